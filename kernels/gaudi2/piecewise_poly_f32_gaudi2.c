@@ -0,0 +1,122 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+// Piecewise polynomial activation, see PiecewisePolyGaudi2. The coefficients
+// of the interval come from the user LUT in aux: function 0 holds c3,
+// function 1 the c0, c1, c2 triples.
+void main(tensor ifm,
+          tensor ofm,
+          tensor aux,
+          float lo,
+          float hi,
+          float invWidth,
+          int lastInterval,
+          float loSlope,
+          float loIntercept,
+          float hiSlope,
+          float hiIntercept)
+{
+    const int depth    = 0;
+    const int width    = 1;
+    const int height   = 2;
+    const int batch    = 3;
+    const int fifthDim = 4;
+
+    const int c3FuncId   = (0x0 << 2) | 0x3;
+    const int c012FuncId = (0x1 << 2) | 0x3;
+
+    const int5 indexSpaceStart = get_index_space_offset();
+    const int5 indexSpaceEnd = get_index_space_size() + indexSpaceStart;
+
+    int5 coords = {0, 0, 0, 0, 0};
+
+    // DEPTH
+    const int depthStep  = 64;
+    const int depthStart = indexSpaceStart[depth] * depthStep;
+    const int depthEnd   = indexSpaceEnd[depth] * depthStep;
+
+    // WIDTH
+    const int widthStep  = 4;
+    const int widthStart = indexSpaceStart[width] * widthStep;
+    const int widthEnd   = indexSpaceEnd[width] * widthStep;
+
+    // HEIGHT
+    const int heightStep  = 1;
+    const int heightStart = indexSpaceStart[height];
+    const int heightEnd   = indexSpaceEnd[height];
+
+    // BATCH
+    const int batchStep  = 1;
+    const int batchStart = indexSpaceStart[batch];
+    const int batchEnd   = indexSpaceEnd[batch];
+
+    // FIFTH DIM
+    const int fifthDimStep  = 1;
+    const int fifthDimStart = indexSpaceStart[fifthDim];
+    const int fifthDimEnd   = indexSpaceEnd[fifthDim];
+
+    set_lut_32(aux);
+
+    for (int f = fifthDimStart; f < fifthDimEnd; f += fifthDimStep)
+    {
+        coords[fifthDim] = f;
+        for (int b = batchStart; b < batchEnd; b += batchStep)
+        {
+            coords[batch] = b;
+            for (int h = heightStart; h < heightEnd; h += heightStep)
+            {
+                coords[height] = h;
+                for (int d = depthStart; d < depthEnd; d += depthStep)
+                {
+                    coords[depth] = d;
+                    #pragma loop_unroll(4)
+                    for (int w = widthStart; w < widthEnd; w += 1)
+                    {
+                        coords[width] = w;
+                        float64 x = v_f32_ld_tnsr_b(coords, ifm);
+
+                        // interval and local coordinate, the last interval
+                        // is closed at hi
+                        float64 u = (x - lo) * invWidth;
+                        int64 interval = v_convert_f32_to_i32_b(u, e_round_down << 16);
+                        interval = v_i32_sel_less_i32_b(interval, 0, 0, interval);
+                        interval = v_i32_sel_grt_i32_b(interval, lastInterval, lastInterval, interval);
+                        float64 t = u - v_convert_i32_to_f32_b(interval, e_round_half_ne << 16);
+                        uint64 entry = *((uint64*)&interval);
+
+                        float64 c3 = v_f32_lookup(entry, c3FuncId, SW_LUT_PTR, 0);
+                        float128 c1c2 = {0};
+                        float64 c0 = 0;
+                        c1c2 = v_f32_lookup_2c(entry, c012FuncId, SW_LUT_PTR, c1c2);
+                        c0 = v_f32_lookup_1c(entry, c012FuncId, SW_LUT_PTR, c0);
+
+                        float64 y = v_f32_mac_b(c3, t, c1c2.v2);
+                        y = v_f32_mac_b(y, t, c1c2.v1);
+                        y = v_f32_mac_b(y, t, c0);
+
+                        // linear tails, nan passes through
+                        y = v_f32_sel_less_f32_b(x, lo, x * loSlope + loIntercept, y);
+                        y = v_f32_sel_grt_f32_b(x, hi, x * hiSlope + hiIntercept, y);
+                        uint64 absX = *((uint64*)&x) & 0x7fffffff;
+                        y = v_f32_sel_grt_u32_b(absX, 0x7f800000, x, y);
+
+                        v_f32_st_tnsr(coords, ofm, y);
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,161 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+// Softmax backward along dim 0: dX = Y * (dY - SUM(dY * Y))
+// Y is the forward softmax output. The dot product is accumulated in f32.
+// Dims 2 and 3, when present, are independent batches of rows.
+
+// VLM  CONFIGURATION
+
+// space left for register spill
+#define REG_SPILL_REDUCTION 20
+// space assigned for data. as we do not have LUT, out total space is 320 2Byte vectors
+#define VLM_MAX_VECTOR (320 - REG_SPILL_REDUCTION)
+// number of data compartments we will use, Y and dY
+#define VLM_INPUTS      2
+// calculation of the number of vectors we can place along the depth
+#define VLM_VECTORS_IN_DEPTH (VLM_MAX_VECTOR/VLM_INPUTS)
+#define Y_TENSOR        0
+#define DY_TENSOR       1
+
+//local memory definition
+__local__ bfloat128 vlm[VLM_INPUTS][VLM_VECTORS_IN_DEPTH];
+
+void main(
+        tensor y,
+        tensor dy,
+        tensor dx
+        )
+{
+    const int depth  = 0;
+    const int width  = 1;
+    const int height = 2;
+    const int batch  = 3;
+
+    const int5 index_space_start = get_index_space_offset();
+    const int5 index_space_end = get_index_space_size() + index_space_start;
+
+    // depth
+    const int depthStep  = 128;
+    const int depthStart = 0;
+    // Returns the dim0 size of y
+    const int depthEnd   = get_dim_size(y, 0);
+
+    // width
+    const int widthStep  = 1;
+    const int widthStart = index_space_start[width] * widthStep;
+    const int widthEnd   = index_space_end[width]   * widthStep;
+
+    // height
+    const int heightStep  = 1;
+    const int heightStart = index_space_start[height];
+    const int heightEnd   = index_space_end[height];
+
+    // batch
+    const int batchStep  = 1;
+    const int batchStart = index_space_start[batch];
+    const int batchEnd   = index_space_end[batch];
+
+    int5 coords = { depthStart, widthStart, 0, 0, 0 };
+
+    // calculation of the vlm_data_end in the depth dimension
+    const int vlm_data_end =  (VLM_VECTORS_IN_DEPTH*depthStep) > depthEnd ? depthEnd : (VLM_VECTORS_IN_DEPTH*depthStep)  ;
+
+    bfloat128 yv;
+    bfloat128 dyv;
+    float64_pair_t yf32, dyf32, dxf32;
+
+#pragma loop_taken
+    for (int b = batchStart; b < batchEnd; b += batchStep)
+    {
+        coords[batch] = b;
+
+#pragma loop_taken
+        for (int h = heightStart; h < heightEnd; h += heightStep)
+        {
+            coords[height] = h;
+
+#pragma loop_taken
+            for (int w = widthStart; w < widthEnd; w += widthStep)
+            {
+                coords[width] = w;
+
+                // SUM(dY * Y), out of bound lanes are loaded as zero and add nothing
+                float64 sum1 = 0.f;
+                float64 sum2 = 0.f;
+
+#pragma loop_taken
+                // in this loop we iterate over vectors that fit inside the vlm
+                for (int d = depthStart, i = 0 ; d < vlm_data_end ; d += depthStep , i++)
+                {
+                    coords[depth] = d;
+
+                    // load input tensors
+                    yv  = v_bf16_ld_tnsr_b(coords, y);
+                    dyv = v_bf16_ld_tnsr_b(coords, dy);
+                    // save to vlm for the second pass
+                    vlm[Y_TENSOR][i]  = yv;
+                    vlm[DY_TENSOR][i] = dyv;
+
+                    yf32  = v_convert_bf16_to_f32_all_b(yv);
+                    dyf32 = v_convert_bf16_to_f32_all_b(dyv);
+                    sum1 = v_f32_mac_b(yf32.v1, dyf32.v1, sum1);
+                    sum2 = v_f32_mac_b(yf32.v2, dyf32.v2, sum2);
+                }
+                for (int d = vlm_data_end ; d < depthEnd; d += depthStep )
+                {
+                    // this loop is outside the scope of the vlm
+                    coords[depth] = d;
+
+                    yv  = v_bf16_ld_tnsr_b(coords, y);
+                    dyv = v_bf16_ld_tnsr_b(coords, dy);
+
+                    yf32  = v_convert_bf16_to_f32_all_b(yv);
+                    dyf32 = v_convert_bf16_to_f32_all_b(dyv);
+                    sum1 = v_f32_mac_b(yf32.v1, dyf32.v1, sum1);
+                    sum2 = v_f32_mac_b(yf32.v2, dyf32.v2, sum2);
+                }
+                // reduce the dot product to all lanes
+                float64 sum = v_f32_reduce_add(sum1 + sum2);
+
+                // dX = Y * (dY - sum)
+#pragma loop_taken
+                for (int d = depthStart, i = 0 ; d < vlm_data_end ; d += depthStep , i++)
+                {
+                    // this loop iterate over vectors in the vlm
+                    coords[depth] = d;
+
+                    yf32  = v_convert_bf16_to_f32_all_b(vlm[Y_TENSOR][i]);
+                    dyf32 = v_convert_bf16_to_f32_all_b(vlm[DY_TENSOR][i]);
+                    dxf32.v1 = yf32.v1 * (dyf32.v1 - sum);
+                    dxf32.v2 = yf32.v2 * (dyf32.v2 - sum);
+                    v_bf16_st_tnsr(coords, dx, v_convert_f32_to_bf16_all_b(dxf32));
+                }
+                for (int d = vlm_data_end ; d < depthEnd; d += depthStep )
+                {
+                    // this loop iterate over vectors that are not in the vlm
+                    coords[depth] = d;
+
+                    yf32  = v_convert_bf16_to_f32_all_b(v_bf16_ld_tnsr_b(coords, y));
+                    dyf32 = v_convert_bf16_to_f32_all_b(v_bf16_ld_tnsr_b(coords, dy));
+                    dxf32.v1 = yf32.v1 * (dyf32.v1 - sum);
+                    dxf32.v2 = yf32.v2 * (dyf32.v2 - sum);
+                    v_bf16_st_tnsr(coords, dx, v_convert_f32_to_bf16_all_b(dxf32));
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,97 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+// Softmax backward along dim 1: dX = Y * (dY - SUM(dY * Y))
+// Y is the forward softmax output. Every lane owns one column, so the dot
+// product needs no cross lane reduction. It is accumulated in f32.
+// Dims 2 and 3, when present, are independent batches of columns.
+
+void main(
+    tensor y,
+    tensor dy,
+    tensor dx
+)
+{
+    const int depth  = 0;
+    const int width  = 1;
+    const int height = 2;
+    const int batch  = 3;
+
+    const int5 index_space_start = get_index_space_offset();
+    const int5 index_space_end = get_index_space_size() + index_space_start;
+
+    // depth
+    const int depthStep  = 128;
+    const int depthStart = index_space_start[depth] * depthStep;
+    const int depthEnd   = index_space_end[depth]   * depthStep;
+
+    // width
+    const int widthStep  = 1;
+    const int widthStart = 0;
+    const int widthEnd   = get_dim_size(y, 1);
+
+    // height
+    const int heightStep  = 1;
+    const int heightStart = index_space_start[height];
+    const int heightEnd   = index_space_end[height];
+
+    // batch
+    const int batchStep  = 1;
+    const int batchStart = index_space_start[batch];
+    const int batchEnd   = index_space_end[batch];
+
+    int5 coords = { depthStart, widthStart, 0, 0, 0 };
+
+    float64_pair_t yf32, dyf32, dxf32;
+
+    for (int b = batchStart; b < batchEnd; b += batchStep)
+    {
+        coords[batch] = b;
+
+        for (int h = heightStart; h < heightEnd; h += heightStep)
+        {
+            coords[height] = h;
+
+            for (int d = depthStart; d < depthEnd; d += depthStep)
+            {
+                coords[depth] = d;
+
+                float64_pair_t sum;
+                sum.v1 = 0.f;
+                sum.v2 = 0.f;
+                for (int w = widthStart; w < widthEnd; w += widthStep)
+                {
+                    coords[width] = w;
+                    yf32  = v_convert_bf16_to_f32_all_b(v_bf16_ld_tnsr_b(coords, y));
+                    dyf32 = v_convert_bf16_to_f32_all_b(v_bf16_ld_tnsr_b(coords, dy));
+                    sum.v1 = v_f32_mac_b(yf32.v1, dyf32.v1, sum.v1);
+                    sum.v2 = v_f32_mac_b(yf32.v2, dyf32.v2, sum.v2);
+                }
+
+                for (int w = widthStart; w < widthEnd; w += widthStep)
+                {
+                    coords[width] = w;
+                    yf32  = v_convert_bf16_to_f32_all_b(v_bf16_ld_tnsr_b(coords, y));
+                    dyf32 = v_convert_bf16_to_f32_all_b(v_bf16_ld_tnsr_b(coords, dy));
+                    // dX = Y * (dY - sum)
+                    dxf32.v1 = yf32.v1 * (dyf32.v1 - sum.v1);
+                    dxf32.v2 = yf32.v2 * (dyf32.v2 - sum.v2);
+                    v_bf16_st_tnsr(coords, dx, v_convert_f32_to_bf16_all_b(dxf32));
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,241 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+#include "kernel_config.h"
+
+// Elementwise activations for transformer MLPs. One of the ACT_* defines
+// selects the function:
+//
+//   ACT_SILU      : y = x * sigmoid(x)
+//   ACT_GELU_TANH : y = x * sigmoid(2 * sqrt(2/pi) * (x + 0.044715 * x^3))
+//                   (the tanh approximation, 0.5 * (1 + tanh(u)) == sigmoid(2u))
+//   ACT_GELU_ERF  : y = x * 0.5 * (1 + erf(x / sqrt(2)))
+//
+// GATED : ifm holds [gate | up] along dim 0 and ofm = act(gate) * up, so
+//         SwiGLU (ACT_SILU) and GeGLU (ACT_GELU_TANH) need a single kernel
+//         and no intermediate tensor.
+// BACKWARD : main(gradOut, ifm, gradIn). For GATED, gradIn is [dgate | dup].
+//
+// bf16 data is computed in f32 through the ACC_VECTOR helpers.
+
+#define NUM_UNROLL              4
+
+// sqrt(2/pi) and 0.044715 * sqrt(2/pi), both doubled to feed sigmoid(2u)
+#define GELU_TANH_C0            1.5957691216f
+#define GELU_TANH_C1            0.0713548162f
+// Abramowitz & Stegun 7.1.26, |error| < 1.5e-7
+#define ERF_P                   0.3275911f
+#define ERF_A1                  0.254829592f
+#define ERF_A2                  -0.284496736f
+#define ERF_A3                  1.421413741f
+#define ERF_A4                  -1.453152027f
+#define ERF_A5                  1.061405429f
+#define INV_SQRT_2              0.7071067812f
+#define INV_SQRT_2PI            0.3989422804f
+
+#if defined(ACT_SILU)
+float64 act_fwd(float64 x)
+{
+    return x * v_sigmoid_f32(x);
+}
+
+float64 act_bwd(float64 x)
+{
+    // s + x * s * (1 - s)
+    float64 s = v_sigmoid_f32(x);
+    return s + x * (s - s * s);
+}
+#elif defined(ACT_GELU_TANH)
+float64 act_fwd(float64 x)
+{
+    float64 u = x * (x * x * GELU_TANH_C1 + GELU_TANH_C0);
+    return x * v_sigmoid_f32(u);
+}
+
+float64 act_bwd(float64 x)
+{
+    // s + x * s * (1 - s) * du/dx
+    float64 x2 = x * x;
+    float64 s  = v_sigmoid_f32(x * (x2 * GELU_TANH_C1 + GELU_TANH_C0));
+    float64 du = x2 * (3.0f * GELU_TANH_C1) + GELU_TANH_C0;
+    return s + x * (s - s * s) * du;
+}
+#elif defined(ACT_GELU_ERF)
+// Returns the normal CDF of x and exp(-x^2 / 2) for the derivative.
+float64 normal_cdf(float64 x, float64* expTerm)
+{
+    float64 z = v_f32_abs_b(x) * INV_SQRT_2;
+    float64 t = v_reciprocal_f32(z * ERF_P + 1.0f);
+    float64 poly = t * (t * (t * (t * (t * ERF_A5 + ERF_A4) + ERF_A3) + ERF_A2) + ERF_A1);
+    float64 e = exp_f32(-(z * z));
+    float64 erfAbs = -(poly * e) + 1.0f;
+    float64 erfX = v_f32_sel_less_f32_b(x, 0.0f, -erfAbs, erfAbs);
+    *expTerm = e;
+    return erfX * 0.5f + 0.5f;
+}
+
+float64 act_fwd(float64 x)
+{
+    float64 e;
+    return x * normal_cdf(x, &e);
+}
+
+float64 act_bwd(float64 x)
+{
+    // cdf(x) + x * pdf(x)
+    float64 e;
+    float64 cdf = normal_cdf(x, &e);
+    return cdf + x * e * INV_SQRT_2PI;
+}
+#endif
+
+void main(
+#if defined(BACKWARD)
+          tensor gradOut,
+#endif
+          tensor ifm,
+#if defined(BACKWARD)
+          tensor gradIn
+#else
+          tensor ofm
+#endif
+          )
+{
+    const int depth    = 0;
+    const int width    = 1;
+    const int height   = 2;
+    const int batch    = 3;
+    const int fifthDim = 4;
+
+    const int5 indexSpaceStart = get_index_space_offset();
+    const int5 indexSpaceEnd = get_index_space_size() + indexSpaceStart;
+
+    int5 coords = {0, 0, 0, 0, 0};
+#if defined(GATED)
+    int5 upCoords = {0, 0, 0, 0, 0};
+    // the up half starts right after the gate half
+    const int upOffset = get_dim_size(ifm, depth) / 2;
+#endif
+
+    // DEPTH
+    const int depthStep  = VECTOR_SIZE;
+    const int depthStart = indexSpaceStart[depth] * depthStep;
+    const int depthEnd   = indexSpaceEnd[depth] * depthStep;
+
+    // WIDTH
+    const int widthStep  = NUM_UNROLL;
+    const int widthStart = indexSpaceStart[width] * widthStep;
+    const int widthEnd   = indexSpaceEnd[width] * widthStep;
+
+    // HEIGHT
+    const int heightStep  = 1;
+    const int heightStart = indexSpaceStart[height];
+    const int heightEnd   = indexSpaceEnd[height];
+
+    // BATCH
+    const int batchStep  = 1;
+    const int batchStart = indexSpaceStart[batch];
+    const int batchEnd   = indexSpaceEnd[batch];
+
+    // fifthDim
+    const int fifthDimStep  = 1;
+    const int fifthDimStart = indexSpaceStart[fifthDim];
+    const int fifthDimEnd   = indexSpaceEnd[fifthDim];
+
+    #pragma loop_taken
+    for (int d = depthStart; d < depthEnd; d += depthStep)
+    {
+        coords[depth] = d;
+#if defined(GATED)
+        upCoords[depth] = d + upOffset;
+#endif
+
+        #pragma loop_taken
+        for (int f = fifthDimStart; f < fifthDimEnd; f += fifthDimStep)
+        {
+            coords[fifthDim] = f;
+
+            #pragma loop_taken
+            for (int b = batchStart; b < batchEnd; b += batchStep)
+            {
+                coords[batch] = b;
+
+                #pragma loop_taken
+                for (int h = heightStart; h < heightEnd; h += heightStep)
+                {
+                    coords[height] = h;
+
+                    #pragma loop_taken
+                    #pragma unroll(NUM_UNROLL)
+                    for (int w = widthStart; w < widthEnd; w += 1)
+                    {
+                        coords[width] = w;
+#if defined(GATED)
+                        upCoords[width]    = w;
+                        upCoords[height]   = h;
+                        upCoords[batch]    = b;
+                        upCoords[fifthDim] = f;
+#endif
+
+                        ACC_VECTOR x = v_to_acc(v_ld_tnsr_i(coords, ifm));
+#if defined(GATED)
+                        ACC_VECTOR up = v_to_acc(v_ld_tnsr_i(upCoords, ifm));
+#endif
+#if defined(BACKWARD)
+                        ACC_VECTOR dy = v_to_acc(v_ld_tnsr_i(coords, gradOut));
+#endif
+                        ACC_VECTOR y;
+#if defined(BACKWARD) && defined(GATED)
+                        ACC_VECTOR dUp;
+#endif
+
+                        #pragma unroll(ACC_PARTS)
+                        for (int p = 0; p < ACC_PARTS; p++)
+                        {
+                            float64 xp = acc_part(x, p);
+#if !defined(BACKWARD)
+    #if defined(GATED)
+                            float64 yp = act_fwd(xp) * acc_part(up, p);
+    #else
+                            float64 yp = act_fwd(xp);
+    #endif
+#else
+                            float64 dyp = acc_part(dy, p);
+    #if defined(GATED)
+                            // dgate = dy * up * act'(gate), dup = dy * act(gate)
+                            float64 dUpP = dyp * act_fwd(xp);
+                            acc_set_part(dUp, p, dUpP);
+                            float64 yp = dyp * acc_part(up, p) * act_bwd(xp);
+    #else
+                            float64 yp = dyp * act_bwd(xp);
+    #endif
+#endif
+                            acc_set_part(y, p, yp);
+                        }
+
+#if defined(BACKWARD)
+                        st_tnsr_i_v(coords, gradIn, v_from_acc(y));
+    #if defined(GATED)
+                        st_tnsr_i_v(upCoords, gradIn, v_from_acc(dUp));
+    #endif
+#else
+                        st_tnsr_i_v(coords, ofm, v_from_acc(y));
+#endif
+                    }
+                }
+            }
+        }
+    }
+}
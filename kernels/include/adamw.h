@@ -0,0 +1,166 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include "kernel_config.h"
+#if defined(BFLOAT16)
+#include "bf16_linear.h"
+#endif
+
+// Fused AdamW step, one pass over the weights, gradients and moments:
+//
+//   m = beta1 * m + (1 - beta1) * g
+//   v = beta2 * v + (1 - beta2) * g^2
+//   w = w * (1 - lr * wd) - stepSize * m / (sqrt(v * biasCorr2) + eps)
+//
+// stepSize is lr / (1 - beta1^t) and biasCorr2 is 1 / (1 - beta2^t), both
+// folded by the glue code. Weights and moments are f32. The gradient is in the
+// FLOAT32 / BFLOAT16 data type, and for bf16 the f32 master weights are also
+// written out rounded to the bf16 params. weights is the master copy then.
+//
+// ADAMW_MULTI_TENSOR : all tensors are flat 1D lists of chunkSize element
+//                      chunks, and chunkDecay holds the weight decay
+//                      multiplier of every chunk (0 for params without decay).
+//
+// Every element is read before it is written, so the outputs may alias the
+// inputs for an in-place update.
+
+// vectors of dim 0 handled by one index space member
+#define ADAMW_VECTORS           4
+
+// f32 vectors per gradient vector, the gradient is converted in element order
+// to line up with the f32 weight and moment loads
+#if defined(BFLOAT16)
+#define ADAMW_PARTS             2
+#define ld_grad_linear(c, t)    bf16_to_f32_linear(v_bf16_ld_tnsr_b(c, t))
+#else
+#define ADAMW_PARTS             1
+#define ld_grad_linear(c, t)    v_f32_ld_tnsr_b(c, t)
+#endif
+
+void main(tensor grad,
+          tensor weights,
+          tensor m,
+          tensor v,
+#if defined(ADAMW_MULTI_TENSOR)
+          tensor chunkDecay,
+#endif
+          tensor weightsOut,
+          tensor mOut,
+          tensor vOut,
+#if defined(BFLOAT16)
+          tensor paramOut,
+#endif
+          float lr,
+          float beta1,
+          float beta2,
+          float eps,
+          float weightDecay,
+          float stepSize,
+          float biasCorr2,
+          int chunkSize)
+{
+    const int depth  = 0;
+    const int width  = 1;
+    const int height = 2;
+    const int batch  = 3;
+
+    const int5 index_space_start = get_index_space_offset();
+    const int5 index_space_end = get_index_space_size() + index_space_start;
+
+    // depth
+    const int depthStep  = VECTOR_SIZE * ADAMW_VECTORS;
+    const int depthStart = index_space_start[depth] * depthStep;
+    const int depthEnd   = index_space_end[depth] * depthStep;
+
+    // width
+    const int widthStep  = 1;
+    const int widthStart = index_space_start[width] * widthStep;
+    const int widthEnd   = index_space_end[width] * widthStep;
+
+    // height
+    const int heightStep  = 1;
+    const int heightStart = index_space_start[height] * heightStep;
+    const int heightEnd   = index_space_end[height] * heightStep;
+
+    // batch
+    const int batchStep  = 1;
+    const int batchStart = index_space_start[batch] * batchStep;
+    const int batchEnd   = index_space_end[batch] * batchStep;
+
+    const float oneMinusBeta1 = 1.0f - beta1;
+    const float oneMinusBeta2 = 1.0f - beta2;
+
+    int5 coords = {0, 0, 0, 0, 0};
+
+    for (int b = batchStart; b < batchEnd; b += batchStep)
+    {
+        coords[batch] = b;
+        for (int h = heightStart; h < heightEnd; h += heightStep)
+        {
+            coords[height] = h;
+            for (int w = widthStart; w < widthEnd; w += widthStep)
+            {
+                coords[width] = w;
+                for (int d = depthStart; d < depthEnd; d += depthStep)
+                {
+#if defined(ADAMW_MULTI_TENSOR)
+                    // the glue keeps chunkSize a multiple of depthStep
+                    int5 chunkCoords = {d / chunkSize, 0, 0, 0, 0};
+                    const float chunkWd = s_f32_ld_g((__global__ float*)gen_addr(chunkCoords, chunkDecay));
+                    const float decay = 1.0f - lr * weightDecay * chunkWd;
+#else
+                    const float decay = 1.0f - lr * weightDecay;
+#endif
+                    #pragma unroll(ADAMW_VECTORS)
+                    for (int j = 0; j < ADAMW_VECTORS; j++)
+                    {
+                        coords[depth] = d + j * VECTOR_SIZE;
+                        ACC_VECTOR g = ld_grad_linear(coords, grad);
+#if defined(BFLOAT16)
+                        float128 param;
+#endif
+                        #pragma unroll(ADAMW_PARTS)
+                        for (int p = 0; p < ADAMW_PARTS; p++)
+                        {
+                            int5 stateCoords = coords;
+                            stateCoords[depth] = d + j * VECTOR_SIZE + p * 64;
+
+                            float64 gp = acc_part(g, p);
+                            float64 wp = v_f32_ld_tnsr_b(stateCoords, weights);
+                            float64 mp = v_f32_ld_tnsr_b(stateCoords, m);
+                            float64 vp = v_f32_ld_tnsr_b(stateCoords, v);
+
+                            mp = v_f32_mac_b(gp, oneMinusBeta1, mp * beta1);
+                            vp = v_f32_mac_b(gp * gp, oneMinusBeta2, vp * beta2);
+                            float64 denom = v_sqrt_f32(vp * biasCorr2) + eps;
+                            wp = wp * decay - mp * v_reciprocal_f32(denom) * stepSize;
+
+                            v_f32_st_tnsr(stateCoords, weightsOut, wp);
+                            v_f32_st_tnsr(stateCoords, mOut, mp);
+                            v_f32_st_tnsr(stateCoords, vOut, vp);
+#if defined(BFLOAT16)
+                            acc_set_part(param, p, wp);
+#endif
+                        }
+#if defined(BFLOAT16)
+                        st_tnsr_bf16_linear(coords, paramOut, param);
+#endif
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,30 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+// Selects bf16 for word_linear.h, for kernels that mix bf16 tensors with f32
+// ones.
+
+#define WORD_VECTOR                     bfloat128
+#define v_word_unpack_b                 v_bf16_unpack_b
+#define v_word_st_tnsr                  v_bf16_st_tnsr
+#define v_word_mov_dual_group_b         v_bf16_mov_dual_group_b
+#define v_convert_word_to_f32(x)        v_convert_bf16_to_f32_all_b(x).v1
+#define v_convert_f32_to_word(x)        v_convert_f32_to_bf16_all_b(x, SW_RHNE, (bfloat128)0)
+
+#include "word_linear.h"
+
+#define bf16_to_f32_linear              word_to_f32_linear
+#define st_tnsr_bf16_linear             st_tnsr_word_linear
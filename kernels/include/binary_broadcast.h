@@ -0,0 +1,180 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include "kernel_config.h"
+
+// Elementwise binary ops with numpy style broadcasting, ofm = OP(ifm0, ifm1).
+// One binary per op, selected with OP_ADD, OP_SUB, OP_MUL, OP_DIV, OP_MAX or
+// OP_MIN.
+//
+// bcast0 / bcast1 have bit d set when dim d of ifm0 / ifm1 is 1 while the
+// ofm dim is not. Broadcast dims read coordinate 0. A broadcast FCD loads
+// the single element with a scalar load once per row and splats it.
+//
+// The ofm may alias ifm0 (in place): every vector of ifm0 is read before
+// the same vector of the ofm is written, and by the same member only.
+
+#if defined(FLOAT32)
+#define s_ld_g_i(a)                 s_f32_ld_g(a)
+#define v_splat_s(a)                v_f32_mov_b(a)
+#define v_max_v_v(a, b)             v_f32_max_b(a, b)
+#define v_min_v_v(a, b)             v_f32_min_b(a, b)
+#endif
+
+#if defined(BFLOAT16)
+#define s_ld_g_i(a)                 s_bf16_ld_g(a)
+#define v_splat_s(a)                v_bf16_mov_b(a)
+#define v_max_v_v(a, b)             v_bf16_max_b(a, b)
+#define v_min_v_v(a, b)             v_bf16_min_b(a, b)
+#endif
+
+#define NUM_UNROLL                  4
+
+VECTOR binary_op(VECTOR a, VECTOR b)
+{
+#if defined(OP_ADD)
+    return a + b;
+#elif defined(OP_SUB)
+    return a - b;
+#elif defined(OP_MUL)
+    return a * b;
+#elif defined(OP_MAX)
+    return v_max_v_v(a, b);
+#elif defined(OP_MIN)
+    return v_min_v_v(a, b);
+#elif defined(OP_DIV)
+    // a * 1 / b in f32, bf16 rounds once on the way back
+    ACC_VECTOR accA = v_to_acc(a);
+    ACC_VECTOR accB = v_to_acc(b);
+    for (int p = 0; p < ACC_PARTS; p++)
+    {
+        acc_set_part(accA, p, acc_part(accA, p) * v_reciprocal_f32(acc_part(accB, p)));
+    }
+    return v_from_acc(accA);
+#endif
+}
+
+void main(tensor ifm0,
+          tensor ifm1,
+          tensor ofm,
+          int bcast0,
+          int bcast1)
+{
+    const int depth  = 0;
+    const int width  = 1;
+    const int height = 2;
+    const int batch  = 3;
+    const int fifthDim = 4;
+
+    const int5 index_space_start = get_index_space_offset();
+    const int5 index_space_end = get_index_space_size() + index_space_start;
+
+    const int depthStep  = VECTOR_SIZE;
+    const int depthStart = index_space_start[depth] * depthStep;
+    const int depthEnd   = index_space_end[depth] * depthStep;
+
+    const int widthStart = index_space_start[width];
+    const int widthEnd   = index_space_end[width];
+
+    const int heightStart = index_space_start[height];
+    const int heightEnd   = index_space_end[height];
+
+    const int batchStart = index_space_start[batch];
+    const int batchEnd   = index_space_end[batch];
+
+    const int fifthDimStart = index_space_start[fifthDim];
+    const int fifthDimEnd   = index_space_end[fifthDim];
+
+    // at most one input broadcasts the FCD, the ofm FCD is 1 otherwise
+    const bool splat0 = (bcast0 & 1) != 0;
+    const bool splat1 = (bcast1 & 1) != 0;
+
+    int5 ofmCoords = {0, 0, 0, 0, 0};
+    int5 ifm0Coords = {0, 0, 0, 0, 0};
+    int5 ifm1Coords = {0, 0, 0, 0, 0};
+
+    for (int f = fifthDimStart; f < fifthDimEnd; f++)
+    {
+        ofmCoords[fifthDim] = f;
+        ifm0Coords[fifthDim] = (bcast0 & (1 << fifthDim)) ? 0 : f;
+        ifm1Coords[fifthDim] = (bcast1 & (1 << fifthDim)) ? 0 : f;
+
+        for (int b = batchStart; b < batchEnd; b++)
+        {
+            ofmCoords[batch] = b;
+            ifm0Coords[batch] = (bcast0 & (1 << batch)) ? 0 : b;
+            ifm1Coords[batch] = (bcast1 & (1 << batch)) ? 0 : b;
+
+            for (int h = heightStart; h < heightEnd; h++)
+            {
+                ofmCoords[height] = h;
+                ifm0Coords[height] = (bcast0 & (1 << height)) ? 0 : h;
+                ifm1Coords[height] = (bcast1 & (1 << height)) ? 0 : h;
+
+                for (int w = widthStart; w < widthEnd; w++)
+                {
+                    ofmCoords[width] = w;
+                    ifm0Coords[width] = (bcast0 & (1 << width)) ? 0 : w;
+                    ifm1Coords[width] = (bcast1 & (1 << width)) ? 0 : w;
+
+                    if (splat0)
+                    {
+                        ifm0Coords[depth] = 0;
+                        __global__ void* addr = gen_addr(ifm0Coords, ifm0);
+                        const VECTOR x = v_splat_s(s_ld_g_i(addr));
+
+                        #pragma unroll(NUM_UNROLL)
+                        for (int d = depthStart; d < depthEnd; d += depthStep)
+                        {
+                            ofmCoords[depth] = d;
+                            ifm1Coords[depth] = d;
+                            VECTOR y = v_ld_tnsr_i(ifm1Coords, ifm1);
+                            st_tnsr_i_v(ofmCoords, ofm, binary_op(x, y));
+                        }
+                    }
+                    else if (splat1)
+                    {
+                        ifm1Coords[depth] = 0;
+                        __global__ void* addr = gen_addr(ifm1Coords, ifm1);
+                        const VECTOR y = v_splat_s(s_ld_g_i(addr));
+
+                        #pragma unroll(NUM_UNROLL)
+                        for (int d = depthStart; d < depthEnd; d += depthStep)
+                        {
+                            ofmCoords[depth] = d;
+                            ifm0Coords[depth] = d;
+                            VECTOR x = v_ld_tnsr_i(ifm0Coords, ifm0);
+                            st_tnsr_i_v(ofmCoords, ofm, binary_op(x, y));
+                        }
+                    }
+                    else
+                    {
+                        #pragma unroll(NUM_UNROLL)
+                        for (int d = depthStart; d < depthEnd; d += depthStep)
+                        {
+                            ofmCoords[depth] = d;
+                            ifm0Coords[depth] = d;
+                            ifm1Coords[depth] = d;
+                            VECTOR x = v_ld_tnsr_i(ifm0Coords, ifm0);
+                            VECTOR y = v_ld_tnsr_i(ifm1Coords, ifm1);
+                            st_tnsr_i_v(ofmCoords, ofm, binary_op(x, y));
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,78 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+// 8 bit <-> f32 conversions that keep the element order, shared by the fp8
+// and int8 kernels. The including header selects the 8 bit type with
+//   BYTE_VECTOR, v_byte_unpack_b, v_byte_mov_dual_group_b, v_byte_st_tnsr,
+//   v_convert_byte_to_f32(x)    : low byte of every 32 bit lane -> float64
+//   v_convert_f32_to_byte(x)    : float256 -> BYTE_VECTOR, packed by the store
+//
+// A 256 element vector maps to float256 with elements 0..63 in v1,
+// 64..127 in v2, 128..191 in v3 and 192..255 in v4, the same split as
+// bf16_linear.h.
+
+// Spreads every fourth byte into 32 bit lanes. Dual group j of the result
+// holds elements 64j + 32 * group + 16 * half .. + 15.
+#define byte_unpack(in, group, half) \
+                v_byte_unpack_b(in, ((group) << 8) | ((e_every_forth_element) << 9) | ((half) << 10), (BYTE_VECTOR)0)
+
+// Returns elements 0..255 of in split over v1..v4, as cast_bf16_to_f32.c
+// does for bf16. After the unpack r[2g + h] holds, in dual group j, the 16
+// elements starting at 64j + 16(2g + h), so the output vector k takes dual
+// group j from dual group k of r[j].
+float256 byte_to_f32_linear(BYTE_VECTOR in)
+{
+    BYTE_VECTOR r0 = byte_unpack(in, e_group_0, e_lower_half_group);
+    BYTE_VECTOR r1 = byte_unpack(in, e_group_0, e_upper_half_group);
+    BYTE_VECTOR r2 = byte_unpack(in, e_group_1, e_lower_half_group);
+    BYTE_VECTOR r3 = byte_unpack(in, e_group_1, e_upper_half_group);
+
+    // 0..63
+    BYTE_VECTOR y0 = r0;
+    y0 = v_byte_mov_dual_group_b(r1, 0xFFFFFFFF, 0, 1, MkWr(1, 1), y0);
+    y0 = v_byte_mov_dual_group_b(r2, 0xFFFFFFFF, 0, 2, MkWr(1, 1), y0);
+    y0 = v_byte_mov_dual_group_b(r3, 0xFFFFFFFF, 0, 3, MkWr(1, 1), y0);
+
+    // 64..127
+    BYTE_VECTOR y1 = r1;
+    y1 = v_byte_mov_dual_group_b(r0, 0xFFFFFFFF, 1, 0, MkWr(1, 1), y1);
+    y1 = v_byte_mov_dual_group_b(r2, 0xFFFFFFFF, 1, 2, MkWr(1, 1), y1);
+    y1 = v_byte_mov_dual_group_b(r3, 0xFFFFFFFF, 1, 3, MkWr(1, 1), y1);
+
+    // 128..191
+    BYTE_VECTOR y2 = r2;
+    y2 = v_byte_mov_dual_group_b(r0, 0xFFFFFFFF, 2, 0, MkWr(1, 1), y2);
+    y2 = v_byte_mov_dual_group_b(r1, 0xFFFFFFFF, 2, 1, MkWr(1, 1), y2);
+    y2 = v_byte_mov_dual_group_b(r3, 0xFFFFFFFF, 2, 3, MkWr(1, 1), y2);
+
+    // 192..255
+    BYTE_VECTOR y3 = r3;
+    y3 = v_byte_mov_dual_group_b(r0, 0xFFFFFFFF, 3, 0, MkWr(1, 1), y3);
+    y3 = v_byte_mov_dual_group_b(r1, 0xFFFFFFFF, 3, 1, MkWr(1, 1), y3);
+    y3 = v_byte_mov_dual_group_b(r2, 0xFFFFFFFF, 3, 2, MkWr(1, 1), y3);
+
+    float256 out;
+    out.v1 = v_convert_byte_to_f32(y0);
+    out.v2 = v_convert_byte_to_f32(y1);
+    out.v3 = v_convert_byte_to_f32(y2);
+    out.v4 = v_convert_byte_to_f32(y3);
+    return out;
+}
+
+// Stores elements 0..63 from x.v1 up to 192..255 from x.v4, as
+// cast_f32_to_bf16.c. x must already be within the range of the type.
+#define st_tnsr_byte_linear(coords, t, x) \
+                v_byte_st_tnsr(coords, t, v_convert_f32_to_byte(x), SW_PACK)
@@ -0,0 +1,256 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+// Any-to-any cast among f32, bf16, f16, i32, i16, i8 and u8. The wrapper
+// picks one type per side, the same switch names as kernel_config.h with a
+// SRC_ / DST_ prefix, e.g.
+//   #define SRC_FLOAT32
+//   #define DST_INT8
+//
+// Every member handles 256 elements of dim 0, one 8 bit vector, which goes
+// through f32 in element order (float256, elements 0..63 in v1). All the
+// 16 and 8 bit types and i32 values up to 2^24 convert to f32 exactly, so
+// the only rounding is the final one:
+//   float -> float : round half to even, overflow goes to inf
+//   any   -> int   : round half to even, saturated to the integer range,
+//                    NaN to 0
+// i32 beyond 2^24 is rounded to f32 first; it saturates the narrower integer
+// types either way, for bf16 / f16 it can round twice.
+// Gaudi has no f16, it builds the pairs of the other six types.
+
+// Source side: v_src_ld_tnsr_b and SRC_BITS, the 16 and 8 bit types pull in
+// the element order helpers.
+#if defined(SRC_FLOAT32)
+#define SRC_BITS                        32
+#define v_src_ld_tnsr_b                 v_f32_ld_tnsr_b
+#define v_src_to_f32(x)                 (x)
+#elif defined(SRC_INT32)
+#define SRC_BITS                        32
+#define v_src_ld_tnsr_b                 v_i32_ld_tnsr_b
+#define v_src_to_f32(x)                 v_convert_i32_to_f32_b(x, e_round_half_ne << 16)
+#elif defined(SRC_BFLOAT16)
+#define SRC_BITS                        16
+#define v_src_ld_tnsr_b                 v_bf16_ld_tnsr_b
+#include "bf16_linear.h"
+#elif defined(SRC_FLOAT16)
+#define SRC_BITS                        16
+#define v_src_ld_tnsr_b                 v_f16_ld_tnsr_b
+#define WORD_VECTOR                     half128
+#define v_word_unpack_b                 v_f16_unpack_b
+#define v_word_st_tnsr                  v_f16_st_tnsr
+#define v_word_mov_dual_group_b         v_f16_mov_dual_group_b
+#define v_convert_word_to_f32(x)        v_convert_f16_to_f32_all_b(x).v1
+#define v_convert_f32_to_word(x)        v_convert_f32_to_f16_all_b(x, SW_RHNE, (half128)0)
+#include "word_linear.h"
+#elif defined(SRC_INT16)
+#define SRC_BITS                        16
+#define v_src_ld_tnsr_b                 v_i16_ld_tnsr_b
+#define WORD_VECTOR                     short128
+#define v_word_unpack_b                 v_i16_unpack_b
+#define v_word_st_tnsr                  v_i16_st_tnsr
+#define v_word_mov_dual_group_b         v_i16_mov_dual_group_b
+#define v_convert_word_to_f32(x)        v_convert_i16_to_f32_b(x)
+#define v_convert_f32_to_word(x)        v_convert_f32_to_i16_all_b(x, SW_RHNE, (short128)0)
+#include "word_linear.h"
+#elif defined(SRC_INT8)
+#define SRC_BITS                        8
+#include "i8_linear.h"
+#define v_src_ld_tnsr_b                 v_byte_ld_tnsr_b
+#elif defined(SRC_UINT8)
+#define SRC_BITS                        8
+#define BYTE_VECTOR                     uchar256
+#define v_byte_ld_tnsr_b                v_u8_ld_tnsr_b
+#define v_byte_st_tnsr                  v_u8_st_tnsr
+#define v_byte_unpack_b                 v_u8_unpack_b
+#define v_byte_mov_dual_group_b         v_u8_mov_dual_group_b
+#define v_convert_byte_to_f32(x)        v_convert_u8_to_f32_all_b(x).v1
+#define v_convert_f32_to_byte(x)        v_convert_f32_to_u8_all_b(x, SW_RHNE, (uchar256)0)
+#include "byte_linear.h"
+#define v_src_ld_tnsr_b                 v_byte_ld_tnsr_b
+#endif
+
+// Destination side: v_dst_st_tnsr, v_f32_to_dst and DST_BITS. The 16 and 8
+// bit conversions take all 128 / 256 lanes and the store packs them, as
+// cast_f32_to_bf16.c. The 16 and 8 bit integer types clamp in f32 before
+// converting. i32 is left to the saturation of the convert, a clamp in f32
+// could not reach 2^31 - 1, the largest f32 below 2^31 is 2^31 - 128.
+#if defined(DST_FLOAT32)
+#define DST_BITS                        32
+#define v_dst_st_tnsr(c, t, x)          v_f32_st_tnsr(c, t, x)
+#define v_f32_to_dst(x)                 (x)
+#elif defined(DST_INT32)
+#define DST_BITS                        32
+#define DST_INTEGER
+#define v_dst_st_tnsr(c, t, x)          v_i32_st_tnsr(c, t, x)
+#define v_f32_to_dst(x)                 v_convert_f32_to_i32_b(x, e_round_half_ne << 16)
+#elif defined(DST_BFLOAT16)
+#define DST_BITS                        16
+#define v_dst_st_tnsr(c, t, x)          v_bf16_st_tnsr(c, t, x, SW_PACK)
+#define v_f32_to_dst(x)                 v_convert_f32_to_bf16_all_b(x, SW_RHNE, (bfloat128)0)
+#elif defined(DST_FLOAT16)
+#define DST_BITS                        16
+#define v_dst_st_tnsr(c, t, x)          v_f16_st_tnsr(c, t, x, SW_PACK)
+#define v_f32_to_dst(x)                 v_convert_f32_to_f16_all_b(x, SW_RHNE, (half128)0)
+#elif defined(DST_INT16)
+#define DST_BITS                        16
+#define DST_INTEGER
+#define DST_MIN                         -32768.0f
+#define DST_MAX                         32767.0f
+#define v_dst_st_tnsr(c, t, x)          v_i16_st_tnsr(c, t, x, SW_PACK)
+#define v_f32_to_dst(x)                 v_convert_f32_to_i16_all_b(x, SW_RHNE, (short128)0)
+#elif defined(DST_INT8)
+#define DST_BITS                        8
+#define DST_INTEGER
+#define DST_MIN                         -128.0f
+#define DST_MAX                         127.0f
+#define v_dst_st_tnsr(c, t, x)          v_i8_st_tnsr(c, t, x, SW_PACK)
+#define v_f32_to_dst(x)                 v_convert_f32_to_i8_all_b(x, SW_RHNE, (char256)0)
+#elif defined(DST_UINT8)
+#define DST_BITS                        8
+#define DST_INTEGER
+#define DST_MIN                         0.0f
+#define DST_MAX                         255.0f
+#define v_dst_st_tnsr(c, t, x)          v_u8_st_tnsr(c, t, x, SW_PACK)
+#define v_f32_to_dst(x)                 v_convert_f32_to_u8_all_b(x, SW_RHNE, (uchar256)0)
+#endif
+
+// NaN is the only value not equal to itself
+#define cast_nan_to_zero(x)             v_f32_sel_eq_f32_b(x, x, x, 0.0f)
+
+#if defined(DST_MIN)
+#define cast_clamp(x)                   v_f32_min_b(v_f32_max_b(cast_nan_to_zero(x), DST_MIN), DST_MAX)
+#elif defined(DST_INTEGER)
+#define cast_clamp(x)                   cast_nan_to_zero(x)
+#else
+#define cast_clamp(x)                   (x)
+#endif
+
+#define CAST_UNROLL                     2
+
+void main(tensor ifm, tensor ofm)
+{
+    const int depth  = 0;
+    const int width  = 1;
+    const int height = 2;
+    const int batch  = 3;
+    const int fifthDim = 4;
+
+    const int5 index_space_start = get_index_space_offset();
+    const int5 index_space_end = get_index_space_size() + index_space_start;
+
+    // depth, 256 elements per member
+    const int depthStep  = 256;
+    const int depthStart = index_space_start[depth] * depthStep;
+    const int depthEnd   = index_space_end[depth] * depthStep;
+
+    // width
+    const int widthStep  = 1;
+    const int widthStart = index_space_start[width] * widthStep;
+    const int widthEnd   = index_space_end[width] * widthStep;
+
+    // height
+    const int heightStep  = 1;
+    const int heightStart = index_space_start[height] * heightStep;
+    const int heightEnd   = index_space_end[height] * heightStep;
+
+    // batch
+    const int batchStep  = 1;
+    const int batchStart = index_space_start[batch] * batchStep;
+    const int batchEnd   = index_space_end[batch] * batchStep;
+
+    // fifthDim
+    const int fifthDimStep  = 1;
+    const int fifthDimStart = index_space_start[fifthDim] * fifthDimStep;
+    const int fifthDimEnd   = index_space_end[fifthDim] * fifthDimStep;
+
+    int5 coords = {0, 0, 0, 0, 0};
+
+    #pragma loop_taken
+    for (int d = depthStart; d < depthEnd; d += depthStep)
+    {
+        #pragma loop_taken
+        for (int f = fifthDimStart; f < fifthDimEnd; f += fifthDimStep)
+        {
+            coords[fifthDim] = f;
+            #pragma loop_taken
+            for (int b = batchStart; b < batchEnd; b += batchStep)
+            {
+                coords[batch] = b;
+                #pragma loop_taken
+                for (int h = heightStart; h < heightEnd; h += heightStep)
+                {
+                    coords[height] = h;
+                    #pragma loop_taken
+                    #pragma unroll(CAST_UNROLL)
+                    for (int w = widthStart; w < widthEnd; w += widthStep)
+                    {
+                        coords[width] = w;
+
+                        float256 x;
+#if SRC_BITS == 32
+                        coords[depth] = d;
+                        x.v1 = v_src_to_f32(v_src_ld_tnsr_b(coords, ifm));
+                        coords[depth] = d + 64;
+                        x.v2 = v_src_to_f32(v_src_ld_tnsr_b(coords, ifm));
+                        coords[depth] = d + 128;
+                        x.v3 = v_src_to_f32(v_src_ld_tnsr_b(coords, ifm));
+                        coords[depth] = d + 192;
+                        x.v4 = v_src_to_f32(v_src_ld_tnsr_b(coords, ifm));
+#elif SRC_BITS == 16
+                        coords[depth] = d;
+                        float128 srcLo = word_to_f32_linear(v_src_ld_tnsr_b(coords, ifm));
+                        coords[depth] = d + 128;
+                        float128 srcHi = word_to_f32_linear(v_src_ld_tnsr_b(coords, ifm));
+                        x.v1 = srcLo.v1;
+                        x.v2 = srcLo.v2;
+                        x.v3 = srcHi.v1;
+                        x.v4 = srcHi.v2;
+#else
+                        coords[depth] = d;
+                        x = byte_to_f32_linear(v_src_ld_tnsr_b(coords, ifm));
+#endif
+
+                        x.v1 = cast_clamp(x.v1);
+                        x.v2 = cast_clamp(x.v2);
+                        x.v3 = cast_clamp(x.v3);
+                        x.v4 = cast_clamp(x.v4);
+
+#if DST_BITS == 32
+                        coords[depth] = d;
+                        v_dst_st_tnsr(coords, ofm, v_f32_to_dst(x.v1));
+                        coords[depth] = d + 64;
+                        v_dst_st_tnsr(coords, ofm, v_f32_to_dst(x.v2));
+                        coords[depth] = d + 128;
+                        v_dst_st_tnsr(coords, ofm, v_f32_to_dst(x.v3));
+                        coords[depth] = d + 192;
+                        v_dst_st_tnsr(coords, ofm, v_f32_to_dst(x.v4));
+#elif DST_BITS == 16
+                        float128 dstLo = {x.v1, x.v2};
+                        float128 dstHi = {x.v3, x.v4};
+                        coords[depth] = d;
+                        v_dst_st_tnsr(coords, ofm, v_f32_to_dst(dstLo));
+                        coords[depth] = d + 128;
+                        v_dst_st_tnsr(coords, ofm, v_f32_to_dst(dstHi));
+#else
+                        coords[depth] = d;
+                        v_dst_st_tnsr(coords, ofm, v_f32_to_dst(x));
+#endif
+                    }
+                }
+            }
+        }
+    }
+}
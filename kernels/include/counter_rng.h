@@ -0,0 +1,46 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+#ifndef COUNTER_RNG_H
+#define COUNTER_RNG_H
+
+// Jenkins' 32-bit integer hash. Only add/xor/shift are used so the same
+// sequence works on scalars and on uint64 vectors, and it is reproduced
+// bit-exactly by the host reference.
+#define HASH_U32(a)                             \
+    a = (a + 0x7ed55d16) + (a << 12);           \
+    a = (a ^ 0xc761c23c) ^ (a >> 19);           \
+    a = (a + 0x165667b1) + (a << 5);            \
+    a = (a + 0xd3a2646c) ^ (a << 9);            \
+    a = (a + 0xfd7046c5) + (a << 3);            \
+    a = (a ^ 0xb55a4f09) ^ (a >> 16);
+
+// key step between rounds, 2^32 / golden ratio as in Philox
+#define RNG_WEYL                0x9e3779b9
+
+// Counter based generator: 32 random bits per lane as a pure function of
+// (counter, key), two hash rounds with the key mixed in before each. The
+// stream does not depend on how the index space is split, and any element
+// can be regenerated on its own.
+uint64 rng_u32(uint64 counter, unsigned int key)
+{
+    uint64 x = counter ^ key;
+    HASH_U32(x);
+    x = x ^ (key + RNG_WEYL);
+    HASH_U32(x);
+    return x;
+}
+
+#endif // COUNTER_RNG_H
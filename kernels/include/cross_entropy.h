@@ -0,0 +1,174 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include "kernel_config.h"
+
+// Fused log-softmax + cross-entropy over the classes of dim 0.
+//
+// forward  : lse[n]  = log(sum(exp(logits[:, n])))   (one online pass)
+//            loss[n] = lse[n] - logits[target[n], n]
+//            reduce  : loss[0] += scale * loss[n], atomically, loss must be zeroed
+//            scale is 1 for 'sum' and 1/N for 'mean'
+// BACKWARD : gradLogits = (softmax(logits) - onehot(target)) * gradLoss * scale
+//            softmax comes from the lse saved by the forward pass. Every vector
+//            is read before it is written, so gradLogits may alias logits.
+//
+// lse, loss and gradLoss are f32 for both data types.
+
+// running max of the online logsumexp before the first element, finite so that
+// exp(max - newMax) never sees -inf - -inf
+#define CE_LOWEST_F32           -3.0e38f
+
+#if defined(BACKWARD)
+// vectors of dim 0 handled by one index space member
+#define CE_BWD_VECTORS          4
+
+void main(tensor logits,
+          tensor targets,
+          tensor lse,
+          tensor gradLoss,
+          tensor gradLogits,
+          float scale,
+          int reduce)
+#else
+void main(tensor logits,
+          tensor targets,
+          tensor loss,
+          tensor lse,
+          float scale,
+          int reduce)
+#endif
+{
+    const int depth = 0;
+    const int row   = 1;
+
+    const int5 index_space_start = get_index_space_offset();
+    const int5 index_space_end = get_index_space_size() + index_space_start;
+
+    const int depthEnd = get_dim_size(logits, depth);
+#if defined(BACKWARD)
+    const int depthStep  = VECTOR_SIZE * CE_BWD_VECTORS;
+    const int depthStart = index_space_start[depth] * depthStep;
+    const int depthLimit = index_space_end[depth] * depthStep;
+    const int depthStop  = depthLimit < depthEnd ? depthLimit : depthEnd;
+#endif
+
+    // row
+    const int rowStep  = 1;
+    const int rowStart = index_space_start[row];
+    const int rowEnd   = index_space_end[row];
+
+    const ACC_VECTOR laneId = v_lane_id_acc();
+    const uint64 negInfBits = 0xff800000;
+    const float64 negInf = *((float64*)&negInfBits);
+
+    int5 coords    = {0, 0, 0, 0, 0};
+    int5 rowCoords = {0, 0, 0, 0, 0};
+
+    for (int r = rowStart; r < rowEnd; r += rowStep)
+    {
+        coords[row] = r;
+        rowCoords[0] = r;
+        const float target = (float)s_i32_ld_g((__global__ int*)gen_addr(rowCoords, targets));
+
+#if defined(BACKWARD)
+        const float rowLse = s_f32_ld_g((__global__ float*)gen_addr(rowCoords, lse));
+        int5 gradCoords = {reduce ? 0 : r, 0, 0, 0, 0};
+        const float g = s_f32_ld_g((__global__ float*)gen_addr(gradCoords, gradLoss)) * scale;
+
+        for (int d = depthStart; d < depthStop; d += VECTOR_SIZE)
+        {
+            coords[depth] = d;
+            ACC_VECTOR x = v_to_acc(v_ld_tnsr_i(coords, logits));
+            ACC_VECTOR y;
+            #pragma unroll(ACC_PARTS)
+            for (int p = 0; p < ACC_PARTS; p++)
+            {
+                float64 idx = acc_part(laneId, p) + (float)d;
+                float64 prob = exp_f32(acc_part(x, p) - rowLse);
+                prob = v_f32_sel_eq_f32_b(idx, target, prob - 1.0f, prob);
+                acc_set_part(y, p, prob * g);
+            }
+            st_tnsr_i_v(coords, gradLogits, v_from_acc(y));
+        }
+#else
+        // online logsumexp: every lane keeps its max and the sum scaled to it
+        float64 runMax[ACC_PARTS];
+        float64 runSum[ACC_PARTS];
+        float64 targetLogit[ACC_PARTS];
+        #pragma unroll(ACC_PARTS)
+        for (int p = 0; p < ACC_PARTS; p++)
+        {
+            runMax[p] = CE_LOWEST_F32;
+            runSum[p] = 0.0f;
+            targetLogit[p] = 0.0f;
+        }
+
+        for (int d = 0; d < depthEnd; d += VECTOR_SIZE)
+        {
+            coords[depth] = d;
+            ACC_VECTOR x = v_to_acc(v_ld_tnsr_i(coords, logits));
+            #pragma unroll(ACC_PARTS)
+            for (int p = 0; p < ACC_PARTS; p++)
+            {
+                float64 idx = acc_part(laneId, p) + (float)d;
+                // classes past the row end do not contribute
+                float64 xp = v_f32_sel_geq_f32_b(idx, (float)depthEnd, negInf, acc_part(x, p));
+                float64 newMax = v_f32_max_b(runMax[p], xp);
+                runSum[p] = runSum[p] * exp_f32(runMax[p] - newMax) + exp_f32(xp - newMax);
+                runMax[p] = newMax;
+                targetLogit[p] = v_f32_sel_eq_f32_b(idx, target, xp, targetLogit[p]);
+            }
+        }
+
+        // merge the lanes
+        float64 rowMax = runMax[0];
+        #pragma unroll(ACC_PARTS)
+        for (int p = 1; p < ACC_PARTS; p++)
+        {
+            rowMax = v_f32_max_b(rowMax, runMax[p]);
+        }
+        rowMax = v_f32_reduce_max(rowMax);
+
+        float64 rowSum = 0.0f;
+        float64 rowTarget = 0.0f;
+        #pragma unroll(ACC_PARTS)
+        for (int p = 0; p < ACC_PARTS; p++)
+        {
+            rowSum += runSum[p] * exp_f32(runMax[p] - rowMax);
+            rowTarget += targetLogit[p];
+        }
+        rowSum = v_f32_reduce_add(rowSum);
+        rowTarget = v_f32_reduce_add(rowTarget);
+
+        float64 rowLse = rowMax + log_f32(rowSum);
+        float64 rowLoss = rowLse - rowTarget;
+
+        v_f32_st_tnsr_partial(rowCoords, lse, rowLse, 0, 0);
+        if (reduce)
+        {
+            // lanes past element 0 are clipped by the {1} loss tensor
+            int5 lossCoords = {0, 0, 0, 0, 0};
+            v_f32_st_tnsr_rmw(lossCoords, loss, rowLoss * scale,
+                              MkRMW(e_rmw_fp32, e_rmw_add, e_rmw_atomic, e_tnsr_dt_srf), 0, 1, 0);
+        }
+        else
+        {
+            v_f32_st_tnsr_partial(rowCoords, loss, rowLoss, 0, 0);
+        }
+#endif
+    }
+}
@@ -0,0 +1,187 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+#include "kernel_config.h"
+#include "counter_rng.h"
+
+// Dropout with the random stream generated on the fly. Element e (linear
+// index over the whole tensor) is dropped when rng_u32(offset + e, hash(seed))
+// is below threshold, kept elements are multiplied by scale. The backward
+// regenerates the same stream with this kernel applied to dY, or reads the
+// mask written by the forward.
+//
+// MASK_OUT writes the keep mask, MASK_IN reads it instead of generating the
+// stream. The mask has the layout of relu_mask.h: bit j of mask word (lane l,
+// d) is element j * VECTOR_SIZE + l of the 2048 element block of dim 0 that
+// starts at d / VECTOR_SIZE * 2048.
+
+#if defined(FLOAT32)
+    #define MASK_VECTOR                     int64
+    #define MASK_SCALAR                     int
+    #define MASK_BITS                       32
+    #define v_mask_ld_tnsr(c, t)            v_i32_ld_tnsr_b(c, t)
+    #define v_mask_st_tnsr(c, t, v)         v_i32_st_tnsr(c, t, v)
+    #define v_sel_mask_eq(m, s, a, b)       v_f32_sel_eq_i32_b(m, s, a, b)
+#elif defined(BFLOAT16)
+    #define MASK_VECTOR                     short128
+    #define MASK_SCALAR                     short
+    #define MASK_BITS                       16
+    #define v_mask_ld_tnsr(c, t)            v_i16_ld_tnsr_b(c, t)
+    #define v_mask_st_tnsr(c, t, v)         v_i16_st_tnsr(c, t, v)
+    #define v_sel_mask_eq(m, s, a, b)       v_bf16_sel_eq_i16_b(m, s, a, b)
+#endif
+
+// all ones in the kept lanes of the vector whose lane 0 is counter
+MASK_VECTOR keep_lanes(unsigned int counter, uint64 laneId, unsigned int key, unsigned int threshold)
+{
+#if defined(FLOAT32)
+    uint64 rnd = rng_u32(laneId + counter, key);
+    uint64 keep = v_u32_sel_less_u32_b(rnd, threshold, 0, 0xffffffff);
+    return *((int64*)&keep);
+#else
+    // i16 lane 2l is the low half of u32 lane l, 2l + 1 the high half
+    uint64 even = rng_u32((laneId << 1) + counter, key);
+    uint64 odd  = rng_u32((laneId << 1) + (counter + 1), key);
+    uint64 keep = v_u32_sel_less_u32_b(even, threshold, 0, 0x0000ffff);
+    keep = keep | v_u32_sel_less_u32_b(odd, threshold, 0, 0xffff0000);
+    return *((short128*)&keep);
+#endif
+}
+
+#if defined(MASK_IN)
+void main(tensor ifm, tensor mask, tensor ofm,
+#elif defined(MASK_OUT)
+void main(tensor ifm, tensor ofm, tensor mask,
+#else
+void main(tensor ifm, tensor ofm,
+#endif
+          unsigned int seed,
+          unsigned int offset,
+          unsigned int threshold,
+          float scale)
+{
+    const int depth = 0;
+    const int width = 1;
+    const int height = 2;
+    const int batch = 3;
+    const int fifthDim = 4;
+
+    const int5 indexSpaceStart = get_index_space_offset();
+    const int5 indexSpaceEnd = get_index_space_size() + indexSpaceStart;
+
+    // DEPTH, one mask vector per member
+    const int depthStep = VECTOR_SIZE;
+    const int depthStart = indexSpaceStart[depth] * depthStep;
+    const int depthEnd = indexSpaceEnd[depth] * depthStep;
+
+    // WIDTH
+    const int widthStep = 1;
+    const int widthStart = indexSpaceStart[width];
+    const int widthEnd = indexSpaceEnd[width];
+
+    // HEIGHT
+    const int heightStep = 1;
+    const int heightStart = indexSpaceStart[height];
+    const int heightEnd = indexSpaceEnd[height];
+
+    // BATCH
+    const int batchStep = 1;
+    const int batchStart = indexSpaceStart[batch];
+    const int batchEnd = indexSpaceEnd[batch];
+
+    // fifthDim
+    const int fifthDimStep = 1;
+    const int fifthDimStart = indexSpaceStart[fifthDim];
+    const int fifthDimEnd = indexSpaceEnd[fifthDim];
+
+#if !defined(MASK_IN)
+    const unsigned int depthSize  = get_dim_size(ifm, depth);
+    const unsigned int widthSize  = get_dim_size(ifm, width);
+    const unsigned int heightSize = get_dim_size(ifm, height);
+    const unsigned int batchSize  = get_dim_size(ifm, batch);
+
+    unsigned int key = seed;
+    HASH_U32(key);
+
+    const uint64 laneId = read_lane_id_4b_b();
+#endif
+    const SCALAR scaleS = (SCALAR)scale;
+
+    int5 maskCoords = {0, 0, 0, 0, 0};
+    int5 dataCoords = {0, 0, 0, 0, 0};
+
+    #pragma loop_taken
+    for (int d = depthStart; d < depthEnd; d += depthStep)
+    {
+        maskCoords[depth] = d;
+        const int dataStart = d * MASK_BITS;
+
+        #pragma loop_taken
+        for (int f = fifthDimStart; f < fifthDimEnd; f += fifthDimStep)
+        {
+            maskCoords[fifthDim] = f;   dataCoords[fifthDim] = f;
+
+            #pragma loop_taken
+            for (int b = batchStart; b < batchEnd; b += batchStep)
+            {
+                maskCoords[batch] = b;   dataCoords[batch] = b;
+
+                #pragma loop_taken
+                for (int h = heightStart; h < heightEnd; h += heightStep)
+                {
+                    maskCoords[height] = h;   dataCoords[height] = h;
+
+                    #pragma loop_taken
+                    for (int w = widthStart; w < widthEnd; w += widthStep)
+                    {
+                        maskCoords[width] = w;   dataCoords[width] = w;
+                        dataCoords[depth] = dataStart;
+#if defined(MASK_IN)
+                        MASK_VECTOR bits = v_mask_ld_tnsr(maskCoords, mask);
+#else
+                        // counter of the first element of the block
+                        unsigned int counter = offset + dataStart +
+                            (((f * batchSize + b) * heightSize + h) * widthSize + w) * depthSize;
+#if defined(MASK_OUT)
+                        MASK_VECTOR bits = 0;
+#endif
+#endif
+
+                        #pragma unroll 4
+                        for (int j = 0; j < MASK_BITS; j++)
+                        {
+                            VECTOR x = v_ld_tnsr_i(dataCoords, ifm);
+#if defined(MASK_IN)
+                            MASK_VECTOR keep = bits & (MASK_SCALAR)(1 << j);
+#else
+                            MASK_VECTOR keep = keep_lanes(counter, laneId, key, threshold);
+                            counter += VECTOR_SIZE;
+#if defined(MASK_OUT)
+                            bits |= keep & (MASK_SCALAR)(1 << j);
+#endif
+#endif
+                            VECTOR o = v_sel_mask_eq(keep, 0, (SCALAR)0.0, x * scaleS);
+                            st_tnsr_i_v(dataCoords, ofm, o);
+                            dataCoords[depth] += VECTOR_SIZE;
+                        }
+#if defined(MASK_OUT)
+                        v_mask_st_tnsr(maskCoords, mask, bits);
+#endif
+                    }
+                }
+            }
+        }
+    }
+}
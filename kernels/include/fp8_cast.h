@@ -0,0 +1,178 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include "fp8_linear.h"
+#if defined(BFLOAT16)
+#include "bf16_linear.h"
+#endif
+
+// Scaled casts between f32 / bf16 and fp8, FP8_143 and BFLOAT16 pick the
+// formats, DEQUANT the direction:
+//
+//   quant   : y = saturate(x * scale), amax = max(amax, max|x|)
+//   dequant : y = x * scaleInv
+//
+// scale / scaleInv is a {1} f32 tensor so that delayed scaling can keep it
+// on the device. amax is a {1} f32 tensor, every invocation merges its
+// maximum with a single atomic RMW max, so it must be zeroed by the caller
+// and also collects the amax of several launches. The amax is taken before
+// scaling to give the next step's scale directly.
+
+#if defined(DEQUANT)
+void main(tensor ifm,
+          tensor scaleInvTensor,
+          tensor ofm)
+#else
+void main(tensor ifm,
+          tensor scaleTensor,
+          tensor ofm,
+          tensor amaxTensor)
+#endif
+{
+    const int depth  = 0;
+    const int width  = 1;
+    const int height = 2;
+    const int batch  = 3;
+    const int fifthDim = 4;
+
+    const int5 index_space_start = get_index_space_offset();
+    const int5 index_space_end = get_index_space_size() + index_space_start;
+
+    // depth, one fp8 vector of 256 elements per member
+    const int depthStep  = 256;
+    const int depthStart = index_space_start[depth] * depthStep;
+    const int depthEnd   = index_space_end[depth] * depthStep;
+
+    // width
+    const int widthStep  = 1;
+    const int widthStart = index_space_start[width] * widthStep;
+    const int widthEnd   = index_space_end[width] * widthStep;
+
+    // height
+    const int heightStep  = 1;
+    const int heightStart = index_space_start[height] * heightStep;
+    const int heightEnd   = index_space_end[height] * heightStep;
+
+    // batch
+    const int batchStep  = 1;
+    const int batchStart = index_space_start[batch] * batchStep;
+    const int batchEnd   = index_space_end[batch] * batchStep;
+
+    // fifthDim
+    const int fifthDimStep  = 1;
+    const int fifthDimStart = index_space_start[fifthDim] * fifthDimStep;
+    const int fifthDimEnd   = index_space_end[fifthDim] * fifthDimStep;
+
+    int5 scalarCoords = {0, 0, 0, 0, 0};
+#if defined(DEQUANT)
+    const float scale = s_f32_ld_g((__global__ float*)gen_addr(scalarCoords, scaleInvTensor));
+#else
+    const float scale = s_f32_ld_g((__global__ float*)gen_addr(scalarCoords, scaleTensor));
+    // out of bound lanes load as zero and leave the maximum alone
+    float64 amax = 0.0f;
+#endif
+
+    int5 coords = {0, 0, 0, 0, 0};
+
+    for (int f = fifthDimStart; f < fifthDimEnd; f += fifthDimStep)
+    {
+        coords[fifthDim] = f;
+        for (int b = batchStart; b < batchEnd; b += batchStep)
+        {
+            coords[batch] = b;
+            for (int h = heightStart; h < heightEnd; h += heightStep)
+            {
+                coords[height] = h;
+                for (int w = widthStart; w < widthEnd; w += widthStep)
+                {
+                    coords[width] = w;
+                    for (int d = depthStart; d < depthEnd; d += depthStep)
+                    {
+                        float256 x;
+#if defined(DEQUANT)
+                        coords[depth] = d;
+                        x = byte_to_f32_linear(v_byte_ld_tnsr_b(coords, ifm));
+
+                        x.v1 = x.v1 * scale;
+                        x.v2 = x.v2 * scale;
+                        x.v3 = x.v3 * scale;
+                        x.v4 = x.v4 * scale;
+
+    #if defined(BFLOAT16)
+                        float128 lo = {x.v1, x.v2};
+                        float128 hi = {x.v3, x.v4};
+                        st_tnsr_bf16_linear(coords, ofm, lo);
+                        coords[depth] = d + 128;
+                        st_tnsr_bf16_linear(coords, ofm, hi);
+    #else
+                        v_f32_st_tnsr(coords, ofm, x.v1);
+                        coords[depth] = d + 64;
+                        v_f32_st_tnsr(coords, ofm, x.v2);
+                        coords[depth] = d + 128;
+                        v_f32_st_tnsr(coords, ofm, x.v3);
+                        coords[depth] = d + 192;
+                        v_f32_st_tnsr(coords, ofm, x.v4);
+    #endif
+#else
+    #if defined(BFLOAT16)
+                        coords[depth] = d;
+                        float128 lo = bf16_to_f32_linear(v_bf16_ld_tnsr_b(coords, ifm));
+                        coords[depth] = d + 128;
+                        float128 hi = bf16_to_f32_linear(v_bf16_ld_tnsr_b(coords, ifm));
+                        x.v1 = lo.v1;
+                        x.v2 = lo.v2;
+                        x.v3 = hi.v1;
+                        x.v4 = hi.v2;
+    #else
+                        coords[depth] = d;
+                        x.v1 = v_f32_ld_tnsr_b(coords, ifm);
+                        coords[depth] = d + 64;
+                        x.v2 = v_f32_ld_tnsr_b(coords, ifm);
+                        coords[depth] = d + 128;
+                        x.v3 = v_f32_ld_tnsr_b(coords, ifm);
+                        coords[depth] = d + 192;
+                        x.v4 = v_f32_ld_tnsr_b(coords, ifm);
+    #endif
+                        // amax rides along with the cast instead of a second read
+                        amax = v_f32_max_b(amax, v_f32_abs_b(x.v1));
+                        amax = v_f32_max_b(amax, v_f32_abs_b(x.v2));
+                        amax = v_f32_max_b(amax, v_f32_abs_b(x.v3));
+                        amax = v_f32_max_b(amax, v_f32_abs_b(x.v4));
+
+                        // saturate instead of overflowing to inf / NaN
+                        x.v1 = v_f32_min_b(v_f32_max_b(x.v1 * scale, -FP8_MAX), FP8_MAX);
+                        x.v2 = v_f32_min_b(v_f32_max_b(x.v2 * scale, -FP8_MAX), FP8_MAX);
+                        x.v3 = v_f32_min_b(v_f32_max_b(x.v3 * scale, -FP8_MAX), FP8_MAX);
+                        x.v4 = v_f32_min_b(v_f32_max_b(x.v4 * scale, -FP8_MAX), FP8_MAX);
+
+                        coords[depth] = d;
+                        st_tnsr_byte_linear(coords, ofm, x);
+#endif
+                    }
+                }
+            }
+        }
+    }
+
+#if !defined(DEQUANT)
+    // lane 0 carries the maximum, the other lanes are clipped by the {1}
+    // amax tensor
+    amax = v_f32_reduce_max(amax);
+    int5 amaxCoords = {0, 0, 0, 0, 0};
+    v_f32_st_tnsr_rmw(amaxCoords, amaxTensor, amax,
+                      MkRMW(e_rmw_fp32, e_rmw_max, e_rmw_atomic, e_tnsr_dt_srf), 0, 1, 0);
+#endif
+}
@@ -0,0 +1,41 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+// Selects the fp8 type for byte_linear.h. FP8_143 selects the 1-4-3 (E4M3)
+// format, otherwise 1-5-2 (E5M2). Both follow the Gaudi2 encoding with the
+// top exponent reserved, so the largest finite values are 240 and 57344.
+
+#if defined(FP8_143)
+#define BYTE_VECTOR                     minihalf256
+#define FP8_MAX                         240.0f
+#define v_byte_ld_tnsr_b                v_h8_ld_tnsr_b
+#define v_byte_st_tnsr                  v_h8_st_tnsr
+#define v_byte_unpack_b                 v_h8_unpack_b
+#define v_byte_mov_dual_group_b         v_h8_mov_dual_group_b
+#define v_convert_byte_to_f32(x)        v_convert_h8_to_f32_all_b(x).v1
+#define v_convert_f32_to_byte(x)        v_convert_f32_to_h8_all_b(x, SW_RHNE, (minihalf256)0)
+#else
+#define BYTE_VECTOR                     minifloat256
+#define FP8_MAX                         57344.0f
+#define v_byte_ld_tnsr_b                v_f8_ld_tnsr_b
+#define v_byte_st_tnsr                  v_f8_st_tnsr
+#define v_byte_unpack_b                 v_f8_unpack_b
+#define v_byte_mov_dual_group_b         v_f8_mov_dual_group_b
+#define v_convert_byte_to_f32(x)        v_convert_f8_to_f32_all_b(x).v1
+#define v_convert_f32_to_byte(x)        v_convert_f32_to_f8_all_b(x, SW_RHNE, (minifloat256)0)
+#endif
+
+#include "byte_linear.h"
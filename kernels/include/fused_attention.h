@@ -0,0 +1,320 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include "kernel_config.h"
+#include "vlm_transpose.h"
+
+// Fused attention for short sequences and small heads, f32:
+//
+//   out = softmax(scale * q k^T + mask) v
+//
+// q, out   : {headDim, qLen, heads, batch}
+// k, v     : {headDim, kvLen, heads, batch}
+// kvLengths: ATTENTION_KV_LENGTHS, i32 {batch} valid keys of every batch
+//            entry, the rest of the cache is ignored
+//
+// Every member owns a block of ATTENTION_BLOCK_Q queries of one head, the
+// lanes run over the head dim for q and out and over the keys for scores.
+// Keys go in tiles of VECTOR_SIZE staged in VLM, and every tile is used by
+// all queries of the block:
+//   1. the k rows of the tile are loaded and transposed in place, row d of
+//      vlmTile then holds element d of all its keys and
+//        s = sum_d q[d] * vlmTile[d]
+//      is a chain of headDim MACs with no reduction
+//   2. the online softmax of every query updates its running max and sum
+//      with one lane reduction each:
+//        m' = max(m, max(s)),  p = exp(s - m'),  l' = l * exp(m - m') + sum(p)
+//   3. the v rows of the tile overwrite the k rows and
+//        o = o * exp(m - m') + sum_j p[j] * vlmTile[j]
+// The element broadcasts of q[d] and p[j] are a MOV_DUAL_GROUP of the dual
+// group holding them to the other three, once per DG_SIZE elements, and a
+// SHUFFLE of that lane in every dual group, with no scalar global load.
+//
+// The output of every query, ATTENTION_HEAD_VECTORS vectors, stays in
+// registers for the whole key loop, and so do the probabilities of the
+// tile. The running max and sum go to VLM, all VLM comes to 168 vectors and
+// leaves the LUT of exp_f32 and v_reciprocal_f32 free.
+//
+// At the end o is scaled by 1 / l and stored with full vector stores. With
+// causal != 0 key j of query q is visible for j <= q + causalOffset and the
+// key tiles past the last query of the block are skipped. A query with no
+// visible key gets zeros.
+
+// queries per member; o, p and the row broadcasts stay within the 40
+// vector registers
+#define ATTENTION_BLOCK_Q       8
+// head dim limit, in vectors for o
+#define ATTENTION_MAX_HEAD_DIM  128
+#define ATTENTION_HEAD_VECTORS  (ATTENTION_MAX_HEAD_DIM / VECTOR_SIZE)
+
+#define ATTENTION_LOWEST_F32    -3.0e38f
+
+// k^T of a key tile, then its v rows, key j and head vector h at
+// j * ATTENTION_HEAD_VECTORS + h
+__local__ VECTOR vlmTile[ATTENTION_MAX_HEAD_DIM];
+__local__ VECTOR vlmRowMax[ATTENTION_BLOCK_Q];
+__local__ VECTOR vlmRowSum[ATTENTION_BLOCK_Q];
+
+// SHUFFLE controls, vlmCtlLane[x] takes lane x of every dual group
+__local__ uchar256 vlmCtlLane[DG_SIZE];
+
+void attention_init_ctl()
+{
+    const LANE_VECTOR all = 1;
+    for (int x = 0; x < DG_SIZE; x++)
+    {
+        const LANE_VECTOR src = x;
+        LANE_VECTOR ctl = shuffle_ctl(src, all);
+        vlmCtlLane[x] = *((uchar256*)&ctl);
+    }
+}
+
+// Copy of a with dual group c (a literal) in all four dual groups.
+#define BROADCAST_DUAL_GROUP(a, c, out)                                         \
+    {                                                                           \
+        out = a;                                                                \
+        if ((c) != 0) out = v_mov_dual_group_b(a, c, 0, out);                   \
+        if ((c) != 1) out = v_mov_dual_group_b(a, c, 1, out);                   \
+        if ((c) != 2) out = v_mov_dual_group_b(a, c, 2, out);                   \
+        if ((c) != 3) out = v_mov_dual_group_b(a, c, 3, out);                   \
+    }
+
+// Scores of one query over head dims t + c * DG_SIZE .. + DG_SIZE - 1, qRow
+// holds head dims t .. t + VECTOR_SIZE - 1 of the query.
+#define ATTENTION_SCORES(qRow, t, c)                                            \
+    if ((t) + (c) * DG_SIZE < headDim)                                          \
+    {                                                                           \
+        VECTOR qDg;                                                             \
+        BROADCAST_DUAL_GROUP(qRow, c, qDg);                                     \
+        _Pragma("unroll(4)")                                                    \
+        for (int x = 0; x < DG_SIZE; x++)                                       \
+        {                                                                       \
+            const float64 qd = v_shuffle_b(qDg, vlmCtlLane[x], qDg);            \
+            s = v_f32_mac_b(qd, vlmTile[(t) + (c) * DG_SIZE + x], s);           \
+        }                                                                       \
+    }
+
+// Output of query q over keys j0 + c * DG_SIZE .. + DG_SIZE - 1 of the tile.
+#define ATTENTION_VALUES(q, c)                                                  \
+    if (j0 + (c) * DG_SIZE < blockKeyEnd)                                       \
+    {                                                                           \
+        VECTOR pDg;                                                             \
+        BROADCAST_DUAL_GROUP(p[q], c, pDg);                                     \
+        _Pragma("unroll(2)")                                                    \
+        for (int x = 0; x < DG_SIZE; x++)                                       \
+        {                                                                       \
+            const float64 pj = v_shuffle_b(pDg, vlmCtlLane[x], pDg);            \
+            const int row = ((c) * DG_SIZE + x) * ATTENTION_HEAD_VECTORS;       \
+            _Pragma("unroll(ATTENTION_HEAD_VECTORS)")                           \
+            for (int v = 0; v < ATTENTION_HEAD_VECTORS; v++)                    \
+            {                                                                   \
+                o[q][v] = v_f32_mac_b(pj, vlmTile[row + v], o[q][v]);           \
+            }                                                                   \
+        }                                                                       \
+    }
+
+// In place transpose of rows base .. base + VECTOR_SIZE - 1 of tile.
+#define TRANSPOSE_TILE(tile, base)                                              \
+    {                                                                           \
+        TRANSPOSE_DIAGONAL(tile, base);                                         \
+        for (int x = 0; x < DG_SIZE; x++)                                       \
+        {                                                                       \
+            VECTOR y0, y1, y2, y3;                                              \
+            TRANSPOSE_GATHER(tile, base, x, y0, y1, y2, y3);                    \
+            tile[base + 0 * DG_SIZE + x] = y0;                                  \
+            tile[base + 1 * DG_SIZE + x] = y1;                                  \
+            tile[base + 2 * DG_SIZE + x] = y2;                                  \
+            tile[base + 3 * DG_SIZE + x] = y3;                                  \
+        }                                                                       \
+    }
+
+void main(tensor qTensor,
+          tensor kTensor,
+          tensor vTensor,
+#if defined(ATTENTION_KV_LENGTHS)
+          tensor kvLengths,
+#endif
+          tensor ofm,
+          float scale,
+          int causal,
+          int causalOffset)
+{
+    const int depth  = 0;
+    const int seq    = 1;
+    const int head   = 2;
+    const int batch  = 3;
+
+    const int5 index_space_start = get_index_space_offset();
+    const int5 index_space_end = get_index_space_size() + index_space_start;
+
+    // index space: query blocks, heads, batch
+    const int queryStep  = ATTENTION_BLOCK_Q;
+    const int queryStart = index_space_start[0] * queryStep;
+    const int queryEnd   = index_space_end[0]   * queryStep;
+
+    const int headDim = get_dim_size(qTensor, depth);
+    // head dim in whole vectors, the lanes past headDim stay zero
+    const int headVectors = (headDim + VECTOR_SIZE - 1) / VECTOR_SIZE;
+
+    const uint64 negInfBits = 0xff800000;
+    const float64 negInf = *((float64*)&negInfBits);
+    const float64 laneId = v_lane_id_acc();
+    const float64 zero = 0.0f;
+
+    transpose_init_ctl();
+    attention_init_ctl();
+
+    int5 coords = {0, 0, 0, 0, 0};
+
+    for (int b = index_space_start[2]; b < index_space_end[2]; b++)
+    {
+        coords[batch] = b;
+
+        int keyEnd = get_dim_size(kTensor, seq);
+#if defined(ATTENTION_KV_LENGTHS)
+        int5 lengthCoords = {b, 0, 0, 0, 0};
+        __global__ int* lengthAddr = (__global__ int*)gen_addr(lengthCoords, kvLengths);
+        keyEnd = s_i32_min(s_i32_ld_g(lengthAddr), keyEnd);
+#endif
+
+        for (int h = index_space_start[1]; h < index_space_end[1]; h++)
+        {
+            coords[head] = h;
+
+            for (int qb = queryStart; qb < queryEnd; qb += queryStep)
+            {
+                // keys this block can see
+                int blockKeyEnd = keyEnd;
+                if (causal != 0)
+                {
+                    blockKeyEnd = s_i32_min(qb + queryStep + causalOffset, keyEnd);
+                }
+
+                float64 o[ATTENTION_BLOCK_Q][ATTENTION_HEAD_VECTORS];
+                #pragma unroll(ATTENTION_BLOCK_Q)
+                for (int q = 0; q < ATTENTION_BLOCK_Q; q++)
+                {
+                    vlmRowMax[q] = ATTENTION_LOWEST_F32;
+                    vlmRowSum[q] = zero;
+                    #pragma unroll(ATTENTION_HEAD_VECTORS)
+                    for (int v = 0; v < ATTENTION_HEAD_VECTORS; v++)
+                    {
+                        o[q][v] = zero;
+                    }
+                }
+
+                for (int j0 = 0; j0 < blockKeyEnd; j0 += VECTOR_SIZE)
+                {
+                    // k^T of the tile; keys past the tensor and head dims
+                    // past headDim read zeros
+                    for (int t = 0; t < headVectors * VECTOR_SIZE; t += VECTOR_SIZE)
+                    {
+                        coords[depth] = t;
+                        coords[seq] = j0;
+                        #pragma unroll(4)
+                        for (int r = 0; r < VECTOR_SIZE; r++)
+                        {
+                            vlmTile[t + r] = v_f32_ld_tnsr_b(coords, kTensor);
+                            coords[seq] += 1;
+                        }
+                        TRANSPOSE_TILE(vlmTile, t);
+                    }
+
+                    const float64 keyIdx = laneId + (float)j0;
+
+                    float64 p[ATTENTION_BLOCK_Q];
+                    #pragma unroll(ATTENTION_BLOCK_Q)
+                    for (int q = 0; q < ATTENTION_BLOCK_Q; q++)
+                    {
+                        float64 s = zero;
+                        coords[seq] = qb + q;
+                        for (int t = 0; t < headVectors * VECTOR_SIZE; t += VECTOR_SIZE)
+                        {
+                            coords[depth] = t;
+                            const float64 qRow = v_f32_ld_tnsr_b(coords, qTensor) * scale;
+                            ATTENTION_SCORES(qRow, t, 0);
+                            ATTENTION_SCORES(qRow, t, 1);
+                            ATTENTION_SCORES(qRow, t, 2);
+                            ATTENTION_SCORES(qRow, t, 3);
+                        }
+
+                        // last visible key of the query
+                        int keyLimit = keyEnd - 1;
+                        if (causal != 0)
+                        {
+                            keyLimit = s_i32_min(qb + q + causalOffset, keyLimit);
+                        }
+                        s = v_f32_sel_grt_f32_b(keyIdx, (float)keyLimit, negInf, s);
+
+                        const float64 rowMax = vlmRowMax[q];
+                        const float64 tileMax = v_f32_max_b(v_f32_reduce_max(s), rowMax);
+                        const float64 alpha = exp_f32(rowMax - tileMax);
+                        p[q] = exp_f32(s - tileMax);
+                        vlmRowSum[q] = vlmRowSum[q] * alpha + v_f32_reduce_add(p[q]);
+                        vlmRowMax[q] = tileMax;
+
+                        #pragma unroll(ATTENTION_HEAD_VECTORS)
+                        for (int v = 0; v < ATTENTION_HEAD_VECTORS; v++)
+                        {
+                            o[q][v] = o[q][v] * alpha;
+                        }
+                    }
+
+                    // v rows of the tile over k^T
+                    for (int v = 0; v < headVectors; v++)
+                    {
+                        coords[depth] = v * VECTOR_SIZE;
+                        coords[seq] = j0;
+                        #pragma unroll(4)
+                        for (int r = 0; r < VECTOR_SIZE; r++)
+                        {
+                            vlmTile[r * ATTENTION_HEAD_VECTORS + v] = v_f32_ld_tnsr_b(coords, vTensor);
+                            coords[seq] += 1;
+                        }
+                    }
+
+                    #pragma unroll(ATTENTION_BLOCK_Q)
+                    for (int q = 0; q < ATTENTION_BLOCK_Q; q++)
+                    {
+                        ATTENTION_VALUES(q, 0);
+                        ATTENTION_VALUES(q, 1);
+                        ATTENTION_VALUES(q, 2);
+                        ATTENTION_VALUES(q, 3);
+                    }
+                }
+
+                // o / l, rows with no visible key stay zero; lanes past
+                // headDim and queries past qLen are clipped by the stores
+                #pragma unroll(ATTENTION_BLOCK_Q)
+                for (int q = 0; q < ATTENTION_BLOCK_Q; q++)
+                {
+                    const float64 rowSum = vlmRowSum[q];
+                    const float64 recip = v_f32_sel_grt_f32_b(rowSum, 0.0f, v_reciprocal_f32(rowSum), zero);
+                    coords[seq] = qb + q;
+                    #pragma unroll(ATTENTION_HEAD_VECTORS)
+                    for (int v = 0; v < ATTENTION_HEAD_VECTORS; v++)
+                    {
+                        if (v < headVectors)
+                        {
+                            coords[depth] = v * VECTOR_SIZE;
+                            v_f32_st_tnsr(coords, ofm, o[q][v] * recip);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,269 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+// Fused chain of elementwise ops over 1 to 4 inputs, run in f32 registers:
+// every input vector is loaded once, the op program runs on an accumulator
+// that starts as ifm0, and the result is stored once.
+//
+// The including file defines FUSED_INPUTS (1..4), IN_FLOAT32 or IN_BFLOAT16
+// for the inputs and OUT_FLOAT32 or OUT_BFLOAT16 for the ofm, a cast at the
+// end of the chain comes with the output type.
+//
+// Program, see FusedElementwiseGaudi2::FusedElementwiseParams:
+//   opCount      : number of ops
+//   op0..op11    : opcode in bits 0-7, operand in bits 8-15. The operand is
+//                  an input index for the *_INPUT ops, an index into
+//                  imm0..imm7 for the *_SCALAR ops and unused otherwise.
+//   bcastMasks   : 5 bits per input, bit d set when dim d of the input is
+//                  1 while the ofm dim is not. A broadcast FCD is splatted.
+
+#include "bf16_linear.h"
+
+// opcodes, as FusedElementwiseGaudi2::FusedOp_t
+#define FUSED_ADD_INPUT         0
+#define FUSED_SUB_INPUT         1
+#define FUSED_MUL_INPUT         2
+#define FUSED_MAX_INPUT         3
+#define FUSED_MIN_INPUT         4
+#define FUSED_ADD_SCALAR        5
+#define FUSED_MUL_SCALAR        6
+#define FUSED_MAX_SCALAR        7
+#define FUSED_MIN_SCALAR        8
+#define FUSED_RELU              9
+#define FUSED_RELU6             10
+
+#define FUSED_MAX_OPS           12
+#define FUSED_MAX_IMMS          8
+// elements of dim 0 per member, one float128
+#define FUSED_ELEMENTS          128
+
+__local__ int slmOps[FUSED_MAX_OPS];
+__local__ float slmImms[FUSED_MAX_IMMS];
+
+#if defined(IN_FLOAT32)
+#define LOAD_IN(coords, t, out) \
+    { \
+        int5 c = coords; \
+        out.v1 = v_f32_ld_tnsr_b(c, t); \
+        c[0] += 64; \
+        out.v2 = v_f32_ld_tnsr_b(c, t); \
+    }
+#define SPLAT_IN(coords, t, out) \
+    { \
+        float s = s_f32_ld_g(gen_addr(coords, t)); \
+        out.v1 = v_f32_mov_b(s); \
+        out.v2 = out.v1; \
+    }
+#endif
+
+#if defined(IN_BFLOAT16)
+#define LOAD_IN(coords, t, out) \
+    out = bf16_to_f32_linear(v_bf16_ld_tnsr_b(coords, t))
+#define SPLAT_IN(coords, t, out) \
+    { \
+        float s = (float)s_bf16_ld_g(gen_addr(coords, t)); \
+        out.v1 = v_f32_mov_b(s); \
+        out.v2 = out.v1; \
+    }
+#endif
+
+#if defined(OUT_FLOAT32)
+#define STORE_OUT(coords, t, x) \
+    { \
+        int5 c = coords; \
+        v_f32_st_tnsr(c, t, x.v1); \
+        c[0] += 64; \
+        v_f32_st_tnsr(c, t, x.v2); \
+    }
+#endif
+
+#if defined(OUT_BFLOAT16)
+#define STORE_OUT(coords, t, x) \
+    st_tnsr_bf16_linear(coords, t, x)
+#endif
+
+// coordinate of an input along dim, 0 when the input broadcasts it
+#define IN_COORD(mask, dim, o)  ((((mask) >> (dim)) & 1) ? 0 : (o))
+
+// load of input k for the current row, splats stay from the row setup
+#define LOAD_INPUT(k) \
+    if (((bcast##k) & 1) == 0) \
+    { \
+        ifmCoords##k[0] = d; \
+        LOAD_IN(ifmCoords##k, ifm##k, x##k); \
+    }
+
+// row setup of input k, dims 1-4 and the splat of a broadcast FCD
+#define SETUP_INPUT(k) \
+    ifmCoords##k[1] = IN_COORD(bcast##k, 1, ofmCoords[1]); \
+    ifmCoords##k[2] = IN_COORD(bcast##k, 2, ofmCoords[2]); \
+    ifmCoords##k[3] = IN_COORD(bcast##k, 3, ofmCoords[3]); \
+    ifmCoords##k[4] = IN_COORD(bcast##k, 4, ofmCoords[4]); \
+    if ((bcast##k) & 1) \
+    { \
+        ifmCoords##k[0] = 0; \
+        SPLAT_IN(ifmCoords##k, ifm##k, x##k); \
+    }
+
+float64 fused_op(int op, float64 acc, float64 in, float imm)
+{
+    float64 out = acc;
+    if (op == FUSED_ADD_INPUT)
+        out = acc + in;
+    else if (op == FUSED_SUB_INPUT)
+        out = acc - in;
+    else if (op == FUSED_MUL_INPUT)
+        out = acc * in;
+    else if (op == FUSED_MAX_INPUT)
+        out = v_f32_max_b(acc, in);
+    else if (op == FUSED_MIN_INPUT)
+        out = v_f32_min_b(acc, in);
+    else if (op == FUSED_ADD_SCALAR)
+        out = acc + imm;
+    else if (op == FUSED_MUL_SCALAR)
+        out = acc * imm;
+    else if (op == FUSED_MAX_SCALAR)
+        out = v_f32_max_b(acc, imm);
+    else if (op == FUSED_MIN_SCALAR)
+        out = v_f32_min_b(acc, imm);
+    else if (op == FUSED_RELU)
+        out = v_f32_max_b(acc, 0.0f);
+    else if (op == FUSED_RELU6)
+        out = v_f32_min_b(v_f32_max_b(acc, 0.0f), 6.0f);
+    return out;
+}
+
+void main(tensor ifm0,
+#if FUSED_INPUTS > 1
+          tensor ifm1,
+#endif
+#if FUSED_INPUTS > 2
+          tensor ifm2,
+#endif
+#if FUSED_INPUTS > 3
+          tensor ifm3,
+#endif
+          tensor ofm,
+          int opCount,
+          int bcastMasks,
+          int op0, int op1, int op2, int op3, int op4, int op5,
+          int op6, int op7, int op8, int op9, int op10, int op11,
+          float imm0, float imm1, float imm2, float imm3,
+          float imm4, float imm5, float imm6, float imm7)
+{
+    const int5 index_space_start = get_index_space_offset();
+    const int5 index_space_end = get_index_space_size() + index_space_start;
+
+    // the program is walked once per vector, SLM lets it be indexed
+    slmOps[0] = op0;  slmOps[1] = op1;  slmOps[2]  = op2;  slmOps[3]  = op3;
+    slmOps[4] = op4;  slmOps[5] = op5;  slmOps[6]  = op6;  slmOps[7]  = op7;
+    slmOps[8] = op8;  slmOps[9] = op9;  slmOps[10] = op10; slmOps[11] = op11;
+    slmImms[0] = imm0; slmImms[1] = imm1; slmImms[2] = imm2; slmImms[3] = imm3;
+    slmImms[4] = imm4; slmImms[5] = imm5; slmImms[6] = imm6; slmImms[7] = imm7;
+
+    const int depthStep  = FUSED_ELEMENTS;
+    const int depthStart = index_space_start[0] * depthStep;
+    const int depthEnd   = index_space_end[0] * depthStep;
+
+    const int bcast0 = bcastMasks & 0x1f;
+    int5 ifmCoords0 = {0, 0, 0, 0, 0};
+    float128 x0;
+#if FUSED_INPUTS > 1
+    const int bcast1 = (bcastMasks >> 5) & 0x1f;
+    int5 ifmCoords1 = {0, 0, 0, 0, 0};
+    float128 x1;
+#endif
+#if FUSED_INPUTS > 2
+    const int bcast2 = (bcastMasks >> 10) & 0x1f;
+    int5 ifmCoords2 = {0, 0, 0, 0, 0};
+    float128 x2;
+#endif
+#if FUSED_INPUTS > 3
+    const int bcast3 = (bcastMasks >> 15) & 0x1f;
+    int5 ifmCoords3 = {0, 0, 0, 0, 0};
+    float128 x3;
+#endif
+
+    int5 ofmCoords = {0, 0, 0, 0, 0};
+
+    for (int f = index_space_start[4]; f < index_space_end[4]; f++)
+    {
+        ofmCoords[4] = f;
+        for (int b = index_space_start[3]; b < index_space_end[3]; b++)
+        {
+            ofmCoords[3] = b;
+            for (int h = index_space_start[2]; h < index_space_end[2]; h++)
+            {
+                ofmCoords[2] = h;
+                for (int w = index_space_start[1]; w < index_space_end[1]; w++)
+                {
+                    ofmCoords[1] = w;
+
+                    SETUP_INPUT(0)
+#if FUSED_INPUTS > 1
+                    SETUP_INPUT(1)
+#endif
+#if FUSED_INPUTS > 2
+                    SETUP_INPUT(2)
+#endif
+#if FUSED_INPUTS > 3
+                    SETUP_INPUT(3)
+#endif
+
+                    for (int d = depthStart; d < depthEnd; d += depthStep)
+                    {
+                        ofmCoords[0] = d;
+
+                        LOAD_INPUT(0)
+#if FUSED_INPUTS > 1
+                        LOAD_INPUT(1)
+#endif
+#if FUSED_INPUTS > 2
+                        LOAD_INPUT(2)
+#endif
+#if FUSED_INPUTS > 3
+                        LOAD_INPUT(3)
+#endif
+
+                        float128 acc = x0;
+                        for (int i = 0; i < opCount; i++)
+                        {
+                            const int op = slmOps[i] & 0xff;
+                            const int arg = (slmOps[i] >> 8) & 0xff;
+
+                            float128 in = x0;
+#if FUSED_INPUTS > 1
+                            in = (arg == 1) ? x1 : in;
+#endif
+#if FUSED_INPUTS > 2
+                            in = (arg == 2) ? x2 : in;
+#endif
+#if FUSED_INPUTS > 3
+                            in = (arg == 3) ? x3 : in;
+#endif
+                            const float imm = slmImms[arg & (FUSED_MAX_IMMS - 1)];
+
+                            acc.v1 = fused_op(op, acc.v1, in.v1, imm);
+                            acc.v2 = fused_op(op, acc.v2, in.v2, imm);
+                        }
+
+                        STORE_OUT(ofmCoords, ofm, acc);
+                    }
+                }
+            }
+        }
+    }
+}
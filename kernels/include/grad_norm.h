@@ -0,0 +1,166 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include "kernel_config.h"
+
+// Global gradient norm statistics for clipping and dynamic loss scaling:
+//
+//   stats[0] += sum(g^2)
+//   stats[1] += number of inf / NaN elements of g
+//
+// stats is a {2} f32 tensor zeroed by the caller, every index space member
+// adds its partial sums with a single atomic RMW store. The norm is
+// sqrt(stats[0]). Non-finite elements are summed as they are, so stats[0] is
+// inf / NaN whenever stats[1] is not zero.
+//
+// GRAD_NORM_MULTI_TENSOR : grad is the flat 1D list of chunkSize element
+//                          chunks packed for the multi tensor AdamW step, so
+//                          a whole parameter list is reduced in one launch.
+//                          chunkTensor {numChunks} i32 holds the list index of
+//                          every chunk, and tensorStats {2, numTensors} f32
+//                          (also zeroed) collects the same pair per tensor.
+//                          Members flush one RMW per chunk they touch.
+
+// vectors of dim 0 handled by one index space member
+#define GRAD_NORM_VECTORS       4
+
+// v_f32_fclass_b classes of -inf, +inf, signaling and quiet NaN
+#define FCLASS_NON_FINITE       0x381
+
+// lane 0 carries the sum of squares, lane 1 the non-finite count, the other
+// lanes are clipped by the stats tensors
+float64 stats_lanes(float64 sumSq, float64 nonFinite)
+{
+    sumSq = v_f32_reduce_add(sumSq);
+    nonFinite = v_f32_reduce_add(nonFinite);
+    const float64 lane = v_convert_i32_to_f32_b((int64)read_lane_id_4b_b(), e_round_half_ne << 16);
+    return v_f32_sel_eq_f32_b(lane, 0.0f, sumSq, nonFinite);
+}
+
+void main(tensor grad,
+#if defined(GRAD_NORM_MULTI_TENSOR)
+          tensor chunkTensor,
+          tensor stats,
+          tensor tensorStats,
+          int chunkSize)
+#else
+          tensor stats)
+#endif
+{
+    const int depth  = 0;
+    const int width  = 1;
+    const int height = 2;
+    const int batch  = 3;
+
+    const int5 index_space_start = get_index_space_offset();
+    const int5 index_space_end = get_index_space_size() + index_space_start;
+
+    // depth
+    const int depthStep  = VECTOR_SIZE * GRAD_NORM_VECTORS;
+    const int depthStart = index_space_start[depth] * depthStep;
+    const int depthEnd   = index_space_end[depth] * depthStep;
+
+    // width
+    const int widthStep  = 1;
+    const int widthStart = index_space_start[width] * widthStep;
+    const int widthEnd   = index_space_end[width] * widthStep;
+
+    // height
+    const int heightStep  = 1;
+    const int heightStart = index_space_start[height] * heightStep;
+    const int heightEnd   = index_space_end[height] * heightStep;
+
+    // batch
+    const int batchStep  = 1;
+    const int batchStart = index_space_start[batch] * batchStep;
+    const int batchEnd   = index_space_end[batch] * batchStep;
+
+    int5 coords = {0, 0, 0, 0, 0};
+
+    // out of bound lanes load as zero and add nothing
+    float64 sumSq = 0.0f;
+    float64 nonFinite = 0.0f;
+
+#if defined(GRAD_NORM_MULTI_TENSOR)
+    // sumSq / nonFinite only hold the current chunk, the glue keeps chunkSize
+    // a multiple of depthStep and the packed list is 1D
+    float64 totalSq = 0.0f;
+    float64 totalNonFinite = 0.0f;
+    int chunk = depthStart / chunkSize;
+    int chunkEnd = (chunk + 1) * chunkSize;
+    int5 chunkCoords = {0, 0, 0, 0, 0};
+    int5 tensorCoords = {0, 0, 0, 0, 0};
+#endif
+
+    for (int b = batchStart; b < batchEnd; b += batchStep)
+    {
+        coords[batch] = b;
+        for (int h = heightStart; h < heightEnd; h += heightStep)
+        {
+            coords[height] = h;
+            for (int w = widthStart; w < widthEnd; w += widthStep)
+            {
+                coords[width] = w;
+                for (int d = depthStart; d < depthEnd; d += depthStep)
+                {
+                    #pragma unroll(GRAD_NORM_VECTORS)
+                    for (int j = 0; j < GRAD_NORM_VECTORS; j++)
+                    {
+                        coords[depth] = d + j * VECTOR_SIZE;
+                        ACC_VECTOR g = v_to_acc(v_ld_tnsr_i(coords, grad));
+                        #pragma unroll(ACC_PARTS)
+                        for (int p = 0; p < ACC_PARTS; p++)
+                        {
+                            float64 gp = acc_part(g, p);
+                            sumSq = v_f32_mac_b(gp, gp, sumSq);
+
+                            float64 fclass = v_f32_fclass_b(gp);
+                            int64 special = v_i32_and_b(*((int64*)&fclass), FCLASS_NON_FINITE);
+                            nonFinite += v_f32_sel_grt_f32_b(v_convert_i32_to_f32_b(special, e_round_half_ne << 16),
+                                                             0.0f, 1.0f, 0.0f);
+                        }
+                    }
+
+#if defined(GRAD_NORM_MULTI_TENSOR)
+                    const int next = d + depthStep;
+                    if (next >= chunkEnd || next >= depthEnd)
+                    {
+                        chunkCoords[0] = chunk;
+                        tensorCoords[1] = s_i32_ld_g((__global__ int*)gen_addr(chunkCoords, chunkTensor));
+                        v_f32_st_tnsr_rmw(tensorCoords, tensorStats, stats_lanes(sumSq, nonFinite),
+                                          MkRMW(e_rmw_fp32, e_rmw_add, e_rmw_atomic, e_tnsr_dt_srf), 0, 1, 0);
+                        totalSq += sumSq;
+                        totalNonFinite += nonFinite;
+                        sumSq = 0.0f;
+                        nonFinite = 0.0f;
+                        chunk++;
+                        chunkEnd += chunkSize;
+                    }
+#endif
+                }
+            }
+        }
+    }
+
+#if defined(GRAD_NORM_MULTI_TENSOR)
+    sumSq = totalSq;
+    nonFinite = totalNonFinite;
+#endif
+
+    int5 statsCoords = {0, 0, 0, 0, 0};
+    v_f32_st_tnsr_rmw(statsCoords, stats, stats_lanes(sumSq, nonFinite),
+                      MkRMW(e_rmw_fp32, e_rmw_add, e_rmw_atomic, e_tnsr_dt_srf), 0, 1, 0);
+}
@@ -54,6 +54,15 @@ typedef float                       SCALAR;
 #define v_mov_v_b(a, b, predicate, predicatePolarity)\
                 v_f32_mov_b(a, 0, b, predicate, predicatePolarity)
 #define v_add_v_v(a, b, st)            v_f32_add_b(a, b)
+// f32 accumulation: ACC_VECTOR holds VECTOR_SIZE lanes as ACC_PARTS float64 parts
+#define ACC_VECTOR                  float64
+#define ACC_PARTS                   1
+#define v_to_acc(a)                 (a)
+#define v_from_acc(a)               (a)
+#define acc_part(a, p)              (a)
+#define acc_set_part(a, p, v)       (a) = (v)
+// element offset of every lane, in ACC_VECTOR lane order
+#define v_lane_id_acc()             v_convert_i32_to_f32_b((int64)V_LANE_ID, e_round_half_ne << 16)
 #endif
 
 #if defined(BFLOAT16)
@@ -88,5 +97,42 @@ typedef bf16                        SCALAR;
 #define v_add_v_v_b(a, b, source, predicate, predicatePolarity) \
                 v_bf16_add_b(a, b, 0, source, predicate, predicatePolarity)
 #define v_ld_g_a(a)                 v_bf16_ld_g(a)             
+#define V_LANE_ID                   V_LANE_ID_16
+#define bv_u_cmp_geq_v_s(a, b)      from_bool128(v_u16_cmp_geq_b(a, b, 0, to_bool128((bool256){0})))
+#define v_mov_s_vb(a, b, c, d)      v_bf16_mov_vb(a, 0, b, to_bool128(c), d)
+// f32 accumulation: ACC_VECTOR holds VECTOR_SIZE lanes as ACC_PARTS float64 parts
+#define ACC_VECTOR                  float128
+#define ACC_PARTS                   2
+#define v_to_acc(a)                 v_convert_bf16_to_f32_all_b(a)
+#define v_from_acc(a)               v_convert_f32_to_bf16_all_b(a, SW_RHNE)
+#define acc_part(a, p)              ((p) == 0 ? (a).v1 : (a).v2)
+#define acc_set_part(a, p, v)       do { if ((p) == 0) (a).v1 = (v); else (a).v2 = (v); } while (0)
+// element offset of every lane, in ACC_VECTOR lane order
+#define v_lane_id_acc()             v_to_acc(v_convert_i16_to_bf16_b((short128)V_LANE_ID, e_round_half_ne << 16))
 
 #endif
+
+#if defined(INT32)
+#define VECTOR                      int64
+#define VECTOR_SIZE                 64
+typedef int                         SCALAR;
+#define v_ld_tnsr_i(a,b)            v_i32_ld_tnsr_b(a,b)
+#define st_tnsr_i_v(a,b,c)          v_i32_st_tnsr(a,b,c)
+#define V_LANE_ID                   read_lane_id_4b_b()
+// i32 accumulation: ACC_VECTOR holds VECTOR_SIZE lanes as ACC_PARTS int64 parts
+#define ACC_VECTOR                  int64
+#define ACC_PARTS                   1
+#define v_to_acc(a)                 (a)
+#define v_from_acc(a)               (a)
+#define acc_part(a, p)              (a)
+#define acc_set_part(a, p, v)       (a) = (v)
+#endif
+
+#if defined(INT8)
+#define VECTOR                      char256
+#define VECTOR_SIZE                 256
+typedef char                        SCALAR;
+#define v_ld_tnsr_i(a,b)            v_i8_ld_tnsr_b(a,b)
+#define st_tnsr_i_v(a,b,c)          v_i8_st_tnsr(a,b,c)
+#define V_LANE_ID                   read_lane_id_1b_b()
+#endif
@@ -0,0 +1,328 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+#include "kernel_config.h"
+
+// Backward of layer_norm_fwd.h. With xhat the normalized input and
+// g = gradOut * gamma, the input gradient of a row is
+//
+//   LayerNorm : gradIn = rstd * (g - mean(g) - xhat * mean(g * xhat))
+//   RMSNorm   : gradIn = rstd * (g - xhat * mean(g * xhat))
+//
+// Every index space member owns rowsPerMember rows, walked in groups of
+// NUM_UNROLL complete rows. Its share of gradGamma = sum(gradOut * xhat) and
+// gradBeta = sum(gradOut) is accumulated in f32 VLM over all of those rows
+// and written back once per member with an RMW add:
+//   f32  : straight into gradGamma / gradBeta {C} with atomic adds.
+//   bf16 : into f32 partials {ALIGN(C, VECTOR_SIZE), G1, H, B}, one slice per
+//          member, which layer_norm_param_reduce.h then sums into the bf16
+//          gradients. Part p of a depth vector at d lives at d + p * 64, i.e.
+//          the partials keep ACC_VECTOR lane order, which only the reduce
+//          kernel interprets.
+// The glue code zeroes the gradient / partial tensors before execution.
+
+#define NUM_UNROLL              4
+
+// space left for register spill
+#define REG_SPILL_REDUCTION     20
+// space assigned for data. as we do not have LUT, out total space is 320 vectors
+#define VLM_MAX_VECTOR          (320 - REG_SPILL_REDUCTION)
+// f32 vectors reserved for the parameter gradient accumulators
+#define VLM_PARAM_VECTORS       96
+#if defined(USE_RMS_NORM)
+#define PARAM_GRADS             1
+#else
+#define PARAM_GRADS             2
+#endif
+// depth vectors whose parameter gradients are kept in VLM, deeper ones are
+// added to the destination once per row group
+#define VLM_PARAM_DEPTH         (VLM_PARAM_VECTORS / (PARAM_GRADS * ACC_PARTS))
+// number of data compartments we will use
+#define VLM_INPUTS              2
+// calculation of the number of vectors we can place along the depth
+#define VLM_VECTORS_IN_DEPTH    ((VLM_MAX_VECTOR - VLM_PARAM_VECTORS) / (VLM_INPUTS * NUM_UNROLL))
+#define INPUT_TENSOR            0
+#define GRAD_TENSOR             1
+#define GAMMA_GRAD              0
+#define BETA_GRAD               1
+// f32 lanes of one ACC_VECTOR part
+#define ACC_PART_SIZE           (VECTOR_SIZE / ACC_PARTS)
+
+#define param_rmw_add(coords, t, v) \
+    v_f32_st_tnsr_rmw(coords, t, v, MkRMW(e_rmw_fp32, e_rmw_add, e_rmw_atomic, e_tnsr_dt_srf), 0, 1, 0)
+
+//local memory definition
+__local__ VECTOR vlm[VLM_INPUTS][NUM_UNROLL][VLM_VECTORS_IN_DEPTH];
+__local__ float64 vlmParamGrad[PARAM_GRADS][VLM_PARAM_DEPTH][ACC_PARTS];
+
+void main(tensor gradOut,
+          tensor ifm,
+          tensor gamma,
+#if !defined(USE_RMS_NORM)
+          tensor meanIn,
+#endif
+          tensor rstdIn,
+          tensor gradIn,
+          tensor gradGamma,
+#if !defined(USE_RMS_NORM)
+          tensor gradBeta,
+#endif
+          float invLen,
+          int rowsPerMember)
+{
+    const int depth  = 0;
+    const int width  = 1;
+    const int height = 2;
+    const int batch  = 3;
+
+    const int5 index_space_start = get_index_space_offset();
+    const int5 index_space_end = get_index_space_size() + index_space_start;
+
+    // depth - the whole row is processed by one index space member
+    const int depthStep  = VECTOR_SIZE;
+    const int depthStart = 0;
+    const int depthEnd   = get_dim_size(ifm, depth);
+
+    // width - rowsPerMember rows per member, in groups of NUM_UNROLL
+    const int widthStep  = NUM_UNROLL;
+    const int widthLast  = get_dim_size(ifm, width) - 1;
+    const int widthStart = index_space_start[width] * rowsPerMember;
+    const int widthEnd   = s_i32_min(index_space_end[width] * rowsPerMember, widthLast + 1);
+
+    // height
+    const int heightStep  = 1;
+    const int heightStart = index_space_start[height];
+    const int heightEnd   = index_space_end[height];
+
+    // batch
+    const int batchStep  = 1;
+    const int batchStart = index_space_start[batch];
+    const int batchEnd   = index_space_end[batch];
+
+    // calculation of the vlm_data_end in the depth dimension
+    const int vlmDataEnd = (VLM_VECTORS_IN_DEPTH * depthStep) > depthEnd ?
+                            depthEnd : (VLM_VECTORS_IN_DEPTH * depthStep);
+    const int vlmParamEnd = (VLM_PARAM_DEPTH * depthStep) > depthEnd ?
+                             depthEnd : (VLM_PARAM_DEPTH * depthStep);
+
+    int5 coords      = {0, 0, 0, 0, 0};
+    int5 statCoords  = {0, 0, 0, 0, 0};
+    int5 paramCoords = {0, 0, 0, 0, 0};
+#if defined(BFLOAT16)
+    // this member's slice of the partials
+    int5 gradCoords  = {0, index_space_start[width], index_space_start[height],
+                        index_space_start[batch], 0};
+#else
+    int5 gradCoords  = {0, 0, 0, 0, 0};
+#endif
+
+    float rstd[NUM_UNROLL];
+    float shift[NUM_UNROLL];
+    float64 sumG[NUM_UNROLL][ACC_PARTS];
+    float64 sumGX[NUM_UNROLL][ACC_PARTS];
+    float64 meanG[NUM_UNROLL];
+    float64 meanGX[NUM_UNROLL];
+
+    for (int i = 0; i < VLM_PARAM_DEPTH; i++)
+    {
+        #pragma unroll(PARAM_GRADS)
+        for (int j = 0; j < PARAM_GRADS; j++)
+        {
+            #pragma unroll(ACC_PARTS)
+            for (int p = 0; p < ACC_PARTS; p++)
+            {
+                vlmParamGrad[j][i][p] = 0;
+            }
+        }
+    }
+
+#pragma loop_taken
+    for (int b = batchStart; b < batchEnd; b += batchStep)
+    {
+        coords[batch] = b;
+        statCoords[batch] = b;
+
+#pragma loop_taken
+        for (int h = heightStart; h < heightEnd; h += heightStep)
+        {
+            coords[height] = h;
+            statCoords[height] = h;
+
+#pragma loop_taken
+            for (int w = widthStart; w < widthEnd; w += widthStep)
+            {
+                #pragma unroll(NUM_UNROLL)
+                for (int k = 0; k < NUM_UNROLL; k++)
+                {
+                    // rows past the tensor end read the last row, their
+                    // gradOut loads as zero and their stores are dropped
+                    statCoords[width] = s_i32_min(w + k, widthLast);
+                    __global__ float* rstdAddr = gen_addr(statCoords, rstdIn);
+                    rstd[k] = s_f32_ld_g(rstdAddr);
+#if defined(USE_RMS_NORM)
+                    shift[k] = 0;
+#else
+                    __global__ float* meanAddr = gen_addr(statCoords, meanIn);
+                    shift[k] = -(s_f32_ld_g(meanAddr) * rstd[k]);
+#endif
+                    #pragma unroll(ACC_PARTS)
+                    for (int p = 0; p < ACC_PARTS; p++)
+                    {
+                        sumG[k][p] = 0;
+                        sumGX[k][p] = 0;
+                    }
+                }
+
+                // pass 1 - cache x and gradOut in VLM, accumulate the row sums
+                // and this member's share of gradGamma / gradBeta
+                for (int d = depthStart, i = 0; d < depthEnd; d += depthStep, i++)
+                {
+                    coords[depth] = d;
+                    paramCoords[depth] = d;
+                    bool256 pred = bv_u_cmp_geq_v_s(d + V_LANE_ID, (unsigned)depthEnd);
+                    ACC_VECTOR g = v_to_acc(v_ld_tnsr_i(paramCoords, gamma));
+
+                    float64 dGamma[ACC_PARTS];
+                    float64 dBeta[ACC_PARTS];
+                    #pragma unroll(ACC_PARTS)
+                    for (int p = 0; p < ACC_PARTS; p++)
+                    {
+                        dGamma[p] = 0;
+                        dBeta[p] = 0;
+                    }
+
+                    #pragma unroll(NUM_UNROLL)
+                    for (int k = 0; k < NUM_UNROLL; k++)
+                    {
+                        coords[width] = w + k;
+                        VECTOR x  = v_ld_tnsr_i(coords, ifm);
+                        VECTOR dy = v_ld_tnsr_i(coords, gradOut);
+                        // Move zero for out of bound co-ordinates
+                        dy = v_mov_s_vb(0, dy, pred, 0);
+                        if (d < vlmDataEnd)
+                        {
+                            vlm[INPUT_TENSOR][k][i] = x;
+                            vlm[GRAD_TENSOR][k][i] = dy;
+                        }
+
+                        ACC_VECTOR xf = v_to_acc(x);
+                        ACC_VECTOR dyf = v_to_acc(dy);
+                        #pragma unroll(ACC_PARTS)
+                        for (int p = 0; p < ACC_PARTS; p++)
+                        {
+                            float64 xhat = v_f32_mac_b(acc_part(xf, p), rstd[k], shift[k]);
+                            float64 gdy = acc_part(dyf, p) * acc_part(g, p);
+                            sumG[k][p] += gdy;
+                            sumGX[k][p] = v_f32_mac_b(gdy, xhat, sumGX[k][p]);
+                            dGamma[p] = v_f32_mac_b(acc_part(dyf, p), xhat, dGamma[p]);
+                            dBeta[p] += acc_part(dyf, p);
+                        }
+                    }
+
+                    if (d < vlmParamEnd)
+                    {
+                        #pragma unroll(ACC_PARTS)
+                        for (int p = 0; p < ACC_PARTS; p++)
+                        {
+                            vlmParamGrad[GAMMA_GRAD][i][p] += dGamma[p];
+#if !defined(USE_RMS_NORM)
+                            vlmParamGrad[BETA_GRAD][i][p] += dBeta[p];
+#endif
+                        }
+                    }
+                    else
+                    {
+                        #pragma unroll(ACC_PARTS)
+                        for (int p = 0; p < ACC_PARTS; p++)
+                        {
+                            gradCoords[depth] = d + p * ACC_PART_SIZE;
+                            param_rmw_add(gradCoords, gradGamma, dGamma[p]);
+#if !defined(USE_RMS_NORM)
+                            param_rmw_add(gradCoords, gradBeta, dBeta[p]);
+#endif
+                        }
+                    }
+                }
+
+                #pragma unroll(NUM_UNROLL)
+                for (int k = 0; k < NUM_UNROLL; k++)
+                {
+                    #pragma unroll(ACC_PARTS)
+                    for (int p = 1; p < ACC_PARTS; p++)
+                    {
+                        sumG[k][0] += sumG[k][p];
+                        sumGX[k][0] += sumGX[k][p];
+                    }
+                    meanG[k] = v_f32_reduce_add(sumG[k][0]) * invLen;
+                    meanGX[k] = v_f32_reduce_add(sumGX[k][0]) * invLen;
+                }
+
+                // pass 2 - gradIn, the cached part of the rows is read from VLM
+                for (int d = depthStart, i = 0; d < depthEnd; d += depthStep, i++)
+                {
+                    coords[depth] = d;
+                    paramCoords[depth] = d;
+                    ACC_VECTOR g = v_to_acc(v_ld_tnsr_i(paramCoords, gamma));
+
+                    #pragma unroll(NUM_UNROLL)
+                    for (int k = 0; k < NUM_UNROLL; k++)
+                    {
+                        coords[width] = w + k;
+                        VECTOR x, dy;
+                        if (d < vlmDataEnd)
+                        {
+                            x  = vlm[INPUT_TENSOR][k][i];
+                            dy = vlm[GRAD_TENSOR][k][i];
+                        }
+                        else
+                        {
+                            x  = v_ld_tnsr_i(coords, ifm);
+                            dy = v_ld_tnsr_i(coords, gradOut);
+                        }
+
+                        ACC_VECTOR xf = v_to_acc(x);
+                        ACC_VECTOR dyf = v_to_acc(dy);
+                        #pragma unroll(ACC_PARTS)
+                        for (int p = 0; p < ACC_PARTS; p++)
+                        {
+                            float64 xhat = v_f32_mac_b(acc_part(xf, p), rstd[k], shift[k]);
+                            float64 t = acc_part(dyf, p) * acc_part(g, p);
+#if !defined(USE_RMS_NORM)
+                            t = t - meanG[k];
+#endif
+                            t = v_f32_mac_b(xhat, meanGX[k], t, (e_with_negation) << 1);
+                            acc_set_part(xf, p, t * rstd[k]);
+                        }
+                        st_tnsr_i_v(coords, gradIn, v_from_acc(xf));
+                    }
+                }
+            }
+        }
+    }
+
+    // one write back of the member's f32 parameter gradients
+    for (int d = depthStart, i = 0; d < vlmParamEnd; d += depthStep, i++)
+    {
+        #pragma unroll(ACC_PARTS)
+        for (int p = 0; p < ACC_PARTS; p++)
+        {
+            gradCoords[depth] = d + p * ACC_PART_SIZE;
+            param_rmw_add(gradCoords, gradGamma, vlmParamGrad[GAMMA_GRAD][i][p]);
+#if !defined(USE_RMS_NORM)
+            param_rmw_add(gradCoords, gradBeta, vlmParamGrad[BETA_GRAD][i][p]);
+#endif
+        }
+    }
+}
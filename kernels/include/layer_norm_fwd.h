@@ -0,0 +1,278 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+#include "kernel_config.h"
+
+// LayerNorm / RMSNorm over the FCD (dim 0). Every index space member owns
+// NUM_UNROLL complete rows, so no statistic crosses a TPC boundary.
+//
+//   USE_RMS_NORM  : y = x * rstd * gamma,               rstd = 1 / sqrt(E[x^2] + eps)
+//   otherwise     : y = (x - mean) * rstd * gamma + beta, rstd = 1 / sqrt(Var[x] + eps)
+//   FUSE_RESIDUAL : x = ifm + residual is normalized and also written to
+//                   residualOut for the next block of the residual stream.
+//
+// Sum and sum of squares are accumulated in f32 in a single pass over the
+// row, which is cached in VLM for the normalization pass. mean and rstd are
+// written as f32 {1, W, H, B} tensors for the backward kernel.
+
+#define NUM_UNROLL              4
+
+// space left for register spill
+#define REG_SPILL_REDUCTION     20
+// 64 vectors are left free for the rsqrt LUT
+#define VLM_MAX_VECTOR          (256 - REG_SPILL_REDUCTION)
+// calculation of the number of vectors we can place along the depth
+#define VLM_VECTORS_IN_DEPTH    (VLM_MAX_VECTOR / NUM_UNROLL)
+
+//local memory definition
+__local__ VECTOR vlm[NUM_UNROLL][VLM_VECTORS_IN_DEPTH];
+
+void main(tensor ifm,
+          tensor gamma,
+#if !defined(USE_RMS_NORM)
+          tensor beta,
+#endif
+#if defined(FUSE_RESIDUAL)
+          tensor residual,
+#endif
+          tensor ofm,
+#if !defined(USE_RMS_NORM)
+          tensor meanOut,
+#endif
+          tensor rstdOut,
+#if defined(FUSE_RESIDUAL)
+          tensor residualOut,
+#endif
+          float epsilon,
+          float invLen)
+{
+    const int depth  = 0;
+    const int width  = 1;
+    const int height = 2;
+    const int batch  = 3;
+
+    const int5 index_space_start = get_index_space_offset();
+    const int5 index_space_end = get_index_space_size() + index_space_start;
+
+    // depth - the whole row is processed by one index space member
+    const int depthStep  = VECTOR_SIZE;
+    const int depthStart = 0;
+    const int depthEnd   = get_dim_size(ifm, depth);
+
+    // width
+    const int widthStep  = NUM_UNROLL;
+    const int widthStart = index_space_start[width] * widthStep;
+    const int widthEnd   = index_space_end[width] * widthStep;
+
+    // height
+    const int heightStep  = 1;
+    const int heightStart = index_space_start[height];
+    const int heightEnd   = index_space_end[height];
+
+    // batch
+    const int batchStep  = 1;
+    const int batchStart = index_space_start[batch];
+    const int batchEnd   = index_space_end[batch];
+
+    // calculation of the vlm_data_end in the depth dimension
+    const int vlmDataEnd = (VLM_VECTORS_IN_DEPTH * depthStep) > depthEnd ?
+                            depthEnd : (VLM_VECTORS_IN_DEPTH * depthStep);
+
+    int5 coords      = {0, 0, 0, 0, 0};
+    int5 statCoords  = {0, 0, 0, 0, 0};
+    int5 paramCoords = {0, 0, 0, 0, 0};
+
+    float64 sum[NUM_UNROLL][ACC_PARTS];
+    float64 sumSq[NUM_UNROLL][ACC_PARTS];
+    float64 scale[NUM_UNROLL];
+    float64 shift[NUM_UNROLL];
+
+#pragma loop_taken
+    for (int b = batchStart; b < batchEnd; b += batchStep)
+    {
+        coords[batch] = b;
+        statCoords[batch] = b;
+
+#pragma loop_taken
+        for (int h = heightStart; h < heightEnd; h += heightStep)
+        {
+            coords[height] = h;
+            statCoords[height] = h;
+
+#pragma loop_taken
+            for (int w = widthStart; w < widthEnd; w += widthStep)
+            {
+                #pragma unroll(NUM_UNROLL)
+                for (int k = 0; k < NUM_UNROLL; k++)
+                {
+                    #pragma unroll(ACC_PARTS)
+                    for (int p = 0; p < ACC_PARTS; p++)
+                    {
+                        sum[k][p] = 0;
+                        sumSq[k][p] = 0;
+                    }
+                }
+
+                // pass 1 - cache the row in VLM, accumulate sum and sum of squares
+#pragma loop_taken
+                for (int d = depthStart, i = 0; d < vlmDataEnd; d += depthStep, i++)
+                {
+                    coords[depth] = d;
+                    bool256 pred = bv_u_cmp_geq_v_s(d + V_LANE_ID, (unsigned)depthEnd);
+
+                    #pragma unroll(NUM_UNROLL)
+                    for (int k = 0; k < NUM_UNROLL; k++)
+                    {
+                        coords[width] = w + k;
+                        VECTOR x = v_ld_tnsr_i(coords, ifm);
+#if defined(FUSE_RESIDUAL)
+                        x = x + v_ld_tnsr_i(coords, residual);
+                        st_tnsr_i_v(coords, residualOut, x);
+#endif
+                        // Move zero for out of bound co-ordinates
+                        x = v_mov_s_vb(0, x, pred, 0);
+                        vlm[k][i] = x;
+
+                        ACC_VECTOR xf = v_to_acc(x);
+                        #pragma unroll(ACC_PARTS)
+                        for (int p = 0; p < ACC_PARTS; p++)
+                        {
+                            sum[k][p] += acc_part(xf, p);
+                            sumSq[k][p] = v_f32_mac_b(acc_part(xf, p), acc_part(xf, p), sumSq[k][p]);
+                        }
+                    }
+                }
+                for (int d = vlmDataEnd; d < depthEnd; d += depthStep)
+                {
+                    // this loop is outside the scope of the vlm
+                    coords[depth] = d;
+                    bool256 pred = bv_u_cmp_geq_v_s(d + V_LANE_ID, (unsigned)depthEnd);
+
+                    #pragma unroll(NUM_UNROLL)
+                    for (int k = 0; k < NUM_UNROLL; k++)
+                    {
+                        coords[width] = w + k;
+                        VECTOR x = v_ld_tnsr_i(coords, ifm);
+#if defined(FUSE_RESIDUAL)
+                        x = x + v_ld_tnsr_i(coords, residual);
+                        st_tnsr_i_v(coords, residualOut, x);
+#endif
+                        x = v_mov_s_vb(0, x, pred, 0);
+
+                        ACC_VECTOR xf = v_to_acc(x);
+                        #pragma unroll(ACC_PARTS)
+                        for (int p = 0; p < ACC_PARTS; p++)
+                        {
+                            sum[k][p] += acc_part(xf, p);
+                            sumSq[k][p] = v_f32_mac_b(acc_part(xf, p), acc_part(xf, p), sumSq[k][p]);
+                        }
+                    }
+                }
+
+                // reduce the statistics and turn them into y = x * scale + shift
+                #pragma unroll(NUM_UNROLL)
+                for (int k = 0; k < NUM_UNROLL; k++)
+                {
+                    statCoords[width] = w + k;
+
+                    #pragma unroll(ACC_PARTS)
+                    for (int p = 1; p < ACC_PARTS; p++)
+                    {
+                        sum[k][0] += sum[k][p];
+                        sumSq[k][0] += sumSq[k][p];
+                    }
+                    float64 meanSq = v_f32_reduce_add(sumSq[k][0]) * invLen;
+#if defined(USE_RMS_NORM)
+                    float64 rstd = v_rsqrt_f32(meanSq + epsilon);
+                    scale[k] = rstd;
+                    shift[k] = 0;
+#else
+                    float64 mean = v_f32_reduce_add(sum[k][0]) * invLen;
+                    // var = E[x^2] - E[x]^2, clamped at zero against cancellation
+                    float64 var = v_f32_mac_b(mean, mean, meanSq, (e_with_negation) << 1);
+                    var = v_f32_max_b(var, 0.0f);
+                    float64 rstd = v_rsqrt_f32(var + epsilon);
+                    scale[k] = rstd;
+                    shift[k] = -(mean * rstd);
+                    v_f32_st_tnsr(statCoords, meanOut, mean);
+#endif
+                    v_f32_st_tnsr(statCoords, rstdOut, rstd);
+                }
+
+                // pass 2 - normalize, the cached part of the row is read from VLM
+#pragma loop_taken
+                for (int d = depthStart, i = 0; d < vlmDataEnd; d += depthStep, i++)
+                {
+                    coords[depth] = d;
+                    paramCoords[depth] = d;
+                    ACC_VECTOR g = v_to_acc(v_ld_tnsr_i(paramCoords, gamma));
+#if !defined(USE_RMS_NORM)
+                    ACC_VECTOR bt = v_to_acc(v_ld_tnsr_i(paramCoords, beta));
+#endif
+
+                    #pragma unroll(NUM_UNROLL)
+                    for (int k = 0; k < NUM_UNROLL; k++)
+                    {
+                        coords[width] = w + k;
+                        ACC_VECTOR y = v_to_acc(vlm[k][i]);
+                        #pragma unroll(ACC_PARTS)
+                        for (int p = 0; p < ACC_PARTS; p++)
+                        {
+                            float64 xn = v_f32_mac_b(acc_part(y, p), scale[k], shift[k]);
+#if defined(USE_RMS_NORM)
+                            acc_set_part(y, p, xn * acc_part(g, p));
+#else
+                            acc_set_part(y, p, v_f32_mac_b(xn, acc_part(g, p), acc_part(bt, p)));
+#endif
+                        }
+                        st_tnsr_i_v(coords, ofm, v_from_acc(y));
+                    }
+                }
+                for (int d = vlmDataEnd; d < depthEnd; d += depthStep)
+                {
+                    // this loop is outside the scope of the vlm
+                    coords[depth] = d;
+                    paramCoords[depth] = d;
+                    ACC_VECTOR g = v_to_acc(v_ld_tnsr_i(paramCoords, gamma));
+#if !defined(USE_RMS_NORM)
+                    ACC_VECTOR bt = v_to_acc(v_ld_tnsr_i(paramCoords, beta));
+#endif
+
+                    #pragma unroll(NUM_UNROLL)
+                    for (int k = 0; k < NUM_UNROLL; k++)
+                    {
+                        coords[width] = w + k;
+                        VECTOR x = v_ld_tnsr_i(coords, ifm);
+#if defined(FUSE_RESIDUAL)
+                        x = x + v_ld_tnsr_i(coords, residual);
+#endif
+                        ACC_VECTOR y = v_to_acc(x);
+                        #pragma unroll(ACC_PARTS)
+                        for (int p = 0; p < ACC_PARTS; p++)
+                        {
+                            float64 xn = v_f32_mac_b(acc_part(y, p), scale[k], shift[k]);
+#if defined(USE_RMS_NORM)
+                            acc_set_part(y, p, xn * acc_part(g, p));
+#else
+                            acc_set_part(y, p, v_f32_mac_b(xn, acc_part(g, p), acc_part(bt, p)));
+#endif
+                        }
+                        st_tnsr_i_v(coords, ofm, v_from_acc(y));
+                    }
+                }
+            }
+        }
+    }
+}
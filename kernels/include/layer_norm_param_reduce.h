@@ -0,0 +1,85 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+#include "kernel_config.h"
+
+// Second pass of the bf16 normalization backward. Sums the f32 parameter
+// gradient partials {ALIGN(C, VECTOR_SIZE), G1, H, B} written by
+// layer_norm_bwd.h over dims 1-3 and rounds the total once into the bf16
+// gradient {C}. Part p of the depth vector at d is read from d + p * 64, the
+// ACC_VECTOR lane order the partials were written in.
+
+// f32 lanes of one ACC_VECTOR part
+#define ACC_PART_SIZE           (VECTOR_SIZE / ACC_PARTS)
+
+void main(tensor partials, tensor paramGrad)
+{
+    const int depth  = 0;
+    const int width  = 1;
+    const int height = 2;
+    const int batch  = 3;
+
+    const int5 index_space_start = get_index_space_offset();
+    const int5 index_space_end = get_index_space_size() + index_space_start;
+
+    const int depthStep  = VECTOR_SIZE;
+    const int depthStart = index_space_start[depth] * depthStep;
+    const int depthEnd   = index_space_end[depth] * depthStep;
+
+    const int widthEnd  = get_dim_size(partials, width);
+    const int heightEnd = get_dim_size(partials, height);
+    const int batchEnd  = get_dim_size(partials, batch);
+
+    int5 coords      = {0, 0, 0, 0, 0};
+    int5 paramCoords = {0, 0, 0, 0, 0};
+
+    for (int d = depthStart; d < depthEnd; d += depthStep)
+    {
+        float64 sum[ACC_PARTS];
+        #pragma unroll(ACC_PARTS)
+        for (int p = 0; p < ACC_PARTS; p++)
+        {
+            sum[p] = 0;
+        }
+
+        for (int b = 0; b < batchEnd; b++)
+        {
+            coords[batch] = b;
+            for (int h = 0; h < heightEnd; h++)
+            {
+                coords[height] = h;
+                for (int w = 0; w < widthEnd; w++)
+                {
+                    coords[width] = w;
+                    #pragma unroll(ACC_PARTS)
+                    for (int p = 0; p < ACC_PARTS; p++)
+                    {
+                        coords[depth] = d + p * ACC_PART_SIZE;
+                        sum[p] += v_f32_ld_tnsr_b(coords, partials);
+                    }
+                }
+            }
+        }
+
+        ACC_VECTOR total;
+        #pragma unroll(ACC_PARTS)
+        for (int p = 0; p < ACC_PARTS; p++)
+        {
+            acc_set_part(total, p, sum[p]);
+        }
+        paramCoords[depth] = d;
+        st_tnsr_i_v(paramCoords, paramGrad, v_from_acc(total));
+    }
+}
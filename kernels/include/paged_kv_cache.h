@@ -0,0 +1,173 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+// Paged KV cache, the cache is split in fixed size blocks addressed through
+// a per sequence block table:
+//
+//   cache        : {headDim, heads, blockSize, numBlocks}
+//   blockTable   : i32 {maxBlocksPerSeq, numSeqs}, physical block of every
+//                  logical block of a sequence
+//   contextLens  : i32 {numSeqs}
+//   slotMapping  : i32 {numTokens}, block * blockSize + offset, < 0 skips
+//                  the token (padding)
+//
+// PAGED_GATHER : key / value {headDim, maxLen, heads, numSeqs} get token t
+//                of every sequence from its block, the layout the fused
+//                attention kernel takes with contextLens as kv lengths.
+//                Tokens past the context length are stored as zeros.
+//                Index space: heads, logical blocks, sequences.
+// otherwise    : append, token i of newKey / newValue {headDim, heads,
+//                numTokens} is written to slot slotMapping[i] of the caches,
+//                nothing else is touched, the cache outputs must be bound to
+//                the persistent cache tensors.
+//                Index space: heads, tokens.
+//
+// The kernels only move bits. FP8 serves both fp8 formats, blockSize is a
+// power of two given as blockShift.
+
+#if defined(FP8)
+#define VECTOR                      minihalf256
+#define VECTOR_SIZE                 256
+#define v_ld_tnsr_i(a, b)           v_h8_ld_tnsr_b(a, b)
+#define st_tnsr_i_v(a, b, c)        v_h8_st_tnsr(a, b, c)
+#else
+#include "kernel_config.h"
+#endif
+
+#if defined(PAGED_GATHER)
+void main(tensor keyCache,
+          tensor valueCache,
+          tensor blockTable,
+          tensor contextLens,
+          tensor keyOut,
+          tensor valueOut,
+          int blockShift)
+#else
+void main(tensor newKey,
+          tensor newValue,
+          tensor slotMapping,
+          tensor keyCache,
+          tensor valueCache,
+          int blockShift)
+#endif
+{
+    const int5 index_space_start = get_index_space_offset();
+    const int5 index_space_end = get_index_space_size() + index_space_start;
+
+    const int blockSize = 1 << blockShift;
+    const VECTOR zero = 0;
+
+#if defined(PAGED_GATHER)
+    const int headDim = get_dim_size(keyOut, 0);
+    const int maxLen  = get_dim_size(keyOut, 1);
+
+    int5 cacheCoords = {0, 0, 0, 0, 0};
+    int5 outCoords = {0, 0, 0, 0, 0};
+    int5 tableCoords = {0, 0, 0, 0, 0};
+    int5 lengthCoords = {0, 0, 0, 0, 0};
+
+    for (int seq = index_space_start[2]; seq < index_space_end[2]; seq++)
+    {
+        outCoords[3] = seq;
+        tableCoords[1] = seq;
+        lengthCoords[0] = seq;
+        const int contextLen = s_i32_ld_g((__global__ int*)gen_addr(lengthCoords, contextLens));
+
+        for (int lb = index_space_start[1]; lb < index_space_end[1]; lb++)
+        {
+            // tokens of this logical block, the valid ones come from the cache
+            const int tokenStart = lb << blockShift;
+            int tokenEnd = s_i32_min(tokenStart + blockSize, maxLen);
+            int validEnd = s_i32_min(tokenEnd, contextLen);
+
+            // the table entry is only read for a block in use
+            int block = 0;
+            if (tokenStart < validEnd)
+            {
+                tableCoords[0] = lb;
+                block = s_i32_ld_g((__global__ int*)gen_addr(tableCoords, blockTable));
+            }
+            cacheCoords[3] = block;
+
+            for (int h = index_space_start[0]; h < index_space_end[0]; h++)
+            {
+                cacheCoords[1] = h;
+                outCoords[2] = h;
+
+                for (int t = tokenStart; t < validEnd; t++)
+                {
+                    cacheCoords[2] = t - tokenStart;
+                    outCoords[1] = t;
+                    #pragma unroll(2)
+                    for (int d = 0; d < headDim; d += VECTOR_SIZE)
+                    {
+                        cacheCoords[0] = d;
+                        outCoords[0] = d;
+                        st_tnsr_i_v(outCoords, keyOut, v_ld_tnsr_i(cacheCoords, keyCache));
+                        st_tnsr_i_v(outCoords, valueOut, v_ld_tnsr_i(cacheCoords, valueCache));
+                    }
+                }
+
+                // past the context
+                for (int t = s_i32_max(validEnd, tokenStart); t < tokenEnd; t++)
+                {
+                    outCoords[1] = t;
+                    #pragma unroll(2)
+                    for (int d = 0; d < headDim; d += VECTOR_SIZE)
+                    {
+                        outCoords[0] = d;
+                        st_tnsr_i_v(outCoords, keyOut, zero);
+                        st_tnsr_i_v(outCoords, valueOut, zero);
+                    }
+                }
+            }
+        }
+    }
+#else
+    const int headDim = get_dim_size(newKey, 0);
+
+    int5 inCoords = {0, 0, 0, 0, 0};
+    int5 cacheCoords = {0, 0, 0, 0, 0};
+    int5 slotCoords = {0, 0, 0, 0, 0};
+
+    for (int token = index_space_start[1]; token < index_space_end[1]; token++)
+    {
+        slotCoords[0] = token;
+        const int slot = s_i32_ld_g((__global__ int*)gen_addr(slotCoords, slotMapping));
+        if (slot < 0)
+        {
+            continue;
+        }
+        inCoords[2] = token;
+        cacheCoords[2] = slot & (blockSize - 1);
+        cacheCoords[3] = slot >> blockShift;
+
+        for (int h = index_space_start[0]; h < index_space_end[0]; h++)
+        {
+            inCoords[1] = h;
+            cacheCoords[1] = h;
+            #pragma unroll(2)
+            for (int d = 0; d < headDim; d += VECTOR_SIZE)
+            {
+                inCoords[0] = d;
+                cacheCoords[0] = d;
+                st_tnsr_i_v(cacheCoords, keyCache, v_ld_tnsr_i(inCoords, newKey));
+                st_tnsr_i_v(cacheCoords, valueCache, v_ld_tnsr_i(inCoords, newValue));
+            }
+        }
+    }
+#endif
+}
@@ -0,0 +1,195 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+// Permutes the dims of a tensor of up to 5 dims. Output dim i is input dim
+// perm<i>. The kernel only moves bits, FLOAT32 serves every 32 bit type,
+// BFLOAT16 every 16 bit one and INT8 every 8 bit one.
+//
+// perm0 == 0, the FCD stays: every member copies one full vector of dim 0,
+// only the coordinates of the other dims are permuted.
+//
+// perm0 != 0, the FCD moves: input dim perm0 becomes the output FCD and the
+// input FCD goes to output dim fcdOut. Every member handles a square tile of
+// VECTOR_SIZE x VECTOR_SIZE elements of that plane. The input rows are
+// loaded into VLM with full vector loads, transposed there and written out
+// with full vector stores, see vlm_transpose.h. The 8 bit tile is 256 rows of
+// 256 bytes, 64KB of VLM.
+
+#include "kernel_config.h"
+#include "vlm_transpose.h"
+
+// tile rows
+__local__ VECTOR vlmTile[VECTOR_SIZE];
+
+// Component dim of c for a dim only known at run time.
+int get_dim(int5 c, int dim)
+{
+    int v = c[0];
+    v = (dim == 1) ? c[1] : v;
+    v = (dim == 2) ? c[2] : v;
+    v = (dim == 3) ? c[3] : v;
+    v = (dim == 4) ? c[4] : v;
+    return v;
+}
+
+// The i with perm[i] == dim, the inverse permutation.
+int find_dim(int5 perm, int dim)
+{
+    int v = 0;
+    v = (perm[1] == dim) ? 1 : v;
+    v = (perm[2] == dim) ? 2 : v;
+    v = (perm[3] == dim) ? 3 : v;
+    v = (perm[4] == dim) ? 4 : v;
+    return v;
+}
+
+void main(tensor ifm,
+          tensor ofm,
+          int perm0,
+          int perm1,
+          int perm2,
+          int perm3,
+          int perm4)
+{
+    const int5 index_space_start = get_index_space_offset();
+    const int5 index_space_end = get_index_space_size() + index_space_start;
+
+    const int5 perm = {perm0, perm1, perm2, perm3, perm4};
+    const int5 invPerm = {find_dim(perm, 0), find_dim(perm, 1), find_dim(perm, 2),
+                          find_dim(perm, 3), find_dim(perm, 4)};
+
+    const bool fcdMoves = (perm0 != 0);
+    // output dim of the input FCD
+    const int fcdOut = invPerm[0];
+
+    // dim 0 takes a vector per member, so does fcdOut when the FCD moves
+    const int step0 = VECTOR_SIZE;
+    const int step1 = (fcdMoves && fcdOut == 1) ? VECTOR_SIZE : 1;
+    const int step2 = (fcdMoves && fcdOut == 2) ? VECTOR_SIZE : 1;
+    const int step3 = (fcdMoves && fcdOut == 3) ? VECTOR_SIZE : 1;
+    const int step4 = (fcdMoves && fcdOut == 4) ? VECTOR_SIZE : 1;
+
+    int5 outCoords = {0, 0, 0, 0, 0};
+    int5 inCoords  = {0, 0, 0, 0, 0};
+
+    if (!fcdMoves)
+    {
+        for (int o4 = index_space_start[4] * step4; o4 < index_space_end[4] * step4; o4 += step4)
+        {
+            outCoords[4] = o4;
+            for (int o3 = index_space_start[3] * step3; o3 < index_space_end[3] * step3; o3 += step3)
+            {
+                outCoords[3] = o3;
+                for (int o2 = index_space_start[2] * step2; o2 < index_space_end[2] * step2; o2 += step2)
+                {
+                    outCoords[2] = o2;
+                    for (int o1 = index_space_start[1] * step1; o1 < index_space_end[1] * step1; o1 += step1)
+                    {
+                        outCoords[1] = o1;
+
+                        inCoords[1] = get_dim(outCoords, invPerm[1]);
+                        inCoords[2] = get_dim(outCoords, invPerm[2]);
+                        inCoords[3] = get_dim(outCoords, invPerm[3]);
+                        inCoords[4] = get_dim(outCoords, invPerm[4]);
+
+                        #pragma unroll(4)
+                        for (int o0 = index_space_start[0] * step0; o0 < index_space_end[0] * step0; o0 += step0)
+                        {
+                            outCoords[0] = o0;
+                            inCoords[0] = o0;
+                            st_tnsr_i_v(outCoords, ofm, v_ld_tnsr_i(inCoords, ifm));
+                        }
+                    }
+                }
+            }
+        }
+        return;
+    }
+
+    transpose_init_ctl();
+
+    // input row r of a tile is one step along input dim perm0
+    int5 rowStep = {0, 0, 0, 0, 0};
+    rowStep[1] = (perm0 == 1);
+    rowStep[2] = (perm0 == 2);
+    rowStep[3] = (perm0 == 3);
+    rowStep[4] = (perm0 == 4);
+    // output vector c of a tile is one step along output dim fcdOut
+    int5 colStep = {0, 0, 0, 0, 0};
+    colStep[1] = (fcdOut == 1);
+    colStep[2] = (fcdOut == 2);
+    colStep[3] = (fcdOut == 3);
+    colStep[4] = (fcdOut == 4);
+
+    for (int o4 = index_space_start[4] * step4; o4 < index_space_end[4] * step4; o4 += step4)
+    {
+        outCoords[4] = o4;
+        for (int o3 = index_space_start[3] * step3; o3 < index_space_end[3] * step3; o3 += step3)
+        {
+            outCoords[3] = o3;
+            for (int o2 = index_space_start[2] * step2; o2 < index_space_end[2] * step2; o2 += step2)
+            {
+                outCoords[2] = o2;
+                for (int o1 = index_space_start[1] * step1; o1 < index_space_end[1] * step1; o1 += step1)
+                {
+                    outCoords[1] = o1;
+                    for (int o0 = index_space_start[0] * step0; o0 < index_space_end[0] * step0; o0 += step0)
+                    {
+                        outCoords[0] = o0;
+
+                        inCoords[0] = get_dim(outCoords, invPerm[0]);
+                        inCoords[1] = get_dim(outCoords, invPerm[1]);
+                        inCoords[2] = get_dim(outCoords, invPerm[2]);
+                        inCoords[3] = get_dim(outCoords, invPerm[3]);
+                        inCoords[4] = get_dim(outCoords, invPerm[4]);
+
+                        // rows past the input read zeros, their lanes are
+                        // clipped by the output stores
+                        #pragma unroll(4)
+                        for (int r = 0; r < VECTOR_SIZE; r++)
+                        {
+                            vlmTile[r] = v_ld_tnsr_i(inCoords, ifm);
+                            inCoords = inCoords + rowStep;
+                        }
+
+                        // 1. transpose the diagonal blocks of every dual group
+                        TRANSPOSE_DIAGONAL(vlmTile, 0);
+
+                        // 2. swap the blocks between dual groups on the way out
+                        int5 storeCoords = outCoords;
+                        for (int x = 0; x < DG_SIZE; x++)
+                        {
+                            VECTOR y0, y1, y2, y3;
+                            TRANSPOSE_GATHER(vlmTile, 0, x, y0, y1, y2, y3);
+
+                            // output vectors x, DG_SIZE + x, ...; columns past
+                            // the input FCD are clipped
+                            int5 c = storeCoords;
+                            st_tnsr_i_v(c, ofm, y0);
+                            c = c + colStep * DG_SIZE;
+                            st_tnsr_i_v(c, ofm, y1);
+                            c = c + colStep * DG_SIZE;
+                            st_tnsr_i_v(c, ofm, y2);
+                            c = c + colStep * DG_SIZE;
+                            st_tnsr_i_v(c, ofm, y3);
+                            storeCoords = storeCoords + colStep;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,299 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include "i8_linear.h"
+#if defined(BFLOAT16)
+#include "bf16_linear.h"
+#endif
+
+// int8 (de)quantization of f32 / bf16 tensors:
+//
+//   quant   : q = clamp(round(x * (1 / scale)) + zeroPoint, -128, 127)
+//   dequant : x = (q - zeroPoint) * scale
+//
+// Rounding is half to even and happens before the integral zero point is
+// added, so ties do not depend on its value. The scale and zero point come from
+//   default     : scalar params, per tensor. The quant kernel gets 1 / scale.
+//   PER_CHANNEL : a {C} f32 scale tensor and with ZERO_POINT a {C} i32 zero
+//                 point tensor, indexed by the coordinate along axis.
+//   DYNAMIC     : quant only. Every dim 0 row gets its own scale and zero
+//                 point, computed from the row min / max in the same launch
+//                 and written to the {1, ...} scale and zeroPoint outputs.
+//                 The range always includes 0 so that zero stays exact.
+
+#define I8_MIN                  -128.0f
+#define I8_MAX                  127.0f
+
+#if defined(DYNAMIC)
+void main(tensor ifm,
+          tensor ofm,
+          tensor scaleOut,
+          tensor zeroPointOut,
+          int symmetric)
+#elif defined(PER_CHANNEL)
+void main(tensor ifm,
+          tensor scaleTensor,
+  #if defined(ZERO_POINT)
+          tensor zeroPointTensor,
+  #endif
+          tensor ofm,
+          int axis)
+#else
+void main(tensor ifm,
+          tensor ofm,
+          float scale,
+          float zeroPoint)
+#endif
+{
+    const int depth  = 0;
+    const int width  = 1;
+    const int height = 2;
+    const int batch  = 3;
+    const int fifthDim = 4;
+
+    const int5 index_space_start = get_index_space_offset();
+    const int5 index_space_end = get_index_space_size() + index_space_start;
+
+    // depth, one int8 vector of 256 elements per member. DYNAMIC members
+    // own whole rows.
+    const int depthStep  = 256;
+#if defined(DYNAMIC)
+    const int depthStart = 0;
+    const int depthEnd   = get_dim_size(ifm, depth);
+#else
+    const int depthStart = index_space_start[depth] * depthStep;
+    const int depthEnd   = index_space_end[depth] * depthStep;
+#endif
+
+    // width
+    const int widthStep  = 1;
+    const int widthStart = index_space_start[width] * widthStep;
+    const int widthEnd   = index_space_end[width] * widthStep;
+
+    // height
+    const int heightStep  = 1;
+    const int heightStart = index_space_start[height] * heightStep;
+    const int heightEnd   = index_space_end[height] * heightStep;
+
+    // batch
+    const int batchStep  = 1;
+    const int batchStart = index_space_start[batch] * batchStep;
+    const int batchEnd   = index_space_end[batch] * batchStep;
+
+    // fifthDim
+    const int fifthDimStep  = 1;
+    const int fifthDimStart = index_space_start[fifthDim] * fifthDimStep;
+    const int fifthDimEnd   = index_space_end[fifthDim] * fifthDimStep;
+
+    int5 coords = {0, 0, 0, 0, 0};
+
+    // per lane multiplier and zero point of the four f32 parts
+    float64 mul0, mul1, mul2, mul3;
+    float64 zp0, zp1, zp2, zp3;
+#if !defined(PER_CHANNEL) && !defined(DYNAMIC)
+    mul0 = mul1 = mul2 = mul3 = scale;
+    zp0 = zp1 = zp2 = zp3 = zeroPoint;
+#endif
+#if defined(PER_CHANNEL)
+    int5 chanCoords = {0, 0, 0, 0, 0};
+    zp0 = zp1 = zp2 = zp3 = 0.0f;
+#endif
+
+    for (int f = fifthDimStart; f < fifthDimEnd; f += fifthDimStep)
+    {
+        coords[fifthDim] = f;
+        for (int b = batchStart; b < batchEnd; b += batchStep)
+        {
+            coords[batch] = b;
+            for (int h = heightStart; h < heightEnd; h += heightStep)
+            {
+                coords[height] = h;
+                for (int w = widthStart; w < widthEnd; w += widthStep)
+                {
+                    coords[width] = w;
+                    float256 x;
+
+#if defined(PER_CHANNEL)
+                    // the whole row shares one channel
+                    if (axis != depth)
+                    {
+                        chanCoords[0] = (axis == width) ? w : (axis == height) ? h :
+                                        (axis == batch) ? b : f;
+                        mul0 = s_f32_ld_g((__global__ float*)gen_addr(chanCoords, scaleTensor));
+  #if !defined(DEQUANT)
+                        mul0 = v_reciprocal_f32(mul0);
+  #endif
+                        mul1 = mul2 = mul3 = mul0;
+  #if defined(ZERO_POINT)
+                        float z = (float)s_i32_ld_g((__global__ int*)gen_addr(chanCoords, zeroPointTensor));
+                        zp0 = zp1 = zp2 = zp3 = z;
+  #endif
+                    }
+#endif
+
+#if defined(DYNAMIC)
+                    // pass 1: row range
+                    float64 minV = 0.0f;
+                    float64 maxV = 0.0f;
+                    for (int d = depthStart; d < depthEnd; d += depthStep)
+                    {
+  #if defined(BFLOAT16)
+                        coords[depth] = d;
+                        float128 lo = bf16_to_f32_linear(v_bf16_ld_tnsr_b(coords, ifm));
+                        coords[depth] = d + 128;
+                        float128 hi = bf16_to_f32_linear(v_bf16_ld_tnsr_b(coords, ifm));
+                        minV = v_f32_min_b(minV, v_f32_min_b(v_f32_min_b(lo.v1, lo.v2), v_f32_min_b(hi.v1, hi.v2)));
+                        maxV = v_f32_max_b(maxV, v_f32_max_b(v_f32_max_b(lo.v1, lo.v2), v_f32_max_b(hi.v1, hi.v2)));
+  #else
+                        #pragma unroll(4)
+                        for (int k = 0; k < 4; k++)
+                        {
+                            coords[depth] = d + 64 * k;
+                            float64 v = v_f32_ld_tnsr_b(coords, ifm);
+                            minV = v_f32_min_b(minV, v);
+                            maxV = v_f32_max_b(maxV, v);
+                        }
+  #endif
+                    }
+                    minV = v_f32_reduce_min(minV);
+                    maxV = v_f32_reduce_max(maxV);
+
+                    float64 rowScale, rowZp;
+                    if (symmetric)
+                    {
+                        rowScale = v_f32_max_b(maxV, -minV) * (1.0f / I8_MAX);
+                        rowZp = 0.0f;
+                    }
+                    else
+                    {
+                        rowScale = (maxV - minV) * (1.0f / (I8_MAX - I8_MIN));
+                    }
+                    // an all zero row quantizes to zero with any scale
+                    rowScale = v_f32_sel_eq_f32_b(rowScale, 0.0f, 1.0f, rowScale);
+                    float64 rowMul = v_reciprocal_f32(rowScale);
+                    if (!symmetric)
+                    {
+                        // minV maps to -128, within range since minV <= 0 <= maxV
+                        rowZp = v_convert_i32_to_f32_b(v_convert_f32_to_i32_b(I8_MIN - minV * rowMul,
+                                                                              e_round_half_ne << 16),
+                                                       e_round_half_ne << 16);
+                    }
+
+                    // the {1, ...} outputs clip everything but lane 0
+                    coords[depth] = 0;
+                    v_f32_st_tnsr(coords, scaleOut, rowScale);
+                    v_i32_st_tnsr(coords, zeroPointOut, v_convert_f32_to_i32_b(rowZp, e_round_half_ne << 16));
+
+                    mul0 = mul1 = mul2 = mul3 = rowMul;
+                    zp0 = zp1 = zp2 = zp3 = rowZp;
+#endif
+
+                    for (int d = depthStart; d < depthEnd; d += depthStep)
+                    {
+#if defined(PER_CHANNEL)
+                        // per lane channels, out of bound lanes are clipped on store
+                        if (axis == depth)
+                        {
+                            chanCoords[0] = d;
+                            mul0 = v_f32_ld_tnsr_b(chanCoords, scaleTensor);
+                            chanCoords[0] = d + 64;
+                            mul1 = v_f32_ld_tnsr_b(chanCoords, scaleTensor);
+                            chanCoords[0] = d + 128;
+                            mul2 = v_f32_ld_tnsr_b(chanCoords, scaleTensor);
+                            chanCoords[0] = d + 192;
+                            mul3 = v_f32_ld_tnsr_b(chanCoords, scaleTensor);
+  #if !defined(DEQUANT)
+                            mul0 = v_reciprocal_f32(mul0);
+                            mul1 = v_reciprocal_f32(mul1);
+                            mul2 = v_reciprocal_f32(mul2);
+                            mul3 = v_reciprocal_f32(mul3);
+  #endif
+  #if defined(ZERO_POINT)
+                            chanCoords[0] = d;
+                            zp0 = v_convert_i32_to_f32_b(v_i32_ld_tnsr_b(chanCoords, zeroPointTensor), e_round_half_ne << 16);
+                            chanCoords[0] = d + 64;
+                            zp1 = v_convert_i32_to_f32_b(v_i32_ld_tnsr_b(chanCoords, zeroPointTensor), e_round_half_ne << 16);
+                            chanCoords[0] = d + 128;
+                            zp2 = v_convert_i32_to_f32_b(v_i32_ld_tnsr_b(chanCoords, zeroPointTensor), e_round_half_ne << 16);
+                            chanCoords[0] = d + 192;
+                            zp3 = v_convert_i32_to_f32_b(v_i32_ld_tnsr_b(chanCoords, zeroPointTensor), e_round_half_ne << 16);
+  #endif
+                        }
+#endif
+
+#if defined(DEQUANT)
+                        coords[depth] = d;
+                        x = byte_to_f32_linear(v_byte_ld_tnsr_b(coords, ifm));
+                        x.v1 = (x.v1 - zp0) * mul0;
+                        x.v2 = (x.v2 - zp1) * mul1;
+                        x.v3 = (x.v3 - zp2) * mul2;
+                        x.v4 = (x.v4 - zp3) * mul3;
+
+  #if defined(BFLOAT16)
+                        float128 lo = {x.v1, x.v2};
+                        float128 hi = {x.v3, x.v4};
+                        st_tnsr_bf16_linear(coords, ofm, lo);
+                        coords[depth] = d + 128;
+                        st_tnsr_bf16_linear(coords, ofm, hi);
+  #else
+                        v_f32_st_tnsr(coords, ofm, x.v1);
+                        coords[depth] = d + 64;
+                        v_f32_st_tnsr(coords, ofm, x.v2);
+                        coords[depth] = d + 128;
+                        v_f32_st_tnsr(coords, ofm, x.v3);
+                        coords[depth] = d + 192;
+                        v_f32_st_tnsr(coords, ofm, x.v4);
+  #endif
+#else
+  #if defined(BFLOAT16)
+                        coords[depth] = d;
+                        float128 lo = bf16_to_f32_linear(v_bf16_ld_tnsr_b(coords, ifm));
+                        coords[depth] = d + 128;
+                        float128 hi = bf16_to_f32_linear(v_bf16_ld_tnsr_b(coords, ifm));
+                        x.v1 = lo.v1;
+                        x.v2 = lo.v2;
+                        x.v3 = hi.v1;
+                        x.v4 = hi.v2;
+  #else
+                        coords[depth] = d;
+                        x.v1 = v_f32_ld_tnsr_b(coords, ifm);
+                        coords[depth] = d + 64;
+                        x.v2 = v_f32_ld_tnsr_b(coords, ifm);
+                        coords[depth] = d + 128;
+                        x.v3 = v_f32_ld_tnsr_b(coords, ifm);
+                        coords[depth] = d + 192;
+                        x.v4 = v_f32_ld_tnsr_b(coords, ifm);
+  #endif
+                        // the values are integral after the zero point is
+                        // added, so the clamp and the byte cast are exact
+                        x.v1 = v_f32_nearbyint_b(x.v1 * mul0, e_round_half_ne) + zp0;
+                        x.v2 = v_f32_nearbyint_b(x.v2 * mul1, e_round_half_ne) + zp1;
+                        x.v3 = v_f32_nearbyint_b(x.v3 * mul2, e_round_half_ne) + zp2;
+                        x.v4 = v_f32_nearbyint_b(x.v4 * mul3, e_round_half_ne) + zp3;
+                        x.v1 = v_f32_min_b(v_f32_max_b(x.v1, I8_MIN), I8_MAX);
+                        x.v2 = v_f32_min_b(v_f32_max_b(x.v2, I8_MIN), I8_MAX);
+                        x.v3 = v_f32_min_b(v_f32_max_b(x.v3, I8_MIN), I8_MAX);
+                        x.v4 = v_f32_min_b(v_f32_max_b(x.v4, I8_MIN), I8_MAX);
+
+                        coords[depth] = d;
+                        st_tnsr_byte_linear(coords, ofm, x);
+#endif
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,258 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+#include "kernel_config.h"
+
+// Reduction over any set of dims of a tensor of up to 5 dims. The math is
+// done in f32 for both data types and the ofm keeps the rank of the ifm with
+// the reduced dims set to 1.
+//
+//   REDUCE_SUM  : sum, or mean with scale = 1/N
+//   REDUCE_PROD : product
+//   REDUCE_MAX  : max
+//   REDUCE_MIN  : min
+//   REDUCE_VAR  : single pass variance with scale = 1/(N - correction),
+//                 std when takeSqrt is set
+//
+// Bit d of reduceMask is set for every reduced dim. An index space member
+// owns a set of output elements and reduces their whole input range, unless
+// the glue code splits the reduced dim splitDim into chunks of `chunk`
+// elements over the index space. The chunks are then added into the zeroed
+// ofm with atomic RMW stores (USING_RMW, REDUCE_SUM only), which keeps all
+// TPCs busy when the reduction produces few outputs.
+//
+// When dim 0 is reduced every lane accumulates its own partial, the lanes
+// are folded before the store. Lanes past the end of dim 0 read the
+// identity of the op.
+//
+// The variance accumulates per lane sum(x - K) and sum((x - K)^2), K being
+// the first vector of the range, which avoids the cancellation of
+// E[x^2] - E[x]^2. Lane partials are merged with the parallel formula
+//   M2 = sum_l (M2_l + n_l * (mean_l - mean)^2)
+
+#if defined(REDUCE_SUM)
+#define REDUCE_IDENTITY         0.0f
+#define reduce_op(a, b)         ((a) + (b))
+#define reduce_lanes(a)         v_f32_reduce_add(a)
+#elif defined(REDUCE_PROD)
+#define REDUCE_IDENTITY         1.0f
+#define reduce_op(a, b)         ((a) * (b))
+#define reduce_lanes(a)         v_f32_reduce_mul(a)
+#elif defined(REDUCE_MAX)
+#define REDUCE_IDENTITY         (-__builtin_inff())
+#define reduce_op(a, b)         v_f32_max_b(a, b)
+#define reduce_lanes(a)         v_f32_reduce_max(a)
+#elif defined(REDUCE_MIN)
+#define REDUCE_IDENTITY         __builtin_inff()
+#define reduce_op(a, b)         v_f32_min_b(a, b)
+#define reduce_lanes(a)         v_f32_reduce_min(a)
+#endif
+
+void main(tensor ifm,
+          tensor ofm,
+          int reduceMask,
+          int splitDim,
+          int chunk,
+          float scale,
+          int takeSqrt)
+{
+    const int5 index_space_start = get_index_space_offset();
+    const int5 index_space_end   = get_index_space_size() + index_space_start;
+
+    // [start, end) of every dim in the outer loops, one iteration per output,
+    // and in the inner loops, the reduced range. A kept dim has the inner
+    // range [0, 1), a reduced dim the outer range [0, 1).
+    const int5 step = {VECTOR_SIZE, 1, 1, 1, 1};
+    int5 outerStart, outerEnd, innerStart, innerEnd;
+
+    #pragma unroll(5)
+    for (int d = 0; d < 5; d++)
+    {
+        const int size = get_dim_size(ifm, d);
+        if ((reduceMask >> d) & 1)
+        {
+            const int dimChunk = (d == splitDim) ? chunk : size;
+            outerStart[d] = 0;
+            outerEnd[d]   = 1;
+            innerStart[d] = index_space_start[d] * dimChunk;
+            innerEnd[d]   = s_i32_min(index_space_end[d] * dimChunk, size);
+        }
+        else
+        {
+            outerStart[d] = index_space_start[d] * step[d];
+            outerEnd[d]   = index_space_end[d] * step[d];
+            innerStart[d] = 0;
+            innerEnd[d]   = 1;
+        }
+    }
+
+    const int depthSize = get_dim_size(ifm, 0);
+    const bool reduceDepth = reduceMask & 1;
+    const ACC_VECTOR laneIds = v_lane_id_acc();
+
+    int5 ifmCoords = {0, 0, 0, 0, 0};
+    int5 ofmCoords = {0, 0, 0, 0, 0};
+
+    for (int o4 = outerStart[4]; o4 < outerEnd[4]; o4++)
+    for (int o3 = outerStart[3]; o3 < outerEnd[3]; o3++)
+    for (int o2 = outerStart[2]; o2 < outerEnd[2]; o2++)
+    for (int o1 = outerStart[1]; o1 < outerEnd[1]; o1++)
+    for (int o0 = outerStart[0]; o0 < outerEnd[0]; o0 += VECTOR_SIZE)
+    {
+        ofmCoords[0] = o0;
+        ofmCoords[1] = o1;
+        ofmCoords[2] = o2;
+        ofmCoords[3] = o3;
+        ofmCoords[4] = o4;
+
+#if defined(REDUCE_VAR)
+        // the shift K is the first vector of the range
+        ifmCoords = ofmCoords + innerStart;
+        const ACC_VECTOR shift = v_to_acc(v_ld_tnsr_i(ifmCoords, ifm));
+        float64 sum[ACC_PARTS];
+        float64 sumSq[ACC_PARTS];
+        float64 count[ACC_PARTS];
+        #pragma unroll(ACC_PARTS)
+        for (int p = 0; p < ACC_PARTS; p++)
+        {
+            sum[p] = 0;
+            sumSq[p] = 0;
+            count[p] = 0;
+        }
+#else
+        float64 acc[ACC_PARTS];
+        #pragma unroll(ACC_PARTS)
+        for (int p = 0; p < ACC_PARTS; p++)
+        {
+            acc[p] = REDUCE_IDENTITY;
+        }
+#endif
+
+        for (int i4 = innerStart[4]; i4 < innerEnd[4]; i4++)
+        for (int i3 = innerStart[3]; i3 < innerEnd[3]; i3++)
+        for (int i2 = innerStart[2]; i2 < innerEnd[2]; i2++)
+        for (int i1 = innerStart[1]; i1 < innerEnd[1]; i1++)
+        for (int i0 = innerStart[0]; i0 < innerEnd[0]; i0 += VECTOR_SIZE)
+        {
+            ifmCoords[0] = o0 + i0;
+            ifmCoords[1] = o1 + i1;
+            ifmCoords[2] = o2 + i2;
+            ifmCoords[3] = o3 + i3;
+            ifmCoords[4] = o4 + i4;
+            const ACC_VECTOR x = v_to_acc(v_ld_tnsr_i(ifmCoords, ifm));
+            const float lanesLeft = (float)(depthSize - ifmCoords[0]);
+
+            #pragma unroll(ACC_PARTS)
+            for (int p = 0; p < ACC_PARTS; p++)
+            {
+                const bool64 pad = v_f32_cmp_geq_b(acc_part(laneIds, p), lanesLeft);
+#if defined(REDUCE_VAR)
+                float64 dev = acc_part(x, p) - acc_part(shift, p);
+                dev = v_f32_mov_vb(0.0f, 0, dev, pad, 0);
+                float64 one = 1.0f;
+                sum[p] += dev;
+                sumSq[p] = v_f32_mac_b(dev, dev, sumSq[p]);
+                count[p] += v_f32_mov_vb(0.0f, 0, one, pad, 0);
+#else
+                const float64 xp = v_f32_mov_vb(REDUCE_IDENTITY, 0, acc_part(x, p), pad, 0);
+                acc[p] = reduce_op(acc[p], xp);
+#endif
+            }
+        }
+
+        ACC_VECTOR result;
+#if defined(REDUCE_VAR)
+        float64 mean[ACC_PARTS];
+        float64 m2[ACC_PARTS];
+        #pragma unroll(ACC_PARTS)
+        for (int p = 0; p < ACC_PARTS; p++)
+        {
+            // lanes that saw no element keep mean = K and M2 = 0
+            const float64 invCount = v_reciprocal_f32(v_f32_max_b(count[p], 1.0f));
+            mean[p] = v_f32_mac_b(sum[p], invCount, acc_part(shift, p));
+            m2[p] = sumSq[p] - sum[p] * sum[p] * invCount;
+        }
+        if (reduceDepth)
+        {
+            float64 total = 0;
+            float64 weighted = 0;
+            #pragma unroll(ACC_PARTS)
+            for (int p = 0; p < ACC_PARTS; p++)
+            {
+                total += count[p];
+                weighted += v_f32_mac_b(count[p], acc_part(shift, p), sum[p]);
+            }
+            const float64 meanAll = v_f32_reduce_add(weighted) * v_reciprocal_f32(v_f32_reduce_add(total));
+
+            float64 m2All = 0;
+            #pragma unroll(ACC_PARTS)
+            for (int p = 0; p < ACC_PARTS; p++)
+            {
+                const float64 delta = mean[p] - meanAll;
+                m2All += m2[p];
+                m2All = v_f32_mac_b(count[p] * delta, delta, m2All);
+            }
+            m2All = v_f32_reduce_add(m2All);
+            #pragma unroll(ACC_PARTS)
+            for (int p = 0; p < ACC_PARTS; p++)
+            {
+                m2[p] = m2All;
+            }
+        }
+        #pragma unroll(ACC_PARTS)
+        for (int p = 0; p < ACC_PARTS; p++)
+        {
+            float64 var = v_f32_max_b(m2[p] * scale, 0.0f);
+            if (takeSqrt)
+            {
+                var = v_sqrt_f32(var);
+            }
+            acc_set_part(result, p, var);
+        }
+#else
+        if (reduceDepth)
+        {
+            // fold the parts and the lanes, every lane gets the result
+            #pragma unroll(ACC_PARTS)
+            for (int p = 1; p < ACC_PARTS; p++)
+            {
+                acc[0] = reduce_op(acc[0], acc[p]);
+            }
+            acc[0] = reduce_lanes(acc[0]);
+            #pragma unroll(ACC_PARTS)
+            for (int p = 1; p < ACC_PARTS; p++)
+            {
+                acc[p] = acc[0];
+            }
+        }
+        #pragma unroll(ACC_PARTS)
+        for (int p = 0; p < ACC_PARTS; p++)
+        {
+#if defined(REDUCE_SUM)
+            acc[p] = acc[p] * scale;
+#endif
+            acc_set_part(result, p, acc[p]);
+        }
+#endif
+
+        // a reduced dim 0 stores lane 0 only, the other lanes fall outside
+        // the ofm
+#if defined(USING_RMW)
+        st_tnsr_rmw_i_v(ofmCoords, ofm, v_from_acc(result), e_rmw_add, e_rmw_atomic, e_tnsr_dt_srf);
+#else
+        st_tnsr_i_v(ofmCoords, ofm, v_from_acc(result));
+#endif
+    }
+}
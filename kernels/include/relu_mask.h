@@ -0,0 +1,160 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+#include "kernel_config.h"
+
+// ReLU / ReLU6 that keep a 1 bit per element mask of where the gradient
+// passes (0 < x, and x < 6 for ReLU6), and the backward that applies it to
+// dY. Bit j of mask word (lane l, d) covers element j * VECTOR_SIZE + l of the
+// 2048 element block of dim 0 starting at d / VECTOR_SIZE * 2048, so the
+// packing stays within a lane. The mask has dim 0 ceil(D / 2048) * VECTOR_SIZE
+// and the data tensor dims 1-4.
+//
+// MASK_BWD selects the backward, USE_RELU6 the ReLU6 flavour.
+
+#if defined(FLOAT32)
+    #define MASK_VECTOR                     int64
+    #define MASK_SCALAR                     int
+    #define MASK_BITS                       32
+    #define PLUS_INF                        0x7f800000
+    #define v_mask_ld_tnsr(c, t)            v_i32_ld_tnsr_b(c, t)
+    #define v_mask_st_tnsr(c, t, v)         v_i32_st_tnsr(c, t, v)
+    #define v_mask_sel_grt(x, s, a, b)      v_i32_sel_grt_f32_b(x, s, a, b)
+    #define v_mask_sel_less(x, s, a, b)     v_i32_sel_less_f32_b(x, s, a, b)
+    #define v_sel_mask_eq(m, s, a, b)       v_f32_sel_eq_i32_b(m, s, a, b)
+    #define v_sel_grt_b(grad, output) \
+                                v_i32_sel_grt_i32_b((int64)grad, PLUS_INF, (int64)grad, (int64)output);
+#elif defined(BFLOAT16)
+    #define MASK_VECTOR                     short128
+    #define MASK_SCALAR                     short
+    #define MASK_BITS                       16
+    #define PLUS_INF                        0x7F80
+    #define v_mask_ld_tnsr(c, t)            v_i16_ld_tnsr_b(c, t)
+    #define v_mask_st_tnsr(c, t, v)         v_i16_st_tnsr(c, t, v)
+    #define v_mask_sel_grt(x, s, a, b)      v_i16_sel_grt_bf16_b(x, s, a, b)
+    #define v_mask_sel_less(x, s, a, b)     v_i16_sel_less_bf16_b(x, s, a, b)
+    #define v_sel_mask_eq(m, s, a, b)       v_bf16_sel_eq_i16_b(m, s, a, b)
+    #define v_sel_grt_b(grad, output) \
+                        v_i16_sel_grt_i16_b((short128)grad, PLUS_INF, (short128)grad, (short128)output);
+#endif
+
+#if defined(MASK_BWD)
+void main(tensor grad, tensor mask, tensor output)
+#else
+void main(tensor input, tensor output, tensor mask)
+#endif
+{
+    const int depth = 0;
+    const int width = 1;
+    const int height = 2;
+    const int batch = 3;
+    const int fifthDim = 4;
+
+    const int5 indexSpaceStart = get_index_space_offset();
+    const int5 indexSpaceEnd = get_index_space_size() + indexSpaceStart;
+
+    // DEPTH, one mask vector per member
+    const int depthStep = VECTOR_SIZE;
+    const int depthStart = indexSpaceStart[depth] * depthStep;
+    const int depthEnd = indexSpaceEnd[depth] * depthStep;
+
+    // WIDTH
+    const int widthStep = 1;
+    const int widthStart = indexSpaceStart[width];
+    const int widthEnd = indexSpaceEnd[width];
+
+    // HEIGHT
+    const int heightStep = 1;
+    const int heightStart = indexSpaceStart[height];
+    const int heightEnd = indexSpaceEnd[height];
+
+    // BATCH
+    const int batchStep = 1;
+    const int batchStart = indexSpaceStart[batch];
+    const int batchEnd = indexSpaceEnd[batch];
+
+    // fifthDim
+    const int fifthDimStep = 1;
+    const int fifthDimStart = indexSpaceStart[fifthDim];
+    const int fifthDimEnd = indexSpaceEnd[fifthDim];
+
+    int5 maskCoords = {0, 0, 0, 0, 0};
+    int5 dataCoords = {0, 0, 0, 0, 0};
+
+    #pragma loop_taken
+    for (int d = depthStart; d < depthEnd; d += depthStep)
+    {
+        maskCoords[depth] = d;
+        const int dataStart = d * MASK_BITS;
+
+        #pragma loop_taken
+        for (int f = fifthDimStart; f < fifthDimEnd; f += fifthDimStep)
+        {
+            maskCoords[fifthDim] = f;   dataCoords[fifthDim] = f;
+
+            #pragma loop_taken
+            for (int b = batchStart; b < batchEnd; b += batchStep)
+            {
+                maskCoords[batch] = b;   dataCoords[batch] = b;
+
+                #pragma loop_taken
+                for (int h = heightStart; h < heightEnd; h += heightStep)
+                {
+                    maskCoords[height] = h;   dataCoords[height] = h;
+
+                    #pragma loop_taken
+                    for (int w = widthStart; w < widthEnd; w += widthStep)
+                    {
+                        maskCoords[width] = w;   dataCoords[width] = w;
+                        dataCoords[depth] = dataStart;
+#if defined(MASK_BWD)
+                        MASK_VECTOR bits = v_mask_ld_tnsr(maskCoords, mask);
+
+                        #pragma unroll 4
+                        for (int j = 0; j < MASK_BITS; j++)
+                        {
+                            VECTOR g = v_ld_tnsr_i(dataCoords, grad);
+                            MASK_VECTOR bit = bits & (MASK_SCALAR)(1 << j);
+                            VECTOR o = v_sel_mask_eq(bit, 0, (SCALAR)0.0, g);
+                            // nan gradients pass like in relu6_bwd
+                            o = (VECTOR)v_sel_grt_b(g, o);
+                            st_tnsr_i_v(dataCoords, output, o);
+                            dataCoords[depth] += VECTOR_SIZE;
+                        }
+#else
+                        MASK_VECTOR bits = 0;
+
+                        #pragma unroll 4
+                        for (int j = 0; j < MASK_BITS; j++)
+                        {
+                            VECTOR x = v_ld_tnsr_i(dataCoords, input);
+                            VECTOR o = v_sel_leq_v_s_v_v(x, (SCALAR)0.0, (SCALAR)0.0, x);
+                            MASK_VECTOR bit = v_mask_sel_grt(x, (SCALAR)0.0, (MASK_SCALAR)(1 << j), 0);
+#if defined(USE_RELU6)
+                            o = v_sel_geq_v_s_v_v(o, (SCALAR)6.0, (SCALAR)6.0, o);
+                            bit = v_mask_sel_less(x, (SCALAR)6.0, bit, 0);
+#endif
+                            bits |= bit;
+                            st_tnsr_i_v(dataCoords, output, o);
+                            dataCoords[depth] += VECTOR_SIZE;
+                        }
+                        v_mask_st_tnsr(maskCoords, mask, bits);
+#endif
+                    }
+                }
+            }
+        }
+    }
+}
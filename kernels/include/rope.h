@@ -0,0 +1,225 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+#include "kernel_config.h"
+#if !defined(ROPE_USE_CACHE)
+#include "sin_f32.h"
+#endif
+
+// Rotary positional embedding of Q and K in a single pass.
+//
+//   out[e] = x[e] * cos[e] + partner[e] * sin[e]
+//   half-split       : partner[e] = -x[e + D/2] for e < D/2, x[e - D/2] otherwise
+//   ROPE_INTERLEAVED : partner[e] = -x[e + 1] for even e, x[e - 1] otherwise
+//
+// Partners come from two loads shifted by +-shift. For the half-split layout
+// the zero padding of out-of-bound lanes already selects the right one.
+//
+//   ROPE_USE_CACHE : cos / sin are read from {D, maxPos} caches at the token
+//                    position, laid out per element like the heads. Positions
+//                    are clamped to [0, maxPos - 1], so an out of range
+//                    position reuses the nearest cache row instead of reading
+//                    the zero padding.
+//   otherwise      : angle = pos * theta^(-2i / D) is evaluated per lane, i
+//                    being the pair index of the element. freqScale holds
+//                    -2 * ln(theta) / D.
+//
+// Every index space member owns one (token, batch) row of all Q and K heads.
+// cos / sin are evaluated once per row, and every head is staged in VLM before
+// it is stored, so qOut / kOut may alias q / k.
+
+// head dim is limited to MAX_HEAD_VECTORS * VECTOR_SIZE
+#define MAX_HEAD_VECTORS        4
+#define HALF_PI                 1.5707963268f
+
+__local__ float64 cosVlm[MAX_HEAD_VECTORS][ACC_PARTS];
+__local__ float64 sinVlm[MAX_HEAD_VECTORS][ACC_PARTS];
+__local__ VECTOR  headVlm[MAX_HEAD_VECTORS];
+
+float64 floor_f32(float64 x)
+{
+    int64 xi = v_convert_f32_to_i32_b(x, e_round_down << 16);
+    return v_convert_i32_to_f32_b(xi, e_round_half_ne << 16);
+}
+
+// Rotates vector j of a head, a / b are the loads at +shift / -shift.
+VECTOR rope_rotate(VECTOR x, VECTOR a, VECTOR b, ACC_VECTOR oddMask, int j)
+{
+    ACC_VECTOR xf = v_to_acc(x);
+    ACC_VECTOR af = v_to_acc(a);
+    ACC_VECTOR bf = v_to_acc(b);
+    ACC_VECTOR y;
+
+    #pragma unroll(ACC_PARTS)
+    for (int p = 0; p < ACC_PARTS; p++)
+    {
+#if defined(ROPE_INTERLEAVED)
+        // -a on even elements, b on odd ones
+        float64 partner = (acc_part(af, p) + acc_part(bf, p)) * acc_part(oddMask, p) - acc_part(af, p);
+#else
+        float64 partner = acc_part(bf, p) - acc_part(af, p);
+#endif
+        float64 yp = acc_part(xf, p) * cosVlm[j][p] + partner * sinVlm[j][p];
+        acc_set_part(y, p, yp);
+    }
+    return v_from_acc(y);
+}
+
+void main(tensor q,
+          tensor k,
+          tensor positions,
+#if defined(ROPE_USE_CACHE)
+          tensor cosCache,
+          tensor sinCache,
+#endif
+          tensor qOut,
+          tensor kOut
+#if !defined(ROPE_USE_CACHE)
+          , float freqScale
+#endif
+          )
+{
+    const int depth = 0;
+    const int token = 1;
+    const int head  = 2;
+    const int batch = 3;
+
+    const int5 index_space_start = get_index_space_offset();
+    const int5 index_space_end = get_index_space_size() + index_space_start;
+
+    // token
+    const int tokenStep  = 1;
+    const int tokenStart = index_space_start[token];
+    const int tokenEnd   = index_space_end[token];
+
+    // batch
+    const int batchStep  = 1;
+    const int batchStart = index_space_start[batch];
+    const int batchEnd   = index_space_end[batch];
+
+    const int headDim     = get_dim_size(q, depth);
+    const int qHeads      = get_dim_size(q, head);
+    const int kHeads      = get_dim_size(k, head);
+    const int headVectors = (headDim + VECTOR_SIZE - 1) / VECTOR_SIZE;
+#if defined(ROPE_USE_CACHE)
+    const int posLast     = get_dim_size(cosCache, 1) - 1;
+#endif
+#if defined(ROPE_INTERLEAVED)
+    const int shift = 1;
+#else
+    const int shift = headDim / 2;
+#endif
+
+    // 1.0 on odd elements, vectors always start at an even element
+    ACC_VECTOR laneId = v_lane_id_acc();
+    ACC_VECTOR oddMask;
+    #pragma unroll(ACC_PARTS)
+    for (int p = 0; p < ACC_PARTS; p++)
+    {
+        float64 l = acc_part(laneId, p);
+        float64 odd = l - floor_f32(l * 0.5f) * 2.0f;
+        acc_set_part(oddMask, p, odd);
+    }
+
+    int5 coords      = {0, 0, 0, 0, 0};
+    int5 posCoords   = {0, 0, 0, 0, 0};
+#if defined(ROPE_USE_CACHE)
+    int5 cacheCoords = {0, 0, 0, 0, 0};
+#endif
+
+    for (int b = batchStart; b < batchEnd; b += batchStep)
+    {
+        coords[batch] = b;
+        posCoords[1] = b;
+
+        for (int t = tokenStart; t < tokenEnd; t += tokenStep)
+        {
+            coords[token] = t;
+            posCoords[0] = t;
+            int pos = s_i32_ld_g((__global__ int*)gen_addr(posCoords, positions));
+
+            // cos / sin of every head vector, shared by all Q and K heads
+            for (int j = 0; j < headVectors; j++)
+            {
+#if defined(ROPE_USE_CACHE)
+                cacheCoords[0] = j * VECTOR_SIZE;
+                cacheCoords[1] = s_i32_max(s_i32_min(pos, posLast), 0);
+                ACC_VECTOR c = v_to_acc(v_ld_tnsr_i(cacheCoords, cosCache));
+                ACC_VECTOR s = v_to_acc(v_ld_tnsr_i(cacheCoords, sinCache));
+                #pragma unroll(ACC_PARTS)
+                for (int p = 0; p < ACC_PARTS; p++)
+                {
+                    cosVlm[j][p] = acc_part(c, p);
+                    sinVlm[j][p] = acc_part(s, p);
+                }
+#else
+                #pragma unroll(ACC_PARTS)
+                for (int p = 0; p < ACC_PARTS; p++)
+                {
+                    float64 e = acc_part(laneId, p) + (float)(j * VECTOR_SIZE);
+    #if defined(ROPE_INTERLEAVED)
+                    float64 pair = floor_f32(e * 0.5f);
+    #else
+                    float64 pair = v_f32_sel_geq_f32_b(e, (float)shift, e - (float)shift, e);
+    #endif
+                    float64 angle = exp_f32(pair * freqScale) * (float)pos;
+                    sinVlm[j][p] = sin_fast_f32(angle);
+                    cosVlm[j][p] = sin_fast_f32(angle + HALF_PI);
+                }
+#endif
+            }
+
+            for (int h = 0; h < qHeads; h++)
+            {
+                coords[head] = h;
+                for (int j = 0; j < headVectors; j++)
+                {
+                    coords[depth] = j * VECTOR_SIZE;
+                    VECTOR x = v_ld_tnsr_i(coords, q);
+                    coords[depth] = j * VECTOR_SIZE + shift;
+                    VECTOR a = v_ld_tnsr_i(coords, q);
+                    coords[depth] = j * VECTOR_SIZE - shift;
+                    VECTOR c = v_ld_tnsr_i(coords, q);
+                    headVlm[j] = rope_rotate(x, a, c, oddMask, j);
+                }
+                for (int j = 0; j < headVectors; j++)
+                {
+                    coords[depth] = j * VECTOR_SIZE;
+                    st_tnsr_i_v(coords, qOut, headVlm[j]);
+                }
+            }
+
+            for (int h = 0; h < kHeads; h++)
+            {
+                coords[head] = h;
+                for (int j = 0; j < headVectors; j++)
+                {
+                    coords[depth] = j * VECTOR_SIZE;
+                    VECTOR x = v_ld_tnsr_i(coords, k);
+                    coords[depth] = j * VECTOR_SIZE + shift;
+                    VECTOR a = v_ld_tnsr_i(coords, k);
+                    coords[depth] = j * VECTOR_SIZE - shift;
+                    VECTOR c = v_ld_tnsr_i(coords, k);
+                    headVlm[j] = rope_rotate(x, a, c, oddMask, j);
+                }
+                for (int j = 0; j < headVectors; j++)
+                {
+                    coords[depth] = j * VECTOR_SIZE;
+                    st_tnsr_i_v(coords, kOut, headVlm[j]);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,333 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include "kernel_config.h"
+#if defined(BFLOAT16)
+#include "bf16_linear.h"
+#endif
+
+// Inclusive / exclusive cumsum (default) or cumprod (SCAN_PROD) along any axis.
+//
+// Long axes use a three-phase scan so that a single row spreads across TPCs.
+// The axis is cut into blocks of blockSize elements, one index space member
+// per block:
+//   SCAN_BLOCK_REDUCE : blockSums[blk] = op of the elements of block blk
+//   (single pass)     : exclusive scan of blockSums along the same axis
+//   SCAN_BLOCK_FIXUP  : scan of every block, seeded with blockCarry[blk]
+// Without a phase define the kernel is the single pass scan, one member walks
+// the whole axis; it is also phase 2 of the three-phase scan.
+//
+// Block sums are f32 for f32 / bf16 data and i32 for i32 data. For bf16 the
+// block sums of a non-FCD scan keep the lane order of the f32 parts, which is
+// internal to the three phases.
+//
+// axis != 0 : lanes run along dim 0 and every lane is an independent scan.
+// axis == 0 : the scan runs inside the vectors. Every vector is loaded once
+//             and scanned in place in 32 bit parts, f32 for f32 / bf16 and
+//             i32 for i32: a Hillis-Steele scan of log2(SCAN_DG_SIZE)
+//             SHUFFLE steps inside every dual group, then the dual group
+//             totals are carried across with MOV_DUAL_GROUP. bf16 vectors
+//             are split into parts of elements 0..63 and 64..127 in element
+//             order and only round once, at the store. The running carry of
+//             the previous parts is a broadcast. blockSize is a multiple of
+//             VECTOR_SIZE, so blocks start at a vector and only end
+//             mid-vector at the row end.
+//
+// Per 32 bit part that is up to SCAN_DG_LOG2 + 4 SHUFFLE and 9 MOV_DUAL_GROUP
+// in place of the VECTOR_SIZE shifted loads of a window built from memory.
+
+#if defined(SCAN_PROD)
+#define SCAN_IDENTITY           1
+#define scan_op(a, b)           ((a) * (b))
+#else
+#define SCAN_IDENTITY           0
+#define scan_op(a, b)           ((a) + (b))
+#endif
+
+// 32 bit lanes of the in-vector scan: 16 per dual group, 8 per group
+#define SCAN_DG_LOG2            4
+#define SCAN_DG_SIZE            (1 << SCAN_DG_LOG2)
+#define SCAN_GROUP_LOG2         (SCAN_DG_LOG2 - 1)
+
+#if defined(INT32)
+typedef int64                   SCAN_PART;
+#define v_ld_sums(a, b)         v_i32_ld_tnsr_b(a, b)
+#define st_sums(a, b, c)        v_i32_st_tnsr(a, b, c)
+#define s_ld_sums(a, b)         s_i32_ld_g((__global__ int*)gen_addr(a, b))
+#define scan_shuffle(a, ctl, income) \
+                v_i32_shuffle_b(a, ctl, 0, income)
+#define scan_mov_dual_group(a, s, d, income) \
+                v_i32_mov_dual_group_b(a, 0xFFFFFFFF, s, d, MkWr(1, 1), income)
+#else
+typedef float64                 SCAN_PART;
+#define v_ld_sums(a, b)         v_f32_ld_tnsr_b(a, b)
+#define st_sums(a, b, c)        v_f32_st_tnsr(a, b, c)
+#define s_ld_sums(a, b)         s_f32_ld_g((__global__ float*)gen_addr(a, b))
+#define scan_shuffle(a, ctl, income) \
+                v_f32_shuffle_b(a, ctl, 0, income)
+#define scan_mov_dual_group(a, s, d, income) \
+                v_f32_mov_dual_group_b(a, 0xFFFFFFFF, s, d, MkWr(1, 1), income)
+#endif
+
+// Vectors of the in-vector scan as 32 bit parts in element order, part p
+// holds elements p * 64 .. p * 64 + 63.
+#if defined(BFLOAT16)
+#define v_ld_linear(a, b)       bf16_to_f32_linear(v_bf16_ld_tnsr_b(a, b))
+#define st_linear(a, b, c)      st_tnsr_bf16_linear(a, b, c)
+#else
+#define v_ld_linear(a, b)       v_ld_tnsr_i(a, b)
+#define st_linear(a, b, c)      st_tnsr_i_v(a, b, c)
+#endif
+
+// in-vector scan controls, filled by scan_init_ctl()
+__local__ uchar256 vlmCtlScan[SCAN_DG_LOG2];
+__local__ uchar256 vlmCtlLast;
+
+// SHUFFLE control of a 32 bit lane, as shuffle_ctl() of vlm_transpose.h:
+// source lane within its group (bits 0-2), source group within the dual
+// group (bit 5) and write enable (bit 7).
+uint64 scan_shuffle_ctl(uint64 src, uint64 enable)
+{
+    uint64 ctl = (src & ((1 << SCAN_GROUP_LOG2) - 1)) | (((src >> SCAN_GROUP_LOG2) & 1) << 5) | 0x80;
+    return ctl & (0 - enable);
+}
+
+// stage s : lanes at or past 1 << s of their dual group take the lane
+//           1 << s below, the others keep the income
+// last    : every lane takes the last lane of its dual group
+void scan_init_ctl()
+{
+    const uint64 dgLane = read_lane_id_4b_b() & (SCAN_DG_SIZE - 1);
+    for (int stage = 0; stage < SCAN_DG_LOG2; stage++)
+    {
+        const int s = 1 << stage;
+        uint64 enable = ((dgLane + (SCAN_DG_SIZE - s)) >> SCAN_DG_LOG2) & 1;
+        uint64 ctl = scan_shuffle_ctl(dgLane - s, enable);
+        vlmCtlScan[stage] = *((uchar256*)&ctl);
+    }
+    const uint64 all = 1;
+    uint64 last = scan_shuffle_ctl(dgLane | (SCAN_DG_SIZE - 1), all);
+    vlmCtlLast = *((uchar256*)&last);
+}
+
+// Inclusive scan of the lanes of x.
+SCAN_PART scan_vector(SCAN_PART x, SCAN_PART identity)
+{
+    for (int stage = 0; stage < SCAN_DG_LOG2; stage++)
+    {
+        x = scan_op(x, scan_shuffle(x, vlmCtlScan[stage], identity));
+    }
+    // dual group g is carried by the op of the totals of dual groups 0 .. g - 1
+    SCAN_PART totals = scan_shuffle(x, vlmCtlLast, identity);
+    SCAN_PART carry = identity;
+    carry = scan_mov_dual_group(scan_op(carry, totals), 0, 1, carry);
+    carry = scan_mov_dual_group(scan_op(carry, totals), 1, 2, carry);
+    carry = scan_mov_dual_group(scan_op(carry, totals), 2, 3, carry);
+    return scan_op(x, carry);
+}
+
+// Lane l of the result is lane l - 1 of x, lane 0 is the identity.
+SCAN_PART shift_lanes(SCAN_PART x, SCAN_PART identity)
+{
+    SCAN_PART last = scan_shuffle(x, vlmCtlLast, identity);
+    SCAN_PART prev = identity;
+    prev = scan_mov_dual_group(last, 0, 1, prev);
+    prev = scan_mov_dual_group(last, 1, 2, prev);
+    prev = scan_mov_dual_group(last, 2, 3, prev);
+    return scan_shuffle(x, vlmCtlScan[0], prev);
+}
+
+// Every lane of the result is the last lane of x.
+SCAN_PART last_lane(SCAN_PART x)
+{
+    SCAN_PART last = scan_shuffle(x, vlmCtlLast, x);
+    last = scan_mov_dual_group(last, 3, 0, last);
+    last = scan_mov_dual_group(last, 3, 1, last);
+    last = scan_mov_dual_group(last, 3, 2, last);
+    return last;
+}
+
+void main(tensor ifm,
+#if defined(SCAN_BLOCK_REDUCE)
+          tensor blockSums,
+          int axis,
+          int blockSize
+#elif defined(SCAN_BLOCK_FIXUP)
+          tensor blockCarry,
+          tensor ofm,
+          int axis,
+          int blockSize,
+          int exclusive
+#else
+          tensor ofm,
+          int axis,
+          int exclusive
+#endif
+          )
+{
+    const int5 index_space_start = get_index_space_offset();
+    const int5 index_space_end = get_index_space_size() + index_space_start;
+
+    const int axisSize = get_dim_size(ifm, axis);
+#if !defined(SCAN_BLOCK_FIXUP) && !defined(SCAN_BLOCK_REDUCE)
+    const int blockSize = axisSize;
+#endif
+#if defined(SCAN_BLOCK_REDUCE)
+    const int exclusive = 0;
+#endif
+    // f32 part p of a bf16 vector is kept at dim 0 offset p * 64 of the block sums
+    const int partSize = VECTOR_SIZE / ACC_PARTS;
+
+    const SCAN_PART identity = SCAN_IDENTITY;
+    if (axis == 0)
+    {
+        scan_init_ctl();
+    }
+
+    // index space dim 0 counts vectors, or blocks when scanning dim 0
+    const int dim0Step = (axis == 0) ? 1 : VECTOR_SIZE;
+
+    int5 coords    = {0, 0, 0, 0, 0};
+    int5 sumCoords = {0, 0, 0, 0, 0};
+
+    for (int i3 = index_space_start[3]; i3 < index_space_end[3]; i3++)
+    {
+        for (int i2 = index_space_start[2]; i2 < index_space_end[2]; i2++)
+        {
+            for (int i1 = index_space_start[1]; i1 < index_space_end[1]; i1++)
+            {
+                for (int i0 = index_space_start[0]; i0 < index_space_end[0]; i0++)
+                {
+                    // the scan loops move coords along the axis, restore the member
+                    coords[0] = i0 * dim0Step;
+                    coords[1] = i1;
+                    coords[2] = i2;
+                    coords[3] = i3;
+
+                    // the member index along the axis is the block index
+                    const int blk = coords[axis];
+                    const int blockStart = blk * blockSize;
+                    const int blockEnd = (blockStart + blockSize < axisSize) ? blockStart + blockSize : axisSize;
+                    sumCoords = coords;
+
+                    // running scan, seeded with the carry of the previous blocks
+                    SCAN_PART acc[ACC_PARTS];
+                    #pragma unroll(ACC_PARTS)
+                    for (int p = 0; p < ACC_PARTS; p++)
+                    {
+#if defined(SCAN_BLOCK_FIXUP)
+                        if (axis == 0)
+                        {
+                            acc[p] = s_ld_sums(sumCoords, blockCarry);
+                        }
+                        else
+                        {
+                            sumCoords[0] = coords[0] + p * partSize;
+                            acc[p] = v_ld_sums(sumCoords, blockCarry);
+                        }
+#else
+                        acc[p] = identity;
+#endif
+                    }
+
+                    if (axis != 0)
+                    {
+                        for (int t = blockStart; t < blockEnd; t++)
+                        {
+                            coords[axis] = t;
+                            ACC_VECTOR x = v_to_acc(v_ld_tnsr_i(coords, ifm));
+#if !defined(SCAN_BLOCK_REDUCE)
+                            ACC_VECTOR y;
+#endif
+                            #pragma unroll(ACC_PARTS)
+                            for (int p = 0; p < ACC_PARTS; p++)
+                            {
+#if defined(SCAN_BLOCK_REDUCE)
+                                acc[p] = scan_op(acc[p], acc_part(x, p));
+#else
+                                SCAN_PART before = acc[p];
+                                acc[p] = scan_op(acc[p], acc_part(x, p));
+                                acc_set_part(y, p, exclusive ? before : acc[p]);
+#endif
+                            }
+#if !defined(SCAN_BLOCK_REDUCE)
+                            st_tnsr_i_v(coords, ofm, v_from_acc(y));
+#endif
+                        }
+#if defined(SCAN_BLOCK_REDUCE)
+                        #pragma unroll(ACC_PARTS)
+                        for (int p = 0; p < ACC_PARTS; p++)
+                        {
+                            sumCoords[0] = coords[0] + p * partSize;
+                            st_sums(sumCoords, blockSums, acc[p]);
+                        }
+#endif
+                    }
+                    else
+                    {
+                        // carry is the op of the previous parts, the same in
+                        // every lane. tail is the scan of the latest part.
+                        SCAN_PART carry = acc[0];
+                        SCAN_PART tail[ACC_PARTS];
+                        for (int d = blockStart; d < blockEnd; d += VECTOR_SIZE)
+                        {
+                            coords[0] = d;
+                            ACC_VECTOR x = v_ld_linear(coords, ifm);
+#if !defined(SCAN_BLOCK_REDUCE)
+                            ACC_VECTOR y;
+#endif
+                            // lanes past the row end only occur in the last vector
+                            #pragma unroll(ACC_PARTS)
+                            for (int p = 0; p < ACC_PARTS; p++)
+                            {
+                                SCAN_PART inclusive = scan_vector(acc_part(x, p), identity);
+                                SCAN_PART scanned = exclusive ? shift_lanes(inclusive, identity) : inclusive;
+                                tail[p] = scan_op(carry, scanned);
+#if !defined(SCAN_BLOCK_REDUCE)
+                                acc_set_part(y, p, tail[p]);
+#endif
+                                carry = scan_op(carry, last_lane(inclusive));
+                            }
+#if !defined(SCAN_BLOCK_REDUCE)
+                            st_linear(coords, ofm, y);
+#endif
+                        }
+#if defined(SCAN_BLOCK_REDUCE)
+                        // the block total sits at the lane of the last element
+                        const int lastLane = (blockEnd - 1 - blockStart) % VECTOR_SIZE;
+                        sumCoords[0] = blk;
+    #if defined(INT32)
+                        sumCoords[0] = blk - lastLane;
+                        v_i32_st_tnsr_partial(sumCoords, blockSums, tail[0], 0, lastLane);
+    #else
+                        const int partLanes = VECTOR_SIZE / ACC_PARTS;
+                        const float64 laneId = v_convert_i32_to_f32_b((int64)read_lane_id_4b_b(), e_round_half_ne << 16);
+                        float64 total = 0.0f;
+                        #pragma unroll(ACC_PARTS)
+                        for (int p = 0; p < ACC_PARTS; p++)
+                        {
+                            total += v_f32_sel_eq_f32_b(laneId, (float)(lastLane - p * partLanes), tail[p], 0.0f);
+                        }
+                        total = v_f32_reduce_add(total);
+                        v_f32_st_tnsr_partial(sumCoords, blockSums, total, 0, 0);
+    #endif
+#endif
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,274 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include "kernel_config.h"
+
+// Fused attention score softmax along dim 0 of {kLen, qLen, heads, batch}:
+//
+//   out = softmax(scale * x + mask)
+//
+//   SOFTMAX_MASK_TENSOR : mask is an additive {kLen, qLen} tensor, broadcast
+//                         over heads and batch
+//   maskMode            : generated on top of it from the lane ids
+//       SOFTMAX_MASK_CAUSAL : key k of query q is visible for k <= q + causalOffset
+//       SOFTMAX_MASK_ALIBI  : causal, plus slope * (k - q - causalOffset) where
+//                             slope = exp((head + 1) * alibiStep)
+//
+// Keys past the causal limit are neither loaded nor exponentiated, their
+// output vectors are stored as zero. A row with no visible key is all zero.
+// The scaled scores are kept in f32 in VLM between the passes. Rows longer
+// than the cache recompute the tail from the input.
+
+#define SOFTMAX_MASK_NONE       0
+#define SOFTMAX_MASK_CAUSAL     1
+#define SOFTMAX_MASK_ALIBI      2
+
+// VLM  CONFIGURATION
+// space left for register spill
+#define REG_SPILL_REDUCTION     20
+// 64 vectors are left free for the exp and reciprocal LUTs
+#define VLM_MAX_VECTOR          (256 - REG_SPILL_REDUCTION)
+// input vectors whose f32 scores fit in the vlm
+#define VLM_VECTORS_IN_DEPTH    (VLM_MAX_VECTOR / ACC_PARTS)
+
+#define SOFTMAX_LOWEST_F32      -3.0e38f
+
+__local__ float64 vlm[VLM_VECTORS_IN_DEPTH][ACC_PARTS];
+
+// scale * x + mask + bias, keys past keyLimit are -inf
+ACC_VECTOR masked_scores(ACC_VECTOR x,
+#if defined(SOFTMAX_MASK_TENSOR)
+                         ACC_VECTOR m,
+#endif
+                         ACC_VECTOR laneId, int d, float keyLimit,
+                         float scale, float queryPos, float64 slope, int maskMode)
+{
+    const uint64 negInfBits = 0xff800000;
+    const float64 negInf = *((float64*)&negInfBits);
+    ACC_VECTOR z;
+
+    #pragma unroll(ACC_PARTS)
+    for (int p = 0; p < ACC_PARTS; p++)
+    {
+        float64 keyPos = acc_part(laneId, p) + (float)d;
+        float64 zp = acc_part(x, p) * scale;
+#if defined(SOFTMAX_MASK_TENSOR)
+        zp += acc_part(m, p);
+#endif
+        if (maskMode == SOFTMAX_MASK_ALIBI)
+        {
+            zp = v_f32_mac_b(keyPos - queryPos, slope, zp);
+        }
+        zp = v_f32_sel_grt_f32_b(keyPos, keyLimit, negInf, zp);
+        acc_set_part(z, p, zp);
+    }
+    return z;
+}
+
+void main(tensor ifm,
+#if defined(SOFTMAX_MASK_TENSOR)
+          tensor mask,
+#endif
+          tensor ofm,
+          float scale,
+          int maskMode,
+          int causalOffset,
+          float alibiStep)
+{
+    const int depth  = 0;
+    const int width  = 1;
+    const int height = 2;
+    const int batch  = 3;
+
+    const int5 index_space_start = get_index_space_offset();
+    const int5 index_space_end = get_index_space_size() + index_space_start;
+
+    // depth, whole key row per member
+    const int depthStep = VECTOR_SIZE;
+    const int depthEnd  = get_dim_size(ifm, depth);
+
+    // width (query)
+    const int widthStep  = 1;
+    const int widthStart = index_space_start[width] * widthStep;
+    const int widthEnd   = index_space_end[width]   * widthStep;
+
+    // height (head)
+    const int heightStep  = 1;
+    const int heightStart = index_space_start[height] * heightStep;
+    const int heightEnd   = index_space_end[height]   * heightStep;
+
+    // batch
+    const int batchStep  = 1;
+    const int batchStart = index_space_start[batch] * batchStep;
+    const int batchEnd   = index_space_end[batch]   * batchStep;
+
+    const ACC_VECTOR laneId = v_lane_id_acc();
+    const VECTOR zero = 0.0f;
+
+    int5 coords = {0, 0, 0, 0, 0};
+#if defined(SOFTMAX_MASK_TENSOR)
+    int5 maskCoords = {0, 0, 0, 0, 0};
+    ACC_VECTOR m;
+#endif
+
+    for (int b = batchStart; b < batchEnd; b += batchStep)
+    {
+        coords[batch] = b;
+        for (int h = heightStart; h < heightEnd; h += heightStep)
+        {
+            coords[height] = h;
+
+            float64 slope = 0.0f;
+            if (maskMode == SOFTMAX_MASK_ALIBI)
+            {
+                slope = exp_f32((float64)((float)(h + 1) * alibiStep));
+            }
+
+            for (int w = widthStart; w < widthEnd; w += widthStep)
+            {
+                coords[width] = w;
+#if defined(SOFTMAX_MASK_TENSOR)
+                maskCoords[width] = w;
+#endif
+                // keys this query can see
+                int validEnd = depthEnd;
+                if (maskMode != SOFTMAX_MASK_NONE)
+                {
+                    int causalEnd = w + causalOffset + 1;
+                    validEnd = causalEnd < depthEnd ? causalEnd : depthEnd;
+                    validEnd = validEnd > 0 ? validEnd : 0;
+                }
+                const float keyLimit = (float)(validEnd - 1);
+                const float queryPos = (float)(w + causalOffset);
+
+                // pass 1: masked scores into the vlm, running max
+                float64 rowMax[ACC_PARTS];
+                #pragma unroll(ACC_PARTS)
+                for (int p = 0; p < ACC_PARTS; p++)
+                {
+                    rowMax[p] = SOFTMAX_LOWEST_F32;
+                }
+                for (int d = 0, i = 0; d < validEnd; d += depthStep, i++)
+                {
+                    coords[depth] = d;
+                    ACC_VECTOR x = v_to_acc(v_ld_tnsr_i(coords, ifm));
+#if defined(SOFTMAX_MASK_TENSOR)
+                    maskCoords[depth] = d;
+                    m = v_to_acc(v_ld_tnsr_i(maskCoords, mask));
+                    ACC_VECTOR z = masked_scores(x, m, laneId, d, keyLimit, scale, queryPos, slope, maskMode);
+#else
+                    ACC_VECTOR z = masked_scores(x, laneId, d, keyLimit, scale, queryPos, slope, maskMode);
+#endif
+                    #pragma unroll(ACC_PARTS)
+                    for (int p = 0; p < ACC_PARTS; p++)
+                    {
+                        if (i < VLM_VECTORS_IN_DEPTH)
+                        {
+                            vlm[i][p] = acc_part(z, p);
+                        }
+                        rowMax[p] = v_f32_max_b(rowMax[p], acc_part(z, p));
+                    }
+                }
+                float64 maxVal = rowMax[0];
+                #pragma unroll(ACC_PARTS)
+                for (int p = 1; p < ACC_PARTS; p++)
+                {
+                    maxVal = v_f32_max_b(maxVal, rowMax[p]);
+                }
+                maxVal = v_f32_reduce_max(maxVal);
+
+                // pass 2: exp(z - max) replaces the scores in the vlm, sum
+                float64 sum = 0.0f;
+                for (int d = 0, i = 0; d < validEnd; d += depthStep, i++)
+                {
+                    ACC_VECTOR z;
+                    if (i < VLM_VECTORS_IN_DEPTH)
+                    {
+                        #pragma unroll(ACC_PARTS)
+                        for (int p = 0; p < ACC_PARTS; p++)
+                        {
+                            acc_set_part(z, p, vlm[i][p]);
+                        }
+                    }
+                    else
+                    {
+                        coords[depth] = d;
+                        ACC_VECTOR x = v_to_acc(v_ld_tnsr_i(coords, ifm));
+#if defined(SOFTMAX_MASK_TENSOR)
+                        maskCoords[depth] = d;
+                        m = v_to_acc(v_ld_tnsr_i(maskCoords, mask));
+                        z = masked_scores(x, m, laneId, d, keyLimit, scale, queryPos, slope, maskMode);
+#else
+                        z = masked_scores(x, laneId, d, keyLimit, scale, queryPos, slope, maskMode);
+#endif
+                    }
+                    #pragma unroll(ACC_PARTS)
+                    for (int p = 0; p < ACC_PARTS; p++)
+                    {
+                        float64 e = exp_f32(acc_part(z, p) - maxVal);
+                        if (i < VLM_VECTORS_IN_DEPTH)
+                        {
+                            vlm[i][p] = e;
+                        }
+                        sum += e;
+                    }
+                }
+                sum = v_f32_reduce_add(sum);
+                float64 recip = v_reciprocal_f32(sum);
+
+                // pass 3: normalize
+                for (int d = 0, i = 0; d < validEnd; d += depthStep, i++)
+                {
+                    coords[depth] = d;
+                    ACC_VECTOR y;
+                    if (i < VLM_VECTORS_IN_DEPTH)
+                    {
+                        #pragma unroll(ACC_PARTS)
+                        for (int p = 0; p < ACC_PARTS; p++)
+                        {
+                            acc_set_part(y, p, vlm[i][p] * recip);
+                        }
+                    }
+                    else
+                    {
+                        ACC_VECTOR x = v_to_acc(v_ld_tnsr_i(coords, ifm));
+#if defined(SOFTMAX_MASK_TENSOR)
+                        maskCoords[depth] = d;
+                        m = v_to_acc(v_ld_tnsr_i(maskCoords, mask));
+                        ACC_VECTOR z = masked_scores(x, m, laneId, d, keyLimit, scale, queryPos, slope, maskMode);
+#else
+                        ACC_VECTOR z = masked_scores(x, laneId, d, keyLimit, scale, queryPos, slope, maskMode);
+#endif
+                        #pragma unroll(ACC_PARTS)
+                        for (int p = 0; p < ACC_PARTS; p++)
+                        {
+                            acc_set_part(y, p, exp_f32(acc_part(z, p) - maxVal) * recip);
+                        }
+                    }
+                    st_tnsr_i_v(coords, ofm, v_from_acc(y));
+                }
+
+                // fully masked vectors are never loaded
+                const int zeroStart = (validEnd + depthStep - 1) / depthStep * depthStep;
+                for (int d = zeroStart; d < depthEnd; d += depthStep)
+                {
+                    coords[depth] = d;
+                    st_tnsr_i_v(coords, ofm, zero);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,219 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include "kernel_config.h"
+
+// Top-k / argmax along dim 0 (FCD). Emits the k largest values of every row in
+// descending order together with their int32 element indices; ties keep the
+// lower index first.
+//
+// Phase 1: every lane keeps a sorted running top-k of the elements it sees.
+//          A new element is bubbled down the list with compare / select only,
+//          so there are no per-lane branches.
+// Phase 2: k rounds of cross-lane merge. Each round reduces the list heads to
+//          the row maximum, picks the lowest index holding it and pops that
+//          lane's head.
+//
+// ARGMAX keeps the single running candidate in registers, the top-k lists are
+// TOPK_MAX entries deep and live in VLM.
+//
+// Indices are carried as f32, which is exact for rows up to 2^24 elements.
+
+#if defined(ARGMAX)
+#define TOPK_MAX                1
+#else
+#define TOPK_MAX                64
+#endif
+// index of the empty list entries, larger than any real index
+#define TOPK_NO_INDEX           16777216.0f
+
+#if defined(ARGMAX)
+#define HEAD_VAL(p)             bestVal[p]
+#define HEAD_IDX(p)             bestIdx[p]
+#else
+__local__ float64 topVal[TOPK_MAX][ACC_PARTS];
+__local__ float64 topIdx[TOPK_MAX][ACC_PARTS];
+#define HEAD_VAL(p)             topVal[0][p]
+#define HEAD_IDX(p)             topIdx[0][p]
+#endif
+
+void main(tensor ifm,
+          tensor values,
+          tensor indices
+#if !defined(ARGMAX)
+          , int k
+#endif
+          )
+{
+    const int depth  = 0;
+    const int width  = 1;
+    const int height = 2;
+    const int batch  = 3;
+
+    const int5 index_space_start = get_index_space_offset();
+    const int5 index_space_end = get_index_space_size() + index_space_start;
+
+    // width
+    const int widthStep  = 1;
+    const int widthStart = index_space_start[width];
+    const int widthEnd   = index_space_end[width];
+
+    // height
+    const int heightStep  = 1;
+    const int heightStart = index_space_start[height];
+    const int heightEnd   = index_space_end[height];
+
+    // batch
+    const int batchStep  = 1;
+    const int batchStart = index_space_start[batch];
+    const int batchEnd   = index_space_end[batch];
+
+    const int depthEnd = get_dim_size(ifm, depth);
+#if defined(ARGMAX)
+    const int k = 1;
+#endif
+
+    const uint64 negInfBits = 0xff800000;
+    const float64 negInf = *((float64*)&negInfBits);
+
+    // element offset of every lane, and of every 32-bit output lane
+    const ACC_VECTOR laneId = v_lane_id_acc();
+    const float64 outLane = v_convert_i32_to_f32_b((int64)read_lane_id_4b_b(), e_round_half_ne << 16);
+
+    int5 coords = {0, 0, 0, 0, 0};
+
+    for (int b = batchStart; b < batchEnd; b += batchStep)
+    {
+        coords[batch] = b;
+
+        for (int h = heightStart; h < heightEnd; h += heightStep)
+        {
+            coords[height] = h;
+
+            for (int w = widthStart; w < widthEnd; w += widthStep)
+            {
+                coords[width] = w;
+
+#if defined(ARGMAX)
+                float64 bestVal[ACC_PARTS];
+                float64 bestIdx[ACC_PARTS];
+                #pragma unroll(ACC_PARTS)
+                for (int p = 0; p < ACC_PARTS; p++)
+                {
+                    bestVal[p] = negInf;
+                    bestIdx[p] = TOPK_NO_INDEX;
+                }
+#else
+                for (int j = 0; j < k; j++)
+                {
+                    #pragma unroll(ACC_PARTS)
+                    for (int p = 0; p < ACC_PARTS; p++)
+                    {
+                        topVal[j][p] = negInf;
+                        topIdx[j][p] = TOPK_NO_INDEX;
+                    }
+                }
+#endif
+
+                // phase 1 - per lane running top-k
+                for (int d = 0; d < depthEnd; d += VECTOR_SIZE)
+                {
+                    coords[depth] = d;
+                    ACC_VECTOR x = v_to_acc(v_ld_tnsr_i(coords, ifm));
+
+                    #pragma unroll(ACC_PARTS)
+                    for (int p = 0; p < ACC_PARTS; p++)
+                    {
+                        float64 idx = acc_part(laneId, p) + (float)d;
+                        // lanes past the row end never win
+                        float64 val = v_f32_sel_geq_f32_b(idx, (float)depthEnd, negInf, acc_part(x, p));
+#if defined(ARGMAX)
+                        bestIdx[p] = v_f32_sel_grt_f32_b(val, bestVal[p], idx, bestIdx[p]);
+                        bestVal[p] = v_f32_max_b(val, bestVal[p]);
+#else
+                        for (int j = 0; j < k; j++)
+                        {
+                            float64 curVal = topVal[j][p];
+                            float64 curIdx = topIdx[j][p];
+                            // the larger one stays at j, the other moves on to j + 1
+                            topVal[j][p] = v_f32_max_b(val, curVal);
+                            topIdx[j][p] = v_f32_sel_grt_f32_b(val, curVal, idx, curIdx);
+                            idx = v_f32_sel_grt_f32_b(val, curVal, curIdx, idx);
+                            val = v_f32_min_b(val, curVal);
+                        }
+#endif
+                    }
+                }
+
+                // phase 2 - cross-lane merge of the per lane lists
+                ACC_VECTOR outVal;
+                #pragma unroll(ACC_PARTS)
+                for (int p = 0; p < ACC_PARTS; p++)
+                {
+                    acc_set_part(outVal, p, 0.0f);
+                }
+                float64 outIdx = 0.0f;
+                for (int r = 0; r < k; r++)
+                {
+                    float64 headVal = HEAD_VAL(0);
+                    #pragma unroll(ACC_PARTS)
+                    for (int p = 1; p < ACC_PARTS; p++)
+                    {
+                        headVal = v_f32_max_b(headVal, HEAD_VAL(p));
+                    }
+                    float64 rowMax = v_f32_reduce_max(headVal);
+
+                    float64 headIdx = v_f32_sel_eq_f32_b(HEAD_VAL(0), rowMax, HEAD_IDX(0), TOPK_NO_INDEX);
+                    #pragma unroll(ACC_PARTS)
+                    for (int p = 1; p < ACC_PARTS; p++)
+                    {
+                        float64 pIdx = v_f32_sel_eq_f32_b(HEAD_VAL(p), rowMax, HEAD_IDX(p), TOPK_NO_INDEX);
+                        headIdx = v_f32_min_b(headIdx, pIdx);
+                    }
+                    float64 rowIdx = v_f32_reduce_min(headIdx);
+
+#if !defined(ARGMAX)
+                    // pop the head of the single lane holding rowIdx
+                    #pragma unroll(ACC_PARTS)
+                    for (int p = 0; p < ACC_PARTS; p++)
+                    {
+                        float64 popIdx = topIdx[0][p];
+                        for (int j = 0; j < k - 1 - r; j++)
+                        {
+                            topVal[j][p] = v_f32_sel_eq_f32_b(popIdx, rowIdx, topVal[j + 1][p], topVal[j][p]);
+                            topIdx[j][p] = v_f32_sel_eq_f32_b(popIdx, rowIdx, topIdx[j + 1][p], topIdx[j][p]);
+                        }
+                        topVal[k - 1 - r][p] = v_f32_sel_eq_f32_b(popIdx, rowIdx, negInf, topVal[k - 1 - r][p]);
+                        topIdx[k - 1 - r][p] = v_f32_sel_eq_f32_b(popIdx, rowIdx, TOPK_NO_INDEX, topIdx[k - 1 - r][p]);
+                    }
+#endif
+                    // result r goes to element r of the outputs
+                    #pragma unroll(ACC_PARTS)
+                    for (int p = 0; p < ACC_PARTS; p++)
+                    {
+                        float64 v = v_f32_sel_eq_f32_b(acc_part(laneId, p), (float)r, rowMax, acc_part(outVal, p));
+                        acc_set_part(outVal, p, v);
+                    }
+                    outIdx = v_f32_sel_eq_f32_b(outLane, (float)r, rowIdx, outIdx);
+                }
+
+                coords[depth] = 0;
+                st_tnsr_i_v(coords, values, v_from_acc(outVal));
+                v_i32_st_tnsr(coords, indices, v_convert_f32_to_i32_b(outIdx, e_round_half_ne << 16));
+            }
+        }
+    }
+}
@@ -0,0 +1,483 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+#include "sin_f32.h"
+
+// Elementwise f32 transcendental functions in two accuracy tiers. One of the
+// TR_* defines selects the function, TR_PRECISE the tier:
+//
+//   TR_COS, TR_SINCOS (ofm = sin, ofm2 = cos), TR_EXP, TR_LOG, TR_TANH,
+//   TR_SIGMOID, TR_RSQRT, TR_ERF
+//
+// fast    : finite inputs in the range of the result. sin / cos use the
+//           sin_cos LUT of sin_f32.h, the other functions a short polynomial
+//           after bit level range reduction and no LUT. The LUT backed
+//           exp_f32, log_f32, v_rsqrt_f32 and v_sigmoid_f32 of the TPC
+//           library have no error bound to test against here, the
+//           polynomials have one and skip the LUT load.
+// precise : Cody-Waite range reduction, longer polynomials and handling of
+//           nan / inf / overflow. Denormal inputs count as 0.
+//
+// Max error against a correctly rounded result on a host float model of
+// this code with fused MACs and an exact reciprocal, not on the simulator
+// (sin / cos for |x| <= 100). The test allows 1 ULP more.
+//
+//            cos  exp  log  tanh  sigmoid  rsqrt  erf
+//   fast     LUT    9   11     5        7      2   10
+//   precise    2    2    1     2        3      1    3
+
+#define NUM_UNROLL              4
+
+#define LOG2E                   1.44269504089f
+#define LN2                     0.693147180560f
+// ln2 split for Cody-Waite, LN2_HI has 9 significant bits
+#define LN2_HI                  0.693359375f
+#define LN2_LO                  -2.12194440e-4f
+#define EXP_MAX_ARG             88.7228393555f
+#define EXP_MIN_ARG             -87.3365402222f
+#define FOUR_BY_PI              1.27323954474f
+#define PI4_1                   0.78515625f
+#define PI4_2                   2.4187564849853515625e-4f
+#define PI4_3                   3.77489497744594108e-8f
+#define SQRT_HALF               0.707106781187f
+#define RSQRT_MAGIC             0x5f3759df
+// below: erf(x) = x * P(x^2), above: erf(x) = 1 - exp(-x^2) * Q((x - 2.5) * 2/3)
+#define ERF_SPLIT               1.0f
+// erf(x) rounds to 1 past this point
+#define ERF_ONE                 4.0f
+
+float64 nan_f32()
+{
+    const uint64 nanBits = 0x7fffffff;
+    return *((float64*)&nanBits);
+}
+
+float64 inf_f32()
+{
+    const uint64 infBits = 0x7f800000;
+    return *((float64*)&infBits);
+}
+
+// y * 2^n for n in the normal exponent range
+float64 scale_pow2_f32(float64 y, int64 n)
+{
+    int64 bits = *((int64*)&y) + (n << 23);
+    return *((float64*)&bits);
+}
+
+// x with the sign of s
+float64 copy_sign_f32(float64 x, float64 s)
+{
+    return v_f32_sel_less_f32_b(s, 0.0f, -x, x);
+}
+
+// nan inputs pass through
+float64 keep_nan_f32(float64 x, float64 result)
+{
+    float64 absX = v_f32_abs_b(x);
+    return v_f32_sel_grt_u32_b(*((uint64*)&absX), 0x7f800000, x, result);
+}
+
+////////////////////////////////////////// EXP //////////////////////////////////////////////////
+// e^r = 1 + r + r^2 * P(r) on |r| <= ln2/2
+
+float64 exp_fast_f32(float64 x)
+{
+    x = v_f32_min_b(v_f32_max_b(x, EXP_MIN_ARG), EXP_MAX_ARG);
+    int64 n = v_convert_f32_to_i32_b(x * LOG2E, e_round_half_ne << 16);
+    float64 fn = v_convert_i32_to_f32_b(n, e_round_half_ne << 16);
+    float64 r = v_f32_mac_b(fn, LN2, x, (e_with_negation) << 1);
+
+    float64 p = 8.357203791e-03f;
+    p = v_f32_mac_b(p, r, 4.183382960e-02f);
+    p = v_f32_mac_b(p, r, 1.666663081e-01f);
+    p = v_f32_mac_b(p, r, 4.999974891e-01f);
+    float64 y = v_f32_mac_b(p, r * r, r) + 1.0f;
+    return scale_pow2_f32(y, n);
+}
+
+float64 exp_precise_f32(float64 x)
+{
+    float64 xc = v_f32_min_b(v_f32_max_b(x, EXP_MIN_ARG), EXP_MAX_ARG);
+    int64 n = v_convert_f32_to_i32_b(xc * LOG2E, e_round_half_ne << 16);
+    float64 fn = v_convert_i32_to_f32_b(n, e_round_half_ne << 16);
+    float64 r = v_f32_mac_b(fn, LN2_HI, xc, (e_with_negation) << 1);
+    r = v_f32_mac_b(fn, LN2_LO, r, (e_with_negation) << 1);
+
+    float64 p = 1.9875691500e-4f;
+    p = v_f32_mac_b(p, r, 1.3981999507e-3f);
+    p = v_f32_mac_b(p, r, 8.3334519073e-3f);
+    p = v_f32_mac_b(p, r, 4.1665795894e-2f);
+    p = v_f32_mac_b(p, r, 1.6666665459e-1f);
+    p = v_f32_mac_b(p, r, 5.0000001201e-1f);
+    float64 y = v_f32_mac_b(p, r * r, r) + 1.0f;
+    y = scale_pow2_f32(y, n);
+
+    y = v_f32_sel_grt_f32_b(x, EXP_MAX_ARG, inf_f32(), y);
+    y = v_f32_sel_less_f32_b(x, EXP_MIN_ARG, 0.0f, y);
+    return keep_nan_f32(x, y);
+}
+
+////////////////////////////////////////// LOG //////////////////////////////////////////////////
+// x = 2^e * (1 + m) with 1 + m in [sqrt(1/2), sqrt(2)),
+// log(1 + m) = m - m^2 / 2 + m^3 * P(m)
+
+float64 log_reduce_f32(float64 x, float64* e)
+{
+    int64 bits = *((int64*)&x);
+    int64 exponent = ((bits >> 23) & 0xff) - 126;
+    int64 mantBits = (bits & 0x007fffff) | 0x3f000000;
+    float64 m = *((float64*)&mantBits);    // [0.5, 1)
+
+    // below sqrt(1/2) take 2m - 1 and e - 1
+    float64 fe = v_convert_i32_to_f32_b(exponent, e_round_half_ne << 16);
+    *e = v_f32_sel_less_f32_b(m, SQRT_HALF, fe - 1.0f, fe);
+    return v_f32_sel_less_f32_b(m, SQRT_HALF, m + m, m) - 1.0f;
+}
+
+float64 log_fast_f32(float64 x)
+{
+    float64 e;
+    float64 m = log_reduce_f32(x, &e);
+    float64 z = m * m;
+
+    float64 p = -1.049052664e-01f;
+    p = v_f32_mac_b(p, m, 1.581938838e-01f);
+    p = v_f32_mac_b(p, m, -1.700165823e-01f);
+    p = v_f32_mac_b(p, m, 1.994744552e-01f);
+    p = v_f32_mac_b(p, m, -2.499183955e-01f);
+    p = v_f32_mac_b(p, m, 3.333362390e-01f);
+    float64 y = p * m * z;
+    y = v_f32_mac_b(z, -0.5f, y);
+    return v_f32_mac_b(e, LN2, m + y);
+}
+
+float64 log_precise_f32(float64 x)
+{
+    float64 e;
+    float64 m = log_reduce_f32(x, &e);
+    float64 z = m * m;
+
+    float64 p = 7.0376836292e-2f;
+    p = v_f32_mac_b(p, m, -1.1514610310e-1f);
+    p = v_f32_mac_b(p, m, 1.1676998740e-1f);
+    p = v_f32_mac_b(p, m, -1.2420140846e-1f);
+    p = v_f32_mac_b(p, m, 1.4249322787e-1f);
+    p = v_f32_mac_b(p, m, -1.6668057665e-1f);
+    p = v_f32_mac_b(p, m, 2.0000714765e-1f);
+    p = v_f32_mac_b(p, m, -2.4999993993e-1f);
+    p = v_f32_mac_b(p, m, 3.3333331174e-1f);
+    float64 y = p * m * z;
+    y = v_f32_mac_b(e, LN2_LO, y);
+    y = v_f32_mac_b(z, -0.5f, y);
+    float64 result = v_f32_mac_b(e, LN2_HI, m + y);
+
+    // x < 0 -> nan, 0 and denormals -> -inf, +inf -> +inf
+    float64 absX = v_f32_abs_b(x);
+    result = v_f32_sel_less_f32_b(x, 0.0f, nan_f32(), result);
+    result = v_f32_sel_less_u32_b(*((uint64*)&absX), 0x00800000, -inf_f32(), result);
+    result = v_f32_sel_eq_u32_b(*((uint64*)&x), 0x7f800000, x, result);
+    return keep_nan_f32(x, result);
+}
+
+////////////////////////////////////////// TANH /////////////////////////////////////////////////
+// |x| < 0.625 : x + x^3 * P(x^2), above : 1 - 2 / (e^2|x| + 1)
+
+float64 tanh_fast_f32(float64 x)
+{
+    float64 absX = v_f32_abs_b(x);
+    float64 z = x * x;
+    float64 p = 1.621225574e-02f;
+    p = v_f32_mac_b(p, z, -5.267516351e-02f);
+    p = v_f32_mac_b(p, z, 1.332349416e-01f);
+    p = v_f32_mac_b(p, z, -3.333321382e-01f);
+    float64 small = v_f32_mac_b(p * z, x, x);
+
+    float64 e = exp_fast_f32(absX + absX);
+    float64 large = v_f32_mac_b(v_reciprocal_f32(e + 1.0f), -2.0f, 1.0f);
+    large = copy_sign_f32(large, x);
+    return v_f32_sel_less_f32_b(absX, 0.625f, small, large);
+}
+
+float64 tanh_precise_f32(float64 x)
+{
+    float64 absX = v_f32_abs_b(x);
+    float64 z = x * x;
+    float64 p = -5.70498872745e-3f;
+    p = v_f32_mac_b(p, z, 2.06390887954e-2f);
+    p = v_f32_mac_b(p, z, -5.37397155531e-2f);
+    p = v_f32_mac_b(p, z, 1.33314422036e-1f);
+    p = v_f32_mac_b(p, z, -3.33332819422e-1f);
+    float64 small = v_f32_mac_b(p * z, x, x);
+
+    float64 e = exp_precise_f32(absX + absX);
+    float64 large = v_f32_mac_b(v_reciprocal_f32(e + 1.0f), -2.0f, 1.0f);
+    large = v_f32_sel_grt_f32_b(absX, 9.0f, 1.0f, large);
+    large = copy_sign_f32(large, x);
+    return keep_nan_f32(x, v_f32_sel_less_f32_b(absX, 0.625f, small, large));
+}
+
+///////////////////////////////////////// SIGMOID ///////////////////////////////////////////////
+
+float64 sigmoid_fast_f32(float64 x)
+{
+    return v_reciprocal_f32(exp_fast_f32(-x) + 1.0f);
+}
+
+float64 sigmoid_precise_f32(float64 x)
+{
+    // exp overflows to inf for very negative x, 1 / inf gives the 0 limit
+    return v_reciprocal_f32(exp_precise_f32(-x) + 1.0f);
+}
+
+////////////////////////////////////////// RSQRT ////////////////////////////////////////////////
+// bit level estimate refined by Newton steps y = y * (1.5 - x/2 * y^2)
+
+float64 rsqrt_fast_f32(float64 x)
+{
+    int64 bits = RSQRT_MAGIC - (*((int64*)&x) >> 1);
+    float64 y = *((float64*)&bits);
+    float64 halfX = x * 0.5f;
+    y = y * v_f32_mac_b(halfX, y * y, 1.5f, (e_with_negation) << 1);
+    y = y * v_f32_mac_b(halfX, y * y, 1.5f, (e_with_negation) << 1);
+    y = y * v_f32_mac_b(halfX, y * y, 1.5f, (e_with_negation) << 1);
+    return y;
+}
+
+float64 rsqrt_precise_f32(float64 x)
+{
+    float64 y = rsqrt_fast_f32(x);
+    // last step on the residual, y += y * (0.5 - x/2 * y^2)
+    float64 residual = v_f32_mac_b(x * 0.5f, y * y, 0.5f, (e_with_negation) << 1);
+    y = v_f32_mac_b(y, residual, y);
+
+    // x < 0 -> nan, 0 and denormals -> +inf, +inf -> 0
+    float64 absX = v_f32_abs_b(x);
+    y = v_f32_sel_less_f32_b(x, 0.0f, nan_f32(), y);
+    y = v_f32_sel_less_u32_b(*((uint64*)&absX), 0x00800000, inf_f32(), y);
+    y = v_f32_sel_eq_u32_b(*((uint64*)&x), 0x7f800000, 0.0f, y);
+    return keep_nan_f32(x, y);
+}
+
+/////////////////////////////////////////// ERF /////////////////////////////////////////////////
+
+float64 erf_fast_f32(float64 x)
+{
+    float64 absX = v_f32_abs_b(x);
+    float64 z = x * x;
+    float64 p = -5.648059866e-04f;
+    p = v_f32_mac_b(p, z, 4.921762028e-03f);
+    p = v_f32_mac_b(p, z, -2.671505423e-02f);
+    p = v_f32_mac_b(p, z, 1.128031665e-01f);
+    p = v_f32_mac_b(p, z, -3.761234378e-01f);
+    p = v_f32_mac_b(p, z, 1.128379126e+00f);
+    float64 small = p * x;
+
+    float64 t = (absX - 2.5f) * (2.0f / 3.0f);
+    float64 q = 5.847788317e-04f;
+    q = v_f32_mac_b(q, t, -1.465636562e-03f);
+    q = v_f32_mac_b(q, t, 2.262986559e-03f);
+    q = v_f32_mac_b(q, t, -5.201496484e-03f);
+    q = v_f32_mac_b(q, t, 1.252954742e-02f);
+    q = v_f32_mac_b(q, t, -2.711087573e-02f);
+    q = v_f32_mac_b(q, t, 5.610744949e-02f);
+    q = v_f32_mac_b(q, t, -1.115130168e-01f);
+    q = v_f32_mac_b(q, t, 2.108063641e-01f);
+    float64 large = v_f32_mac_b(q, exp_fast_f32(-z), 1.0f, (e_with_negation) << 1);
+    large = v_f32_sel_grt_f32_b(absX, ERF_ONE, 1.0f, large);
+    large = copy_sign_f32(large, x);
+    return v_f32_sel_less_f32_b(absX, ERF_SPLIT, small, large);
+}
+
+float64 erf_precise_f32(float64 x)
+{
+    float64 absX = v_f32_abs_b(x);
+    float64 z = x * x;
+    float64 p = 7.875875063e-05f;
+    p = v_f32_mac_b(p, z, -8.016864287e-04f);
+    p = v_f32_mac_b(p, z, 5.189087423e-03f);
+    p = v_f32_mac_b(p, z, -2.685421201e-02f);
+    p = v_f32_mac_b(p, z, 1.128359472e-01f);
+    p = v_f32_mac_b(p, z, -3.761262667e-01f);
+    p = v_f32_mac_b(p, z, 1.128379166e+00f);
+    float64 small = p * x;
+
+    float64 t = (absX - 2.5f) * (2.0f / 3.0f);
+    float64 q = 9.294974299e-05f;
+    q = v_f32_mac_b(q, t, -2.451864515e-04f);
+    q = v_f32_mac_b(q, t, 3.764772747e-04f);
+    q = v_f32_mac_b(q, t, -9.162726026e-04f);
+    q = v_f32_mac_b(q, t, 2.418384229e-03f);
+    q = v_f32_mac_b(q, t, -5.611233637e-03f);
+    q = v_f32_mac_b(q, t, 1.248669964e-02f);
+    q = v_f32_mac_b(q, t, -2.699793742e-02f);
+    q = v_f32_mac_b(q, t, 5.611062799e-02f);
+    q = v_f32_mac_b(q, t, -1.115213905e-01f);
+    q = v_f32_mac_b(q, t, 2.108063641e-01f);
+    float64 large = v_f32_mac_b(q, exp_precise_f32(-z), 1.0f, (e_with_negation) << 1);
+    large = v_f32_sel_grt_f32_b(absX, ERF_ONE, 1.0f, large);
+    large = copy_sign_f32(large, x);
+    return keep_nan_f32(x, v_f32_sel_less_f32_b(absX, ERF_SPLIT, small, large));
+}
+
+///////////////////////////////////////// SIN / COS /////////////////////////////////////////////
+// |x| = k * pi/4 + r with k even and |r| <= pi/4, quadrant k/2. Accurate up
+// to |x| = 8192 like sin_f32.
+
+void sin_cos_precise_f32(float64 x, float64* sinX, float64* cosX)
+{
+    float64 absX = v_f32_abs_b(x);
+    int64 k = v_convert_f32_to_i32_b(absX * FOUR_BY_PI, e_round_down << 16);
+    k += k & 1;
+    float64 fk = v_convert_i32_to_f32_b(k, e_round_half_ne << 16);
+    float64 r = v_f32_mac_b(fk, PI4_1, absX, (e_with_negation) << 1);
+    r = v_f32_mac_b(fk, PI4_2, r, (e_with_negation) << 1);
+    r = v_f32_mac_b(fk, PI4_3, r, (e_with_negation) << 1);
+    float64 z = r * r;
+
+    float64 ps = -1.9515295891e-4f;
+    ps = v_f32_mac_b(ps, z, 8.3321608736e-3f);
+    ps = v_f32_mac_b(ps, z, -1.6666654611e-1f);
+    float64 sinR = v_f32_mac_b(ps * z, r, r);
+
+    float64 pc = 2.443315711809948e-5f;
+    pc = v_f32_mac_b(pc, z, -1.388731625493765e-3f);
+    pc = v_f32_mac_b(pc, z, 4.166664568298827e-2f);
+    float64 cosR = v_f32_mac_b(pc * z, z, v_f32_mac_b(z, -0.5f, 1.0f));
+
+    // odd quadrants swap sin and cos, sin flips in quadrants 2 and 3,
+    // cos in quadrants 1 and 2
+    int64 quadrant = (k >> 1) & 3;
+    float64 s = v_f32_sel_eq_i32_b(quadrant & 1, 1, cosR, sinR);
+    float64 c = v_f32_sel_eq_i32_b(quadrant & 1, 1, sinR, cosR);
+    s = v_f32_sel_eq_i32_b(quadrant & 2, 2, -s, s);
+    c = v_f32_sel_eq_i32_b((quadrant + 1) & 2, 2, -c, c);
+    s = copy_sign_f32(s, x);
+
+    // +-inf and nan give nan
+    s = v_f32_sel_geq_u32_b(*((uint64*)&absX), 0x7f800000, nan_f32(), s);
+    c = v_f32_sel_geq_u32_b(*((uint64*)&absX), 0x7f800000, nan_f32(), c);
+    *sinX = s;
+    *cosX = c;
+}
+
+float64 cos_precise_f32(float64 x)
+{
+    float64 s, c;
+    sin_cos_precise_f32(x, &s, &c);
+    return c;
+}
+
+#if defined(TR_PRECISE)
+#define TR_TIER(f)              f##_precise_f32
+#else
+#define TR_TIER(f)              f##_fast_f32
+#endif
+
+#if defined(TR_COS)
+#define tr_func(x)              TR_TIER(cos)(x)
+#elif defined(TR_EXP)
+#define tr_func(x)              TR_TIER(exp)(x)
+#elif defined(TR_LOG)
+#define tr_func(x)              TR_TIER(log)(x)
+#elif defined(TR_TANH)
+#define tr_func(x)              TR_TIER(tanh)(x)
+#elif defined(TR_SIGMOID)
+#define tr_func(x)              TR_TIER(sigmoid)(x)
+#elif defined(TR_RSQRT)
+#define tr_func(x)              TR_TIER(rsqrt)(x)
+#elif defined(TR_ERF)
+#define tr_func(x)              TR_TIER(erf)(x)
+#endif
+
+void main(tensor ifm,
+          tensor ofm
+#if defined(TR_SINCOS)
+          , tensor ofm2
+#endif
+          )
+{
+    const int depth    = 0;
+    const int width    = 1;
+    const int height   = 2;
+    const int batch    = 3;
+    const int fifthDim = 4;
+
+    const int5 indexSpaceStart = get_index_space_offset();
+    const int5 indexSpaceEnd = get_index_space_size() + indexSpaceStart;
+
+    int5 coords = {0, 0, 0, 0, 0};
+
+    // DEPTH
+    const int depthStep  = VECTOR_SIZE;
+    const int depthStart = indexSpaceStart[depth] * depthStep;
+    const int depthEnd   = indexSpaceEnd[depth] * depthStep;
+
+    // WIDTH
+    const int widthStep  = NUM_UNROLL;
+    const int widthStart = indexSpaceStart[width] * widthStep;
+    const int widthEnd   = indexSpaceEnd[width] * widthStep;
+
+    // HEIGHT
+    const int heightStep  = 1;
+    const int heightStart = indexSpaceStart[height];
+    const int heightEnd   = indexSpaceEnd[height];
+
+    // BATCH
+    const int batchStep  = 1;
+    const int batchStart = indexSpaceStart[batch];
+    const int batchEnd   = indexSpaceEnd[batch];
+
+    // FIFTH DIM
+    const int fifthDimStep  = 1;
+    const int fifthDimStart = indexSpaceStart[fifthDim];
+    const int fifthDimEnd   = indexSpaceEnd[fifthDim];
+
+    for (int f = fifthDimStart; f < fifthDimEnd; f += fifthDimStep)
+    {
+        coords[fifthDim] = f;
+        for (int b = batchStart; b < batchEnd; b += batchStep)
+        {
+            coords[batch] = b;
+            for (int h = heightStart; h < heightEnd; h += heightStep)
+            {
+                coords[height] = h;
+                for (int d = depthStart; d < depthEnd; d += depthStep)
+                {
+                    coords[depth] = d;
+                    #pragma loop_unroll(NUM_UNROLL)
+                    for (int w = widthStart; w < widthEnd; w += 1)
+                    {
+                        coords[width] = w;
+                        float64 x = v_f32_ld_tnsr_b(coords, ifm);
+#if defined(TR_SINCOS)
+                        float64 s, c;
+#if defined(TR_PRECISE)
+                        sin_cos_precise_f32(x, &s, &c);
+#else
+                        s = sin_fast_f32(x);
+                        c = cos_fast_f32(x);
+#endif
+                        v_f32_st_tnsr(coords, ofm, s);
+                        v_f32_st_tnsr(coords, ofm2, c);
+#else
+                        v_f32_st_tnsr(coords, ofm, tr_func(x));
+#endif
+                    }
+                }
+            }
+        }
+    }
+}
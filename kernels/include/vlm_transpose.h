@@ -0,0 +1,148 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+// Transpose of a VECTOR_SIZE x VECTOR_SIZE tile held in VLM, rows
+// tile[base] .. tile[base + VECTOR_SIZE - 1] of a __local__ VECTOR array.
+// Include after kernel_config.h with FLOAT32, BFLOAT16, INT32 or INT8 defined.
+//   1. every DG_SIZE x DG_SIZE block on the diagonal of a dual group is
+//      transposed in place with a log2(DG_SIZE) step butterfly of SHUFFLE
+//   2. transposed row C * DG_SIZE + x gathers dual group C of rows
+//      R * DG_SIZE + x into its dual group R with MOV_DUAL_GROUP
+//
+// transpose_init_ctl() fills the butterfly controls once per kernel.
+
+#ifndef VLM_TRANSPOSE_H
+#define VLM_TRANSPOSE_H
+
+#if defined(FLOAT32)
+#define LANE_VECTOR                     uint64
+#define LANE_ID                         read_lane_id_4b_b()
+#define DG_LOG2                         4
+#define v_shuffle_b(a, ctl, income)     v_f32_shuffle_b(a, ctl, 0, income)
+#define v_mov_dual_group_b(a, s, d, income) \
+                v_f32_mov_dual_group_b(a, 0xFFFFFFFF, s, d, MkWr(1, 1), income)
+#endif
+
+#if defined(INT32)
+#define LANE_VECTOR                     uint64
+#define LANE_ID                         read_lane_id_4b_b()
+#define DG_LOG2                         4
+#define v_shuffle_b(a, ctl, income)     v_i32_shuffle_b(a, ctl, 0, income)
+#define v_mov_dual_group_b(a, s, d, income) \
+                v_i32_mov_dual_group_b(a, 0xFFFFFFFF, s, d, MkWr(1, 1), income)
+#endif
+
+#if defined(BFLOAT16)
+#define LANE_VECTOR                     ushort128
+#define LANE_ID                         V_LANE_ID_16
+#define DG_LOG2                         5
+#define v_shuffle_b(a, ctl, income)     v_bf16_shuffle_b(a, ctl, 0, income)
+#define v_mov_dual_group_b(a, s, d, income) \
+                v_bf16_mov_dual_group_b(a, 0xFFFFFFFF, s, d, MkWr(1, 1), income)
+#endif
+
+#if defined(INT8)
+#define LANE_VECTOR                     uchar256
+#define LANE_ID                         read_lane_id_1b_b()
+#define DG_LOG2                         6
+#define v_shuffle_b(a, ctl, income)     v_i8_shuffle_b(a, ctl, 0, income)
+#define v_mov_dual_group_b(a, s, d, income) \
+                v_i8_mov_dual_group_b(a, 0xFFFFFFFF, s, d, MkWr(1, 1), income)
+#endif
+
+// 4 dual groups of 2 groups per vector
+#define DG_SIZE                         (1 << DG_LOG2)
+#define GROUP_LOG2                      (DG_LOG2 - 1)
+#define GROUP_SIZE                      (1 << GROUP_LOG2)
+
+// butterfly controls
+__local__ uchar256 vlmCtlDown[DG_LOG2];
+__local__ uchar256 vlmCtlUp[DG_LOG2];
+
+// SHUFFLE control: the low byte of every element holds the source element
+// within its group (bits 0-4), the source group within the dual group
+// (bit 5) and the write enable (bit 7). Lanes with enable == 0 keep the
+// income.
+LANE_VECTOR shuffle_ctl(LANE_VECTOR src, LANE_VECTOR enable)
+{
+    LANE_VECTOR ctl = (src & (GROUP_SIZE - 1)) | (((src >> GROUP_LOG2) & 1) << 5) | 0x80;
+    return ctl & (0 - enable);
+}
+
+// Butterfly controls, lane l of a dual group at stage s:
+//   down : l & s, takes l - s from the upper row of the pair
+//   up   : !(l & s), takes l + s from the lower row of the pair
+void transpose_init_ctl()
+{
+    const LANE_VECTOR dgLane = LANE_ID & (DG_SIZE - 1);
+    for (int stage = 0; stage < DG_LOG2; stage++)
+    {
+        const int s = 1 << stage;
+        LANE_VECTOR upper = (dgLane >> stage) & 1;
+        LANE_VECTOR down = shuffle_ctl(dgLane - s, upper);
+        LANE_VECTOR up = shuffle_ctl(dgLane + s, upper ^ 1);
+        vlmCtlDown[stage] = *((uchar256*)&down);
+        vlmCtlUp[stage] = *((uchar256*)&up);
+    }
+}
+
+// 1. transpose the diagonal blocks of every dual group of tile in place
+#define TRANSPOSE_DIAGONAL(tile, base)                                          \
+    for (int stage = 0; stage < DG_LOG2; stage++)                               \
+    {                                                                           \
+        const int s = 1 << stage;                                               \
+        const uchar256 ctlDown = vlmCtlDown[stage];                             \
+        const uchar256 ctlUp = vlmCtlUp[stage];                                 \
+        _Pragma("unroll(2)")                                                    \
+        for (int r = 0; r < VECTOR_SIZE; r++)                                   \
+        {                                                                       \
+            /* pairs (r, r + s) with bit s of r clear */                        \
+            if ((r & s) == 0)                                                   \
+            {                                                                   \
+                VECTOR lower = tile[base + r];                                  \
+                VECTOR upper = tile[base + r + s];                              \
+                tile[base + r] = v_shuffle_b(upper, ctlDown, lower);            \
+                tile[base + r + s] = v_shuffle_b(lower, ctlUp, upper);          \
+            }                                                                   \
+        }                                                                       \
+    }
+
+// 2. rows x, DG_SIZE + x, 2 * DG_SIZE + x and 3 * DG_SIZE + x of the
+// transpose of a tile that went through TRANSPOSE_DIAGONAL
+#define TRANSPOSE_GATHER(tile, base, x, y0, y1, y2, y3)                         \
+    {                                                                           \
+        y0 = tile[base + 0 * DG_SIZE + x];                                      \
+        y0 = v_mov_dual_group_b(tile[base + 1 * DG_SIZE + x], 0, 1, y0);        \
+        y0 = v_mov_dual_group_b(tile[base + 2 * DG_SIZE + x], 0, 2, y0);        \
+        y0 = v_mov_dual_group_b(tile[base + 3 * DG_SIZE + x], 0, 3, y0);        \
+                                                                                \
+        y1 = tile[base + 1 * DG_SIZE + x];                                      \
+        y1 = v_mov_dual_group_b(tile[base + 0 * DG_SIZE + x], 1, 0, y1);        \
+        y1 = v_mov_dual_group_b(tile[base + 2 * DG_SIZE + x], 1, 2, y1);        \
+        y1 = v_mov_dual_group_b(tile[base + 3 * DG_SIZE + x], 1, 3, y1);        \
+                                                                                \
+        y2 = tile[base + 2 * DG_SIZE + x];                                      \
+        y2 = v_mov_dual_group_b(tile[base + 0 * DG_SIZE + x], 2, 0, y2);        \
+        y2 = v_mov_dual_group_b(tile[base + 1 * DG_SIZE + x], 2, 1, y2);        \
+        y2 = v_mov_dual_group_b(tile[base + 3 * DG_SIZE + x], 2, 3, y2);        \
+                                                                                \
+        y3 = tile[base + 3 * DG_SIZE + x];                                      \
+        y3 = v_mov_dual_group_b(tile[base + 0 * DG_SIZE + x], 3, 0, y3);        \
+        y3 = v_mov_dual_group_b(tile[base + 1 * DG_SIZE + x], 3, 1, y3);        \
+        y3 = v_mov_dual_group_b(tile[base + 2 * DG_SIZE + x], 3, 2, y3);        \
+    }
+
+#endif // VLM_TRANSPOSE_H
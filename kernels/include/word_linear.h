@@ -0,0 +1,57 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+// 16 bit <-> f32 conversions that keep the element order, the 16 bit
+// counterpart of byte_linear.h. The including header selects the type with
+//   WORD_VECTOR, v_word_unpack_b, v_word_mov_dual_group_b, v_word_st_tnsr,
+//   v_convert_word_to_f32(x)    : low half of every 32 bit lane -> float64
+//   v_convert_f32_to_word(x)    : float128 -> WORD_VECTOR, packed by the store
+//
+// The "all" conversions work in the ACC_VECTOR lane order, which is fine as
+// long as every operand went through the same conversion, but does not line
+// up with f32 tensor loads.
+
+// Returns elements 0..63 of in in v1 and 64..127 in v2, as cast_bf16_to_f32.c.
+float128 word_to_f32_linear(WORD_VECTOR in)
+{
+    WORD_VECTOR y1, y2, tmp;
+
+    // 0..15, 32..47, 64..79, 96..111
+    y1 = v_word_unpack_b(in, ((e_group_0) << 8) | ((e_every_second_element) << 9) | ((e_lower_half_group) << 10), (WORD_VECTOR)0);
+    // 16..31, 48..63, 80..95, 112..127
+    y2 = v_word_unpack_b(in, ((e_group_1) << 8) | ((e_every_second_element) << 9) | ((e_lower_half_group) << 10), (WORD_VECTOR)0);
+
+    // 0..15, 16..31, 32..47, 48..63
+    tmp = y1;
+    y1 = v_word_mov_dual_group_b(y2, 0xFFFFFFFF, 0, 1, MkWr(1, 1), y1);
+    y1 = v_word_mov_dual_group_b(tmp, 0xFFFFFFFF, 1, 2, MkWr(1, 1), y1);
+    y1 = v_word_mov_dual_group_b(y2, 0xFFFFFFFF, 1, 3, MkWr(1, 1), y1);
+
+    // 64..79, 80..95, 96..111, 112..127
+    y2 = v_word_mov_dual_group_b(tmp, 0xFFFFFFFF, 2, 0, MkWr(1, 1), y2);
+    y2 = v_word_mov_dual_group_b(y2, 0xFFFFFFFF, 2, 1, MkWr(1, 1), y2);
+    y2 = v_word_mov_dual_group_b(tmp, 0xFFFFFFFF, 3, 2, MkWr(1, 1), y2);
+
+    float128 out;
+    out.v1 = v_convert_word_to_f32(y1);
+    out.v2 = v_convert_word_to_f32(y2);
+    return out;
+}
+
+// Stores elements 0..63 from x.v1 and 64..127 from x.v2, as cast_f32_to_bf16.c.
+// For integer types x must already be within the range of the type.
+#define st_tnsr_word_linear(coords, t, x) \
+                v_word_st_tnsr(coords, t, v_convert_f32_to_word(x), SW_PACK)
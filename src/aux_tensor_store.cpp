@@ -0,0 +1,165 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "aux_tensor_store.hpp"
+
+namespace
+{
+struct Payload
+{
+    std::vector<uint8_t> bytes;
+    double generationUs;
+};
+
+struct Store
+{
+    std::mutex mutex;
+    // recipe (kind, key, size) -> payload
+    std::unordered_map<std::string, std::shared_ptr<Payload> > recipes;
+    // content hash -> payloads with that hash
+    std::unordered_multimap<uint64_t, std::shared_ptr<Payload> > contents;
+    AuxTensorStore::Stats stats;
+};
+
+Store& store()
+{
+    static Store s;
+    return s;
+}
+
+// FNV-1a
+uint64_t contentHash(const std::vector<uint8_t>& bytes)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (uint8_t b : bytes)
+    {
+        hash = (hash ^ b) * 0x100000001b3ull;
+    }
+    return hash;
+}
+
+std::string recipeKey(const char* kind, const void* key, unsigned keySize, unsigned size)
+{
+    std::string recipe(kind);
+    recipe.push_back('\0');
+    recipe.append(static_cast<const char*>(key), keySize);
+    recipe.append(reinterpret_cast<const char*>(&size), sizeof(size));
+    return recipe;
+}
+}
+
+void AuxTensorStore::Fill(const char* kind, const void* key, unsigned keySize,
+                          void* data, unsigned size, const Generator& generate)
+{
+    Store& s = store();
+    const std::string recipe = recipeKey(kind, key, keySize, size);
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        auto found = s.recipes.find(recipe);
+        if (found != s.recipes.end())
+        {
+            memcpy(data, found->second->bytes.data(), size);
+            s.stats.hits++;
+            s.stats.bytesNotRegenerated += size;
+            s.stats.generationUsAvoided += found->second->generationUs;
+            return;
+        }
+    }
+
+    // generate outside the lock, a racing fill of the same recipe only costs
+    // one extra generation
+    std::shared_ptr<Payload> payload = std::make_shared<Payload>();
+    payload->bytes.resize(size);
+    const auto start = std::chrono::steady_clock::now();
+    generate(payload->bytes.data(), size);
+    payload->generationUs = std::chrono::duration<double, std::micro>(
+            std::chrono::steady_clock::now() - start).count();
+    memcpy(data, payload->bytes.data(), size);
+
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.stats.misses++;
+    s.stats.generationUs += payload->generationUs;
+    if (s.recipes.count(recipe) != 0 || s.stats.bytesStored + size > c_maxStoreBytes)
+    {
+        return;
+    }
+
+    // share the bytes with an identical payload of another recipe
+    const uint64_t hash = contentHash(payload->bytes);
+    auto range = s.contents.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (it->second->bytes == payload->bytes)
+        {
+            s.recipes[recipe] = it->second;
+            s.stats.bytesDeduplicated += size;
+            return;
+        }
+    }
+    s.contents.insert(std::make_pair(hash, payload));
+    s.recipes[recipe] = payload;
+    s.stats.bytesStored += size;
+}
+
+tpc_lib_api::GlueCodeReturn AuxTensorStore::FillF32Aux(
+        tpc_lib_api::HabanaKernelInstantiation* out_defs,
+        const char* kind, const void* key, unsigned keySize,
+        unsigned count, const Generator& generate)
+{
+    out_defs->auxiliaryTensorNr = 1;
+    out_defs->auxiliaryTensors[0].geometry.dims = 1;
+    out_defs->auxiliaryTensors[0].geometry.maxSizes[0] = count;
+    out_defs->auxiliaryTensors[0].geometry.maxSizes[1] = 0;
+    out_defs->auxiliaryTensors[0].geometry.maxSizes[2] = 0;
+    out_defs->auxiliaryTensors[0].geometry.maxSizes[3] = 0;
+    out_defs->auxiliaryTensors[0].geometry.maxSizes[4] = 0;
+    out_defs->auxiliaryTensors[0].geometry.dataType = tpc_lib_api::DATA_F32;
+
+    unsigned required_size = count * sizeof(float);
+    // Check whether required memory is allocated for auxiliary tensor
+    if (required_size > out_defs->auxiliaryTensors[0].bufferSize ||
+        out_defs->auxiliaryTensors[0].pData == nullptr)
+    {
+        out_defs->auxiliaryTensors[0].bufferSize = required_size;
+        return tpc_lib_api::GLUE_INSUFFICIENT_AUX_BUFFER_SIZE;
+    }
+
+    Fill(kind, key, keySize, out_defs->auxiliaryTensors[0].pData, required_size, generate);
+    return tpc_lib_api::GLUE_SUCCESS;
+}
+
+AuxTensorStore::Stats AuxTensorStore::GetStats()
+{
+    Store& s = store();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.stats;
+}
+
+void AuxTensorStore::Clear()
+{
+    Store& s = store();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.recipes.clear();
+    s.contents.clear();
+    s.stats = Stats();
+}
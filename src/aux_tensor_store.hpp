@@ -0,0 +1,65 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef _AUX_TENSOR_STORE_HPP
+#define _AUX_TENSOR_STORE_HPP
+
+#include <cstdint>
+#include <functional>
+#include "gc_interface.h"
+#include "tpc_kernel_lib_interface.h"
+
+// Library wide store of constant aux tensor payloads (LUTs, reciprocal
+// tables). A payload is generated once per recipe, the kind of table plus the
+// key bytes it depends on, and copied into the aux tensor of every later node
+// with the same recipe. Payloads are also interned by content hash, so two
+// recipes that produce the same bytes share one copy in the store. Every node
+// still gets its own copy in its aux tensor, a hit only saves the generation.
+class AuxTensorStore
+{
+public:
+    typedef std::function<void(void* data, unsigned size)> Generator;
+
+    struct Stats
+    {
+        uint64_t hits;                  // fills served without generating
+        uint64_t misses;                // fills that ran the generator
+        uint64_t bytesStored;           // distinct payload bytes held
+        uint64_t bytesNotRegenerated;   // payload bytes of the hits, still copied
+        uint64_t bytesDeduplicated;     // store bytes shared by identical payloads
+        double   generationUs;          // time spent in generators
+        double   generationUsAvoided;   // generator time of the hits
+    };
+
+    // Copy the payload of (kind, key) into data, running generate on first
+    // use. Payloads past c_maxStoreBytes are generated in place.
+    static void Fill(const char* kind, const void* key, unsigned keySize,
+                     void* data, unsigned size, const Generator& generate);
+
+    // Fill the single f32 aux tensor of out_defs with count elements, sized
+    // and checked like the glue code does by hand.
+    static tpc_lib_api::GlueCodeReturn FillF32Aux(
+            tpc_lib_api::HabanaKernelInstantiation* out_defs,
+            const char* kind, const void* key, unsigned keySize,
+            unsigned count, const Generator& generate);
+
+    static Stats GetStats();
+    static void Clear();
+
+    static const uint64_t c_maxStoreBytes = 64ull << 20;
+};
+
+#endif //_AUX_TENSOR_STORE_HPP
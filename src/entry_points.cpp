@@ -34,14 +34,50 @@ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVE
 #include "cast_f16_to_i16_gaudi2.hpp"
 #include "searchsorted_f32.hpp"
 #include "kl_div_all.hpp"
+#include "binary_broadcast.hpp"
+#include "cast_all_gaudi.hpp"
 #include "add_f32_gaudi2.hpp"
 #include "relu_all_gaudi2.hpp"
 #include "user_lut_gaudi2.hpp"
+#include "layer_norm_all_gaudi2.hpp"
+#include "activation_all_gaudi2.hpp"
+#include "rope_gaudi2.hpp"
+#include "topk_gaudi2.hpp"
+#include "scan_gaudi2.hpp"
+#include "cross_entropy_gaudi2.hpp"
+#include "softmax_bwd_bf16_gaudi2.hpp"
+#include "softmax_masked_gaudi2.hpp"
+#include "adamw_gaudi2.hpp"
+#include "grad_norm_gaudi2.hpp"
+#include "fp8_cast_gaudi2.hpp"
+#include "quantize_i8_gaudi2.hpp"
+#include "cast_all_gaudi2.hpp"
+#include "permute_gaudi2.hpp"
+#include "binary_broadcast_gaudi2.hpp"
+#include "fused_elementwise_gaudi2.hpp"
+#include "reduction_gaudi2.hpp"
+#include "transcendental_gaudi2.hpp"
+#include "dropout_gaudi2.hpp"
+#include "piecewise_poly_gaudi2.hpp"
+#include "fused_attention_gaudi2.hpp"
+#include "paged_kv_cache_gaudi2.hpp"
 #include "mamba_pscan_gaudi3.hpp"
 #include "mamba_pscan_update_gaudi3.hpp"
+#include "activation_all_gaudi3.hpp"
+#include "fp8_cast_gaudi3.hpp"
+#include "binary_broadcast_gaudi3.hpp"
+#include "cast_all_gaudi3.hpp"
 
 #include "entry_points.hpp"
 #include <stdio.h>
+
+static_assert(GAUDI_KERNEL_CAST_ALL_LAST - GAUDI_KERNEL_CAST_ALL_FIRST + 1 == CastAllGaudi::c_pairCount,
+              "GAUDI_KERNEL_CAST_ALL_* must cover every CastAllGaudi pair");
+static_assert(GAUDI2_KERNEL_CAST_ALL_LAST - GAUDI2_KERNEL_CAST_ALL_FIRST + 1 == CastAllGaudi2::c_pairCount,
+              "GAUDI2_KERNEL_CAST_ALL_* must cover every CastAllGaudi2 pair");
+static_assert(GAUDI3_KERNEL_CAST_ALL_LAST - GAUDI3_KERNEL_CAST_ALL_FIRST + 1 == CastAllGaudi2::c_pairCount,
+              "GAUDI3_KERNEL_CAST_ALL_* must cover every CastAllGaudi2 pair");
+
 extern "C"
 {
 
@@ -59,6 +95,8 @@ tpc_lib_api::GlueCodeReturn GetKernelGuids( _IN_    tpc_lib_api::DeviceId
            castInstance.GetKernelName(guids[GAUDI_KERNEL_CAST_BF16_F32].name, CastGaudi::bf16_to_f32);
            CastGaudi castInstance2(CastGaudi::f32_to_bf16);
            castInstance2.GetKernelName(guids[GAUDI_KERNEL_CAST_F32_BF16].name, CastGaudi::f32_to_bf16);
+           CastGaudi castInstance3(CastGaudi::f32_to_bf16_sr);
+           castInstance3.GetKernelName(guids[GAUDI_KERNEL_CAST_F32_BF16_SR].name, CastGaudi::f32_to_bf16_sr);
            FilterFwd2dBF16 filterInstance;
            filterInstance.GetKernelName(guids[GAUDI_KERNEL_FILTER_FWD_2D_BF16].name);
            LeakyReluF32Gaudi leakyReluInstance;
@@ -108,6 +146,27 @@ tpc_lib_api::GlueCodeReturn GetKernelGuids( _IN_    tpc_lib_api::DeviceId
            KLDivFwdF32Instance.GetKernelName(guids[GAUDI_KERNEL_KL_DIV_FWD_F32].name);
            KLDivAll KLDivBwdF32Instance(KLDivAll::bwd_f32);
            KLDivBwdF32Instance.GetKernelName(guids[GAUDI_KERNEL_KL_DIV_BWD_F32].name);
+           // broadcasting binary ops follow the BinaryBroadcast mode order
+           for (int mode = 0; mode < BinaryBroadcast::binary_broadcast_mode_count; mode++)
+           {
+               BinaryBroadcast binaryBroadcastInstance((BinaryBroadcast::BinaryBroadcast_mode_t)mode);
+               binaryBroadcastInstance.GetKernelName(guids[GAUDI_KERNEL_BINARY_BROADCAST_F32 + mode].name,
+                                                     (BinaryBroadcast::BinaryBroadcast_mode_t)mode);
+           }
+           // masked relu / relu6 follow the Relu6All mode order
+           for (int mode = Relu6All::relu6_fwd_mask_f32; mode <= Relu6All::relu_bwd_mask_bf16; mode++)
+           {
+               Relu6All reluMaskInstance((Relu6All::Relu6_mode_t)mode);
+               reluMaskInstance.GetKernelName(guids[GAUDI_KERNEL_RELU6_FWD_MASK_F32 + mode - Relu6All::relu6_fwd_mask_f32].name,
+                                              (Relu6All::Relu6_mode_t)mode);
+           }
+           // any-to-any casts follow the CastAllGaudi pair order
+           for (int pair = 0; pair < CastAllGaudi::c_pairCount; pair++)
+           {
+               CastAllGaudi castAllInstance(CastAllGaudi::GetPairSrc(pair), CastAllGaudi::GetPairDst(pair));
+               castAllInstance.GetKernelName(guids[GAUDI_KERNEL_CAST_ALL_FIRST + pair].name,
+                                             CastAllGaudi::GetPairSrc(pair), CastAllGaudi::GetPairDst(pair));
+           }
         }
 
         if (kernelCount != nullptr)
@@ -143,6 +202,188 @@ tpc_lib_api::GlueCodeReturn GetKernelGuids( _IN_    tpc_lib_api::DeviceId
            ReluBwdBF16g2Instance.GetKernelName(guids[GAUDI2_KERNEL_RELU_BWD_BF16].name, ReluAllGaudi2::relu_bwd_bf16);
            UserLutGaudi2 userLutInstance;
            userLutInstance.GetKernelName(guids[GAUDI2_KERNEL_USER_LUT].name);
+           LayerNormAllGaudi2 LayerNormFwdF32g2Instance(LayerNormAllGaudi2::layer_norm_fwd_f32);
+           LayerNormFwdF32g2Instance.GetKernelName(guids[GAUDI2_KERNEL_LAYER_NORM_FWD_F32].name, LayerNormAllGaudi2::layer_norm_fwd_f32);
+           LayerNormAllGaudi2 LayerNormFwdBF16g2Instance(LayerNormAllGaudi2::layer_norm_fwd_bf16);
+           LayerNormFwdBF16g2Instance.GetKernelName(guids[GAUDI2_KERNEL_LAYER_NORM_FWD_BF16].name, LayerNormAllGaudi2::layer_norm_fwd_bf16);
+           LayerNormAllGaudi2 LayerNormResidualFwdF32g2Instance(LayerNormAllGaudi2::layer_norm_residual_fwd_f32);
+           LayerNormResidualFwdF32g2Instance.GetKernelName(guids[GAUDI2_KERNEL_LAYER_NORM_RESIDUAL_FWD_F32].name, LayerNormAllGaudi2::layer_norm_residual_fwd_f32);
+           LayerNormAllGaudi2 LayerNormResidualFwdBF16g2Instance(LayerNormAllGaudi2::layer_norm_residual_fwd_bf16);
+           LayerNormResidualFwdBF16g2Instance.GetKernelName(guids[GAUDI2_KERNEL_LAYER_NORM_RESIDUAL_FWD_BF16].name, LayerNormAllGaudi2::layer_norm_residual_fwd_bf16);
+           LayerNormAllGaudi2 LayerNormBwdF32g2Instance(LayerNormAllGaudi2::layer_norm_bwd_f32);
+           LayerNormBwdF32g2Instance.GetKernelName(guids[GAUDI2_KERNEL_LAYER_NORM_BWD_F32].name, LayerNormAllGaudi2::layer_norm_bwd_f32);
+           LayerNormAllGaudi2 LayerNormBwdBF16g2Instance(LayerNormAllGaudi2::layer_norm_bwd_bf16);
+           LayerNormBwdBF16g2Instance.GetKernelName(guids[GAUDI2_KERNEL_LAYER_NORM_BWD_BF16].name, LayerNormAllGaudi2::layer_norm_bwd_bf16);
+           LayerNormAllGaudi2 RmsNormFwdF32g2Instance(LayerNormAllGaudi2::rms_norm_fwd_f32);
+           RmsNormFwdF32g2Instance.GetKernelName(guids[GAUDI2_KERNEL_RMS_NORM_FWD_F32].name, LayerNormAllGaudi2::rms_norm_fwd_f32);
+           LayerNormAllGaudi2 RmsNormFwdBF16g2Instance(LayerNormAllGaudi2::rms_norm_fwd_bf16);
+           RmsNormFwdBF16g2Instance.GetKernelName(guids[GAUDI2_KERNEL_RMS_NORM_FWD_BF16].name, LayerNormAllGaudi2::rms_norm_fwd_bf16);
+           LayerNormAllGaudi2 RmsNormResidualFwdF32g2Instance(LayerNormAllGaudi2::rms_norm_residual_fwd_f32);
+           RmsNormResidualFwdF32g2Instance.GetKernelName(guids[GAUDI2_KERNEL_RMS_NORM_RESIDUAL_FWD_F32].name, LayerNormAllGaudi2::rms_norm_residual_fwd_f32);
+           LayerNormAllGaudi2 RmsNormResidualFwdBF16g2Instance(LayerNormAllGaudi2::rms_norm_residual_fwd_bf16);
+           RmsNormResidualFwdBF16g2Instance.GetKernelName(guids[GAUDI2_KERNEL_RMS_NORM_RESIDUAL_FWD_BF16].name, LayerNormAllGaudi2::rms_norm_residual_fwd_bf16);
+           LayerNormAllGaudi2 RmsNormBwdF32g2Instance(LayerNormAllGaudi2::rms_norm_bwd_f32);
+           RmsNormBwdF32g2Instance.GetKernelName(guids[GAUDI2_KERNEL_RMS_NORM_BWD_F32].name, LayerNormAllGaudi2::rms_norm_bwd_f32);
+           LayerNormAllGaudi2 RmsNormBwdBF16g2Instance(LayerNormAllGaudi2::rms_norm_bwd_bf16);
+           RmsNormBwdBF16g2Instance.GetKernelName(guids[GAUDI2_KERNEL_RMS_NORM_BWD_BF16].name, LayerNormAllGaudi2::rms_norm_bwd_bf16);
+           LayerNormAllGaudi2 NormBwdParamReduceBF16g2Instance(LayerNormAllGaudi2::norm_bwd_param_reduce_bf16);
+           NormBwdParamReduceBF16g2Instance.GetKernelName(guids[GAUDI2_KERNEL_NORM_BWD_PARAM_REDUCE_BF16].name, LayerNormAllGaudi2::norm_bwd_param_reduce_bf16);
+           // activation kernels follow the ActivationAllGaudi2 mode order
+           for (int mode = 0; mode < ActivationAllGaudi2::activation_mode_count; mode++)
+           {
+               ActivationAllGaudi2 activationg2Instance((ActivationAllGaudi2::Activation_mode_t)mode);
+               activationg2Instance.GetKernelName(guids[GAUDI2_KERNEL_GELU_TANH_FWD_F32 + mode].name,
+                                                  (ActivationAllGaudi2::Activation_mode_t)mode);
+           }
+           RopeGaudi2 RopeHalfCacheF32g2Instance(RopeGaudi2::rope_half_cache_f32);
+           RopeHalfCacheF32g2Instance.GetKernelName(guids[GAUDI2_KERNEL_ROPE_HALF_CACHE_F32].name, RopeGaudi2::rope_half_cache_f32);
+           RopeGaudi2 RopeHalfCacheBF16g2Instance(RopeGaudi2::rope_half_cache_bf16);
+           RopeHalfCacheBF16g2Instance.GetKernelName(guids[GAUDI2_KERNEL_ROPE_HALF_CACHE_BF16].name, RopeGaudi2::rope_half_cache_bf16);
+           RopeGaudi2 RopeInterleavedCacheF32g2Instance(RopeGaudi2::rope_interleaved_cache_f32);
+           RopeInterleavedCacheF32g2Instance.GetKernelName(guids[GAUDI2_KERNEL_ROPE_INTERLEAVED_CACHE_F32].name, RopeGaudi2::rope_interleaved_cache_f32);
+           RopeGaudi2 RopeInterleavedCacheBF16g2Instance(RopeGaudi2::rope_interleaved_cache_bf16);
+           RopeInterleavedCacheBF16g2Instance.GetKernelName(guids[GAUDI2_KERNEL_ROPE_INTERLEAVED_CACHE_BF16].name, RopeGaudi2::rope_interleaved_cache_bf16);
+           RopeGaudi2 RopeHalfDynamicF32g2Instance(RopeGaudi2::rope_half_dynamic_f32);
+           RopeHalfDynamicF32g2Instance.GetKernelName(guids[GAUDI2_KERNEL_ROPE_HALF_DYNAMIC_F32].name, RopeGaudi2::rope_half_dynamic_f32);
+           RopeGaudi2 RopeHalfDynamicBF16g2Instance(RopeGaudi2::rope_half_dynamic_bf16);
+           RopeHalfDynamicBF16g2Instance.GetKernelName(guids[GAUDI2_KERNEL_ROPE_HALF_DYNAMIC_BF16].name, RopeGaudi2::rope_half_dynamic_bf16);
+           RopeGaudi2 RopeInterleavedDynamicF32g2Instance(RopeGaudi2::rope_interleaved_dynamic_f32);
+           RopeInterleavedDynamicF32g2Instance.GetKernelName(guids[GAUDI2_KERNEL_ROPE_INTERLEAVED_DYNAMIC_F32].name, RopeGaudi2::rope_interleaved_dynamic_f32);
+           RopeGaudi2 RopeInterleavedDynamicBF16g2Instance(RopeGaudi2::rope_interleaved_dynamic_bf16);
+           RopeInterleavedDynamicBF16g2Instance.GetKernelName(guids[GAUDI2_KERNEL_ROPE_INTERLEAVED_DYNAMIC_BF16].name, RopeGaudi2::rope_interleaved_dynamic_bf16);
+           TopKGaudi2 TopKF32g2Instance(TopKGaudi2::topk_f32);
+           TopKF32g2Instance.GetKernelName(guids[GAUDI2_KERNEL_TOPK_F32].name, TopKGaudi2::topk_f32);
+           TopKGaudi2 TopKBF16g2Instance(TopKGaudi2::topk_bf16);
+           TopKBF16g2Instance.GetKernelName(guids[GAUDI2_KERNEL_TOPK_BF16].name, TopKGaudi2::topk_bf16);
+           TopKGaudi2 ArgMaxF32g2Instance(TopKGaudi2::argmax_f32);
+           ArgMaxF32g2Instance.GetKernelName(guids[GAUDI2_KERNEL_ARGMAX_F32].name, TopKGaudi2::argmax_f32);
+           TopKGaudi2 ArgMaxBF16g2Instance(TopKGaudi2::argmax_bf16);
+           ArgMaxBF16g2Instance.GetKernelName(guids[GAUDI2_KERNEL_ARGMAX_BF16].name, TopKGaudi2::argmax_bf16);
+           // scan kernels follow the ScanGaudi2 mode order
+           for (int mode = 0; mode < ScanGaudi2::scan_mode_count; mode++)
+           {
+               ScanGaudi2 scang2Instance((ScanGaudi2::Scan_mode_t)mode);
+               scang2Instance.GetKernelName(guids[GAUDI2_KERNEL_CUMSUM_F32 + mode].name,
+                                            (ScanGaudi2::Scan_mode_t)mode);
+           }
+           CrossEntropyGaudi2 CrossEntropyFwdF32g2Instance(CrossEntropyGaudi2::cross_entropy_fwd_f32);
+           CrossEntropyFwdF32g2Instance.GetKernelName(guids[GAUDI2_KERNEL_CROSS_ENTROPY_FWD_F32].name, CrossEntropyGaudi2::cross_entropy_fwd_f32);
+           CrossEntropyGaudi2 CrossEntropyFwdBF16g2Instance(CrossEntropyGaudi2::cross_entropy_fwd_bf16);
+           CrossEntropyFwdBF16g2Instance.GetKernelName(guids[GAUDI2_KERNEL_CROSS_ENTROPY_FWD_BF16].name, CrossEntropyGaudi2::cross_entropy_fwd_bf16);
+           CrossEntropyGaudi2 CrossEntropyBwdF32g2Instance(CrossEntropyGaudi2::cross_entropy_bwd_f32);
+           CrossEntropyBwdF32g2Instance.GetKernelName(guids[GAUDI2_KERNEL_CROSS_ENTROPY_BWD_F32].name, CrossEntropyGaudi2::cross_entropy_bwd_f32);
+           CrossEntropyGaudi2 CrossEntropyBwdBF16g2Instance(CrossEntropyGaudi2::cross_entropy_bwd_bf16);
+           CrossEntropyBwdBF16g2Instance.GetKernelName(guids[GAUDI2_KERNEL_CROSS_ENTROPY_BWD_BF16].name, CrossEntropyGaudi2::cross_entropy_bwd_bf16);
+           SoftMaxBwdBF16Gaudi2 softmaxBwdInstance;
+           softmaxBwdInstance.GetKernelNameFcd(guids[GAUDI2_KERNEL_SOFTMAX_BWD_FCD_BF16].name);
+           softmaxBwdInstance.GetKernelNameNonFcd(guids[GAUDI2_KERNEL_SOFTMAX_BWD_NONFCD_BF16].name);
+           SoftMaxMaskedGaudi2 SoftMaxScaledF32g2Instance(SoftMaxMaskedGaudi2::softmax_scaled_f32);
+           SoftMaxScaledF32g2Instance.GetKernelName(guids[GAUDI2_KERNEL_SOFTMAX_SCALED_F32].name, SoftMaxMaskedGaudi2::softmax_scaled_f32);
+           SoftMaxMaskedGaudi2 SoftMaxScaledBF16g2Instance(SoftMaxMaskedGaudi2::softmax_scaled_bf16);
+           SoftMaxScaledBF16g2Instance.GetKernelName(guids[GAUDI2_KERNEL_SOFTMAX_SCALED_BF16].name, SoftMaxMaskedGaudi2::softmax_scaled_bf16);
+           SoftMaxMaskedGaudi2 SoftMaxMaskedF32g2Instance(SoftMaxMaskedGaudi2::softmax_masked_f32);
+           SoftMaxMaskedF32g2Instance.GetKernelName(guids[GAUDI2_KERNEL_SOFTMAX_MASKED_F32].name, SoftMaxMaskedGaudi2::softmax_masked_f32);
+           SoftMaxMaskedGaudi2 SoftMaxMaskedBF16g2Instance(SoftMaxMaskedGaudi2::softmax_masked_bf16);
+           SoftMaxMaskedBF16g2Instance.GetKernelName(guids[GAUDI2_KERNEL_SOFTMAX_MASKED_BF16].name, SoftMaxMaskedGaudi2::softmax_masked_bf16);
+           AdamWGaudi2 AdamWF32g2Instance(AdamWGaudi2::adamw_f32);
+           AdamWF32g2Instance.GetKernelName(guids[GAUDI2_KERNEL_ADAMW_F32].name, AdamWGaudi2::adamw_f32);
+           AdamWGaudi2 AdamWBF16g2Instance(AdamWGaudi2::adamw_bf16);
+           AdamWBF16g2Instance.GetKernelName(guids[GAUDI2_KERNEL_ADAMW_BF16].name, AdamWGaudi2::adamw_bf16);
+           AdamWGaudi2 AdamWMultiF32g2Instance(AdamWGaudi2::adamw_multi_f32);
+           AdamWMultiF32g2Instance.GetKernelName(guids[GAUDI2_KERNEL_ADAMW_MULTI_F32].name, AdamWGaudi2::adamw_multi_f32);
+           AdamWGaudi2 AdamWMultiBF16g2Instance(AdamWGaudi2::adamw_multi_bf16);
+           AdamWMultiBF16g2Instance.GetKernelName(guids[GAUDI2_KERNEL_ADAMW_MULTI_BF16].name, AdamWGaudi2::adamw_multi_bf16);
+           GradNormGaudi2 GradNormF32g2Instance(GradNormGaudi2::grad_norm_f32);
+           GradNormF32g2Instance.GetKernelName(guids[GAUDI2_KERNEL_GRAD_NORM_F32].name, GradNormGaudi2::grad_norm_f32);
+           GradNormGaudi2 GradNormBF16g2Instance(GradNormGaudi2::grad_norm_bf16);
+           GradNormBF16g2Instance.GetKernelName(guids[GAUDI2_KERNEL_GRAD_NORM_BF16].name, GradNormGaudi2::grad_norm_bf16);
+           GradNormGaudi2 GradNormMultiF32g2Instance(GradNormGaudi2::grad_norm_multi_f32);
+           GradNormMultiF32g2Instance.GetKernelName(guids[GAUDI2_KERNEL_GRAD_NORM_MULTI_F32].name, GradNormGaudi2::grad_norm_multi_f32);
+           GradNormGaudi2 GradNormMultiBF16g2Instance(GradNormGaudi2::grad_norm_multi_bf16);
+           GradNormMultiBF16g2Instance.GetKernelName(guids[GAUDI2_KERNEL_GRAD_NORM_MULTI_BF16].name, GradNormGaudi2::grad_norm_multi_bf16);
+           // fp8 casts follow the Fp8CastGaudi2 mode order
+           for (int mode = 0; mode < Fp8CastGaudi2::fp8_cast_mode_count; mode++)
+           {
+               Fp8CastGaudi2 fp8Castg2Instance((Fp8CastGaudi2::Fp8Cast_mode_t)mode);
+               fp8Castg2Instance.GetKernelName(guids[GAUDI2_KERNEL_CAST_F32_TO_FP8_143 + mode].name,
+                                               (Fp8CastGaudi2::Fp8Cast_mode_t)mode);
+           }
+           // int8 (de)quantization follows the QuantizeI8Gaudi2 mode order
+           for (int mode = 0; mode < QuantizeI8Gaudi2::quantize_i8_mode_count; mode++)
+           {
+               QuantizeI8Gaudi2 quantizeI8g2Instance((QuantizeI8Gaudi2::QuantizeI8_mode_t)mode);
+               quantizeI8g2Instance.GetKernelName(guids[GAUDI2_KERNEL_QUANTIZE_I8_TENSOR_F32 + mode].name,
+                                                  (QuantizeI8Gaudi2::QuantizeI8_mode_t)mode);
+           }
+           // any-to-any casts follow the CastAllGaudi2 pair order
+           for (int pair = 0; pair < CastAllGaudi2::c_pairCount; pair++)
+           {
+               CastAllGaudi2 castAllg2Instance(CastAllGaudi2::GetPairSrc(pair), CastAllGaudi2::GetPairDst(pair));
+               castAllg2Instance.GetKernelName(guids[GAUDI2_KERNEL_CAST_ALL_FIRST + pair].name,
+                                               CastAllGaudi2::GetPairSrc(pair), CastAllGaudi2::GetPairDst(pair));
+           }
+           // permutes follow the PermuteGaudi2 mode order
+           for (int mode = 0; mode < PermuteGaudi2::permute_mode_count; mode++)
+           {
+               PermuteGaudi2 permuteg2Instance((PermuteGaudi2::Permute_mode_t)mode);
+               permuteg2Instance.GetKernelName(guids[GAUDI2_KERNEL_PERMUTE_F32 + mode].name,
+                                               (PermuteGaudi2::Permute_mode_t)mode);
+           }
+           // broadcasting binary ops follow the BinaryBroadcast mode order
+           for (int mode = 0; mode < BinaryBroadcast::binary_broadcast_mode_count; mode++)
+           {
+               BinaryBroadcastGaudi2 binaryBroadcastg2Instance((BinaryBroadcast::BinaryBroadcast_mode_t)mode);
+               binaryBroadcastg2Instance.GetKernelName(guids[GAUDI2_KERNEL_BINARY_BROADCAST_F32 + mode].name,
+                                                       (BinaryBroadcast::BinaryBroadcast_mode_t)mode);
+           }
+           // fused elementwise chains follow the FusedElementwiseGaudi2 mode order
+           for (int mode = 0; mode < FusedElementwiseGaudi2::fused_mode_count; mode++)
+           {
+               FusedElementwiseGaudi2 fusedg2Instance((FusedElementwiseGaudi2::FusedElementwise_mode_t)mode);
+               fusedg2Instance.GetKernelName(guids[GAUDI2_KERNEL_FUSED_ELEMENTWISE_F32_TO_F32 + mode].name,
+                                             (FusedElementwiseGaudi2::FusedElementwise_mode_t)mode);
+           }
+           // reductions follow the ReductionGaudi2 mode order
+           for (int mode = 0; mode < ReductionGaudi2::reduce_mode_count; mode++)
+           {
+               ReductionGaudi2 reduceg2Instance((ReductionGaudi2::Reduction_mode_t)mode);
+               reduceg2Instance.GetKernelName(guids[GAUDI2_KERNEL_REDUCE_F32 + mode].name,
+                                              (ReductionGaudi2::Reduction_mode_t)mode);
+           }
+           // transcendentals follow the TranscendentalGaudi2 mode order
+           for (int mode = 0; mode < TranscendentalGaudi2::tr_mode_count; mode++)
+           {
+               TranscendentalGaudi2 trg2Instance((TranscendentalGaudi2::Transcendental_mode_t)mode);
+               trg2Instance.GetKernelName(guids[GAUDI2_KERNEL_TRANSCENDENTAL_COS + mode].name,
+                                          (TranscendentalGaudi2::Transcendental_mode_t)mode);
+           }
+           // masked relu follows the ReluAllGaudi2 mode order
+           for (int mode = ReluAllGaudi2::relu_fwd_mask_f32; mode <= ReluAllGaudi2::relu_bwd_mask_bf16; mode++)
+           {
+               ReluAllGaudi2 reluMaskg2Instance((ReluAllGaudi2::Relu_mode_t)mode);
+               reluMaskg2Instance.GetKernelName(guids[GAUDI2_KERNEL_RELU_FWD_MASK_F32 + mode - ReluAllGaudi2::relu_fwd_mask_f32].name,
+                                                (ReluAllGaudi2::Relu_mode_t)mode);
+           }
+           // dropout follows the DropoutGaudi2 mode order
+           for (int mode = 0; mode < DropoutGaudi2::dropout_mode_count; mode++)
+           {
+               DropoutGaudi2 dropoutg2Instance((DropoutGaudi2::Dropout_mode_t)mode);
+               dropoutg2Instance.GetKernelName(guids[GAUDI2_KERNEL_DROPOUT_FWD_F32 + mode].name,
+                                               (DropoutGaudi2::Dropout_mode_t)mode);
+           }
+           PiecewisePolyGaudi2 piecewisePolyg2Instance;
+           piecewisePolyg2Instance.GetKernelName(guids[GAUDI2_KERNEL_PIECEWISE_POLY_F32].name);
+           FusedAttentionGaudi2 attentionF32g2Instance(FusedAttentionGaudi2::fused_attention_f32);
+           attentionF32g2Instance.GetKernelName(guids[GAUDI2_KERNEL_FUSED_ATTENTION_F32].name, FusedAttentionGaudi2::fused_attention_f32);
+           FusedAttentionGaudi2 attentionKvLengthsF32g2Instance(FusedAttentionGaudi2::fused_attention_kv_lengths_f32);
+           attentionKvLengthsF32g2Instance.GetKernelName(guids[GAUDI2_KERNEL_FUSED_ATTENTION_KV_LENGTHS_F32].name, FusedAttentionGaudi2::fused_attention_kv_lengths_f32);
+           // paged kv cache follows the PagedKvCacheGaudi2 mode order
+           for (int mode = 0; mode < PagedKvCacheGaudi2::paged_kv_mode_count; mode++)
+           {
+               PagedKvCacheGaudi2 pagedKvg2Instance((PagedKvCacheGaudi2::PagedKvCache_mode_t)mode);
+               pagedKvg2Instance.GetKernelName(guids[GAUDI2_KERNEL_PAGED_KV_GATHER_BF16 + mode].name,
+                                               (PagedKvCacheGaudi2::PagedKvCache_mode_t)mode);
+           }
         }
 
         if (kernelCount != nullptr)
@@ -163,6 +404,34 @@ tpc_lib_api::GlueCodeReturn GetKernelGuids( _IN_    tpc_lib_api::DeviceId
             MambaPscanUpdateF32g3Instance.GetKernelName(guids[GAUDI3_KERNEL_PSCAN_UPDATE_F32].name, MambaPscanUpdateGaudi3::pscan_update_f32);
             MambaPscanUpdateGaudi3 MambaPscanUpdateBF16g3Instance(MambaPscanUpdateGaudi3::pscan_update_bf16);
             MambaPscanUpdateBF16g3Instance.GetKernelName(guids[GAUDI3_KERNEL_PSCAN_UPDATE_BF16].name, MambaPscanUpdateGaudi3::pscan_update_bf16);
+            // activation kernels follow the ActivationAllGaudi2 mode order
+            for (int mode = 0; mode < ActivationAllGaudi2::activation_mode_count; mode++)
+            {
+                ActivationAllGaudi3 activationg3Instance((ActivationAllGaudi2::Activation_mode_t)mode);
+                activationg3Instance.GetKernelName(guids[GAUDI3_KERNEL_GELU_TANH_FWD_F32 + mode].name,
+                                                   (ActivationAllGaudi2::Activation_mode_t)mode);
+            }
+            // fp8 casts follow the Fp8CastGaudi2 mode order
+            for (int mode = 0; mode < Fp8CastGaudi2::fp8_cast_mode_count; mode++)
+            {
+                Fp8CastGaudi3 fp8Castg3Instance((Fp8CastGaudi2::Fp8Cast_mode_t)mode);
+                fp8Castg3Instance.GetKernelName(guids[GAUDI3_KERNEL_CAST_F32_TO_FP8_143 + mode].name,
+                                                (Fp8CastGaudi2::Fp8Cast_mode_t)mode);
+            }
+            // any-to-any casts follow the CastAllGaudi2 pair order
+            for (int pair = 0; pair < CastAllGaudi2::c_pairCount; pair++)
+            {
+                CastAllGaudi3 castAllg3Instance(CastAllGaudi2::GetPairSrc(pair), CastAllGaudi2::GetPairDst(pair));
+                castAllg3Instance.GetKernelName(guids[GAUDI3_KERNEL_CAST_ALL_FIRST + pair].name,
+                                                CastAllGaudi2::GetPairSrc(pair), CastAllGaudi2::GetPairDst(pair));
+            }
+            // broadcasting binary ops follow the BinaryBroadcast mode order
+            for (int mode = 0; mode < BinaryBroadcast::binary_broadcast_mode_count; mode++)
+            {
+                BinaryBroadcastGaudi3 binaryBroadcastg3Instance((BinaryBroadcast::BinaryBroadcast_mode_t)mode);
+                binaryBroadcastg3Instance.GetKernelName(guids[GAUDI3_KERNEL_BINARY_BROADCAST_F32 + mode].name,
+                                                        (BinaryBroadcast::BinaryBroadcast_mode_t)mode);
+            }
         }
 
         if (kernelCount != nullptr)
@@ -222,6 +491,12 @@ InstantiateTpcKernel(_IN_  tpc_lib_api::HabanaKernelParams* params,
     {
         return castGaudiInstancefbf.GetGcDefinitions(params,instance);
     }
+    CastGaudi castGaudiInstancefbfsr(CastGaudi::f32_to_bf16_sr);
+    castGaudiInstancefbfsr.GetKernelName(kernelName, CastGaudi::f32_to_bf16_sr);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return castGaudiInstancefbfsr.GetGcDefinitions(params,instance);
+    }
     LeakyReluF32Gaudi leakyReluGaudiInstance;
     leakyReluGaudiInstance.GetKernelName(kernelName);
     if (strcmp(params->guid.name, kernelName) == 0)
@@ -307,6 +582,16 @@ InstantiateTpcKernel(_IN_  tpc_lib_api::HabanaKernelParams* params,
         return ReluBwdBF16Instance.GetGcDefinitions(params,instance);
     }
 
+    for (int mode = Relu6All::relu6_fwd_mask_f32; mode <= Relu6All::relu_bwd_mask_bf16; mode++)
+    {
+        Relu6All reluMaskInstance((Relu6All::Relu6_mode_t)mode);
+        reluMaskInstance.GetKernelName(kernelName, (Relu6All::Relu6_mode_t)mode);
+        if (strcmp(params->guid.name, kernelName) == 0)
+        {
+            return reluMaskInstance.GetGcDefinitions(params,instance);
+        }
+    }
+
     MatrixMulFwdF32 MatrixMulFwdF32Instance;
     MatrixMulFwdF32Instance.GetKernelName(kernelName);
     if (strcmp(params->guid.name, kernelName) == 0)
@@ -383,6 +668,26 @@ InstantiateTpcKernel(_IN_  tpc_lib_api::HabanaKernelParams* params,
     {
         return KLDivBwdF32Instance.GetGcDefinitions(params,instance);
     }
+
+    for (int mode = 0; mode < BinaryBroadcast::binary_broadcast_mode_count; mode++)
+    {
+        BinaryBroadcast binaryBroadcastInstance((BinaryBroadcast::BinaryBroadcast_mode_t)mode);
+        binaryBroadcastInstance.GetKernelName(kernelName, (BinaryBroadcast::BinaryBroadcast_mode_t)mode);
+        if (strcmp(params->guid.name, kernelName) == 0)
+        {
+            return binaryBroadcastInstance.GetGcDefinitions(params,instance);
+        }
+    }
+
+    for (int pair = 0; pair < CastAllGaudi::c_pairCount; pair++)
+    {
+        CastAllGaudi castAllInstance(CastAllGaudi::GetPairSrc(pair), CastAllGaudi::GetPairDst(pair));
+        castAllInstance.GetKernelName(kernelName, CastAllGaudi::GetPairSrc(pair), CastAllGaudi::GetPairDst(pair));
+        if (strcmp(params->guid.name, kernelName) == 0)
+        {
+            return castAllInstance.GetGcDefinitions(params,instance);
+        }
+    }
     /////// --- Gaudi2 
     ///////////////////////////////
     KLDivAll KLDivFwdF32Instance2(KLDivAll::fwd_f32_gaudi2);
@@ -456,6 +761,16 @@ InstantiateTpcKernel(_IN_  tpc_lib_api::HabanaKernelParams* params,
         return ReluBwdBF16g2Instance.GetGcDefinitions(params,instance);
     }
 
+    for (int mode = ReluAllGaudi2::relu_fwd_mask_f32; mode <= ReluAllGaudi2::relu_bwd_mask_bf16; mode++)
+    {
+        ReluAllGaudi2 reluMaskg2Instance((ReluAllGaudi2::Relu_mode_t)mode);
+        reluMaskg2Instance.GetKernelName(kernelName, (ReluAllGaudi2::Relu_mode_t)mode);
+        if (strcmp(params->guid.name, kernelName) == 0)
+        {
+            return reluMaskg2Instance.GetGcDefinitions(params,instance);
+        }
+    }
+
     UserLutGaudi2 userLutInstance;
     userLutInstance.GetKernelName(kernelName);
     if (strcmp(params->guid.name, kernelName) == 0)
@@ -463,6 +778,446 @@ InstantiateTpcKernel(_IN_  tpc_lib_api::HabanaKernelParams* params,
         return userLutInstance.GetGcDefinitions(params,instance);
     }
 
+    LayerNormAllGaudi2 LayerNormFwdF32g2Instance(LayerNormAllGaudi2::layer_norm_fwd_f32);
+    LayerNormFwdF32g2Instance.GetKernelName(kernelName, LayerNormAllGaudi2::layer_norm_fwd_f32);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return LayerNormFwdF32g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    LayerNormAllGaudi2 LayerNormFwdBF16g2Instance(LayerNormAllGaudi2::layer_norm_fwd_bf16);
+    LayerNormFwdBF16g2Instance.GetKernelName(kernelName, LayerNormAllGaudi2::layer_norm_fwd_bf16);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return LayerNormFwdBF16g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    LayerNormAllGaudi2 LayerNormResidualFwdF32g2Instance(LayerNormAllGaudi2::layer_norm_residual_fwd_f32);
+    LayerNormResidualFwdF32g2Instance.GetKernelName(kernelName, LayerNormAllGaudi2::layer_norm_residual_fwd_f32);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return LayerNormResidualFwdF32g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    LayerNormAllGaudi2 LayerNormResidualFwdBF16g2Instance(LayerNormAllGaudi2::layer_norm_residual_fwd_bf16);
+    LayerNormResidualFwdBF16g2Instance.GetKernelName(kernelName, LayerNormAllGaudi2::layer_norm_residual_fwd_bf16);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return LayerNormResidualFwdBF16g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    LayerNormAllGaudi2 LayerNormBwdF32g2Instance(LayerNormAllGaudi2::layer_norm_bwd_f32);
+    LayerNormBwdF32g2Instance.GetKernelName(kernelName, LayerNormAllGaudi2::layer_norm_bwd_f32);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return LayerNormBwdF32g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    LayerNormAllGaudi2 LayerNormBwdBF16g2Instance(LayerNormAllGaudi2::layer_norm_bwd_bf16);
+    LayerNormBwdBF16g2Instance.GetKernelName(kernelName, LayerNormAllGaudi2::layer_norm_bwd_bf16);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return LayerNormBwdBF16g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    LayerNormAllGaudi2 RmsNormFwdF32g2Instance(LayerNormAllGaudi2::rms_norm_fwd_f32);
+    RmsNormFwdF32g2Instance.GetKernelName(kernelName, LayerNormAllGaudi2::rms_norm_fwd_f32);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return RmsNormFwdF32g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    LayerNormAllGaudi2 RmsNormFwdBF16g2Instance(LayerNormAllGaudi2::rms_norm_fwd_bf16);
+    RmsNormFwdBF16g2Instance.GetKernelName(kernelName, LayerNormAllGaudi2::rms_norm_fwd_bf16);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return RmsNormFwdBF16g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    LayerNormAllGaudi2 RmsNormResidualFwdF32g2Instance(LayerNormAllGaudi2::rms_norm_residual_fwd_f32);
+    RmsNormResidualFwdF32g2Instance.GetKernelName(kernelName, LayerNormAllGaudi2::rms_norm_residual_fwd_f32);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return RmsNormResidualFwdF32g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    LayerNormAllGaudi2 RmsNormResidualFwdBF16g2Instance(LayerNormAllGaudi2::rms_norm_residual_fwd_bf16);
+    RmsNormResidualFwdBF16g2Instance.GetKernelName(kernelName, LayerNormAllGaudi2::rms_norm_residual_fwd_bf16);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return RmsNormResidualFwdBF16g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    LayerNormAllGaudi2 RmsNormBwdF32g2Instance(LayerNormAllGaudi2::rms_norm_bwd_f32);
+    RmsNormBwdF32g2Instance.GetKernelName(kernelName, LayerNormAllGaudi2::rms_norm_bwd_f32);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return RmsNormBwdF32g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    LayerNormAllGaudi2 RmsNormBwdBF16g2Instance(LayerNormAllGaudi2::rms_norm_bwd_bf16);
+    RmsNormBwdBF16g2Instance.GetKernelName(kernelName, LayerNormAllGaudi2::rms_norm_bwd_bf16);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return RmsNormBwdBF16g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    LayerNormAllGaudi2 NormBwdParamReduceBF16g2Instance(LayerNormAllGaudi2::norm_bwd_param_reduce_bf16);
+    NormBwdParamReduceBF16g2Instance.GetKernelName(kernelName, LayerNormAllGaudi2::norm_bwd_param_reduce_bf16);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return NormBwdParamReduceBF16g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    for (int mode = 0; mode < ActivationAllGaudi2::activation_mode_count; mode++)
+    {
+        ActivationAllGaudi2 activationg2Instance((ActivationAllGaudi2::Activation_mode_t)mode);
+        activationg2Instance.GetKernelName(kernelName, (ActivationAllGaudi2::Activation_mode_t)mode);
+        if (strcmp(params->guid.name, kernelName) == 0)
+        {
+            return activationg2Instance.GetGcDefinitions(params,instance);
+        }
+    }
+
+    RopeGaudi2 RopeHalfCacheF32g2Instance(RopeGaudi2::rope_half_cache_f32);
+    RopeHalfCacheF32g2Instance.GetKernelName(kernelName, RopeGaudi2::rope_half_cache_f32);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return RopeHalfCacheF32g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    RopeGaudi2 RopeHalfCacheBF16g2Instance(RopeGaudi2::rope_half_cache_bf16);
+    RopeHalfCacheBF16g2Instance.GetKernelName(kernelName, RopeGaudi2::rope_half_cache_bf16);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return RopeHalfCacheBF16g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    RopeGaudi2 RopeInterleavedCacheF32g2Instance(RopeGaudi2::rope_interleaved_cache_f32);
+    RopeInterleavedCacheF32g2Instance.GetKernelName(kernelName, RopeGaudi2::rope_interleaved_cache_f32);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return RopeInterleavedCacheF32g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    RopeGaudi2 RopeInterleavedCacheBF16g2Instance(RopeGaudi2::rope_interleaved_cache_bf16);
+    RopeInterleavedCacheBF16g2Instance.GetKernelName(kernelName, RopeGaudi2::rope_interleaved_cache_bf16);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return RopeInterleavedCacheBF16g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    RopeGaudi2 RopeHalfDynamicF32g2Instance(RopeGaudi2::rope_half_dynamic_f32);
+    RopeHalfDynamicF32g2Instance.GetKernelName(kernelName, RopeGaudi2::rope_half_dynamic_f32);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return RopeHalfDynamicF32g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    RopeGaudi2 RopeHalfDynamicBF16g2Instance(RopeGaudi2::rope_half_dynamic_bf16);
+    RopeHalfDynamicBF16g2Instance.GetKernelName(kernelName, RopeGaudi2::rope_half_dynamic_bf16);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return RopeHalfDynamicBF16g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    RopeGaudi2 RopeInterleavedDynamicF32g2Instance(RopeGaudi2::rope_interleaved_dynamic_f32);
+    RopeInterleavedDynamicF32g2Instance.GetKernelName(kernelName, RopeGaudi2::rope_interleaved_dynamic_f32);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return RopeInterleavedDynamicF32g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    RopeGaudi2 RopeInterleavedDynamicBF16g2Instance(RopeGaudi2::rope_interleaved_dynamic_bf16);
+    RopeInterleavedDynamicBF16g2Instance.GetKernelName(kernelName, RopeGaudi2::rope_interleaved_dynamic_bf16);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return RopeInterleavedDynamicBF16g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    TopKGaudi2 TopKF32g2Instance(TopKGaudi2::topk_f32);
+    TopKF32g2Instance.GetKernelName(kernelName, TopKGaudi2::topk_f32);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return TopKF32g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    TopKGaudi2 TopKBF16g2Instance(TopKGaudi2::topk_bf16);
+    TopKBF16g2Instance.GetKernelName(kernelName, TopKGaudi2::topk_bf16);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return TopKBF16g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    TopKGaudi2 ArgMaxF32g2Instance(TopKGaudi2::argmax_f32);
+    ArgMaxF32g2Instance.GetKernelName(kernelName, TopKGaudi2::argmax_f32);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return ArgMaxF32g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    TopKGaudi2 ArgMaxBF16g2Instance(TopKGaudi2::argmax_bf16);
+    ArgMaxBF16g2Instance.GetKernelName(kernelName, TopKGaudi2::argmax_bf16);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return ArgMaxBF16g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    for (int mode = 0; mode < ScanGaudi2::scan_mode_count; mode++)
+    {
+        ScanGaudi2 scang2Instance((ScanGaudi2::Scan_mode_t)mode);
+        scang2Instance.GetKernelName(kernelName, (ScanGaudi2::Scan_mode_t)mode);
+        if (strcmp(params->guid.name, kernelName) == 0)
+        {
+            return scang2Instance.GetGcDefinitions(params,instance);
+        }
+    }
+
+    CrossEntropyGaudi2 CrossEntropyFwdF32g2Instance(CrossEntropyGaudi2::cross_entropy_fwd_f32);
+    CrossEntropyFwdF32g2Instance.GetKernelName(kernelName, CrossEntropyGaudi2::cross_entropy_fwd_f32);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return CrossEntropyFwdF32g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    CrossEntropyGaudi2 CrossEntropyFwdBF16g2Instance(CrossEntropyGaudi2::cross_entropy_fwd_bf16);
+    CrossEntropyFwdBF16g2Instance.GetKernelName(kernelName, CrossEntropyGaudi2::cross_entropy_fwd_bf16);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return CrossEntropyFwdBF16g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    CrossEntropyGaudi2 CrossEntropyBwdF32g2Instance(CrossEntropyGaudi2::cross_entropy_bwd_f32);
+    CrossEntropyBwdF32g2Instance.GetKernelName(kernelName, CrossEntropyGaudi2::cross_entropy_bwd_f32);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return CrossEntropyBwdF32g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    CrossEntropyGaudi2 CrossEntropyBwdBF16g2Instance(CrossEntropyGaudi2::cross_entropy_bwd_bf16);
+    CrossEntropyBwdBF16g2Instance.GetKernelName(kernelName, CrossEntropyGaudi2::cross_entropy_bwd_bf16);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return CrossEntropyBwdBF16g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    SoftMaxBwdBF16Gaudi2 softmaxBwdBf16g2Instance;
+    softmaxBwdBf16g2Instance.GetKernelNameFcd(kernelName);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return softmaxBwdBf16g2Instance.GetGcDefinitions(params,instance);
+    }
+    softmaxBwdBf16g2Instance.GetKernelNameNonFcd(kernelName);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return softmaxBwdBf16g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    SoftMaxMaskedGaudi2 SoftMaxScaledF32g2Instance(SoftMaxMaskedGaudi2::softmax_scaled_f32);
+    SoftMaxScaledF32g2Instance.GetKernelName(kernelName, SoftMaxMaskedGaudi2::softmax_scaled_f32);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return SoftMaxScaledF32g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    SoftMaxMaskedGaudi2 SoftMaxScaledBF16g2Instance(SoftMaxMaskedGaudi2::softmax_scaled_bf16);
+    SoftMaxScaledBF16g2Instance.GetKernelName(kernelName, SoftMaxMaskedGaudi2::softmax_scaled_bf16);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return SoftMaxScaledBF16g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    SoftMaxMaskedGaudi2 SoftMaxMaskedF32g2Instance(SoftMaxMaskedGaudi2::softmax_masked_f32);
+    SoftMaxMaskedF32g2Instance.GetKernelName(kernelName, SoftMaxMaskedGaudi2::softmax_masked_f32);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return SoftMaxMaskedF32g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    SoftMaxMaskedGaudi2 SoftMaxMaskedBF16g2Instance(SoftMaxMaskedGaudi2::softmax_masked_bf16);
+    SoftMaxMaskedBF16g2Instance.GetKernelName(kernelName, SoftMaxMaskedGaudi2::softmax_masked_bf16);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return SoftMaxMaskedBF16g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    AdamWGaudi2 AdamWF32g2Instance(AdamWGaudi2::adamw_f32);
+    AdamWF32g2Instance.GetKernelName(kernelName, AdamWGaudi2::adamw_f32);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return AdamWF32g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    AdamWGaudi2 AdamWBF16g2Instance(AdamWGaudi2::adamw_bf16);
+    AdamWBF16g2Instance.GetKernelName(kernelName, AdamWGaudi2::adamw_bf16);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return AdamWBF16g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    AdamWGaudi2 AdamWMultiF32g2Instance(AdamWGaudi2::adamw_multi_f32);
+    AdamWMultiF32g2Instance.GetKernelName(kernelName, AdamWGaudi2::adamw_multi_f32);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return AdamWMultiF32g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    AdamWGaudi2 AdamWMultiBF16g2Instance(AdamWGaudi2::adamw_multi_bf16);
+    AdamWMultiBF16g2Instance.GetKernelName(kernelName, AdamWGaudi2::adamw_multi_bf16);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return AdamWMultiBF16g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    GradNormGaudi2 GradNormF32g2Instance(GradNormGaudi2::grad_norm_f32);
+    GradNormF32g2Instance.GetKernelName(kernelName, GradNormGaudi2::grad_norm_f32);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return GradNormF32g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    GradNormGaudi2 GradNormBF16g2Instance(GradNormGaudi2::grad_norm_bf16);
+    GradNormBF16g2Instance.GetKernelName(kernelName, GradNormGaudi2::grad_norm_bf16);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return GradNormBF16g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    GradNormGaudi2 GradNormMultiF32g2Instance(GradNormGaudi2::grad_norm_multi_f32);
+    GradNormMultiF32g2Instance.GetKernelName(kernelName, GradNormGaudi2::grad_norm_multi_f32);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return GradNormMultiF32g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    GradNormGaudi2 GradNormMultiBF16g2Instance(GradNormGaudi2::grad_norm_multi_bf16);
+    GradNormMultiBF16g2Instance.GetKernelName(kernelName, GradNormGaudi2::grad_norm_multi_bf16);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return GradNormMultiBF16g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    for (int mode = 0; mode < Fp8CastGaudi2::fp8_cast_mode_count; mode++)
+    {
+        Fp8CastGaudi2 fp8Castg2Instance((Fp8CastGaudi2::Fp8Cast_mode_t)mode);
+        fp8Castg2Instance.GetKernelName(kernelName, (Fp8CastGaudi2::Fp8Cast_mode_t)mode);
+        if (strcmp(params->guid.name, kernelName) == 0)
+        {
+            return fp8Castg2Instance.GetGcDefinitions(params,instance);
+        }
+    }
+
+    for (int mode = 0; mode < QuantizeI8Gaudi2::quantize_i8_mode_count; mode++)
+    {
+        QuantizeI8Gaudi2 quantizeI8g2Instance((QuantizeI8Gaudi2::QuantizeI8_mode_t)mode);
+        quantizeI8g2Instance.GetKernelName(kernelName, (QuantizeI8Gaudi2::QuantizeI8_mode_t)mode);
+        if (strcmp(params->guid.name, kernelName) == 0)
+        {
+            return quantizeI8g2Instance.GetGcDefinitions(params,instance);
+        }
+    }
+
+    for (int pair = 0; pair < CastAllGaudi2::c_pairCount; pair++)
+    {
+        CastAllGaudi2 castAllg2Instance(CastAllGaudi2::GetPairSrc(pair), CastAllGaudi2::GetPairDst(pair));
+        castAllg2Instance.GetKernelName(kernelName, CastAllGaudi2::GetPairSrc(pair), CastAllGaudi2::GetPairDst(pair));
+        if (strcmp(params->guid.name, kernelName) == 0)
+        {
+            return castAllg2Instance.GetGcDefinitions(params,instance);
+        }
+    }
+
+    for (int mode = 0; mode < PermuteGaudi2::permute_mode_count; mode++)
+    {
+        PermuteGaudi2 permuteg2Instance((PermuteGaudi2::Permute_mode_t)mode);
+        permuteg2Instance.GetKernelName(kernelName, (PermuteGaudi2::Permute_mode_t)mode);
+        if (strcmp(params->guid.name, kernelName) == 0)
+        {
+            return permuteg2Instance.GetGcDefinitions(params,instance);
+        }
+    }
+
+    for (int mode = 0; mode < BinaryBroadcast::binary_broadcast_mode_count; mode++)
+    {
+        BinaryBroadcastGaudi2 binaryBroadcastg2Instance((BinaryBroadcast::BinaryBroadcast_mode_t)mode);
+        binaryBroadcastg2Instance.GetKernelName(kernelName, (BinaryBroadcast::BinaryBroadcast_mode_t)mode);
+        if (strcmp(params->guid.name, kernelName) == 0)
+        {
+            return binaryBroadcastg2Instance.GetGcDefinitions(params,instance);
+        }
+    }
+
+    for (int mode = 0; mode < FusedElementwiseGaudi2::fused_mode_count; mode++)
+    {
+        FusedElementwiseGaudi2 fusedg2Instance((FusedElementwiseGaudi2::FusedElementwise_mode_t)mode);
+        fusedg2Instance.GetKernelName(kernelName, (FusedElementwiseGaudi2::FusedElementwise_mode_t)mode);
+        if (strcmp(params->guid.name, kernelName) == 0)
+        {
+            return fusedg2Instance.GetGcDefinitions(params,instance);
+        }
+    }
+
+    for (int mode = 0; mode < ReductionGaudi2::reduce_mode_count; mode++)
+    {
+        ReductionGaudi2 reduceg2Instance((ReductionGaudi2::Reduction_mode_t)mode);
+        reduceg2Instance.GetKernelName(kernelName, (ReductionGaudi2::Reduction_mode_t)mode);
+        if (strcmp(params->guid.name, kernelName) == 0)
+        {
+            return reduceg2Instance.GetGcDefinitions(params,instance);
+        }
+    }
+
+    for (int mode = 0; mode < TranscendentalGaudi2::tr_mode_count; mode++)
+    {
+        TranscendentalGaudi2 trg2Instance((TranscendentalGaudi2::Transcendental_mode_t)mode);
+        trg2Instance.GetKernelName(kernelName, (TranscendentalGaudi2::Transcendental_mode_t)mode);
+        if (strcmp(params->guid.name, kernelName) == 0)
+        {
+            return trg2Instance.GetGcDefinitions(params,instance);
+        }
+    }
+
+    for (int mode = 0; mode < DropoutGaudi2::dropout_mode_count; mode++)
+    {
+        DropoutGaudi2 dropoutg2Instance((DropoutGaudi2::Dropout_mode_t)mode);
+        dropoutg2Instance.GetKernelName(kernelName, (DropoutGaudi2::Dropout_mode_t)mode);
+        if (strcmp(params->guid.name, kernelName) == 0)
+        {
+            return dropoutg2Instance.GetGcDefinitions(params,instance);
+        }
+    }
+
+    PiecewisePolyGaudi2 piecewisePolyg2Instance;
+    piecewisePolyg2Instance.GetKernelName(kernelName);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return piecewisePolyg2Instance.GetGcDefinitions(params,instance);
+    }
+
+    FusedAttentionGaudi2 attentionF32g2Instance(FusedAttentionGaudi2::fused_attention_f32);
+    attentionF32g2Instance.GetKernelName(kernelName, FusedAttentionGaudi2::fused_attention_f32);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return attentionF32g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    FusedAttentionGaudi2 attentionKvLengthsF32g2Instance(FusedAttentionGaudi2::fused_attention_kv_lengths_f32);
+    attentionKvLengthsF32g2Instance.GetKernelName(kernelName, FusedAttentionGaudi2::fused_attention_kv_lengths_f32);
+    if (strcmp(params->guid.name, kernelName) == 0)
+    {
+        return attentionKvLengthsF32g2Instance.GetGcDefinitions(params,instance);
+    }
+
+    for (int mode = 0; mode < PagedKvCacheGaudi2::paged_kv_mode_count; mode++)
+    {
+        PagedKvCacheGaudi2 pagedKvg2Instance((PagedKvCacheGaudi2::PagedKvCache_mode_t)mode);
+        pagedKvg2Instance.GetKernelName(kernelName, (PagedKvCacheGaudi2::PagedKvCache_mode_t)mode);
+        if (strcmp(params->guid.name, kernelName) == 0)
+        {
+            return pagedKvg2Instance.GetGcDefinitions(params,instance);
+        }
+    }
+
     /////// --- Gaudi3
     ///////////////////////////////    
     MambaPscanGaudi3 MambaPscanF32g3Instance(MambaPscanGaudi3::pscan_f32);
@@ -488,7 +1243,44 @@ InstantiateTpcKernel(_IN_  tpc_lib_api::HabanaKernelParams* params,
     if (strcmp(params->guid.name, kernelName) == 0)
     {
         return MambaPscanUpdateBF16g3Instance.GetGcDefinitions(params,instance);
-    }    
+    }
+    for (int mode = 0; mode < ActivationAllGaudi2::activation_mode_count; mode++)
+    {
+        ActivationAllGaudi3 activationg3Instance((ActivationAllGaudi2::Activation_mode_t)mode);
+        activationg3Instance.GetKernelName(kernelName, (ActivationAllGaudi2::Activation_mode_t)mode);
+        if (strcmp(params->guid.name, kernelName) == 0)
+        {
+            return activationg3Instance.GetGcDefinitions(params,instance);
+        }
+    }
+    for (int mode = 0; mode < Fp8CastGaudi2::fp8_cast_mode_count; mode++)
+    {
+        Fp8CastGaudi3 fp8Castg3Instance((Fp8CastGaudi2::Fp8Cast_mode_t)mode);
+        fp8Castg3Instance.GetKernelName(kernelName, (Fp8CastGaudi2::Fp8Cast_mode_t)mode);
+        if (strcmp(params->guid.name, kernelName) == 0)
+        {
+            return fp8Castg3Instance.GetGcDefinitions(params,instance);
+        }
+    }
+    for (int pair = 0; pair < CastAllGaudi2::c_pairCount; pair++)
+    {
+        CastAllGaudi3 castAllg3Instance(CastAllGaudi2::GetPairSrc(pair), CastAllGaudi2::GetPairDst(pair));
+        castAllg3Instance.GetKernelName(kernelName, CastAllGaudi2::GetPairSrc(pair), CastAllGaudi2::GetPairDst(pair));
+        if (strcmp(params->guid.name, kernelName) == 0)
+        {
+            return castAllg3Instance.GetGcDefinitions(params,instance);
+        }
+    }
+
+    for (int mode = 0; mode < BinaryBroadcast::binary_broadcast_mode_count; mode++)
+    {
+        BinaryBroadcastGaudi3 binaryBroadcastg3Instance((BinaryBroadcast::BinaryBroadcast_mode_t)mode);
+        binaryBroadcastg3Instance.GetKernelName(kernelName, (BinaryBroadcast::BinaryBroadcast_mode_t)mode);
+        if (strcmp(params->guid.name, kernelName) == 0)
+        {
+            return binaryBroadcastg3Instance.GetGcDefinitions(params,instance);
+        }
+    }
     return tpc_lib_api::GLUE_NODE_NOT_FOUND;
 }
 
@@ -50,6 +50,21 @@ typedef enum
     GAUDI_KERNEL_GATHER_FWD_DIM1_I32,
     GAUDI_KERNEL_KL_DIV_FWD_F32,
     GAUDI_KERNEL_KL_DIV_BWD_F32,
+    GAUDI_KERNEL_CAST_F32_BF16_SR,
+    GAUDI_KERNEL_BINARY_BROADCAST_F32,
+    GAUDI_KERNEL_BINARY_BROADCAST_BF16,
+    GAUDI_KERNEL_RELU6_FWD_MASK_F32,
+    GAUDI_KERNEL_RELU6_BWD_MASK_F32,
+    GAUDI_KERNEL_RELU6_FWD_MASK_BF16,
+    GAUDI_KERNEL_RELU6_BWD_MASK_BF16,
+    GAUDI_KERNEL_RELU_FWD_MASK_F32,
+    GAUDI_KERNEL_RELU_BWD_MASK_F32,
+    GAUDI_KERNEL_RELU_FWD_MASK_BF16,
+    GAUDI_KERNEL_RELU_BWD_MASK_BF16,
+    // CastAllGaudi (src, dst) pairs in CastAllGaudi::GetPairIndex order,
+    // 6 types * 5 other types, no f16
+    GAUDI_KERNEL_CAST_ALL_FIRST,
+    GAUDI_KERNEL_CAST_ALL_LAST = GAUDI_KERNEL_CAST_ALL_FIRST + 29,
 
     GAUDI_KERNEL_MAX_EXAMPLE_KERNEL
 
@@ -69,6 +84,156 @@ typedef enum
     GAUDI2_KERNEL_RELU_FWD_BF16,
     GAUDI2_KERNEL_RELU_BWD_BF16,    
     GAUDI2_KERNEL_USER_LUT,
+    GAUDI2_KERNEL_LAYER_NORM_FWD_F32,
+    GAUDI2_KERNEL_LAYER_NORM_FWD_BF16,
+    GAUDI2_KERNEL_LAYER_NORM_RESIDUAL_FWD_F32,
+    GAUDI2_KERNEL_LAYER_NORM_RESIDUAL_FWD_BF16,
+    GAUDI2_KERNEL_LAYER_NORM_BWD_F32,
+    GAUDI2_KERNEL_LAYER_NORM_BWD_BF16,
+    GAUDI2_KERNEL_RMS_NORM_FWD_F32,
+    GAUDI2_KERNEL_RMS_NORM_FWD_BF16,
+    GAUDI2_KERNEL_RMS_NORM_RESIDUAL_FWD_F32,
+    GAUDI2_KERNEL_RMS_NORM_RESIDUAL_FWD_BF16,
+    GAUDI2_KERNEL_RMS_NORM_BWD_F32,
+    GAUDI2_KERNEL_RMS_NORM_BWD_BF16,
+    GAUDI2_KERNEL_NORM_BWD_PARAM_REDUCE_BF16,
+    GAUDI2_KERNEL_GELU_TANH_FWD_F32,
+    GAUDI2_KERNEL_GELU_TANH_FWD_BF16,
+    GAUDI2_KERNEL_GELU_TANH_BWD_F32,
+    GAUDI2_KERNEL_GELU_TANH_BWD_BF16,
+    GAUDI2_KERNEL_GELU_ERF_FWD_F32,
+    GAUDI2_KERNEL_GELU_ERF_FWD_BF16,
+    GAUDI2_KERNEL_GELU_ERF_BWD_F32,
+    GAUDI2_KERNEL_GELU_ERF_BWD_BF16,
+    GAUDI2_KERNEL_SILU_FWD_F32,
+    GAUDI2_KERNEL_SILU_FWD_BF16,
+    GAUDI2_KERNEL_SILU_BWD_F32,
+    GAUDI2_KERNEL_SILU_BWD_BF16,
+    GAUDI2_KERNEL_SWIGLU_FWD_F32,
+    GAUDI2_KERNEL_SWIGLU_FWD_BF16,
+    GAUDI2_KERNEL_SWIGLU_BWD_F32,
+    GAUDI2_KERNEL_SWIGLU_BWD_BF16,
+    GAUDI2_KERNEL_GEGLU_FWD_F32,
+    GAUDI2_KERNEL_GEGLU_FWD_BF16,
+    GAUDI2_KERNEL_GEGLU_BWD_F32,
+    GAUDI2_KERNEL_GEGLU_BWD_BF16,
+    GAUDI2_KERNEL_ROPE_HALF_CACHE_F32,
+    GAUDI2_KERNEL_ROPE_HALF_CACHE_BF16,
+    GAUDI2_KERNEL_ROPE_INTERLEAVED_CACHE_F32,
+    GAUDI2_KERNEL_ROPE_INTERLEAVED_CACHE_BF16,
+    GAUDI2_KERNEL_ROPE_HALF_DYNAMIC_F32,
+    GAUDI2_KERNEL_ROPE_HALF_DYNAMIC_BF16,
+    GAUDI2_KERNEL_ROPE_INTERLEAVED_DYNAMIC_F32,
+    GAUDI2_KERNEL_ROPE_INTERLEAVED_DYNAMIC_BF16,
+    GAUDI2_KERNEL_TOPK_F32,
+    GAUDI2_KERNEL_TOPK_BF16,
+    GAUDI2_KERNEL_ARGMAX_F32,
+    GAUDI2_KERNEL_ARGMAX_BF16,
+    GAUDI2_KERNEL_CUMSUM_F32,
+    GAUDI2_KERNEL_CUMSUM_BLOCK_REDUCE_F32,
+    GAUDI2_KERNEL_CUMSUM_BLOCK_FIXUP_F32,
+    GAUDI2_KERNEL_CUMSUM_BF16,
+    GAUDI2_KERNEL_CUMSUM_BLOCK_REDUCE_BF16,
+    GAUDI2_KERNEL_CUMSUM_BLOCK_FIXUP_BF16,
+    GAUDI2_KERNEL_CUMSUM_I32,
+    GAUDI2_KERNEL_CUMSUM_BLOCK_REDUCE_I32,
+    GAUDI2_KERNEL_CUMSUM_BLOCK_FIXUP_I32,
+    GAUDI2_KERNEL_CUMPROD_F32,
+    GAUDI2_KERNEL_CUMPROD_BLOCK_REDUCE_F32,
+    GAUDI2_KERNEL_CUMPROD_BLOCK_FIXUP_F32,
+    GAUDI2_KERNEL_CUMPROD_BF16,
+    GAUDI2_KERNEL_CUMPROD_BLOCK_REDUCE_BF16,
+    GAUDI2_KERNEL_CUMPROD_BLOCK_FIXUP_BF16,
+    GAUDI2_KERNEL_CUMPROD_I32,
+    GAUDI2_KERNEL_CUMPROD_BLOCK_REDUCE_I32,
+    GAUDI2_KERNEL_CUMPROD_BLOCK_FIXUP_I32,
+    GAUDI2_KERNEL_CROSS_ENTROPY_FWD_F32,
+    GAUDI2_KERNEL_CROSS_ENTROPY_FWD_BF16,
+    GAUDI2_KERNEL_CROSS_ENTROPY_BWD_F32,
+    GAUDI2_KERNEL_CROSS_ENTROPY_BWD_BF16,
+    GAUDI2_KERNEL_SOFTMAX_BWD_FCD_BF16,
+    GAUDI2_KERNEL_SOFTMAX_BWD_NONFCD_BF16,
+    GAUDI2_KERNEL_SOFTMAX_SCALED_F32,
+    GAUDI2_KERNEL_SOFTMAX_SCALED_BF16,
+    GAUDI2_KERNEL_SOFTMAX_MASKED_F32,
+    GAUDI2_KERNEL_SOFTMAX_MASKED_BF16,
+    GAUDI2_KERNEL_ADAMW_F32,
+    GAUDI2_KERNEL_ADAMW_BF16,
+    GAUDI2_KERNEL_ADAMW_MULTI_F32,
+    GAUDI2_KERNEL_ADAMW_MULTI_BF16,
+    GAUDI2_KERNEL_GRAD_NORM_F32,
+    GAUDI2_KERNEL_GRAD_NORM_BF16,
+    GAUDI2_KERNEL_GRAD_NORM_MULTI_F32,
+    GAUDI2_KERNEL_GRAD_NORM_MULTI_BF16,
+    GAUDI2_KERNEL_CAST_F32_TO_FP8_143,
+    GAUDI2_KERNEL_CAST_BF16_TO_FP8_143,
+    GAUDI2_KERNEL_CAST_F32_TO_FP8_152,
+    GAUDI2_KERNEL_CAST_BF16_TO_FP8_152,
+    GAUDI2_KERNEL_CAST_FP8_143_TO_F32,
+    GAUDI2_KERNEL_CAST_FP8_143_TO_BF16,
+    GAUDI2_KERNEL_CAST_FP8_152_TO_F32,
+    GAUDI2_KERNEL_CAST_FP8_152_TO_BF16,
+    GAUDI2_KERNEL_QUANTIZE_I8_TENSOR_F32,
+    GAUDI2_KERNEL_QUANTIZE_I8_TENSOR_BF16,
+    GAUDI2_KERNEL_DEQUANTIZE_I8_TENSOR_F32,
+    GAUDI2_KERNEL_DEQUANTIZE_I8_TENSOR_BF16,
+    GAUDI2_KERNEL_QUANTIZE_I8_CHANNEL_F32,
+    GAUDI2_KERNEL_QUANTIZE_I8_CHANNEL_BF16,
+    GAUDI2_KERNEL_DEQUANTIZE_I8_CHANNEL_F32,
+    GAUDI2_KERNEL_DEQUANTIZE_I8_CHANNEL_BF16,
+    GAUDI2_KERNEL_QUANTIZE_I8_CHANNEL_ZP_F32,
+    GAUDI2_KERNEL_QUANTIZE_I8_CHANNEL_ZP_BF16,
+    GAUDI2_KERNEL_DEQUANTIZE_I8_CHANNEL_ZP_F32,
+    GAUDI2_KERNEL_DEQUANTIZE_I8_CHANNEL_ZP_BF16,
+    GAUDI2_KERNEL_QUANTIZE_I8_DYNAMIC_F32,
+    GAUDI2_KERNEL_QUANTIZE_I8_DYNAMIC_BF16,
+    // CastAllGaudi2 (src, dst) pairs in CastAllGaudi2::GetPairIndex order,
+    // 7 types * 6 other types
+    GAUDI2_KERNEL_CAST_ALL_FIRST,
+    GAUDI2_KERNEL_CAST_ALL_LAST = GAUDI2_KERNEL_CAST_ALL_FIRST + 41,
+    GAUDI2_KERNEL_PERMUTE_F32,
+    GAUDI2_KERNEL_PERMUTE_I32,
+    GAUDI2_KERNEL_PERMUTE_BF16,
+    GAUDI2_KERNEL_PERMUTE_F16,
+    GAUDI2_KERNEL_PERMUTE_I8,
+    GAUDI2_KERNEL_PERMUTE_U8,
+    GAUDI2_KERNEL_PERMUTE_F8_143,
+    GAUDI2_KERNEL_PERMUTE_F8_152,
+    GAUDI2_KERNEL_BINARY_BROADCAST_F32,
+    GAUDI2_KERNEL_BINARY_BROADCAST_BF16,
+    GAUDI2_KERNEL_FUSED_ELEMENTWISE_F32_TO_F32,
+    GAUDI2_KERNEL_FUSED_ELEMENTWISE_F32_TO_BF16,
+    GAUDI2_KERNEL_FUSED_ELEMENTWISE_BF16_TO_F32,
+    GAUDI2_KERNEL_FUSED_ELEMENTWISE_BF16_TO_BF16,
+    GAUDI2_KERNEL_REDUCE_F32,
+    GAUDI2_KERNEL_REDUCE_BF16,
+    GAUDI2_KERNEL_TRANSCENDENTAL_COS,
+    GAUDI2_KERNEL_TRANSCENDENTAL_SINCOS,
+    GAUDI2_KERNEL_TRANSCENDENTAL_EXP,
+    GAUDI2_KERNEL_TRANSCENDENTAL_LOG,
+    GAUDI2_KERNEL_TRANSCENDENTAL_TANH,
+    GAUDI2_KERNEL_TRANSCENDENTAL_SIGMOID,
+    GAUDI2_KERNEL_TRANSCENDENTAL_RSQRT,
+    GAUDI2_KERNEL_TRANSCENDENTAL_ERF,
+    GAUDI2_KERNEL_RELU_FWD_MASK_F32,
+    GAUDI2_KERNEL_RELU_BWD_MASK_F32,
+    GAUDI2_KERNEL_RELU_FWD_MASK_BF16,
+    GAUDI2_KERNEL_RELU_BWD_MASK_BF16,
+    GAUDI2_KERNEL_DROPOUT_FWD_F32,
+    GAUDI2_KERNEL_DROPOUT_FWD_MASK_F32,
+    GAUDI2_KERNEL_DROPOUT_BWD_F32,
+    GAUDI2_KERNEL_DROPOUT_BWD_MASK_F32,
+    GAUDI2_KERNEL_DROPOUT_FWD_BF16,
+    GAUDI2_KERNEL_DROPOUT_FWD_MASK_BF16,
+    GAUDI2_KERNEL_DROPOUT_BWD_BF16,
+    GAUDI2_KERNEL_DROPOUT_BWD_MASK_BF16,
+    GAUDI2_KERNEL_PIECEWISE_POLY_F32,
+    GAUDI2_KERNEL_FUSED_ATTENTION_F32,
+    GAUDI2_KERNEL_FUSED_ATTENTION_KV_LENGTHS_F32,
+    GAUDI2_KERNEL_PAGED_KV_GATHER_BF16,
+    GAUDI2_KERNEL_PAGED_KV_GATHER_FP8,
+    GAUDI2_KERNEL_PAGED_KV_APPEND_BF16,
+    GAUDI2_KERNEL_PAGED_KV_APPEND_FP8,
 
     GAUDI2_KERNEL_MAX_EXAMPLE_KERNEL
 
@@ -80,6 +245,39 @@ typedef enum
     GAUDI3_KERNEL_PSCAN_BF16,
     GAUDI3_KERNEL_PSCAN_UPDATE_F32,
     GAUDI3_KERNEL_PSCAN_UPDATE_BF16,
+    GAUDI3_KERNEL_GELU_TANH_FWD_F32,
+    GAUDI3_KERNEL_GELU_TANH_FWD_BF16,
+    GAUDI3_KERNEL_GELU_TANH_BWD_F32,
+    GAUDI3_KERNEL_GELU_TANH_BWD_BF16,
+    GAUDI3_KERNEL_GELU_ERF_FWD_F32,
+    GAUDI3_KERNEL_GELU_ERF_FWD_BF16,
+    GAUDI3_KERNEL_GELU_ERF_BWD_F32,
+    GAUDI3_KERNEL_GELU_ERF_BWD_BF16,
+    GAUDI3_KERNEL_SILU_FWD_F32,
+    GAUDI3_KERNEL_SILU_FWD_BF16,
+    GAUDI3_KERNEL_SILU_BWD_F32,
+    GAUDI3_KERNEL_SILU_BWD_BF16,
+    GAUDI3_KERNEL_SWIGLU_FWD_F32,
+    GAUDI3_KERNEL_SWIGLU_FWD_BF16,
+    GAUDI3_KERNEL_SWIGLU_BWD_F32,
+    GAUDI3_KERNEL_SWIGLU_BWD_BF16,
+    GAUDI3_KERNEL_GEGLU_FWD_F32,
+    GAUDI3_KERNEL_GEGLU_FWD_BF16,
+    GAUDI3_KERNEL_GEGLU_BWD_F32,
+    GAUDI3_KERNEL_GEGLU_BWD_BF16,
+    GAUDI3_KERNEL_CAST_F32_TO_FP8_143,
+    GAUDI3_KERNEL_CAST_BF16_TO_FP8_143,
+    GAUDI3_KERNEL_CAST_F32_TO_FP8_152,
+    GAUDI3_KERNEL_CAST_BF16_TO_FP8_152,
+    GAUDI3_KERNEL_CAST_FP8_143_TO_F32,
+    GAUDI3_KERNEL_CAST_FP8_143_TO_BF16,
+    GAUDI3_KERNEL_CAST_FP8_152_TO_F32,
+    GAUDI3_KERNEL_CAST_FP8_152_TO_BF16,
+    // CastAllGaudi3 (src, dst) pairs in CastAllGaudi2::GetPairIndex order
+    GAUDI3_KERNEL_CAST_ALL_FIRST,
+    GAUDI3_KERNEL_CAST_ALL_LAST = GAUDI3_KERNEL_CAST_ALL_FIRST + 41,
+    GAUDI3_KERNEL_BINARY_BROADCAST_F32,
+    GAUDI3_KERNEL_BINARY_BROADCAST_BF16,
 
     GAUDI3_KERNEL_MAX_EXAMPLE_KERNEL
 
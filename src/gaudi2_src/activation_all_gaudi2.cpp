@@ -0,0 +1,312 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cstring>
+#include <cstdio>
+#include "activation_all_gaudi2.hpp"
+
+extern unsigned char _binary___gelu_tanh_fwd_f32_gaudi2_o_start;
+extern unsigned char _binary___gelu_tanh_fwd_f32_gaudi2_o_end;
+extern unsigned char _binary___gelu_tanh_fwd_bf16_gaudi2_o_start;
+extern unsigned char _binary___gelu_tanh_fwd_bf16_gaudi2_o_end;
+extern unsigned char _binary___gelu_tanh_bwd_f32_gaudi2_o_start;
+extern unsigned char _binary___gelu_tanh_bwd_f32_gaudi2_o_end;
+extern unsigned char _binary___gelu_tanh_bwd_bf16_gaudi2_o_start;
+extern unsigned char _binary___gelu_tanh_bwd_bf16_gaudi2_o_end;
+extern unsigned char _binary___gelu_erf_fwd_f32_gaudi2_o_start;
+extern unsigned char _binary___gelu_erf_fwd_f32_gaudi2_o_end;
+extern unsigned char _binary___gelu_erf_fwd_bf16_gaudi2_o_start;
+extern unsigned char _binary___gelu_erf_fwd_bf16_gaudi2_o_end;
+extern unsigned char _binary___gelu_erf_bwd_f32_gaudi2_o_start;
+extern unsigned char _binary___gelu_erf_bwd_f32_gaudi2_o_end;
+extern unsigned char _binary___gelu_erf_bwd_bf16_gaudi2_o_start;
+extern unsigned char _binary___gelu_erf_bwd_bf16_gaudi2_o_end;
+extern unsigned char _binary___silu_fwd_f32_gaudi2_o_start;
+extern unsigned char _binary___silu_fwd_f32_gaudi2_o_end;
+extern unsigned char _binary___silu_fwd_bf16_gaudi2_o_start;
+extern unsigned char _binary___silu_fwd_bf16_gaudi2_o_end;
+extern unsigned char _binary___silu_bwd_f32_gaudi2_o_start;
+extern unsigned char _binary___silu_bwd_f32_gaudi2_o_end;
+extern unsigned char _binary___silu_bwd_bf16_gaudi2_o_start;
+extern unsigned char _binary___silu_bwd_bf16_gaudi2_o_end;
+extern unsigned char _binary___swiglu_fwd_f32_gaudi2_o_start;
+extern unsigned char _binary___swiglu_fwd_f32_gaudi2_o_end;
+extern unsigned char _binary___swiglu_fwd_bf16_gaudi2_o_start;
+extern unsigned char _binary___swiglu_fwd_bf16_gaudi2_o_end;
+extern unsigned char _binary___swiglu_bwd_f32_gaudi2_o_start;
+extern unsigned char _binary___swiglu_bwd_f32_gaudi2_o_end;
+extern unsigned char _binary___swiglu_bwd_bf16_gaudi2_o_start;
+extern unsigned char _binary___swiglu_bwd_bf16_gaudi2_o_end;
+extern unsigned char _binary___geglu_fwd_f32_gaudi2_o_start;
+extern unsigned char _binary___geglu_fwd_f32_gaudi2_o_end;
+extern unsigned char _binary___geglu_fwd_bf16_gaudi2_o_start;
+extern unsigned char _binary___geglu_fwd_bf16_gaudi2_o_end;
+extern unsigned char _binary___geglu_bwd_f32_gaudi2_o_start;
+extern unsigned char _binary___geglu_bwd_f32_gaudi2_o_end;
+extern unsigned char _binary___geglu_bwd_bf16_gaudi2_o_start;
+extern unsigned char _binary___geglu_bwd_bf16_gaudi2_o_end;
+
+static const char* const c_activationModeNames[] = {
+    "gelu_tanh_fwd_f32",
+    "gelu_tanh_fwd_bf16",
+    "gelu_tanh_bwd_f32",
+    "gelu_tanh_bwd_bf16",
+    "gelu_erf_fwd_f32",
+    "gelu_erf_fwd_bf16",
+    "gelu_erf_bwd_f32",
+    "gelu_erf_bwd_bf16",
+    "silu_fwd_f32",
+    "silu_fwd_bf16",
+    "silu_bwd_f32",
+    "silu_bwd_bf16",
+    "swiglu_fwd_f32",
+    "swiglu_fwd_bf16",
+    "swiglu_bwd_f32",
+    "swiglu_bwd_bf16",
+    "geglu_fwd_f32",
+    "geglu_fwd_bf16",
+    "geglu_bwd_f32",
+    "geglu_bwd_bf16"
+};
+
+static unsigned char* const c_activationBinaries[][2] = {
+    {&_binary___gelu_tanh_fwd_f32_gaudi2_o_start, &_binary___gelu_tanh_fwd_f32_gaudi2_o_end},
+    {&_binary___gelu_tanh_fwd_bf16_gaudi2_o_start, &_binary___gelu_tanh_fwd_bf16_gaudi2_o_end},
+    {&_binary___gelu_tanh_bwd_f32_gaudi2_o_start, &_binary___gelu_tanh_bwd_f32_gaudi2_o_end},
+    {&_binary___gelu_tanh_bwd_bf16_gaudi2_o_start, &_binary___gelu_tanh_bwd_bf16_gaudi2_o_end},
+    {&_binary___gelu_erf_fwd_f32_gaudi2_o_start, &_binary___gelu_erf_fwd_f32_gaudi2_o_end},
+    {&_binary___gelu_erf_fwd_bf16_gaudi2_o_start, &_binary___gelu_erf_fwd_bf16_gaudi2_o_end},
+    {&_binary___gelu_erf_bwd_f32_gaudi2_o_start, &_binary___gelu_erf_bwd_f32_gaudi2_o_end},
+    {&_binary___gelu_erf_bwd_bf16_gaudi2_o_start, &_binary___gelu_erf_bwd_bf16_gaudi2_o_end},
+    {&_binary___silu_fwd_f32_gaudi2_o_start, &_binary___silu_fwd_f32_gaudi2_o_end},
+    {&_binary___silu_fwd_bf16_gaudi2_o_start, &_binary___silu_fwd_bf16_gaudi2_o_end},
+    {&_binary___silu_bwd_f32_gaudi2_o_start, &_binary___silu_bwd_f32_gaudi2_o_end},
+    {&_binary___silu_bwd_bf16_gaudi2_o_start, &_binary___silu_bwd_bf16_gaudi2_o_end},
+    {&_binary___swiglu_fwd_f32_gaudi2_o_start, &_binary___swiglu_fwd_f32_gaudi2_o_end},
+    {&_binary___swiglu_fwd_bf16_gaudi2_o_start, &_binary___swiglu_fwd_bf16_gaudi2_o_end},
+    {&_binary___swiglu_bwd_f32_gaudi2_o_start, &_binary___swiglu_bwd_f32_gaudi2_o_end},
+    {&_binary___swiglu_bwd_bf16_gaudi2_o_start, &_binary___swiglu_bwd_bf16_gaudi2_o_end},
+    {&_binary___geglu_fwd_f32_gaudi2_o_start, &_binary___geglu_fwd_f32_gaudi2_o_end},
+    {&_binary___geglu_fwd_bf16_gaudi2_o_start, &_binary___geglu_fwd_bf16_gaudi2_o_end},
+    {&_binary___geglu_bwd_f32_gaudi2_o_start, &_binary___geglu_bwd_f32_gaudi2_o_end},
+    {&_binary___geglu_bwd_bf16_gaudi2_o_start, &_binary___geglu_bwd_bf16_gaudi2_o_end}
+};
+
+const char* ActivationAllGaudi2::GetModeName(Activation_mode_t mode)
+{
+    return c_activationModeNames[mode];
+}
+
+tpc_lib_api::GlueCodeReturn ActivationAllGaudi2::GetKernelName(
+        char kernelName [tpc_lib_api::MAX_NODE_NAME], Activation_mode_t mode)
+{
+    if (mode >= activation_mode_count)
+        return tpc_lib_api::GLUE_NODE_NOT_FOUND;
+    snprintf(kernelName, tpc_lib_api::MAX_NODE_NAME, "custom_%s_gaudi2", GetModeName(mode));
+    return tpc_lib_api::GLUE_SUCCESS;
+}
+
+void ActivationAllGaudi2::GetKernelBinary(unsigned char** binary, unsigned* size)
+{
+    *binary = c_activationBinaries[m_mode][0];
+    *size = c_activationBinaries[m_mode][1] - c_activationBinaries[m_mode][0];
+}
+
+bool ActivationAllGaudi2::IsGated() const
+{
+    return m_mode >= swiglu_fwd_f32;
+}
+
+bool ActivationAllGaudi2::IsBackward() const
+{
+    // bwd modes are the second pair of every activation
+    return (m_mode % 4) >= 2;
+}
+
+bool ActivationAllGaudi2::IsBF16() const
+{
+    // bf16 modes follow their f32 twin in the enum
+    return (m_mode % 2) == 1;
+}
+
+tpc_lib_api::GlueCodeReturn ActivationAllGaudi2::GetGcDefinitions(
+        tpc_lib_api::HabanaKernelParams* in_defs,
+        tpc_lib_api::HabanaKernelInstantiation* out_defs)
+{
+    tpc_lib_api::GlueCodeReturn retVal;
+
+    // Tensor order is a convention between the TPC kernel writer and the
+    // framework layer writer:
+    //   fwd : ifm -> ofm
+    //   bwd : gradOut, ifm -> gradIn
+    // Gated modes take ifm = [gate | up] along dim 0, so ofm and gradOut
+    // are half as wide as ifm and gradIn.
+    const unsigned inputNr = IsBackward() ? 2 : 1;
+    const unsigned ifmIndex = IsBackward() ? 1 : 0;
+
+    /*************************************************************************************
+    *   Stage I - validate input
+    **************************************************************************************/
+    //validate correct amount of input tensors
+    if (in_defs->inputTensorNr != inputNr)
+    {
+        in_defs->inputTensorNr  = inputNr;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_COUNT;
+    }
+    //validate correct amount of output tensors
+    if (in_defs->outputTensorNr != 1)
+    {
+        in_defs->outputTensorNr  = 1;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_COUNT;
+    }
+
+    // validate input and output data type
+    const tpc_lib_api::TensorDataType dataType = IsBF16() ? tpc_lib_api::DATA_BF16 : tpc_lib_api::DATA_F32;
+    for (unsigned i = 0; i < inputNr; i++)
+    {
+        if (in_defs->inputTensors[i].geometry.dataType != dataType)
+        {
+            in_defs->inputTensors[i].geometry.dataType = dataType;
+            return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+        }
+    }
+    if (in_defs->outputTensors[0].geometry.dataType != dataType)
+    {
+        in_defs->outputTensors[0].geometry.dataType = dataType;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+    }
+
+    const tpc_lib_api::Tensor* ifm = &in_defs->inputTensors[ifmIndex];
+    const unsigned dims = ifm->geometry.dims;
+    if (dims < 1 || dims > gcapi::MAX_TENSOR_DIM)
+    {
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+    }
+
+    const int elementsInVec = IsBF16() ? 128 : 64;
+    uint64_t ifmSizes[gcapi::MAX_TENSOR_DIM] = {0};
+    uint64_t halfSizes[gcapi::MAX_TENSOR_DIM] = {0};
+    memcpy(ifmSizes, ifm->geometry.maxSizes, sizeof(ifmSizes));
+    memcpy(halfSizes, ifm->geometry.maxSizes, sizeof(halfSizes));
+    if (IsGated())
+    {
+        if (ifmSizes[0] % 2 != 0)
+        {
+            return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+        }
+        halfSizes[0] = ifmSizes[0] / 2;
+        // dgate and dup are stored by the same member at d and d + N, a
+        // partial dgate vector would overwrite the head of dup.
+        if (IsBackward() && (halfSizes[0] % elementsInVec) != 0)
+        {
+            return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+        }
+    }
+
+    // gradOut has the shape of ofm
+    if (IsBackward())
+    {
+        const tpc_lib_api::Tensor* gradOut = &in_defs->inputTensors[0];
+        if (gradOut->geometry.dims != dims ||
+            memcmp(gradOut->geometry.maxSizes, halfSizes, dims * sizeof(uint64_t)) != 0)
+        {
+            return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+        }
+    }
+
+    // verify that output feature map dimension are correct
+    const uint64_t* outputSizes = IsBackward() ? ifmSizes : halfSizes;
+    if (in_defs->outputTensors[0].geometry.dims != dims ||
+        memcmp(in_defs->outputTensors[0].geometry.maxSizes, outputSizes, dims * sizeof(uint64_t)) != 0)
+    {
+        memcpy(in_defs->outputTensors[0].geometry.maxSizes, outputSizes, sizeof(ifmSizes));
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_SIZE;
+    }
+
+    /*************************************************************************************
+    *    Stage II -  Define index space geometry. dim 0 is split into vectors of the
+    *    (gate) half, dim 1 is unrolled by c_unrollCount.
+    **************************************************************************************/
+    out_defs->indexSpaceRank = 5;
+    out_defs->indexSpaceGeometry[0] = (halfSizes[0] + (elementsInVec - 1)) / elementsInVec;
+    out_defs->indexSpaceGeometry[1] = dims > 1 ? (halfSizes[1] + (c_unrollCount - 1)) / c_unrollCount : 1;
+    for (unsigned dim = 2; dim < out_defs->indexSpaceRank; dim++)
+    {
+        out_defs->indexSpaceGeometry[dim] = dims > dim ? halfSizes[dim] : 1;
+    }
+
+    /*************************************************************************************
+    *    Stage III -  Define index space mapping
+    **************************************************************************************/
+    for (unsigned i = 0; i < inputNr + 1; i++)
+    {
+        bool isInput = i < inputNr;
+        tpc_lib_api::TensorAccessPattern* pattern = isInput ?
+                &out_defs->inputTensorAccessPattern[i] : &out_defs->outputTensorAccessPattern[0];
+        // ifm and gradIn hold both halves of a gated activation
+        bool bothHalves = IsGated() && (i == ifmIndex || !isInput);
+
+        // f_start f(i) = elementsInVec*i + 0;
+        // f_end   f(i) = elementsInVec*i + (elementsInVec - 1) [+ N for both halves]
+        pattern->mapping[0].indexSpaceDim = 0;
+        pattern->mapping[0].a             = elementsInVec;
+        pattern->mapping[0].start_b       = 0;
+        pattern->mapping[0].end_b         = elementsInVec - 1 + (bothHalves ? halfSizes[0] : 0);
+
+        // f_start f(i) = c_unrollCount*i + 0;
+        // f_end   f(i) = c_unrollCount*i + (c_unrollCount - 1);
+        pattern->mapping[1].indexSpaceDim = 1;
+        pattern->mapping[1].a             = c_unrollCount;
+        pattern->mapping[1].start_b       = 0;
+        pattern->mapping[1].end_b         = c_unrollCount - 1;
+
+        // f_start f(i) = 1*i + 0;
+        // f_end   f(i) = 1*i + 0;
+        for (unsigned dim = 2; dim < out_defs->indexSpaceRank; dim++)
+        {
+            pattern->mapping[dim].indexSpaceDim = dim;
+            pattern->mapping[dim].a             = 1;
+            pattern->mapping[dim].start_b       = 0;
+            pattern->mapping[dim].end_b         = 1 - 1;
+        }
+    }
+
+    /*************************************************************************************
+    *    Stage IV -  define scalar parameters
+    **************************************************************************************/
+    out_defs->kernel.paramsNr = 0;
+
+    /*************************************************************************************
+    *    Stage V -  Load ISA into the descriptor.
+    **************************************************************************************/
+    unsigned char* binary_kernel = nullptr;
+    unsigned IsaSize = 0;
+    GetKernelBinary(&binary_kernel, &IsaSize);
+
+    unsigned givenBinarySize = out_defs->kernel.elfSize;
+    out_defs->kernel.elfSize = IsaSize;
+    if (givenBinarySize >= IsaSize)
+    {
+        memcpy (out_defs->kernel.kernelElf, binary_kernel, IsaSize);
+    }
+    else
+    {
+        retVal = tpc_lib_api::GLUE_INSUFFICIENT_ELF_BUFFER;
+        return retVal;
+    }
+
+    return tpc_lib_api::GLUE_SUCCESS;
+}
@@ -0,0 +1,83 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef _ACTIVATION_ALL_GAUDI2_HPP
+#define _ACTIVATION_ALL_GAUDI2_HPP
+
+#include "gc_interface.h"
+#include "tpc_kernel_lib_interface.h"
+
+class ActivationAllGaudi2
+{
+public:
+    // Every activation has fwd/bwd x f32/bf16 modes, in that order.
+    typedef enum _Activation_mode_t
+    {
+        gelu_tanh_fwd_f32,
+        gelu_tanh_fwd_bf16,
+        gelu_tanh_bwd_f32,
+        gelu_tanh_bwd_bf16,
+        gelu_erf_fwd_f32,
+        gelu_erf_fwd_bf16,
+        gelu_erf_bwd_f32,
+        gelu_erf_bwd_bf16,
+        silu_fwd_f32,
+        silu_fwd_bf16,
+        silu_bwd_f32,
+        silu_bwd_bf16,
+        swiglu_fwd_f32,
+        swiglu_fwd_bf16,
+        swiglu_bwd_f32,
+        swiglu_bwd_bf16,
+        geglu_fwd_f32,
+        geglu_fwd_bf16,
+        geglu_bwd_f32,
+        geglu_bwd_bf16,
+        activation_mode_count
+    } Activation_mode_t;
+
+    ActivationAllGaudi2(Activation_mode_t mode=gelu_tanh_fwd_f32) {m_mode = mode;}
+    virtual ~ActivationAllGaudi2() {}
+
+    virtual tpc_lib_api::GlueCodeReturn GetGcDefinitions(
+            tpc_lib_api::HabanaKernelParams* in_defs,
+            tpc_lib_api::HabanaKernelInstantiation* out_defs);
+
+    virtual tpc_lib_api::GlueCodeReturn GetKernelName(
+            char kernelName [tpc_lib_api::MAX_NODE_NAME], Activation_mode_t mode);
+
+    // Rows (dim 1) handled by one index space member.
+    static const int c_unrollCount = 4;
+
+protected:
+    // "gelu_tanh_fwd_f32" etc., the device suffix is added by GetKernelName
+    static const char* GetModeName(Activation_mode_t mode);
+
+    // ISA of m_mode for the device this class instantiates kernels for
+    virtual void GetKernelBinary(unsigned char** binary, unsigned* size);
+
+    bool IsGated() const;
+    bool IsBackward() const;
+    bool IsBF16() const;
+
+    Activation_mode_t m_mode;
+
+private:
+    ActivationAllGaudi2(const ActivationAllGaudi2& other) = delete;
+    ActivationAllGaudi2& operator=(const ActivationAllGaudi2& other) = delete;
+};
+
+#endif //_ACTIVATION_ALL_GAUDI2_HPP
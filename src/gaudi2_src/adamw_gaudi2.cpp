@@ -0,0 +1,272 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cmath>
+#include <cstring>
+#include "adamw_gaudi2.hpp"
+
+extern unsigned char _binary___adamw_f32_gaudi2_o_start;
+extern unsigned char _binary___adamw_f32_gaudi2_o_end;
+extern unsigned char _binary___adamw_bf16_gaudi2_o_start;
+extern unsigned char _binary___adamw_bf16_gaudi2_o_end;
+extern unsigned char _binary___adamw_multi_f32_gaudi2_o_start;
+extern unsigned char _binary___adamw_multi_f32_gaudi2_o_end;
+extern unsigned char _binary___adamw_multi_bf16_gaudi2_o_start;
+extern unsigned char _binary___adamw_multi_bf16_gaudi2_o_end;
+
+static const char c_adamWKernelNames[][tpc_lib_api::MAX_NODE_NAME] = {
+    "custom_adamw_f32_gaudi2",
+    "custom_adamw_bf16_gaudi2",
+    "custom_adamw_multi_f32_gaudi2",
+    "custom_adamw_multi_bf16_gaudi2"
+};
+
+// vectors of dim 0 per index space member, ADAMW_VECTORS in the kernel
+static const int c_vectorsPerMember = 4;
+
+tpc_lib_api::GlueCodeReturn AdamWGaudi2::GetKernelName(
+        char kernelName [tpc_lib_api::MAX_NODE_NAME], AdamW_mode_t mode)
+{
+    if (mode > adamw_multi_bf16)
+        return tpc_lib_api::GLUE_NODE_NOT_FOUND;
+    strcpy(kernelName, c_adamWKernelNames[mode]);
+    return tpc_lib_api::GLUE_SUCCESS;
+}
+
+int AdamWGaudi2::ElementsPerMember(AdamW_mode_t mode)
+{
+    const bool bf16 = (mode == adamw_bf16 || mode == adamw_multi_bf16);
+    return (bf16 ? 128 : 64) * c_vectorsPerMember;
+}
+
+bool AdamWGaudi2::IsMultiTensor() const
+{
+    return m_mode == adamw_multi_f32 || m_mode == adamw_multi_bf16;
+}
+
+bool AdamWGaudi2::IsBF16() const
+{
+    return m_mode == adamw_bf16 || m_mode == adamw_multi_bf16;
+}
+
+tpc_lib_api::GlueCodeReturn AdamWGaudi2::GetGcDefinitions(
+        tpc_lib_api::HabanaKernelParams* in_defs,
+        tpc_lib_api::HabanaKernelInstantiation* out_defs)
+{
+    tpc_lib_api::GlueCodeReturn retVal;
+    AdamWParams* def = static_cast<AdamWParams*>(in_defs->nodeParams.nodeParams);
+
+    // Tensor order is a convention between the TPC kernel writer and the
+    // framework layer writer:
+    //   inputs  : grad, weights (f32, the master copy for bf16), m (f32), v (f32),
+    //             chunkDecay {numChunks} f32 (multi tensor modes)
+    //   outputs : weights, m, v (f32), params in bf16 (bf16 modes)
+    // Outputs may alias the matching inputs for an in-place step.
+
+    /*************************************************************************************
+    *   Stage I - validate input
+    **************************************************************************************/
+    const unsigned inputNr  = IsMultiTensor() ? 5 : 4;
+    const unsigned outputNr = IsBF16() ? 4 : 3;
+    //validate correct amount of input tensors
+    if (in_defs->inputTensorNr != inputNr)
+    {
+        in_defs->inputTensorNr  = inputNr;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_COUNT;
+    }
+    //validate correct amount of output tensors
+    if (in_defs->outputTensorNr != outputNr)
+    {
+        in_defs->outputTensorNr  = outputNr;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_COUNT;
+    }
+
+    if (def->step < 1 || def->beta1 < 0.0f || def->beta1 >= 1.0f ||
+        def->beta2 < 0.0f || def->beta2 >= 1.0f)
+    {
+        return tpc_lib_api::GLUE_UNSUPPORTED_LAYER_CONFIGURATION;
+    }
+
+    // validate input and output data type, everything but the gradient and
+    // the bf16 params is f32
+    const tpc_lib_api::TensorDataType dataType = IsBF16() ? tpc_lib_api::DATA_BF16 : tpc_lib_api::DATA_F32;
+    for (unsigned i = 0; i < inputNr + outputNr; i++)
+    {
+        const bool isInput = i < inputNr;
+        tpc_lib_api::Tensor* t = isInput ? &in_defs->inputTensors[i] : &in_defs->outputTensors[i - inputNr];
+        const bool isGradOrParam = (i == 0) || (i == inputNr + 3);
+        const tpc_lib_api::TensorDataType expected = isGradOrParam ? dataType : tpc_lib_api::DATA_F32;
+        if (t->geometry.dataType != expected)
+        {
+            t->geometry.dataType = expected;
+            return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+        }
+    }
+
+    const unsigned dims = in_defs->inputTensors[0].geometry.dims;
+    if (dims < 1 || dims > 4 || (IsMultiTensor() && dims != 1))
+    {
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+    }
+    uint64_t sizes[4] = {1, 1, 1, 1};
+    memcpy(sizes, in_defs->inputTensors[0].geometry.maxSizes, dims * sizeof(uint64_t));
+
+    // weights and moments match the gradient
+    for (unsigned i = 1; i < 4; i++)
+    {
+        const tpc_lib_api::Tensor& t = in_defs->inputTensors[i];
+        if (t.geometry.dims != dims ||
+            memcmp(t.geometry.maxSizes, sizes, dims * sizeof(uint64_t)) != 0)
+        {
+            return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+        }
+    }
+
+    // verify that output feature map dimension are correct
+    for (unsigned i = 0; i < outputNr; i++)
+    {
+        tpc_lib_api::Tensor& t = in_defs->outputTensors[i];
+        if (t.geometry.dims != dims ||
+            memcmp(t.geometry.maxSizes, sizes, dims * sizeof(uint64_t)) != 0)
+        {
+            memcpy(t.geometry.maxSizes, sizes, dims * sizeof(uint64_t));
+            return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_SIZE;
+        }
+    }
+
+    const int depthStep = ElementsPerMember(m_mode);
+    uint64_t numChunks = 0;
+    if (IsMultiTensor())
+    {
+        // a member never straddles two chunks
+        if (def->chunkSize <= 0 || def->chunkSize % depthStep != 0)
+        {
+            return tpc_lib_api::GLUE_UNSUPPORTED_LAYER_CONFIGURATION;
+        }
+        numChunks = (sizes[0] + def->chunkSize - 1) / def->chunkSize;
+        const tpc_lib_api::Tensor& chunkDecay = in_defs->inputTensors[4];
+        if (chunkDecay.geometry.dims != 1 || chunkDecay.geometry.maxSizes[0] != numChunks)
+        {
+            return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+        }
+    }
+
+    /*************************************************************************************
+    *    Stage II -  Define index space geometry. Elementwise, depthStep elements of dim 0
+    *    per member.
+    **************************************************************************************/
+    out_defs->indexSpaceRank = 4;
+    out_defs->indexSpaceGeometry[0] = (sizes[0] + depthStep - 1) / depthStep;
+    out_defs->indexSpaceGeometry[1] = sizes[1];
+    out_defs->indexSpaceGeometry[2] = sizes[2];
+    out_defs->indexSpaceGeometry[3] = sizes[3];
+
+    /*************************************************************************************
+    *    Stage III -  Define index space mapping
+    **************************************************************************************/
+    for (unsigned i = 0; i < inputNr + outputNr; i++)
+    {
+        tpc_lib_api::TensorAccessPattern* pattern = (i < inputNr) ?
+                &out_defs->inputTensorAccessPattern[i] : &out_defs->outputTensorAccessPattern[i - inputNr];
+
+        if (IsMultiTensor() && i == 4)
+        {
+            // f_start f(i) = 0;
+            // f_end   f(i) = numChunks - 1 (small table, read with scalar loads)
+            pattern->mapping[0].indexSpaceDim = 0;
+            pattern->mapping[0].a             = 0;
+            pattern->mapping[0].start_b       = 0;
+            pattern->mapping[0].end_b         = numChunks - 1;
+            continue;
+        }
+
+        // f_start f(i) = depthStep*i + 0;
+        // f_end   f(i) = depthStep*i + (depthStep - 1);
+        pattern->mapping[0].indexSpaceDim = 0;
+        pattern->mapping[0].a             = depthStep;
+        pattern->mapping[0].start_b       = 0;
+        pattern->mapping[0].end_b         = depthStep - 1;
+
+        // f_start f(i) = 1*i + 0;
+        // f_end   f(i) = 1*i + 0;
+        for (unsigned dim = 1; dim < 4; dim++)
+        {
+            pattern->mapping[dim].indexSpaceDim = dim;
+            pattern->mapping[dim].a             = 1;
+            pattern->mapping[dim].start_b       = 0;
+            pattern->mapping[dim].end_b         = 0;
+        }
+    }
+
+    /*************************************************************************************
+    *    Stage IV -  define scalar parameters
+    **************************************************************************************/
+    // bias corrections of step t are folded here
+    const float stepSize  = def->lr / (1.0f - powf(def->beta1, (float)def->step));
+    const float biasCorr2 = 1.0f / (1.0f - powf(def->beta2, (float)def->step));
+    const int32_t chunkSize = IsMultiTensor() ? def->chunkSize : 0;
+
+    out_defs->kernel.paramsNr = 8;
+    memcpy(&(out_defs->kernel.scalarParams[0]), &def->lr, sizeof(float));
+    memcpy(&(out_defs->kernel.scalarParams[1]), &def->beta1, sizeof(float));
+    memcpy(&(out_defs->kernel.scalarParams[2]), &def->beta2, sizeof(float));
+    memcpy(&(out_defs->kernel.scalarParams[3]), &def->eps, sizeof(float));
+    memcpy(&(out_defs->kernel.scalarParams[4]), &def->weightDecay, sizeof(float));
+    memcpy(&(out_defs->kernel.scalarParams[5]), &stepSize, sizeof(float));
+    memcpy(&(out_defs->kernel.scalarParams[6]), &biasCorr2, sizeof(float));
+    memcpy(&(out_defs->kernel.scalarParams[7]), &chunkSize, sizeof(int32_t));
+
+    /*************************************************************************************
+    *    Stage V -  Load ISA into the descriptor.
+    **************************************************************************************/
+    unsigned IsaSize = (&_binary___adamw_f32_gaudi2_o_end - &_binary___adamw_f32_gaudi2_o_start);
+    unsigned char *binary_kernel = &_binary___adamw_f32_gaudi2_o_start;
+    switch (m_mode)
+    {
+        case adamw_f32:
+            IsaSize = (&_binary___adamw_f32_gaudi2_o_end - &_binary___adamw_f32_gaudi2_o_start);
+            binary_kernel = &_binary___adamw_f32_gaudi2_o_start;
+            break;
+        case adamw_bf16:
+            IsaSize = (&_binary___adamw_bf16_gaudi2_o_end - &_binary___adamw_bf16_gaudi2_o_start);
+            binary_kernel = &_binary___adamw_bf16_gaudi2_o_start;
+            break;
+        case adamw_multi_f32:
+            IsaSize = (&_binary___adamw_multi_f32_gaudi2_o_end - &_binary___adamw_multi_f32_gaudi2_o_start);
+            binary_kernel = &_binary___adamw_multi_f32_gaudi2_o_start;
+            break;
+        case adamw_multi_bf16:
+            IsaSize = (&_binary___adamw_multi_bf16_gaudi2_o_end - &_binary___adamw_multi_bf16_gaudi2_o_start);
+            binary_kernel = &_binary___adamw_multi_bf16_gaudi2_o_start;
+            break;
+        default:
+            break;
+    }
+
+    unsigned givenBinarySize = out_defs->kernel.elfSize;
+    out_defs->kernel.elfSize = IsaSize;
+    if (givenBinarySize >= IsaSize)
+    {
+        memcpy (out_defs->kernel.kernelElf, binary_kernel, IsaSize);
+    }
+    else
+    {
+        retVal = tpc_lib_api::GLUE_INSUFFICIENT_ELF_BUFFER;
+        return retVal;
+    }
+
+    return tpc_lib_api::GLUE_SUCCESS;
+}
@@ -0,0 +1,71 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef _ADAMW_GAUDI2_HPP
+#define _ADAMW_GAUDI2_HPP
+
+#include "gc_interface.h"
+#include "tpc_kernel_lib_interface.h"
+
+class AdamWGaudi2
+{
+public:
+    typedef enum _AdamW_mode_t
+    {
+        adamw_f32,
+        adamw_bf16,
+        adamw_multi_f32,
+        adamw_multi_bf16
+    } AdamW_mode_t;
+
+    AdamWGaudi2(AdamW_mode_t mode=adamw_f32) {m_mode = mode;}
+    virtual ~AdamWGaudi2() {}
+
+    virtual tpc_lib_api::GlueCodeReturn GetGcDefinitions(
+            tpc_lib_api::HabanaKernelParams* in_defs,
+            tpc_lib_api::HabanaKernelInstantiation* out_defs);
+
+    virtual tpc_lib_api::GlueCodeReturn GetKernelName(
+            char kernelName [tpc_lib_api::MAX_NODE_NAME], AdamW_mode_t mode);
+
+    // This struct is common between the TPC kernel writer and the framework
+    // layer writer. The programmer who adds a new layer to the framework-backend
+    // is responsible to fill the structure with valid data.
+    struct AdamWParams
+    {
+        float   lr;
+        float   beta1;
+        float   beta2;
+        float   eps;
+        float   weightDecay;
+        int32_t step;       // 1 for the first update, drives the bias correction
+        int32_t chunkSize;  // multi tensor modes only
+    };
+
+    // Elements of dim 0 handled by one index space member, chunkSize of the
+    // multi tensor modes must be a multiple of it.
+    static int ElementsPerMember(AdamW_mode_t mode);
+
+private:
+    bool IsMultiTensor() const;
+    bool IsBF16() const;
+
+    AdamW_mode_t m_mode;
+    AdamWGaudi2(const AdamWGaudi2& other) = delete;
+    AdamWGaudi2& operator=(const AdamWGaudi2& other) = delete;
+};
+
+#endif //_ADAMW_GAUDI2_HPP
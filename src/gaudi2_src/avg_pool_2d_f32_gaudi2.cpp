@@ -18,6 +18,7 @@ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVE
 #include <cstring>
 #include <iostream>
 #include "avg_pool_2d_f32_gaudi2.hpp"
+#include "aux_tensor_store.hpp"
 
 extern unsigned char _binary___avg_pool_2d_fwd_f32_gaudi2_o_start;
 extern unsigned char _binary___avg_pool_2d_fwd_f32_gaudi2_o_end;
@@ -182,37 +183,14 @@ tpc_lib_api::GlueCodeReturn AvgPool2dF32Gaudi2::GetGcDefinitions(
     memcpy(&( out_defs->kernel.scalarParams[0]), def, sizeof(*def));
 
     const int maxWindowSize = def->srdef.kernel_h * def->srdef.kernel_w + 1;
-    out_defs->auxiliaryTensorNr = 1;
-    out_defs->auxiliaryTensors[0].geometry.dims = 1;
-    out_defs->auxiliaryTensors[0].geometry.maxSizes[0] = maxWindowSize;
-    out_defs->auxiliaryTensors[0].geometry.maxSizes[1] = 0;
-    out_defs->auxiliaryTensors[0].geometry.maxSizes[2] = 0;
-    out_defs->auxiliaryTensors[0].geometry.maxSizes[3] = 0;
-    out_defs->auxiliaryTensors[0].geometry.maxSizes[4] = 0;
-
-    out_defs->auxiliaryTensors[0].geometry.dataType = tpc_lib_api::DATA_F32;
-    
-    unsigned required_size = out_defs->auxiliaryTensors[0].geometry.maxSizes[0] * sizeof(float);
-    // Check whether required memory is allocated for auxiliary tensor
-    if (required_size > out_defs->auxiliaryTensors[0].bufferSize)
-    {
-        out_defs->auxiliaryTensors[0].bufferSize = required_size;
-        return tpc_lib_api::GLUE_INSUFFICIENT_AUX_BUFFER_SIZE;
-    }
-    out_defs->auxiliaryTensors[0].bufferSize = required_size;
-    if (out_defs->auxiliaryTensors[0].bufferSize >= required_size)
-    {
-        // fill aux 0 (for 1/x) with data
-        float* reciprocalTable = (float*)malloc(required_size);
-        fill_reciprocal_table(reciprocalTable, maxWindowSize);
-        // Initialize the auxiliary tensor with reduction_fcd_tab
-        out_defs->auxiliaryTensors[0].pData = reciprocalTable;
-        //memcpy(out_defs->auxiliaryTensors[0].pData, reciprocalTable, required_size);
-        //free(reciprocalTable);
-    }
-    else
+    // the 1/x table depends on the window size only, every avg pool node with
+    // the same window shares it
+    retVal = AuxTensorStore::FillF32Aux(out_defs, "reciprocal_tab", &maxWindowSize, sizeof(maxWindowSize),
+                                        maxWindowSize, [this](void* data, unsigned size)
+                                        { fill_reciprocal_table((float*)data, size / sizeof(float)); });
+    if (retVal != tpc_lib_api::GLUE_SUCCESS)
     {
-        return tpc_lib_api::GLUE_INSUFFICIENT_AUX_BUFFER_SIZE;
+        return retVal;
     }
 
     /*************************************************************************************
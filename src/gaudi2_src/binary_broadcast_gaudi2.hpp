@@ -0,0 +1,41 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef _BINARY_BROADCAST_GAUDI2_HPP
+#define _BINARY_BROADCAST_GAUDI2_HPP
+
+#include "binary_broadcast.hpp"
+
+// Gaudi2 builds of the broadcasting binary ops, the glue code is shared with
+// BinaryBroadcast.
+class BinaryBroadcastGaudi2 : public BinaryBroadcast
+{
+public:
+    BinaryBroadcastGaudi2(BinaryBroadcast_mode_t mode=binary_broadcast_f32) : BinaryBroadcast(mode) {}
+    virtual ~BinaryBroadcastGaudi2() {}
+
+    virtual tpc_lib_api::GlueCodeReturn GetKernelName(
+            char kernelName [tpc_lib_api::MAX_NODE_NAME], BinaryBroadcast_mode_t mode);
+
+protected:
+    virtual void GetKernelBinary(BinaryOp_t op, unsigned char** binary, unsigned* size);
+
+private:
+    BinaryBroadcastGaudi2(const BinaryBroadcastGaudi2& other) = delete;
+    BinaryBroadcastGaudi2& operator=(const BinaryBroadcastGaudi2& other) = delete;
+};
+
+#endif //_BINARY_BROADCAST_GAUDI2_HPP
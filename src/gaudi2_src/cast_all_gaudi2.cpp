@@ -0,0 +1,345 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cstring>
+#include <cstdio>
+#include "cast_all_gaudi2.hpp"
+
+extern unsigned char _binary___cast_all_f32_to_bf16_gaudi2_o_start;
+extern unsigned char _binary___cast_all_f32_to_bf16_gaudi2_o_end;
+extern unsigned char _binary___cast_all_f32_to_f16_gaudi2_o_start;
+extern unsigned char _binary___cast_all_f32_to_f16_gaudi2_o_end;
+extern unsigned char _binary___cast_all_f32_to_i32_gaudi2_o_start;
+extern unsigned char _binary___cast_all_f32_to_i32_gaudi2_o_end;
+extern unsigned char _binary___cast_all_f32_to_i16_gaudi2_o_start;
+extern unsigned char _binary___cast_all_f32_to_i16_gaudi2_o_end;
+extern unsigned char _binary___cast_all_f32_to_i8_gaudi2_o_start;
+extern unsigned char _binary___cast_all_f32_to_i8_gaudi2_o_end;
+extern unsigned char _binary___cast_all_f32_to_u8_gaudi2_o_start;
+extern unsigned char _binary___cast_all_f32_to_u8_gaudi2_o_end;
+extern unsigned char _binary___cast_all_bf16_to_f32_gaudi2_o_start;
+extern unsigned char _binary___cast_all_bf16_to_f32_gaudi2_o_end;
+extern unsigned char _binary___cast_all_bf16_to_f16_gaudi2_o_start;
+extern unsigned char _binary___cast_all_bf16_to_f16_gaudi2_o_end;
+extern unsigned char _binary___cast_all_bf16_to_i32_gaudi2_o_start;
+extern unsigned char _binary___cast_all_bf16_to_i32_gaudi2_o_end;
+extern unsigned char _binary___cast_all_bf16_to_i16_gaudi2_o_start;
+extern unsigned char _binary___cast_all_bf16_to_i16_gaudi2_o_end;
+extern unsigned char _binary___cast_all_bf16_to_i8_gaudi2_o_start;
+extern unsigned char _binary___cast_all_bf16_to_i8_gaudi2_o_end;
+extern unsigned char _binary___cast_all_bf16_to_u8_gaudi2_o_start;
+extern unsigned char _binary___cast_all_bf16_to_u8_gaudi2_o_end;
+extern unsigned char _binary___cast_all_f16_to_f32_gaudi2_o_start;
+extern unsigned char _binary___cast_all_f16_to_f32_gaudi2_o_end;
+extern unsigned char _binary___cast_all_f16_to_bf16_gaudi2_o_start;
+extern unsigned char _binary___cast_all_f16_to_bf16_gaudi2_o_end;
+extern unsigned char _binary___cast_all_f16_to_i32_gaudi2_o_start;
+extern unsigned char _binary___cast_all_f16_to_i32_gaudi2_o_end;
+extern unsigned char _binary___cast_all_f16_to_i16_gaudi2_o_start;
+extern unsigned char _binary___cast_all_f16_to_i16_gaudi2_o_end;
+extern unsigned char _binary___cast_all_f16_to_i8_gaudi2_o_start;
+extern unsigned char _binary___cast_all_f16_to_i8_gaudi2_o_end;
+extern unsigned char _binary___cast_all_f16_to_u8_gaudi2_o_start;
+extern unsigned char _binary___cast_all_f16_to_u8_gaudi2_o_end;
+extern unsigned char _binary___cast_all_i32_to_f32_gaudi2_o_start;
+extern unsigned char _binary___cast_all_i32_to_f32_gaudi2_o_end;
+extern unsigned char _binary___cast_all_i32_to_bf16_gaudi2_o_start;
+extern unsigned char _binary___cast_all_i32_to_bf16_gaudi2_o_end;
+extern unsigned char _binary___cast_all_i32_to_f16_gaudi2_o_start;
+extern unsigned char _binary___cast_all_i32_to_f16_gaudi2_o_end;
+extern unsigned char _binary___cast_all_i32_to_i16_gaudi2_o_start;
+extern unsigned char _binary___cast_all_i32_to_i16_gaudi2_o_end;
+extern unsigned char _binary___cast_all_i32_to_i8_gaudi2_o_start;
+extern unsigned char _binary___cast_all_i32_to_i8_gaudi2_o_end;
+extern unsigned char _binary___cast_all_i32_to_u8_gaudi2_o_start;
+extern unsigned char _binary___cast_all_i32_to_u8_gaudi2_o_end;
+extern unsigned char _binary___cast_all_i16_to_f32_gaudi2_o_start;
+extern unsigned char _binary___cast_all_i16_to_f32_gaudi2_o_end;
+extern unsigned char _binary___cast_all_i16_to_bf16_gaudi2_o_start;
+extern unsigned char _binary___cast_all_i16_to_bf16_gaudi2_o_end;
+extern unsigned char _binary___cast_all_i16_to_f16_gaudi2_o_start;
+extern unsigned char _binary___cast_all_i16_to_f16_gaudi2_o_end;
+extern unsigned char _binary___cast_all_i16_to_i32_gaudi2_o_start;
+extern unsigned char _binary___cast_all_i16_to_i32_gaudi2_o_end;
+extern unsigned char _binary___cast_all_i16_to_i8_gaudi2_o_start;
+extern unsigned char _binary___cast_all_i16_to_i8_gaudi2_o_end;
+extern unsigned char _binary___cast_all_i16_to_u8_gaudi2_o_start;
+extern unsigned char _binary___cast_all_i16_to_u8_gaudi2_o_end;
+extern unsigned char _binary___cast_all_i8_to_f32_gaudi2_o_start;
+extern unsigned char _binary___cast_all_i8_to_f32_gaudi2_o_end;
+extern unsigned char _binary___cast_all_i8_to_bf16_gaudi2_o_start;
+extern unsigned char _binary___cast_all_i8_to_bf16_gaudi2_o_end;
+extern unsigned char _binary___cast_all_i8_to_f16_gaudi2_o_start;
+extern unsigned char _binary___cast_all_i8_to_f16_gaudi2_o_end;
+extern unsigned char _binary___cast_all_i8_to_i32_gaudi2_o_start;
+extern unsigned char _binary___cast_all_i8_to_i32_gaudi2_o_end;
+extern unsigned char _binary___cast_all_i8_to_i16_gaudi2_o_start;
+extern unsigned char _binary___cast_all_i8_to_i16_gaudi2_o_end;
+extern unsigned char _binary___cast_all_i8_to_u8_gaudi2_o_start;
+extern unsigned char _binary___cast_all_i8_to_u8_gaudi2_o_end;
+extern unsigned char _binary___cast_all_u8_to_f32_gaudi2_o_start;
+extern unsigned char _binary___cast_all_u8_to_f32_gaudi2_o_end;
+extern unsigned char _binary___cast_all_u8_to_bf16_gaudi2_o_start;
+extern unsigned char _binary___cast_all_u8_to_bf16_gaudi2_o_end;
+extern unsigned char _binary___cast_all_u8_to_f16_gaudi2_o_start;
+extern unsigned char _binary___cast_all_u8_to_f16_gaudi2_o_end;
+extern unsigned char _binary___cast_all_u8_to_i32_gaudi2_o_start;
+extern unsigned char _binary___cast_all_u8_to_i32_gaudi2_o_end;
+extern unsigned char _binary___cast_all_u8_to_i16_gaudi2_o_start;
+extern unsigned char _binary___cast_all_u8_to_i16_gaudi2_o_end;
+extern unsigned char _binary___cast_all_u8_to_i8_gaudi2_o_start;
+extern unsigned char _binary___cast_all_u8_to_i8_gaudi2_o_end;
+
+// [src][dst], nothing is built for src == dst
+static unsigned char* const c_castAllBinaries[CastAllGaudi2::cast_type_count]
+                                             [CastAllGaudi2::cast_type_count][2] = {
+    {
+        {nullptr, nullptr},
+        {&_binary___cast_all_f32_to_bf16_gaudi2_o_start, &_binary___cast_all_f32_to_bf16_gaudi2_o_end},
+        {&_binary___cast_all_f32_to_f16_gaudi2_o_start, &_binary___cast_all_f32_to_f16_gaudi2_o_end},
+        {&_binary___cast_all_f32_to_i32_gaudi2_o_start, &_binary___cast_all_f32_to_i32_gaudi2_o_end},
+        {&_binary___cast_all_f32_to_i16_gaudi2_o_start, &_binary___cast_all_f32_to_i16_gaudi2_o_end},
+        {&_binary___cast_all_f32_to_i8_gaudi2_o_start, &_binary___cast_all_f32_to_i8_gaudi2_o_end},
+        {&_binary___cast_all_f32_to_u8_gaudi2_o_start, &_binary___cast_all_f32_to_u8_gaudi2_o_end}
+    },
+    {
+        {&_binary___cast_all_bf16_to_f32_gaudi2_o_start, &_binary___cast_all_bf16_to_f32_gaudi2_o_end},
+        {nullptr, nullptr},
+        {&_binary___cast_all_bf16_to_f16_gaudi2_o_start, &_binary___cast_all_bf16_to_f16_gaudi2_o_end},
+        {&_binary___cast_all_bf16_to_i32_gaudi2_o_start, &_binary___cast_all_bf16_to_i32_gaudi2_o_end},
+        {&_binary___cast_all_bf16_to_i16_gaudi2_o_start, &_binary___cast_all_bf16_to_i16_gaudi2_o_end},
+        {&_binary___cast_all_bf16_to_i8_gaudi2_o_start, &_binary___cast_all_bf16_to_i8_gaudi2_o_end},
+        {&_binary___cast_all_bf16_to_u8_gaudi2_o_start, &_binary___cast_all_bf16_to_u8_gaudi2_o_end}
+    },
+    {
+        {&_binary___cast_all_f16_to_f32_gaudi2_o_start, &_binary___cast_all_f16_to_f32_gaudi2_o_end},
+        {&_binary___cast_all_f16_to_bf16_gaudi2_o_start, &_binary___cast_all_f16_to_bf16_gaudi2_o_end},
+        {nullptr, nullptr},
+        {&_binary___cast_all_f16_to_i32_gaudi2_o_start, &_binary___cast_all_f16_to_i32_gaudi2_o_end},
+        {&_binary___cast_all_f16_to_i16_gaudi2_o_start, &_binary___cast_all_f16_to_i16_gaudi2_o_end},
+        {&_binary___cast_all_f16_to_i8_gaudi2_o_start, &_binary___cast_all_f16_to_i8_gaudi2_o_end},
+        {&_binary___cast_all_f16_to_u8_gaudi2_o_start, &_binary___cast_all_f16_to_u8_gaudi2_o_end}
+    },
+    {
+        {&_binary___cast_all_i32_to_f32_gaudi2_o_start, &_binary___cast_all_i32_to_f32_gaudi2_o_end},
+        {&_binary___cast_all_i32_to_bf16_gaudi2_o_start, &_binary___cast_all_i32_to_bf16_gaudi2_o_end},
+        {&_binary___cast_all_i32_to_f16_gaudi2_o_start, &_binary___cast_all_i32_to_f16_gaudi2_o_end},
+        {nullptr, nullptr},
+        {&_binary___cast_all_i32_to_i16_gaudi2_o_start, &_binary___cast_all_i32_to_i16_gaudi2_o_end},
+        {&_binary___cast_all_i32_to_i8_gaudi2_o_start, &_binary___cast_all_i32_to_i8_gaudi2_o_end},
+        {&_binary___cast_all_i32_to_u8_gaudi2_o_start, &_binary___cast_all_i32_to_u8_gaudi2_o_end}
+    },
+    {
+        {&_binary___cast_all_i16_to_f32_gaudi2_o_start, &_binary___cast_all_i16_to_f32_gaudi2_o_end},
+        {&_binary___cast_all_i16_to_bf16_gaudi2_o_start, &_binary___cast_all_i16_to_bf16_gaudi2_o_end},
+        {&_binary___cast_all_i16_to_f16_gaudi2_o_start, &_binary___cast_all_i16_to_f16_gaudi2_o_end},
+        {&_binary___cast_all_i16_to_i32_gaudi2_o_start, &_binary___cast_all_i16_to_i32_gaudi2_o_end},
+        {nullptr, nullptr},
+        {&_binary___cast_all_i16_to_i8_gaudi2_o_start, &_binary___cast_all_i16_to_i8_gaudi2_o_end},
+        {&_binary___cast_all_i16_to_u8_gaudi2_o_start, &_binary___cast_all_i16_to_u8_gaudi2_o_end}
+    },
+    {
+        {&_binary___cast_all_i8_to_f32_gaudi2_o_start, &_binary___cast_all_i8_to_f32_gaudi2_o_end},
+        {&_binary___cast_all_i8_to_bf16_gaudi2_o_start, &_binary___cast_all_i8_to_bf16_gaudi2_o_end},
+        {&_binary___cast_all_i8_to_f16_gaudi2_o_start, &_binary___cast_all_i8_to_f16_gaudi2_o_end},
+        {&_binary___cast_all_i8_to_i32_gaudi2_o_start, &_binary___cast_all_i8_to_i32_gaudi2_o_end},
+        {&_binary___cast_all_i8_to_i16_gaudi2_o_start, &_binary___cast_all_i8_to_i16_gaudi2_o_end},
+        {nullptr, nullptr},
+        {&_binary___cast_all_i8_to_u8_gaudi2_o_start, &_binary___cast_all_i8_to_u8_gaudi2_o_end}
+    },
+    {
+        {&_binary___cast_all_u8_to_f32_gaudi2_o_start, &_binary___cast_all_u8_to_f32_gaudi2_o_end},
+        {&_binary___cast_all_u8_to_bf16_gaudi2_o_start, &_binary___cast_all_u8_to_bf16_gaudi2_o_end},
+        {&_binary___cast_all_u8_to_f16_gaudi2_o_start, &_binary___cast_all_u8_to_f16_gaudi2_o_end},
+        {&_binary___cast_all_u8_to_i32_gaudi2_o_start, &_binary___cast_all_u8_to_i32_gaudi2_o_end},
+        {&_binary___cast_all_u8_to_i16_gaudi2_o_start, &_binary___cast_all_u8_to_i16_gaudi2_o_end},
+        {&_binary___cast_all_u8_to_i8_gaudi2_o_start, &_binary___cast_all_u8_to_i8_gaudi2_o_end},
+        {nullptr, nullptr}
+    }
+};
+
+static const char* const c_castTypeNames[] = {
+    "f32",
+    "bf16",
+    "f16",
+    "i32",
+    "i16",
+    "i8",
+    "u8"
+};
+
+static const tpc_lib_api::TensorDataType c_castDataTypes[] = {
+    tpc_lib_api::DATA_F32,
+    tpc_lib_api::DATA_BF16,
+    tpc_lib_api::DATA_F16,
+    tpc_lib_api::DATA_I32,
+    tpc_lib_api::DATA_I16,
+    tpc_lib_api::DATA_I8,
+    tpc_lib_api::DATA_U8
+};
+
+const char* CastAllGaudi2::GetTypeName(CastType_t type)
+{
+    return c_castTypeNames[type];
+}
+
+tpc_lib_api::TensorDataType CastAllGaudi2::GetDataType(CastType_t type)
+{
+    return c_castDataTypes[type];
+}
+
+int CastAllGaudi2::GetPairIndex(CastType_t src, CastType_t dst)
+{
+    if (src == dst)
+        return -1;
+    return src * (cast_type_count - 1) + (dst < src ? dst : dst - 1);
+}
+
+tpc_lib_api::GlueCodeReturn CastAllGaudi2::GetKernelName(
+        char kernelName [tpc_lib_api::MAX_NODE_NAME], CastType_t src, CastType_t dst)
+{
+    if (src >= cast_type_count || dst >= cast_type_count || src == dst)
+        return tpc_lib_api::GLUE_NODE_NOT_FOUND;
+    snprintf(kernelName, tpc_lib_api::MAX_NODE_NAME, "custom_cast_all_%s_to_%s_gaudi2",
+             GetTypeName(src), GetTypeName(dst));
+    return tpc_lib_api::GLUE_SUCCESS;
+}
+
+void CastAllGaudi2::GetKernelBinary(unsigned char** binary, unsigned* size)
+{
+    *binary = c_castAllBinaries[m_src][m_dst][0];
+    *size = c_castAllBinaries[m_src][m_dst][1] - c_castAllBinaries[m_src][m_dst][0];
+}
+
+tpc_lib_api::GlueCodeReturn CastAllGaudi2::GetGcDefinitions(
+        tpc_lib_api::HabanaKernelParams* in_defs,
+        tpc_lib_api::HabanaKernelInstantiation* out_defs)
+{
+    tpc_lib_api::GlueCodeReturn retVal;
+
+    /*************************************************************************************
+    *   Stage I - validate input
+    **************************************************************************************/
+    if (m_src >= cast_type_count || m_dst >= cast_type_count || m_src == m_dst)
+    {
+        return tpc_lib_api::GLUE_NODE_NOT_FOUND;
+    }
+
+    //validate correct amount of input tensors
+    if (in_defs->inputTensorNr != 1)
+    {
+        in_defs->inputTensorNr  = 1;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_COUNT;
+    }
+    //validate correct amount of output tensors
+    if (in_defs->outputTensorNr != 1)
+    {
+        in_defs->outputTensorNr  = 1;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_COUNT;
+    }
+
+    // validate input and output data type
+    if (in_defs->inputTensors[0].geometry.dataType != GetDataType(m_src))
+    {
+        in_defs->inputTensors[0].geometry.dataType = GetDataType(m_src);
+        return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+    }
+    if (in_defs->outputTensors[0].geometry.dataType != GetDataType(m_dst))
+    {
+        in_defs->outputTensors[0].geometry.dataType = GetDataType(m_dst);
+        return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+    }
+
+    const tpc_lib_api::Tensor* ifm = &in_defs->inputTensors[0];
+    const unsigned dims = ifm->geometry.dims;
+    if (dims < 1 || dims > gcapi::MAX_TENSOR_DIM)
+    {
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+    }
+    uint64_t ifmSizes[gcapi::MAX_TENSOR_DIM] = {0};
+    memcpy(ifmSizes, ifm->geometry.maxSizes, dims * sizeof(uint64_t));
+
+    // verify that output feature map dimension are correct
+    if (in_defs->outputTensors[0].geometry.dims != dims ||
+        memcmp(in_defs->outputTensors[0].geometry.maxSizes, ifmSizes, dims * sizeof(uint64_t)) != 0)
+    {
+        in_defs->outputTensors[0].geometry.dims = dims;
+        memcpy(in_defs->outputTensors[0].geometry.maxSizes, ifmSizes, sizeof(ifmSizes));
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_SIZE;
+    }
+
+    /*************************************************************************************
+    *    Stage II -  Define index space geometry. Elementwise, 256 elements of dim 0
+    *    per member.
+    **************************************************************************************/
+    out_defs->indexSpaceRank = gcapi::MAX_TENSOR_DIM;
+    out_defs->indexSpaceGeometry[0] = (ifmSizes[0] + c_elementsPerMember - 1) / c_elementsPerMember;
+    for (unsigned dim = 1; dim < out_defs->indexSpaceRank; dim++)
+    {
+        out_defs->indexSpaceGeometry[dim] = dims > dim ? ifmSizes[dim] : 1;
+    }
+
+    /*************************************************************************************
+    *    Stage III -  Define index space mapping
+    **************************************************************************************/
+    tpc_lib_api::TensorAccessPattern* patterns[2] = {
+            &out_defs->inputTensorAccessPattern[0], &out_defs->outputTensorAccessPattern[0]};
+    for (unsigned i = 0; i < 2; i++)
+    {
+        // f_start f(i) = c_elementsPerMember*i + 0;
+        // f_end   f(i) = c_elementsPerMember*i + (c_elementsPerMember - 1);
+        patterns[i]->mapping[0].indexSpaceDim = 0;
+        patterns[i]->mapping[0].a             = c_elementsPerMember;
+        patterns[i]->mapping[0].start_b       = 0;
+        patterns[i]->mapping[0].end_b         = c_elementsPerMember - 1;
+
+        // f_start f(i) = 1*i + 0;
+        // f_end   f(i) = 1*i + 0;
+        for (unsigned dim = 1; dim < out_defs->indexSpaceRank; dim++)
+        {
+            patterns[i]->mapping[dim].indexSpaceDim = dim;
+            patterns[i]->mapping[dim].a             = 1;
+            patterns[i]->mapping[dim].start_b       = 0;
+            patterns[i]->mapping[dim].end_b         = 0;
+        }
+    }
+
+    /*************************************************************************************
+    *    Stage IV -  define scalar parameters
+    **************************************************************************************/
+    out_defs->kernel.paramsNr = 0;
+
+    /*************************************************************************************
+    *    Stage V -  Load ISA into the descriptor.
+    **************************************************************************************/
+    unsigned char* binary_kernel = nullptr;
+    unsigned IsaSize = 0;
+    GetKernelBinary(&binary_kernel, &IsaSize);
+
+    unsigned givenBinarySize = out_defs->kernel.elfSize;
+    out_defs->kernel.elfSize = IsaSize;
+    if (givenBinarySize >= IsaSize)
+    {
+        memcpy (out_defs->kernel.kernelElf, binary_kernel, IsaSize);
+    }
+    else
+    {
+        retVal = tpc_lib_api::GLUE_INSUFFICIENT_ELF_BUFFER;
+        return retVal;
+    }
+
+    return tpc_lib_api::GLUE_SUCCESS;
+}
@@ -0,0 +1,84 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef _CAST_ALL_GAUDI2_HPP
+#define _CAST_ALL_GAUDI2_HPP
+
+#include "gc_interface.h"
+#include "tpc_kernel_lib_interface.h"
+
+// Casts between any two of f32, bf16, f16, i32, i16, i8 and u8, one binary
+// of kernels/include/cast_all.h per (src, dst) pair.
+//   float -> float : round half to even
+//   any   -> int   : round half to even, saturated to the integer range
+class CastAllGaudi2
+{
+public:
+    // order of the types in the (src, dst) tables
+    typedef enum _CastType_t
+    {
+        cast_f32,
+        cast_bf16,
+        cast_f16,
+        cast_i32,
+        cast_i16,
+        cast_i8,
+        cast_u8,
+        cast_type_count
+    } CastType_t;
+
+    // every (src, dst) pair with src != dst, row major by src
+    static const int c_pairCount = cast_type_count * (cast_type_count - 1);
+
+    CastAllGaudi2(CastType_t src=cast_f32, CastType_t dst=cast_bf16) {m_src = src; m_dst = dst;}
+    virtual ~CastAllGaudi2() {}
+
+    virtual tpc_lib_api::GlueCodeReturn GetGcDefinitions(
+            tpc_lib_api::HabanaKernelParams* in_defs,
+            tpc_lib_api::HabanaKernelInstantiation* out_defs);
+
+    virtual tpc_lib_api::GlueCodeReturn GetKernelName(
+            char kernelName [tpc_lib_api::MAX_NODE_NAME], CastType_t src, CastType_t dst);
+
+    // position of (src, dst) in the pair order, -1 for src == dst
+    static int GetPairIndex(CastType_t src, CastType_t dst);
+    static CastType_t GetPairSrc(int pair) { return (CastType_t)(pair / (cast_type_count - 1)); }
+    static CastType_t GetPairDst(int pair)
+    {
+        int dst = pair % (cast_type_count - 1);
+        return (CastType_t)(dst < GetPairSrc(pair) ? dst : dst + 1);
+    }
+
+    // "f32", "bf16" etc. as used in the kernel names
+    static const char* GetTypeName(CastType_t type);
+    static tpc_lib_api::TensorDataType GetDataType(CastType_t type);
+
+    // elements of dim 0 per index space member, one 8 bit vector
+    static const int c_elementsPerMember = 256;
+
+protected:
+    // ISA of (m_src, m_dst) for the device this class instantiates kernels for
+    virtual void GetKernelBinary(unsigned char** binary, unsigned* size);
+
+    CastType_t m_src;
+    CastType_t m_dst;
+
+private:
+    CastAllGaudi2(const CastAllGaudi2& other) = delete;
+    CastAllGaudi2& operator=(const CastAllGaudi2& other) = delete;
+};
+
+#endif //_CAST_ALL_GAUDI2_HPP
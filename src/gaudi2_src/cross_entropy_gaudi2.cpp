@@ -0,0 +1,291 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cstring>
+#include "cross_entropy_gaudi2.hpp"
+
+extern unsigned char _binary___cross_entropy_fwd_f32_gaudi2_o_start;
+extern unsigned char _binary___cross_entropy_fwd_f32_gaudi2_o_end;
+extern unsigned char _binary___cross_entropy_fwd_bf16_gaudi2_o_start;
+extern unsigned char _binary___cross_entropy_fwd_bf16_gaudi2_o_end;
+extern unsigned char _binary___cross_entropy_bwd_f32_gaudi2_o_start;
+extern unsigned char _binary___cross_entropy_bwd_f32_gaudi2_o_end;
+extern unsigned char _binary___cross_entropy_bwd_bf16_gaudi2_o_start;
+extern unsigned char _binary___cross_entropy_bwd_bf16_gaudi2_o_end;
+
+static const char c_crossEntropyKernelNames[][tpc_lib_api::MAX_NODE_NAME] = {
+    "custom_cross_entropy_fwd_f32_gaudi2",
+    "custom_cross_entropy_fwd_bf16_gaudi2",
+    "custom_cross_entropy_bwd_f32_gaudi2",
+    "custom_cross_entropy_bwd_bf16_gaudi2"
+};
+
+// vectors of dim 0 per backward index space member, CE_BWD_VECTORS in the kernel
+static const int c_bwdVectorsPerMember = 4;
+
+tpc_lib_api::GlueCodeReturn CrossEntropyGaudi2::GetKernelName(
+        char kernelName [tpc_lib_api::MAX_NODE_NAME], CrossEntropy_mode_t mode)
+{
+    if (mode > cross_entropy_bwd_bf16)
+        return tpc_lib_api::GLUE_NODE_NOT_FOUND;
+    strcpy(kernelName, c_crossEntropyKernelNames[mode]);
+    return tpc_lib_api::GLUE_SUCCESS;
+}
+
+bool CrossEntropyGaudi2::IsBackward() const
+{
+    return m_mode == cross_entropy_bwd_f32 || m_mode == cross_entropy_bwd_bf16;
+}
+
+bool CrossEntropyGaudi2::IsBF16() const
+{
+    return m_mode == cross_entropy_fwd_bf16 || m_mode == cross_entropy_bwd_bf16;
+}
+
+static bool IsRowVector(const tpc_lib_api::Tensor& tensor, uint64_t size)
+{
+    return tensor.geometry.dims == 1 && tensor.geometry.maxSizes[0] == size;
+}
+
+tpc_lib_api::GlueCodeReturn CrossEntropyGaudi2::GetGcDefinitions(
+        tpc_lib_api::HabanaKernelParams* in_defs,
+        tpc_lib_api::HabanaKernelInstantiation* out_defs)
+{
+    tpc_lib_api::GlueCodeReturn retVal;
+    CrossEntropyParams* def = static_cast<CrossEntropyParams*>(in_defs->nodeParams.nodeParams);
+
+    // Tensor order is a convention between the TPC kernel writer and the
+    // framework layer writer:
+    //   forward  inputs  : logits {C, N}, targets {N} i32
+    //            outputs : loss {N} f32 ({1} for mean/sum, must be zeroed), lse {N} f32
+    //   backward inputs  : logits {C, N}, targets {N} i32, lse {N} f32,
+    //                      gradLoss {N} f32 ({1} for mean/sum)
+    //            outputs : gradLogits {C, N}, may alias logits
+
+    /*************************************************************************************
+    *   Stage I - validate input
+    **************************************************************************************/
+    const unsigned inputNr  = IsBackward() ? 4 : 2;
+    const unsigned outputNr = IsBackward() ? 1 : 2;
+    //validate correct amount of input tensors
+    if (in_defs->inputTensorNr != inputNr)
+    {
+        in_defs->inputTensorNr  = inputNr;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_COUNT;
+    }
+    //validate correct amount of output tensors
+    if (in_defs->outputTensorNr != outputNr)
+    {
+        in_defs->outputTensorNr  = outputNr;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_COUNT;
+    }
+
+    if (def->reduction < reduction_none || def->reduction > reduction_sum)
+    {
+        return tpc_lib_api::GLUE_UNSUPPORTED_LAYER_CONFIGURATION;
+    }
+    const bool reduce = def->reduction != reduction_none;
+
+    // validate input and output data type
+    const tpc_lib_api::TensorDataType dataType = IsBF16() ? tpc_lib_api::DATA_BF16 : tpc_lib_api::DATA_F32;
+    if (in_defs->inputTensors[0].geometry.dataType != dataType)
+    {
+        in_defs->inputTensors[0].geometry.dataType = dataType;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+    }
+    if (in_defs->inputTensors[1].geometry.dataType != tpc_lib_api::DATA_I32)
+    {
+        in_defs->inputTensors[1].geometry.dataType = tpc_lib_api::DATA_I32;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+    }
+    if (IsBackward())
+    {
+        for (unsigned i = 2; i < 4; i++)
+        {
+            if (in_defs->inputTensors[i].geometry.dataType != tpc_lib_api::DATA_F32)
+            {
+                in_defs->inputTensors[i].geometry.dataType = tpc_lib_api::DATA_F32;
+                return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+            }
+        }
+        if (in_defs->outputTensors[0].geometry.dataType != dataType)
+        {
+            in_defs->outputTensors[0].geometry.dataType = dataType;
+            return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+        }
+    }
+    else
+    {
+        for (unsigned i = 0; i < 2; i++)
+        {
+            if (in_defs->outputTensors[i].geometry.dataType != tpc_lib_api::DATA_F32)
+            {
+                in_defs->outputTensors[i].geometry.dataType = tpc_lib_api::DATA_F32;
+                return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+            }
+        }
+    }
+
+    if (in_defs->inputTensors[0].geometry.dims != 2)
+    {
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+    }
+    const uint64_t classes = in_defs->inputTensors[0].geometry.maxSizes[0];
+    const uint64_t rows    = in_defs->inputTensors[0].geometry.maxSizes[1];
+    // class ids travel through f32 in the kernel
+    if (classes == 0 || classes > (1 << 24))
+    {
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+    }
+    if (!IsRowVector(in_defs->inputTensors[1], rows))
+    {
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+    }
+
+    // verify that the per row tensors are correct
+    const uint64_t lossSize = reduce ? 1 : rows;
+    if (IsBackward())
+    {
+        if (!IsRowVector(in_defs->inputTensors[2], rows) ||
+            !IsRowVector(in_defs->inputTensors[3], lossSize))
+        {
+            return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+        }
+        if (in_defs->outputTensors[0].geometry.dims != 2 ||
+            memcmp(in_defs->outputTensors[0].geometry.maxSizes,
+                   in_defs->inputTensors[0].geometry.maxSizes, 2 * sizeof(uint64_t)) != 0)
+        {
+            memcpy(in_defs->outputTensors[0].geometry.maxSizes,
+                   in_defs->inputTensors[0].geometry.maxSizes, 2 * sizeof(uint64_t));
+            return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_SIZE;
+        }
+    }
+    else
+    {
+        const uint64_t outputSizes[2] = {lossSize, rows};
+        for (unsigned i = 0; i < 2; i++)
+        {
+            if (!IsRowVector(in_defs->outputTensors[i], outputSizes[i]))
+            {
+                in_defs->outputTensors[i].geometry.dims = 1;
+                in_defs->outputTensors[i].geometry.maxSizes[0] = outputSizes[i];
+                return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_SIZE;
+            }
+        }
+    }
+
+    /*************************************************************************************
+    *    Stage II -  Define index space geometry. The forward pass needs the whole row in
+    *    one member for the logsumexp, the backward pass is elementwise given the lse and
+    *    splits the row as well.
+    **************************************************************************************/
+    const int elementsInVec = IsBF16() ? 128 : 64;
+    const int depthStep = IsBackward() ? elementsInVec * c_bwdVectorsPerMember : classes;
+
+    out_defs->indexSpaceRank = 2;
+    out_defs->indexSpaceGeometry[0] = (classes + depthStep - 1) / depthStep;
+    out_defs->indexSpaceGeometry[1] = rows;
+
+    /*************************************************************************************
+    *    Stage III -  Define index space mapping
+    **************************************************************************************/
+    // logits and gradLogits
+    tpc_lib_api::TensorAccessPattern* logitsPattern[2] = {
+        &out_defs->inputTensorAccessPattern[0],
+        IsBackward() ? &out_defs->outputTensorAccessPattern[0] : nullptr
+    };
+    for (unsigned i = 0; i < 2 && logitsPattern[i]; i++)
+    {
+        // f_start f(i) = depthStep*i + 0;
+        // f_end   f(i) = depthStep*i + (depthStep - 1);
+        logitsPattern[i]->mapping[0].indexSpaceDim = 0;
+        logitsPattern[i]->mapping[0].a             = depthStep;
+        logitsPattern[i]->mapping[0].start_b       = 0;
+        logitsPattern[i]->mapping[0].end_b         = depthStep - 1;
+
+        // f_start f(i) = 1*i + 0;
+        // f_end   f(i) = 1*i + 0;
+        logitsPattern[i]->mapping[1].indexSpaceDim = 1;
+        logitsPattern[i]->mapping[1].a             = 1;
+        logitsPattern[i]->mapping[1].start_b       = 0;
+        logitsPattern[i]->mapping[1].end_b         = 0;
+    }
+
+    // per row tensors follow index space dim 1, the reduced loss is shared by all rows
+    tpc_lib_api::TensorAccessPattern* rowPattern[3] = {
+        &out_defs->inputTensorAccessPattern[1],
+        IsBackward() ? &out_defs->inputTensorAccessPattern[2] : &out_defs->outputTensorAccessPattern[1],
+        IsBackward() ? &out_defs->inputTensorAccessPattern[3] : &out_defs->outputTensorAccessPattern[0]
+    };
+    for (unsigned i = 0; i < 3; i++)
+    {
+        const bool shared = reduce && i == 2;
+        rowPattern[i]->mapping[0].indexSpaceDim = 1;
+        rowPattern[i]->mapping[0].a             = shared ? 0 : 1;
+        rowPattern[i]->mapping[0].start_b       = 0;
+        rowPattern[i]->mapping[0].end_b         = 0;
+    }
+
+    /*************************************************************************************
+    *    Stage IV -  define scalar parameters
+    **************************************************************************************/
+    const float scale = (def->reduction == reduction_mean) ? 1.0f / rows : 1.0f;
+    const int32_t reduceFlag = reduce ? 1 : 0;
+    out_defs->kernel.paramsNr = 2;
+    memcpy(&(out_defs->kernel.scalarParams[0]), &scale, sizeof(float));
+    memcpy(&(out_defs->kernel.scalarParams[1]), &reduceFlag, sizeof(int32_t));
+
+    /*************************************************************************************
+    *    Stage V -  Load ISA into the descriptor.
+    **************************************************************************************/
+    unsigned IsaSize = (&_binary___cross_entropy_fwd_f32_gaudi2_o_end - &_binary___cross_entropy_fwd_f32_gaudi2_o_start);
+    unsigned char *binary_kernel = &_binary___cross_entropy_fwd_f32_gaudi2_o_start;
+    switch (m_mode)
+    {
+        case cross_entropy_fwd_f32:
+            IsaSize = (&_binary___cross_entropy_fwd_f32_gaudi2_o_end - &_binary___cross_entropy_fwd_f32_gaudi2_o_start);
+            binary_kernel = &_binary___cross_entropy_fwd_f32_gaudi2_o_start;
+            break;
+        case cross_entropy_fwd_bf16:
+            IsaSize = (&_binary___cross_entropy_fwd_bf16_gaudi2_o_end - &_binary___cross_entropy_fwd_bf16_gaudi2_o_start);
+            binary_kernel = &_binary___cross_entropy_fwd_bf16_gaudi2_o_start;
+            break;
+        case cross_entropy_bwd_f32:
+            IsaSize = (&_binary___cross_entropy_bwd_f32_gaudi2_o_end - &_binary___cross_entropy_bwd_f32_gaudi2_o_start);
+            binary_kernel = &_binary___cross_entropy_bwd_f32_gaudi2_o_start;
+            break;
+        case cross_entropy_bwd_bf16:
+            IsaSize = (&_binary___cross_entropy_bwd_bf16_gaudi2_o_end - &_binary___cross_entropy_bwd_bf16_gaudi2_o_start);
+            binary_kernel = &_binary___cross_entropy_bwd_bf16_gaudi2_o_start;
+            break;
+        default:
+            break;
+    }
+
+    unsigned givenBinarySize = out_defs->kernel.elfSize;
+    out_defs->kernel.elfSize = IsaSize;
+    if (givenBinarySize >= IsaSize)
+    {
+        memcpy (out_defs->kernel.kernelElf, binary_kernel, IsaSize);
+    }
+    else
+    {
+        retVal = tpc_lib_api::GLUE_INSUFFICIENT_ELF_BUFFER;
+        return retVal;
+    }
+
+    return tpc_lib_api::GLUE_SUCCESS;
+}
@@ -0,0 +1,235 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cstring>
+#include <cstdio>
+#include "dropout_gaudi2.hpp"
+
+extern unsigned char _binary___dropout_f32_gaudi2_o_start;
+extern unsigned char _binary___dropout_f32_gaudi2_o_end;
+extern unsigned char _binary___dropout_mask_out_f32_gaudi2_o_start;
+extern unsigned char _binary___dropout_mask_out_f32_gaudi2_o_end;
+extern unsigned char _binary___dropout_mask_in_f32_gaudi2_o_start;
+extern unsigned char _binary___dropout_mask_in_f32_gaudi2_o_end;
+extern unsigned char _binary___dropout_bf16_gaudi2_o_start;
+extern unsigned char _binary___dropout_bf16_gaudi2_o_end;
+extern unsigned char _binary___dropout_mask_out_bf16_gaudi2_o_start;
+extern unsigned char _binary___dropout_mask_out_bf16_gaudi2_o_end;
+extern unsigned char _binary___dropout_mask_in_bf16_gaudi2_o_start;
+extern unsigned char _binary___dropout_mask_in_bf16_gaudi2_o_end;
+
+// [mode], the regenerating backward is the forward kernel run on dY
+static unsigned char* const c_dropoutBinaries[DropoutGaudi2::dropout_mode_count][2] = {
+    {&_binary___dropout_f32_gaudi2_o_start, &_binary___dropout_f32_gaudi2_o_end},
+    {&_binary___dropout_mask_out_f32_gaudi2_o_start, &_binary___dropout_mask_out_f32_gaudi2_o_end},
+    {&_binary___dropout_f32_gaudi2_o_start, &_binary___dropout_f32_gaudi2_o_end},
+    {&_binary___dropout_mask_in_f32_gaudi2_o_start, &_binary___dropout_mask_in_f32_gaudi2_o_end},
+    {&_binary___dropout_bf16_gaudi2_o_start, &_binary___dropout_bf16_gaudi2_o_end},
+    {&_binary___dropout_mask_out_bf16_gaudi2_o_start, &_binary___dropout_mask_out_bf16_gaudi2_o_end},
+    {&_binary___dropout_bf16_gaudi2_o_start, &_binary___dropout_bf16_gaudi2_o_end},
+    {&_binary___dropout_mask_in_bf16_gaudi2_o_start, &_binary___dropout_mask_in_bf16_gaudi2_o_end}
+};
+
+static const char* const c_dropoutModeNames[] = {
+    "fwd_f32",
+    "fwd_mask_f32",
+    "bwd_f32",
+    "bwd_mask_f32",
+    "fwd_bf16",
+    "fwd_mask_bf16",
+    "bwd_bf16",
+    "bwd_mask_bf16"
+};
+
+tpc_lib_api::GlueCodeReturn DropoutGaudi2::GetKernelName(
+        char kernelName [tpc_lib_api::MAX_NODE_NAME], Dropout_mode_t mode)
+{
+    if (mode >= dropout_mode_count)
+        return tpc_lib_api::GLUE_NODE_NOT_FOUND;
+    snprintf(kernelName, tpc_lib_api::MAX_NODE_NAME, "custom_dropout_%s_gaudi2",
+             c_dropoutModeNames[mode]);
+    return tpc_lib_api::GLUE_SUCCESS;
+}
+
+tpc_lib_api::GlueCodeReturn DropoutGaudi2::GetGcDefinitions(
+        tpc_lib_api::HabanaKernelParams* in_defs,
+        tpc_lib_api::HabanaKernelInstantiation* out_defs)
+{
+    tpc_lib_api::GlueCodeReturn retVal;
+    DropoutParams* def = static_cast<DropoutParams*>(in_defs->nodeParams.nodeParams);
+
+    /*************************************************************************************
+    *   Stage I - validate input
+    **************************************************************************************/
+    if (m_mode >= dropout_mode_count)
+    {
+        return tpc_lib_api::GLUE_NODE_NOT_FOUND;
+    }
+
+    const bool isF32 = m_mode < dropout_fwd_bf16;
+    const bool maskOut = m_mode == dropout_fwd_mask_f32 || m_mode == dropout_fwd_mask_bf16;
+    const bool maskIn = m_mode == dropout_bwd_mask_f32 || m_mode == dropout_bwd_mask_bf16;
+    const tpc_lib_api::TensorDataType dataType = isF32 ? tpc_lib_api::DATA_F32 : tpc_lib_api::DATA_BF16;
+    const tpc_lib_api::TensorDataType maskType = isF32 ? tpc_lib_api::DATA_I32 : tpc_lib_api::DATA_I16;
+    const unsigned inputCount = maskIn ? 2 : 1;
+    const unsigned outputCount = maskOut ? 2 : 1;
+
+    //validate correct amount of input tensors
+    if (in_defs->inputTensorNr != inputCount)
+    {
+        in_defs->inputTensorNr  = inputCount;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_COUNT;
+    }
+    //validate correct amount of output tensors
+    if (in_defs->outputTensorNr != outputCount)
+    {
+        in_defs->outputTensorNr  = outputCount;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_COUNT;
+    }
+
+    if (def == nullptr || !(def->prob >= 0.0f && def->prob < 1.0f))
+    {
+        return tpc_lib_api::GLUE_UNSUPPORTED_LAYER_CONFIGURATION;
+    }
+
+    tpc_lib_api::Tensor* data = &in_defs->inputTensors[0];
+    tpc_lib_api::Tensor* result = &in_defs->outputTensors[0];
+    tpc_lib_api::Tensor* mask = maskIn ? &in_defs->inputTensors[1] : &in_defs->outputTensors[1];
+
+    // validate input and output data type
+    if (data->geometry.dataType != dataType || result->geometry.dataType != dataType)
+    {
+        data->geometry.dataType = dataType;
+        result->geometry.dataType = dataType;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+    }
+    if ((maskIn || maskOut) && mask->geometry.dataType != maskType)
+    {
+        mask->geometry.dataType = maskType;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+    }
+
+    uint64_t outputSizes[gcapi::MAX_TENSOR_DIM] = {0};
+    memcpy(outputSizes, data->geometry.maxSizes, sizeof(outputSizes));
+
+    // verify that output feature map dimension are correct
+    if (memcmp(result->geometry.maxSizes, outputSizes,
+               result->geometry.dims * sizeof(uint64_t)) != 0)
+    {
+        memcpy(result->geometry.maxSizes, outputSizes, sizeof(outputSizes));
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_SIZE;
+    }
+
+    // the mask packs every c_maskBlockElements elements of dim 0 into one vector
+    const int elementsInVec = isF32 ? 64 : 128;
+    const uint64_t blocks = (outputSizes[0] + (c_maskBlockElements - 1)) / c_maskBlockElements;
+    if (maskIn || maskOut)
+    {
+        uint64_t maskSizes[gcapi::MAX_TENSOR_DIM] = {0};
+        memcpy(maskSizes, outputSizes, sizeof(maskSizes));
+        maskSizes[0] = blocks * elementsInVec;
+        if (memcmp(mask->geometry.maxSizes, maskSizes, mask->geometry.dims * sizeof(uint64_t)) != 0)
+        {
+            if (maskIn)
+            {
+                return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+            }
+            memcpy(mask->geometry.maxSizes, maskSizes, sizeof(maskSizes));
+            return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_SIZE;
+        }
+    }
+
+    /*************************************************************************************
+    *    Stage II -  Define index space geometry. One member per mask vector, it
+    *    covers c_maskBlockElements elements of dim 0.
+    **************************************************************************************/
+    out_defs->indexSpaceRank = 5;
+    out_defs->indexSpaceGeometry[0] = blocks;
+    out_defs->indexSpaceGeometry[1] = outputSizes[1];
+    out_defs->indexSpaceGeometry[2] = outputSizes[2];
+    out_defs->indexSpaceGeometry[3] = outputSizes[3];
+    out_defs->indexSpaceGeometry[4] = outputSizes[4];
+
+    /*************************************************************************************
+    *    Stage III -  Define index space mapping
+    **************************************************************************************/
+    tpc_lib_api::TensorAccessPattern dataPattern = {};
+    tpc_lib_api::TensorAccessPattern maskPattern = {};
+
+    // f_start f(i) = c_maskBlockElements*i + 0;
+    // f_end   f(i) = c_maskBlockElements*i + (c_maskBlockElements - 1);
+    dataPattern.mapping[0].indexSpaceDim = 0;
+    dataPattern.mapping[0].a             = c_maskBlockElements;
+    dataPattern.mapping[0].start_b       = 0;
+    dataPattern.mapping[0].end_b         = c_maskBlockElements - 1;
+
+    // f_start f(i) = elementsInVec*i + 0;
+    // f_end   f(i) = elementsInVec*i + (elementsInVec - 1);
+    maskPattern.mapping[0].indexSpaceDim = 0;
+    maskPattern.mapping[0].a             = elementsInVec;
+    maskPattern.mapping[0].start_b       = 0;
+    maskPattern.mapping[0].end_b         = elementsInVec - 1;
+
+    // f_start f(i) = 1*i + 0;
+    // f_end   f(i) = 1*i + 0;
+    for (unsigned int dims = 1; dims < out_defs->indexSpaceRank; dims++)
+    {
+        dataPattern.mapping[dims].indexSpaceDim = dims;
+        dataPattern.mapping[dims].a             = 1;
+        dataPattern.mapping[dims].start_b       = 0;
+        dataPattern.mapping[dims].end_b         = 1 - 1;
+        maskPattern.mapping[dims] = dataPattern.mapping[dims];
+    }
+
+    out_defs->inputTensorAccessPattern[0] = dataPattern;
+    out_defs->outputTensorAccessPattern[0] = dataPattern;
+    if (maskIn)
+        out_defs->inputTensorAccessPattern[1] = maskPattern;
+    if (maskOut)
+        out_defs->outputTensorAccessPattern[1] = maskPattern;
+
+    /*************************************************************************************
+    *    Stage IV -  define scalar parameters: seed, offset, threshold, scale
+    **************************************************************************************/
+    const uint32_t threshold = GetThreshold(def->prob);
+    const float scale = 1.0f / (1.0f - def->prob);
+
+    out_defs->kernel.paramsNr = 4;
+    memcpy(&(out_defs->kernel.scalarParams[0]), &def->seed, sizeof(uint32_t));
+    memcpy(&(out_defs->kernel.scalarParams[1]), &def->offset, sizeof(uint32_t));
+    memcpy(&(out_defs->kernel.scalarParams[2]), &threshold, sizeof(uint32_t));
+    memcpy(&(out_defs->kernel.scalarParams[3]), &scale, sizeof(float));
+
+    /*************************************************************************************
+    *    Stage V -  Load ISA into the descriptor.
+    **************************************************************************************/
+    unsigned char* binary_kernel = c_dropoutBinaries[m_mode][0];
+    unsigned IsaSize = (c_dropoutBinaries[m_mode][1] - c_dropoutBinaries[m_mode][0]);
+    unsigned givenBinarySize = out_defs->kernel.elfSize;
+    out_defs->kernel.elfSize = IsaSize;
+
+    if (givenBinarySize >= IsaSize)
+    {
+        memcpy (out_defs->kernel.kernelElf, binary_kernel, IsaSize);
+    }
+    else
+    {
+        retVal = tpc_lib_api::GLUE_INSUFFICIENT_ELF_BUFFER;
+        return retVal;
+    }
+
+    return tpc_lib_api::GLUE_SUCCESS;
+}
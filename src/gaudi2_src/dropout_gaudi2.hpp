@@ -0,0 +1,83 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef _DROPOUT_GAUDI2_HPP
+#define _DROPOUT_GAUDI2_HPP
+
+#include "gc_interface.h"
+#include "tpc_kernel_lib_interface.h"
+
+// Dropout of a f32 or bf16 tensor with a counter based random stream keyed
+// by (seed, offset, linear element index), so no random tensor is read and
+// the backward can regenerate the mask from the same params.
+//
+//   fwd      : x -> y
+//   fwd_mask : x -> y, mask (1 bit per element, see c_maskBlockElements)
+//   bwd      : dY -> dX, regenerates the mask from seed and offset
+//   bwd_mask : dY, mask -> dX
+class DropoutGaudi2
+{
+public:
+    typedef enum _Dropout_mode_t
+    {
+        dropout_fwd_f32,
+        dropout_fwd_mask_f32,
+        dropout_bwd_f32,
+        dropout_bwd_mask_f32,
+        dropout_fwd_bf16,
+        dropout_fwd_mask_bf16,
+        dropout_bwd_bf16,
+        dropout_bwd_mask_bf16,
+        dropout_mode_count
+    } Dropout_mode_t;
+
+    DropoutGaudi2(Dropout_mode_t mode=dropout_fwd_f32) {m_mode = mode;}
+    virtual ~DropoutGaudi2() {}
+
+    virtual tpc_lib_api::GlueCodeReturn GetGcDefinitions(
+            tpc_lib_api::HabanaKernelParams* in_defs,
+            tpc_lib_api::HabanaKernelInstantiation* out_defs);
+
+    virtual tpc_lib_api::GlueCodeReturn GetKernelName(
+            char kernelName [tpc_lib_api::MAX_NODE_NAME], Dropout_mode_t mode);
+
+    // This struct is common between the TPC kernel writer and the framework
+    // layer writer. The backward takes the params of its forward.
+    struct DropoutParams
+    {
+        float    prob;      // drop probability, [0, 1)
+        uint32_t seed;
+        uint32_t offset;    // added to the element index, advance it per call
+    };
+
+    // elements of dim 0 packed into one mask vector, 32 bits per i32 lane
+    // for f32 and 16 bits per i16 lane for bf16, as the ReLU masks
+    static const int c_maskBlockElements = 2048;
+
+    // an element is dropped when its random u32 is below the threshold
+    static uint32_t GetThreshold(float prob)
+    {
+        const double threshold = (double)prob * 4294967296.0;
+        return threshold >= 4294967295.0 ? 0xffffffffu : (uint32_t)threshold;
+    }
+
+private:
+    Dropout_mode_t m_mode;
+    DropoutGaudi2(const DropoutGaudi2& other) = delete;
+    DropoutGaudi2& operator=(const DropoutGaudi2& other) = delete;
+};
+
+#endif //_DROPOUT_GAUDI2_HPP
@@ -0,0 +1,239 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cstring>
+#include <cstdio>
+#include "fp8_cast_gaudi2.hpp"
+
+extern unsigned char _binary___cast_f32_to_fp8_143_gaudi2_o_start;
+extern unsigned char _binary___cast_f32_to_fp8_143_gaudi2_o_end;
+extern unsigned char _binary___cast_bf16_to_fp8_143_gaudi2_o_start;
+extern unsigned char _binary___cast_bf16_to_fp8_143_gaudi2_o_end;
+extern unsigned char _binary___cast_f32_to_fp8_152_gaudi2_o_start;
+extern unsigned char _binary___cast_f32_to_fp8_152_gaudi2_o_end;
+extern unsigned char _binary___cast_bf16_to_fp8_152_gaudi2_o_start;
+extern unsigned char _binary___cast_bf16_to_fp8_152_gaudi2_o_end;
+extern unsigned char _binary___cast_fp8_143_to_f32_gaudi2_o_start;
+extern unsigned char _binary___cast_fp8_143_to_f32_gaudi2_o_end;
+extern unsigned char _binary___cast_fp8_143_to_bf16_gaudi2_o_start;
+extern unsigned char _binary___cast_fp8_143_to_bf16_gaudi2_o_end;
+extern unsigned char _binary___cast_fp8_152_to_f32_gaudi2_o_start;
+extern unsigned char _binary___cast_fp8_152_to_f32_gaudi2_o_end;
+extern unsigned char _binary___cast_fp8_152_to_bf16_gaudi2_o_start;
+extern unsigned char _binary___cast_fp8_152_to_bf16_gaudi2_o_end;
+
+static const char* const c_fp8CastModeNames[] = {
+    "cast_f32_to_fp8_143",
+    "cast_bf16_to_fp8_143",
+    "cast_f32_to_fp8_152",
+    "cast_bf16_to_fp8_152",
+    "cast_fp8_143_to_f32",
+    "cast_fp8_143_to_bf16",
+    "cast_fp8_152_to_f32",
+    "cast_fp8_152_to_bf16"
+};
+
+static unsigned char* const c_fp8CastBinaries[][2] = {
+    {&_binary___cast_f32_to_fp8_143_gaudi2_o_start, &_binary___cast_f32_to_fp8_143_gaudi2_o_end},
+    {&_binary___cast_bf16_to_fp8_143_gaudi2_o_start, &_binary___cast_bf16_to_fp8_143_gaudi2_o_end},
+    {&_binary___cast_f32_to_fp8_152_gaudi2_o_start, &_binary___cast_f32_to_fp8_152_gaudi2_o_end},
+    {&_binary___cast_bf16_to_fp8_152_gaudi2_o_start, &_binary___cast_bf16_to_fp8_152_gaudi2_o_end},
+    {&_binary___cast_fp8_143_to_f32_gaudi2_o_start, &_binary___cast_fp8_143_to_f32_gaudi2_o_end},
+    {&_binary___cast_fp8_143_to_bf16_gaudi2_o_start, &_binary___cast_fp8_143_to_bf16_gaudi2_o_end},
+    {&_binary___cast_fp8_152_to_f32_gaudi2_o_start, &_binary___cast_fp8_152_to_f32_gaudi2_o_end},
+    {&_binary___cast_fp8_152_to_bf16_gaudi2_o_start, &_binary___cast_fp8_152_to_bf16_gaudi2_o_end}
+};
+
+const char* Fp8CastGaudi2::GetModeName(Fp8Cast_mode_t mode)
+{
+    return c_fp8CastModeNames[mode];
+}
+
+tpc_lib_api::GlueCodeReturn Fp8CastGaudi2::GetKernelName(
+        char kernelName [tpc_lib_api::MAX_NODE_NAME], Fp8Cast_mode_t mode)
+{
+    if (mode >= fp8_cast_mode_count)
+        return tpc_lib_api::GLUE_NODE_NOT_FOUND;
+    snprintf(kernelName, tpc_lib_api::MAX_NODE_NAME, "custom_%s_gaudi2", GetModeName(mode));
+    return tpc_lib_api::GLUE_SUCCESS;
+}
+
+void Fp8CastGaudi2::GetKernelBinary(unsigned char** binary, unsigned* size)
+{
+    *binary = c_fp8CastBinaries[m_mode][0];
+    *size = c_fp8CastBinaries[m_mode][1] - c_fp8CastBinaries[m_mode][0];
+}
+
+tpc_lib_api::GlueCodeReturn Fp8CastGaudi2::GetGcDefinitions(
+        tpc_lib_api::HabanaKernelParams* in_defs,
+        tpc_lib_api::HabanaKernelInstantiation* out_defs)
+{
+    tpc_lib_api::GlueCodeReturn retVal;
+
+    // Tensor order is a convention between the TPC kernel writer and the
+    // framework layer writer:
+    //   quant   : ifm, scale {1} f32    -> ofm fp8, amax {1} f32
+    //   dequant : ifm fp8, scaleInv {1} -> ofm
+    const bool dequant = IsDequant(m_mode);
+    const unsigned outputNr = dequant ? 1 : 2;
+
+    /*************************************************************************************
+    *   Stage I - validate input
+    **************************************************************************************/
+    //validate correct amount of input tensors
+    if (in_defs->inputTensorNr != 2)
+    {
+        in_defs->inputTensorNr  = 2;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_COUNT;
+    }
+    //validate correct amount of output tensors
+    if (in_defs->outputTensorNr != outputNr)
+    {
+        in_defs->outputTensorNr  = outputNr;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_COUNT;
+    }
+
+    // validate input and output data type
+    const tpc_lib_api::TensorDataType wideType =
+            IsBF16(m_mode) ? tpc_lib_api::DATA_BF16 : tpc_lib_api::DATA_F32;
+    const tpc_lib_api::TensorDataType fp8Type =
+            IsFp8143(m_mode) ? tpc_lib_api::DATA_F8_143 : tpc_lib_api::DATA_F8_152;
+    const tpc_lib_api::TensorDataType ifmType = dequant ? fp8Type : wideType;
+    const tpc_lib_api::TensorDataType ofmType = dequant ? wideType : fp8Type;
+    if (in_defs->inputTensors[0].geometry.dataType != ifmType)
+    {
+        in_defs->inputTensors[0].geometry.dataType = ifmType;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+    }
+    if (in_defs->outputTensors[0].geometry.dataType != ofmType)
+    {
+        in_defs->outputTensors[0].geometry.dataType = ofmType;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+    }
+
+    // scale, scaleInv and amax are single f32 values
+    tpc_lib_api::Tensor* scalars[2] = {&in_defs->inputTensors[1], &in_defs->outputTensors[1]};
+    for (unsigned i = 0; i < (dequant ? 1u : 2u); i++)
+    {
+        if (scalars[i]->geometry.dataType != tpc_lib_api::DATA_F32)
+        {
+            scalars[i]->geometry.dataType = tpc_lib_api::DATA_F32;
+            return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+        }
+        if (scalars[i]->geometry.dims != 1 || scalars[i]->geometry.maxSizes[0] != 1)
+        {
+            scalars[i]->geometry.dims = 1;
+            scalars[i]->geometry.maxSizes[0] = 1;
+            return (i == 0) ? tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE :
+                              tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_SIZE;
+        }
+    }
+
+    const tpc_lib_api::Tensor* ifm = &in_defs->inputTensors[0];
+    const unsigned dims = ifm->geometry.dims;
+    if (dims < 1 || dims > gcapi::MAX_TENSOR_DIM)
+    {
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+    }
+    uint64_t ifmSizes[gcapi::MAX_TENSOR_DIM] = {0};
+    memcpy(ifmSizes, ifm->geometry.maxSizes, dims * sizeof(uint64_t));
+
+    // verify that output feature map dimension are correct
+    if (in_defs->outputTensors[0].geometry.dims != dims ||
+        memcmp(in_defs->outputTensors[0].geometry.maxSizes, ifmSizes, dims * sizeof(uint64_t)) != 0)
+    {
+        in_defs->outputTensors[0].geometry.dims = dims;
+        memcpy(in_defs->outputTensors[0].geometry.maxSizes, ifmSizes, sizeof(ifmSizes));
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_SIZE;
+    }
+
+    /*************************************************************************************
+    *    Stage II -  Define index space geometry. Elementwise, one fp8 vector of dim 0
+    *    per member.
+    **************************************************************************************/
+    out_defs->indexSpaceRank = gcapi::MAX_TENSOR_DIM;
+    out_defs->indexSpaceGeometry[0] = (ifmSizes[0] + c_elementsPerMember - 1) / c_elementsPerMember;
+    for (unsigned dim = 1; dim < out_defs->indexSpaceRank; dim++)
+    {
+        out_defs->indexSpaceGeometry[dim] = dims > dim ? ifmSizes[dim] : 1;
+    }
+
+    /*************************************************************************************
+    *    Stage III -  Define index space mapping
+    **************************************************************************************/
+    tpc_lib_api::TensorAccessPattern* patterns[2] = {
+            &out_defs->inputTensorAccessPattern[0], &out_defs->outputTensorAccessPattern[0]};
+    for (unsigned i = 0; i < 2; i++)
+    {
+        // f_start f(i) = c_elementsPerMember*i + 0;
+        // f_end   f(i) = c_elementsPerMember*i + (c_elementsPerMember - 1);
+        patterns[i]->mapping[0].indexSpaceDim = 0;
+        patterns[i]->mapping[0].a             = c_elementsPerMember;
+        patterns[i]->mapping[0].start_b       = 0;
+        patterns[i]->mapping[0].end_b         = c_elementsPerMember - 1;
+
+        // f_start f(i) = 1*i + 0;
+        // f_end   f(i) = 1*i + 0;
+        for (unsigned dim = 1; dim < out_defs->indexSpaceRank; dim++)
+        {
+            patterns[i]->mapping[dim].indexSpaceDim = dim;
+            patterns[i]->mapping[dim].a             = 1;
+            patterns[i]->mapping[dim].start_b       = 0;
+            patterns[i]->mapping[dim].end_b         = 0;
+        }
+    }
+
+    // every member reads the scale and merges into amax
+    // f_start f(i) = 0;
+    // f_end   f(i) = 0;
+    out_defs->inputTensorAccessPattern[1].mapping[0].indexSpaceDim = 0;
+    out_defs->inputTensorAccessPattern[1].mapping[0].a             = 0;
+    out_defs->inputTensorAccessPattern[1].mapping[0].start_b       = 0;
+    out_defs->inputTensorAccessPattern[1].mapping[0].end_b         = 0;
+    if (!dequant)
+    {
+        out_defs->outputTensorAccessPattern[1].mapping[0].indexSpaceDim = 0;
+        out_defs->outputTensorAccessPattern[1].mapping[0].a             = 0;
+        out_defs->outputTensorAccessPattern[1].mapping[0].start_b       = 0;
+        out_defs->outputTensorAccessPattern[1].mapping[0].end_b         = 0;
+    }
+
+    /*************************************************************************************
+    *    Stage IV -  define scalar parameters
+    **************************************************************************************/
+    out_defs->kernel.paramsNr = 0;
+
+    /*************************************************************************************
+    *    Stage V -  Load ISA into the descriptor.
+    **************************************************************************************/
+    unsigned char* binary_kernel = nullptr;
+    unsigned IsaSize = 0;
+    GetKernelBinary(&binary_kernel, &IsaSize);
+
+    unsigned givenBinarySize = out_defs->kernel.elfSize;
+    out_defs->kernel.elfSize = IsaSize;
+    if (givenBinarySize >= IsaSize)
+    {
+        memcpy (out_defs->kernel.kernelElf, binary_kernel, IsaSize);
+    }
+    else
+    {
+        retVal = tpc_lib_api::GLUE_INSUFFICIENT_ELF_BUFFER;
+        return retVal;
+    }
+
+    return tpc_lib_api::GLUE_SUCCESS;
+}
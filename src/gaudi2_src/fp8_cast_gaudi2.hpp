@@ -0,0 +1,76 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef _FP8_CAST_GAUDI2_HPP
+#define _FP8_CAST_GAUDI2_HPP
+
+#include "gc_interface.h"
+#include "tpc_kernel_lib_interface.h"
+
+// Scaled casts between f32 / bf16 and fp8. fp8_143 is E4M3 (max 240) and
+// fp8_152 is E5M2 (max 57344).
+//   quant   : x, scale {1} f32 -> y = saturate(x * scale), amax {1} f32
+//   dequant : x, scaleInv {1} f32 -> y = x * scaleInv
+// amax is merged into with an atomic max, zero it before the first launch.
+class Fp8CastGaudi2
+{
+public:
+    // quant modes come first, bf16 modes follow their f32 twin
+    typedef enum _Fp8Cast_mode_t
+    {
+        f32_to_fp8_143,
+        bf16_to_fp8_143,
+        f32_to_fp8_152,
+        bf16_to_fp8_152,
+        fp8_143_to_f32,
+        fp8_143_to_bf16,
+        fp8_152_to_f32,
+        fp8_152_to_bf16,
+        fp8_cast_mode_count
+    } Fp8Cast_mode_t;
+
+    Fp8CastGaudi2(Fp8Cast_mode_t mode=f32_to_fp8_143) {m_mode = mode;}
+    virtual ~Fp8CastGaudi2() {}
+
+    virtual tpc_lib_api::GlueCodeReturn GetGcDefinitions(
+            tpc_lib_api::HabanaKernelParams* in_defs,
+            tpc_lib_api::HabanaKernelInstantiation* out_defs);
+
+    virtual tpc_lib_api::GlueCodeReturn GetKernelName(
+            char kernelName [tpc_lib_api::MAX_NODE_NAME], Fp8Cast_mode_t mode);
+
+    static bool IsDequant(Fp8Cast_mode_t mode) { return mode >= fp8_143_to_f32; }
+    static bool IsBF16(Fp8Cast_mode_t mode) { return (mode % 2) == 1; }
+    static bool IsFp8143(Fp8Cast_mode_t mode) { return (mode % 4) < 2; }
+
+    // elements of dim 0 per index space member, one fp8 vector
+    static const int c_elementsPerMember = 256;
+
+protected:
+    // "cast_f32_to_fp8_143" etc., the device suffix is added by GetKernelName
+    static const char* GetModeName(Fp8Cast_mode_t mode);
+
+    // ISA of m_mode for the device this class instantiates kernels for
+    virtual void GetKernelBinary(unsigned char** binary, unsigned* size);
+
+    Fp8Cast_mode_t m_mode;
+
+private:
+    Fp8CastGaudi2(const Fp8CastGaudi2& other) = delete;
+    Fp8CastGaudi2& operator=(const Fp8CastGaudi2& other) = delete;
+};
+
+#endif //_FP8_CAST_GAUDI2_HPP
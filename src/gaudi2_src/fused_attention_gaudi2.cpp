@@ -0,0 +1,227 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cstring>
+#include "fused_attention_gaudi2.hpp"
+
+extern unsigned char _binary___fused_attention_f32_gaudi2_o_start;
+extern unsigned char _binary___fused_attention_f32_gaudi2_o_end;
+extern unsigned char _binary___fused_attention_kv_lengths_f32_gaudi2_o_start;
+extern unsigned char _binary___fused_attention_kv_lengths_f32_gaudi2_o_end;
+
+static const char c_fusedAttentionKernelNames[][tpc_lib_api::MAX_NODE_NAME] = {
+    "custom_fused_attention_f32_gaudi2",
+    "custom_fused_attention_kv_lengths_f32_gaudi2"
+};
+
+tpc_lib_api::GlueCodeReturn FusedAttentionGaudi2::GetKernelName(
+        char kernelName [tpc_lib_api::MAX_NODE_NAME], FusedAttention_mode_t mode)
+{
+    if (mode > fused_attention_kv_lengths_f32)
+        return tpc_lib_api::GLUE_NODE_NOT_FOUND;
+    strcpy(kernelName, c_fusedAttentionKernelNames[mode]);
+    return tpc_lib_api::GLUE_SUCCESS;
+}
+
+tpc_lib_api::GlueCodeReturn FusedAttentionGaudi2::GetGcDefinitions(
+        tpc_lib_api::HabanaKernelParams* in_defs,
+        tpc_lib_api::HabanaKernelInstantiation* out_defs)
+{
+    tpc_lib_api::GlueCodeReturn retVal;
+    FusedAttentionParams* def = static_cast<FusedAttentionParams*>(in_defs->nodeParams.nodeParams);
+
+    // Tensor order is a convention between the TPC kernel writer and the
+    // framework layer writer:
+    //   inputs  : q {headDim, qLen, heads, batch}, k and v {headDim, kvLen, heads, batch},
+    //             kv lengths i32 {batch} (kv lengths mode)
+    //   outputs : attention output, same shape as q
+
+    /*************************************************************************************
+    *   Stage I - validate input
+    **************************************************************************************/
+    const unsigned inputNr = HasKvLengths() ? 4 : 3;
+    //validate correct amount of input tensors
+    if (in_defs->inputTensorNr != inputNr)
+    {
+        in_defs->inputTensorNr  = inputNr;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_COUNT;
+    }
+    //validate correct amount of output tensors
+    if (in_defs->outputTensorNr != 1)
+    {
+        in_defs->outputTensorNr  = 1;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_COUNT;
+    }
+
+    if (def == nullptr || def->causal < 0 || def->causal > 1)
+    {
+        return tpc_lib_api::GLUE_UNSUPPORTED_LAYER_CONFIGURATION;
+    }
+
+    // validate input and output data type
+    for (unsigned i = 0; i < inputNr; i++)
+    {
+        const tpc_lib_api::TensorDataType type = (i == 3) ? tpc_lib_api::DATA_I32 : tpc_lib_api::DATA_F32;
+        if (in_defs->inputTensors[i].geometry.dataType != type)
+        {
+            in_defs->inputTensors[i].geometry.dataType = type;
+            return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+        }
+    }
+    if (in_defs->outputTensors[0].geometry.dataType != tpc_lib_api::DATA_F32)
+    {
+        in_defs->outputTensors[0].geometry.dataType = tpc_lib_api::DATA_F32;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+    }
+
+    // q, k and v share headDim, heads and batch, k and v share kvLen
+    uint64_t sizes[3][4];
+    for (unsigned i = 0; i < 3; i++)
+    {
+        const unsigned dims = in_defs->inputTensors[i].geometry.dims;
+        if (dims < 2 || dims > 4)
+        {
+            return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+        }
+        for (unsigned dim = 0; dim < 4; dim++)
+        {
+            sizes[i][dim] = dim < dims ? in_defs->inputTensors[i].geometry.maxSizes[dim] : 1;
+        }
+    }
+    const uint64_t headDim = sizes[0][0];
+    const uint64_t qLen    = sizes[0][1];
+    const uint64_t kvLen   = sizes[1][1];
+    if (sizes[1][0] != headDim || sizes[2][0] != headDim || sizes[2][1] != kvLen ||
+        sizes[1][2] != sizes[0][2] || sizes[2][2] != sizes[0][2] ||
+        sizes[1][3] != sizes[0][3] || sizes[2][3] != sizes[0][3])
+    {
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+    }
+
+    // q^T and o^T tiles live in VLM, the whole key range in one member
+    if (headDim > (uint64_t)c_maxHeadDim || qLen > (uint64_t)c_maxSeqLen ||
+        kvLen > (uint64_t)c_maxSeqLen || kvLen == 0)
+    {
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+    }
+
+    if (HasKvLengths() &&
+        (in_defs->inputTensors[3].geometry.dims != 1 ||
+         in_defs->inputTensors[3].geometry.maxSizes[0] != sizes[0][3]))
+    {
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+    }
+
+    // verify that output feature map dimension are correct
+    const unsigned dims = in_defs->inputTensors[0].geometry.dims;
+    if (in_defs->outputTensors[0].geometry.dims != dims ||
+        memcmp(in_defs->outputTensors[0].geometry.maxSizes, sizes[0], dims * sizeof(uint64_t)) != 0)
+    {
+        in_defs->outputTensors[0].geometry.dims = dims;
+        memcpy(in_defs->outputTensors[0].geometry.maxSizes, sizes[0], dims * sizeof(uint64_t));
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_SIZE;
+    }
+
+    /*************************************************************************************
+    *    Stage II -  Define index space geometry. A member takes c_queryBlock queries of
+    *    one head with every key.
+    **************************************************************************************/
+    out_defs->indexSpaceRank = 3;
+    out_defs->indexSpaceGeometry[0] = (qLen + c_queryBlock - 1) / c_queryBlock;
+    out_defs->indexSpaceGeometry[1] = sizes[0][2];
+    out_defs->indexSpaceGeometry[2] = sizes[0][3];
+
+    /*************************************************************************************
+    *    Stage III -  Define index space mapping
+    **************************************************************************************/
+    tpc_lib_api::TensorAccessPattern* patterns[4] = {
+        &out_defs->inputTensorAccessPattern[0],
+        &out_defs->outputTensorAccessPattern[0],
+        &out_defs->inputTensorAccessPattern[1],
+        &out_defs->inputTensorAccessPattern[2]
+    };
+    for (unsigned i = 0; i < 4; i++)
+    {
+        const bool isQuery = i < 2;
+
+        // f_start f(i) = 0;
+        // f_end   f(i) = headDim - 1 (whole head)
+        patterns[i]->mapping[0].indexSpaceDim = 0;
+        patterns[i]->mapping[0].a             = 0;
+        patterns[i]->mapping[0].start_b       = 0;
+        patterns[i]->mapping[0].end_b         = headDim - 1;
+
+        // q and out:
+        // f_start f(i) = c_queryBlock*i + 0;
+        // f_end   f(i) = c_queryBlock*i + (c_queryBlock - 1);
+        // k and v: every key
+        patterns[i]->mapping[1].indexSpaceDim = 0;
+        patterns[i]->mapping[1].a             = isQuery ? c_queryBlock : 0;
+        patterns[i]->mapping[1].start_b       = 0;
+        patterns[i]->mapping[1].end_b         = isQuery ? c_queryBlock - 1 : kvLen - 1;
+
+        // f_start f(i) = 1*i + 0;
+        // f_end   f(i) = 1*i + 0;
+        for (unsigned dim = 2; dim < 4; dim++)
+        {
+            patterns[i]->mapping[dim].indexSpaceDim = dim - 1;
+            patterns[i]->mapping[dim].a             = 1;
+            patterns[i]->mapping[dim].start_b       = 0;
+            patterns[i]->mapping[dim].end_b         = 0;
+        }
+    }
+    if (HasKvLengths())
+    {
+        // one length per batch entry
+        out_defs->inputTensorAccessPattern[3].mapping[0].indexSpaceDim = 2;
+        out_defs->inputTensorAccessPattern[3].mapping[0].a             = 1;
+        out_defs->inputTensorAccessPattern[3].mapping[0].start_b       = 0;
+        out_defs->inputTensorAccessPattern[3].mapping[0].end_b         = 0;
+    }
+
+    /*************************************************************************************
+    *    Stage IV -  define scalar parameters
+    **************************************************************************************/
+    out_defs->kernel.paramsNr = 3;
+    memcpy(&(out_defs->kernel.scalarParams[0]), &def->scale, sizeof(float));
+    memcpy(&(out_defs->kernel.scalarParams[1]), &def->causal, sizeof(int32_t));
+    memcpy(&(out_defs->kernel.scalarParams[2]), &def->causalOffset, sizeof(int32_t));
+
+    /*************************************************************************************
+    *    Stage V -  Load ISA into the descriptor.
+    **************************************************************************************/
+    unsigned IsaSize = (&_binary___fused_attention_f32_gaudi2_o_end - &_binary___fused_attention_f32_gaudi2_o_start);
+    unsigned char *binary_kernel = &_binary___fused_attention_f32_gaudi2_o_start;
+    if (HasKvLengths())
+    {
+        IsaSize = (&_binary___fused_attention_kv_lengths_f32_gaudi2_o_end - &_binary___fused_attention_kv_lengths_f32_gaudi2_o_start);
+        binary_kernel = &_binary___fused_attention_kv_lengths_f32_gaudi2_o_start;
+    }
+
+    unsigned givenBinarySize = out_defs->kernel.elfSize;
+    out_defs->kernel.elfSize = IsaSize;
+    if (givenBinarySize >= IsaSize)
+    {
+        memcpy (out_defs->kernel.kernelElf, binary_kernel, IsaSize);
+    }
+    else
+    {
+        retVal = tpc_lib_api::GLUE_INSUFFICIENT_ELF_BUFFER;
+        return retVal;
+    }
+
+    return tpc_lib_api::GLUE_SUCCESS;
+}
@@ -0,0 +1,67 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef _FUSED_ATTENTION_GAUDI2_HPP
+#define _FUSED_ATTENTION_GAUDI2_HPP
+
+#include "gc_interface.h"
+#include "tpc_kernel_lib_interface.h"
+
+// softmax(scale * q k^T + mask) v in a single f32 kernel for short sequences
+// and small heads, one member per block of c_queryBlock queries of a head.
+class FusedAttentionGaudi2
+{
+public:
+    typedef enum _FusedAttention_mode_t
+    {
+        fused_attention_f32,
+        fused_attention_kv_lengths_f32
+    } FusedAttention_mode_t;
+
+    // queries per member, ATTENTION_BLOCK_Q in the kernel
+    static const int c_queryBlock = 8;
+    static const int c_maxHeadDim = 128;
+    static const int c_maxSeqLen = 512;
+
+    FusedAttentionGaudi2(FusedAttention_mode_t mode=fused_attention_f32) {m_mode = mode;}
+    virtual ~FusedAttentionGaudi2() {}
+
+    virtual tpc_lib_api::GlueCodeReturn GetGcDefinitions(
+            tpc_lib_api::HabanaKernelParams* in_defs,
+            tpc_lib_api::HabanaKernelInstantiation* out_defs);
+
+    virtual tpc_lib_api::GlueCodeReturn GetKernelName(
+            char kernelName [tpc_lib_api::MAX_NODE_NAME], FusedAttention_mode_t mode);
+
+    // This struct is common between the TPC kernel writer and the framework
+    // layer writer. The programmer who adds a new layer to the framework-backend
+    // is responsible to fill the structure with valid data.
+    struct FusedAttentionParams
+    {
+        float   scale;          // usually 1 / sqrt(headDim)
+        int32_t causal;         // key j of query q is visible for j <= q + causalOffset
+        int32_t causalOffset;
+    };
+
+private:
+    bool HasKvLengths() const { return m_mode == fused_attention_kv_lengths_f32; }
+
+    FusedAttention_mode_t m_mode;
+    FusedAttentionGaudi2(const FusedAttentionGaudi2& other) = delete;
+    FusedAttentionGaudi2& operator=(const FusedAttentionGaudi2& other) = delete;
+};
+
+#endif //_FUSED_ATTENTION_GAUDI2_HPP
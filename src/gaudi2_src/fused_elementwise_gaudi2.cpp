@@ -0,0 +1,295 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cstring>
+#include <cstdio>
+#include "fused_elementwise_gaudi2.hpp"
+
+extern unsigned char _binary___fused_elementwise_f32_to_f32_in1_gaudi2_o_start;
+extern unsigned char _binary___fused_elementwise_f32_to_f32_in1_gaudi2_o_end;
+extern unsigned char _binary___fused_elementwise_f32_to_f32_in2_gaudi2_o_start;
+extern unsigned char _binary___fused_elementwise_f32_to_f32_in2_gaudi2_o_end;
+extern unsigned char _binary___fused_elementwise_f32_to_f32_in3_gaudi2_o_start;
+extern unsigned char _binary___fused_elementwise_f32_to_f32_in3_gaudi2_o_end;
+extern unsigned char _binary___fused_elementwise_f32_to_f32_in4_gaudi2_o_start;
+extern unsigned char _binary___fused_elementwise_f32_to_f32_in4_gaudi2_o_end;
+extern unsigned char _binary___fused_elementwise_f32_to_bf16_in1_gaudi2_o_start;
+extern unsigned char _binary___fused_elementwise_f32_to_bf16_in1_gaudi2_o_end;
+extern unsigned char _binary___fused_elementwise_f32_to_bf16_in2_gaudi2_o_start;
+extern unsigned char _binary___fused_elementwise_f32_to_bf16_in2_gaudi2_o_end;
+extern unsigned char _binary___fused_elementwise_f32_to_bf16_in3_gaudi2_o_start;
+extern unsigned char _binary___fused_elementwise_f32_to_bf16_in3_gaudi2_o_end;
+extern unsigned char _binary___fused_elementwise_f32_to_bf16_in4_gaudi2_o_start;
+extern unsigned char _binary___fused_elementwise_f32_to_bf16_in4_gaudi2_o_end;
+extern unsigned char _binary___fused_elementwise_bf16_to_f32_in1_gaudi2_o_start;
+extern unsigned char _binary___fused_elementwise_bf16_to_f32_in1_gaudi2_o_end;
+extern unsigned char _binary___fused_elementwise_bf16_to_f32_in2_gaudi2_o_start;
+extern unsigned char _binary___fused_elementwise_bf16_to_f32_in2_gaudi2_o_end;
+extern unsigned char _binary___fused_elementwise_bf16_to_f32_in3_gaudi2_o_start;
+extern unsigned char _binary___fused_elementwise_bf16_to_f32_in3_gaudi2_o_end;
+extern unsigned char _binary___fused_elementwise_bf16_to_f32_in4_gaudi2_o_start;
+extern unsigned char _binary___fused_elementwise_bf16_to_f32_in4_gaudi2_o_end;
+extern unsigned char _binary___fused_elementwise_bf16_to_bf16_in1_gaudi2_o_start;
+extern unsigned char _binary___fused_elementwise_bf16_to_bf16_in1_gaudi2_o_end;
+extern unsigned char _binary___fused_elementwise_bf16_to_bf16_in2_gaudi2_o_start;
+extern unsigned char _binary___fused_elementwise_bf16_to_bf16_in2_gaudi2_o_end;
+extern unsigned char _binary___fused_elementwise_bf16_to_bf16_in3_gaudi2_o_start;
+extern unsigned char _binary___fused_elementwise_bf16_to_bf16_in3_gaudi2_o_end;
+extern unsigned char _binary___fused_elementwise_bf16_to_bf16_in4_gaudi2_o_start;
+extern unsigned char _binary___fused_elementwise_bf16_to_bf16_in4_gaudi2_o_end;
+
+// [mode][input count - 1]
+static unsigned char* const c_fusedElementwiseBinaries[FusedElementwiseGaudi2::fused_mode_count]
+                                                    [FusedElementwiseGaudi2::c_maxInputs][2] = {
+    {
+        {&_binary___fused_elementwise_f32_to_f32_in1_gaudi2_o_start, &_binary___fused_elementwise_f32_to_f32_in1_gaudi2_o_end},
+        {&_binary___fused_elementwise_f32_to_f32_in2_gaudi2_o_start, &_binary___fused_elementwise_f32_to_f32_in2_gaudi2_o_end},
+        {&_binary___fused_elementwise_f32_to_f32_in3_gaudi2_o_start, &_binary___fused_elementwise_f32_to_f32_in3_gaudi2_o_end},
+        {&_binary___fused_elementwise_f32_to_f32_in4_gaudi2_o_start, &_binary___fused_elementwise_f32_to_f32_in4_gaudi2_o_end}
+    },
+    {
+        {&_binary___fused_elementwise_f32_to_bf16_in1_gaudi2_o_start, &_binary___fused_elementwise_f32_to_bf16_in1_gaudi2_o_end},
+        {&_binary___fused_elementwise_f32_to_bf16_in2_gaudi2_o_start, &_binary___fused_elementwise_f32_to_bf16_in2_gaudi2_o_end},
+        {&_binary___fused_elementwise_f32_to_bf16_in3_gaudi2_o_start, &_binary___fused_elementwise_f32_to_bf16_in3_gaudi2_o_end},
+        {&_binary___fused_elementwise_f32_to_bf16_in4_gaudi2_o_start, &_binary___fused_elementwise_f32_to_bf16_in4_gaudi2_o_end}
+    },
+    {
+        {&_binary___fused_elementwise_bf16_to_f32_in1_gaudi2_o_start, &_binary___fused_elementwise_bf16_to_f32_in1_gaudi2_o_end},
+        {&_binary___fused_elementwise_bf16_to_f32_in2_gaudi2_o_start, &_binary___fused_elementwise_bf16_to_f32_in2_gaudi2_o_end},
+        {&_binary___fused_elementwise_bf16_to_f32_in3_gaudi2_o_start, &_binary___fused_elementwise_bf16_to_f32_in3_gaudi2_o_end},
+        {&_binary___fused_elementwise_bf16_to_f32_in4_gaudi2_o_start, &_binary___fused_elementwise_bf16_to_f32_in4_gaudi2_o_end}
+    },
+    {
+        {&_binary___fused_elementwise_bf16_to_bf16_in1_gaudi2_o_start, &_binary___fused_elementwise_bf16_to_bf16_in1_gaudi2_o_end},
+        {&_binary___fused_elementwise_bf16_to_bf16_in2_gaudi2_o_start, &_binary___fused_elementwise_bf16_to_bf16_in2_gaudi2_o_end},
+        {&_binary___fused_elementwise_bf16_to_bf16_in3_gaudi2_o_start, &_binary___fused_elementwise_bf16_to_bf16_in3_gaudi2_o_end},
+        {&_binary___fused_elementwise_bf16_to_bf16_in4_gaudi2_o_start, &_binary___fused_elementwise_bf16_to_bf16_in4_gaudi2_o_end}
+    }
+};
+
+static const char* const c_fusedModeNames[] = {
+    "f32_to_f32",
+    "f32_to_bf16",
+    "bf16_to_f32",
+    "bf16_to_bf16"
+};
+
+static const tpc_lib_api::TensorDataType c_fusedInTypes[] = {
+    tpc_lib_api::DATA_F32,
+    tpc_lib_api::DATA_F32,
+    tpc_lib_api::DATA_BF16,
+    tpc_lib_api::DATA_BF16
+};
+
+static const tpc_lib_api::TensorDataType c_fusedOutTypes[] = {
+    tpc_lib_api::DATA_F32,
+    tpc_lib_api::DATA_BF16,
+    tpc_lib_api::DATA_F32,
+    tpc_lib_api::DATA_BF16
+};
+
+tpc_lib_api::GlueCodeReturn FusedElementwiseGaudi2::GetKernelName(
+        char kernelName [tpc_lib_api::MAX_NODE_NAME], FusedElementwise_mode_t mode)
+{
+    if (mode >= fused_mode_count)
+        return tpc_lib_api::GLUE_NODE_NOT_FOUND;
+    snprintf(kernelName, tpc_lib_api::MAX_NODE_NAME, "custom_fused_elementwise_%s_gaudi2",
+             c_fusedModeNames[mode]);
+    return tpc_lib_api::GLUE_SUCCESS;
+}
+
+tpc_lib_api::GlueCodeReturn FusedElementwiseGaudi2::GetGcDefinitions(
+        tpc_lib_api::HabanaKernelParams* in_defs,
+        tpc_lib_api::HabanaKernelInstantiation* out_defs)
+{
+    tpc_lib_api::GlueCodeReturn retVal;
+    FusedElementwiseParams* def = static_cast<FusedElementwiseParams*>(in_defs->nodeParams.nodeParams);
+
+    /*************************************************************************************
+    *   Stage I - validate input
+    **************************************************************************************/
+    if (m_mode >= fused_mode_count)
+    {
+        return tpc_lib_api::GLUE_NODE_NOT_FOUND;
+    }
+
+    //validate correct amount of input tensors
+    const unsigned inputNr = in_defs->inputTensorNr;
+    if (inputNr < 1 || inputNr > (unsigned)c_maxInputs)
+    {
+        in_defs->inputTensorNr  = inputNr < 1 ? 1 : c_maxInputs;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_COUNT;
+    }
+    //validate correct amount of output tensors
+    if (in_defs->outputTensorNr != 1)
+    {
+        in_defs->outputTensorNr  = 1;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_COUNT;
+    }
+    if (def == nullptr || def->opCount < 0 || def->opCount > c_maxOps)
+    {
+        return tpc_lib_api::GLUE_UNSUPPORTED_LAYER_CONFIGURATION;
+    }
+
+    // validate the program, every operand must exist
+    for (int i = 0; i < def->opCount; i++)
+    {
+        const int op = def->ops[i] & 0xff;
+        const int operand = (def->ops[i] >> 8) & 0xff;
+        if ((def->ops[i] >> 16) != 0 || op >= fused_op_count)
+        {
+            return tpc_lib_api::GLUE_UNSUPPORTED_LAYER_CONFIGURATION;
+        }
+        if (op <= fused_min_input && operand >= (int)inputNr)
+        {
+            return tpc_lib_api::GLUE_UNSUPPORTED_LAYER_CONFIGURATION;
+        }
+        if (op >= fused_add_scalar && op <= fused_min_scalar && operand >= c_maxImms)
+        {
+            return tpc_lib_api::GLUE_UNSUPPORTED_LAYER_CONFIGURATION;
+        }
+        if (op >= fused_relu && operand != 0)
+        {
+            return tpc_lib_api::GLUE_UNSUPPORTED_LAYER_CONFIGURATION;
+        }
+    }
+
+    // validate input and output data type
+    for (unsigned i = 0; i < inputNr; i++)
+    {
+        if (in_defs->inputTensors[i].geometry.dataType != c_fusedInTypes[m_mode])
+        {
+            in_defs->inputTensors[i].geometry.dataType = c_fusedInTypes[m_mode];
+            return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+        }
+    }
+    if (in_defs->outputTensors[0].geometry.dataType != c_fusedOutTypes[m_mode])
+    {
+        in_defs->outputTensors[0].geometry.dataType = c_fusedOutTypes[m_mode];
+        return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+    }
+
+    // the ofm is the union of the input shapes, every input dim is the ofm
+    // dim or 1 and dims past the rank of an input are 1
+    uint64_t ifmSizes[c_maxInputs][gcapi::MAX_TENSOR_DIM];
+    uint64_t ofmSizes[gcapi::MAX_TENSOR_DIM] = {1, 1, 1, 1, 1};
+    unsigned dims = 0;
+    for (unsigned i = 0; i < inputNr; i++)
+    {
+        const tpc_lib_api::Tensor* ifm = &in_defs->inputTensors[i];
+        if (ifm->geometry.dims < 1 || ifm->geometry.dims > gcapi::MAX_TENSOR_DIM)
+        {
+            return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+        }
+        for (unsigned dim = 0; dim < gcapi::MAX_TENSOR_DIM; dim++)
+        {
+            ifmSizes[i][dim] = dim < ifm->geometry.dims ? ifm->geometry.maxSizes[dim] : 1;
+            if (ifmSizes[i][dim] != 1 && ofmSizes[dim] != 1 && ifmSizes[i][dim] != ofmSizes[dim])
+            {
+                return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+            }
+            ofmSizes[dim] = ifmSizes[i][dim] > ofmSizes[dim] ? ifmSizes[i][dim] : ofmSizes[dim];
+        }
+        dims = ifm->geometry.dims > dims ? ifm->geometry.dims : dims;
+    }
+
+    // 5 broadcast bits per input
+    int bcastMasks = 0;
+    for (unsigned i = 0; i < inputNr; i++)
+    {
+        for (unsigned dim = 0; dim < gcapi::MAX_TENSOR_DIM; dim++)
+        {
+            bcastMasks |= (ifmSizes[i][dim] != ofmSizes[dim]) << (i * gcapi::MAX_TENSOR_DIM + dim);
+        }
+    }
+
+    // verify that output feature map dimension are correct
+    if (in_defs->outputTensors[0].geometry.dims != dims ||
+        memcmp(in_defs->outputTensors[0].geometry.maxSizes, ofmSizes, dims * sizeof(uint64_t)) != 0)
+    {
+        in_defs->outputTensors[0].geometry.dims = dims;
+        memcpy(in_defs->outputTensors[0].geometry.maxSizes, ofmSizes, sizeof(ofmSizes));
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_SIZE;
+    }
+
+    /*************************************************************************************
+    *    Stage II -  Define index space geometry. The index space follows the ofm,
+    *    c_elementsPerMember elements of dim 0 per member.
+    **************************************************************************************/
+    out_defs->indexSpaceRank = gcapi::MAX_TENSOR_DIM;
+    out_defs->indexSpaceGeometry[0] = (ofmSizes[0] + c_elementsPerMember - 1) / c_elementsPerMember;
+    for (unsigned dim = 1; dim < out_defs->indexSpaceRank; dim++)
+    {
+        out_defs->indexSpaceGeometry[dim] = ofmSizes[dim];
+    }
+
+    /*************************************************************************************
+    *    Stage III -  Define index space mapping. Broadcast dims of an input are read
+    *    at 0 by every member.
+    **************************************************************************************/
+    for (unsigned i = 0; i <= inputNr; i++)
+    {
+        // the ofm comes last and broadcasts nothing
+        tpc_lib_api::TensorAccessPattern* pattern = i < inputNr ?
+                &out_defs->inputTensorAccessPattern[i] : &out_defs->outputTensorAccessPattern[0];
+        const int mask = i < inputNr ? (bcastMasks >> (i * gcapi::MAX_TENSOR_DIM)) & 0x1f : 0;
+        for (unsigned dim = 0; dim < out_defs->indexSpaceRank; dim++)
+        {
+            const int a = dim == 0 ? c_elementsPerMember : 1;
+            const bool bcast = (mask >> dim) & 1;
+
+            // f_start f(i) = a*i + 0;
+            // f_end   f(i) = a*i + (a - 1);
+            pattern->mapping[dim].indexSpaceDim = dim;
+            pattern->mapping[dim].a             = bcast ? 0 : a;
+            pattern->mapping[dim].start_b       = 0;
+            pattern->mapping[dim].end_b         = bcast ? 0 : a - 1;
+        }
+    }
+
+    /*************************************************************************************
+    *    Stage IV -  define scalar parameters: opCount, bcastMasks, ops, imms. Unused
+    *    ops and imms are passed as 0.
+    **************************************************************************************/
+    int32_t ops[c_maxOps] = {0};
+    memcpy(ops, def->ops, def->opCount * sizeof(int32_t));
+    out_defs->kernel.paramsNr = 2 + c_maxOps + c_maxImms;
+    memcpy(&(out_defs->kernel.scalarParams[0]), &def->opCount, sizeof(int32_t));
+    memcpy(&(out_defs->kernel.scalarParams[1]), &bcastMasks, sizeof(int32_t));
+    memcpy(&(out_defs->kernel.scalarParams[2]), ops, sizeof(ops));
+    memcpy(&(out_defs->kernel.scalarParams[2 + c_maxOps]), def->imms, sizeof(def->imms));
+
+    /*************************************************************************************
+    *    Stage V -  Load ISA into the descriptor.
+    **************************************************************************************/
+    unsigned char* binary_kernel = c_fusedElementwiseBinaries[m_mode][inputNr - 1][0];
+    unsigned IsaSize = (c_fusedElementwiseBinaries[m_mode][inputNr - 1][1] -
+                        c_fusedElementwiseBinaries[m_mode][inputNr - 1][0]);
+    unsigned givenBinarySize = out_defs->kernel.elfSize;
+    out_defs->kernel.elfSize = IsaSize;
+
+    if (givenBinarySize >= IsaSize)
+    {
+        memcpy (out_defs->kernel.kernelElf, binary_kernel, IsaSize);
+    }
+    else
+    {
+        retVal = tpc_lib_api::GLUE_INSUFFICIENT_ELF_BUFFER;
+        return retVal;
+    }
+
+    return tpc_lib_api::GLUE_SUCCESS;
+}
@@ -0,0 +1,92 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef _FUSED_ELEMENTWISE_GAUDI2_HPP
+#define _FUSED_ELEMENTWISE_GAUDI2_HPP
+
+#include "gc_interface.h"
+#include "tpc_kernel_lib_interface.h"
+
+// Runs a chain of elementwise ops over 1 to 4 inputs in one kernel, e.g.
+// add -> relu6 -> mul by scalar -> cast, without a memory round trip per
+// op. The accumulator starts as input 0, every op updates it in f32 and the
+// ofm gets it in the output type of the mode. Inputs broadcast numpy style
+// against the union of their shapes.
+class FusedElementwiseGaudi2
+{
+public:
+    // input and output data type, all inputs share one type
+    typedef enum _FusedElementwise_mode_t
+    {
+        fused_f32_to_f32,
+        fused_f32_to_bf16,
+        fused_bf16_to_f32,
+        fused_bf16_to_bf16,
+        fused_mode_count
+    } FusedElementwise_mode_t;
+
+    // acc = acc op operand, as the FUSED_* opcodes of fused_elementwise.h
+    typedef enum _FusedOp_t
+    {
+        fused_add_input,    // operand: input index
+        fused_sub_input,
+        fused_mul_input,
+        fused_max_input,
+        fused_min_input,
+        fused_add_scalar,   // operand: index into imms
+        fused_mul_scalar,
+        fused_max_scalar,
+        fused_min_scalar,
+        fused_relu,         // no operand
+        fused_relu6,
+        fused_op_count
+    } FusedOp_t;
+
+    static const int c_maxInputs = 4;
+    static const int c_maxOps = 12;
+    static const int c_maxImms = 8;
+
+    FusedElementwiseGaudi2(FusedElementwise_mode_t mode=fused_f32_to_f32) {m_mode = mode;}
+    virtual ~FusedElementwiseGaudi2() {}
+
+    virtual tpc_lib_api::GlueCodeReturn GetGcDefinitions(
+            tpc_lib_api::HabanaKernelParams* in_defs,
+            tpc_lib_api::HabanaKernelInstantiation* out_defs);
+
+    virtual tpc_lib_api::GlueCodeReturn GetKernelName(
+            char kernelName [tpc_lib_api::MAX_NODE_NAME], FusedElementwise_mode_t mode);
+
+    // This struct is common between the TPC kernel writer and the framework
+    // layer writer.
+    struct FusedElementwiseParams
+    {
+        int32_t opCount;
+        int32_t ops[c_maxOps];      // MakeOp(op, operand)
+        float   imms[c_maxImms];
+    };
+
+    static int32_t MakeOp(FusedOp_t op, int operand) { return (int32_t)op | (operand << 8); }
+
+    // elements of dim 0 per index space member, one f32 pair of vectors
+    static const int c_elementsPerMember = 128;
+
+private:
+    FusedElementwise_mode_t m_mode;
+    FusedElementwiseGaudi2(const FusedElementwiseGaudi2& other) = delete;
+    FusedElementwiseGaudi2& operator=(const FusedElementwiseGaudi2& other) = delete;
+};
+
+#endif //_FUSED_ELEMENTWISE_GAUDI2_HPP
@@ -0,0 +1,276 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cstring>
+#include "grad_norm_gaudi2.hpp"
+
+extern unsigned char _binary___grad_norm_f32_gaudi2_o_start;
+extern unsigned char _binary___grad_norm_f32_gaudi2_o_end;
+extern unsigned char _binary___grad_norm_bf16_gaudi2_o_start;
+extern unsigned char _binary___grad_norm_bf16_gaudi2_o_end;
+extern unsigned char _binary___grad_norm_multi_f32_gaudi2_o_start;
+extern unsigned char _binary___grad_norm_multi_f32_gaudi2_o_end;
+extern unsigned char _binary___grad_norm_multi_bf16_gaudi2_o_start;
+extern unsigned char _binary___grad_norm_multi_bf16_gaudi2_o_end;
+
+static const char c_gradNormKernelNames[][tpc_lib_api::MAX_NODE_NAME] = {
+    "custom_grad_norm_f32_gaudi2",
+    "custom_grad_norm_bf16_gaudi2",
+    "custom_grad_norm_multi_f32_gaudi2",
+    "custom_grad_norm_multi_bf16_gaudi2"
+};
+
+// vectors of dim 0 per index space member, GRAD_NORM_VECTORS in the kernel
+static const int c_vectorsPerMember = 4;
+
+tpc_lib_api::GlueCodeReturn GradNormGaudi2::GetKernelName(
+        char kernelName [tpc_lib_api::MAX_NODE_NAME], GradNorm_mode_t mode)
+{
+    if (mode > grad_norm_multi_bf16)
+        return tpc_lib_api::GLUE_NODE_NOT_FOUND;
+    strcpy(kernelName, c_gradNormKernelNames[mode]);
+    return tpc_lib_api::GLUE_SUCCESS;
+}
+
+int GradNormGaudi2::ElementsPerMember(GradNorm_mode_t mode)
+{
+    const bool bf16 = (mode == grad_norm_bf16 || mode == grad_norm_multi_bf16);
+    return (bf16 ? 128 : 64) * c_vectorsPerMember;
+}
+
+bool GradNormGaudi2::IsMultiTensor() const
+{
+    return m_mode == grad_norm_multi_f32 || m_mode == grad_norm_multi_bf16;
+}
+
+bool GradNormGaudi2::IsBF16() const
+{
+    return m_mode == grad_norm_bf16 || m_mode == grad_norm_multi_bf16;
+}
+
+tpc_lib_api::GlueCodeReturn GradNormGaudi2::GetGcDefinitions(
+        tpc_lib_api::HabanaKernelParams* in_defs,
+        tpc_lib_api::HabanaKernelInstantiation* out_defs)
+{
+    tpc_lib_api::GlueCodeReturn retVal;
+
+    // Tensor order is a convention between the TPC kernel writer and the
+    // framework layer writer:
+    //   inputs  : grad, chunkTensor {numChunks} i32 (multi tensor modes)
+    //   outputs : stats {2} f32, [sum of squares, non-finite count],
+    //             tensorStats {2, numTensors} f32 (multi tensor modes)
+    // The outputs are accumulated into and must be zeroed before the launch.
+    // In the multi tensor modes grad is the flat chunked list of the multi
+    // tensor AdamW step, and every chunkTensor entry is below numTensors.
+
+    /*************************************************************************************
+    *   Stage I - validate input
+    **************************************************************************************/
+    const unsigned tensorNr = IsMultiTensor() ? 2 : 1;
+    //validate correct amount of input tensors
+    if (in_defs->inputTensorNr != tensorNr)
+    {
+        in_defs->inputTensorNr  = tensorNr;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_COUNT;
+    }
+    //validate correct amount of output tensors
+    if (in_defs->outputTensorNr != tensorNr)
+    {
+        in_defs->outputTensorNr  = tensorNr;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_COUNT;
+    }
+
+    // validate input and output data type
+    const tpc_lib_api::TensorDataType dataType =
+            IsBF16() ? tpc_lib_api::DATA_BF16 : tpc_lib_api::DATA_F32;
+    if (in_defs->inputTensors[0].geometry.dataType != dataType)
+    {
+        in_defs->inputTensors[0].geometry.dataType = dataType;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+    }
+    if (IsMultiTensor() && in_defs->inputTensors[1].geometry.dataType != tpc_lib_api::DATA_I32)
+    {
+        in_defs->inputTensors[1].geometry.dataType = tpc_lib_api::DATA_I32;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+    }
+    for (unsigned i = 0; i < tensorNr; i++)
+    {
+        if (in_defs->outputTensors[i].geometry.dataType != tpc_lib_api::DATA_F32)
+        {
+            in_defs->outputTensors[i].geometry.dataType = tpc_lib_api::DATA_F32;
+            return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+        }
+    }
+
+    const unsigned dims = in_defs->inputTensors[0].geometry.dims;
+    if (dims < 1 || dims > 4 || (IsMultiTensor() && dims != 1))
+    {
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+    }
+    uint64_t inputSizes[4] = {1, 1, 1, 1};
+    memcpy(inputSizes, in_defs->inputTensors[0].geometry.maxSizes, dims * sizeof(uint64_t));
+
+    // verify that output feature map dimension are correct
+    if (in_defs->outputTensors[0].geometry.dims != 1 ||
+        in_defs->outputTensors[0].geometry.maxSizes[0] != c_statsSize)
+    {
+        in_defs->outputTensors[0].geometry.dims = 1;
+        in_defs->outputTensors[0].geometry.maxSizes[0] = c_statsSize;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_SIZE;
+    }
+
+    const int depthStep = ElementsPerMember(m_mode);
+    int32_t chunkSize = 0;
+    uint64_t numChunks = 0;
+    uint64_t numTensors = 0;
+    if (IsMultiTensor())
+    {
+        const GradNormParams* def = static_cast<const GradNormParams*>(in_defs->nodeParams.nodeParams);
+        // a member never straddles two chunks
+        if (def == nullptr || def->chunkSize <= 0 || def->chunkSize % depthStep != 0)
+        {
+            return tpc_lib_api::GLUE_UNSUPPORTED_LAYER_CONFIGURATION;
+        }
+        chunkSize = def->chunkSize;
+        numChunks = (inputSizes[0] + chunkSize - 1) / chunkSize;
+        const tpc_lib_api::Tensor& chunkTensor = in_defs->inputTensors[1];
+        if (chunkTensor.geometry.dims != 1 || chunkTensor.geometry.maxSizes[0] != numChunks)
+        {
+            return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+        }
+
+        tpc_lib_api::Tensor& tensorStats = in_defs->outputTensors[1];
+        numTensors = tensorStats.geometry.maxSizes[1];
+        if (tensorStats.geometry.dims != 2 ||
+            tensorStats.geometry.maxSizes[0] != c_statsSize || numTensors == 0)
+        {
+            tensorStats.geometry.dims = 2;
+            tensorStats.geometry.maxSizes[0] = c_statsSize;
+            return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_SIZE;
+        }
+    }
+
+    /*************************************************************************************
+    *    Stage II -  Define index space geometry. Elementwise over the gradient, every
+    *    TPC adds its partial sums once at the end (and once per chunk for the list).
+    **************************************************************************************/
+    out_defs->indexSpaceRank = 4;
+    out_defs->indexSpaceGeometry[0] = (inputSizes[0] + depthStep - 1) / depthStep;
+    out_defs->indexSpaceGeometry[1] = inputSizes[1];
+    out_defs->indexSpaceGeometry[2] = inputSizes[2];
+    out_defs->indexSpaceGeometry[3] = inputSizes[3];
+
+    /*************************************************************************************
+    *    Stage III -  Define index space mapping
+    **************************************************************************************/
+    // f_start f(i) = depthStep*i + 0;
+    // f_end   f(i) = depthStep*i + (depthStep - 1);
+    out_defs->inputTensorAccessPattern[0].mapping[0].indexSpaceDim = 0;
+    out_defs->inputTensorAccessPattern[0].mapping[0].a             = depthStep;
+    out_defs->inputTensorAccessPattern[0].mapping[0].start_b       = 0;
+    out_defs->inputTensorAccessPattern[0].mapping[0].end_b         = depthStep - 1;
+
+    // f_start f(i) = 1*i + 0;
+    // f_end   f(i) = 1*i + 0;
+    for (unsigned dim = 1; dim < 4; dim++)
+    {
+        out_defs->inputTensorAccessPattern[0].mapping[dim].indexSpaceDim = dim;
+        out_defs->inputTensorAccessPattern[0].mapping[dim].a             = 1;
+        out_defs->inputTensorAccessPattern[0].mapping[dim].start_b       = 0;
+        out_defs->inputTensorAccessPattern[0].mapping[dim].end_b         = 0;
+    }
+
+    // every member adds into the whole stats tensor
+    // f_start f(i) = 0;
+    // f_end   f(i) = 1;
+    out_defs->outputTensorAccessPattern[0].mapping[0].indexSpaceDim = 0;
+    out_defs->outputTensorAccessPattern[0].mapping[0].a             = 0;
+    out_defs->outputTensorAccessPattern[0].mapping[0].start_b       = 0;
+    out_defs->outputTensorAccessPattern[0].mapping[0].end_b         = c_statsSize - 1;
+
+    if (IsMultiTensor())
+    {
+        // f_start f(i) = 0;
+        // f_end   f(i) = numChunks - 1 (small table, read with scalar loads)
+        out_defs->inputTensorAccessPattern[1].mapping[0].indexSpaceDim = 0;
+        out_defs->inputTensorAccessPattern[1].mapping[0].a             = 0;
+        out_defs->inputTensorAccessPattern[1].mapping[0].start_b       = 0;
+        out_defs->inputTensorAccessPattern[1].mapping[0].end_b         = numChunks - 1;
+
+        // any member may add into any tensor of the list
+        // f_start f(i) = 0;
+        // f_end   f(i) = size - 1;
+        const uint64_t tensorStatsSizes[2] = {c_statsSize, numTensors};
+        for (unsigned dim = 0; dim < 2; dim++)
+        {
+            out_defs->outputTensorAccessPattern[1].mapping[dim].indexSpaceDim = 0;
+            out_defs->outputTensorAccessPattern[1].mapping[dim].a             = 0;
+            out_defs->outputTensorAccessPattern[1].mapping[dim].start_b       = 0;
+            out_defs->outputTensorAccessPattern[1].mapping[dim].end_b         = tensorStatsSizes[dim] - 1;
+        }
+    }
+
+    /*************************************************************************************
+    *    Stage IV -  define scalar parameters
+    **************************************************************************************/
+    out_defs->kernel.paramsNr = 0;
+    if (IsMultiTensor())
+    {
+        out_defs->kernel.paramsNr = 1;
+        memcpy(&(out_defs->kernel.scalarParams[0]), &chunkSize, sizeof(int32_t));
+    }
+
+    /*************************************************************************************
+    *    Stage V -  Load ISA into the descriptor.
+    **************************************************************************************/
+    unsigned IsaSize = (&_binary___grad_norm_f32_gaudi2_o_end - &_binary___grad_norm_f32_gaudi2_o_start);
+    unsigned char *binary_kernel = &_binary___grad_norm_f32_gaudi2_o_start;
+    switch (m_mode)
+    {
+        case grad_norm_f32:
+            IsaSize = (&_binary___grad_norm_f32_gaudi2_o_end - &_binary___grad_norm_f32_gaudi2_o_start);
+            binary_kernel = &_binary___grad_norm_f32_gaudi2_o_start;
+            break;
+        case grad_norm_bf16:
+            IsaSize = (&_binary___grad_norm_bf16_gaudi2_o_end - &_binary___grad_norm_bf16_gaudi2_o_start);
+            binary_kernel = &_binary___grad_norm_bf16_gaudi2_o_start;
+            break;
+        case grad_norm_multi_f32:
+            IsaSize = (&_binary___grad_norm_multi_f32_gaudi2_o_end - &_binary___grad_norm_multi_f32_gaudi2_o_start);
+            binary_kernel = &_binary___grad_norm_multi_f32_gaudi2_o_start;
+            break;
+        case grad_norm_multi_bf16:
+            IsaSize = (&_binary___grad_norm_multi_bf16_gaudi2_o_end - &_binary___grad_norm_multi_bf16_gaudi2_o_start);
+            binary_kernel = &_binary___grad_norm_multi_bf16_gaudi2_o_start;
+            break;
+        default:
+            break;
+    }
+
+    unsigned givenBinarySize = out_defs->kernel.elfSize;
+    out_defs->kernel.elfSize = IsaSize;
+    if (givenBinarySize >= IsaSize)
+    {
+        memcpy (out_defs->kernel.kernelElf, binary_kernel, IsaSize);
+    }
+    else
+    {
+        retVal = tpc_lib_api::GLUE_INSUFFICIENT_ELF_BUFFER;
+        return retVal;
+    }
+
+    return tpc_lib_api::GLUE_SUCCESS;
+}
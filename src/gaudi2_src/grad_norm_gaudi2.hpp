@@ -0,0 +1,67 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef _GRAD_NORM_GAUDI2_HPP
+#define _GRAD_NORM_GAUDI2_HPP
+
+#include "gc_interface.h"
+#include "tpc_kernel_lib_interface.h"
+
+class GradNormGaudi2
+{
+public:
+    typedef enum _GradNorm_mode_t
+    {
+        grad_norm_f32,
+        grad_norm_bf16,
+        grad_norm_multi_f32,
+        grad_norm_multi_bf16
+    } GradNorm_mode_t;
+
+    GradNormGaudi2(GradNorm_mode_t mode=grad_norm_f32) {m_mode = mode;}
+    virtual ~GradNormGaudi2() {}
+
+    virtual tpc_lib_api::GlueCodeReturn GetGcDefinitions(
+            tpc_lib_api::HabanaKernelParams* in_defs,
+            tpc_lib_api::HabanaKernelInstantiation* out_defs);
+
+    virtual tpc_lib_api::GlueCodeReturn GetKernelName(
+            char kernelName [tpc_lib_api::MAX_NODE_NAME], GradNorm_mode_t mode);
+
+    // This struct is common between the TPC kernel writer and the framework
+    // layer writer. It is only read by the multi tensor modes.
+    struct GradNormParams
+    {
+        int32_t chunkSize;  // same chunking as the multi tensor AdamW step
+    };
+
+    // Layout of the stats outputs, dim 0 of the per tensor stats too.
+    enum { c_sumSquares = 0, c_nonFiniteCount = 1, c_statsSize = 2 };
+
+    // Elements of dim 0 handled by one index space member, chunkSize of the
+    // multi tensor modes must be a multiple of it.
+    static int ElementsPerMember(GradNorm_mode_t mode);
+
+private:
+    bool IsMultiTensor() const;
+    bool IsBF16() const;
+
+    GradNorm_mode_t m_mode;
+    GradNormGaudi2(const GradNormGaudi2& other) = delete;
+    GradNormGaudi2& operator=(const GradNormGaudi2& other) = delete;
+};
+
+#endif //_GRAD_NORM_GAUDI2_HPP
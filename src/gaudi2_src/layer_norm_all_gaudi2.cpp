@@ -0,0 +1,546 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cstring>
+#include "layer_norm_all_gaudi2.hpp"
+
+extern unsigned char _binary___layer_norm_fwd_f32_gaudi2_o_start;
+extern unsigned char _binary___layer_norm_fwd_f32_gaudi2_o_end;
+extern unsigned char _binary___layer_norm_fwd_bf16_gaudi2_o_start;
+extern unsigned char _binary___layer_norm_fwd_bf16_gaudi2_o_end;
+extern unsigned char _binary___layer_norm_residual_fwd_f32_gaudi2_o_start;
+extern unsigned char _binary___layer_norm_residual_fwd_f32_gaudi2_o_end;
+extern unsigned char _binary___layer_norm_residual_fwd_bf16_gaudi2_o_start;
+extern unsigned char _binary___layer_norm_residual_fwd_bf16_gaudi2_o_end;
+extern unsigned char _binary___layer_norm_bwd_f32_gaudi2_o_start;
+extern unsigned char _binary___layer_norm_bwd_f32_gaudi2_o_end;
+extern unsigned char _binary___layer_norm_bwd_bf16_gaudi2_o_start;
+extern unsigned char _binary___layer_norm_bwd_bf16_gaudi2_o_end;
+extern unsigned char _binary___rms_norm_fwd_f32_gaudi2_o_start;
+extern unsigned char _binary___rms_norm_fwd_f32_gaudi2_o_end;
+extern unsigned char _binary___rms_norm_fwd_bf16_gaudi2_o_start;
+extern unsigned char _binary___rms_norm_fwd_bf16_gaudi2_o_end;
+extern unsigned char _binary___rms_norm_residual_fwd_f32_gaudi2_o_start;
+extern unsigned char _binary___rms_norm_residual_fwd_f32_gaudi2_o_end;
+extern unsigned char _binary___rms_norm_residual_fwd_bf16_gaudi2_o_start;
+extern unsigned char _binary___rms_norm_residual_fwd_bf16_gaudi2_o_end;
+extern unsigned char _binary___rms_norm_bwd_f32_gaudi2_o_start;
+extern unsigned char _binary___rms_norm_bwd_f32_gaudi2_o_end;
+extern unsigned char _binary___rms_norm_bwd_bf16_gaudi2_o_start;
+extern unsigned char _binary___rms_norm_bwd_bf16_gaudi2_o_end;
+extern unsigned char _binary___norm_bwd_param_reduce_bf16_gaudi2_o_start;
+extern unsigned char _binary___norm_bwd_param_reduce_bf16_gaudi2_o_end;
+
+static const char c_layerNormKernelNames[][tpc_lib_api::MAX_NODE_NAME] = {
+    "custom_layer_norm_fwd_f32_gaudi2",
+    "custom_layer_norm_fwd_bf16_gaudi2",
+    "custom_layer_norm_residual_fwd_f32_gaudi2",
+    "custom_layer_norm_residual_fwd_bf16_gaudi2",
+    "custom_layer_norm_bwd_f32_gaudi2",
+    "custom_layer_norm_bwd_bf16_gaudi2",
+    "custom_rms_norm_fwd_f32_gaudi2",
+    "custom_rms_norm_fwd_bf16_gaudi2",
+    "custom_rms_norm_residual_fwd_f32_gaudi2",
+    "custom_rms_norm_residual_fwd_bf16_gaudi2",
+    "custom_rms_norm_bwd_f32_gaudi2",
+    "custom_rms_norm_bwd_bf16_gaudi2",
+    "custom_norm_bwd_param_reduce_bf16_gaudi2"
+};
+
+// Shape classes of the tensors used by the normalization kernels.
+typedef enum _NormTensor_t
+{
+    norm_row_tensor,    // same shape as the normalized input
+    norm_param_tensor,  // {C}, gamma / beta and their gradients
+    norm_stat_tensor,   // f32 {1, W, H, B}, mean / rstd
+    norm_partial_tensor // f32 {ALIGN(C, 128), G1, H, B}, bf16 bwd gradient partials
+} NormTensor_t;
+
+tpc_lib_api::GlueCodeReturn LayerNormAllGaudi2::GetKernelName(
+        char kernelName [tpc_lib_api::MAX_NODE_NAME], LayerNorm_mode_t mode)
+{
+    if (mode > norm_bwd_param_reduce_bf16)
+        return tpc_lib_api::GLUE_NODE_NOT_FOUND;
+    strcpy(kernelName, c_layerNormKernelNames[mode]);
+    return tpc_lib_api::GLUE_SUCCESS;
+}
+
+bool LayerNormAllGaudi2::IsRmsNorm() const
+{
+    return m_mode >= rms_norm_fwd_f32 && m_mode <= rms_norm_bwd_bf16;
+}
+
+bool LayerNormAllGaudi2::IsResidual() const
+{
+    return m_mode == layer_norm_residual_fwd_f32 || m_mode == layer_norm_residual_fwd_bf16 ||
+           m_mode == rms_norm_residual_fwd_f32 || m_mode == rms_norm_residual_fwd_bf16;
+}
+
+bool LayerNormAllGaudi2::IsBackward() const
+{
+    return m_mode == layer_norm_bwd_f32 || m_mode == layer_norm_bwd_bf16 ||
+           m_mode == rms_norm_bwd_f32 || m_mode == rms_norm_bwd_bf16;
+}
+
+bool LayerNormAllGaudi2::IsBF16() const
+{
+    // bf16 modes follow their f32 twin in the enum
+    return m_mode == norm_bwd_param_reduce_bf16 || (m_mode % 2) == 1;
+}
+
+unsigned LayerNormAllGaudi2::GetBwdRowsPerMember(const uint64_t rowSizes[], unsigned dims)
+{
+    uint64_t rowGroups = (rowSizes[1] + (c_unrollCount - 1)) / c_unrollCount;
+    uint64_t planes = (dims > 2 ? rowSizes[2] : 1) * (dims > 3 ? rowSizes[3] : 1);
+    // split dim 1 only as far as needed to reach c_bwdMemberTarget members
+    uint64_t members = (c_bwdMemberTarget + planes - 1) / planes;
+    if (members > rowGroups)
+        members = rowGroups;
+    if (members < 1)
+        members = 1;
+    uint64_t groupsPerMember = (rowGroups + members - 1) / members;
+    return (unsigned)(groupsPerMember * c_unrollCount);
+}
+
+void LayerNormAllGaudi2::GetParamPartialSizes(const uint64_t rowSizes[], unsigned dims,
+                                              uint64_t partialSizes[])
+{
+    uint64_t rowsPerMember = GetBwdRowsPerMember(rowSizes, dims);
+    memcpy(partialSizes, rowSizes, dims * sizeof(uint64_t));
+    partialSizes[0] = (rowSizes[0] + (c_partialAlign - 1)) / c_partialAlign * c_partialAlign;
+    partialSizes[1] = (rowSizes[1] + rowsPerMember - 1) / rowsPerMember;
+}
+
+tpc_lib_api::GlueCodeReturn LayerNormAllGaudi2::GetGcDefinitions(
+        tpc_lib_api::HabanaKernelParams* in_defs,
+        tpc_lib_api::HabanaKernelInstantiation* out_defs)
+{
+    if (m_mode == norm_bwd_param_reduce_bf16)
+    {
+        return GetParamReduceDefinitions(in_defs, out_defs);
+    }
+
+    tpc_lib_api::GlueCodeReturn retVal;
+    LayerNormParams* def = static_cast<LayerNormParams*>(in_defs->nodeParams.nodeParams);
+
+    // Tensor order is a convention between the TPC kernel writer and the
+    // framework layer writer:
+    //   fwd inputs  : ifm, gamma, [beta], [residual]
+    //   fwd outputs : ofm, [mean], rstd, [residualOut]
+    //   bwd inputs  : gradOut, ifm, gamma, [mean], rstd
+    //   bwd outputs : gradIn, gradGamma, [gradBeta]
+    // mean / beta are LayerNorm only, the residual tensors belong to the
+    // fused residual modes. The bf16 backward modes output f32 gradient
+    // partials instead of gradGamma / gradBeta, norm_bwd_param_reduce_bf16
+    // turns each of them into the bf16 gradient.
+    NormTensor_t inputKind[5];
+    NormTensor_t outputKind[4];
+    unsigned inputNr = 0;
+    unsigned outputNr = 0;
+    if (!IsBackward())
+    {
+        inputKind[inputNr++] = norm_row_tensor;
+        inputKind[inputNr++] = norm_param_tensor;
+        if (!IsRmsNorm())
+            inputKind[inputNr++] = norm_param_tensor;
+        if (IsResidual())
+            inputKind[inputNr++] = norm_row_tensor;
+
+        outputKind[outputNr++] = norm_row_tensor;
+        if (!IsRmsNorm())
+            outputKind[outputNr++] = norm_stat_tensor;
+        outputKind[outputNr++] = norm_stat_tensor;
+        if (IsResidual())
+            outputKind[outputNr++] = norm_row_tensor;
+    }
+    else
+    {
+        inputKind[inputNr++] = norm_row_tensor;
+        inputKind[inputNr++] = norm_row_tensor;
+        inputKind[inputNr++] = norm_param_tensor;
+        if (!IsRmsNorm())
+            inputKind[inputNr++] = norm_stat_tensor;
+        inputKind[inputNr++] = norm_stat_tensor;
+
+        NormTensor_t gradKind = IsBF16() ? norm_partial_tensor : norm_param_tensor;
+        outputKind[outputNr++] = norm_row_tensor;
+        outputKind[outputNr++] = gradKind;
+        if (!IsRmsNorm())
+            outputKind[outputNr++] = gradKind;
+    }
+
+    /*************************************************************************************
+    *   Stage I - validate input
+    **************************************************************************************/
+    //validate correct amount of input tensors
+    if (in_defs->inputTensorNr != inputNr)
+    {
+        in_defs->inputTensorNr  = inputNr;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_COUNT;
+    }
+    //validate correct amount of output tensors
+    if (in_defs->outputTensorNr != outputNr)
+    {
+        in_defs->outputTensorNr  = outputNr;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_COUNT;
+    }
+
+    // only the forward modes read the params (epsilon)
+    if (!IsBackward() && def == nullptr)
+    {
+        return tpc_lib_api::GLUE_UNSUPPORTED_LAYER_CONFIGURATION;
+    }
+
+    // the normalized input defines the shape of every other tensor
+    const tpc_lib_api::Tensor* ifm = &in_defs->inputTensors[IsBackward() ? 1 : 0];
+    const unsigned dims = ifm->geometry.dims;
+    if (dims < 2 || dims > 4)
+    {
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+    }
+
+    uint64_t rowSizes[gcapi::MAX_TENSOR_DIM] = {0};
+    uint64_t statSizes[gcapi::MAX_TENSOR_DIM] = {0};
+    uint64_t partialSizes[gcapi::MAX_TENSOR_DIM] = {0};
+    memcpy(rowSizes, ifm->geometry.maxSizes, sizeof(rowSizes));
+    memcpy(statSizes, ifm->geometry.maxSizes, sizeof(statSizes));
+    statSizes[0] = 1;
+    GetParamPartialSizes(rowSizes, dims, partialSizes);
+
+    // validate data type and sizes. row and param tensors follow the mode
+    // data type, mean, rstd and the gradient partials are always f32.
+    const tpc_lib_api::TensorDataType dataType = IsBF16() ? tpc_lib_api::DATA_BF16 : tpc_lib_api::DATA_F32;
+    for (unsigned i = 0; i < inputNr + outputNr; i++)
+    {
+        bool isInput = i < inputNr;
+        tpc_lib_api::Tensor* t = isInput ? &in_defs->inputTensors[i] : &in_defs->outputTensors[i - inputNr];
+        NormTensor_t kind = isInput ? inputKind[i] : outputKind[i - inputNr];
+
+        tpc_lib_api::TensorDataType expectedType =
+                (kind == norm_stat_tensor || kind == norm_partial_tensor) ? tpc_lib_api::DATA_F32 : dataType;
+        if (t->geometry.dataType != expectedType)
+        {
+            t->geometry.dataType = expectedType;
+            return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+        }
+
+        const uint64_t* expected = (kind == norm_row_tensor) ? rowSizes :
+                                   (kind == norm_stat_tensor) ? statSizes : partialSizes;
+        bool sizeOk;
+        if (kind == norm_param_tensor)
+        {
+            sizeOk = (t->geometry.dims == 1) && (t->geometry.maxSizes[0] == rowSizes[0]);
+        }
+        else
+        {
+            sizeOk = (t->geometry.dims == dims) &&
+                     (memcmp(t->geometry.maxSizes, expected, dims * sizeof(uint64_t)) == 0);
+        }
+        if (!sizeOk)
+        {
+            if (isInput)
+                return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+            if (kind != norm_param_tensor)
+            {
+                memcpy(t->geometry.maxSizes, expected, sizeof(rowSizes));
+            }
+            return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_SIZE;
+        }
+    }
+
+    /*************************************************************************************
+    *    Stage II -  Define index space geometry. A single index space is used along
+    *    the normalized dim 0, every forward member owns c_unrollCount complete rows,
+    *    every backward member GetBwdRowsPerMember() rows.
+    **************************************************************************************/
+    const unsigned rowsPerMember = IsBackward() ? GetBwdRowsPerMember(rowSizes, dims) : c_unrollCount;
+    out_defs->indexSpaceRank = 4;
+    out_defs->indexSpaceGeometry[0] = 1;
+    out_defs->indexSpaceGeometry[1] = (rowSizes[1] + (rowsPerMember - 1)) / rowsPerMember;
+    out_defs->indexSpaceGeometry[2] = dims > 2 ? rowSizes[2] : 1;
+    out_defs->indexSpaceGeometry[3] = dims > 3 ? rowSizes[3] : 1;
+
+    /*************************************************************************************
+    *    Stage III -  Define index space mapping
+    **************************************************************************************/
+    for (unsigned i = 0; i < inputNr + outputNr; i++)
+    {
+        bool isInput = i < inputNr;
+        tpc_lib_api::TensorAccessPattern* pattern = isInput ?
+                &out_defs->inputTensorAccessPattern[i] : &out_defs->outputTensorAccessPattern[i - inputNr];
+        NormTensor_t kind = isInput ? inputKind[i] : outputKind[i - inputNr];
+
+        // f_start f(i) = 0;
+        // f_end   f(i) = size[0] - 1 (rows, params and partials), 0 (mean / rstd)
+        // Access is given to the whole row since single indexspace is used
+        pattern->mapping[0].indexSpaceDim = 0;
+        pattern->mapping[0].a             = 0;
+        pattern->mapping[0].start_b       = 0;
+        pattern->mapping[0].end_b         = (kind == norm_stat_tensor) ? 0 :
+                                            (kind == norm_partial_tensor) ? partialSizes[0] - 1 : rowSizes[0] - 1;
+
+        if (kind == norm_param_tensor)
+        {
+            // gamma / beta are read by every member, their gradients are
+            // accumulated by every member with atomic RMW adds.
+            pattern->allRequired = true;
+            for (unsigned dim = 1; dim < out_defs->indexSpaceRank; dim++)
+            {
+                pattern->mapping[dim].indexSpaceDim = dim;
+                pattern->mapping[dim].a             = 0;
+                pattern->mapping[dim].start_b       = 0;
+                pattern->mapping[dim].end_b         = 0;
+            }
+            if (!isInput)
+            {
+                pattern->memsetBeforeExecution = 1;
+            }
+            continue;
+        }
+
+        if (kind == norm_partial_tensor)
+        {
+            // every member adds into its own slice once, the slices are
+            // zeroed so that members which own no rows leave zeros behind.
+            // f_start f(i) = 1*i + 0;
+            // f_end   f(i) = 1*i + 0;
+            for (unsigned dim = 1; dim < out_defs->indexSpaceRank; dim++)
+            {
+                pattern->mapping[dim].indexSpaceDim = dim;
+                pattern->mapping[dim].a             = 1;
+                pattern->mapping[dim].start_b       = 0;
+                pattern->mapping[dim].end_b         = 1 - 1;
+            }
+            pattern->memsetBeforeExecution = 1;
+            continue;
+        }
+
+        // f_start f(i) = rowsPerMember*i + 0;
+        // f_end   f(i) = rowsPerMember*i + (rowsPerMember - 1);
+        pattern->mapping[1].indexSpaceDim = 1;
+        pattern->mapping[1].a             = rowsPerMember;
+        pattern->mapping[1].start_b       = 0;
+        pattern->mapping[1].end_b         = rowsPerMember - 1;
+
+        // f_start f(i) = 1*i + 0;
+        // f_end   f(i) = 1*i + 0;
+        for (unsigned dim = 2; dim < out_defs->indexSpaceRank; dim++)
+        {
+            pattern->mapping[dim].indexSpaceDim = dim;
+            pattern->mapping[dim].a             = 1;
+            pattern->mapping[dim].start_b       = 0;
+            pattern->mapping[dim].end_b         = 1 - 1;
+        }
+    }
+
+    /*************************************************************************************
+    *    Stage IV -  define scalar parameters
+    **************************************************************************************/
+    // forward kernels take (epsilon, invLen), backward kernels take
+    // (invLen, rowsPerMember)
+    float invLen = 1.0f / (float)rowSizes[0];
+    if (!IsBackward())
+    {
+        float scalarParams[2] = {def->epsilon, invLen};
+        out_defs->kernel.paramsNr = 2;
+        memcpy(&(out_defs->kernel.scalarParams[0]), &scalarParams[0], 2 * sizeof(float));
+    }
+    else
+    {
+        int32_t memberRows = (int32_t)rowsPerMember;
+        out_defs->kernel.paramsNr = 2;
+        memcpy(&(out_defs->kernel.scalarParams[0]), &invLen, sizeof(float));
+        memcpy(&(out_defs->kernel.scalarParams[1]), &memberRows, sizeof(int32_t));
+    }
+
+    /*************************************************************************************
+    *    Stage V -  Load ISA into the descriptor.
+    **************************************************************************************/
+    unsigned IsaSize = (&_binary___layer_norm_fwd_f32_gaudi2_o_end - &_binary___layer_norm_fwd_f32_gaudi2_o_start);
+    unsigned char *binary_kernel = &_binary___layer_norm_fwd_f32_gaudi2_o_start;
+    switch (m_mode)
+    {
+        case layer_norm_fwd_f32:
+            IsaSize = (&_binary___layer_norm_fwd_f32_gaudi2_o_end - &_binary___layer_norm_fwd_f32_gaudi2_o_start);
+            binary_kernel = &_binary___layer_norm_fwd_f32_gaudi2_o_start;
+            break;
+        case layer_norm_fwd_bf16:
+            IsaSize = (&_binary___layer_norm_fwd_bf16_gaudi2_o_end - &_binary___layer_norm_fwd_bf16_gaudi2_o_start);
+            binary_kernel = &_binary___layer_norm_fwd_bf16_gaudi2_o_start;
+            break;
+        case layer_norm_residual_fwd_f32:
+            IsaSize = (&_binary___layer_norm_residual_fwd_f32_gaudi2_o_end - &_binary___layer_norm_residual_fwd_f32_gaudi2_o_start);
+            binary_kernel = &_binary___layer_norm_residual_fwd_f32_gaudi2_o_start;
+            break;
+        case layer_norm_residual_fwd_bf16:
+            IsaSize = (&_binary___layer_norm_residual_fwd_bf16_gaudi2_o_end - &_binary___layer_norm_residual_fwd_bf16_gaudi2_o_start);
+            binary_kernel = &_binary___layer_norm_residual_fwd_bf16_gaudi2_o_start;
+            break;
+        case layer_norm_bwd_f32:
+            IsaSize = (&_binary___layer_norm_bwd_f32_gaudi2_o_end - &_binary___layer_norm_bwd_f32_gaudi2_o_start);
+            binary_kernel = &_binary___layer_norm_bwd_f32_gaudi2_o_start;
+            break;
+        case layer_norm_bwd_bf16:
+            IsaSize = (&_binary___layer_norm_bwd_bf16_gaudi2_o_end - &_binary___layer_norm_bwd_bf16_gaudi2_o_start);
+            binary_kernel = &_binary___layer_norm_bwd_bf16_gaudi2_o_start;
+            break;
+        case rms_norm_fwd_f32:
+            IsaSize = (&_binary___rms_norm_fwd_f32_gaudi2_o_end - &_binary___rms_norm_fwd_f32_gaudi2_o_start);
+            binary_kernel = &_binary___rms_norm_fwd_f32_gaudi2_o_start;
+            break;
+        case rms_norm_fwd_bf16:
+            IsaSize = (&_binary___rms_norm_fwd_bf16_gaudi2_o_end - &_binary___rms_norm_fwd_bf16_gaudi2_o_start);
+            binary_kernel = &_binary___rms_norm_fwd_bf16_gaudi2_o_start;
+            break;
+        case rms_norm_residual_fwd_f32:
+            IsaSize = (&_binary___rms_norm_residual_fwd_f32_gaudi2_o_end - &_binary___rms_norm_residual_fwd_f32_gaudi2_o_start);
+            binary_kernel = &_binary___rms_norm_residual_fwd_f32_gaudi2_o_start;
+            break;
+        case rms_norm_residual_fwd_bf16:
+            IsaSize = (&_binary___rms_norm_residual_fwd_bf16_gaudi2_o_end - &_binary___rms_norm_residual_fwd_bf16_gaudi2_o_start);
+            binary_kernel = &_binary___rms_norm_residual_fwd_bf16_gaudi2_o_start;
+            break;
+        case rms_norm_bwd_f32:
+            IsaSize = (&_binary___rms_norm_bwd_f32_gaudi2_o_end - &_binary___rms_norm_bwd_f32_gaudi2_o_start);
+            binary_kernel = &_binary___rms_norm_bwd_f32_gaudi2_o_start;
+            break;
+        case rms_norm_bwd_bf16:
+            IsaSize = (&_binary___rms_norm_bwd_bf16_gaudi2_o_end - &_binary___rms_norm_bwd_bf16_gaudi2_o_start);
+            binary_kernel = &_binary___rms_norm_bwd_bf16_gaudi2_o_start;
+            break;
+        default:
+            break;
+    }
+
+    unsigned givenBinarySize = out_defs->kernel.elfSize;
+    out_defs->kernel.elfSize = IsaSize;
+    if (givenBinarySize >= IsaSize)
+    {
+        memcpy (out_defs->kernel.kernelElf, binary_kernel, IsaSize);
+    }
+    else
+    {
+        retVal = tpc_lib_api::GLUE_INSUFFICIENT_ELF_BUFFER;
+        return retVal;
+    }
+
+    return tpc_lib_api::GLUE_SUCCESS;
+}
+
+tpc_lib_api::GlueCodeReturn LayerNormAllGaudi2::GetParamReduceDefinitions(
+        tpc_lib_api::HabanaKernelParams* in_defs,
+        tpc_lib_api::HabanaKernelInstantiation* out_defs)
+{
+    tpc_lib_api::GlueCodeReturn retVal;
+
+    // inputs  : partials f32 {ALIGN(C, 128), G1, H, B} from a bf16 backward mode
+    // outputs : gradient bf16 {C}
+    /*************************************************************************************
+    *   Stage I - validate input
+    **************************************************************************************/
+    if (in_defs->inputTensorNr != 1)
+    {
+        in_defs->inputTensorNr  = 1;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_COUNT;
+    }
+    if (in_defs->outputTensorNr != 1)
+    {
+        in_defs->outputTensorNr  = 1;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_COUNT;
+    }
+
+    const tpc_lib_api::Tensor* partials = &in_defs->inputTensors[0];
+    tpc_lib_api::Tensor* paramGrad = &in_defs->outputTensors[0];
+    if (partials->geometry.dataType != tpc_lib_api::DATA_F32)
+    {
+        in_defs->inputTensors[0].geometry.dataType = tpc_lib_api::DATA_F32;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+    }
+    if (paramGrad->geometry.dataType != tpc_lib_api::DATA_BF16)
+    {
+        paramGrad->geometry.dataType = tpc_lib_api::DATA_BF16;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+    }
+
+    const unsigned dims = partials->geometry.dims;
+    const uint64_t* partialSizes = partials->geometry.maxSizes;
+    if (dims < 2 || dims > 4 || partialSizes[0] % c_partialAlign != 0)
+    {
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+    }
+    // the gradient is {C} with C rounded up to partialSizes[0]
+    if (paramGrad->geometry.dims != 1 ||
+        (paramGrad->geometry.maxSizes[0] + (c_partialAlign - 1)) / c_partialAlign * c_partialAlign != partialSizes[0])
+    {
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_SIZE;
+    }
+
+    /*************************************************************************************
+    *    Stage II -  Define index space geometry. Every member reduces one
+    *    c_partialAlign wide vector of the gradient.
+    **************************************************************************************/
+    out_defs->indexSpaceRank = 1;
+    out_defs->indexSpaceGeometry[0] = partialSizes[0] / c_partialAlign;
+
+    /*************************************************************************************
+    *    Stage III -  Define index space mapping
+    **************************************************************************************/
+    // f_start f(i) = c_partialAlign*i + 0;
+    // f_end   f(i) = c_partialAlign*i + (c_partialAlign - 1);
+    out_defs->inputTensorAccessPattern[0].mapping[0].indexSpaceDim = 0;
+    out_defs->inputTensorAccessPattern[0].mapping[0].a             = c_partialAlign;
+    out_defs->inputTensorAccessPattern[0].mapping[0].start_b       = 0;
+    out_defs->inputTensorAccessPattern[0].mapping[0].end_b         = c_partialAlign - 1;
+    out_defs->outputTensorAccessPattern[0].mapping[0].indexSpaceDim = 0;
+    out_defs->outputTensorAccessPattern[0].mapping[0].a             = c_partialAlign;
+    out_defs->outputTensorAccessPattern[0].mapping[0].start_b       = 0;
+    out_defs->outputTensorAccessPattern[0].mapping[0].end_b         = c_partialAlign - 1;
+
+    // every member reads all the partials of its vector
+    // f_start f(i) = 0;
+    // f_end   f(i) = size - 1;
+    for (unsigned dim = 1; dim < dims; dim++)
+    {
+        out_defs->inputTensorAccessPattern[0].mapping[dim].indexSpaceDim = 0;
+        out_defs->inputTensorAccessPattern[0].mapping[dim].a             = 0;
+        out_defs->inputTensorAccessPattern[0].mapping[dim].start_b       = 0;
+        out_defs->inputTensorAccessPattern[0].mapping[dim].end_b         = partialSizes[dim] - 1;
+    }
+
+    /*************************************************************************************
+    *    Stage IV -  define scalar parameters
+    **************************************************************************************/
+    out_defs->kernel.paramsNr = 0;
+
+    /*************************************************************************************
+    *    Stage V -  Load ISA into the descriptor.
+    **************************************************************************************/
+    unsigned IsaSize = (&_binary___norm_bwd_param_reduce_bf16_gaudi2_o_end -
+                        &_binary___norm_bwd_param_reduce_bf16_gaudi2_o_start);
+    unsigned givenBinarySize = out_defs->kernel.elfSize;
+    out_defs->kernel.elfSize = IsaSize;
+    if (givenBinarySize >= IsaSize)
+    {
+        memcpy (out_defs->kernel.kernelElf, &_binary___norm_bwd_param_reduce_bf16_gaudi2_o_start, IsaSize);
+    }
+    else
+    {
+        retVal = tpc_lib_api::GLUE_INSUFFICIENT_ELF_BUFFER;
+        return retVal;
+    }
+
+    return tpc_lib_api::GLUE_SUCCESS;
+}
@@ -0,0 +1,91 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef _LAYER_NORM_ALL_GAUDI2_HPP
+#define _LAYER_NORM_ALL_GAUDI2_HPP
+
+#include "gc_interface.h"
+#include "tpc_kernel_lib_interface.h"
+
+class LayerNormAllGaudi2
+{
+public:
+    typedef enum _LayerNorm_mode_t
+    {
+        layer_norm_fwd_f32,
+        layer_norm_fwd_bf16,
+        layer_norm_residual_fwd_f32,
+        layer_norm_residual_fwd_bf16,
+        layer_norm_bwd_f32,
+        layer_norm_bwd_bf16,
+        rms_norm_fwd_f32,
+        rms_norm_fwd_bf16,
+        rms_norm_residual_fwd_f32,
+        rms_norm_residual_fwd_bf16,
+        rms_norm_bwd_f32,
+        rms_norm_bwd_bf16,
+        norm_bwd_param_reduce_bf16
+    } LayerNorm_mode_t;
+
+    LayerNormAllGaudi2(LayerNorm_mode_t mode=layer_norm_fwd_f32) {m_mode = mode;}
+    virtual ~LayerNormAllGaudi2() {}
+
+    virtual tpc_lib_api::GlueCodeReturn GetGcDefinitions(
+            tpc_lib_api::HabanaKernelParams* in_defs,
+            tpc_lib_api::HabanaKernelInstantiation* out_defs);
+
+    virtual tpc_lib_api::GlueCodeReturn GetKernelName(
+            char kernelName [tpc_lib_api::MAX_NODE_NAME], LayerNorm_mode_t mode);
+
+    // This struct is common between the TPC kernel writer and the framework
+    // layer writer. The programmer who adds a new layer to the framework-backend
+    // is responsible to fill the structure with valid data.
+    // Normalization is always done over dim 0 (FCD).
+    struct LayerNormParams
+    {
+        float epsilon;
+    };
+
+    // Rows handled by one index space member.
+    static const int c_unrollCount = 4;
+    // Backward members aimed for. Each one walks several row groups so that
+    // the f32 parameter gradients are written back once per member.
+    static const int c_bwdMemberTarget = 48;
+    // The bf16 partials keep whole 128 lane vectors along dim 0.
+    static const int c_partialAlign = 128;
+
+    // Rows owned by one backward member, a multiple of c_unrollCount.
+    static unsigned GetBwdRowsPerMember(const uint64_t rowSizes[], unsigned dims);
+    // Sizes of the f32 parameter gradient partials of the bf16 backward
+    // modes, {ALIGN(C, c_partialAlign), G1, H, B} with as many dims as the input.
+    static void GetParamPartialSizes(const uint64_t rowSizes[], unsigned dims,
+                                     uint64_t partialSizes[]);
+
+private:
+    bool IsRmsNorm() const;
+    bool IsResidual() const;
+    bool IsBackward() const;
+    bool IsBF16() const;
+    tpc_lib_api::GlueCodeReturn GetParamReduceDefinitions(
+            tpc_lib_api::HabanaKernelParams* in_defs,
+            tpc_lib_api::HabanaKernelInstantiation* out_defs);
+
+    LayerNorm_mode_t m_mode;
+    LayerNormAllGaudi2(const LayerNormAllGaudi2& other) = delete;
+    LayerNormAllGaudi2& operator=(const LayerNormAllGaudi2& other) = delete;
+};
+
+#endif //_LAYER_NORM_ALL_GAUDI2_HPP
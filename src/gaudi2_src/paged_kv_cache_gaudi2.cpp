@@ -0,0 +1,358 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cstring>
+#include <cstdio>
+#include "paged_kv_cache_gaudi2.hpp"
+
+extern unsigned char _binary___paged_kv_gather_bf16_gaudi2_o_start;
+extern unsigned char _binary___paged_kv_gather_bf16_gaudi2_o_end;
+extern unsigned char _binary___paged_kv_gather_fp8_gaudi2_o_start;
+extern unsigned char _binary___paged_kv_gather_fp8_gaudi2_o_end;
+extern unsigned char _binary___paged_kv_append_bf16_gaudi2_o_start;
+extern unsigned char _binary___paged_kv_append_bf16_gaudi2_o_end;
+extern unsigned char _binary___paged_kv_append_fp8_gaudi2_o_start;
+extern unsigned char _binary___paged_kv_append_fp8_gaudi2_o_end;
+
+// [mode]
+static unsigned char* const c_pagedKvBinaries[PagedKvCacheGaudi2::paged_kv_mode_count][2] = {
+    {&_binary___paged_kv_gather_bf16_gaudi2_o_start, &_binary___paged_kv_gather_bf16_gaudi2_o_end},
+    {&_binary___paged_kv_gather_fp8_gaudi2_o_start, &_binary___paged_kv_gather_fp8_gaudi2_o_end},
+    {&_binary___paged_kv_append_bf16_gaudi2_o_start, &_binary___paged_kv_append_bf16_gaudi2_o_end},
+    {&_binary___paged_kv_append_fp8_gaudi2_o_start, &_binary___paged_kv_append_fp8_gaudi2_o_end}
+};
+
+static const char* const c_pagedKvModeNames[] = {
+    "gather_bf16",
+    "gather_fp8",
+    "append_bf16",
+    "append_fp8"
+};
+
+tpc_lib_api::GlueCodeReturn PagedKvCacheGaudi2::GetKernelName(
+        char kernelName [tpc_lib_api::MAX_NODE_NAME], PagedKvCache_mode_t mode)
+{
+    if (mode >= paged_kv_mode_count)
+        return tpc_lib_api::GLUE_NODE_NOT_FOUND;
+    snprintf(kernelName, tpc_lib_api::MAX_NODE_NAME, "custom_paged_kv_%s_gaudi2",
+             c_pagedKvModeNames[mode]);
+    return tpc_lib_api::GLUE_SUCCESS;
+}
+
+bool PagedKvCacheGaudi2::IsGather() const
+{
+    return m_mode == paged_kv_gather_bf16 || m_mode == paged_kv_gather_fp8;
+}
+
+bool PagedKvCacheGaudi2::IsFp8() const
+{
+    return m_mode == paged_kv_gather_fp8 || m_mode == paged_kv_append_fp8;
+}
+
+// bf16, or either fp8 format for the fp8 modes
+tpc_lib_api::GlueCodeReturn PagedKvCacheGaudi2::ValidateDataType(tpc_lib_api::Tensor& tensor) const
+{
+    const tpc_lib_api::TensorDataType type = tensor.geometry.dataType;
+    const bool valid = IsFp8() ?
+            (type == tpc_lib_api::DATA_F8_143 || type == tpc_lib_api::DATA_F8_152) :
+            (type == tpc_lib_api::DATA_BF16);
+    if (!valid)
+    {
+        tensor.geometry.dataType = IsFp8() ? tpc_lib_api::DATA_F8_143 : tpc_lib_api::DATA_BF16;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+    }
+    return tpc_lib_api::GLUE_SUCCESS;
+}
+
+static bool IsI32Tensor(const tpc_lib_api::Tensor& tensor, unsigned dims)
+{
+    return tensor.geometry.dataType == tpc_lib_api::DATA_I32 && tensor.geometry.dims == dims;
+}
+
+tpc_lib_api::GlueCodeReturn PagedKvCacheGaudi2::GetGcDefinitions(
+        tpc_lib_api::HabanaKernelParams* in_defs,
+        tpc_lib_api::HabanaKernelInstantiation* out_defs)
+{
+    tpc_lib_api::GlueCodeReturn retVal;
+
+    // Tensor order is a convention between the TPC kernel writer and the
+    // framework layer writer:
+    //   gather : inputs  keyCache, valueCache {headDim, heads, blockSize, numBlocks},
+    //                    blockTable i32 {maxBlocksPerSeq, numSeqs}, contextLens i32 {numSeqs}
+    //            outputs key, value {headDim, maxLen, heads, numSeqs}
+    //   append : inputs  newKey, newValue {headDim, heads, numTokens},
+    //                    slotMapping i32 {numTokens}
+    //            outputs keyCache, valueCache, bound to the persistent caches
+
+    /*************************************************************************************
+    *   Stage I - validate input
+    **************************************************************************************/
+    if (m_mode >= paged_kv_mode_count)
+    {
+        return tpc_lib_api::GLUE_NODE_NOT_FOUND;
+    }
+
+    const unsigned inputNr = IsGather() ? 4 : 3;
+    //validate correct amount of input tensors
+    if (in_defs->inputTensorNr != inputNr)
+    {
+        in_defs->inputTensorNr  = inputNr;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_COUNT;
+    }
+    //validate correct amount of output tensors
+    if (in_defs->outputTensorNr != 2)
+    {
+        in_defs->outputTensorNr  = 2;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_COUNT;
+    }
+
+    // the caches and the contiguous key / value
+    tpc_lib_api::Tensor* caches[2];
+    tpc_lib_api::Tensor* tokens[2];
+    for (unsigned i = 0; i < 2; i++)
+    {
+        caches[i] = IsGather() ? &in_defs->inputTensors[i] : &in_defs->outputTensors[i];
+        tokens[i] = IsGather() ? &in_defs->outputTensors[i] : &in_defs->inputTensors[i];
+    }
+
+    // validate data types, key and value share one
+    for (unsigned i = 0; i < 2; i++)
+    {
+        retVal = ValidateDataType(*caches[i]);
+        if (retVal != tpc_lib_api::GLUE_SUCCESS)
+        {
+            return retVal;
+        }
+        if (tokens[i]->geometry.dataType != caches[0]->geometry.dataType ||
+            caches[i]->geometry.dataType != caches[0]->geometry.dataType)
+        {
+            tokens[i]->geometry.dataType = caches[0]->geometry.dataType;
+            caches[i]->geometry.dataType = caches[0]->geometry.dataType;
+            return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+        }
+    }
+
+    // key and value caches are alike, the block size is a power of two
+    const uint64_t* cacheSizes = caches[0]->geometry.maxSizes;
+    if (caches[0]->geometry.dims != 4 || caches[1]->geometry.dims != 4 ||
+        memcmp(caches[1]->geometry.maxSizes, cacheSizes, 4 * sizeof(uint64_t)) != 0)
+    {
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+    }
+    const uint64_t headDim   = cacheSizes[0];
+    const uint64_t heads     = cacheSizes[1];
+    const uint64_t blockSize = cacheSizes[2];
+    if (blockSize == 0 || (blockSize & (blockSize - 1)) != 0)
+    {
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+    }
+    int32_t blockShift = 0;
+    while ((1ull << blockShift) < blockSize)
+    {
+        blockShift++;
+    }
+
+    uint64_t tokenSizes[4] = {0};
+    unsigned tokenDims = 0;
+    uint64_t indexSpace[3] = {0};
+    if (IsGather())
+    {
+        const tpc_lib_api::Tensor& blockTable = in_defs->inputTensors[2];
+        const tpc_lib_api::Tensor& contextLens = in_defs->inputTensors[3];
+        if (!IsI32Tensor(blockTable, 2) || !IsI32Tensor(contextLens, 1))
+        {
+            return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+        }
+        const uint64_t maxBlocks = blockTable.geometry.maxSizes[0];
+        const uint64_t numSeqs   = blockTable.geometry.maxSizes[1];
+        if (contextLens.geometry.maxSizes[0] != numSeqs)
+        {
+            return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+        }
+
+        // the output length is up to the caller, within the table
+        const uint64_t maxLen = tokens[0]->geometry.maxSizes[1];
+        if (maxLen == 0 || maxLen > maxBlocks * blockSize)
+        {
+            return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_SIZE;
+        }
+        tokenDims = 4;
+        tokenSizes[0] = headDim;
+        tokenSizes[1] = maxLen;
+        tokenSizes[2] = heads;
+        tokenSizes[3] = numSeqs;
+
+        indexSpace[0] = heads;
+        indexSpace[1] = (maxLen + blockSize - 1) / blockSize;
+        indexSpace[2] = numSeqs;
+    }
+    else
+    {
+        const tpc_lib_api::Tensor& slotMapping = in_defs->inputTensors[2];
+        if (!IsI32Tensor(slotMapping, 1))
+        {
+            return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+        }
+        tokenDims = 3;
+        tokenSizes[0] = headDim;
+        tokenSizes[1] = heads;
+        tokenSizes[2] = slotMapping.geometry.maxSizes[0];
+
+        indexSpace[0] = heads;
+        indexSpace[1] = tokenSizes[2];
+    }
+
+    // verify that the contiguous key / value dimensions are correct
+    for (unsigned i = 0; i < 2; i++)
+    {
+        if (tokens[i]->geometry.dims != tokenDims ||
+            memcmp(tokens[i]->geometry.maxSizes, tokenSizes, tokenDims * sizeof(uint64_t)) != 0)
+        {
+            if (IsGather())
+            {
+                tokens[i]->geometry.dims = tokenDims;
+                memcpy(tokens[i]->geometry.maxSizes, tokenSizes, tokenDims * sizeof(uint64_t));
+                return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_SIZE;
+            }
+            return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+        }
+    }
+
+    /*************************************************************************************
+    *    Stage II -  Define index space geometry. Gather: heads x logical blocks x sequences,
+    *    one block table read per member. Append: heads x tokens.
+    **************************************************************************************/
+    out_defs->indexSpaceRank = IsGather() ? 3 : 2;
+    for (unsigned dim = 0; dim < out_defs->indexSpaceRank; dim++)
+    {
+        out_defs->indexSpaceGeometry[dim] = indexSpace[dim];
+    }
+
+    /*************************************************************************************
+    *    Stage III -  Define index space mapping
+    **************************************************************************************/
+    // the block of a member is only known on the device, every member may
+    // touch the whole cache
+    for (unsigned i = 0; i < 2; i++)
+    {
+        tpc_lib_api::TensorAccessPattern* pattern = IsGather() ?
+                &out_defs->inputTensorAccessPattern[i] : &out_defs->outputTensorAccessPattern[i];
+        for (unsigned dim = 0; dim < 4; dim++)
+        {
+            pattern->mapping[dim].indexSpaceDim = 0;
+            pattern->mapping[dim].a             = 0;
+            pattern->mapping[dim].start_b       = 0;
+            pattern->mapping[dim].end_b         = cacheSizes[dim] - 1;
+        }
+    }
+
+    for (unsigned i = 0; i < 2; i++)
+    {
+        tpc_lib_api::TensorAccessPattern* pattern = IsGather() ?
+                &out_defs->outputTensorAccessPattern[i] : &out_defs->inputTensorAccessPattern[i];
+
+        // f_start f(i) = 0;
+        // f_end   f(i) = headDim - 1 (whole head)
+        pattern->mapping[0].indexSpaceDim = 0;
+        pattern->mapping[0].a             = 0;
+        pattern->mapping[0].start_b       = 0;
+        pattern->mapping[0].end_b         = headDim - 1;
+
+        if (IsGather())
+        {
+            // tokens: f(i) = blockSize*i + [0, blockSize - 1]
+            pattern->mapping[1].indexSpaceDim = 1;
+            pattern->mapping[1].a             = blockSize;
+            pattern->mapping[1].start_b       = 0;
+            pattern->mapping[1].end_b         = blockSize - 1;
+            // heads and sequences: f(i) = 1*i + 0
+            pattern->mapping[2].indexSpaceDim = 0;
+            pattern->mapping[2].a             = 1;
+            pattern->mapping[2].start_b       = 0;
+            pattern->mapping[2].end_b         = 0;
+            pattern->mapping[3].indexSpaceDim = 2;
+            pattern->mapping[3].a             = 1;
+            pattern->mapping[3].start_b       = 0;
+            pattern->mapping[3].end_b         = 0;
+        }
+        else
+        {
+            // heads and tokens: f(i) = 1*i + 0
+            for (unsigned dim = 1; dim < 3; dim++)
+            {
+                pattern->mapping[dim].indexSpaceDim = dim - 1;
+                pattern->mapping[dim].a             = 1;
+                pattern->mapping[dim].start_b       = 0;
+                pattern->mapping[dim].end_b         = 0;
+            }
+        }
+    }
+
+    if (IsGather())
+    {
+        // block table row and context length of the member's sequence
+        tpc_lib_api::TensorAccessPattern& table = out_defs->inputTensorAccessPattern[2];
+        table.mapping[0].indexSpaceDim = 1;
+        table.mapping[0].a             = 1;
+        table.mapping[0].start_b       = 0;
+        table.mapping[0].end_b         = 0;
+        table.mapping[1].indexSpaceDim = 2;
+        table.mapping[1].a             = 1;
+        table.mapping[1].start_b       = 0;
+        table.mapping[1].end_b         = 0;
+
+        tpc_lib_api::TensorAccessPattern& lengths = out_defs->inputTensorAccessPattern[3];
+        lengths.mapping[0].indexSpaceDim = 2;
+        lengths.mapping[0].a             = 1;
+        lengths.mapping[0].start_b       = 0;
+        lengths.mapping[0].end_b         = 0;
+    }
+    else
+    {
+        // slot of the member's token
+        tpc_lib_api::TensorAccessPattern& slots = out_defs->inputTensorAccessPattern[2];
+        slots.mapping[0].indexSpaceDim = 1;
+        slots.mapping[0].a             = 1;
+        slots.mapping[0].start_b       = 0;
+        slots.mapping[0].end_b         = 0;
+    }
+
+    /*************************************************************************************
+    *    Stage IV -  define scalar parameters
+    **************************************************************************************/
+    out_defs->kernel.paramsNr = 1;
+    memcpy(&(out_defs->kernel.scalarParams[0]), &blockShift, sizeof(int32_t));
+
+    /*************************************************************************************
+    *    Stage V -  Load ISA into the descriptor.
+    **************************************************************************************/
+    unsigned char* binary_kernel = c_pagedKvBinaries[m_mode][0];
+    unsigned IsaSize = (c_pagedKvBinaries[m_mode][1] - c_pagedKvBinaries[m_mode][0]);
+    unsigned givenBinarySize = out_defs->kernel.elfSize;
+    out_defs->kernel.elfSize = IsaSize;
+
+    if (givenBinarySize >= IsaSize)
+    {
+        memcpy (out_defs->kernel.kernelElf, binary_kernel, IsaSize);
+    }
+    else
+    {
+        retVal = tpc_lib_api::GLUE_INSUFFICIENT_ELF_BUFFER;
+        return retVal;
+    }
+
+    return tpc_lib_api::GLUE_SUCCESS;
+}
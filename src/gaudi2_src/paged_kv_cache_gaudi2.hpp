@@ -0,0 +1,64 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef _PAGED_KV_CACHE_GAUDI2_HPP
+#define _PAGED_KV_CACHE_GAUDI2_HPP
+
+#include "gc_interface.h"
+#include "tpc_kernel_lib_interface.h"
+
+// Paged KV cache for serving: the cache {headDim, heads, blockSize, numBlocks}
+// is addressed through a block table per sequence.
+//   gather : block table + context lengths -> contiguous key / value
+//            {headDim, maxLen, heads, numSeqs}, as FusedAttentionGaudi2 takes them
+//   append : new key / value {headDim, heads, numTokens} written to their slots
+//            of the caches through a slot mapping, the cache outputs are
+//            updated in place
+// The fp8 modes take either fp8 format, nothing is converted.
+class PagedKvCacheGaudi2
+{
+public:
+    typedef enum _PagedKvCache_mode_t
+    {
+        paged_kv_gather_bf16,
+        paged_kv_gather_fp8,
+        paged_kv_append_bf16,
+        paged_kv_append_fp8,
+        paged_kv_mode_count
+    } PagedKvCache_mode_t;
+
+    PagedKvCacheGaudi2(PagedKvCache_mode_t mode=paged_kv_gather_bf16) {m_mode = mode;}
+    virtual ~PagedKvCacheGaudi2() {}
+
+    virtual tpc_lib_api::GlueCodeReturn GetGcDefinitions(
+            tpc_lib_api::HabanaKernelParams* in_defs,
+            tpc_lib_api::HabanaKernelInstantiation* out_defs);
+
+    virtual tpc_lib_api::GlueCodeReturn GetKernelName(
+            char kernelName [tpc_lib_api::MAX_NODE_NAME], PagedKvCache_mode_t mode);
+
+private:
+    bool IsGather() const;
+    bool IsFp8() const;
+
+    tpc_lib_api::GlueCodeReturn ValidateDataType(tpc_lib_api::Tensor& tensor) const;
+
+    PagedKvCache_mode_t m_mode;
+    PagedKvCacheGaudi2(const PagedKvCacheGaudi2& other) = delete;
+    PagedKvCacheGaudi2& operator=(const PagedKvCacheGaudi2& other) = delete;
+};
+
+#endif //_PAGED_KV_CACHE_GAUDI2_HPP
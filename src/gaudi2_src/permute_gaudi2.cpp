@@ -0,0 +1,219 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cstring>
+#include <cstdio>
+#include "permute_gaudi2.hpp"
+
+extern unsigned char _binary___permute_f32_gaudi2_o_start;
+extern unsigned char _binary___permute_f32_gaudi2_o_end;
+extern unsigned char _binary___permute_bf16_gaudi2_o_start;
+extern unsigned char _binary___permute_bf16_gaudi2_o_end;
+extern unsigned char _binary___permute_i8_gaudi2_o_start;
+extern unsigned char _binary___permute_i8_gaudi2_o_end;
+
+static const char* const c_permuteModeNames[] = {
+    "permute_f32",
+    "permute_i32",
+    "permute_bf16",
+    "permute_f16",
+    "permute_i8",
+    "permute_u8",
+    "permute_f8_143",
+    "permute_f8_152"
+};
+
+static const tpc_lib_api::TensorDataType c_permuteDataTypes[] = {
+    tpc_lib_api::DATA_F32,
+    tpc_lib_api::DATA_I32,
+    tpc_lib_api::DATA_BF16,
+    tpc_lib_api::DATA_F16,
+    tpc_lib_api::DATA_I8,
+    tpc_lib_api::DATA_U8,
+    tpc_lib_api::DATA_F8_143,
+    tpc_lib_api::DATA_F8_152
+};
+
+static unsigned char* const c_permuteBinaries[][2] = {
+    {&_binary___permute_f32_gaudi2_o_start, &_binary___permute_f32_gaudi2_o_end},
+    {&_binary___permute_f32_gaudi2_o_start, &_binary___permute_f32_gaudi2_o_end},
+    {&_binary___permute_bf16_gaudi2_o_start, &_binary___permute_bf16_gaudi2_o_end},
+    {&_binary___permute_bf16_gaudi2_o_start, &_binary___permute_bf16_gaudi2_o_end},
+    {&_binary___permute_i8_gaudi2_o_start, &_binary___permute_i8_gaudi2_o_end},
+    {&_binary___permute_i8_gaudi2_o_start, &_binary___permute_i8_gaudi2_o_end},
+    {&_binary___permute_i8_gaudi2_o_start, &_binary___permute_i8_gaudi2_o_end},
+    {&_binary___permute_i8_gaudi2_o_start, &_binary___permute_i8_gaudi2_o_end}
+};
+
+tpc_lib_api::GlueCodeReturn PermuteGaudi2::GetKernelName(
+        char kernelName [tpc_lib_api::MAX_NODE_NAME], Permute_mode_t mode)
+{
+    if (mode >= permute_mode_count)
+        return tpc_lib_api::GLUE_NODE_NOT_FOUND;
+    snprintf(kernelName, tpc_lib_api::MAX_NODE_NAME, "custom_%s_gaudi2", c_permuteModeNames[mode]);
+    return tpc_lib_api::GLUE_SUCCESS;
+}
+
+tpc_lib_api::GlueCodeReturn PermuteGaudi2::GetGcDefinitions(
+        tpc_lib_api::HabanaKernelParams* in_defs,
+        tpc_lib_api::HabanaKernelInstantiation* out_defs)
+{
+    tpc_lib_api::GlueCodeReturn retVal;
+    PermuteParams* def = static_cast<PermuteParams*>(in_defs->nodeParams.nodeParams);
+
+    /*************************************************************************************
+    *   Stage I - validate input
+    **************************************************************************************/
+    if (m_mode >= permute_mode_count)
+    {
+        return tpc_lib_api::GLUE_NODE_NOT_FOUND;
+    }
+
+    //validate correct amount of input tensors
+    if (in_defs->inputTensorNr != 1)
+    {
+        in_defs->inputTensorNr  = 1;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_COUNT;
+    }
+    //validate correct amount of output tensors
+    if (in_defs->outputTensorNr != 1)
+    {
+        in_defs->outputTensorNr  = 1;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_COUNT;
+    }
+    if (def == nullptr)
+    {
+        return tpc_lib_api::GLUE_UNSUPPORTED_LAYER_CONFIGURATION;
+    }
+
+    // validate input and output data type
+    const tpc_lib_api::TensorDataType dataType = c_permuteDataTypes[m_mode];
+    if (in_defs->inputTensors[0].geometry.dataType != dataType)
+    {
+        in_defs->inputTensors[0].geometry.dataType = dataType;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+    }
+    if (in_defs->outputTensors[0].geometry.dataType != dataType)
+    {
+        in_defs->outputTensors[0].geometry.dataType = dataType;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+    }
+
+    const tpc_lib_api::Tensor* ifm = &in_defs->inputTensors[0];
+    const unsigned dims = ifm->geometry.dims;
+    if (dims < 1 || dims > gcapi::MAX_TENSOR_DIM)
+    {
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+    }
+    uint64_t ifmSizes[gcapi::MAX_TENSOR_DIM] = {1, 1, 1, 1, 1};
+    memcpy(ifmSizes, ifm->geometry.maxSizes, dims * sizeof(uint64_t));
+
+    // perm must be a permutation that leaves the dims past the rank alone,
+    // invPerm[j] is the ofm dim of ifm dim j
+    int invPerm[gcapi::MAX_TENSOR_DIM] = {-1, -1, -1, -1, -1};
+    for (unsigned dim = 0; dim < gcapi::MAX_TENSOR_DIM; dim++)
+    {
+        const int src = def->perm[dim];
+        if (src < 0 || src >= (int)gcapi::MAX_TENSOR_DIM || invPerm[src] != -1 ||
+            (dim >= dims && src != (int)dim))
+        {
+            return tpc_lib_api::GLUE_UNSUPPORTED_LAYER_CONFIGURATION;
+        }
+        invPerm[src] = dim;
+    }
+
+    uint64_t ofmSizes[gcapi::MAX_TENSOR_DIM] = {1, 1, 1, 1, 1};
+    for (unsigned dim = 0; dim < gcapi::MAX_TENSOR_DIM; dim++)
+    {
+        ofmSizes[dim] = ifmSizes[def->perm[dim]];
+    }
+
+    // verify that output feature map dimension are correct
+    if (in_defs->outputTensors[0].geometry.dims != dims ||
+        memcmp(in_defs->outputTensors[0].geometry.maxSizes, ofmSizes, dims * sizeof(uint64_t)) != 0)
+    {
+        in_defs->outputTensors[0].geometry.dims = dims;
+        memcpy(in_defs->outputTensors[0].geometry.maxSizes, ofmSizes, sizeof(ofmSizes));
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_SIZE;
+    }
+
+    /*************************************************************************************
+    *    Stage II -  Define index space geometry. Index space dims follow the ofm dims.
+    *    Dim 0 takes one vector per member. When dim 0 moves, the ofm dim taking ifm
+    *    dim 0 takes one vector per member too, every member transposes a square tile.
+    **************************************************************************************/
+    const int vectorSize = GetVectorSize();
+    const bool fcdMoves = def->perm[0] != 0;
+    const unsigned fcdOut = invPerm[0];
+
+    out_defs->indexSpaceRank = gcapi::MAX_TENSOR_DIM;
+    for (unsigned dim = 0; dim < out_defs->indexSpaceRank; dim++)
+    {
+        const bool tiled = dim == 0 || (fcdMoves && dim == fcdOut);
+        out_defs->indexSpaceGeometry[dim] = tiled ? (ofmSizes[dim] + vectorSize - 1) / vectorSize
+                                                  : ofmSizes[dim];
+    }
+
+    /*************************************************************************************
+    *    Stage III -  Define index space mapping. ofm dim i is index space dim i, ifm
+    *    dim perm[i] is index space dim i as well.
+    **************************************************************************************/
+    for (unsigned dim = 0; dim < out_defs->indexSpaceRank; dim++)
+    {
+        const bool tiled = dim == 0 || (fcdMoves && dim == fcdOut);
+        const int a = tiled ? vectorSize : 1;
+
+        // f_start f(i) = a*i + 0;
+        // f_end   f(i) = a*i + (a - 1);
+        tpc_lib_api::TensorAccessPattern* ofmPattern = &out_defs->outputTensorAccessPattern[0];
+        ofmPattern->mapping[dim].indexSpaceDim = dim;
+        ofmPattern->mapping[dim].a             = a;
+        ofmPattern->mapping[dim].start_b       = 0;
+        ofmPattern->mapping[dim].end_b         = a - 1;
+
+        tpc_lib_api::TensorAccessPattern* ifmPattern = &out_defs->inputTensorAccessPattern[0];
+        ifmPattern->mapping[def->perm[dim]].indexSpaceDim = dim;
+        ifmPattern->mapping[def->perm[dim]].a             = a;
+        ifmPattern->mapping[def->perm[dim]].start_b       = 0;
+        ifmPattern->mapping[def->perm[dim]].end_b         = a - 1;
+    }
+
+    /*************************************************************************************
+    *    Stage IV -  define scalar parameters
+    **************************************************************************************/
+    out_defs->kernel.paramsNr = gcapi::MAX_TENSOR_DIM;
+    memcpy(&(out_defs->kernel.scalarParams[0]), def->perm, sizeof(def->perm));
+
+    /*************************************************************************************
+    *    Stage V -  Load ISA into the descriptor.
+    **************************************************************************************/
+    unsigned char* binary_kernel = c_permuteBinaries[m_mode][0];
+    unsigned IsaSize = (c_permuteBinaries[m_mode][1] - c_permuteBinaries[m_mode][0]);
+    unsigned givenBinarySize = out_defs->kernel.elfSize;
+    out_defs->kernel.elfSize = IsaSize;
+
+    if (givenBinarySize >= IsaSize)
+    {
+        memcpy (out_defs->kernel.kernelElf, binary_kernel, IsaSize);
+    }
+    else
+    {
+        retVal = tpc_lib_api::GLUE_INSUFFICIENT_ELF_BUFFER;
+        return retVal;
+    }
+
+    return tpc_lib_api::GLUE_SUCCESS;
+}
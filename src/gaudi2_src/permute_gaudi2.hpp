@@ -0,0 +1,75 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef _PERMUTE_GAUDI2_HPP
+#define _PERMUTE_GAUDI2_HPP
+
+#include "gc_interface.h"
+#include "tpc_kernel_lib_interface.h"
+
+// Permutes the dims of a tensor of up to 5 dims, ofm dim i = ifm dim perm[i].
+// Moves bits only, 32 bit types share the f32 binary, 16 bit types the bf16
+// one and 8 bit types the i8 one. Permutations that move dim 0 are transposed in VLM tiles of
+// one vector by one vector, see kernels/include/permute.h.
+class PermuteGaudi2
+{
+public:
+    typedef enum _Permute_mode_t
+    {
+        permute_f32,
+        permute_i32,
+        permute_bf16,
+        permute_f16,
+        permute_i8,
+        permute_u8,
+        permute_f8_143,
+        permute_f8_152,
+        permute_mode_count
+    } Permute_mode_t;
+
+    PermuteGaudi2(Permute_mode_t mode=permute_f32) {m_mode = mode;}
+    virtual ~PermuteGaudi2() {}
+
+    virtual tpc_lib_api::GlueCodeReturn GetGcDefinitions(
+            tpc_lib_api::HabanaKernelParams* in_defs,
+            tpc_lib_api::HabanaKernelInstantiation* out_defs);
+
+    virtual tpc_lib_api::GlueCodeReturn GetKernelName(
+            char kernelName [tpc_lib_api::MAX_NODE_NAME], Permute_mode_t mode);
+
+    // This struct is common between the TPC kernel writer and the framework
+    // layer writer. perm must be a permutation of 0..4, dims past the rank
+    // of the tensor must stay in place.
+    struct PermuteParams
+    {
+        int32_t perm[gcapi::MAX_TENSOR_DIM];
+    };
+
+    // elements of dim 0 per index space member, one vector
+    int GetVectorSize() const
+    {
+        if (m_mode == permute_f32 || m_mode == permute_i32)
+            return 64;
+        return (m_mode == permute_bf16 || m_mode == permute_f16) ? 128 : 256;
+    }
+
+private:
+    Permute_mode_t m_mode;
+    PermuteGaudi2(const PermuteGaudi2& other) = delete;
+    PermuteGaudi2& operator=(const PermuteGaudi2& other) = delete;
+};
+
+#endif //_PERMUTE_GAUDI2_HPP
@@ -0,0 +1,400 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include "piecewise_poly_gaudi2.hpp"
+#include "aux_tensor_store.hpp"
+
+extern unsigned char _binary___piecewise_poly_f32_gaudi2_o_start;
+extern unsigned char _binary___piecewise_poly_f32_gaudi2_o_end;
+
+// least squares points per interval of FitFunction, on Chebyshev nodes so the
+// fit is close to the minimax one
+static const int c_fitPoints = 64;
+// points per interval the error of FitFunction is measured on
+static const int c_checkPoints = 256;
+
+static bool validConfig(float lo, float hi, int intervals, int degree)
+{
+    return std::isfinite(lo) && std::isfinite(hi) && lo < hi &&
+           intervals >= 1 && intervals <= PiecewisePolyGaudi2::c_maxIntervals &&
+           degree >= 0 && degree <= PiecewisePolyGaudi2::c_maxDegree;
+}
+
+// least squares polynomial of the given degree through (t, y), normal
+// equations solved with partial pivoting
+static bool fitInterval(const std::vector<double>& t, const std::vector<double>& y,
+                        int degree, float* coeffs)
+{
+    const int n = degree + 1;
+    double a[PiecewisePolyGaudi2::c_maxDegree + 1][PiecewisePolyGaudi2::c_maxDegree + 2] = {};
+    for (size_t k = 0; k < t.size(); k++)
+    {
+        double powers[2 * PiecewisePolyGaudi2::c_maxDegree + 1];
+        powers[0] = 1.0;
+        for (int i = 1; i < 2 * n - 1; i++)
+        {
+            powers[i] = powers[i - 1] * t[k];
+        }
+        for (int i = 0; i < n; i++)
+        {
+            for (int j = 0; j < n; j++)
+            {
+                a[i][j] += powers[i + j];
+            }
+            a[i][n] += powers[i] * y[k];
+        }
+    }
+
+    for (int col = 0; col < n; col++)
+    {
+        int pivot = col;
+        for (int row = col + 1; row < n; row++)
+        {
+            if (fabs(a[row][col]) > fabs(a[pivot][col]))
+                pivot = row;
+        }
+        if (fabs(a[pivot][col]) < 1e-12)
+            return false;
+        for (int j = 0; j <= n; j++)
+        {
+            std::swap(a[col][j], a[pivot][j]);
+        }
+        for (int row = col + 1; row < n; row++)
+        {
+            const double f = a[row][col] / a[col][col];
+            for (int j = col; j <= n; j++)
+            {
+                a[row][j] -= f * a[col][j];
+            }
+        }
+    }
+
+    double c[PiecewisePolyGaudi2::c_maxDegree + 1] = {};
+    for (int i = n - 1; i >= 0; i--)
+    {
+        double s = a[i][n];
+        for (int j = i + 1; j < n; j++)
+        {
+            s -= a[i][j] * c[j];
+        }
+        c[i] = s / a[i][i];
+    }
+    for (int i = 0; i <= PiecewisePolyGaudi2::c_maxDegree; i++)
+    {
+        coeffs[i] = (float)c[i];
+    }
+    return true;
+}
+
+// tangents of the fit at lo and hi
+static void setTails(PiecewisePolyGaudi2::PiecewisePolyParams* params)
+{
+    const double invWidth = params->intervals / ((double)params->hi - params->lo);
+    const float* first = params->coeffs[0];
+    const float* last = params->coeffs[params->intervals - 1];
+
+    const double loSlope = first[1] * invWidth;
+    const double hiSlope = (last[1] + 2.0 * last[2] + 3.0 * last[3]) * invWidth;
+    const double hiValue = (double)last[0] + last[1] + last[2] + last[3];
+    params->loSlope = (float)loSlope;
+    params->loIntercept = (float)(first[0] - loSlope * params->lo);
+    params->hiSlope = (float)hiSlope;
+    params->hiIntercept = (float)(hiValue - hiSlope * params->hi);
+}
+
+tpc_lib_api::GlueCodeReturn PiecewisePolyGaudi2::FitFunction(
+        double (*func)(double), float lo, float hi, int intervals, int degree,
+        PiecewisePolyParams* params, double* maxError)
+{
+    if (func == nullptr || params == nullptr || !validConfig(lo, hi, intervals, degree))
+    {
+        return tpc_lib_api::GLUE_UNSUPPORTED_LAYER_CONFIGURATION;
+    }
+
+    memset(params, 0, sizeof(*params));
+    params->intervals = intervals;
+    params->degree = degree;
+    params->lo = lo;
+    params->hi = hi;
+
+    const double width = ((double)hi - lo) / intervals;
+    std::vector<double> t(c_fitPoints);
+    std::vector<double> y(c_fitPoints);
+    for (int i = 0; i < intervals; i++)
+    {
+        for (int k = 0; k < c_fitPoints; k++)
+        {
+            t[k] = 0.5 - 0.5 * cos(M_PI * (k + 0.5) / c_fitPoints);
+            y[k] = func(lo + (i + t[k]) * width);
+        }
+        if (!fitInterval(t, y, degree, params->coeffs[i]))
+        {
+            return tpc_lib_api::GLUE_UNSUPPORTED_LAYER_CONFIGURATION;
+        }
+    }
+    setTails(params);
+
+    if (maxError != nullptr)
+    {
+        double error = 0.0;
+        for (int k = 0; k <= intervals * c_checkPoints; k++)
+        {
+            const float x = (float)(lo + k * width / c_checkPoints);
+            error = std::max(error, fabs(Evaluate(*params, x) - func(x)));
+        }
+        *maxError = error;
+    }
+    return tpc_lib_api::GLUE_SUCCESS;
+}
+
+tpc_lib_api::GlueCodeReturn PiecewisePolyGaudi2::FitSamples(
+        const float* x, const float* y, int count, int intervals, int degree,
+        PiecewisePolyParams* params, double* maxError)
+{
+    if (x == nullptr || y == nullptr || params == nullptr || count <= 0)
+    {
+        return tpc_lib_api::GLUE_UNSUPPORTED_LAYER_CONFIGURATION;
+    }
+    const float lo = *std::min_element(x, x + count);
+    const float hi = *std::max_element(x, x + count);
+    if (!validConfig(lo, hi, intervals, degree))
+    {
+        return tpc_lib_api::GLUE_UNSUPPORTED_LAYER_CONFIGURATION;
+    }
+
+    memset(params, 0, sizeof(*params));
+    params->intervals = intervals;
+    params->degree = degree;
+    params->lo = lo;
+    params->hi = hi;
+
+    // bucket the samples the way the kernel picks the interval
+    const double invWidth = intervals / ((double)hi - lo);
+    std::vector<std::vector<double> > t(intervals);
+    std::vector<std::vector<double> > v(intervals);
+    for (int k = 0; k < count; k++)
+    {
+        const double u = (x[k] - lo) * invWidth;
+        const int i = std::min(std::max((int)floor(u), 0), intervals - 1);
+        t[i].push_back(u - i);
+        v[i].push_back(y[k]);
+    }
+    for (int i = 0; i < intervals; i++)
+    {
+        if ((int)t[i].size() <= degree || !fitInterval(t[i], v[i], degree, params->coeffs[i]))
+        {
+            return tpc_lib_api::GLUE_UNSUPPORTED_LAYER_CONFIGURATION;
+        }
+    }
+    setTails(params);
+
+    if (maxError != nullptr)
+    {
+        double error = 0.0;
+        for (int k = 0; k < count; k++)
+        {
+            error = std::max(error, fabs((double)Evaluate(*params, x[k]) - y[k]));
+        }
+        *maxError = error;
+    }
+    return tpc_lib_api::GLUE_SUCCESS;
+}
+
+float PiecewisePolyGaudi2::Evaluate(const PiecewisePolyParams& params, float x)
+{
+    if (std::isnan(x))
+        return x;
+    if (x < params.lo)
+        return params.loSlope * x + params.loIntercept;
+    if (x > params.hi)
+        return params.hiSlope * x + params.hiIntercept;
+
+    const float invWidth = params.intervals / (params.hi - params.lo);
+    const float u = (x - params.lo) * invWidth;
+    const int i = std::min(std::max((int)floorf(u), 0), params.intervals - 1);
+    const float t = u - (float)i;
+    const float* c = params.coeffs[i];
+    return ((c[3] * t + c[2]) * t + c[1]) * t + c[0];
+}
+
+void PiecewisePolyGaudi2::PackLut(const PiecewisePolyParams& params, float* lut)
+{
+    memset(lut, 0, c_lutSize * sizeof(float));
+    for (int i = 0; i < params.intervals; i++)
+    {
+        // coefficients above the degree are left at 0
+        float c[c_maxDegree + 1] = {};
+        std::copy(params.coeffs[i], params.coeffs[i] + params.degree + 1, c);
+
+        lut[i] = c[3];
+        float* triple = lut + 64 + (i / 10) * 32 + (i % 10) * 3;
+        triple[0] = c[0];
+        triple[1] = c[1];
+        triple[2] = c[2];
+    }
+}
+
+tpc_lib_api::GlueCodeReturn PiecewisePolyGaudi2::GetKernelName(
+        char kernelName [tpc_lib_api::MAX_NODE_NAME])
+{
+    strcpy(kernelName, "custom_piecewise_poly_f32_gaudi2");
+    return tpc_lib_api::GLUE_SUCCESS;
+}
+
+tpc_lib_api::GlueCodeReturn PiecewisePolyGaudi2::GetGcDefinitions(
+        tpc_lib_api::HabanaKernelParams* in_defs,
+        tpc_lib_api::HabanaKernelInstantiation* out_defs)
+{
+    const int c_unrollCount = 4;
+    tpc_lib_api::GlueCodeReturn retVal;
+    PiecewisePolyParams* def = static_cast<PiecewisePolyParams*>(in_defs->nodeParams.nodeParams);
+
+    /*************************************************************************************
+    *   Stage I - validate input
+    **************************************************************************************/
+    //validate correct amount of input tensors
+    if (in_defs->inputTensorNr != 1)
+    {
+        in_defs->inputTensorNr  = 1;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_COUNT;
+    }
+    //validate correct amount of output tensors
+    if (in_defs->outputTensorNr != 1)
+    {
+        in_defs->outputTensorNr  = 1;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_COUNT;
+    }
+
+    if (def == nullptr || !validConfig(def->lo, def->hi, def->intervals, def->degree))
+    {
+        return tpc_lib_api::GLUE_UNSUPPORTED_LAYER_CONFIGURATION;
+    }
+
+    // validate input and output data type
+    if (in_defs->inputTensors[0].geometry.dataType != tpc_lib_api::DATA_F32 ||
+        in_defs->outputTensors[0].geometry.dataType != tpc_lib_api::DATA_F32)
+    {
+        in_defs->inputTensors[0].geometry.dataType = tpc_lib_api::DATA_F32;
+        in_defs->outputTensors[0].geometry.dataType = tpc_lib_api::DATA_F32;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+    }
+
+    uint64_t outputSizes[gcapi::MAX_TENSOR_DIM] = {0};
+    memcpy(outputSizes, in_defs->inputTensors[0].geometry.maxSizes, sizeof(outputSizes));
+
+    // verify that output feature map dimension are correct
+    if (memcmp(in_defs->outputTensors[0].geometry.maxSizes, outputSizes,
+               in_defs->outputTensors[0].geometry.dims * sizeof(uint64_t)) != 0)
+    {
+        memcpy(in_defs->outputTensors[0].geometry.maxSizes, outputSizes, sizeof(outputSizes));
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_SIZE;
+    }
+
+    /*************************************************************************************
+    *    Stage II -  Define index space geometry. In this example the index space matches
+    *    the dimensions of the output tensor, up to dim 0.
+    **************************************************************************************/
+    int elementsInVec = 64;
+
+    //round up to elementsInVec and divide by elementsInVec.
+    unsigned depthIndex = (outputSizes[0] + (elementsInVec - 1)) / elementsInVec;
+    out_defs->indexSpaceRank = 5;
+    out_defs->indexSpaceGeometry[0] = depthIndex;
+    //reduce index space due to unroll.
+    out_defs->indexSpaceGeometry[1] = (outputSizes[1] + (c_unrollCount - 1)) / c_unrollCount;
+    out_defs->indexSpaceGeometry[2] = outputSizes[2];
+    out_defs->indexSpaceGeometry[3] = outputSizes[3];
+    out_defs->indexSpaceGeometry[4] = outputSizes[4];
+
+    /*************************************************************************************
+    *    Stage III -  Define index space mapping
+    **************************************************************************************/
+    tpc_lib_api::TensorAccessPattern pattern = {};
+
+    // f_start f(i) = elementsInVec*i + 0;
+    // f_end   f(i) = elementsInVec*i + (elementsInVec - 1);
+    pattern.mapping[0].indexSpaceDim = 0;
+    pattern.mapping[0].a             = elementsInVec;
+    pattern.mapping[0].start_b       = 0;
+    pattern.mapping[0].end_b         = elementsInVec - 1;
+
+    pattern.mapping[1].indexSpaceDim = 1;
+    pattern.mapping[1].a             = c_unrollCount;
+    pattern.mapping[1].start_b       = 0;
+    pattern.mapping[1].end_b         = c_unrollCount - 1;
+
+    // f_start f(i) = 1*i + 0;
+    // f_end   f(i) = 1*i + 0;
+    for (int dims = 2; dims < (int)out_defs->indexSpaceRank; dims++)
+    {
+        pattern.mapping[dims].indexSpaceDim = dims;
+        pattern.mapping[dims].a             = 1;
+        pattern.mapping[dims].start_b       = 0;
+        pattern.mapping[dims].end_b         = 1 - 1;
+    }
+
+    out_defs->inputTensorAccessPattern[0] = pattern;
+    out_defs->outputTensorAccessPattern[0] = pattern;
+
+    /*************************************************************************************
+    *    Stage IV -  define scalar parameters/Set Auxiliary Tensor
+    **************************************************************************************/
+    const float invWidth = def->intervals / (def->hi - def->lo);
+    const int lastInterval = def->intervals - 1;
+
+    out_defs->kernel.paramsNr = 8;
+    memcpy(&(out_defs->kernel.scalarParams[0]), &def->lo, sizeof(float));
+    memcpy(&(out_defs->kernel.scalarParams[1]), &def->hi, sizeof(float));
+    memcpy(&(out_defs->kernel.scalarParams[2]), &invWidth, sizeof(float));
+    memcpy(&(out_defs->kernel.scalarParams[3]), &lastInterval, sizeof(int));
+    memcpy(&(out_defs->kernel.scalarParams[4]), &def->loSlope, sizeof(float));
+    memcpy(&(out_defs->kernel.scalarParams[5]), &def->loIntercept, sizeof(float));
+    memcpy(&(out_defs->kernel.scalarParams[6]), &def->hiSlope, sizeof(float));
+    memcpy(&(out_defs->kernel.scalarParams[7]), &def->hiIntercept, sizeof(float));
+
+    // the table depends on the params only, nodes with the same fit share it
+    retVal = AuxTensorStore::FillF32Aux(out_defs, "piecewise_poly", def, sizeof(*def), c_lutSize,
+                                        [def](void* data, unsigned) { PackLut(*def, (float*)data); });
+    if (retVal != tpc_lib_api::GLUE_SUCCESS)
+    {
+        return retVal;
+    }
+
+    /*************************************************************************************
+    *    Stage V -  Load ISA into the descriptor.
+    **************************************************************************************/
+    unsigned IsaSize = (&_binary___piecewise_poly_f32_gaudi2_o_end - &_binary___piecewise_poly_f32_gaudi2_o_start);
+    unsigned givenBinarySize = out_defs->kernel.elfSize;
+    out_defs->kernel.elfSize = IsaSize;
+
+    if (givenBinarySize >= IsaSize)
+    {
+        // copy binary out
+        memcpy (out_defs->kernel.kernelElf,
+                &_binary___piecewise_poly_f32_gaudi2_o_start,
+                IsaSize);
+    }
+    else
+    {
+       retVal = tpc_lib_api::GLUE_INSUFFICIENT_ELF_BUFFER;
+       return retVal;
+    }
+    return tpc_lib_api::GLUE_SUCCESS;
+}
@@ -0,0 +1,91 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef _PIECEWISE_POLY_GAUDI2_HPP
+#define _PIECEWISE_POLY_GAUDI2_HPP
+
+#include "gc_interface.h"
+#include "tpc_kernel_lib_interface.h"
+
+// Elementwise f32 activation given as a piecewise polynomial, evaluated by a
+// single kernel through the user LUT. [lo, hi] is split into up to
+// c_maxIntervals equal intervals, each with a polynomial of degree up to
+// c_maxDegree in the local coordinate t = (x - lo) / width - interval, t in
+// [0, 1]. Outside [lo, hi] the linear tails apply.
+//
+// FitFunction / FitSamples build the params on the host by a least squares
+// fit per interval to a scalar function or to a sample table.
+class PiecewisePolyGaudi2
+{
+public:
+    static const int c_maxIntervals = 32;
+    static const int c_maxDegree = 3;
+
+    PiecewisePolyGaudi2() {}
+    virtual ~PiecewisePolyGaudi2() {}
+
+    virtual tpc_lib_api::GlueCodeReturn GetGcDefinitions(
+            tpc_lib_api::HabanaKernelParams* in_defs,
+            tpc_lib_api::HabanaKernelInstantiation* out_defs);
+
+    virtual tpc_lib_api::GlueCodeReturn GetKernelName(
+            char kernelName [tpc_lib_api::MAX_NODE_NAME]);
+
+    // This struct is common between the TPC kernel writer and the framework
+    // layer writer.
+    struct PiecewisePolyParams
+    {
+        int32_t intervals;
+        int32_t degree;
+        float lo;
+        float hi;
+        float loSlope;      // y = loSlope * x + loIntercept below lo
+        float loIntercept;
+        float hiSlope;      // y = hiSlope * x + hiIntercept above hi
+        float hiIntercept;
+        float coeffs[c_maxIntervals][c_maxDegree + 1];  // c0 .. c3 in t
+    };
+
+    // Fit func over [lo, hi]. The tails continue the fit with its tangent at
+    // lo and hi. maxError, when given, gets the max abs error of the fit
+    // inside [lo, hi].
+    static tpc_lib_api::GlueCodeReturn FitFunction(
+            double (*func)(double), float lo, float hi, int intervals, int degree,
+            PiecewisePolyParams* params, double* maxError);
+
+    // Fit count (x, y) samples, the range is that of x and every interval
+    // needs at least degree + 1 samples. maxError gets the max abs error over
+    // the samples.
+    static tpc_lib_api::GlueCodeReturn FitSamples(
+            const float* x, const float* y, int count, int intervals, int degree,
+            PiecewisePolyParams* params, double* maxError);
+
+    // value of the fit at x as the kernel computes it
+    static float Evaluate(const PiecewisePolyParams& params, float x);
+
+    // size in floats of the aux LUT tensor and its layout: function 0 holds
+    // c3 of interval i at entry i, function 1 holds the c0, c1, c2 triples
+    // 10 per 32 entry row.
+    static const int c_lutSize = 64 + 4 * 32;
+
+private:
+    static void PackLut(const PiecewisePolyParams& params, float* lut);
+
+    PiecewisePolyGaudi2(const PiecewisePolyGaudi2& other) = delete;
+    PiecewisePolyGaudi2& operator=(const PiecewisePolyGaudi2& other) = delete;
+};
+
+#endif //_PIECEWISE_POLY_GAUDI2_HPP
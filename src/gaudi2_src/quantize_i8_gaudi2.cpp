@@ -0,0 +1,356 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cstring>
+#include <cstdio>
+#include "quantize_i8_gaudi2.hpp"
+
+extern unsigned char _binary___quantize_i8_tensor_f32_gaudi2_o_start;
+extern unsigned char _binary___quantize_i8_tensor_f32_gaudi2_o_end;
+extern unsigned char _binary___quantize_i8_tensor_bf16_gaudi2_o_start;
+extern unsigned char _binary___quantize_i8_tensor_bf16_gaudi2_o_end;
+extern unsigned char _binary___dequantize_i8_tensor_f32_gaudi2_o_start;
+extern unsigned char _binary___dequantize_i8_tensor_f32_gaudi2_o_end;
+extern unsigned char _binary___dequantize_i8_tensor_bf16_gaudi2_o_start;
+extern unsigned char _binary___dequantize_i8_tensor_bf16_gaudi2_o_end;
+extern unsigned char _binary___quantize_i8_channel_f32_gaudi2_o_start;
+extern unsigned char _binary___quantize_i8_channel_f32_gaudi2_o_end;
+extern unsigned char _binary___quantize_i8_channel_bf16_gaudi2_o_start;
+extern unsigned char _binary___quantize_i8_channel_bf16_gaudi2_o_end;
+extern unsigned char _binary___dequantize_i8_channel_f32_gaudi2_o_start;
+extern unsigned char _binary___dequantize_i8_channel_f32_gaudi2_o_end;
+extern unsigned char _binary___dequantize_i8_channel_bf16_gaudi2_o_start;
+extern unsigned char _binary___dequantize_i8_channel_bf16_gaudi2_o_end;
+extern unsigned char _binary___quantize_i8_channel_zp_f32_gaudi2_o_start;
+extern unsigned char _binary___quantize_i8_channel_zp_f32_gaudi2_o_end;
+extern unsigned char _binary___quantize_i8_channel_zp_bf16_gaudi2_o_start;
+extern unsigned char _binary___quantize_i8_channel_zp_bf16_gaudi2_o_end;
+extern unsigned char _binary___dequantize_i8_channel_zp_f32_gaudi2_o_start;
+extern unsigned char _binary___dequantize_i8_channel_zp_f32_gaudi2_o_end;
+extern unsigned char _binary___dequantize_i8_channel_zp_bf16_gaudi2_o_start;
+extern unsigned char _binary___dequantize_i8_channel_zp_bf16_gaudi2_o_end;
+extern unsigned char _binary___quantize_i8_dynamic_f32_gaudi2_o_start;
+extern unsigned char _binary___quantize_i8_dynamic_f32_gaudi2_o_end;
+extern unsigned char _binary___quantize_i8_dynamic_bf16_gaudi2_o_start;
+extern unsigned char _binary___quantize_i8_dynamic_bf16_gaudi2_o_end;
+
+static const char* const c_quantizeI8ModeNames[] = {
+    "quantize_i8_tensor_f32",
+    "quantize_i8_tensor_bf16",
+    "dequantize_i8_tensor_f32",
+    "dequantize_i8_tensor_bf16",
+    "quantize_i8_channel_f32",
+    "quantize_i8_channel_bf16",
+    "dequantize_i8_channel_f32",
+    "dequantize_i8_channel_bf16",
+    "quantize_i8_channel_zp_f32",
+    "quantize_i8_channel_zp_bf16",
+    "dequantize_i8_channel_zp_f32",
+    "dequantize_i8_channel_zp_bf16",
+    "quantize_i8_dynamic_f32",
+    "quantize_i8_dynamic_bf16"
+};
+
+static unsigned char* const c_quantizeI8Binaries[][2] = {
+    {&_binary___quantize_i8_tensor_f32_gaudi2_o_start, &_binary___quantize_i8_tensor_f32_gaudi2_o_end},
+    {&_binary___quantize_i8_tensor_bf16_gaudi2_o_start, &_binary___quantize_i8_tensor_bf16_gaudi2_o_end},
+    {&_binary___dequantize_i8_tensor_f32_gaudi2_o_start, &_binary___dequantize_i8_tensor_f32_gaudi2_o_end},
+    {&_binary___dequantize_i8_tensor_bf16_gaudi2_o_start, &_binary___dequantize_i8_tensor_bf16_gaudi2_o_end},
+    {&_binary___quantize_i8_channel_f32_gaudi2_o_start, &_binary___quantize_i8_channel_f32_gaudi2_o_end},
+    {&_binary___quantize_i8_channel_bf16_gaudi2_o_start, &_binary___quantize_i8_channel_bf16_gaudi2_o_end},
+    {&_binary___dequantize_i8_channel_f32_gaudi2_o_start, &_binary___dequantize_i8_channel_f32_gaudi2_o_end},
+    {&_binary___dequantize_i8_channel_bf16_gaudi2_o_start, &_binary___dequantize_i8_channel_bf16_gaudi2_o_end},
+    {&_binary___quantize_i8_channel_zp_f32_gaudi2_o_start, &_binary___quantize_i8_channel_zp_f32_gaudi2_o_end},
+    {&_binary___quantize_i8_channel_zp_bf16_gaudi2_o_start, &_binary___quantize_i8_channel_zp_bf16_gaudi2_o_end},
+    {&_binary___dequantize_i8_channel_zp_f32_gaudi2_o_start, &_binary___dequantize_i8_channel_zp_f32_gaudi2_o_end},
+    {&_binary___dequantize_i8_channel_zp_bf16_gaudi2_o_start, &_binary___dequantize_i8_channel_zp_bf16_gaudi2_o_end},
+    {&_binary___quantize_i8_dynamic_f32_gaudi2_o_start, &_binary___quantize_i8_dynamic_f32_gaudi2_o_end},
+    {&_binary___quantize_i8_dynamic_bf16_gaudi2_o_start, &_binary___quantize_i8_dynamic_bf16_gaudi2_o_end}
+};
+
+bool QuantizeI8Gaudi2::IsDequant() const
+{
+    switch (m_mode)
+    {
+        case dequantize_i8_tensor_f32:
+        case dequantize_i8_tensor_bf16:
+        case dequantize_i8_channel_f32:
+        case dequantize_i8_channel_bf16:
+        case dequantize_i8_channel_zp_f32:
+        case dequantize_i8_channel_zp_bf16:
+            return true;
+        default:
+            return false;
+    }
+}
+
+tpc_lib_api::GlueCodeReturn QuantizeI8Gaudi2::GetKernelName(
+        char kernelName [tpc_lib_api::MAX_NODE_NAME], QuantizeI8_mode_t mode)
+{
+    if (mode >= quantize_i8_mode_count)
+        return tpc_lib_api::GLUE_NODE_NOT_FOUND;
+    snprintf(kernelName, tpc_lib_api::MAX_NODE_NAME, "custom_%s_gaudi2", c_quantizeI8ModeNames[mode]);
+    return tpc_lib_api::GLUE_SUCCESS;
+}
+
+tpc_lib_api::GlueCodeReturn QuantizeI8Gaudi2::GetGcDefinitions(
+        tpc_lib_api::HabanaKernelParams* in_defs,
+        tpc_lib_api::HabanaKernelInstantiation* out_defs)
+{
+    tpc_lib_api::GlueCodeReturn retVal;
+
+    // Tensor order is a convention between the TPC kernel writer and the
+    // framework layer writer:
+    //   tensor  : ifm -> ofm
+    //   channel : ifm, scale {C} f32, [zeroPoint {C} i32] -> ofm
+    //   dynamic : ifm -> ofm, scale {1, ...} f32, zeroPoint {1, ...} i32
+    const bool dequant = IsDequant();
+    const unsigned inputNr = IsPerChannel() ? (HasZeroPointTensor() ? 3 : 2) : 1;
+    const unsigned outputNr = IsDynamic() ? 3 : 1;
+    QuantizeI8Params* def = static_cast<QuantizeI8Params*>(in_defs->nodeParams.nodeParams);
+
+    /*************************************************************************************
+    *   Stage I - validate input
+    **************************************************************************************/
+    //validate correct amount of input tensors
+    if (in_defs->inputTensorNr != inputNr)
+    {
+        in_defs->inputTensorNr  = inputNr;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_COUNT;
+    }
+    //validate correct amount of output tensors
+    if (in_defs->outputTensorNr != outputNr)
+    {
+        in_defs->outputTensorNr  = outputNr;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_COUNT;
+    }
+    if ((IsPerChannel() || IsDynamic()) && def == nullptr)
+    {
+        return tpc_lib_api::GLUE_UNSUPPORTED_LAYER_CONFIGURATION;
+    }
+
+    // validate input and output data type
+    const tpc_lib_api::TensorDataType wideType = IsBF16() ? tpc_lib_api::DATA_BF16 : tpc_lib_api::DATA_F32;
+    const tpc_lib_api::TensorDataType ifmType = dequant ? tpc_lib_api::DATA_I8 : wideType;
+    const tpc_lib_api::TensorDataType ofmType = dequant ? wideType : tpc_lib_api::DATA_I8;
+    if (in_defs->inputTensors[0].geometry.dataType != ifmType)
+    {
+        in_defs->inputTensors[0].geometry.dataType = ifmType;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+    }
+    if (in_defs->outputTensors[0].geometry.dataType != ofmType)
+    {
+        in_defs->outputTensors[0].geometry.dataType = ofmType;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+    }
+
+    const tpc_lib_api::Tensor* ifm = &in_defs->inputTensors[0];
+    const unsigned dims = ifm->geometry.dims;
+    if (dims < 1 || dims > gcapi::MAX_TENSOR_DIM)
+    {
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+    }
+    uint64_t ifmSizes[gcapi::MAX_TENSOR_DIM] = {1, 1, 1, 1, 1};
+    memcpy(ifmSizes, ifm->geometry.maxSizes, dims * sizeof(uint64_t));
+
+    // verify that output feature map dimension are correct
+    if (in_defs->outputTensors[0].geometry.dims != dims ||
+        memcmp(in_defs->outputTensors[0].geometry.maxSizes, ifmSizes, dims * sizeof(uint64_t)) != 0)
+    {
+        in_defs->outputTensors[0].geometry.dims = dims;
+        memcpy(in_defs->outputTensors[0].geometry.maxSizes, ifmSizes, sizeof(ifmSizes));
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_SIZE;
+    }
+
+    // scale {C} f32 and zeroPoint {C} i32, C = ifm size along axis
+    if (IsPerChannel())
+    {
+        if (def->axis < 0 || (unsigned)def->axis >= dims)
+        {
+            return tpc_lib_api::GLUE_UNSUPPORTED_LAYER_CONFIGURATION;
+        }
+        for (unsigned i = 1; i < inputNr; i++)
+        {
+            tpc_lib_api::Tensor* t = &in_defs->inputTensors[i];
+            const tpc_lib_api::TensorDataType type = (i == 1) ? tpc_lib_api::DATA_F32 : tpc_lib_api::DATA_I32;
+            if (t->geometry.dataType != type)
+            {
+                t->geometry.dataType = type;
+                return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+            }
+            if (t->geometry.dims != 1 || t->geometry.maxSizes[0] != ifmSizes[def->axis])
+            {
+                t->geometry.dims = 1;
+                t->geometry.maxSizes[0] = ifmSizes[def->axis];
+                return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+            }
+        }
+    }
+
+    // scale and zeroPoint of every dim 0 row
+    if (IsDynamic())
+    {
+        uint64_t rowSizes[gcapi::MAX_TENSOR_DIM];
+        memcpy(rowSizes, ifmSizes, sizeof(rowSizes));
+        rowSizes[0] = 1;
+        for (unsigned i = 1; i < outputNr; i++)
+        {
+            tpc_lib_api::Tensor* t = &in_defs->outputTensors[i];
+            const tpc_lib_api::TensorDataType type = (i == 1) ? tpc_lib_api::DATA_F32 : tpc_lib_api::DATA_I32;
+            if (t->geometry.dataType != type)
+            {
+                t->geometry.dataType = type;
+                return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+            }
+            if (t->geometry.dims != dims ||
+                memcmp(t->geometry.maxSizes, rowSizes, dims * sizeof(uint64_t)) != 0)
+            {
+                t->geometry.dims = dims;
+                memcpy(t->geometry.maxSizes, rowSizes, sizeof(rowSizes));
+                return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_SIZE;
+            }
+        }
+    }
+
+    // per tensor parameters live on the int8 tensor
+    const tpc_lib_api::Tensor* i8Tensor = dequant ? &in_defs->inputTensors[0] : &in_defs->outputTensors[0];
+    const float scale = (float)i8Tensor->quantizationParam.scale;
+    const float zeroPoint = (float)i8Tensor->quantizationParam.zeroPoint;
+    if (!IsPerChannel() && !IsDynamic() &&
+        (!(scale > 0.0f) || zeroPoint < -128.0f || zeroPoint > 127.0f))
+    {
+        return tpc_lib_api::GLUE_UNSUPPORTED_LAYER_CONFIGURATION;
+    }
+
+    /*************************************************************************************
+    *    Stage II -  Define index space geometry. Elementwise with one int8 vector of
+    *    dim 0 per member, dynamic members own whole dim 0 rows.
+    **************************************************************************************/
+    out_defs->indexSpaceRank = gcapi::MAX_TENSOR_DIM;
+    out_defs->indexSpaceGeometry[0] = IsDynamic() ? 1 :
+            (ifmSizes[0] + c_elementsPerMember - 1) / c_elementsPerMember;
+    for (unsigned dim = 1; dim < out_defs->indexSpaceRank; dim++)
+    {
+        out_defs->indexSpaceGeometry[dim] = ifmSizes[dim];
+    }
+
+    /*************************************************************************************
+    *    Stage III -  Define index space mapping
+    **************************************************************************************/
+    tpc_lib_api::TensorAccessPattern* patterns[2] = {
+            &out_defs->inputTensorAccessPattern[0], &out_defs->outputTensorAccessPattern[0]};
+    for (unsigned i = 0; i < 2; i++)
+    {
+        if (IsDynamic())
+        {
+            // f_start f(i) = 0;
+            // f_end   f(i) = size - 1;
+            patterns[i]->mapping[0].indexSpaceDim = 0;
+            patterns[i]->mapping[0].a             = 0;
+            patterns[i]->mapping[0].start_b       = 0;
+            patterns[i]->mapping[0].end_b         = ifmSizes[0] - 1;
+        }
+        else
+        {
+            // f_start f(i) = c_elementsPerMember*i + 0;
+            // f_end   f(i) = c_elementsPerMember*i + (c_elementsPerMember - 1);
+            patterns[i]->mapping[0].indexSpaceDim = 0;
+            patterns[i]->mapping[0].a             = c_elementsPerMember;
+            patterns[i]->mapping[0].start_b       = 0;
+            patterns[i]->mapping[0].end_b         = c_elementsPerMember - 1;
+        }
+
+        // f_start f(i) = 1*i + 0;
+        // f_end   f(i) = 1*i + 0;
+        for (unsigned dim = 1; dim < out_defs->indexSpaceRank; dim++)
+        {
+            patterns[i]->mapping[dim].indexSpaceDim = dim;
+            patterns[i]->mapping[dim].a             = 1;
+            patterns[i]->mapping[dim].start_b       = 0;
+            patterns[i]->mapping[dim].end_b         = 0;
+        }
+    }
+
+    // the channel tensors follow the index space dim of axis
+    for (unsigned i = 1; i < (IsPerChannel() ? inputNr : 1); i++)
+    {
+        tpc_lib_api::TensorAccessPattern* pattern = &out_defs->inputTensorAccessPattern[i];
+        const bool fcd = (def->axis == 0);
+        pattern->mapping[0].indexSpaceDim = def->axis;
+        pattern->mapping[0].a             = fcd ? c_elementsPerMember : 1;
+        pattern->mapping[0].start_b       = 0;
+        pattern->mapping[0].end_b         = fcd ? c_elementsPerMember - 1 : 0;
+    }
+
+    // one value per row
+    for (unsigned i = 1; i < (IsDynamic() ? outputNr : 1); i++)
+    {
+        tpc_lib_api::TensorAccessPattern* pattern = &out_defs->outputTensorAccessPattern[i];
+        pattern->mapping[0].indexSpaceDim = 0;
+        pattern->mapping[0].a             = 0;
+        pattern->mapping[0].start_b       = 0;
+        pattern->mapping[0].end_b         = 0;
+        for (unsigned dim = 1; dim < out_defs->indexSpaceRank; dim++)
+        {
+            pattern->mapping[dim].indexSpaceDim = dim;
+            pattern->mapping[dim].a             = 1;
+            pattern->mapping[dim].start_b       = 0;
+            pattern->mapping[dim].end_b         = 0;
+        }
+    }
+
+    /*************************************************************************************
+    *    Stage IV -  define scalar parameters
+    **************************************************************************************/
+    if (IsPerChannel())
+    {
+        out_defs->kernel.paramsNr = 1;
+        memcpy(&(out_defs->kernel.scalarParams[0]), &def->axis, sizeof(int32_t));
+    }
+    else if (IsDynamic())
+    {
+        out_defs->kernel.paramsNr = 1;
+        memcpy(&(out_defs->kernel.scalarParams[0]), &def->symmetric, sizeof(int32_t));
+    }
+    else
+    {
+        // quantization multiplies by the reciprocal
+        const float mul = dequant ? scale : 1.0f / scale;
+        out_defs->kernel.paramsNr = 2;
+        memcpy(&(out_defs->kernel.scalarParams[0]), &mul, sizeof(float));
+        memcpy(&(out_defs->kernel.scalarParams[1]), &zeroPoint, sizeof(float));
+    }
+
+    /*************************************************************************************
+    *    Stage V -  Load ISA into the descriptor.
+    **************************************************************************************/
+    unsigned char* binary_kernel = c_quantizeI8Binaries[m_mode][0];
+    unsigned IsaSize = c_quantizeI8Binaries[m_mode][1] - c_quantizeI8Binaries[m_mode][0];
+
+    unsigned givenBinarySize = out_defs->kernel.elfSize;
+    out_defs->kernel.elfSize = IsaSize;
+    if (givenBinarySize >= IsaSize)
+    {
+        memcpy (out_defs->kernel.kernelElf, binary_kernel, IsaSize);
+    }
+    else
+    {
+        retVal = tpc_lib_api::GLUE_INSUFFICIENT_ELF_BUFFER;
+        return retVal;
+    }
+
+    return tpc_lib_api::GLUE_SUCCESS;
+}
@@ -0,0 +1,86 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef _QUANTIZE_I8_GAUDI2_HPP
+#define _QUANTIZE_I8_GAUDI2_HPP
+
+#include "gc_interface.h"
+#include "tpc_kernel_lib_interface.h"
+
+// int8 quantize / dequantize of f32 and bf16 tensors, round half to even:
+//   quant   : q = clamp(round(x * (1 / scale)) + zeroPoint, -128, 127)
+//   dequant : x = (q - zeroPoint) * scale
+// tensor  : scale and zero point from quantizationParam of the int8 tensor
+// channel : x, scale {C} f32, [zeroPoint {C} i32 with _zp] along params axis
+// dynamic : x -> q, scale and zeroPoint of every dim 0 row, both shaped
+//           {1, sizes[1], ...}, f32 and i32
+class QuantizeI8Gaudi2
+{
+public:
+    // bf16 modes follow their f32 twin
+    typedef enum _QuantizeI8_mode_t
+    {
+        quantize_i8_tensor_f32,
+        quantize_i8_tensor_bf16,
+        dequantize_i8_tensor_f32,
+        dequantize_i8_tensor_bf16,
+        quantize_i8_channel_f32,
+        quantize_i8_channel_bf16,
+        dequantize_i8_channel_f32,
+        dequantize_i8_channel_bf16,
+        quantize_i8_channel_zp_f32,
+        quantize_i8_channel_zp_bf16,
+        dequantize_i8_channel_zp_f32,
+        dequantize_i8_channel_zp_bf16,
+        quantize_i8_dynamic_f32,
+        quantize_i8_dynamic_bf16,
+        quantize_i8_mode_count
+    } QuantizeI8_mode_t;
+
+    QuantizeI8Gaudi2(QuantizeI8_mode_t mode=quantize_i8_tensor_f32) {m_mode = mode;}
+    virtual ~QuantizeI8Gaudi2() {}
+
+    virtual tpc_lib_api::GlueCodeReturn GetGcDefinitions(
+            tpc_lib_api::HabanaKernelParams* in_defs,
+            tpc_lib_api::HabanaKernelInstantiation* out_defs);
+
+    virtual tpc_lib_api::GlueCodeReturn GetKernelName(
+            char kernelName [tpc_lib_api::MAX_NODE_NAME], QuantizeI8_mode_t mode);
+
+    // This struct is common between the TPC kernel writer and the framework
+    // layer writer. Not needed by the tensor modes.
+    struct QuantizeI8Params
+    {
+        int32_t axis;       // channel modes, dimension the scales run along
+        int32_t symmetric;  // dynamic modes, non zero for a zero point of 0
+    };
+
+    bool IsBF16() const { return (m_mode % 2) == 1; }
+    bool IsDequant() const;
+    bool IsPerChannel() const { return m_mode >= quantize_i8_channel_f32 && m_mode < quantize_i8_dynamic_f32; }
+    bool HasZeroPointTensor() const { return m_mode >= quantize_i8_channel_zp_f32 && m_mode < quantize_i8_dynamic_f32; }
+    bool IsDynamic() const { return m_mode >= quantize_i8_dynamic_f32; }
+
+    // elements of dim 0 per index space member, one int8 vector
+    static const int c_elementsPerMember = 256;
+
+private:
+    QuantizeI8_mode_t m_mode;
+    QuantizeI8Gaudi2(const QuantizeI8Gaudi2& other) = delete;
+    QuantizeI8Gaudi2& operator=(const QuantizeI8Gaudi2& other) = delete;
+};
+
+#endif //_QUANTIZE_I8_GAUDI2_HPP
@@ -0,0 +1,332 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cstring>
+#include <cstdio>
+#include "reduction_gaudi2.hpp"
+
+extern unsigned char _binary___reduce_sum_f32_gaudi2_o_start;
+extern unsigned char _binary___reduce_sum_f32_gaudi2_o_end;
+extern unsigned char _binary___reduce_sum_bf16_gaudi2_o_start;
+extern unsigned char _binary___reduce_sum_bf16_gaudi2_o_end;
+extern unsigned char _binary___reduce_prod_f32_gaudi2_o_start;
+extern unsigned char _binary___reduce_prod_f32_gaudi2_o_end;
+extern unsigned char _binary___reduce_prod_bf16_gaudi2_o_start;
+extern unsigned char _binary___reduce_prod_bf16_gaudi2_o_end;
+extern unsigned char _binary___reduce_max_f32_gaudi2_o_start;
+extern unsigned char _binary___reduce_max_f32_gaudi2_o_end;
+extern unsigned char _binary___reduce_max_bf16_gaudi2_o_start;
+extern unsigned char _binary___reduce_max_bf16_gaudi2_o_end;
+extern unsigned char _binary___reduce_min_f32_gaudi2_o_start;
+extern unsigned char _binary___reduce_min_f32_gaudi2_o_end;
+extern unsigned char _binary___reduce_min_bf16_gaudi2_o_start;
+extern unsigned char _binary___reduce_min_bf16_gaudi2_o_end;
+extern unsigned char _binary___reduce_var_f32_gaudi2_o_start;
+extern unsigned char _binary___reduce_var_f32_gaudi2_o_end;
+extern unsigned char _binary___reduce_var_bf16_gaudi2_o_start;
+extern unsigned char _binary___reduce_var_bf16_gaudi2_o_end;
+extern unsigned char _binary___reduce_sum_rmw_f32_gaudi2_o_start;
+extern unsigned char _binary___reduce_sum_rmw_f32_gaudi2_o_end;
+
+// kernels of reduction.h, several ops share one
+typedef enum _ReduceKernel_t
+{
+    reduce_kernel_sum,
+    reduce_kernel_prod,
+    reduce_kernel_max,
+    reduce_kernel_min,
+    reduce_kernel_var,
+    reduce_kernel_count
+} ReduceKernel_t;
+
+// [ReduceOp_t]
+static const ReduceKernel_t c_reduceOpKernels[] = {
+    reduce_kernel_sum,
+    reduce_kernel_sum,
+    reduce_kernel_max,
+    reduce_kernel_min,
+    reduce_kernel_prod,
+    reduce_kernel_var,
+    reduce_kernel_var
+};
+
+// [kernel][mode]
+static unsigned char* const c_reduceBinaries[reduce_kernel_count][ReductionGaudi2::reduce_mode_count][2] = {
+    {
+        {&_binary___reduce_sum_f32_gaudi2_o_start, &_binary___reduce_sum_f32_gaudi2_o_end},
+        {&_binary___reduce_sum_bf16_gaudi2_o_start, &_binary___reduce_sum_bf16_gaudi2_o_end}
+    },
+    {
+        {&_binary___reduce_prod_f32_gaudi2_o_start, &_binary___reduce_prod_f32_gaudi2_o_end},
+        {&_binary___reduce_prod_bf16_gaudi2_o_start, &_binary___reduce_prod_bf16_gaudi2_o_end}
+    },
+    {
+        {&_binary___reduce_max_f32_gaudi2_o_start, &_binary___reduce_max_f32_gaudi2_o_end},
+        {&_binary___reduce_max_bf16_gaudi2_o_start, &_binary___reduce_max_bf16_gaudi2_o_end}
+    },
+    {
+        {&_binary___reduce_min_f32_gaudi2_o_start, &_binary___reduce_min_f32_gaudi2_o_end},
+        {&_binary___reduce_min_bf16_gaudi2_o_start, &_binary___reduce_min_bf16_gaudi2_o_end}
+    },
+    {
+        {&_binary___reduce_var_f32_gaudi2_o_start, &_binary___reduce_var_f32_gaudi2_o_end},
+        {&_binary___reduce_var_bf16_gaudi2_o_start, &_binary___reduce_var_bf16_gaudi2_o_end}
+    }
+};
+
+static const char* const c_reduceModeNames[] = {
+    "f32",
+    "bf16"
+};
+
+static const tpc_lib_api::TensorDataType c_reduceTypes[] = {
+    tpc_lib_api::DATA_F32,
+    tpc_lib_api::DATA_BF16
+};
+
+tpc_lib_api::GlueCodeReturn ReductionGaudi2::GetKernelName(
+        char kernelName [tpc_lib_api::MAX_NODE_NAME], Reduction_mode_t mode)
+{
+    if (mode >= reduce_mode_count)
+        return tpc_lib_api::GLUE_NODE_NOT_FOUND;
+    snprintf(kernelName, tpc_lib_api::MAX_NODE_NAME, "custom_reduce_%s_gaudi2",
+             c_reduceModeNames[mode]);
+    return tpc_lib_api::GLUE_SUCCESS;
+}
+
+tpc_lib_api::GlueCodeReturn ReductionGaudi2::GetGcDefinitions(
+        tpc_lib_api::HabanaKernelParams* in_defs,
+        tpc_lib_api::HabanaKernelInstantiation* out_defs)
+{
+    tpc_lib_api::GlueCodeReturn retVal;
+    ReductionParams* def = static_cast<ReductionParams*>(in_defs->nodeParams.nodeParams);
+
+    /*************************************************************************************
+    *   Stage I - validate input
+    **************************************************************************************/
+    if (m_mode >= reduce_mode_count)
+    {
+        return tpc_lib_api::GLUE_NODE_NOT_FOUND;
+    }
+
+    //validate correct amount of input tensors
+    if (in_defs->inputTensorNr != 1)
+    {
+        in_defs->inputTensorNr  = 1;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_COUNT;
+    }
+    //validate correct amount of output tensors
+    if (in_defs->outputTensorNr != 1)
+    {
+        in_defs->outputTensorNr  = 1;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_COUNT;
+    }
+
+    const tpc_lib_api::Tensor* ifm = &in_defs->inputTensors[0];
+    const unsigned dims = ifm->geometry.dims;
+    if (dims < 1 || dims > gcapi::MAX_TENSOR_DIM)
+    {
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+    }
+
+    if (def == nullptr || def->op < 0 || def->op >= reduce_op_count ||
+        def->axisMask <= 0 || (def->axisMask >> dims) != 0 ||
+        def->strategy < reduce_strategy_auto || def->strategy > reduce_strategy_rmw)
+    {
+        return tpc_lib_api::GLUE_UNSUPPORTED_LAYER_CONFIGURATION;
+    }
+
+    // validate input and output data type
+    if (in_defs->inputTensors[0].geometry.dataType != c_reduceTypes[m_mode])
+    {
+        in_defs->inputTensors[0].geometry.dataType = c_reduceTypes[m_mode];
+        return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+    }
+    if (in_defs->outputTensors[0].geometry.dataType != c_reduceTypes[m_mode])
+    {
+        in_defs->outputTensors[0].geometry.dataType = c_reduceTypes[m_mode];
+        return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+    }
+
+    // the ofm keeps the rank, reduced dims are 1
+    uint64_t ifmSizes[gcapi::MAX_TENSOR_DIM] = {1, 1, 1, 1, 1};
+    uint64_t ofmSizes[gcapi::MAX_TENSOR_DIM] = {1, 1, 1, 1, 1};
+    uint64_t reducedElements = 1;
+    for (unsigned dim = 0; dim < dims; dim++)
+    {
+        ifmSizes[dim] = ifm->geometry.maxSizes[dim];
+        if ((def->axisMask >> dim) & 1)
+        {
+            reducedElements *= ifmSizes[dim];
+        }
+        else
+        {
+            ofmSizes[dim] = ifmSizes[dim];
+        }
+    }
+
+    // verify that output feature map dimension are correct
+    if (in_defs->outputTensors[0].geometry.dims != dims ||
+        memcmp(in_defs->outputTensors[0].geometry.maxSizes, ofmSizes, dims * sizeof(uint64_t)) != 0)
+    {
+        in_defs->outputTensors[0].geometry.dims = dims;
+        memcpy(in_defs->outputTensors[0].geometry.maxSizes, ofmSizes, sizeof(ofmSizes));
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_SIZE;
+    }
+
+    const bool isVar = def->op == reduce_var || def->op == reduce_std;
+    if (isVar && (def->correction < 0 || reducedElements <= (uint64_t)def->correction))
+    {
+        return tpc_lib_api::GLUE_UNSUPPORTED_LAYER_CONFIGURATION;
+    }
+
+    // only sums combine with the atomic add, and in f32 so that every chunk
+    // is not rounded to bf16 when it lands in the ofm
+    const ReduceKernel_t kernel = c_reduceOpKernels[def->op];
+    const bool rmwCapable = (kernel == reduce_kernel_sum) && (m_mode == reduce_f32);
+    if (def->strategy == reduce_strategy_rmw && !rmwCapable)
+    {
+        return tpc_lib_api::GLUE_UNSUPPORTED_LAYER_CONFIGURATION;
+    }
+
+    /*************************************************************************************
+    *    Stage II -  Define index space geometry. Kept dims give one member per
+    *    output vector. Reduced dims are a single member, except the split dim
+    *    of the RMW strategy which gets one member per chunk.
+    **************************************************************************************/
+    const int vectorSize = GetVectorSize();
+    uint64_t units[gcapi::MAX_TENSOR_DIM];
+    uint64_t keptMembers = 1;
+    int splitDim = -1;
+    for (unsigned dim = 0; dim < dims; dim++)
+    {
+        // members a dim can be spread over, dim 0 goes by vectors
+        units[dim] = dim == 0 ? (ifmSizes[0] + vectorSize - 1) / vectorSize : ifmSizes[dim];
+        if (((def->axisMask >> dim) & 1) == 0)
+        {
+            keptMembers *= units[dim];
+        }
+        else if (splitDim < 0 || units[dim] > units[splitDim])
+        {
+            splitDim = dim;
+        }
+    }
+
+    uint64_t splits = 1;
+    if (rmwCapable && def->strategy != reduce_strategy_store)
+    {
+        if (def->strategy == reduce_strategy_rmw)
+        {
+            splits = c_tpcCount;
+        }
+        else if (keptMembers < (uint64_t)c_tpcCount)
+        {
+            uint64_t maxSplits = reducedElements / c_minSplitElements;
+            splits = c_tpcCount / keptMembers;
+            splits = splits < maxSplits ? splits : maxSplits;
+        }
+        splits = splits < units[splitDim] ? splits : units[splitDim];
+        splits = splits > 1 ? splits : 1;
+    }
+    const bool useRmw = (def->strategy == reduce_strategy_rmw) || splits > 1;
+
+    // even chunks, in vectors for dim 0
+    uint64_t chunkUnits = (units[splitDim] + splits - 1) / splits;
+    splits = (units[splitDim] + chunkUnits - 1) / chunkUnits;
+    const int chunk = (int)(splitDim == 0 ? chunkUnits * vectorSize : chunkUnits);
+
+    out_defs->indexSpaceRank = dims;
+    for (unsigned dim = 0; dim < dims; dim++)
+    {
+        if (((def->axisMask >> dim) & 1) == 0)
+            out_defs->indexSpaceGeometry[dim] = units[dim];
+        else
+            out_defs->indexSpaceGeometry[dim] = ((int)dim == splitDim) ? splits : 1;
+    }
+
+    /*************************************************************************************
+    *    Stage III -  Define index space mapping
+    **************************************************************************************/
+    for (unsigned dim = 0; dim < dims; dim++)
+    {
+        const bool reduced = (def->axisMask >> dim) & 1;
+        // a reduced dim is read in chunks, the whole dim when not split
+        const uint64_t a = reduced ? (((int)dim == splitDim) ? chunk : ifmSizes[dim]) :
+                                     (dim == 0 ? vectorSize : 1);
+
+        // f_start f(i) = a*i + 0;
+        // f_end   f(i) = a*i + (a - 1);
+        out_defs->inputTensorAccessPattern[0].mapping[dim].indexSpaceDim = dim;
+        out_defs->inputTensorAccessPattern[0].mapping[dim].a             = a;
+        out_defs->inputTensorAccessPattern[0].mapping[dim].start_b       = 0;
+        out_defs->inputTensorAccessPattern[0].mapping[dim].end_b         = a - 1;
+
+        // every chunk of a reduced dim writes ofm element 0
+        out_defs->outputTensorAccessPattern[0].mapping[dim].indexSpaceDim = dim;
+        out_defs->outputTensorAccessPattern[0].mapping[dim].a             = reduced ? 0 : a;
+        out_defs->outputTensorAccessPattern[0].mapping[dim].start_b       = 0;
+        out_defs->outputTensorAccessPattern[0].mapping[dim].end_b         = reduced ? 0 : a - 1;
+    }
+    if (useRmw)
+    {
+        // the chunks are added into a zeroed ofm
+        out_defs->outputTensorAccessPattern[0].memsetBeforeExecution = 1;
+    }
+
+    /*************************************************************************************
+    *    Stage IV -  define scalar parameters: reduceMask, splitDim, chunk, scale,
+    *    takeSqrt
+    **************************************************************************************/
+    int32_t kernelSplitDim = useRmw ? splitDim : -1;
+    float scale = 1.0f;
+    if (def->op == reduce_mean)
+        scale = 1.0f / (float)reducedElements;
+    else if (isVar)
+        scale = 1.0f / (float)(reducedElements - def->correction);
+    int32_t takeSqrt = def->op == reduce_std;
+
+    out_defs->kernel.paramsNr = 5;
+    memcpy(&(out_defs->kernel.scalarParams[0]), &def->axisMask, sizeof(int32_t));
+    memcpy(&(out_defs->kernel.scalarParams[1]), &kernelSplitDim, sizeof(int32_t));
+    memcpy(&(out_defs->kernel.scalarParams[2]), &chunk, sizeof(int32_t));
+    memcpy(&(out_defs->kernel.scalarParams[3]), &scale, sizeof(float));
+    memcpy(&(out_defs->kernel.scalarParams[4]), &takeSqrt, sizeof(int32_t));
+
+    /*************************************************************************************
+    *    Stage V -  Load ISA into the descriptor.
+    **************************************************************************************/
+    unsigned char* binary_kernel = c_reduceBinaries[kernel][m_mode][0];
+    unsigned IsaSize = (c_reduceBinaries[kernel][m_mode][1] - c_reduceBinaries[kernel][m_mode][0]);
+    if (useRmw)
+    {
+        binary_kernel = &_binary___reduce_sum_rmw_f32_gaudi2_o_start;
+        IsaSize = (&_binary___reduce_sum_rmw_f32_gaudi2_o_end - &_binary___reduce_sum_rmw_f32_gaudi2_o_start);
+    }
+    unsigned givenBinarySize = out_defs->kernel.elfSize;
+    out_defs->kernel.elfSize = IsaSize;
+
+    if (givenBinarySize >= IsaSize)
+    {
+        memcpy (out_defs->kernel.kernelElf, binary_kernel, IsaSize);
+    }
+    else
+    {
+        retVal = tpc_lib_api::GLUE_INSUFFICIENT_ELF_BUFFER;
+        return retVal;
+    }
+
+    return tpc_lib_api::GLUE_SUCCESS;
+}
@@ -0,0 +1,93 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef _REDUCTION_GAUDI2_HPP
+#define _REDUCTION_GAUDI2_HPP
+
+#include "gc_interface.h"
+#include "tpc_kernel_lib_interface.h"
+
+// sum / mean / max / min / prod / var / std of a f32 or bf16 tensor over any
+// set of dims. The ofm keeps the ifm rank with the reduced dims set to 1.
+// Every index space member either reduces complete outputs and stores them,
+// or, for sum and mean in f32, reduces a chunk of the reduced range and adds
+// it into the zeroed ofm with atomic RMW stores. The auto strategy picks RMW
+// when the kept dims give too few members to fill the TPCs. var and std
+// run in a single pass over the input.
+class ReductionGaudi2
+{
+public:
+    typedef enum _Reduction_mode_t
+    {
+        reduce_f32,
+        reduce_bf16,
+        reduce_mode_count
+    } Reduction_mode_t;
+
+    typedef enum _ReduceOp_t
+    {
+        reduce_sum,
+        reduce_mean,
+        reduce_max,
+        reduce_min,
+        reduce_prod,
+        reduce_var,
+        reduce_std,
+        reduce_op_count
+    } ReduceOp_t;
+
+    typedef enum _ReduceStrategy_t
+    {
+        reduce_strategy_auto,
+        reduce_strategy_store,  // every member owns complete outputs
+        reduce_strategy_rmw     // split reduced range, atomic adds (sum / mean, f32)
+    } ReduceStrategy_t;
+
+    ReductionGaudi2(Reduction_mode_t mode=reduce_f32) {m_mode = mode;}
+    virtual ~ReductionGaudi2() {}
+
+    virtual tpc_lib_api::GlueCodeReturn GetGcDefinitions(
+            tpc_lib_api::HabanaKernelParams* in_defs,
+            tpc_lib_api::HabanaKernelInstantiation* out_defs);
+
+    virtual tpc_lib_api::GlueCodeReturn GetKernelName(
+            char kernelName [tpc_lib_api::MAX_NODE_NAME], Reduction_mode_t mode);
+
+    // This struct is common between the TPC kernel writer and the framework
+    // layer writer.
+    struct ReductionParams
+    {
+        int32_t op;         // ReduceOp_t
+        int32_t axisMask;   // bit d set for every reduced dim
+        int32_t correction; // var / std divide by N - correction
+        int32_t strategy;   // ReduceStrategy_t
+    };
+
+    // TPC engines of a Gaudi2 device
+    static const int c_tpcCount = 24;
+    // smallest reduced range worth a chunk of its own with the auto strategy
+    static const int c_minSplitElements = 8192;
+
+    // elements of dim 0 per index space member, one vector
+    int GetVectorSize() const { return m_mode == reduce_f32 ? 64 : 128; }
+
+private:
+    Reduction_mode_t m_mode;
+    ReductionGaudi2(const ReductionGaudi2& other) = delete;
+    ReductionGaudi2& operator=(const ReductionGaudi2& other) = delete;
+};
+
+#endif //_REDUCTION_GAUDI2_HPP
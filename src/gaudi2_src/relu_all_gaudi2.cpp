@@ -26,6 +26,23 @@ extern unsigned char _binary___relu_fwd_bf16_gaudi2_o_end;
 extern unsigned char _binary___relu_bwd_bf16_gaudi2_o_start;
 extern unsigned char _binary___relu_bwd_bf16_gaudi2_o_end;
 
+extern unsigned char _binary___relu_fwd_mask_f32_gaudi2_o_start;
+extern unsigned char _binary___relu_fwd_mask_f32_gaudi2_o_end;
+extern unsigned char _binary___relu_bwd_mask_f32_gaudi2_o_start;
+extern unsigned char _binary___relu_bwd_mask_f32_gaudi2_o_end;
+extern unsigned char _binary___relu_fwd_mask_bf16_gaudi2_o_start;
+extern unsigned char _binary___relu_fwd_mask_bf16_gaudi2_o_end;
+extern unsigned char _binary___relu_bwd_mask_bf16_gaudi2_o_start;
+extern unsigned char _binary___relu_bwd_mask_bf16_gaudi2_o_end;
+
+// [mode - relu_fwd_mask_f32]
+static unsigned char* const c_maskBinaries[][2] = {
+    {&_binary___relu_fwd_mask_f32_gaudi2_o_start, &_binary___relu_fwd_mask_f32_gaudi2_o_end},
+    {&_binary___relu_bwd_mask_f32_gaudi2_o_start, &_binary___relu_bwd_mask_f32_gaudi2_o_end},
+    {&_binary___relu_fwd_mask_bf16_gaudi2_o_start, &_binary___relu_fwd_mask_bf16_gaudi2_o_end},
+    {&_binary___relu_bwd_mask_bf16_gaudi2_o_start, &_binary___relu_bwd_mask_bf16_gaudi2_o_end}
+};
+
 
 tpc_lib_api::GlueCodeReturn ReluAllGaudi2::GetKernelName(
         char kernelName [tpc_lib_api::MAX_NODE_NAME], Relu_mode_t mode)
@@ -38,6 +55,14 @@ tpc_lib_api::GlueCodeReturn ReluAllGaudi2::GetKernelName(
         strcpy(kernelName,"custom_relu_fwd_bf16_gaudi2");
     else if(mode == relu_bwd_bf16)
         strcpy(kernelName,"custom_relu_bwd_bf16_gaudi2");
+    else if(mode == relu_fwd_mask_f32)
+        strcpy(kernelName,"custom_relu_fwd_mask_f32_gaudi2");
+    else if(mode == relu_bwd_mask_f32)
+        strcpy(kernelName,"custom_relu_bwd_mask_f32_gaudi2");
+    else if(mode == relu_fwd_mask_bf16)
+        strcpy(kernelName,"custom_relu_fwd_mask_bf16_gaudi2");
+    else if(mode == relu_bwd_mask_bf16)
+        strcpy(kernelName,"custom_relu_bwd_mask_bf16_gaudi2");
     else
         return tpc_lib_api::GLUE_NODE_NOT_FOUND;
     return tpc_lib_api::GLUE_SUCCESS;
@@ -49,6 +74,10 @@ tpc_lib_api::GlueCodeReturn ReluAllGaudi2::GetGcDefinitions(
 {
 	const int c_unrollCount = 4;
     tpc_lib_api::GlueCodeReturn retVal;
+    if (m_mode >= relu_fwd_mask_f32)
+    {
+        return GetMaskGcDefinitions(in_defs, out_defs);
+    }
     /*************************************************************************************
     *   Stage I - validate input
     **************************************************************************************/
@@ -256,4 +285,150 @@ tpc_lib_api::GlueCodeReturn ReluAllGaudi2::GetGcDefinitions(
     return tpc_lib_api::GLUE_SUCCESS;
 }
 
+// forward: x -> y, mask. backward: dY, mask -> dX
+tpc_lib_api::GlueCodeReturn ReluAllGaudi2::GetMaskGcDefinitions(
+        tpc_lib_api::HabanaKernelParams* in_defs,
+        tpc_lib_api::HabanaKernelInstantiation* out_defs)
+{
+    tpc_lib_api::GlueCodeReturn retVal;
+    const bool isBwd = m_mode == relu_bwd_mask_f32 || m_mode == relu_bwd_mask_bf16;
+    const bool isF32 = m_mode == relu_fwd_mask_f32 || m_mode == relu_bwd_mask_f32;
+    const tpc_lib_api::TensorDataType dataType = isF32 ? tpc_lib_api::DATA_F32 : tpc_lib_api::DATA_BF16;
+    const tpc_lib_api::TensorDataType maskType = isF32 ? tpc_lib_api::DATA_I32 : tpc_lib_api::DATA_I16;
+    const unsigned inputCount = isBwd ? 2 : 1;
+    const unsigned outputCount = isBwd ? 1 : 2;
+
+    /*************************************************************************************
+    *   Stage I - validate input
+    **************************************************************************************/
+    //validate correct amount of input tensors
+    if (in_defs->inputTensorNr != inputCount)
+    {
+        in_defs->inputTensorNr  = inputCount;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_COUNT;
+    }
+    //validate correct amount of output tensors
+    if (in_defs->outputTensorNr != outputCount)
+    {
+        in_defs->outputTensorNr  = outputCount;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_COUNT;
+    }
+
+    tpc_lib_api::Tensor* data = &in_defs->inputTensors[0];
+    tpc_lib_api::Tensor* result = &in_defs->outputTensors[0];
+    tpc_lib_api::Tensor* mask = isBwd ? &in_defs->inputTensors[1] : &in_defs->outputTensors[1];
+
+    // validate input and output data type
+    if (data->geometry.dataType != dataType || result->geometry.dataType != dataType)
+    {
+        data->geometry.dataType = dataType;
+        result->geometry.dataType = dataType;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+    }
+    if (mask->geometry.dataType != maskType)
+    {
+        mask->geometry.dataType = maskType;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+    }
+
+    uint64_t outputSizes[gcapi::MAX_TENSOR_DIM] = {0};
+    memcpy(outputSizes, data->geometry.maxSizes, sizeof(outputSizes));
+
+    // verify that output feature map dimension are correct
+    if (memcmp(result->geometry.maxSizes, outputSizes,
+               result->geometry.dims * sizeof(uint64_t)) != 0)
+    {
+        memcpy(result->geometry.maxSizes, outputSizes, sizeof(outputSizes));
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_SIZE;
+    }
+
+    // the mask packs every c_maskBlockElements elements of dim 0 into one vector
+    const int elementsInVec = isF32 ? 64 : 128;
+    const uint64_t blocks = (outputSizes[0] + (c_maskBlockElements - 1)) / c_maskBlockElements;
+    uint64_t maskSizes[gcapi::MAX_TENSOR_DIM] = {0};
+    memcpy(maskSizes, outputSizes, sizeof(maskSizes));
+    maskSizes[0] = blocks * elementsInVec;
+    if (memcmp(mask->geometry.maxSizes, maskSizes, mask->geometry.dims * sizeof(uint64_t)) != 0)
+    {
+        if (isBwd)
+        {
+            return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+        }
+        memcpy(mask->geometry.maxSizes, maskSizes, sizeof(maskSizes));
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_SIZE;
+    }
+
+    /*************************************************************************************
+    *    Stage II -  Define index space geometry. One member per mask vector, it
+    *    covers c_maskBlockElements elements of dim 0.
+    **************************************************************************************/
+    out_defs->indexSpaceRank = 5;
+    out_defs->indexSpaceGeometry[0] = blocks;
+    out_defs->indexSpaceGeometry[1] = outputSizes[1];
+    out_defs->indexSpaceGeometry[2] = outputSizes[2];
+    out_defs->indexSpaceGeometry[3] = outputSizes[3];
+    out_defs->indexSpaceGeometry[4] = outputSizes[4];
+
+    /*************************************************************************************
+    *    Stage III -  Define index space mapping
+    **************************************************************************************/
+    tpc_lib_api::TensorAccessPattern dataPattern = {};
+    tpc_lib_api::TensorAccessPattern maskPattern = {};
 
+    // f_start f(i) = c_maskBlockElements*i + 0;
+    // f_end   f(i) = c_maskBlockElements*i + (c_maskBlockElements - 1);
+    dataPattern.mapping[0].indexSpaceDim = 0;
+    dataPattern.mapping[0].a             = c_maskBlockElements;
+    dataPattern.mapping[0].start_b       = 0;
+    dataPattern.mapping[0].end_b         = c_maskBlockElements - 1;
+
+    // f_start f(i) = elementsInVec*i + 0;
+    // f_end   f(i) = elementsInVec*i + (elementsInVec - 1);
+    maskPattern.mapping[0].indexSpaceDim = 0;
+    maskPattern.mapping[0].a             = elementsInVec;
+    maskPattern.mapping[0].start_b       = 0;
+    maskPattern.mapping[0].end_b         = elementsInVec - 1;
+
+    // f_start f(i) = 1*i + 0;
+    // f_end   f(i) = 1*i + 0;
+    for (unsigned int dims = 1; dims < out_defs->indexSpaceRank; dims++)
+    {
+        dataPattern.mapping[dims].indexSpaceDim = dims;
+        dataPattern.mapping[dims].a             = 1;
+        dataPattern.mapping[dims].start_b       = 0;
+        dataPattern.mapping[dims].end_b         = 1 - 1;
+        maskPattern.mapping[dims] = dataPattern.mapping[dims];
+    }
+
+    out_defs->inputTensorAccessPattern[0] = dataPattern;
+    out_defs->outputTensorAccessPattern[0] = dataPattern;
+    if (isBwd)
+        out_defs->inputTensorAccessPattern[1] = maskPattern;
+    else
+        out_defs->outputTensorAccessPattern[1] = maskPattern;
+
+    /*************************************************************************************
+    *    Stage IV -  define scalar parameters
+    **************************************************************************************/
+    out_defs->kernel.paramsNr = 0;
+
+    /*************************************************************************************
+    *    Stage V -  Load ISA into the descriptor.
+    **************************************************************************************/
+    const int kernel = m_mode - relu_fwd_mask_f32;
+    unsigned char* binary_kernel = c_maskBinaries[kernel][0];
+    unsigned IsaSize = (c_maskBinaries[kernel][1] - c_maskBinaries[kernel][0]);
+    unsigned givenBinarySize = out_defs->kernel.elfSize;
+    out_defs->kernel.elfSize = IsaSize;
+    if (givenBinarySize >= IsaSize)
+    {
+        memcpy (out_defs->kernel.kernelElf, binary_kernel, IsaSize);
+    }
+    else
+    {
+        retVal = tpc_lib_api::GLUE_INSUFFICIENT_ELF_BUFFER;
+        return retVal;
+    }
+
+    return tpc_lib_api::GLUE_SUCCESS;
+}
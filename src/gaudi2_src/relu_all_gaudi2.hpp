@@ -28,7 +28,12 @@ public:
         relu_fwd_f32,
         relu_bwd_f32,
         relu_fwd_bf16,
-        relu_bwd_bf16
+        relu_bwd_bf16,
+        // forward with a 1 bit per element mask, backward from mask and dY
+        relu_fwd_mask_f32,
+        relu_bwd_mask_f32,
+        relu_fwd_mask_bf16,
+        relu_bwd_mask_bf16
     } Relu_mode_t;
 
     ReluAllGaudi2(Relu_mode_t mode=relu_fwd_f32) {m_mode = mode;}
@@ -41,7 +46,15 @@ public:
     virtual tpc_lib_api::GlueCodeReturn GetKernelName(
             char kernelName [tpc_lib_api::MAX_NODE_NAME], Relu_mode_t mode);
 
+    // elements of dim 0 packed into one mask vector, 32 bits per i32 lane
+    // for f32 and 16 bits per i16 lane for bf16
+    static const int c_maskBlockElements = 2048;
+
 private:
+    tpc_lib_api::GlueCodeReturn GetMaskGcDefinitions(
+            tpc_lib_api::HabanaKernelParams* in_defs,
+            tpc_lib_api::HabanaKernelInstantiation* out_defs);
+
     Relu_mode_t m_mode;
     ReluAllGaudi2(const ReluAllGaudi2& other) = delete;
     ReluAllGaudi2& operator=(const ReluAllGaudi2& other) = delete;
@@ -0,0 +1,311 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cstring>
+#include <cmath>
+#include "rope_gaudi2.hpp"
+
+extern unsigned char _binary___rope_half_cache_f32_gaudi2_o_start;
+extern unsigned char _binary___rope_half_cache_f32_gaudi2_o_end;
+extern unsigned char _binary___rope_half_cache_bf16_gaudi2_o_start;
+extern unsigned char _binary___rope_half_cache_bf16_gaudi2_o_end;
+extern unsigned char _binary___rope_interleaved_cache_f32_gaudi2_o_start;
+extern unsigned char _binary___rope_interleaved_cache_f32_gaudi2_o_end;
+extern unsigned char _binary___rope_interleaved_cache_bf16_gaudi2_o_start;
+extern unsigned char _binary___rope_interleaved_cache_bf16_gaudi2_o_end;
+extern unsigned char _binary___rope_half_dynamic_f32_gaudi2_o_start;
+extern unsigned char _binary___rope_half_dynamic_f32_gaudi2_o_end;
+extern unsigned char _binary___rope_half_dynamic_bf16_gaudi2_o_start;
+extern unsigned char _binary___rope_half_dynamic_bf16_gaudi2_o_end;
+extern unsigned char _binary___rope_interleaved_dynamic_f32_gaudi2_o_start;
+extern unsigned char _binary___rope_interleaved_dynamic_f32_gaudi2_o_end;
+extern unsigned char _binary___rope_interleaved_dynamic_bf16_gaudi2_o_start;
+extern unsigned char _binary___rope_interleaved_dynamic_bf16_gaudi2_o_end;
+
+static const char c_ropeKernelNames[][tpc_lib_api::MAX_NODE_NAME] = {
+    "custom_rope_half_cache_f32_gaudi2",
+    "custom_rope_half_cache_bf16_gaudi2",
+    "custom_rope_interleaved_cache_f32_gaudi2",
+    "custom_rope_interleaved_cache_bf16_gaudi2",
+    "custom_rope_half_dynamic_f32_gaudi2",
+    "custom_rope_half_dynamic_bf16_gaudi2",
+    "custom_rope_interleaved_dynamic_f32_gaudi2",
+    "custom_rope_interleaved_dynamic_bf16_gaudi2"
+};
+
+tpc_lib_api::GlueCodeReturn RopeGaudi2::GetKernelName(
+        char kernelName [tpc_lib_api::MAX_NODE_NAME], Rope_mode_t mode)
+{
+    if (mode > rope_interleaved_dynamic_bf16)
+        return tpc_lib_api::GLUE_NODE_NOT_FOUND;
+    strcpy(kernelName, c_ropeKernelNames[mode]);
+    return tpc_lib_api::GLUE_SUCCESS;
+}
+
+bool RopeGaudi2::UseCache() const
+{
+    return m_mode <= rope_interleaved_cache_bf16;
+}
+
+bool RopeGaudi2::IsBF16() const
+{
+    // bf16 modes follow their f32 twin in the enum
+    return (m_mode % 2) == 1;
+}
+
+tpc_lib_api::GlueCodeReturn RopeGaudi2::GetGcDefinitions(
+        tpc_lib_api::HabanaKernelParams* in_defs,
+        tpc_lib_api::HabanaKernelInstantiation* out_defs)
+{
+    tpc_lib_api::GlueCodeReturn retVal;
+
+    // Tensor order is a convention between the TPC kernel writer and the
+    // framework layer writer:
+    //   inputs  : q {D, S, Hq, B}, k {D, S, Hk, B}, positions i32 {S, B},
+    //             [cos {D, maxPos}, sin {D, maxPos}]
+    //   outputs : qOut, kOut, which may alias q and k
+    // positions are data, so the cache modes cannot check them here, the
+    // kernel clamps them to [0, maxPos - 1].
+    const unsigned inputNr = UseCache() ? 5 : 3;
+
+    /*************************************************************************************
+    *   Stage I - validate input
+    **************************************************************************************/
+    //validate correct amount of input tensors
+    if (in_defs->inputTensorNr != inputNr)
+    {
+        in_defs->inputTensorNr  = inputNr;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_COUNT;
+    }
+    //validate correct amount of output tensors
+    if (in_defs->outputTensorNr != 2)
+    {
+        in_defs->outputTensorNr  = 2;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_COUNT;
+    }
+
+    // validate input and output data type
+    const tpc_lib_api::TensorDataType dataType = IsBF16() ? tpc_lib_api::DATA_BF16 : tpc_lib_api::DATA_F32;
+    for (unsigned i = 0; i < inputNr; i++)
+    {
+        tpc_lib_api::TensorDataType expectedType = (i == 2) ? tpc_lib_api::DATA_I32 : dataType;
+        if (in_defs->inputTensors[i].geometry.dataType != expectedType)
+        {
+            in_defs->inputTensors[i].geometry.dataType = expectedType;
+            return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+        }
+    }
+    for (unsigned i = 0; i < 2; i++)
+    {
+        if (in_defs->outputTensors[i].geometry.dataType != dataType)
+        {
+            in_defs->outputTensors[i].geometry.dataType = dataType;
+            return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+        }
+    }
+
+    const uint64_t* qSizes = in_defs->inputTensors[0].geometry.maxSizes;
+    const uint64_t* kSizes = in_defs->inputTensors[1].geometry.maxSizes;
+    const uint64_t* posSizes = in_defs->inputTensors[2].geometry.maxSizes;
+    const uint64_t headDim = qSizes[0];
+    const int elementsInVec = IsBF16() ? 128 : 64;
+
+    // q and k share the head dim, sequence and batch, the head count may differ
+    if (in_defs->inputTensors[0].geometry.dims != 4 ||
+        in_defs->inputTensors[1].geometry.dims != 4 ||
+        headDim % 2 != 0 || headDim > (uint64_t)(c_maxHeadVectors * elementsInVec) ||
+        kSizes[0] != headDim || kSizes[1] != qSizes[1] || kSizes[3] != qSizes[3])
+    {
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+    }
+
+    if (in_defs->inputTensors[2].geometry.dims != 2 ||
+        posSizes[0] != qSizes[1] || posSizes[1] != qSizes[3])
+    {
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+    }
+
+    if (UseCache())
+    {
+        for (unsigned i = 3; i < 5; i++)
+        {
+            if (in_defs->inputTensors[i].geometry.dims != 2 ||
+                in_defs->inputTensors[i].geometry.maxSizes[0] != headDim ||
+                in_defs->inputTensors[i].geometry.maxSizes[1] != in_defs->inputTensors[3].geometry.maxSizes[1])
+            {
+                return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+            }
+        }
+    }
+
+    // verify that output feature map dimension are correct
+    for (unsigned i = 0; i < 2; i++)
+    {
+        if (in_defs->outputTensors[i].geometry.dims != 4 ||
+            memcmp(in_defs->outputTensors[i].geometry.maxSizes,
+                   in_defs->inputTensors[i].geometry.maxSizes, 4 * sizeof(uint64_t)) != 0)
+        {
+            memcpy(in_defs->outputTensors[i].geometry.maxSizes,
+                   in_defs->inputTensors[i].geometry.maxSizes, 4 * sizeof(uint64_t));
+            return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_SIZE;
+        }
+    }
+
+    /*************************************************************************************
+    *    Stage II -  Define index space geometry. Every member rotates all heads of one
+    *    (token, batch) row, so the position lookup and cos/sin are shared by all heads.
+    **************************************************************************************/
+    out_defs->indexSpaceRank = 4;
+    out_defs->indexSpaceGeometry[0] = 1;
+    out_defs->indexSpaceGeometry[1] = qSizes[1];
+    out_defs->indexSpaceGeometry[2] = 1;
+    out_defs->indexSpaceGeometry[3] = qSizes[3];
+
+    /*************************************************************************************
+    *    Stage III -  Define index space mapping
+    **************************************************************************************/
+    // q, k, qOut, kOut
+    for (unsigned i = 0; i < 4; i++)
+    {
+        bool isInput = i < 2;
+        tpc_lib_api::TensorAccessPattern* pattern = isInput ?
+                &out_defs->inputTensorAccessPattern[i] : &out_defs->outputTensorAccessPattern[i - 2];
+        const uint64_t* sizes = isInput ? in_defs->inputTensors[i].geometry.maxSizes :
+                                          in_defs->outputTensors[i - 2].geometry.maxSizes;
+
+        // f_start f(i) = 0;
+        // f_end   f(i) = size - 1 (whole head dim and all heads)
+        pattern->mapping[0].indexSpaceDim = 0;
+        pattern->mapping[0].a             = 0;
+        pattern->mapping[0].start_b       = 0;
+        pattern->mapping[0].end_b         = sizes[0] - 1;
+        pattern->mapping[2].indexSpaceDim = 2;
+        pattern->mapping[2].a             = 0;
+        pattern->mapping[2].start_b       = 0;
+        pattern->mapping[2].end_b         = sizes[2] - 1;
+
+        // f_start f(i) = 1*i + 0;
+        // f_end   f(i) = 1*i + 0;
+        pattern->mapping[1].indexSpaceDim = 1;
+        pattern->mapping[1].a             = 1;
+        pattern->mapping[1].start_b       = 0;
+        pattern->mapping[1].end_b         = 0;
+        pattern->mapping[3].indexSpaceDim = 3;
+        pattern->mapping[3].a             = 1;
+        pattern->mapping[3].start_b       = 0;
+        pattern->mapping[3].end_b         = 0;
+    }
+
+    // positions {S, B} follow index space dims 1 and 3
+    out_defs->inputTensorAccessPattern[2].mapping[0].indexSpaceDim = 1;
+    out_defs->inputTensorAccessPattern[2].mapping[0].a             = 1;
+    out_defs->inputTensorAccessPattern[2].mapping[0].start_b       = 0;
+    out_defs->inputTensorAccessPattern[2].mapping[0].end_b         = 0;
+    out_defs->inputTensorAccessPattern[2].mapping[1].indexSpaceDim = 3;
+    out_defs->inputTensorAccessPattern[2].mapping[1].a             = 1;
+    out_defs->inputTensorAccessPattern[2].mapping[1].start_b       = 0;
+    out_defs->inputTensorAccessPattern[2].mapping[1].end_b         = 0;
+
+    // the cached row depends on the position value, the whole cache is required
+    if (UseCache())
+    {
+        for (unsigned i = 3; i < 5; i++)
+        {
+            out_defs->inputTensorAccessPattern[i].allRequired = true;
+            for (unsigned dim = 0; dim < 2; dim++)
+            {
+                out_defs->inputTensorAccessPattern[i].mapping[dim].indexSpaceDim = 0;
+                out_defs->inputTensorAccessPattern[i].mapping[dim].a             = 0;
+                out_defs->inputTensorAccessPattern[i].mapping[dim].start_b       = 0;
+                out_defs->inputTensorAccessPattern[i].mapping[dim].end_b         =
+                        in_defs->inputTensors[i].geometry.maxSizes[dim] - 1;
+            }
+        }
+    }
+
+    /*************************************************************************************
+    *    Stage IV -  define scalar parameters
+    **************************************************************************************/
+    if (UseCache())
+    {
+        out_defs->kernel.paramsNr = 0;
+    }
+    else
+    {
+        // inverse frequency of pair i is exp(i * freqScale)
+        RopeParams* def = static_cast<RopeParams*>(in_defs->nodeParams.nodeParams);
+        float freqScale = -2.0f * logf(def->thetaBase) / (float)headDim;
+        out_defs->kernel.paramsNr = 1;
+        memcpy(&(out_defs->kernel.scalarParams[0]), &freqScale, sizeof(float));
+    }
+
+    /*************************************************************************************
+    *    Stage V -  Load ISA into the descriptor.
+    **************************************************************************************/
+    unsigned IsaSize = (&_binary___rope_half_cache_f32_gaudi2_o_end - &_binary___rope_half_cache_f32_gaudi2_o_start);
+    unsigned char *binary_kernel = &_binary___rope_half_cache_f32_gaudi2_o_start;
+    switch (m_mode)
+    {
+        case rope_half_cache_f32:
+            IsaSize = (&_binary___rope_half_cache_f32_gaudi2_o_end - &_binary___rope_half_cache_f32_gaudi2_o_start);
+            binary_kernel = &_binary___rope_half_cache_f32_gaudi2_o_start;
+            break;
+        case rope_half_cache_bf16:
+            IsaSize = (&_binary___rope_half_cache_bf16_gaudi2_o_end - &_binary___rope_half_cache_bf16_gaudi2_o_start);
+            binary_kernel = &_binary___rope_half_cache_bf16_gaudi2_o_start;
+            break;
+        case rope_interleaved_cache_f32:
+            IsaSize = (&_binary___rope_interleaved_cache_f32_gaudi2_o_end - &_binary___rope_interleaved_cache_f32_gaudi2_o_start);
+            binary_kernel = &_binary___rope_interleaved_cache_f32_gaudi2_o_start;
+            break;
+        case rope_interleaved_cache_bf16:
+            IsaSize = (&_binary___rope_interleaved_cache_bf16_gaudi2_o_end - &_binary___rope_interleaved_cache_bf16_gaudi2_o_start);
+            binary_kernel = &_binary___rope_interleaved_cache_bf16_gaudi2_o_start;
+            break;
+        case rope_half_dynamic_f32:
+            IsaSize = (&_binary___rope_half_dynamic_f32_gaudi2_o_end - &_binary___rope_half_dynamic_f32_gaudi2_o_start);
+            binary_kernel = &_binary___rope_half_dynamic_f32_gaudi2_o_start;
+            break;
+        case rope_half_dynamic_bf16:
+            IsaSize = (&_binary___rope_half_dynamic_bf16_gaudi2_o_end - &_binary___rope_half_dynamic_bf16_gaudi2_o_start);
+            binary_kernel = &_binary___rope_half_dynamic_bf16_gaudi2_o_start;
+            break;
+        case rope_interleaved_dynamic_f32:
+            IsaSize = (&_binary___rope_interleaved_dynamic_f32_gaudi2_o_end - &_binary___rope_interleaved_dynamic_f32_gaudi2_o_start);
+            binary_kernel = &_binary___rope_interleaved_dynamic_f32_gaudi2_o_start;
+            break;
+        case rope_interleaved_dynamic_bf16:
+            IsaSize = (&_binary___rope_interleaved_dynamic_bf16_gaudi2_o_end - &_binary___rope_interleaved_dynamic_bf16_gaudi2_o_start);
+            binary_kernel = &_binary___rope_interleaved_dynamic_bf16_gaudi2_o_start;
+            break;
+        default:
+            break;
+    }
+
+    unsigned givenBinarySize = out_defs->kernel.elfSize;
+    out_defs->kernel.elfSize = IsaSize;
+    if (givenBinarySize >= IsaSize)
+    {
+        memcpy (out_defs->kernel.kernelElf, binary_kernel, IsaSize);
+    }
+    else
+    {
+        retVal = tpc_lib_api::GLUE_INSUFFICIENT_ELF_BUFFER;
+        return retVal;
+    }
+
+    return tpc_lib_api::GLUE_SUCCESS;
+}
@@ -0,0 +1,70 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef _ROPE_GAUDI2_HPP
+#define _ROPE_GAUDI2_HPP
+
+#include "gc_interface.h"
+#include "tpc_kernel_lib_interface.h"
+
+class RopeGaudi2
+{
+public:
+    // half / interleaved rotation layout, cos/sin cache or on-the-fly angles
+    typedef enum _Rope_mode_t
+    {
+        rope_half_cache_f32,
+        rope_half_cache_bf16,
+        rope_interleaved_cache_f32,
+        rope_interleaved_cache_bf16,
+        rope_half_dynamic_f32,
+        rope_half_dynamic_bf16,
+        rope_interleaved_dynamic_f32,
+        rope_interleaved_dynamic_bf16
+    } Rope_mode_t;
+
+    RopeGaudi2(Rope_mode_t mode=rope_half_cache_f32) {m_mode = mode;}
+    virtual ~RopeGaudi2() {}
+
+    virtual tpc_lib_api::GlueCodeReturn GetGcDefinitions(
+            tpc_lib_api::HabanaKernelParams* in_defs,
+            tpc_lib_api::HabanaKernelInstantiation* out_defs);
+
+    virtual tpc_lib_api::GlueCodeReturn GetKernelName(
+            char kernelName [tpc_lib_api::MAX_NODE_NAME], Rope_mode_t mode);
+
+    // This struct is common between the TPC kernel writer and the framework
+    // layer writer. The programmer who adds a new layer to the framework-backend
+    // is responsible to fill the structure with valid data.
+    // Only the dynamic modes use it.
+    struct RopeParams
+    {
+        float thetaBase;
+    };
+
+    // Vectors of one head the kernel stages in VLM.
+    static const int c_maxHeadVectors = 4;
+
+private:
+    bool UseCache() const;
+    bool IsBF16() const;
+
+    Rope_mode_t m_mode;
+    RopeGaudi2(const RopeGaudi2& other) = delete;
+    RopeGaudi2& operator=(const RopeGaudi2& other) = delete;
+};
+
+#endif //_ROPE_GAUDI2_HPP
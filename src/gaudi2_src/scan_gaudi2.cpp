@@ -0,0 +1,330 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cstring>
+#include <cstdio>
+#include "scan_gaudi2.hpp"
+
+extern unsigned char _binary___cumsum_f32_gaudi2_o_start;
+extern unsigned char _binary___cumsum_f32_gaudi2_o_end;
+extern unsigned char _binary___cumsum_block_reduce_f32_gaudi2_o_start;
+extern unsigned char _binary___cumsum_block_reduce_f32_gaudi2_o_end;
+extern unsigned char _binary___cumsum_block_fixup_f32_gaudi2_o_start;
+extern unsigned char _binary___cumsum_block_fixup_f32_gaudi2_o_end;
+extern unsigned char _binary___cumsum_bf16_gaudi2_o_start;
+extern unsigned char _binary___cumsum_bf16_gaudi2_o_end;
+extern unsigned char _binary___cumsum_block_reduce_bf16_gaudi2_o_start;
+extern unsigned char _binary___cumsum_block_reduce_bf16_gaudi2_o_end;
+extern unsigned char _binary___cumsum_block_fixup_bf16_gaudi2_o_start;
+extern unsigned char _binary___cumsum_block_fixup_bf16_gaudi2_o_end;
+extern unsigned char _binary___cumsum_i32_gaudi2_o_start;
+extern unsigned char _binary___cumsum_i32_gaudi2_o_end;
+extern unsigned char _binary___cumsum_block_reduce_i32_gaudi2_o_start;
+extern unsigned char _binary___cumsum_block_reduce_i32_gaudi2_o_end;
+extern unsigned char _binary___cumsum_block_fixup_i32_gaudi2_o_start;
+extern unsigned char _binary___cumsum_block_fixup_i32_gaudi2_o_end;
+extern unsigned char _binary___cumprod_f32_gaudi2_o_start;
+extern unsigned char _binary___cumprod_f32_gaudi2_o_end;
+extern unsigned char _binary___cumprod_block_reduce_f32_gaudi2_o_start;
+extern unsigned char _binary___cumprod_block_reduce_f32_gaudi2_o_end;
+extern unsigned char _binary___cumprod_block_fixup_f32_gaudi2_o_start;
+extern unsigned char _binary___cumprod_block_fixup_f32_gaudi2_o_end;
+extern unsigned char _binary___cumprod_bf16_gaudi2_o_start;
+extern unsigned char _binary___cumprod_bf16_gaudi2_o_end;
+extern unsigned char _binary___cumprod_block_reduce_bf16_gaudi2_o_start;
+extern unsigned char _binary___cumprod_block_reduce_bf16_gaudi2_o_end;
+extern unsigned char _binary___cumprod_block_fixup_bf16_gaudi2_o_start;
+extern unsigned char _binary___cumprod_block_fixup_bf16_gaudi2_o_end;
+extern unsigned char _binary___cumprod_i32_gaudi2_o_start;
+extern unsigned char _binary___cumprod_i32_gaudi2_o_end;
+extern unsigned char _binary___cumprod_block_reduce_i32_gaudi2_o_start;
+extern unsigned char _binary___cumprod_block_reduce_i32_gaudi2_o_end;
+extern unsigned char _binary___cumprod_block_fixup_i32_gaudi2_o_start;
+extern unsigned char _binary___cumprod_block_fixup_i32_gaudi2_o_end;
+
+static const char* const c_scanModeNames[] = {
+    "cumsum_f32",
+    "cumsum_block_reduce_f32",
+    "cumsum_block_fixup_f32",
+    "cumsum_bf16",
+    "cumsum_block_reduce_bf16",
+    "cumsum_block_fixup_bf16",
+    "cumsum_i32",
+    "cumsum_block_reduce_i32",
+    "cumsum_block_fixup_i32",
+    "cumprod_f32",
+    "cumprod_block_reduce_f32",
+    "cumprod_block_fixup_f32",
+    "cumprod_bf16",
+    "cumprod_block_reduce_bf16",
+    "cumprod_block_fixup_bf16",
+    "cumprod_i32",
+    "cumprod_block_reduce_i32",
+    "cumprod_block_fixup_i32"
+};
+
+static unsigned char* const c_scanBinaries[][2] = {
+    {&_binary___cumsum_f32_gaudi2_o_start, &_binary___cumsum_f32_gaudi2_o_end},
+    {&_binary___cumsum_block_reduce_f32_gaudi2_o_start, &_binary___cumsum_block_reduce_f32_gaudi2_o_end},
+    {&_binary___cumsum_block_fixup_f32_gaudi2_o_start, &_binary___cumsum_block_fixup_f32_gaudi2_o_end},
+    {&_binary___cumsum_bf16_gaudi2_o_start, &_binary___cumsum_bf16_gaudi2_o_end},
+    {&_binary___cumsum_block_reduce_bf16_gaudi2_o_start, &_binary___cumsum_block_reduce_bf16_gaudi2_o_end},
+    {&_binary___cumsum_block_fixup_bf16_gaudi2_o_start, &_binary___cumsum_block_fixup_bf16_gaudi2_o_end},
+    {&_binary___cumsum_i32_gaudi2_o_start, &_binary___cumsum_i32_gaudi2_o_end},
+    {&_binary___cumsum_block_reduce_i32_gaudi2_o_start, &_binary___cumsum_block_reduce_i32_gaudi2_o_end},
+    {&_binary___cumsum_block_fixup_i32_gaudi2_o_start, &_binary___cumsum_block_fixup_i32_gaudi2_o_end},
+    {&_binary___cumprod_f32_gaudi2_o_start, &_binary___cumprod_f32_gaudi2_o_end},
+    {&_binary___cumprod_block_reduce_f32_gaudi2_o_start, &_binary___cumprod_block_reduce_f32_gaudi2_o_end},
+    {&_binary___cumprod_block_fixup_f32_gaudi2_o_start, &_binary___cumprod_block_fixup_f32_gaudi2_o_end},
+    {&_binary___cumprod_bf16_gaudi2_o_start, &_binary___cumprod_bf16_gaudi2_o_end},
+    {&_binary___cumprod_block_reduce_bf16_gaudi2_o_start, &_binary___cumprod_block_reduce_bf16_gaudi2_o_end},
+    {&_binary___cumprod_block_fixup_bf16_gaudi2_o_start, &_binary___cumprod_block_fixup_bf16_gaudi2_o_end},
+    {&_binary___cumprod_i32_gaudi2_o_start, &_binary___cumprod_i32_gaudi2_o_end},
+    {&_binary___cumprod_block_reduce_i32_gaudi2_o_start, &_binary___cumprod_block_reduce_i32_gaudi2_o_end},
+    {&_binary___cumprod_block_fixup_i32_gaudi2_o_start, &_binary___cumprod_block_fixup_i32_gaudi2_o_end}
+};
+
+tpc_lib_api::GlueCodeReturn ScanGaudi2::GetKernelName(
+        char kernelName [tpc_lib_api::MAX_NODE_NAME], Scan_mode_t mode)
+{
+    if (mode >= scan_mode_count)
+        return tpc_lib_api::GLUE_NODE_NOT_FOUND;
+    snprintf(kernelName, tpc_lib_api::MAX_NODE_NAME, "custom_%s_gaudi2", c_scanModeNames[mode]);
+    return tpc_lib_api::GLUE_SUCCESS;
+}
+
+ScanGaudi2::Scan_phase_t ScanGaudi2::GetPhase(Scan_mode_t mode)
+{
+    return (Scan_phase_t)(mode % 3);
+}
+
+tpc_lib_api::TensorDataType ScanGaudi2::GetDataType(Scan_mode_t mode)
+{
+    switch ((mode / 3) % 3)
+    {
+        case 1:  return tpc_lib_api::DATA_BF16;
+        case 2:  return tpc_lib_api::DATA_I32;
+        default: return tpc_lib_api::DATA_F32;
+    }
+}
+
+tpc_lib_api::TensorDataType ScanGaudi2::GetSumsDataType(Scan_mode_t mode)
+{
+    // bf16 blocks are reduced in f32
+    return GetDataType(mode) == tpc_lib_api::DATA_I32 ? tpc_lib_api::DATA_I32 : tpc_lib_api::DATA_F32;
+}
+
+unsigned ScanGaudi2::GetVectorSize(Scan_mode_t mode)
+{
+    return GetDataType(mode) == tpc_lib_api::DATA_BF16 ? 128 : 64;
+}
+
+void ScanGaudi2::GetBlockSumsSizes(Scan_mode_t mode, const uint64_t* ifmSizes,
+                                   int32_t axis, int32_t blockSize, uint64_t* sumsSizes)
+{
+    const uint64_t vectorSize = GetVectorSize(mode);
+    memcpy(sumsSizes, ifmSizes, 4 * sizeof(uint64_t));
+    sumsSizes[axis] = (ifmSizes[axis] + blockSize - 1) / blockSize;
+    if (axis != 0)
+    {
+        // the f32 parts of a bf16 vector are stored side by side
+        sumsSizes[0] = (ifmSizes[0] + vectorSize - 1) / vectorSize * vectorSize;
+    }
+}
+
+tpc_lib_api::GlueCodeReturn ScanGaudi2::GetGcDefinitions(
+        tpc_lib_api::HabanaKernelParams* in_defs,
+        tpc_lib_api::HabanaKernelInstantiation* out_defs)
+{
+    tpc_lib_api::GlueCodeReturn retVal;
+    ScanParams* def = static_cast<ScanParams*>(in_defs->nodeParams.nodeParams);
+    const Scan_phase_t phase = GetPhase(m_mode);
+    const tpc_lib_api::TensorDataType dataType = GetDataType(m_mode);
+    const tpc_lib_api::TensorDataType sumsType = GetSumsDataType(m_mode);
+    const unsigned vectorSize = GetVectorSize(m_mode);
+
+    // Tensor order is a convention between the TPC kernel writer and the
+    // framework layer writer:
+    //   single pass  : ifm -> ofm
+    //   block reduce : ifm -> blockSums
+    //   block fixup  : ifm, blockCarry -> ofm
+    const unsigned inputNr = (phase == scan_block_fixup) ? 2 : 1;
+
+    /*************************************************************************************
+    *   Stage I - validate input
+    **************************************************************************************/
+    //validate correct amount of input tensors
+    if (in_defs->inputTensorNr != inputNr)
+    {
+        in_defs->inputTensorNr  = inputNr;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_COUNT;
+    }
+    //validate correct amount of output tensors
+    if (in_defs->outputTensorNr != 1)
+    {
+        in_defs->outputTensorNr  = 1;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_COUNT;
+    }
+
+    // validate input and output data type
+    const tpc_lib_api::TensorDataType outputType = (phase == scan_block_reduce) ? sumsType : dataType;
+    if (in_defs->inputTensors[0].geometry.dataType != dataType ||
+        in_defs->outputTensors[0].geometry.dataType != outputType)
+    {
+        in_defs->inputTensors[0].geometry.dataType = dataType;
+        in_defs->outputTensors[0].geometry.dataType = outputType;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+    }
+    if (phase == scan_block_fixup && in_defs->inputTensors[1].geometry.dataType != sumsType)
+    {
+        in_defs->inputTensors[1].geometry.dataType = sumsType;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+    }
+
+    const unsigned dims = in_defs->inputTensors[0].geometry.dims;
+    if (dims < 1 || dims > 4 || def->axis < 0 || def->axis >= (int32_t)dims)
+    {
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+    }
+    uint64_t ifmSizes[4] = {1, 1, 1, 1};
+    memcpy(ifmSizes, in_defs->inputTensors[0].geometry.maxSizes, dims * sizeof(uint64_t));
+    const int32_t axis = def->axis;
+
+    // a single pass is one block covering the whole axis
+    int32_t blockSize = (int32_t)ifmSizes[axis];
+    if (phase != scan_single_pass)
+    {
+        blockSize = def->blockSize;
+        if (blockSize <= 0 || (axis == 0 && blockSize % vectorSize != 0))
+        {
+            return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+        }
+    }
+
+    uint64_t sumsSizes[4];
+    GetBlockSumsSizes(m_mode, ifmSizes, axis, blockSize, sumsSizes);
+    if (phase == scan_block_fixup &&
+        (in_defs->inputTensors[1].geometry.dims != dims ||
+         memcmp(in_defs->inputTensors[1].geometry.maxSizes, sumsSizes, dims * sizeof(uint64_t)) != 0))
+    {
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+    }
+
+    // verify that output feature map dimension are correct
+    const uint64_t* outputSizes = (phase == scan_block_reduce) ? sumsSizes : ifmSizes;
+    if (in_defs->outputTensors[0].geometry.dims != dims ||
+        memcmp(in_defs->outputTensors[0].geometry.maxSizes, outputSizes, dims * sizeof(uint64_t)) != 0)
+    {
+        memcpy(in_defs->outputTensors[0].geometry.maxSizes, outputSizes, dims * sizeof(uint64_t));
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_SIZE;
+    }
+
+    /*************************************************************************************
+    *    Stage II -  Define index space geometry. Dim 0 is split to vectors unless it is
+    *    scanned, and the axis holds one member per block.
+    **************************************************************************************/
+    out_defs->indexSpaceRank = 4;
+    out_defs->indexSpaceGeometry[0] = (ifmSizes[0] + vectorSize - 1) / vectorSize;
+    out_defs->indexSpaceGeometry[1] = ifmSizes[1];
+    out_defs->indexSpaceGeometry[2] = ifmSizes[2];
+    out_defs->indexSpaceGeometry[3] = ifmSizes[3];
+    out_defs->indexSpaceGeometry[axis] = sumsSizes[axis];
+
+    /*************************************************************************************
+    *    Stage III -  Define index space mapping
+    **************************************************************************************/
+    // ifm, [blockCarry], ofm / blockSums
+    for (unsigned i = 0; i < inputNr + 1; i++)
+    {
+        tpc_lib_api::TensorAccessPattern* pattern = (i < inputNr) ?
+                &out_defs->inputTensorAccessPattern[i] : &out_defs->outputTensorAccessPattern[0];
+        const bool isSums = (i == 1 && phase == scan_block_fixup) ||
+                            (i == inputNr && phase == scan_block_reduce);
+
+        for (unsigned dim = 0; dim < 4; dim++)
+        {
+            pattern->mapping[dim].indexSpaceDim = dim;
+            if (dim == (unsigned)axis && isSums)
+            {
+                // f_start f(i) = 1*i + 0;
+                // f_end   f(i) = 1*i + 0;
+                pattern->mapping[dim].a       = 1;
+                pattern->mapping[dim].start_b = 0;
+                pattern->mapping[dim].end_b   = 0;
+            }
+            else if (dim == (unsigned)axis)
+            {
+                // f_start f(i) = blockSize*i + 0;
+                // f_end   f(i) = blockSize*i + blockSize - 1;
+                // a dim 0 block also reads the vector preceding it
+                pattern->mapping[dim].a       = blockSize;
+                pattern->mapping[dim].start_b = (axis == 0 && i == 0) ? -(int)vectorSize : 0;
+                pattern->mapping[dim].end_b   = blockSize - 1;
+            }
+            else if (dim == 0)
+            {
+                // f_start f(i) = vectorSize*i + 0;
+                // f_end   f(i) = vectorSize*i + vectorSize - 1;
+                pattern->mapping[dim].a       = vectorSize;
+                pattern->mapping[dim].start_b = 0;
+                pattern->mapping[dim].end_b   = vectorSize - 1;
+            }
+            else
+            {
+                // f_start f(i) = 1*i + 0;
+                // f_end   f(i) = 1*i + 0;
+                pattern->mapping[dim].a       = 1;
+                pattern->mapping[dim].start_b = 0;
+                pattern->mapping[dim].end_b   = 0;
+            }
+        }
+    }
+
+    /*************************************************************************************
+    *    Stage IV -  define scalar parameters
+    **************************************************************************************/
+    unsigned paramsNr = 0;
+    memcpy(&(out_defs->kernel.scalarParams[paramsNr++]), &axis, sizeof(int32_t));
+    if (phase != scan_single_pass)
+    {
+        memcpy(&(out_defs->kernel.scalarParams[paramsNr++]), &blockSize, sizeof(int32_t));
+    }
+    if (phase != scan_block_reduce)
+    {
+        int32_t exclusive = def->exclusive ? 1 : 0;
+        memcpy(&(out_defs->kernel.scalarParams[paramsNr++]), &exclusive, sizeof(int32_t));
+    }
+    out_defs->kernel.paramsNr = paramsNr;
+
+    /*************************************************************************************
+    *    Stage V -  Load ISA into the descriptor.
+    **************************************************************************************/
+    unsigned char* binary_kernel = c_scanBinaries[m_mode][0];
+    unsigned IsaSize = c_scanBinaries[m_mode][1] - c_scanBinaries[m_mode][0];
+    unsigned givenBinarySize = out_defs->kernel.elfSize;
+    out_defs->kernel.elfSize = IsaSize;
+    if (givenBinarySize >= IsaSize)
+    {
+        memcpy (out_defs->kernel.kernelElf, binary_kernel, IsaSize);
+    }
+    else
+    {
+        retVal = tpc_lib_api::GLUE_INSUFFICIENT_ELF_BUFFER;
+        return retVal;
+    }
+
+    return tpc_lib_api::GLUE_SUCCESS;
+}
@@ -0,0 +1,102 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef _SCAN_GAUDI2_HPP
+#define _SCAN_GAUDI2_HPP
+
+#include "gc_interface.h"
+#include "tpc_kernel_lib_interface.h"
+
+class ScanGaudi2
+{
+public:
+    // Every op / data type has a single pass mode and the two block phases of
+    // the three-phase scan, in that order.
+    //
+    // Three-phase scan of a long axis with blockSize elements per block:
+    //   1. *_block_reduce : ifm -> blockSums
+    //   2. single pass    : blockSums -> blockCarry, exclusive, on the f32 / i32
+    //                       mode of the same op
+    //   3. *_block_fixup  : ifm, blockCarry -> ofm
+    typedef enum _Scan_mode_t
+    {
+        cumsum_f32,
+        cumsum_block_reduce_f32,
+        cumsum_block_fixup_f32,
+        cumsum_bf16,
+        cumsum_block_reduce_bf16,
+        cumsum_block_fixup_bf16,
+        cumsum_i32,
+        cumsum_block_reduce_i32,
+        cumsum_block_fixup_i32,
+        cumprod_f32,
+        cumprod_block_reduce_f32,
+        cumprod_block_fixup_f32,
+        cumprod_bf16,
+        cumprod_block_reduce_bf16,
+        cumprod_block_fixup_bf16,
+        cumprod_i32,
+        cumprod_block_reduce_i32,
+        cumprod_block_fixup_i32,
+        scan_mode_count
+    } Scan_mode_t;
+
+    ScanGaudi2(Scan_mode_t mode=cumsum_f32) {m_mode = mode;}
+    virtual ~ScanGaudi2() {}
+
+    virtual tpc_lib_api::GlueCodeReturn GetGcDefinitions(
+            tpc_lib_api::HabanaKernelParams* in_defs,
+            tpc_lib_api::HabanaKernelInstantiation* out_defs);
+
+    virtual tpc_lib_api::GlueCodeReturn GetKernelName(
+            char kernelName [tpc_lib_api::MAX_NODE_NAME], Scan_mode_t mode);
+
+    // This struct is common between the TPC kernel writer and the framework
+    // layer writer. The programmer who adds a new layer to the framework-backend
+    // is responsible to fill the structure with valid data.
+    // blockSize is used by the block phases only and must be a multiple of
+    // the vector size when scanning dim 0.
+    struct ScanParams
+    {
+        int32_t axis;
+        int32_t exclusive;
+        int32_t blockSize;
+    };
+
+    // Sizes of the blockSums / blockCarry tensor of a 4D ifm: the axis holds
+    // one entry per block, dim 0 is padded to whole vectors for bf16.
+    static void GetBlockSumsSizes(Scan_mode_t mode, const uint64_t* ifmSizes,
+                                  int32_t axis, int32_t blockSize, uint64_t* sumsSizes);
+
+private:
+    typedef enum _Scan_phase_t
+    {
+        scan_single_pass,
+        scan_block_reduce,
+        scan_block_fixup
+    } Scan_phase_t;
+
+    static Scan_phase_t GetPhase(Scan_mode_t mode);
+    static tpc_lib_api::TensorDataType GetDataType(Scan_mode_t mode);
+    static tpc_lib_api::TensorDataType GetSumsDataType(Scan_mode_t mode);
+    static unsigned GetVectorSize(Scan_mode_t mode);
+
+    Scan_mode_t m_mode;
+    ScanGaudi2(const ScanGaudi2& other) = delete;
+    ScanGaudi2& operator=(const ScanGaudi2& other) = delete;
+};
+
+#endif //_SCAN_GAUDI2_HPP
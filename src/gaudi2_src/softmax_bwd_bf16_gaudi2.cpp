@@ -0,0 +1,196 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include "softmax_bwd_bf16_gaudi2.hpp"
+
+extern unsigned char _binary___softmax_bwd_fcd_bf16_gaudi2_o_start;
+extern unsigned char _binary___softmax_bwd_fcd_bf16_gaudi2_o_end;
+extern unsigned char _binary___softmax_bwd_non_fcd_bf16_gaudi2_o_start;
+extern unsigned char _binary___softmax_bwd_non_fcd_bf16_gaudi2_o_end;
+
+ tpc_lib_api::GlueCodeReturn SoftMaxBwdBF16Gaudi2::GetKernelNameFcd(
+             char kernelName [tpc_lib_api::MAX_NODE_NAME])
+ {
+     strcpy(kernelName,"custom_softmax_bwd_fcd_bf16_gaudi2");
+     return tpc_lib_api::GLUE_SUCCESS;
+ }
+
+ tpc_lib_api::GlueCodeReturn SoftMaxBwdBF16Gaudi2::GetKernelNameNonFcd(
+             char kernelName [tpc_lib_api::MAX_NODE_NAME])
+ {
+     strcpy(kernelName,"custom_softmax_bwd_non_fcd_bf16_gaudi2");
+     return tpc_lib_api::GLUE_SUCCESS;
+ }
+
+tpc_lib_api::GlueCodeReturn SoftMaxBwdBF16Gaudi2::GetGcDefinitions(
+            tpc_lib_api::HabanaKernelParams* params,
+            tpc_lib_api::HabanaKernelInstantiation* kernel)
+{
+    tpc_lib_api::GlueCodeReturn retVal;
+    SoftMaxParam* def = static_cast<SoftMaxParam*>(params->nodeParams.nodeParams);
+
+    /*************************************************************************************
+    *   Stage I - validate input
+    **************************************************************************************/
+    //validate correct amount of input tensors
+    if (params->inputTensorNr != 2)
+    {
+        params->inputTensorNr  = 2;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_COUNT;
+    }
+    //validate correct amount of output tensors
+    if (params->outputTensorNr != 1)
+    {
+        params->outputTensorNr  = 1;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_COUNT;
+    }
+    // Validate number of dimensions for input and output tensors, dims 2 and 3
+    // are outer batches of the 2D softmax
+    const unsigned dims = params->inputTensors[0].geometry.dims;
+    if (dims < 2 || dims > 4 ||
+        params->inputTensors[1].geometry.dims != dims ||
+        params->outputTensors[0].geometry.dims != dims)
+    {
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+    }
+    if (def->axis != 0 && def->axis != 1)
+    {
+        return tpc_lib_api::GLUE_UNSUPPORTED_LAYER_CONFIGURATION;
+    }
+
+    // validate input data type
+    if (params->inputTensors[0].geometry.dataType != tpc_lib_api::DATA_BF16 ||
+        params->inputTensors[1].geometry.dataType != tpc_lib_api::DATA_BF16 ||
+        params->outputTensors[0].geometry.dataType != tpc_lib_api::DATA_BF16)
+    {
+        params->inputTensors[0].geometry.dataType = tpc_lib_api::DATA_BF16;
+        params->inputTensors[1].geometry.dataType = tpc_lib_api::DATA_BF16;
+        params->outputTensors[0].geometry.dataType = tpc_lib_api::DATA_BF16;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+    }
+
+    // Tensor 0 is the forward output Y, tensor 1 the gradient dY and the
+    // output is dX. The semantics of the input tensors and their order is a
+    // convention between TPC kernel writer and the write of the layer at the
+    // framework level.
+    uint64_t inputSizes[gcapi::MAX_TENSOR_DIM] = {1, 1, 1, 1, 1};
+    memcpy(inputSizes, params->inputTensors[0].geometry.maxSizes, dims * sizeof(uint64_t));
+
+    if (memcmp(params->inputTensors[1].geometry.maxSizes, inputSizes, dims * sizeof(uint64_t)) != 0)
+    {
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+    }
+
+    // verify that output feature map dimension are correct
+    if (memcmp(params->outputTensors[0].geometry.maxSizes, inputSizes, dims * sizeof(uint64_t)) != 0)
+    {
+        memcpy(params->outputTensors[0].geometry.maxSizes, inputSizes, dims * sizeof(uint64_t));
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_SIZE;
+    }
+
+    /*************************************************************************************
+    *    Stage II -  Define index space geometry. As in the forward kernels the axis of
+    *    the reduction is a single index space member, the other axis is split.
+    *    The outer dims 2 and 3 map one to one onto the index space.
+    **************************************************************************************/
+    kernel->indexSpaceRank = 4;
+    //round up to 128 and divide by 128.
+    kernel->indexSpaceGeometry[0] = (inputSizes[0] + 127) / 128;
+    kernel->indexSpaceGeometry[1] = inputSizes[1];
+    kernel->indexSpaceGeometry[2] = inputSizes[2];
+    kernel->indexSpaceGeometry[3] = inputSizes[3];
+    kernel->indexSpaceGeometry[def->axis] = 1;
+
+    /*************************************************************************************
+    *    Stage III -  Define index space mapping
+    **************************************************************************************/
+    // y, dy and dx share the same access pattern
+    for (unsigned i = 0; i < 3; i++)
+    {
+        tpc_lib_api::TensorAccessPattern* pattern = (i < 2) ?
+                &kernel->inputTensorAccessPattern[i] : &kernel->outputTensorAccessPattern[0];
+        if (def->axis == 0)
+        {
+            // f_start(i) = 0;
+            // f_end f(i) = size[0] - 1;
+            // Access is given to all the elements since single indexspace is used
+            pattern->mapping[0].indexSpaceDim = 0;
+            pattern->mapping[0].a             = 0;
+            pattern->mapping[0].start_b       = 0;
+            pattern->mapping[0].end_b         = inputSizes[0] - 1;
+
+            // f_start(i) = 1*i + 0;
+            // f_end f(i) = 1*i + 0;
+            pattern->mapping[1].indexSpaceDim = 1;
+            pattern->mapping[1].a             = 1;
+            pattern->mapping[1].start_b       = 0;
+            pattern->mapping[1].end_b         = 0;
+        }
+        else
+        {
+            // f_start(i) = 128*i + 0;
+            // f_end f(i) = 128*i + 127;
+            pattern->mapping[0].indexSpaceDim = 0;
+            pattern->mapping[0].a             = 128;
+            pattern->mapping[0].start_b       = 0;
+            pattern->mapping[0].end_b         = 127;
+
+            // f_start(i) = 0;
+            // f_end f(i) = size[1] - 1;
+            // Access is given to all the elements since single indexspace is used
+            pattern->mapping[1].indexSpaceDim = 1;
+            pattern->mapping[1].a             = 0;
+            pattern->mapping[1].start_b       = 0;
+            pattern->mapping[1].end_b         = inputSizes[1] - 1;
+        }
+
+        // f_start(i) = 1*i + 0;
+        // f_end f(i) = 1*i + 0;
+        for (unsigned dim = 2; dim < kernel->indexSpaceRank; dim++)
+        {
+            pattern->mapping[dim].indexSpaceDim = dim;
+            pattern->mapping[dim].a             = 1;
+            pattern->mapping[dim].start_b       = 0;
+            pattern->mapping[dim].end_b         = 0;
+        }
+    }
+
+    /*************************************************************************************
+    *    Stage IV -  Load ISA into the descriptor.
+    **************************************************************************************/
+    unsigned IsaSize1 = (&_binary___softmax_bwd_fcd_bf16_gaudi2_o_end - &_binary___softmax_bwd_fcd_bf16_gaudi2_o_start);
+    unsigned IsaSize2 = (&_binary___softmax_bwd_non_fcd_bf16_gaudi2_o_end - &_binary___softmax_bwd_non_fcd_bf16_gaudi2_o_start);
+    unsigned givenBinarySize = kernel->kernel.elfSize;
+    unsigned IsaSize = def->axis==0? IsaSize1:IsaSize2;
+
+    kernel->kernel.elfSize = IsaSize;
+
+    if (givenBinarySize >= IsaSize)
+    {
+        // copy binary out
+        memcpy (kernel->kernel.kernelElf ,
+                def->axis == 0 ? &_binary___softmax_bwd_fcd_bf16_gaudi2_o_start :
+                                 &_binary___softmax_bwd_non_fcd_bf16_gaudi2_o_start,
+                IsaSize);
+    }
+    else
+    {
+       retVal = tpc_lib_api::GLUE_INSUFFICIENT_ELF_BUFFER;
+       return retVal;
+    }
+
+    return tpc_lib_api::GLUE_SUCCESS;
+}
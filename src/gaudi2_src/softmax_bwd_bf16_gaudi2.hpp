@@ -0,0 +1,52 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef _SOFTMAX_BWD_BF16_GAUDI2_HPP
+#define _SOFTMAX_BWD_BF16_GAUDI2_HPP
+
+#include <vector>
+#include <cstring>
+#include "gc_interface.h"
+#include "tpc_kernel_lib_interface.h"
+#include "softmax_bf16_gaudi2.hpp"
+
+
+class SoftMaxBwdBF16Gaudi2
+{
+public:
+    SoftMaxBwdBF16Gaudi2() {}
+    virtual ~SoftMaxBwdBF16Gaudi2() {}
+
+    virtual tpc_lib_api::GlueCodeReturn GetGcDefinitions(
+                                  tpc_lib_api::HabanaKernelParams* in_defs,
+                                  tpc_lib_api::HabanaKernelInstantiation* out_defs);
+
+     virtual tpc_lib_api::GlueCodeReturn GetKernelNameFcd(
+             char kernelName [tpc_lib_api::MAX_NODE_NAME]);
+
+     virtual tpc_lib_api::GlueCodeReturn GetKernelNameNonFcd(
+             char kernelName [tpc_lib_api::MAX_NODE_NAME]);
+
+    // The backward kernels share the forward axis convention.
+    typedef SoftMaxBF16Gaudi2::SoftMaxParam SoftMaxParam;
+
+private:
+    SoftMaxBwdBF16Gaudi2(const SoftMaxBwdBF16Gaudi2& other) = delete;
+    SoftMaxBwdBF16Gaudi2& operator=(const SoftMaxBwdBF16Gaudi2& other) = delete;
+};
+
+
+#endif
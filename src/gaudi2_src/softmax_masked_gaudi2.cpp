@@ -0,0 +1,233 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cmath>
+#include <cstring>
+#include "softmax_masked_gaudi2.hpp"
+
+extern unsigned char _binary___softmax_scaled_f32_gaudi2_o_start;
+extern unsigned char _binary___softmax_scaled_f32_gaudi2_o_end;
+extern unsigned char _binary___softmax_scaled_bf16_gaudi2_o_start;
+extern unsigned char _binary___softmax_scaled_bf16_gaudi2_o_end;
+extern unsigned char _binary___softmax_masked_f32_gaudi2_o_start;
+extern unsigned char _binary___softmax_masked_f32_gaudi2_o_end;
+extern unsigned char _binary___softmax_masked_bf16_gaudi2_o_start;
+extern unsigned char _binary___softmax_masked_bf16_gaudi2_o_end;
+
+static const char c_softmaxMaskedKernelNames[][tpc_lib_api::MAX_NODE_NAME] = {
+    "custom_softmax_scaled_f32_gaudi2",
+    "custom_softmax_scaled_bf16_gaudi2",
+    "custom_softmax_masked_f32_gaudi2",
+    "custom_softmax_masked_bf16_gaudi2"
+};
+
+tpc_lib_api::GlueCodeReturn SoftMaxMaskedGaudi2::GetKernelName(
+        char kernelName [tpc_lib_api::MAX_NODE_NAME], SoftMaxMasked_mode_t mode)
+{
+    if (mode > softmax_masked_bf16)
+        return tpc_lib_api::GLUE_NODE_NOT_FOUND;
+    strcpy(kernelName, c_softmaxMaskedKernelNames[mode]);
+    return tpc_lib_api::GLUE_SUCCESS;
+}
+
+bool SoftMaxMaskedGaudi2::HasMaskTensor() const
+{
+    return m_mode == softmax_masked_f32 || m_mode == softmax_masked_bf16;
+}
+
+bool SoftMaxMaskedGaudi2::IsBF16() const
+{
+    return m_mode == softmax_scaled_bf16 || m_mode == softmax_masked_bf16;
+}
+
+tpc_lib_api::GlueCodeReturn SoftMaxMaskedGaudi2::GetGcDefinitions(
+        tpc_lib_api::HabanaKernelParams* in_defs,
+        tpc_lib_api::HabanaKernelInstantiation* out_defs)
+{
+    tpc_lib_api::GlueCodeReturn retVal;
+    SoftMaxMaskedParam* def = static_cast<SoftMaxMaskedParam*>(in_defs->nodeParams.nodeParams);
+
+    // Tensor order is a convention between the TPC kernel writer and the
+    // framework layer writer:
+    //   inputs  : scores {kLen, qLen, heads, batch}, mask {kLen, qLen} (masked modes)
+    //   outputs : probabilities, same shape and type as scores
+
+    /*************************************************************************************
+    *   Stage I - validate input
+    **************************************************************************************/
+    const unsigned inputNr = HasMaskTensor() ? 2 : 1;
+    //validate correct amount of input tensors
+    if (in_defs->inputTensorNr != inputNr)
+    {
+        in_defs->inputTensorNr  = inputNr;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_COUNT;
+    }
+    //validate correct amount of output tensors
+    if (in_defs->outputTensorNr != 1)
+    {
+        in_defs->outputTensorNr  = 1;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_COUNT;
+    }
+
+    if (def->axis != 0 || def->maskMode < mask_none || def->maskMode > mask_alibi)
+    {
+        return tpc_lib_api::GLUE_UNSUPPORTED_LAYER_CONFIGURATION;
+    }
+
+    // validate input and output data type
+    const tpc_lib_api::TensorDataType dataType = IsBF16() ? tpc_lib_api::DATA_BF16 : tpc_lib_api::DATA_F32;
+    for (unsigned i = 0; i < inputNr; i++)
+    {
+        if (in_defs->inputTensors[i].geometry.dataType != dataType)
+        {
+            in_defs->inputTensors[i].geometry.dataType = dataType;
+            return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+        }
+    }
+    if (in_defs->outputTensors[0].geometry.dataType != dataType)
+    {
+        in_defs->outputTensors[0].geometry.dataType = dataType;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+    }
+
+    const unsigned dims = in_defs->inputTensors[0].geometry.dims;
+    if (dims < 2 || dims > 4)
+    {
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+    }
+    uint64_t inputSizes[4] = {1, 1, 1, 1};
+    memcpy(inputSizes, in_defs->inputTensors[0].geometry.maxSizes, dims * sizeof(uint64_t));
+
+    // the mask covers one head of one batch
+    if (HasMaskTensor())
+    {
+        const tpc_lib_api::Tensor& mask = in_defs->inputTensors[1];
+        if (mask.geometry.dims < 2 || mask.geometry.dims > 4 ||
+            mask.geometry.maxSizes[0] != inputSizes[0] ||
+            mask.geometry.maxSizes[1] != inputSizes[1])
+        {
+            return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+        }
+        for (unsigned dim = 2; dim < mask.geometry.dims; dim++)
+        {
+            if (mask.geometry.maxSizes[dim] != 1)
+            {
+                return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+            }
+        }
+    }
+
+    // verify that output feature map dimension are correct
+    if (in_defs->outputTensors[0].geometry.dims != dims ||
+        memcmp(in_defs->outputTensors[0].geometry.maxSizes, inputSizes, dims * sizeof(uint64_t)) != 0)
+    {
+        memcpy(in_defs->outputTensors[0].geometry.maxSizes, inputSizes, dims * sizeof(uint64_t));
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_SIZE;
+    }
+
+    /*************************************************************************************
+    *    Stage II -  Define index space geometry. As in the softmax FCD glue, dim 0 is a
+    *    single member since the whole key row is needed.
+    **************************************************************************************/
+    out_defs->indexSpaceRank = 4;
+    out_defs->indexSpaceGeometry[0] = 1;
+    out_defs->indexSpaceGeometry[1] = inputSizes[1];
+    out_defs->indexSpaceGeometry[2] = inputSizes[2];
+    out_defs->indexSpaceGeometry[3] = inputSizes[3];
+
+    /*************************************************************************************
+    *    Stage III -  Define index space mapping
+    **************************************************************************************/
+    for (unsigned i = 0; i < inputNr + 1; i++)
+    {
+        tpc_lib_api::TensorAccessPattern* pattern = (i < inputNr) ?
+                &out_defs->inputTensorAccessPattern[i] : &out_defs->outputTensorAccessPattern[0];
+        const bool isMask = HasMaskTensor() && i == 1;
+
+        // f_start f(i) = 0;
+        // f_end   f(i) = size[0] - 1 (whole row)
+        pattern->mapping[0].indexSpaceDim = 0;
+        pattern->mapping[0].a             = 0;
+        pattern->mapping[0].start_b       = 0;
+        pattern->mapping[0].end_b         = inputSizes[0] - 1;
+
+        // f_start f(i) = 1*i + 0;
+        // f_end   f(i) = 1*i + 0;
+        // the mask is shared by every head and batch
+        for (unsigned dim = 1; dim < 4; dim++)
+        {
+            pattern->mapping[dim].indexSpaceDim = dim;
+            pattern->mapping[dim].a             = (isMask && dim > 1) ? 0 : 1;
+            pattern->mapping[dim].start_b       = 0;
+            pattern->mapping[dim].end_b         = 0;
+        }
+    }
+
+    /*************************************************************************************
+    *    Stage IV -  define scalar parameters
+    **************************************************************************************/
+    // queries are aligned to the end of the keys, as with a KV cache
+    const int32_t causalOffset = (int32_t)inputSizes[0] - (int32_t)inputSizes[1];
+    // ALiBi slope of head h is 2^(-8 (h + 1) / heads)
+    const float alibiStep = -8.0f * logf(2.0f) / inputSizes[2];
+
+    out_defs->kernel.paramsNr = 4;
+    memcpy(&(out_defs->kernel.scalarParams[0]), &def->scale, sizeof(float));
+    memcpy(&(out_defs->kernel.scalarParams[1]), &def->maskMode, sizeof(int32_t));
+    memcpy(&(out_defs->kernel.scalarParams[2]), &causalOffset, sizeof(int32_t));
+    memcpy(&(out_defs->kernel.scalarParams[3]), &alibiStep, sizeof(float));
+
+    /*************************************************************************************
+    *    Stage V -  Load ISA into the descriptor.
+    **************************************************************************************/
+    unsigned IsaSize = (&_binary___softmax_scaled_f32_gaudi2_o_end - &_binary___softmax_scaled_f32_gaudi2_o_start);
+    unsigned char *binary_kernel = &_binary___softmax_scaled_f32_gaudi2_o_start;
+    switch (m_mode)
+    {
+        case softmax_scaled_f32:
+            IsaSize = (&_binary___softmax_scaled_f32_gaudi2_o_end - &_binary___softmax_scaled_f32_gaudi2_o_start);
+            binary_kernel = &_binary___softmax_scaled_f32_gaudi2_o_start;
+            break;
+        case softmax_scaled_bf16:
+            IsaSize = (&_binary___softmax_scaled_bf16_gaudi2_o_end - &_binary___softmax_scaled_bf16_gaudi2_o_start);
+            binary_kernel = &_binary___softmax_scaled_bf16_gaudi2_o_start;
+            break;
+        case softmax_masked_f32:
+            IsaSize = (&_binary___softmax_masked_f32_gaudi2_o_end - &_binary___softmax_masked_f32_gaudi2_o_start);
+            binary_kernel = &_binary___softmax_masked_f32_gaudi2_o_start;
+            break;
+        case softmax_masked_bf16:
+            IsaSize = (&_binary___softmax_masked_bf16_gaudi2_o_end - &_binary___softmax_masked_bf16_gaudi2_o_start);
+            binary_kernel = &_binary___softmax_masked_bf16_gaudi2_o_start;
+            break;
+        default:
+            break;
+    }
+
+    unsigned givenBinarySize = out_defs->kernel.elfSize;
+    out_defs->kernel.elfSize = IsaSize;
+    if (givenBinarySize >= IsaSize)
+    {
+        memcpy (out_defs->kernel.kernelElf, binary_kernel, IsaSize);
+    }
+    else
+    {
+        retVal = tpc_lib_api::GLUE_INSUFFICIENT_ELF_BUFFER;
+        return retVal;
+    }
+
+    return tpc_lib_api::GLUE_SUCCESS;
+}
@@ -0,0 +1,72 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef _SOFTMAX_MASKED_GAUDI2_HPP
+#define _SOFTMAX_MASKED_GAUDI2_HPP
+
+#include "gc_interface.h"
+#include "tpc_kernel_lib_interface.h"
+
+class SoftMaxMaskedGaudi2
+{
+public:
+    typedef enum _SoftMaxMasked_mode_t
+    {
+        softmax_scaled_f32,
+        softmax_scaled_bf16,
+        softmax_masked_f32,
+        softmax_masked_bf16
+    } SoftMaxMasked_mode_t;
+
+    // Generated mask, SOFTMAX_MASK_* in the kernel
+    typedef enum _SoftMaxMasked_maskMode_t
+    {
+        mask_none,
+        mask_causal,
+        mask_alibi
+    } SoftMaxMasked_maskMode_t;
+
+    SoftMaxMaskedGaudi2(SoftMaxMasked_mode_t mode=softmax_scaled_f32) {m_mode = mode;}
+    virtual ~SoftMaxMaskedGaudi2() {}
+
+    virtual tpc_lib_api::GlueCodeReturn GetGcDefinitions(
+            tpc_lib_api::HabanaKernelParams* in_defs,
+            tpc_lib_api::HabanaKernelInstantiation* out_defs);
+
+    virtual tpc_lib_api::GlueCodeReturn GetKernelName(
+            char kernelName [tpc_lib_api::MAX_NODE_NAME], SoftMaxMasked_mode_t mode);
+
+    // This struct is common between the TPC kernel writer and the framework
+    // layer writer. The programmer who adds a new layer to the framework-backend
+    // is responsible to fill the structure with valid data.
+    // It starts like SoftMaxParam, only axis 0 is supported.
+    struct SoftMaxMaskedParam
+    {
+        int32_t axis;
+        float   scale;
+        int32_t maskMode;   // SoftMaxMasked_maskMode_t
+    };
+
+private:
+    bool HasMaskTensor() const;
+    bool IsBF16() const;
+
+    SoftMaxMasked_mode_t m_mode;
+    SoftMaxMaskedGaudi2(const SoftMaxMaskedGaudi2& other) = delete;
+    SoftMaxMaskedGaudi2& operator=(const SoftMaxMaskedGaudi2& other) = delete;
+};
+
+#endif //_SOFTMAX_MASKED_GAUDI2_HPP
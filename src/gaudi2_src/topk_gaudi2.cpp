@@ -0,0 +1,222 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cstring>
+#include "topk_gaudi2.hpp"
+
+extern unsigned char _binary___topk_f32_gaudi2_o_start;
+extern unsigned char _binary___topk_f32_gaudi2_o_end;
+extern unsigned char _binary___topk_bf16_gaudi2_o_start;
+extern unsigned char _binary___topk_bf16_gaudi2_o_end;
+extern unsigned char _binary___argmax_f32_gaudi2_o_start;
+extern unsigned char _binary___argmax_f32_gaudi2_o_end;
+extern unsigned char _binary___argmax_bf16_gaudi2_o_start;
+extern unsigned char _binary___argmax_bf16_gaudi2_o_end;
+
+static const char c_topKKernelNames[][tpc_lib_api::MAX_NODE_NAME] = {
+    "custom_topk_f32_gaudi2",
+    "custom_topk_bf16_gaudi2",
+    "custom_argmax_f32_gaudi2",
+    "custom_argmax_bf16_gaudi2"
+};
+
+tpc_lib_api::GlueCodeReturn TopKGaudi2::GetKernelName(
+        char kernelName [tpc_lib_api::MAX_NODE_NAME], TopK_mode_t mode)
+{
+    if (mode > argmax_bf16)
+        return tpc_lib_api::GLUE_NODE_NOT_FOUND;
+    strcpy(kernelName, c_topKKernelNames[mode]);
+    return tpc_lib_api::GLUE_SUCCESS;
+}
+
+bool TopKGaudi2::IsArgMax() const
+{
+    return m_mode == argmax_f32 || m_mode == argmax_bf16;
+}
+
+bool TopKGaudi2::IsBF16() const
+{
+    return m_mode == topk_bf16 || m_mode == argmax_bf16;
+}
+
+tpc_lib_api::GlueCodeReturn TopKGaudi2::GetGcDefinitions(
+        tpc_lib_api::HabanaKernelParams* in_defs,
+        tpc_lib_api::HabanaKernelInstantiation* out_defs)
+{
+    tpc_lib_api::GlueCodeReturn retVal;
+
+    // Tensor order is a convention between the TPC kernel writer and the
+    // framework layer writer:
+    //   inputs  : ifm {N, ...}
+    //   outputs : values {k, ...} in the ifm data type, indices {k, ...} i32
+
+    /*************************************************************************************
+    *   Stage I - validate input
+    **************************************************************************************/
+    //validate correct amount of input tensors
+    if (in_defs->inputTensorNr != 1)
+    {
+        in_defs->inputTensorNr  = 1;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_COUNT;
+    }
+    //validate correct amount of output tensors
+    if (in_defs->outputTensorNr != 2)
+    {
+        in_defs->outputTensorNr  = 2;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_COUNT;
+    }
+
+    // validate input and output data type
+    const tpc_lib_api::TensorDataType dataType = IsBF16() ? tpc_lib_api::DATA_BF16 : tpc_lib_api::DATA_F32;
+    if (in_defs->inputTensors[0].geometry.dataType != dataType ||
+        in_defs->outputTensors[0].geometry.dataType != dataType)
+    {
+        in_defs->inputTensors[0].geometry.dataType = dataType;
+        in_defs->outputTensors[0].geometry.dataType = dataType;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+    }
+    if (in_defs->outputTensors[1].geometry.dataType != tpc_lib_api::DATA_I32)
+    {
+        in_defs->outputTensors[1].geometry.dataType = tpc_lib_api::DATA_I32;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+    }
+
+    const unsigned dims = in_defs->inputTensors[0].geometry.dims;
+    if (dims < 1 || dims > 4)
+    {
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+    }
+    uint64_t inputSizes[4] = {1, 1, 1, 1};
+    memcpy(inputSizes, in_defs->inputTensors[0].geometry.maxSizes, dims * sizeof(uint64_t));
+
+    int32_t k = 1;
+    if (!IsArgMax())
+    {
+        TopKParams* def = static_cast<TopKParams*>(in_defs->nodeParams.nodeParams);
+        k = def->k;
+    }
+    // every output entry needs a distinct element of the row
+    if (k < 1 || k > c_maxK || (uint64_t)k > inputSizes[0])
+    {
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+    }
+
+    // verify that output feature map dimension are correct
+    uint64_t outputSizes[4];
+    memcpy(outputSizes, inputSizes, sizeof(outputSizes));
+    outputSizes[0] = k;
+    for (unsigned i = 0; i < 2; i++)
+    {
+        if (in_defs->outputTensors[i].geometry.dims != dims ||
+            memcmp(in_defs->outputTensors[i].geometry.maxSizes, outputSizes, dims * sizeof(uint64_t)) != 0)
+        {
+            memcpy(in_defs->outputTensors[i].geometry.maxSizes, outputSizes, dims * sizeof(uint64_t));
+            return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_SIZE;
+        }
+    }
+
+    /*************************************************************************************
+    *    Stage II -  Define index space geometry. As in the softmax FCD glue, dim 0 is a
+    *    single member since the whole row is needed, and rows are spread across TPCs.
+    **************************************************************************************/
+    out_defs->indexSpaceRank = 4;
+    out_defs->indexSpaceGeometry[0] = 1;
+    out_defs->indexSpaceGeometry[1] = inputSizes[1];
+    out_defs->indexSpaceGeometry[2] = inputSizes[2];
+    out_defs->indexSpaceGeometry[3] = inputSizes[3];
+
+    /*************************************************************************************
+    *    Stage III -  Define index space mapping
+    **************************************************************************************/
+    // ifm, values, indices
+    for (unsigned i = 0; i < 3; i++)
+    {
+        tpc_lib_api::TensorAccessPattern* pattern = (i == 0) ?
+                &out_defs->inputTensorAccessPattern[0] : &out_defs->outputTensorAccessPattern[i - 1];
+        uint64_t rowSize = (i == 0) ? inputSizes[0] : outputSizes[0];
+
+        // f_start f(i) = 0;
+        // f_end   f(i) = size[0] - 1 (whole row)
+        pattern->mapping[0].indexSpaceDim = 0;
+        pattern->mapping[0].a             = 0;
+        pattern->mapping[0].start_b       = 0;
+        pattern->mapping[0].end_b         = rowSize - 1;
+
+        // f_start f(i) = 1*i + 0;
+        // f_end   f(i) = 1*i + 0;
+        for (unsigned dim = 1; dim < 4; dim++)
+        {
+            pattern->mapping[dim].indexSpaceDim = dim;
+            pattern->mapping[dim].a             = 1;
+            pattern->mapping[dim].start_b       = 0;
+            pattern->mapping[dim].end_b         = 0;
+        }
+    }
+
+    /*************************************************************************************
+    *    Stage IV -  define scalar parameters
+    **************************************************************************************/
+    if (IsArgMax())
+    {
+        out_defs->kernel.paramsNr = 0;
+    }
+    else
+    {
+        out_defs->kernel.paramsNr = 1;
+        memcpy(&(out_defs->kernel.scalarParams[0]), &k, sizeof(int32_t));
+    }
+
+    /*************************************************************************************
+    *    Stage V -  Load ISA into the descriptor.
+    **************************************************************************************/
+    unsigned IsaSize = (&_binary___topk_f32_gaudi2_o_end - &_binary___topk_f32_gaudi2_o_start);
+    unsigned char *binary_kernel = &_binary___topk_f32_gaudi2_o_start;
+    switch (m_mode)
+    {
+        case topk_f32:
+            IsaSize = (&_binary___topk_f32_gaudi2_o_end - &_binary___topk_f32_gaudi2_o_start);
+            binary_kernel = &_binary___topk_f32_gaudi2_o_start;
+            break;
+        case topk_bf16:
+            IsaSize = (&_binary___topk_bf16_gaudi2_o_end - &_binary___topk_bf16_gaudi2_o_start);
+            binary_kernel = &_binary___topk_bf16_gaudi2_o_start;
+            break;
+        case argmax_f32:
+            IsaSize = (&_binary___argmax_f32_gaudi2_o_end - &_binary___argmax_f32_gaudi2_o_start);
+            binary_kernel = &_binary___argmax_f32_gaudi2_o_start;
+            break;
+        case argmax_bf16:
+            IsaSize = (&_binary___argmax_bf16_gaudi2_o_end - &_binary___argmax_bf16_gaudi2_o_start);
+            binary_kernel = &_binary___argmax_bf16_gaudi2_o_start;
+            break;
+        default:
+            break;
+    }
+
+    unsigned givenBinarySize = out_defs->kernel.elfSize;
+    out_defs->kernel.elfSize = IsaSize;
+    if (givenBinarySize >= IsaSize)
+    {
+        memcpy (out_defs->kernel.kernelElf, binary_kernel, IsaSize);
+    }
+    else
+    {
+        retVal = tpc_lib_api::GLUE_INSUFFICIENT_ELF_BUFFER;
+        return retVal;
+    }
+
+    return tpc_lib_api::GLUE_SUCCESS;
+}
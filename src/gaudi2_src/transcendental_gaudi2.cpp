@@ -0,0 +1,253 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cstring>
+#include <cstdio>
+#include <algorithm>
+#include "transcendental_gaudi2.hpp"
+
+extern unsigned char _binary___transcendental_cos_fast_f32_gaudi2_o_start;
+extern unsigned char _binary___transcendental_cos_fast_f32_gaudi2_o_end;
+extern unsigned char _binary___transcendental_cos_precise_f32_gaudi2_o_start;
+extern unsigned char _binary___transcendental_cos_precise_f32_gaudi2_o_end;
+extern unsigned char _binary___transcendental_sincos_fast_f32_gaudi2_o_start;
+extern unsigned char _binary___transcendental_sincos_fast_f32_gaudi2_o_end;
+extern unsigned char _binary___transcendental_sincos_precise_f32_gaudi2_o_start;
+extern unsigned char _binary___transcendental_sincos_precise_f32_gaudi2_o_end;
+extern unsigned char _binary___transcendental_exp_fast_f32_gaudi2_o_start;
+extern unsigned char _binary___transcendental_exp_fast_f32_gaudi2_o_end;
+extern unsigned char _binary___transcendental_exp_precise_f32_gaudi2_o_start;
+extern unsigned char _binary___transcendental_exp_precise_f32_gaudi2_o_end;
+extern unsigned char _binary___transcendental_log_fast_f32_gaudi2_o_start;
+extern unsigned char _binary___transcendental_log_fast_f32_gaudi2_o_end;
+extern unsigned char _binary___transcendental_log_precise_f32_gaudi2_o_start;
+extern unsigned char _binary___transcendental_log_precise_f32_gaudi2_o_end;
+extern unsigned char _binary___transcendental_tanh_fast_f32_gaudi2_o_start;
+extern unsigned char _binary___transcendental_tanh_fast_f32_gaudi2_o_end;
+extern unsigned char _binary___transcendental_tanh_precise_f32_gaudi2_o_start;
+extern unsigned char _binary___transcendental_tanh_precise_f32_gaudi2_o_end;
+extern unsigned char _binary___transcendental_sigmoid_fast_f32_gaudi2_o_start;
+extern unsigned char _binary___transcendental_sigmoid_fast_f32_gaudi2_o_end;
+extern unsigned char _binary___transcendental_sigmoid_precise_f32_gaudi2_o_start;
+extern unsigned char _binary___transcendental_sigmoid_precise_f32_gaudi2_o_end;
+extern unsigned char _binary___transcendental_rsqrt_fast_f32_gaudi2_o_start;
+extern unsigned char _binary___transcendental_rsqrt_fast_f32_gaudi2_o_end;
+extern unsigned char _binary___transcendental_rsqrt_precise_f32_gaudi2_o_start;
+extern unsigned char _binary___transcendental_rsqrt_precise_f32_gaudi2_o_end;
+extern unsigned char _binary___transcendental_erf_fast_f32_gaudi2_o_start;
+extern unsigned char _binary___transcendental_erf_fast_f32_gaudi2_o_end;
+extern unsigned char _binary___transcendental_erf_precise_f32_gaudi2_o_start;
+extern unsigned char _binary___transcendental_erf_precise_f32_gaudi2_o_end;
+
+// [mode][tier]
+static unsigned char* const c_trBinaries[TranscendentalGaudi2::tr_mode_count][TranscendentalGaudi2::tier_count][2] = {
+    {
+        {&_binary___transcendental_cos_fast_f32_gaudi2_o_start, &_binary___transcendental_cos_fast_f32_gaudi2_o_end},
+        {&_binary___transcendental_cos_precise_f32_gaudi2_o_start, &_binary___transcendental_cos_precise_f32_gaudi2_o_end}
+    },
+    {
+        {&_binary___transcendental_sincos_fast_f32_gaudi2_o_start, &_binary___transcendental_sincos_fast_f32_gaudi2_o_end},
+        {&_binary___transcendental_sincos_precise_f32_gaudi2_o_start, &_binary___transcendental_sincos_precise_f32_gaudi2_o_end}
+    },
+    {
+        {&_binary___transcendental_exp_fast_f32_gaudi2_o_start, &_binary___transcendental_exp_fast_f32_gaudi2_o_end},
+        {&_binary___transcendental_exp_precise_f32_gaudi2_o_start, &_binary___transcendental_exp_precise_f32_gaudi2_o_end}
+    },
+    {
+        {&_binary___transcendental_log_fast_f32_gaudi2_o_start, &_binary___transcendental_log_fast_f32_gaudi2_o_end},
+        {&_binary___transcendental_log_precise_f32_gaudi2_o_start, &_binary___transcendental_log_precise_f32_gaudi2_o_end}
+    },
+    {
+        {&_binary___transcendental_tanh_fast_f32_gaudi2_o_start, &_binary___transcendental_tanh_fast_f32_gaudi2_o_end},
+        {&_binary___transcendental_tanh_precise_f32_gaudi2_o_start, &_binary___transcendental_tanh_precise_f32_gaudi2_o_end}
+    },
+    {
+        {&_binary___transcendental_sigmoid_fast_f32_gaudi2_o_start, &_binary___transcendental_sigmoid_fast_f32_gaudi2_o_end},
+        {&_binary___transcendental_sigmoid_precise_f32_gaudi2_o_start, &_binary___transcendental_sigmoid_precise_f32_gaudi2_o_end}
+    },
+    {
+        {&_binary___transcendental_rsqrt_fast_f32_gaudi2_o_start, &_binary___transcendental_rsqrt_fast_f32_gaudi2_o_end},
+        {&_binary___transcendental_rsqrt_precise_f32_gaudi2_o_start, &_binary___transcendental_rsqrt_precise_f32_gaudi2_o_end}
+    },
+    {
+        {&_binary___transcendental_erf_fast_f32_gaudi2_o_start, &_binary___transcendental_erf_fast_f32_gaudi2_o_end},
+        {&_binary___transcendental_erf_precise_f32_gaudi2_o_start, &_binary___transcendental_erf_precise_f32_gaudi2_o_end}
+    }
+};
+
+static const char* const c_trModeNames[] = {
+    "cos",
+    "sincos",
+    "exp",
+    "log",
+    "tanh",
+    "sigmoid",
+    "rsqrt",
+    "erf"
+};
+
+tpc_lib_api::GlueCodeReturn TranscendentalGaudi2::GetKernelName(
+        char kernelName [tpc_lib_api::MAX_NODE_NAME], Transcendental_mode_t mode)
+{
+    if (mode >= tr_mode_count)
+        return tpc_lib_api::GLUE_NODE_NOT_FOUND;
+    snprintf(kernelName, tpc_lib_api::MAX_NODE_NAME, "custom_%s_f32_gaudi2",
+             c_trModeNames[mode]);
+    return tpc_lib_api::GLUE_SUCCESS;
+}
+
+tpc_lib_api::GlueCodeReturn TranscendentalGaudi2::GetGcDefinitions(
+        tpc_lib_api::HabanaKernelParams* in_defs,
+        tpc_lib_api::HabanaKernelInstantiation* out_defs)
+{
+    const int c_unrollCount = 4;
+    tpc_lib_api::GlueCodeReturn retVal;
+    TranscendentalParams* def = static_cast<TranscendentalParams*>(in_defs->nodeParams.nodeParams);
+
+    /*************************************************************************************
+    *   Stage I - validate input
+    **************************************************************************************/
+    if (m_mode >= tr_mode_count)
+    {
+        return tpc_lib_api::GLUE_NODE_NOT_FOUND;
+    }
+
+    const unsigned outputCount = m_mode == tr_sincos ? 2 : 1;
+
+    //validate correct amount of input tensors
+    if (in_defs->inputTensorNr != 1)
+    {
+        in_defs->inputTensorNr  = 1;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_COUNT;
+    }
+    //validate correct amount of output tensors
+    if (in_defs->outputTensorNr != outputCount)
+    {
+        in_defs->outputTensorNr  = outputCount;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_COUNT;
+    }
+
+    const int tier = def == nullptr ? tier_fast : def->tier;
+    if (tier < tier_fast || tier >= tier_count)
+    {
+        return tpc_lib_api::GLUE_UNSUPPORTED_LAYER_CONFIGURATION;
+    }
+
+    // validate input and output data type
+    if (in_defs->inputTensors[0].geometry.dataType != tpc_lib_api::DATA_F32)
+    {
+        in_defs->inputTensors[0].geometry.dataType = tpc_lib_api::DATA_F32;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+    }
+    for (unsigned i = 0; i < outputCount; i++)
+    {
+        if (in_defs->outputTensors[i].geometry.dataType != tpc_lib_api::DATA_F32)
+        {
+            in_defs->outputTensors[i].geometry.dataType = tpc_lib_api::DATA_F32;
+            return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+        }
+    }
+
+    uint64_t outputSizes[gcapi::MAX_TENSOR_DIM] = {0};
+    std::copy(in_defs->inputTensors[0].geometry.maxSizes,
+              in_defs->inputTensors[0].geometry.maxSizes + gcapi::MAX_TENSOR_DIM,
+              outputSizes);
+
+    // verify that output feature map dimension are correct
+    for (unsigned i = 0; i < outputCount; i++)
+    {
+        if (memcmp(in_defs->outputTensors[i].geometry.maxSizes, outputSizes,
+                   in_defs->outputTensors[i].geometry.dims * sizeof(uint64_t)) != 0)
+        {
+            memcpy(in_defs->outputTensors[i].geometry.maxSizes, outputSizes, sizeof(outputSizes));
+            return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_SIZE;
+        }
+    }
+
+    /*************************************************************************************
+    *    Stage II -  Define index space geometry. In this example the index space matches
+    *    the dimensions of the output tensor, up to dim 0.
+    **************************************************************************************/
+    int elementsInVec = 64;
+
+    //round up to elementsInVec and divide by elementsInVec.
+    unsigned depthIndex = (outputSizes[0] + (elementsInVec - 1)) / elementsInVec;
+    out_defs->indexSpaceRank = 5;
+    out_defs->indexSpaceGeometry[0] = depthIndex;
+    //reduce index space due to unroll.
+    out_defs->indexSpaceGeometry[1] = (outputSizes[1] + (c_unrollCount - 1)) / c_unrollCount;
+    out_defs->indexSpaceGeometry[2] = outputSizes[2];
+    out_defs->indexSpaceGeometry[3] = outputSizes[3];
+    out_defs->indexSpaceGeometry[4] = outputSizes[4];
+
+    /*************************************************************************************
+    *    Stage III -  Define index space mapping
+    **************************************************************************************/
+    tpc_lib_api::TensorAccessPattern pattern = {};
+
+    // f_start f(i) = elementsInVec*i + 0;
+    // f_end   f(i) = elementsInVec*i + (elementsInVec - 1);
+    pattern.mapping[0].indexSpaceDim = 0;
+    pattern.mapping[0].a             = elementsInVec;
+    pattern.mapping[0].start_b       = 0;
+    pattern.mapping[0].end_b         = elementsInVec - 1;
+
+    pattern.mapping[1].indexSpaceDim = 1;
+    pattern.mapping[1].a             = c_unrollCount;
+    pattern.mapping[1].start_b       = 0;
+    pattern.mapping[1].end_b         = c_unrollCount - 1;
+
+    // f_start f(i) = 1*i + 0;
+    // f_end   f(i) = 1*i + 0;
+    for (int dims = 2; dims < (int)out_defs->indexSpaceRank; dims++)
+    {
+        pattern.mapping[dims].indexSpaceDim = dims;
+        pattern.mapping[dims].a             = 1;
+        pattern.mapping[dims].start_b       = 0;
+        pattern.mapping[dims].end_b         = 1 - 1;
+    }
+
+    out_defs->inputTensorAccessPattern[0] = pattern;
+    for (unsigned i = 0; i < outputCount; i++)
+    {
+        out_defs->outputTensorAccessPattern[i] = pattern;
+    }
+
+    /*************************************************************************************
+    *    Stage IV -  Set Auxiliary Tensor
+    **************************************************************************************/
+    // N/A
+    /*************************************************************************************
+    *    Stage V -  Load ISA into the descriptor.
+    **************************************************************************************/
+    unsigned char* binary_kernel = c_trBinaries[m_mode][tier][0];
+    unsigned IsaSize = (c_trBinaries[m_mode][tier][1] - c_trBinaries[m_mode][tier][0]);
+    unsigned givenBinarySize = out_defs->kernel.elfSize;
+    out_defs->kernel.elfSize = IsaSize;
+
+    if (givenBinarySize >= IsaSize)
+    {
+        // copy binary out
+        memcpy (out_defs->kernel.kernelElf, binary_kernel, IsaSize);
+    }
+    else
+    {
+        retVal = tpc_lib_api::GLUE_INSUFFICIENT_ELF_BUFFER;
+        return retVal;
+    }
+
+    return tpc_lib_api::GLUE_SUCCESS;
+}
@@ -0,0 +1,74 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef _TRANSCENDENTAL_GAUDI2_HPP
+#define _TRANSCENDENTAL_GAUDI2_HPP
+
+#include "gc_interface.h"
+#include "tpc_kernel_lib_interface.h"
+
+// Elementwise f32 cos, sin + cos, exp, log, tanh, sigmoid, rsqrt and erf in
+// two accuracy tiers. The fast tier expects finite inputs in the range of the
+// result and stays within a few ULP (sin / cos go through the hardware LUT),
+// the precise tier keeps 1-2 ULP and handles nan / inf / overflow.
+// sincos writes sin to output 0 and cos to output 1.
+class TranscendentalGaudi2
+{
+public:
+    typedef enum _Transcendental_mode_t
+    {
+        tr_cos,
+        tr_sincos,
+        tr_exp,
+        tr_log,
+        tr_tanh,
+        tr_sigmoid,
+        tr_rsqrt,
+        tr_erf,
+        tr_mode_count
+    } Transcendental_mode_t;
+
+    typedef enum _Tier_t
+    {
+        tier_fast,
+        tier_precise,
+        tier_count
+    } Tier_t;
+
+    TranscendentalGaudi2(Transcendental_mode_t mode=tr_exp) {m_mode = mode;}
+    virtual ~TranscendentalGaudi2() {}
+
+    virtual tpc_lib_api::GlueCodeReturn GetGcDefinitions(
+            tpc_lib_api::HabanaKernelParams* in_defs,
+            tpc_lib_api::HabanaKernelInstantiation* out_defs);
+
+    virtual tpc_lib_api::GlueCodeReturn GetKernelName(
+            char kernelName [tpc_lib_api::MAX_NODE_NAME], Transcendental_mode_t mode);
+
+    // This struct is common between the TPC kernel writer and the framework
+    // layer writer. Without params the fast tier runs.
+    struct TranscendentalParams
+    {
+        int32_t tier;   // Tier_t
+    };
+
+private:
+    Transcendental_mode_t m_mode;
+    TranscendentalGaudi2(const TranscendentalGaudi2& other) = delete;
+    TranscendentalGaudi2& operator=(const TranscendentalGaudi2& other) = delete;
+};
+
+#endif //_TRANSCENDENTAL_GAUDI2_HPP
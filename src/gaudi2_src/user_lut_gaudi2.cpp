@@ -17,6 +17,7 @@ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVE
 #include <cmath>
 #include <cstring>
 #include "user_lut_gaudi2.hpp"
+#include "aux_tensor_store.hpp"
 
 extern unsigned char _binary___user_lut_f32_gaudi2_o_start;
 extern unsigned char _binary___user_lut_f32_gaudi2_o_end;
@@ -107,27 +108,14 @@ tpc_lib_api::GlueCodeReturn UserLutGaudi2::GetGcDefinitions(
     **************************************************************************************/
     unsigned tableSize = sizeof(LutTable)/sizeof(LutTable[0]);
 
-    out_defs->auxiliaryTensorNr = 1;
-    out_defs->auxiliaryTensors[0].geometry.dims = 1;
-    out_defs->auxiliaryTensors[0].geometry.maxSizes[0] = tableSize;
-    out_defs->auxiliaryTensors[0].geometry.maxSizes[1] = 0;
-    out_defs->auxiliaryTensors[0].geometry.maxSizes[2] = 0;
-    out_defs->auxiliaryTensors[0].geometry.maxSizes[3] = 0;
-    out_defs->auxiliaryTensors[0].geometry.maxSizes[4] = 0;
-
-    out_defs->auxiliaryTensors[0].geometry.dataType = tpc_lib_api::DATA_F32;
-    
-    unsigned required_size = out_defs->auxiliaryTensors[0].geometry.maxSizes[0] * sizeof(float);
-    // Check whether required memory is allocated for auxiliary tensor
-    if (required_size > out_defs->auxiliaryTensors[0].bufferSize)
+    // fill aux 0 with data, shared with the other user lut nodes
+    retVal = AuxTensorStore::FillF32Aux(out_defs, "user_lut", nullptr, 0, tableSize,
+                                        [](void* data, unsigned size) { memcpy(data, LutTable, size); });
+    if (retVal != tpc_lib_api::GLUE_SUCCESS)
     {
-        out_defs->auxiliaryTensors[0].bufferSize = required_size;
-        return tpc_lib_api::GLUE_INSUFFICIENT_AUX_BUFFER_SIZE;
+        return retVal;
     }
 
-    // fill aux 0 with data
-    memcpy(out_defs->auxiliaryTensors[0].pData, LutTable, required_size);
-
     /*************************************************************************************
     *    Stage V -  Load ISA into the descriptor.
     **************************************************************************************/
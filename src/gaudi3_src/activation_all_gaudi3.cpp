@@ -0,0 +1,98 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cstring>
+#include <cstdio>
+#include "activation_all_gaudi3.hpp"
+
+extern unsigned char _binary___gelu_tanh_fwd_f32_gaudi3_o_start;
+extern unsigned char _binary___gelu_tanh_fwd_f32_gaudi3_o_end;
+extern unsigned char _binary___gelu_tanh_fwd_bf16_gaudi3_o_start;
+extern unsigned char _binary___gelu_tanh_fwd_bf16_gaudi3_o_end;
+extern unsigned char _binary___gelu_tanh_bwd_f32_gaudi3_o_start;
+extern unsigned char _binary___gelu_tanh_bwd_f32_gaudi3_o_end;
+extern unsigned char _binary___gelu_tanh_bwd_bf16_gaudi3_o_start;
+extern unsigned char _binary___gelu_tanh_bwd_bf16_gaudi3_o_end;
+extern unsigned char _binary___gelu_erf_fwd_f32_gaudi3_o_start;
+extern unsigned char _binary___gelu_erf_fwd_f32_gaudi3_o_end;
+extern unsigned char _binary___gelu_erf_fwd_bf16_gaudi3_o_start;
+extern unsigned char _binary___gelu_erf_fwd_bf16_gaudi3_o_end;
+extern unsigned char _binary___gelu_erf_bwd_f32_gaudi3_o_start;
+extern unsigned char _binary___gelu_erf_bwd_f32_gaudi3_o_end;
+extern unsigned char _binary___gelu_erf_bwd_bf16_gaudi3_o_start;
+extern unsigned char _binary___gelu_erf_bwd_bf16_gaudi3_o_end;
+extern unsigned char _binary___silu_fwd_f32_gaudi3_o_start;
+extern unsigned char _binary___silu_fwd_f32_gaudi3_o_end;
+extern unsigned char _binary___silu_fwd_bf16_gaudi3_o_start;
+extern unsigned char _binary___silu_fwd_bf16_gaudi3_o_end;
+extern unsigned char _binary___silu_bwd_f32_gaudi3_o_start;
+extern unsigned char _binary___silu_bwd_f32_gaudi3_o_end;
+extern unsigned char _binary___silu_bwd_bf16_gaudi3_o_start;
+extern unsigned char _binary___silu_bwd_bf16_gaudi3_o_end;
+extern unsigned char _binary___swiglu_fwd_f32_gaudi3_o_start;
+extern unsigned char _binary___swiglu_fwd_f32_gaudi3_o_end;
+extern unsigned char _binary___swiglu_fwd_bf16_gaudi3_o_start;
+extern unsigned char _binary___swiglu_fwd_bf16_gaudi3_o_end;
+extern unsigned char _binary___swiglu_bwd_f32_gaudi3_o_start;
+extern unsigned char _binary___swiglu_bwd_f32_gaudi3_o_end;
+extern unsigned char _binary___swiglu_bwd_bf16_gaudi3_o_start;
+extern unsigned char _binary___swiglu_bwd_bf16_gaudi3_o_end;
+extern unsigned char _binary___geglu_fwd_f32_gaudi3_o_start;
+extern unsigned char _binary___geglu_fwd_f32_gaudi3_o_end;
+extern unsigned char _binary___geglu_fwd_bf16_gaudi3_o_start;
+extern unsigned char _binary___geglu_fwd_bf16_gaudi3_o_end;
+extern unsigned char _binary___geglu_bwd_f32_gaudi3_o_start;
+extern unsigned char _binary___geglu_bwd_f32_gaudi3_o_end;
+extern unsigned char _binary___geglu_bwd_bf16_gaudi3_o_start;
+extern unsigned char _binary___geglu_bwd_bf16_gaudi3_o_end;
+
+static unsigned char* const c_activationBinaries[][2] = {
+    {&_binary___gelu_tanh_fwd_f32_gaudi3_o_start, &_binary___gelu_tanh_fwd_f32_gaudi3_o_end},
+    {&_binary___gelu_tanh_fwd_bf16_gaudi3_o_start, &_binary___gelu_tanh_fwd_bf16_gaudi3_o_end},
+    {&_binary___gelu_tanh_bwd_f32_gaudi3_o_start, &_binary___gelu_tanh_bwd_f32_gaudi3_o_end},
+    {&_binary___gelu_tanh_bwd_bf16_gaudi3_o_start, &_binary___gelu_tanh_bwd_bf16_gaudi3_o_end},
+    {&_binary___gelu_erf_fwd_f32_gaudi3_o_start, &_binary___gelu_erf_fwd_f32_gaudi3_o_end},
+    {&_binary___gelu_erf_fwd_bf16_gaudi3_o_start, &_binary___gelu_erf_fwd_bf16_gaudi3_o_end},
+    {&_binary___gelu_erf_bwd_f32_gaudi3_o_start, &_binary___gelu_erf_bwd_f32_gaudi3_o_end},
+    {&_binary___gelu_erf_bwd_bf16_gaudi3_o_start, &_binary___gelu_erf_bwd_bf16_gaudi3_o_end},
+    {&_binary___silu_fwd_f32_gaudi3_o_start, &_binary___silu_fwd_f32_gaudi3_o_end},
+    {&_binary___silu_fwd_bf16_gaudi3_o_start, &_binary___silu_fwd_bf16_gaudi3_o_end},
+    {&_binary___silu_bwd_f32_gaudi3_o_start, &_binary___silu_bwd_f32_gaudi3_o_end},
+    {&_binary___silu_bwd_bf16_gaudi3_o_start, &_binary___silu_bwd_bf16_gaudi3_o_end},
+    {&_binary___swiglu_fwd_f32_gaudi3_o_start, &_binary___swiglu_fwd_f32_gaudi3_o_end},
+    {&_binary___swiglu_fwd_bf16_gaudi3_o_start, &_binary___swiglu_fwd_bf16_gaudi3_o_end},
+    {&_binary___swiglu_bwd_f32_gaudi3_o_start, &_binary___swiglu_bwd_f32_gaudi3_o_end},
+    {&_binary___swiglu_bwd_bf16_gaudi3_o_start, &_binary___swiglu_bwd_bf16_gaudi3_o_end},
+    {&_binary___geglu_fwd_f32_gaudi3_o_start, &_binary___geglu_fwd_f32_gaudi3_o_end},
+    {&_binary___geglu_fwd_bf16_gaudi3_o_start, &_binary___geglu_fwd_bf16_gaudi3_o_end},
+    {&_binary___geglu_bwd_f32_gaudi3_o_start, &_binary___geglu_bwd_f32_gaudi3_o_end},
+    {&_binary___geglu_bwd_bf16_gaudi3_o_start, &_binary___geglu_bwd_bf16_gaudi3_o_end}
+};
+
+tpc_lib_api::GlueCodeReturn ActivationAllGaudi3::GetKernelName(
+        char kernelName [tpc_lib_api::MAX_NODE_NAME], Activation_mode_t mode)
+{
+    if (mode >= activation_mode_count)
+        return tpc_lib_api::GLUE_NODE_NOT_FOUND;
+    snprintf(kernelName, tpc_lib_api::MAX_NODE_NAME, "custom_%s_gaudi3", GetModeName(mode));
+    return tpc_lib_api::GLUE_SUCCESS;
+}
+
+void ActivationAllGaudi3::GetKernelBinary(unsigned char** binary, unsigned* size)
+{
+    *binary = c_activationBinaries[m_mode][0];
+    *size = c_activationBinaries[m_mode][1] - c_activationBinaries[m_mode][0];
+}
@@ -0,0 +1,41 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef _ACTIVATION_ALL_GAUDI3_HPP
+#define _ACTIVATION_ALL_GAUDI3_HPP
+
+#include "activation_all_gaudi2.hpp"
+
+// Gaudi3 builds of the activation kernels. The kernel sources and the glue
+// code are shared with Gaudi2, only the kernel names and ISA differ.
+class ActivationAllGaudi3 : public ActivationAllGaudi2
+{
+public:
+    ActivationAllGaudi3(Activation_mode_t mode=gelu_tanh_fwd_f32) : ActivationAllGaudi2(mode) {}
+    virtual ~ActivationAllGaudi3() {}
+
+    virtual tpc_lib_api::GlueCodeReturn GetKernelName(
+            char kernelName [tpc_lib_api::MAX_NODE_NAME], Activation_mode_t mode);
+
+protected:
+    virtual void GetKernelBinary(unsigned char** binary, unsigned* size);
+
+private:
+    ActivationAllGaudi3(const ActivationAllGaudi3& other) = delete;
+    ActivationAllGaudi3& operator=(const ActivationAllGaudi3& other) = delete;
+};
+
+#endif //_ACTIVATION_ALL_GAUDI3_HPP
@@ -0,0 +1,88 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cstring>
+#include <cstdio>
+#include "binary_broadcast_gaudi3.hpp"
+
+extern unsigned char _binary___binary_broadcast_add_f32_gaudi3_o_start;
+extern unsigned char _binary___binary_broadcast_add_f32_gaudi3_o_end;
+extern unsigned char _binary___binary_broadcast_add_bf16_gaudi3_o_start;
+extern unsigned char _binary___binary_broadcast_add_bf16_gaudi3_o_end;
+extern unsigned char _binary___binary_broadcast_sub_f32_gaudi3_o_start;
+extern unsigned char _binary___binary_broadcast_sub_f32_gaudi3_o_end;
+extern unsigned char _binary___binary_broadcast_sub_bf16_gaudi3_o_start;
+extern unsigned char _binary___binary_broadcast_sub_bf16_gaudi3_o_end;
+extern unsigned char _binary___binary_broadcast_mul_f32_gaudi3_o_start;
+extern unsigned char _binary___binary_broadcast_mul_f32_gaudi3_o_end;
+extern unsigned char _binary___binary_broadcast_mul_bf16_gaudi3_o_start;
+extern unsigned char _binary___binary_broadcast_mul_bf16_gaudi3_o_end;
+extern unsigned char _binary___binary_broadcast_div_f32_gaudi3_o_start;
+extern unsigned char _binary___binary_broadcast_div_f32_gaudi3_o_end;
+extern unsigned char _binary___binary_broadcast_div_bf16_gaudi3_o_start;
+extern unsigned char _binary___binary_broadcast_div_bf16_gaudi3_o_end;
+extern unsigned char _binary___binary_broadcast_max_f32_gaudi3_o_start;
+extern unsigned char _binary___binary_broadcast_max_f32_gaudi3_o_end;
+extern unsigned char _binary___binary_broadcast_max_bf16_gaudi3_o_start;
+extern unsigned char _binary___binary_broadcast_max_bf16_gaudi3_o_end;
+extern unsigned char _binary___binary_broadcast_min_f32_gaudi3_o_start;
+extern unsigned char _binary___binary_broadcast_min_f32_gaudi3_o_end;
+extern unsigned char _binary___binary_broadcast_min_bf16_gaudi3_o_start;
+extern unsigned char _binary___binary_broadcast_min_bf16_gaudi3_o_end;
+
+// [op][mode]
+static unsigned char* const c_binaryBroadcastBinaries[BinaryBroadcast::binary_op_count]
+                                                    [BinaryBroadcast::binary_broadcast_mode_count][2] = {
+    {
+        {&_binary___binary_broadcast_add_f32_gaudi3_o_start, &_binary___binary_broadcast_add_f32_gaudi3_o_end},
+        {&_binary___binary_broadcast_add_bf16_gaudi3_o_start, &_binary___binary_broadcast_add_bf16_gaudi3_o_end}
+    },
+    {
+        {&_binary___binary_broadcast_sub_f32_gaudi3_o_start, &_binary___binary_broadcast_sub_f32_gaudi3_o_end},
+        {&_binary___binary_broadcast_sub_bf16_gaudi3_o_start, &_binary___binary_broadcast_sub_bf16_gaudi3_o_end}
+    },
+    {
+        {&_binary___binary_broadcast_mul_f32_gaudi3_o_start, &_binary___binary_broadcast_mul_f32_gaudi3_o_end},
+        {&_binary___binary_broadcast_mul_bf16_gaudi3_o_start, &_binary___binary_broadcast_mul_bf16_gaudi3_o_end}
+    },
+    {
+        {&_binary___binary_broadcast_div_f32_gaudi3_o_start, &_binary___binary_broadcast_div_f32_gaudi3_o_end},
+        {&_binary___binary_broadcast_div_bf16_gaudi3_o_start, &_binary___binary_broadcast_div_bf16_gaudi3_o_end}
+    },
+    {
+        {&_binary___binary_broadcast_max_f32_gaudi3_o_start, &_binary___binary_broadcast_max_f32_gaudi3_o_end},
+        {&_binary___binary_broadcast_max_bf16_gaudi3_o_start, &_binary___binary_broadcast_max_bf16_gaudi3_o_end}
+    },
+    {
+        {&_binary___binary_broadcast_min_f32_gaudi3_o_start, &_binary___binary_broadcast_min_f32_gaudi3_o_end},
+        {&_binary___binary_broadcast_min_bf16_gaudi3_o_start, &_binary___binary_broadcast_min_bf16_gaudi3_o_end}
+    }
+};
+
+tpc_lib_api::GlueCodeReturn BinaryBroadcastGaudi3::GetKernelName(
+        char kernelName [tpc_lib_api::MAX_NODE_NAME], BinaryBroadcast_mode_t mode)
+{
+    if (mode >= binary_broadcast_mode_count)
+        return tpc_lib_api::GLUE_NODE_NOT_FOUND;
+    snprintf(kernelName, tpc_lib_api::MAX_NODE_NAME, "custom_binary_broadcast_%s_gaudi3", GetModeName(mode));
+    return tpc_lib_api::GLUE_SUCCESS;
+}
+
+void BinaryBroadcastGaudi3::GetKernelBinary(BinaryOp_t op, unsigned char** binary, unsigned* size)
+{
+    *binary = c_binaryBroadcastBinaries[op][m_mode][0];
+    *size = c_binaryBroadcastBinaries[op][m_mode][1] - c_binaryBroadcastBinaries[op][m_mode][0];
+}
@@ -0,0 +1,188 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cstring>
+#include <cstdio>
+#include "cast_all_gaudi3.hpp"
+
+extern unsigned char _binary___cast_all_f32_to_bf16_gaudi3_o_start;
+extern unsigned char _binary___cast_all_f32_to_bf16_gaudi3_o_end;
+extern unsigned char _binary___cast_all_f32_to_f16_gaudi3_o_start;
+extern unsigned char _binary___cast_all_f32_to_f16_gaudi3_o_end;
+extern unsigned char _binary___cast_all_f32_to_i32_gaudi3_o_start;
+extern unsigned char _binary___cast_all_f32_to_i32_gaudi3_o_end;
+extern unsigned char _binary___cast_all_f32_to_i16_gaudi3_o_start;
+extern unsigned char _binary___cast_all_f32_to_i16_gaudi3_o_end;
+extern unsigned char _binary___cast_all_f32_to_i8_gaudi3_o_start;
+extern unsigned char _binary___cast_all_f32_to_i8_gaudi3_o_end;
+extern unsigned char _binary___cast_all_f32_to_u8_gaudi3_o_start;
+extern unsigned char _binary___cast_all_f32_to_u8_gaudi3_o_end;
+extern unsigned char _binary___cast_all_bf16_to_f32_gaudi3_o_start;
+extern unsigned char _binary___cast_all_bf16_to_f32_gaudi3_o_end;
+extern unsigned char _binary___cast_all_bf16_to_f16_gaudi3_o_start;
+extern unsigned char _binary___cast_all_bf16_to_f16_gaudi3_o_end;
+extern unsigned char _binary___cast_all_bf16_to_i32_gaudi3_o_start;
+extern unsigned char _binary___cast_all_bf16_to_i32_gaudi3_o_end;
+extern unsigned char _binary___cast_all_bf16_to_i16_gaudi3_o_start;
+extern unsigned char _binary___cast_all_bf16_to_i16_gaudi3_o_end;
+extern unsigned char _binary___cast_all_bf16_to_i8_gaudi3_o_start;
+extern unsigned char _binary___cast_all_bf16_to_i8_gaudi3_o_end;
+extern unsigned char _binary___cast_all_bf16_to_u8_gaudi3_o_start;
+extern unsigned char _binary___cast_all_bf16_to_u8_gaudi3_o_end;
+extern unsigned char _binary___cast_all_f16_to_f32_gaudi3_o_start;
+extern unsigned char _binary___cast_all_f16_to_f32_gaudi3_o_end;
+extern unsigned char _binary___cast_all_f16_to_bf16_gaudi3_o_start;
+extern unsigned char _binary___cast_all_f16_to_bf16_gaudi3_o_end;
+extern unsigned char _binary___cast_all_f16_to_i32_gaudi3_o_start;
+extern unsigned char _binary___cast_all_f16_to_i32_gaudi3_o_end;
+extern unsigned char _binary___cast_all_f16_to_i16_gaudi3_o_start;
+extern unsigned char _binary___cast_all_f16_to_i16_gaudi3_o_end;
+extern unsigned char _binary___cast_all_f16_to_i8_gaudi3_o_start;
+extern unsigned char _binary___cast_all_f16_to_i8_gaudi3_o_end;
+extern unsigned char _binary___cast_all_f16_to_u8_gaudi3_o_start;
+extern unsigned char _binary___cast_all_f16_to_u8_gaudi3_o_end;
+extern unsigned char _binary___cast_all_i32_to_f32_gaudi3_o_start;
+extern unsigned char _binary___cast_all_i32_to_f32_gaudi3_o_end;
+extern unsigned char _binary___cast_all_i32_to_bf16_gaudi3_o_start;
+extern unsigned char _binary___cast_all_i32_to_bf16_gaudi3_o_end;
+extern unsigned char _binary___cast_all_i32_to_f16_gaudi3_o_start;
+extern unsigned char _binary___cast_all_i32_to_f16_gaudi3_o_end;
+extern unsigned char _binary___cast_all_i32_to_i16_gaudi3_o_start;
+extern unsigned char _binary___cast_all_i32_to_i16_gaudi3_o_end;
+extern unsigned char _binary___cast_all_i32_to_i8_gaudi3_o_start;
+extern unsigned char _binary___cast_all_i32_to_i8_gaudi3_o_end;
+extern unsigned char _binary___cast_all_i32_to_u8_gaudi3_o_start;
+extern unsigned char _binary___cast_all_i32_to_u8_gaudi3_o_end;
+extern unsigned char _binary___cast_all_i16_to_f32_gaudi3_o_start;
+extern unsigned char _binary___cast_all_i16_to_f32_gaudi3_o_end;
+extern unsigned char _binary___cast_all_i16_to_bf16_gaudi3_o_start;
+extern unsigned char _binary___cast_all_i16_to_bf16_gaudi3_o_end;
+extern unsigned char _binary___cast_all_i16_to_f16_gaudi3_o_start;
+extern unsigned char _binary___cast_all_i16_to_f16_gaudi3_o_end;
+extern unsigned char _binary___cast_all_i16_to_i32_gaudi3_o_start;
+extern unsigned char _binary___cast_all_i16_to_i32_gaudi3_o_end;
+extern unsigned char _binary___cast_all_i16_to_i8_gaudi3_o_start;
+extern unsigned char _binary___cast_all_i16_to_i8_gaudi3_o_end;
+extern unsigned char _binary___cast_all_i16_to_u8_gaudi3_o_start;
+extern unsigned char _binary___cast_all_i16_to_u8_gaudi3_o_end;
+extern unsigned char _binary___cast_all_i8_to_f32_gaudi3_o_start;
+extern unsigned char _binary___cast_all_i8_to_f32_gaudi3_o_end;
+extern unsigned char _binary___cast_all_i8_to_bf16_gaudi3_o_start;
+extern unsigned char _binary___cast_all_i8_to_bf16_gaudi3_o_end;
+extern unsigned char _binary___cast_all_i8_to_f16_gaudi3_o_start;
+extern unsigned char _binary___cast_all_i8_to_f16_gaudi3_o_end;
+extern unsigned char _binary___cast_all_i8_to_i32_gaudi3_o_start;
+extern unsigned char _binary___cast_all_i8_to_i32_gaudi3_o_end;
+extern unsigned char _binary___cast_all_i8_to_i16_gaudi3_o_start;
+extern unsigned char _binary___cast_all_i8_to_i16_gaudi3_o_end;
+extern unsigned char _binary___cast_all_i8_to_u8_gaudi3_o_start;
+extern unsigned char _binary___cast_all_i8_to_u8_gaudi3_o_end;
+extern unsigned char _binary___cast_all_u8_to_f32_gaudi3_o_start;
+extern unsigned char _binary___cast_all_u8_to_f32_gaudi3_o_end;
+extern unsigned char _binary___cast_all_u8_to_bf16_gaudi3_o_start;
+extern unsigned char _binary___cast_all_u8_to_bf16_gaudi3_o_end;
+extern unsigned char _binary___cast_all_u8_to_f16_gaudi3_o_start;
+extern unsigned char _binary___cast_all_u8_to_f16_gaudi3_o_end;
+extern unsigned char _binary___cast_all_u8_to_i32_gaudi3_o_start;
+extern unsigned char _binary___cast_all_u8_to_i32_gaudi3_o_end;
+extern unsigned char _binary___cast_all_u8_to_i16_gaudi3_o_start;
+extern unsigned char _binary___cast_all_u8_to_i16_gaudi3_o_end;
+extern unsigned char _binary___cast_all_u8_to_i8_gaudi3_o_start;
+extern unsigned char _binary___cast_all_u8_to_i8_gaudi3_o_end;
+
+// [src][dst], nothing is built for src == dst
+static unsigned char* const c_castAllBinaries[CastAllGaudi2::cast_type_count]
+                                             [CastAllGaudi2::cast_type_count][2] = {
+    {
+        {nullptr, nullptr},
+        {&_binary___cast_all_f32_to_bf16_gaudi3_o_start, &_binary___cast_all_f32_to_bf16_gaudi3_o_end},
+        {&_binary___cast_all_f32_to_f16_gaudi3_o_start, &_binary___cast_all_f32_to_f16_gaudi3_o_end},
+        {&_binary___cast_all_f32_to_i32_gaudi3_o_start, &_binary___cast_all_f32_to_i32_gaudi3_o_end},
+        {&_binary___cast_all_f32_to_i16_gaudi3_o_start, &_binary___cast_all_f32_to_i16_gaudi3_o_end},
+        {&_binary___cast_all_f32_to_i8_gaudi3_o_start, &_binary___cast_all_f32_to_i8_gaudi3_o_end},
+        {&_binary___cast_all_f32_to_u8_gaudi3_o_start, &_binary___cast_all_f32_to_u8_gaudi3_o_end}
+    },
+    {
+        {&_binary___cast_all_bf16_to_f32_gaudi3_o_start, &_binary___cast_all_bf16_to_f32_gaudi3_o_end},
+        {nullptr, nullptr},
+        {&_binary___cast_all_bf16_to_f16_gaudi3_o_start, &_binary___cast_all_bf16_to_f16_gaudi3_o_end},
+        {&_binary___cast_all_bf16_to_i32_gaudi3_o_start, &_binary___cast_all_bf16_to_i32_gaudi3_o_end},
+        {&_binary___cast_all_bf16_to_i16_gaudi3_o_start, &_binary___cast_all_bf16_to_i16_gaudi3_o_end},
+        {&_binary___cast_all_bf16_to_i8_gaudi3_o_start, &_binary___cast_all_bf16_to_i8_gaudi3_o_end},
+        {&_binary___cast_all_bf16_to_u8_gaudi3_o_start, &_binary___cast_all_bf16_to_u8_gaudi3_o_end}
+    },
+    {
+        {&_binary___cast_all_f16_to_f32_gaudi3_o_start, &_binary___cast_all_f16_to_f32_gaudi3_o_end},
+        {&_binary___cast_all_f16_to_bf16_gaudi3_o_start, &_binary___cast_all_f16_to_bf16_gaudi3_o_end},
+        {nullptr, nullptr},
+        {&_binary___cast_all_f16_to_i32_gaudi3_o_start, &_binary___cast_all_f16_to_i32_gaudi3_o_end},
+        {&_binary___cast_all_f16_to_i16_gaudi3_o_start, &_binary___cast_all_f16_to_i16_gaudi3_o_end},
+        {&_binary___cast_all_f16_to_i8_gaudi3_o_start, &_binary___cast_all_f16_to_i8_gaudi3_o_end},
+        {&_binary___cast_all_f16_to_u8_gaudi3_o_start, &_binary___cast_all_f16_to_u8_gaudi3_o_end}
+    },
+    {
+        {&_binary___cast_all_i32_to_f32_gaudi3_o_start, &_binary___cast_all_i32_to_f32_gaudi3_o_end},
+        {&_binary___cast_all_i32_to_bf16_gaudi3_o_start, &_binary___cast_all_i32_to_bf16_gaudi3_o_end},
+        {&_binary___cast_all_i32_to_f16_gaudi3_o_start, &_binary___cast_all_i32_to_f16_gaudi3_o_end},
+        {nullptr, nullptr},
+        {&_binary___cast_all_i32_to_i16_gaudi3_o_start, &_binary___cast_all_i32_to_i16_gaudi3_o_end},
+        {&_binary___cast_all_i32_to_i8_gaudi3_o_start, &_binary___cast_all_i32_to_i8_gaudi3_o_end},
+        {&_binary___cast_all_i32_to_u8_gaudi3_o_start, &_binary___cast_all_i32_to_u8_gaudi3_o_end}
+    },
+    {
+        {&_binary___cast_all_i16_to_f32_gaudi3_o_start, &_binary___cast_all_i16_to_f32_gaudi3_o_end},
+        {&_binary___cast_all_i16_to_bf16_gaudi3_o_start, &_binary___cast_all_i16_to_bf16_gaudi3_o_end},
+        {&_binary___cast_all_i16_to_f16_gaudi3_o_start, &_binary___cast_all_i16_to_f16_gaudi3_o_end},
+        {&_binary___cast_all_i16_to_i32_gaudi3_o_start, &_binary___cast_all_i16_to_i32_gaudi3_o_end},
+        {nullptr, nullptr},
+        {&_binary___cast_all_i16_to_i8_gaudi3_o_start, &_binary___cast_all_i16_to_i8_gaudi3_o_end},
+        {&_binary___cast_all_i16_to_u8_gaudi3_o_start, &_binary___cast_all_i16_to_u8_gaudi3_o_end}
+    },
+    {
+        {&_binary___cast_all_i8_to_f32_gaudi3_o_start, &_binary___cast_all_i8_to_f32_gaudi3_o_end},
+        {&_binary___cast_all_i8_to_bf16_gaudi3_o_start, &_binary___cast_all_i8_to_bf16_gaudi3_o_end},
+        {&_binary___cast_all_i8_to_f16_gaudi3_o_start, &_binary___cast_all_i8_to_f16_gaudi3_o_end},
+        {&_binary___cast_all_i8_to_i32_gaudi3_o_start, &_binary___cast_all_i8_to_i32_gaudi3_o_end},
+        {&_binary___cast_all_i8_to_i16_gaudi3_o_start, &_binary___cast_all_i8_to_i16_gaudi3_o_end},
+        {nullptr, nullptr},
+        {&_binary___cast_all_i8_to_u8_gaudi3_o_start, &_binary___cast_all_i8_to_u8_gaudi3_o_end}
+    },
+    {
+        {&_binary___cast_all_u8_to_f32_gaudi3_o_start, &_binary___cast_all_u8_to_f32_gaudi3_o_end},
+        {&_binary___cast_all_u8_to_bf16_gaudi3_o_start, &_binary___cast_all_u8_to_bf16_gaudi3_o_end},
+        {&_binary___cast_all_u8_to_f16_gaudi3_o_start, &_binary___cast_all_u8_to_f16_gaudi3_o_end},
+        {&_binary___cast_all_u8_to_i32_gaudi3_o_start, &_binary___cast_all_u8_to_i32_gaudi3_o_end},
+        {&_binary___cast_all_u8_to_i16_gaudi3_o_start, &_binary___cast_all_u8_to_i16_gaudi3_o_end},
+        {&_binary___cast_all_u8_to_i8_gaudi3_o_start, &_binary___cast_all_u8_to_i8_gaudi3_o_end},
+        {nullptr, nullptr}
+    }
+};
+
+tpc_lib_api::GlueCodeReturn CastAllGaudi3::GetKernelName(
+        char kernelName [tpc_lib_api::MAX_NODE_NAME], CastType_t src, CastType_t dst)
+{
+    if (src >= cast_type_count || dst >= cast_type_count || src == dst)
+        return tpc_lib_api::GLUE_NODE_NOT_FOUND;
+    snprintf(kernelName, tpc_lib_api::MAX_NODE_NAME, "custom_cast_all_%s_to_%s_gaudi3",
+             GetTypeName(src), GetTypeName(dst));
+    return tpc_lib_api::GLUE_SUCCESS;
+}
+
+void CastAllGaudi3::GetKernelBinary(unsigned char** binary, unsigned* size)
+{
+    *binary = c_castAllBinaries[m_src][m_dst][0];
+    *size = c_castAllBinaries[m_src][m_dst][1] - c_castAllBinaries[m_src][m_dst][0];
+}
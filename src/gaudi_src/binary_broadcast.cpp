@@ -0,0 +1,260 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cstring>
+#include <cstdio>
+#include "binary_broadcast.hpp"
+
+extern unsigned char _binary___binary_broadcast_add_f32_o_start;
+extern unsigned char _binary___binary_broadcast_add_f32_o_end;
+extern unsigned char _binary___binary_broadcast_add_bf16_o_start;
+extern unsigned char _binary___binary_broadcast_add_bf16_o_end;
+extern unsigned char _binary___binary_broadcast_sub_f32_o_start;
+extern unsigned char _binary___binary_broadcast_sub_f32_o_end;
+extern unsigned char _binary___binary_broadcast_sub_bf16_o_start;
+extern unsigned char _binary___binary_broadcast_sub_bf16_o_end;
+extern unsigned char _binary___binary_broadcast_mul_f32_o_start;
+extern unsigned char _binary___binary_broadcast_mul_f32_o_end;
+extern unsigned char _binary___binary_broadcast_mul_bf16_o_start;
+extern unsigned char _binary___binary_broadcast_mul_bf16_o_end;
+extern unsigned char _binary___binary_broadcast_div_f32_o_start;
+extern unsigned char _binary___binary_broadcast_div_f32_o_end;
+extern unsigned char _binary___binary_broadcast_div_bf16_o_start;
+extern unsigned char _binary___binary_broadcast_div_bf16_o_end;
+extern unsigned char _binary___binary_broadcast_max_f32_o_start;
+extern unsigned char _binary___binary_broadcast_max_f32_o_end;
+extern unsigned char _binary___binary_broadcast_max_bf16_o_start;
+extern unsigned char _binary___binary_broadcast_max_bf16_o_end;
+extern unsigned char _binary___binary_broadcast_min_f32_o_start;
+extern unsigned char _binary___binary_broadcast_min_f32_o_end;
+extern unsigned char _binary___binary_broadcast_min_bf16_o_start;
+extern unsigned char _binary___binary_broadcast_min_bf16_o_end;
+
+// [op][mode]
+static unsigned char* const c_binaryBroadcastBinaries[BinaryBroadcast::binary_op_count]
+                                                    [BinaryBroadcast::binary_broadcast_mode_count][2] = {
+    {
+        {&_binary___binary_broadcast_add_f32_o_start, &_binary___binary_broadcast_add_f32_o_end},
+        {&_binary___binary_broadcast_add_bf16_o_start, &_binary___binary_broadcast_add_bf16_o_end}
+    },
+    {
+        {&_binary___binary_broadcast_sub_f32_o_start, &_binary___binary_broadcast_sub_f32_o_end},
+        {&_binary___binary_broadcast_sub_bf16_o_start, &_binary___binary_broadcast_sub_bf16_o_end}
+    },
+    {
+        {&_binary___binary_broadcast_mul_f32_o_start, &_binary___binary_broadcast_mul_f32_o_end},
+        {&_binary___binary_broadcast_mul_bf16_o_start, &_binary___binary_broadcast_mul_bf16_o_end}
+    },
+    {
+        {&_binary___binary_broadcast_div_f32_o_start, &_binary___binary_broadcast_div_f32_o_end},
+        {&_binary___binary_broadcast_div_bf16_o_start, &_binary___binary_broadcast_div_bf16_o_end}
+    },
+    {
+        {&_binary___binary_broadcast_max_f32_o_start, &_binary___binary_broadcast_max_f32_o_end},
+        {&_binary___binary_broadcast_max_bf16_o_start, &_binary___binary_broadcast_max_bf16_o_end}
+    },
+    {
+        {&_binary___binary_broadcast_min_f32_o_start, &_binary___binary_broadcast_min_f32_o_end},
+        {&_binary___binary_broadcast_min_bf16_o_start, &_binary___binary_broadcast_min_bf16_o_end}
+    }
+};
+
+static const char* const c_binaryBroadcastModeNames[] = {
+    "f32",
+    "bf16"
+};
+
+static const tpc_lib_api::TensorDataType c_binaryBroadcastDataTypes[] = {
+    tpc_lib_api::DATA_F32,
+    tpc_lib_api::DATA_BF16
+};
+
+const char* BinaryBroadcast::GetModeName(BinaryBroadcast_mode_t mode)
+{
+    return c_binaryBroadcastModeNames[mode];
+}
+
+tpc_lib_api::GlueCodeReturn BinaryBroadcast::GetKernelName(
+        char kernelName [tpc_lib_api::MAX_NODE_NAME], BinaryBroadcast_mode_t mode)
+{
+    if (mode >= binary_broadcast_mode_count)
+        return tpc_lib_api::GLUE_NODE_NOT_FOUND;
+    snprintf(kernelName, tpc_lib_api::MAX_NODE_NAME, "custom_binary_broadcast_%s", GetModeName(mode));
+    return tpc_lib_api::GLUE_SUCCESS;
+}
+
+void BinaryBroadcast::GetKernelBinary(BinaryOp_t op, unsigned char** binary, unsigned* size)
+{
+    *binary = c_binaryBroadcastBinaries[op][m_mode][0];
+    *size = c_binaryBroadcastBinaries[op][m_mode][1] - c_binaryBroadcastBinaries[op][m_mode][0];
+}
+
+tpc_lib_api::GlueCodeReturn BinaryBroadcast::GetGcDefinitions(
+        tpc_lib_api::HabanaKernelParams* in_defs,
+        tpc_lib_api::HabanaKernelInstantiation* out_defs)
+{
+    tpc_lib_api::GlueCodeReturn retVal;
+    BinaryBroadcastParams* def = static_cast<BinaryBroadcastParams*>(in_defs->nodeParams.nodeParams);
+
+    /*************************************************************************************
+    *   Stage I - validate input
+    **************************************************************************************/
+    if (m_mode >= binary_broadcast_mode_count)
+    {
+        return tpc_lib_api::GLUE_NODE_NOT_FOUND;
+    }
+
+    //validate correct amount of input tensors
+    if (in_defs->inputTensorNr != 2)
+    {
+        in_defs->inputTensorNr  = 2;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_COUNT;
+    }
+    //validate correct amount of output tensors
+    if (in_defs->outputTensorNr != 1)
+    {
+        in_defs->outputTensorNr  = 1;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_COUNT;
+    }
+    if (def == nullptr || def->op < 0 || def->op >= binary_op_count)
+    {
+        return tpc_lib_api::GLUE_UNSUPPORTED_LAYER_CONFIGURATION;
+    }
+
+    // validate input and output data type
+    const tpc_lib_api::TensorDataType dataType = c_binaryBroadcastDataTypes[m_mode];
+    for (unsigned i = 0; i < 2; i++)
+    {
+        if (in_defs->inputTensors[i].geometry.dataType != dataType)
+        {
+            in_defs->inputTensors[i].geometry.dataType = dataType;
+            return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+        }
+    }
+    if (in_defs->outputTensors[0].geometry.dataType != dataType)
+    {
+        in_defs->outputTensors[0].geometry.dataType = dataType;
+        return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
+    }
+
+    // every dim of an input is the ofm dim or 1, dims past the rank are 1
+    uint64_t ifmSizes[2][gcapi::MAX_TENSOR_DIM] = {{1, 1, 1, 1, 1}, {1, 1, 1, 1, 1}};
+    unsigned dims = 0;
+    for (unsigned i = 0; i < 2; i++)
+    {
+        const tpc_lib_api::Tensor* ifm = &in_defs->inputTensors[i];
+        if (ifm->geometry.dims < 1 || ifm->geometry.dims > gcapi::MAX_TENSOR_DIM)
+        {
+            return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+        }
+        memcpy(ifmSizes[i], ifm->geometry.maxSizes, ifm->geometry.dims * sizeof(uint64_t));
+        dims = ifm->geometry.dims > dims ? ifm->geometry.dims : dims;
+    }
+
+    uint64_t ofmSizes[gcapi::MAX_TENSOR_DIM] = {1, 1, 1, 1, 1};
+    int bcastMask[2] = {0, 0};
+    for (unsigned dim = 0; dim < gcapi::MAX_TENSOR_DIM; dim++)
+    {
+        const uint64_t size0 = ifmSizes[0][dim];
+        const uint64_t size1 = ifmSizes[1][dim];
+        if (size0 != size1 && size0 != 1 && size1 != 1)
+        {
+            return tpc_lib_api::GLUE_INCOMPATIBLE_INPUT_SIZE;
+        }
+        ofmSizes[dim] = size0 > size1 ? size0 : size1;
+        bcastMask[0] |= (size0 != ofmSizes[dim]) << dim;
+        bcastMask[1] |= (size1 != ofmSizes[dim]) << dim;
+    }
+
+    // in place the ofm takes the memory of ifm0, which can't be broadcast
+    if (def->inPlace && (bcastMask[0] != 0 || in_defs->inputTensors[0].geometry.dims != dims))
+    {
+        return tpc_lib_api::GLUE_UNSUPPORTED_LAYER_CONFIGURATION;
+    }
+
+    // verify that output feature map dimension are correct
+    if (in_defs->outputTensors[0].geometry.dims != dims ||
+        memcmp(in_defs->outputTensors[0].geometry.maxSizes, ofmSizes, dims * sizeof(uint64_t)) != 0)
+    {
+        in_defs->outputTensors[0].geometry.dims = dims;
+        memcpy(in_defs->outputTensors[0].geometry.maxSizes, ofmSizes, sizeof(ofmSizes));
+        return tpc_lib_api::GLUE_INCOMPATIBLE_OUTPUT_SIZE;
+    }
+
+    /*************************************************************************************
+    *    Stage II -  Define index space geometry. The index space follows the ofm, one
+    *    vector of dim 0 per member.
+    **************************************************************************************/
+    const int vectorSize = GetVectorSize();
+    out_defs->indexSpaceRank = gcapi::MAX_TENSOR_DIM;
+    out_defs->indexSpaceGeometry[0] = (ofmSizes[0] + vectorSize - 1) / vectorSize;
+    for (unsigned dim = 1; dim < out_defs->indexSpaceRank; dim++)
+    {
+        out_defs->indexSpaceGeometry[dim] = ofmSizes[dim];
+    }
+
+    /*************************************************************************************
+    *    Stage III -  Define index space mapping. Broadcast dims of an input are read
+    *    at 0 by every member.
+    **************************************************************************************/
+    tpc_lib_api::TensorAccessPattern* patterns[3] = {
+            &out_defs->inputTensorAccessPattern[0], &out_defs->inputTensorAccessPattern[1],
+            &out_defs->outputTensorAccessPattern[0]};
+    for (unsigned i = 0; i < 3; i++)
+    {
+        const int mask = i < 2 ? bcastMask[i] : 0;
+        for (unsigned dim = 0; dim < out_defs->indexSpaceRank; dim++)
+        {
+            const int a = dim == 0 ? vectorSize : 1;
+            const bool bcast = (mask >> dim) & 1;
+
+            // f_start f(i) = a*i + 0;
+            // f_end   f(i) = a*i + (a - 1);
+            patterns[i]->mapping[dim].indexSpaceDim = dim;
+            patterns[i]->mapping[dim].a             = bcast ? 0 : a;
+            patterns[i]->mapping[dim].start_b       = 0;
+            patterns[i]->mapping[dim].end_b         = bcast ? 0 : a - 1;
+        }
+    }
+
+    /*************************************************************************************
+    *    Stage IV -  define scalar parameters
+    **************************************************************************************/
+    out_defs->kernel.paramsNr = 2;
+    memcpy(&(out_defs->kernel.scalarParams[0]), &bcastMask[0], sizeof(int));
+    memcpy(&(out_defs->kernel.scalarParams[1]), &bcastMask[1], sizeof(int));
+
+    /*************************************************************************************
+    *    Stage V -  Load ISA into the descriptor.
+    **************************************************************************************/
+    unsigned char* binary_kernel = nullptr;
+    unsigned IsaSize = 0;
+    GetKernelBinary((BinaryOp_t)def->op, &binary_kernel, &IsaSize);
+
+    unsigned givenBinarySize = out_defs->kernel.elfSize;
+    out_defs->kernel.elfSize = IsaSize;
+    if (givenBinarySize >= IsaSize)
+    {
+        memcpy (out_defs->kernel.kernelElf, binary_kernel, IsaSize);
+    }
+    else
+    {
+        retVal = tpc_lib_api::GLUE_INSUFFICIENT_ELF_BUFFER;
+        return retVal;
+    }
+
+    return tpc_lib_api::GLUE_SUCCESS;
+}
@@ -0,0 +1,84 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef _BINARY_BROADCAST_HPP
+#define _BINARY_BROADCAST_HPP
+
+#include "gc_interface.h"
+#include "tpc_kernel_lib_interface.h"
+
+// Elementwise ofm = op(ifm0, ifm1) for f32 and bf16 with numpy style
+// broadcasting: every dim of an input is either the ofm dim or 1, missing
+// outer dims count as 1. One guid per data type, the op in the params
+// selects the binary. With inPlace the ofm may share the memory of ifm0,
+// which then must have the ofm shape.
+// BinaryBroadcastGaudi2 and BinaryBroadcastGaudi3 reuse this glue code with
+// their own binaries.
+class BinaryBroadcast
+{
+public:
+    typedef enum _BinaryBroadcast_mode_t
+    {
+        binary_broadcast_f32,
+        binary_broadcast_bf16,
+        binary_broadcast_mode_count
+    } BinaryBroadcast_mode_t;
+
+    typedef enum _BinaryOp_t
+    {
+        binary_add,
+        binary_sub,
+        binary_mul,
+        binary_div,
+        binary_max,
+        binary_min,
+        binary_op_count
+    } BinaryOp_t;
+
+    BinaryBroadcast(BinaryBroadcast_mode_t mode=binary_broadcast_f32) {m_mode = mode;}
+    virtual ~BinaryBroadcast() {}
+
+    virtual tpc_lib_api::GlueCodeReturn GetGcDefinitions(
+            tpc_lib_api::HabanaKernelParams* in_defs,
+            tpc_lib_api::HabanaKernelInstantiation* out_defs);
+
+    virtual tpc_lib_api::GlueCodeReturn GetKernelName(
+            char kernelName [tpc_lib_api::MAX_NODE_NAME], BinaryBroadcast_mode_t mode);
+
+    // This struct is common between the TPC kernel writer and the framework
+    // layer writer.
+    struct BinaryBroadcastParams
+    {
+        int32_t op;         // BinaryOp_t
+        int32_t inPlace;    // non zero when the ofm aliases ifm0
+    };
+
+    // elements of dim 0 per index space member, one vector
+    int GetVectorSize() const { return m_mode == binary_broadcast_f32 ? 64 : 128; }
+
+protected:
+    static const char* GetModeName(BinaryBroadcast_mode_t mode);
+    // ISA of op for m_mode on the device this class instantiates kernels for
+    virtual void GetKernelBinary(BinaryOp_t op, unsigned char** binary, unsigned* size);
+
+    BinaryBroadcast_mode_t m_mode;
+
+private:
+    BinaryBroadcast(const BinaryBroadcast& other) = delete;
+    BinaryBroadcast& operator=(const BinaryBroadcast& other) = delete;
+};
+
+#endif //_BINARY_BROADCAST_HPP
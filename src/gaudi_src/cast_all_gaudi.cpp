@@ -0,0 +1,214 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cstring>
+#include <cstdio>
+#include "cast_all_gaudi.hpp"
+
+extern unsigned char _binary___cast_all_f32_to_bf16_o_start;
+extern unsigned char _binary___cast_all_f32_to_bf16_o_end;
+extern unsigned char _binary___cast_all_f32_to_i32_o_start;
+extern unsigned char _binary___cast_all_f32_to_i32_o_end;
+extern unsigned char _binary___cast_all_f32_to_i16_o_start;
+extern unsigned char _binary___cast_all_f32_to_i16_o_end;
+extern unsigned char _binary___cast_all_f32_to_i8_o_start;
+extern unsigned char _binary___cast_all_f32_to_i8_o_end;
+extern unsigned char _binary___cast_all_f32_to_u8_o_start;
+extern unsigned char _binary___cast_all_f32_to_u8_o_end;
+extern unsigned char _binary___cast_all_bf16_to_f32_o_start;
+extern unsigned char _binary___cast_all_bf16_to_f32_o_end;
+extern unsigned char _binary___cast_all_bf16_to_i32_o_start;
+extern unsigned char _binary___cast_all_bf16_to_i32_o_end;
+extern unsigned char _binary___cast_all_bf16_to_i16_o_start;
+extern unsigned char _binary___cast_all_bf16_to_i16_o_end;
+extern unsigned char _binary___cast_all_bf16_to_i8_o_start;
+extern unsigned char _binary___cast_all_bf16_to_i8_o_end;
+extern unsigned char _binary___cast_all_bf16_to_u8_o_start;
+extern unsigned char _binary___cast_all_bf16_to_u8_o_end;
+extern unsigned char _binary___cast_all_i32_to_f32_o_start;
+extern unsigned char _binary___cast_all_i32_to_f32_o_end;
+extern unsigned char _binary___cast_all_i32_to_bf16_o_start;
+extern unsigned char _binary___cast_all_i32_to_bf16_o_end;
+extern unsigned char _binary___cast_all_i32_to_i16_o_start;
+extern unsigned char _binary___cast_all_i32_to_i16_o_end;
+extern unsigned char _binary___cast_all_i32_to_i8_o_start;
+extern unsigned char _binary___cast_all_i32_to_i8_o_end;
+extern unsigned char _binary___cast_all_i32_to_u8_o_start;
+extern unsigned char _binary___cast_all_i32_to_u8_o_end;
+extern unsigned char _binary___cast_all_i16_to_f32_o_start;
+extern unsigned char _binary___cast_all_i16_to_f32_o_end;
+extern unsigned char _binary___cast_all_i16_to_bf16_o_start;
+extern unsigned char _binary___cast_all_i16_to_bf16_o_end;
+extern unsigned char _binary___cast_all_i16_to_i32_o_start;
+extern unsigned char _binary___cast_all_i16_to_i32_o_end;
+extern unsigned char _binary___cast_all_i16_to_i8_o_start;
+extern unsigned char _binary___cast_all_i16_to_i8_o_end;
+extern unsigned char _binary___cast_all_i16_to_u8_o_start;
+extern unsigned char _binary___cast_all_i16_to_u8_o_end;
+extern unsigned char _binary___cast_all_i8_to_f32_o_start;
+extern unsigned char _binary___cast_all_i8_to_f32_o_end;
+extern unsigned char _binary___cast_all_i8_to_bf16_o_start;
+extern unsigned char _binary___cast_all_i8_to_bf16_o_end;
+extern unsigned char _binary___cast_all_i8_to_i32_o_start;
+extern unsigned char _binary___cast_all_i8_to_i32_o_end;
+extern unsigned char _binary___cast_all_i8_to_i16_o_start;
+extern unsigned char _binary___cast_all_i8_to_i16_o_end;
+extern unsigned char _binary___cast_all_i8_to_u8_o_start;
+extern unsigned char _binary___cast_all_i8_to_u8_o_end;
+extern unsigned char _binary___cast_all_u8_to_f32_o_start;
+extern unsigned char _binary___cast_all_u8_to_f32_o_end;
+extern unsigned char _binary___cast_all_u8_to_bf16_o_start;
+extern unsigned char _binary___cast_all_u8_to_bf16_o_end;
+extern unsigned char _binary___cast_all_u8_to_i32_o_start;
+extern unsigned char _binary___cast_all_u8_to_i32_o_end;
+extern unsigned char _binary___cast_all_u8_to_i16_o_start;
+extern unsigned char _binary___cast_all_u8_to_i16_o_end;
+extern unsigned char _binary___cast_all_u8_to_i8_o_start;
+extern unsigned char _binary___cast_all_u8_to_i8_o_end;
+
+// [src][dst], nothing is built for src == dst or f16
+static unsigned char* const c_castAllBinaries[CastAllGaudi2::cast_type_count]
+                                             [CastAllGaudi2::cast_type_count][2] = {
+    {
+        {nullptr, nullptr},
+        {&_binary___cast_all_f32_to_bf16_o_start, &_binary___cast_all_f32_to_bf16_o_end},
+        {nullptr, nullptr},
+        {&_binary___cast_all_f32_to_i32_o_start, &_binary___cast_all_f32_to_i32_o_end},
+        {&_binary___cast_all_f32_to_i16_o_start, &_binary___cast_all_f32_to_i16_o_end},
+        {&_binary___cast_all_f32_to_i8_o_start, &_binary___cast_all_f32_to_i8_o_end},
+        {&_binary___cast_all_f32_to_u8_o_start, &_binary___cast_all_f32_to_u8_o_end}
+    },
+    {
+        {&_binary___cast_all_bf16_to_f32_o_start, &_binary___cast_all_bf16_to_f32_o_end},
+        {nullptr, nullptr},
+        {nullptr, nullptr},
+        {&_binary___cast_all_bf16_to_i32_o_start, &_binary___cast_all_bf16_to_i32_o_end},
+        {&_binary___cast_all_bf16_to_i16_o_start, &_binary___cast_all_bf16_to_i16_o_end},
+        {&_binary___cast_all_bf16_to_i8_o_start, &_binary___cast_all_bf16_to_i8_o_end},
+        {&_binary___cast_all_bf16_to_u8_o_start, &_binary___cast_all_bf16_to_u8_o_end}
+    },
+    {
+        {nullptr, nullptr},
+        {nullptr, nullptr},
+        {nullptr, nullptr},
+        {nullptr, nullptr},
+        {nullptr, nullptr},
+        {nullptr, nullptr},
+        {nullptr, nullptr}
+    },
+    {
+        {&_binary___cast_all_i32_to_f32_o_start, &_binary___cast_all_i32_to_f32_o_end},
+        {&_binary___cast_all_i32_to_bf16_o_start, &_binary___cast_all_i32_to_bf16_o_end},
+        {nullptr, nullptr},
+        {nullptr, nullptr},
+        {&_binary___cast_all_i32_to_i16_o_start, &_binary___cast_all_i32_to_i16_o_end},
+        {&_binary___cast_all_i32_to_i8_o_start, &_binary___cast_all_i32_to_i8_o_end},
+        {&_binary___cast_all_i32_to_u8_o_start, &_binary___cast_all_i32_to_u8_o_end}
+    },
+    {
+        {&_binary___cast_all_i16_to_f32_o_start, &_binary___cast_all_i16_to_f32_o_end},
+        {&_binary___cast_all_i16_to_bf16_o_start, &_binary___cast_all_i16_to_bf16_o_end},
+        {nullptr, nullptr},
+        {&_binary___cast_all_i16_to_i32_o_start, &_binary___cast_all_i16_to_i32_o_end},
+        {nullptr, nullptr},
+        {&_binary___cast_all_i16_to_i8_o_start, &_binary___cast_all_i16_to_i8_o_end},
+        {&_binary___cast_all_i16_to_u8_o_start, &_binary___cast_all_i16_to_u8_o_end}
+    },
+    {
+        {&_binary___cast_all_i8_to_f32_o_start, &_binary___cast_all_i8_to_f32_o_end},
+        {&_binary___cast_all_i8_to_bf16_o_start, &_binary___cast_all_i8_to_bf16_o_end},
+        {nullptr, nullptr},
+        {&_binary___cast_all_i8_to_i32_o_start, &_binary___cast_all_i8_to_i32_o_end},
+        {&_binary___cast_all_i8_to_i16_o_start, &_binary___cast_all_i8_to_i16_o_end},
+        {nullptr, nullptr},
+        {&_binary___cast_all_i8_to_u8_o_start, &_binary___cast_all_i8_to_u8_o_end}
+    },
+    {
+        {&_binary___cast_all_u8_to_f32_o_start, &_binary___cast_all_u8_to_f32_o_end},
+        {&_binary___cast_all_u8_to_bf16_o_start, &_binary___cast_all_u8_to_bf16_o_end},
+        {nullptr, nullptr},
+        {&_binary___cast_all_u8_to_i32_o_start, &_binary___cast_all_u8_to_i32_o_end},
+        {&_binary___cast_all_u8_to_i16_o_start, &_binary___cast_all_u8_to_i16_o_end},
+        {&_binary___cast_all_u8_to_i8_o_start, &_binary___cast_all_u8_to_i8_o_end},
+        {nullptr, nullptr}
+    }
+};
+
+// the types of the Gaudi pairs, in CastType_t order
+static const CastAllGaudi2::CastType_t c_gaudiTypes[CastAllGaudi::c_typeCount] = {
+    CastAllGaudi2::cast_f32,
+    CastAllGaudi2::cast_bf16,
+    CastAllGaudi2::cast_i32,
+    CastAllGaudi2::cast_i16,
+    CastAllGaudi2::cast_i8,
+    CastAllGaudi2::cast_u8
+};
+
+// position of type in c_gaudiTypes, -1 for f16
+static int GetTypeSlot(CastAllGaudi2::CastType_t type)
+{
+    if (type == CastAllGaudi2::cast_f16)
+        return -1;
+    return type < CastAllGaudi2::cast_f16 ? type : type - 1;
+}
+
+int CastAllGaudi::GetPairIndex(CastType_t src, CastType_t dst)
+{
+    int srcSlot = GetTypeSlot(src);
+    int dstSlot = GetTypeSlot(dst);
+    if (srcSlot < 0 || dstSlot < 0 || src == dst)
+        return -1;
+    return srcSlot * (c_typeCount - 1) + (dstSlot < srcSlot ? dstSlot : dstSlot - 1);
+}
+
+CastAllGaudi2::CastType_t CastAllGaudi::GetPairSrc(int pair)
+{
+    return c_gaudiTypes[pair / (c_typeCount - 1)];
+}
+
+CastAllGaudi2::CastType_t CastAllGaudi::GetPairDst(int pair)
+{
+    int srcSlot = pair / (c_typeCount - 1);
+    int dstSlot = pair % (c_typeCount - 1);
+    return c_gaudiTypes[dstSlot < srcSlot ? dstSlot : dstSlot + 1];
+}
+
+tpc_lib_api::GlueCodeReturn CastAllGaudi::GetKernelName(
+        char kernelName [tpc_lib_api::MAX_NODE_NAME], CastType_t src, CastType_t dst)
+{
+    if (src >= cast_type_count || dst >= cast_type_count || GetPairIndex(src, dst) < 0)
+        return tpc_lib_api::GLUE_NODE_NOT_FOUND;
+    snprintf(kernelName, tpc_lib_api::MAX_NODE_NAME, "custom_cast_all_%s_to_%s",
+             GetTypeName(src), GetTypeName(dst));
+    return tpc_lib_api::GLUE_SUCCESS;
+}
+
+tpc_lib_api::GlueCodeReturn CastAllGaudi::GetGcDefinitions(
+        tpc_lib_api::HabanaKernelParams* in_defs,
+        tpc_lib_api::HabanaKernelInstantiation* out_defs)
+{
+    if (m_src >= cast_type_count || m_dst >= cast_type_count || GetPairIndex(m_src, m_dst) < 0)
+    {
+        return tpc_lib_api::GLUE_NODE_NOT_FOUND;
+    }
+    return CastAllGaudi2::GetGcDefinitions(in_defs, out_defs);
+}
+
+void CastAllGaudi::GetKernelBinary(unsigned char** binary, unsigned* size)
+{
+    *binary = c_castAllBinaries[m_src][m_dst][0];
+    *size = c_castAllBinaries[m_src][m_dst][1] - c_castAllBinaries[m_src][m_dst][0];
+}
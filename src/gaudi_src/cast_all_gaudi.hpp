@@ -0,0 +1,53 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef _CAST_ALL_GAUDI_HPP
+#define _CAST_ALL_GAUDI_HPP
+
+#include "cast_all_gaudi2.hpp"
+
+// Gaudi builds of the any-to-any casts, the glue code is shared with Gaudi2.
+// Gaudi has no f16, its pairs are every (src, dst) of the other six types.
+class CastAllGaudi : public CastAllGaudi2
+{
+public:
+    static const int c_typeCount = cast_type_count - 1;
+    static const int c_pairCount = c_typeCount * (c_typeCount - 1);
+
+    CastAllGaudi(CastType_t src=cast_f32, CastType_t dst=cast_bf16) : CastAllGaudi2(src, dst) {}
+    virtual ~CastAllGaudi() {}
+
+    virtual tpc_lib_api::GlueCodeReturn GetGcDefinitions(
+            tpc_lib_api::HabanaKernelParams* in_defs,
+            tpc_lib_api::HabanaKernelInstantiation* out_defs);
+
+    virtual tpc_lib_api::GlueCodeReturn GetKernelName(
+            char kernelName [tpc_lib_api::MAX_NODE_NAME], CastType_t src, CastType_t dst);
+
+    // position of (src, dst) in the Gaudi pair order, -1 for src == dst or f16
+    static int GetPairIndex(CastType_t src, CastType_t dst);
+    static CastType_t GetPairSrc(int pair);
+    static CastType_t GetPairDst(int pair);
+
+protected:
+    virtual void GetKernelBinary(unsigned char** binary, unsigned* size);
+
+private:
+    CastAllGaudi(const CastAllGaudi& other) = delete;
+    CastAllGaudi& operator=(const CastAllGaudi& other) = delete;
+};
+
+#endif //_CAST_ALL_GAUDI_HPP
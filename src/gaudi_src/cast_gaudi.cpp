@@ -26,6 +26,8 @@ extern unsigned char _binary___cast_bf16_to_f32_o_start;
 extern unsigned char _binary___cast_bf16_to_f32_o_end;
 extern unsigned char _binary___cast_f32_to_bf16_o_start;
 extern unsigned char _binary___cast_f32_to_bf16_o_end;
+extern unsigned char _binary___cast_f32_to_bf16_sr_o_start;
+extern unsigned char _binary___cast_f32_to_bf16_sr_o_end;
 
  tpc_lib_api::GlueCodeReturn CastGaudi::GetKernelName(
              char kernelName [tpc_lib_api::MAX_NODE_NAME],
@@ -42,6 +44,7 @@ tpc_lib_api::GlueCodeReturn CastGaudi::GetGcDefinitions(
 {
     tpc_lib_api::GlueCodeReturn retVal;
     CastParams* def = static_cast<CastParams*>(in_defs->nodeParams.nodeParams);
+    CastSRParams* defSR = static_cast<CastSRParams*>(in_defs->nodeParams.nodeParams);
     /*************************************************************************************
     *   Stage I - validate input
     **************************************************************************************/
@@ -69,7 +72,7 @@ tpc_lib_api::GlueCodeReturn CastGaudi::GetGcDefinitions(
             return tpc_lib_api::GLUE_INCOMPATIBLE_DATA_TYPE;
         }
     }
-    else if (m_mode == 1)
+    else if (m_mode == 1 || m_mode == 2)
     {
         if (in_defs->inputTensors[0].geometry.dataType != tpc_lib_api::DATA_F32 ||
             in_defs->outputTensors[0].geometry.dataType != tpc_lib_api::DATA_BF16)
@@ -159,8 +162,16 @@ tpc_lib_api::GlueCodeReturn CastGaudi::GetGcDefinitions(
     /*************************************************************************************
     *    Stage IV -  define scalar parameters
     **************************************************************************************/
-    out_defs->kernel.paramsNr = sizeof(*def)/ sizeof(int);
-    memcpy(&( out_defs->kernel.scalarParams[0]),def, sizeof(*def));
+    if (m_mode == 2)
+    {
+        out_defs->kernel.paramsNr = sizeof(*defSR)/ sizeof(int);
+        memcpy(&( out_defs->kernel.scalarParams[0]),defSR, sizeof(*defSR));
+    }
+    else
+    {
+        out_defs->kernel.paramsNr = sizeof(*def)/ sizeof(int);
+        memcpy(&( out_defs->kernel.scalarParams[0]),def, sizeof(*def));
+    }
 
     /*************************************************************************************
     *    Stage V -  Load ISA into the descriptor.
@@ -170,6 +181,10 @@ tpc_lib_api::GlueCodeReturn CastGaudi::GetGcDefinitions(
     {
         IsaSize = (&_binary___cast_f32_to_bf16_o_end - &_binary___cast_f32_to_bf16_o_start);
     }
+    else if (m_mode == 2)
+    {
+        IsaSize = (&_binary___cast_f32_to_bf16_sr_o_end - &_binary___cast_f32_to_bf16_sr_o_start);
+    }
     unsigned givenBinarySize = out_defs->kernel.elfSize;
     out_defs->kernel.elfSize = IsaSize;
 
@@ -182,13 +197,20 @@ tpc_lib_api::GlueCodeReturn CastGaudi::GetGcDefinitions(
                     &_binary___cast_bf16_to_f32_o_start,
                     IsaSize);
         }
-        else
+        else if (m_mode == 1)
         {
             // copy binary out
             memcpy (out_defs->kernel.kernelElf ,
                     &_binary___cast_f32_to_bf16_o_start,
                     IsaSize);
         }
+        else
+        {
+            // copy binary out
+            memcpy (out_defs->kernel.kernelElf ,
+                    &_binary___cast_f32_to_bf16_sr_o_start,
+                    IsaSize);
+        }
     }
     else
     {
@@ -29,10 +29,11 @@ public:
     typedef enum _CastBF16DataType_t
     {
         bf16_to_f32,
-        f32_to_bf16
+        f32_to_bf16,
+        f32_to_bf16_sr
     } CastDataType_t;
 
-    char castDataType[2][15] = {"bf16_to_f32", "f32_to_bf16"};
+    char castDataType[3][15] = {"bf16_to_f32", "f32_to_bf16", "f32_to_bf16_sr"};
     CastGaudi(CastDataType_t mode = bf16_to_f32)
     {
         m_mode = mode;
@@ -56,6 +57,13 @@ public:
         float scale;
     };
 
+    // Stochastic rounding mode. The same seed always produces the same output.
+    struct CastSRParams
+    {
+        float scale;
+        uint32_t seed;
+    };
+
 private:
 
     CastDataType_t m_mode;
@@ -0,0 +1,102 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+
+// Reference fp8 formats of Gaudi2: 1 sign bit, EXP_BITS exponent bits and
+// MAN_BITS mantissa bits, IEEE like with the top exponent reserved for
+// inf / NaN. float8_143 (E4M3) tops out at 240, float8_152 (E5M2) at 57344.
+
+inline float fp8MaxValue(int expBits, int manBits)
+{
+    const int bias = (1 << (expBits - 1)) - 1;
+    const int maxExp = (1 << expBits) - 2 - bias;
+    return std::ldexp(2.0f - std::ldexp(1.0f, -manBits), maxExp);
+}
+
+inline float fp8ToFloat(uint8_t a, int expBits, int manBits)
+{
+    const int bias = (1 << (expBits - 1)) - 1;
+    const int exponent = (a >> manBits) & ((1 << expBits) - 1);
+    const int mantissa = a & ((1 << manBits) - 1);
+    const float sign = (a & 0x80) ? -1.0f : 1.0f;
+
+    if (exponent == (1 << expBits) - 1)
+    {
+        return mantissa ? NAN : sign * INFINITY;
+    }
+    if (exponent == 0)
+    {
+        return sign * std::ldexp((float)mantissa, 1 - bias - manBits);
+    }
+    return sign * std::ldexp((float)((1 << manBits) | mantissa), exponent - bias - manBits);
+}
+
+// Round half to even and saturate to the largest finite value, as the TPC
+// cast with SW_RHNE after clamping.
+inline uint8_t floatToFp8(float input, int expBits, int manBits)
+{
+    const int bias = (1 << (expBits - 1)) - 1;
+    const uint8_t sign = std::signbit(input) ? 0x80 : 0;
+    if (std::isnan(input))
+    {
+        return sign | 0x7F;
+    }
+
+    float a = std::min(std::abs(input), fp8MaxValue(expBits, manBits));
+    int exponent = 0;
+    std::frexp(a, &exponent);
+    // below the smallest normal the spacing stays fixed
+    exponent = std::max(exponent - 1, 1 - bias);
+    a = std::nearbyint(std::ldexp(a, manBits - exponent));
+    if (a == 0.0f)
+    {
+        return sign;
+    }
+
+    // rounding may carry into the next binade, re-derive the exponent
+    uint32_t significand = (uint32_t)a;
+    if (significand >> (manBits + 1))
+    {
+        significand >>= 1;
+        exponent++;
+    }
+    const uint32_t biased = (significand >> manBits) ? exponent + bias : 0;
+    return sign | (biased << manBits) | (significand & ((1 << manBits) - 1));
+}
+
+template <int EXP_BITS, int MAN_BITS>
+class float8
+{
+public:
+    float8(float v = 0) {this->val = floatToFp8(v, EXP_BITS, MAN_BITS);}
+
+    static float MaxValue() {return fp8MaxValue(EXP_BITS, MAN_BITS);}
+
+    operator double() const {return fp8ToFloat(val, EXP_BITS, MAN_BITS);}
+    operator float()  const {return fp8ToFloat(val, EXP_BITS, MAN_BITS);}
+
+    uint8_t val;
+};
+
+typedef float8<4, 3> float8_143;
+typedef float8<5, 2> float8_152;
+
+static_assert(sizeof(float8_143) == sizeof(uint8_t), "reinterpret casting to float8 won't work");
@@ -0,0 +1,184 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cmath>
+#include <type_traits>
+#include "activation_all_gaudi2_test.hpp"
+
+typedef ActivationAllGaudi2 Act;
+
+float ActivationAllGaudi2Test::act_fwd_reference(Act::Activation_mode_t mode, float x)
+{
+    if (mode >= Act::silu_fwd_f32 && mode <= Act::swiglu_bwd_bf16)
+    {
+        return x / (1.0f + std::exp(-x));
+    }
+    if (mode >= Act::gelu_erf_fwd_f32 && mode <= Act::gelu_erf_bwd_bf16)
+    {
+        return 0.5f * x * (1.0f + std::erf(x * (float)M_SQRT1_2));
+    }
+    // gelu_tanh and geglu
+    float u = (float)std::sqrt(2.0 / M_PI) * (x + 0.044715f * x * x * x);
+    return 0.5f * x * (1.0f + std::tanh(u));
+}
+
+float ActivationAllGaudi2Test::act_bwd_reference(Act::Activation_mode_t mode, float x)
+{
+    if (mode >= Act::silu_fwd_f32 && mode <= Act::swiglu_bwd_bf16)
+    {
+        float s = 1.0f / (1.0f + std::exp(-x));
+        return s * (1.0f + x * (1.0f - s));
+    }
+    if (mode >= Act::gelu_erf_fwd_f32 && mode <= Act::gelu_erf_bwd_bf16)
+    {
+        float cdf = 0.5f * (1.0f + std::erf(x * (float)M_SQRT1_2));
+        float pdf = std::exp(-0.5f * x * x) / (float)std::sqrt(2.0 * M_PI);
+        return cdf + x * pdf;
+    }
+    float k = (float)std::sqrt(2.0 / M_PI);
+    float t = std::tanh(k * (x + 0.044715f * x * x * x));
+    float du = k * (1.0f + 3.0f * 0.044715f * x * x);
+    return 0.5f * (1.0f + t) + 0.5f * x * (1.0f - t * t) * du;
+}
+
+template <class T>
+void ActivationAllGaudi2Test::activation_reference_implementation(
+        test::Tensor<T,3>& gradOut,
+        test::Tensor<T,3>& ifm,
+        test::Tensor<T,3>& out,
+        Act::Activation_mode_t mode,
+        bool gated, bool backward)
+{
+    const int inLen  = (int)ifm.Size(0);
+    const int outLen = gated ? inLen / 2 : inLen;
+    const int rows   = ifm.ElementCount() / inLen;
+
+    for (int r = 0; r < rows; r++)
+    {
+        for (int c = 0; c < outLen; c++)
+        {
+            float x = (float)ifm.Data()[r * inLen + c];
+            float up = gated ? (float)ifm.Data()[r * inLen + outLen + c] : 1.0f;
+            if (!backward)
+            {
+                out.Data()[r * outLen + c] = (T)(act_fwd_reference(mode, x) * up);
+                continue;
+            }
+
+            // gradOut has the shape of the forward output
+            float dy = (float)gradOut.Data()[r * outLen + c];
+            out.Data()[r * inLen + c] = (T)(dy * up * act_bwd_reference(mode, x));
+            if (gated)
+            {
+                out.Data()[r * inLen + outLen + c] = (T)(dy * act_fwd_reference(mode, x));
+            }
+        }
+    }
+}
+
+template <class T>
+int ActivationAllGaudi2Test::runActivationTest(tpc_lib_api::DeviceId deviceId, Act::Activation_mode_t mode)
+{
+    const bool gated    = mode >= Act::swiglu_fwd_f32;
+    const bool backward = (mode % 4) >= 2;
+    // gated backward needs a vector aligned half, the others use a partial vector
+    const uint64_t halfLen = gated ? 128 : 200;
+    const float tolerance = std::is_same<T, float>::value ? 1e-4f : 2e-2f;
+
+    uint64_t ifmInitializer[] = {gated ? 2 * halfLen : halfLen, 5, 3};
+    uint64_t halfInitializer[] = {halfLen, 5, 3};
+
+    test::Tensor<T,3> ifm(ifmInitializer);
+    ifm.InitRand(-4.0f, 3.0f);
+    test::Tensor<T,3> gradOut(halfInitializer);
+    gradOut.InitRand(-1.0f, 0.0f);
+
+    uint64_t* outInitializer = backward ? ifmInitializer : halfInitializer;
+    test::Tensor<T,3> out(outInitializer);
+    test::Tensor<T,3> out_ref(outInitializer);
+
+    // execute reference implementation of the kernel.
+    activation_reference_implementation<T>(gradOut, ifm, out_ref, mode, gated, backward);
+
+    // generate input for query call
+    m_in_defs.deviceId = deviceId;
+    std::vector<TensorDesc2> vec;
+    m_in_defs.inputTensorNr = 0;
+    if (backward)
+    {
+        LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[m_in_defs.inputTensorNr++]), gradOut);
+        vec.push_back(gradOut.GetTensorDescriptor());
+    }
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[m_in_defs.inputTensorNr++]), ifm);
+    vec.push_back(ifm.GetTensorDescriptor());
+
+    m_in_defs.outputTensorNr = 1;
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[0]), out);
+    vec.push_back(out.GetTensorDescriptor());
+
+    m_in_defs.nodeParams.nodeParams = nullptr;
+
+    tpc_lib_api::GuidInfo *guids = nullptr;
+    unsigned kernelCount = 0;
+    tpc_lib_api::GlueCodeReturn result = GetKernelGuids(deviceId, &kernelCount, guids);
+    guids = new tpc_lib_api::GuidInfo[kernelCount];
+    result = GetKernelGuids(deviceId, &kernelCount, guids);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "Can't get kernel name!! " << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    unsigned kernelIndex = (deviceId == tpc_lib_api::DEVICE_ID_GAUDI3) ?
+            GAUDI3_KERNEL_GELU_TANH_FWD_F32 + mode : GAUDI2_KERNEL_GELU_TANH_FWD_F32 + mode;
+    strcpy(m_in_defs.guid.name, guids[kernelIndex].name);
+    result  = InstantiateTpcKernel(&m_in_defs,&m_out_defs);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "glue test failed!!" << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    // execute a simulation of the kernel using TPC simulator,
+    TestBase::RunSimulation(vec, m_in_defs, m_out_defs);
+
+    for (int element = 0; element < out_ref.ElementCount(); element++)
+    {
+        float a = (float)out.Data()[element];
+        float b = (float)out_ref.Data()[element];
+        if (std::abs(a - b) > tolerance * (1.f + std::abs(b)))
+        {
+            std::cout << m_in_defs.guid.name << " test failed!!" << std::endl;
+            ReleaseKernelNames(guids, kernelCount);
+            return -1;
+        }
+    }
+
+    std::cout << m_in_defs.guid.name << " test pass!!" << std::endl;
+    ReleaseKernelNames(guids, kernelCount);
+    return 0;
+}
+
+int ActivationAllGaudi2Test::runTest(tpc_lib_api::DeviceId deviceId, Act::Activation_mode_t mode)
+{
+    if (mode % 2 == 1)
+    {
+        return runActivationTest<bfloat16>(deviceId, mode);
+    }
+    return runActivationTest<float>(deviceId, mode);
+}
@@ -0,0 +1,54 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef ACTIVATION_ALL_GAUDI2_TEST_HPP
+#define ACTIVATION_ALL_GAUDI2_TEST_HPP
+
+#include "test_base.hpp"
+#include "tensor.h"
+#include "activation_all_gaudi2.hpp"
+#include "entry_points.hpp"
+
+// Covers the Gaudi2 and Gaudi3 builds of the activation kernels.
+class ActivationAllGaudi2Test : public TestBase
+{
+public:
+    ActivationAllGaudi2Test() {}
+    ~ActivationAllGaudi2Test() {}
+    int runTest(tpc_lib_api::DeviceId deviceId, ActivationAllGaudi2::Activation_mode_t mode);
+
+    // y = act(x) or act(gate) * up, dx = dy * act'(x)
+    static float act_fwd_reference(ActivationAllGaudi2::Activation_mode_t mode, float x);
+    static float act_bwd_reference(ActivationAllGaudi2::Activation_mode_t mode, float x);
+
+    template <class T>
+    static void activation_reference_implementation(
+            test::Tensor<T,3>& gradOut,
+            test::Tensor<T,3>& ifm,
+            test::Tensor<T,3>& out,
+            ActivationAllGaudi2::Activation_mode_t mode,
+            bool gated, bool backward);
+
+private:
+    template <class T>
+    int runActivationTest(tpc_lib_api::DeviceId deviceId, ActivationAllGaudi2::Activation_mode_t mode);
+
+    ActivationAllGaudi2Test(const ActivationAllGaudi2Test& other) = delete;
+    ActivationAllGaudi2Test& operator=(const ActivationAllGaudi2Test& other) = delete;
+};
+
+
+#endif /* ACTIVATION_ALL_GAUDI2_TEST_HPP */
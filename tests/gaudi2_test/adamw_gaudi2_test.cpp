@@ -0,0 +1,213 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "adamw_gaudi2_test.hpp"
+
+template <class T>
+void AdamWGaudi2Test::adamw_reference_implementation(
+        test::Tensor<T,1>& grad,
+        float_1DTensor& weights,
+        float_1DTensor& m,
+        float_1DTensor& v,
+        float_1DTensor* chunkDecay,
+        const AdamWGaudi2::AdamWParams& def)
+{
+    const float bc1 = 1.0f - std::pow(def.beta1, (float)def.step);
+    const float bc2 = 1.0f - std::pow(def.beta2, (float)def.step);
+
+    for (int e = 0; e < (int)grad.Size(0); e++)
+    {
+        int coords[1] = {e};
+        float wd = def.weightDecay;
+        if (chunkDecay != nullptr)
+        {
+            int chunkCoords[1] = {e / def.chunkSize};
+            wd *= chunkDecay->ElementAt(chunkCoords);
+        }
+
+        float g  = (float)grad.ElementAt(coords);
+        float mv = def.beta1 * m.ElementAt(coords) + (1.0f - def.beta1) * g;
+        float vv = def.beta2 * v.ElementAt(coords) + (1.0f - def.beta2) * g * g;
+        float w  = weights.ElementAt(coords) * (1.0f - def.lr * wd);
+        w -= def.lr * (mv / bc1) / (std::sqrt(vv / bc2) + def.eps);
+
+        weights.SetElement(coords, w);
+        m.SetElement(coords, mv);
+        v.SetElement(coords, vv);
+    }
+}
+
+template <class T>
+int AdamWGaudi2Test::runAdamWTest(Gaudi2_Kernel_Name_e NameofKernel, bool multiTensor)
+{
+    const bool bf16 = sizeof(T) != sizeof(float);
+
+    AdamWGaudi2::AdamWParams def;
+    def.lr = 1e-3f;
+    def.beta1 = 0.9f;
+    def.beta2 = 0.999f;
+    def.eps = 1e-8f;
+    def.weightDecay = 0.1f;
+    def.step = 10;
+    def.chunkSize = 1024;
+
+    // the last chunk and the single tensor case are not full members
+    const uint64_t elements = multiTensor ? 3 * def.chunkSize + 100 : 1000;
+    const uint64_t numChunks = (elements + def.chunkSize - 1) / def.chunkSize;
+    uint64_t fmInitializer[] = {elements};
+    uint64_t chunkInitializer[] = {numChunks};
+
+    test::Tensor<T,1> grad(fmInitializer);
+    grad.InitRand(-1.0f, 1.0f);
+    float_1DTensor weights(fmInitializer);
+    weights.InitRand(-1.0f, 1.0f);
+    float_1DTensor m(fmInitializer);
+    m.InitRand(-0.1f, 0.1f);
+    float_1DTensor v(fmInitializer);
+    v.InitRand(0.0f, 0.01f);
+
+    // every other chunk is excluded from weight decay
+    float_1DTensor chunkDecay(chunkInitializer);
+    for (int c = 0; c < (int)numChunks; c++)
+    {
+        int coords[1] = {c};
+        chunkDecay.SetElement(coords, (c % 2) ? 0.0f : 1.0f);
+    }
+
+    float_1DTensor weights_out(fmInitializer);
+    float_1DTensor m_out(fmInitializer);
+    float_1DTensor v_out(fmInitializer);
+    test::Tensor<T,1> param_out(fmInitializer);
+
+    float_1DTensor weights_ref(fmInitializer);
+    float_1DTensor m_ref(fmInitializer);
+    float_1DTensor v_ref(fmInitializer);
+    std::copy(weights.Data(), weights.Data() + elements, weights_ref.Data());
+    std::copy(m.Data(), m.Data() + elements, m_ref.Data());
+    std::copy(v.Data(), v.Data() + elements, v_ref.Data());
+
+    // execute reference implementation of the kernel.
+    adamw_reference_implementation<T>(grad, weights_ref, m_ref, v_ref,
+                                      multiTensor ? &chunkDecay : nullptr, def);
+
+    // generate input for query call
+    m_in_defs.deviceId = tpc_lib_api::DEVICE_ID_GAUDI2;
+
+    std::vector<TensorDesc2> vec;
+    unsigned inputNr = 0;
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[inputNr++]), grad);
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[inputNr++]), weights);
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[inputNr++]), m);
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[inputNr++]), v);
+    vec.push_back(grad.GetTensorDescriptor());
+    vec.push_back(weights.GetTensorDescriptor());
+    vec.push_back(m.GetTensorDescriptor());
+    vec.push_back(v.GetTensorDescriptor());
+    if (multiTensor)
+    {
+        LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[inputNr++]), chunkDecay);
+        vec.push_back(chunkDecay.GetTensorDescriptor());
+    }
+    m_in_defs.inputTensorNr = inputNr;
+
+    unsigned outputNr = 0;
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[outputNr++]), weights_out);
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[outputNr++]), m_out);
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[outputNr++]), v_out);
+    vec.push_back(weights_out.GetTensorDescriptor());
+    vec.push_back(m_out.GetTensorDescriptor());
+    vec.push_back(v_out.GetTensorDescriptor());
+    if (bf16)
+    {
+        LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[outputNr++]), param_out);
+        vec.push_back(param_out.GetTensorDescriptor());
+    }
+    m_in_defs.outputTensorNr = outputNr;
+    m_in_defs.nodeParams.nodeParams = &def;
+
+    tpc_lib_api::GuidInfo *guids = nullptr;
+    unsigned kernelCount = 0;
+    tpc_lib_api::GlueCodeReturn result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    guids = new tpc_lib_api::GuidInfo[kernelCount];
+    result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "Can't get kernel name!! " << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    strcpy(m_in_defs.guid.name, guids[NameofKernel].name);
+    result  = InstantiateTpcKernel(&m_in_defs,&m_out_defs);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "glue test failed!!" << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    // execute a simulation of the kernel using TPC simulator,
+    TestBase::RunSimulation(vec, m_in_defs, m_out_defs);
+
+    bool passed = true;
+    for (int element = 0; element < (int)elements; element++)
+    {
+        float ref = weights_ref.Data()[element];
+        if (std::abs(weights_out.Data()[element] - ref) > 1e-5f * std::max(1.0f, std::abs(ref)) ||
+            std::abs(m_out.Data()[element] - m_ref.Data()[element]) > 1e-6f ||
+            std::abs(v_out.Data()[element] - v_ref.Data()[element]) > 1e-6f)
+        {
+            passed = false;
+        }
+        // the bf16 params are the rounded master weights
+        if (bf16 && std::abs((float)param_out.Data()[element] - ref) > 1e-2f * std::abs(ref) + 1e-6f)
+        {
+            passed = false;
+        }
+    }
+
+    if (!passed)
+    {
+        std::cout << m_in_defs.guid.name << " test failed!!" << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    std::cout << m_in_defs.guid.name << " test pass!!" << std::endl;
+    ReleaseKernelNames(guids, kernelCount);
+    return 0;
+}
+
+int AdamWGaudi2Test::runTest(Gaudi2_Kernel_Name_e NameofKernel)
+{
+    switch (NameofKernel)
+    {
+        case GAUDI2_KERNEL_ADAMW_F32:
+            return runAdamWTest<float>(NameofKernel, false);
+        case GAUDI2_KERNEL_ADAMW_BF16:
+            return runAdamWTest<bfloat16>(NameofKernel, false);
+        case GAUDI2_KERNEL_ADAMW_MULTI_F32:
+            return runAdamWTest<float>(NameofKernel, true);
+        case GAUDI2_KERNEL_ADAMW_MULTI_BF16:
+            return runAdamWTest<bfloat16>(NameofKernel, true);
+        default:
+            std::cout << "Unsupported AdamW kernel " << NameofKernel << std::endl;
+            return -1;
+    }
+}
@@ -0,0 +1,51 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef ADAMW_GAUDI2_TEST_HPP
+#define ADAMW_GAUDI2_TEST_HPP
+
+#include "test_base.hpp"
+#include "tensor.h"
+#include "adamw_gaudi2.hpp"
+#include "entry_points.hpp"
+
+class AdamWGaudi2Test : public TestBase
+{
+public:
+    AdamWGaudi2Test() {}
+    ~AdamWGaudi2Test() {}
+    int runTest(Gaudi2_Kernel_Name_e NameofKernel);
+
+    // in-place AdamW step, chunkDecay is null for the single tensor modes
+    template <class T>
+    static void adamw_reference_implementation(
+            test::Tensor<T,1>& grad,
+            float_1DTensor& weights,
+            float_1DTensor& m,
+            float_1DTensor& v,
+            float_1DTensor* chunkDecay,
+            const AdamWGaudi2::AdamWParams& def);
+
+private:
+    template <class T>
+    int runAdamWTest(Gaudi2_Kernel_Name_e NameofKernel, bool multiTensor);
+
+    AdamWGaudi2Test(const AdamWGaudi2Test& other) = delete;
+    AdamWGaudi2Test& operator=(const AdamWGaudi2Test& other) = delete;
+};
+
+
+#endif /* ADAMW_GAUDI2_TEST_HPP */
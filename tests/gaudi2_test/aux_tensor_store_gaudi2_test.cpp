@@ -0,0 +1,203 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cmath>
+#include <cstring>
+#include <map>
+#include "aux_tensor_store_gaudi2_test.hpp"
+#include "avg_pool_2d_f32_gaudi2.hpp"
+#include "piecewise_poly_gaudi2.hpp"
+
+static double sigmoid(double x) { return 1.0 / (1.0 + exp(-x)); }
+static double tanhRef(double x) { return tanh(x); }
+
+tpc_lib_api::GlueCodeReturn AuxTensorStoreGaudi2Test::instantiate(
+        Gaudi2_Kernel_Name_e kernel, std::vector<float>& aux)
+{
+    tpc_lib_api::GuidInfo *guids = nullptr;
+    unsigned kernelCount = 0;
+    tpc_lib_api::GlueCodeReturn result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    guids = new tpc_lib_api::GuidInfo[kernelCount];
+    result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        ReleaseKernelNames(guids, kernelCount);
+        return result;
+    }
+    strcpy(m_in_defs.guid.name, guids[kernel].name);
+    ReleaseKernelNames(guids, kernelCount);
+
+    m_out_defs.kernel.elfSize = c_default_isa_buffer_size;
+    result  = InstantiateTpcKernel(&m_in_defs,&m_out_defs);
+    // Allocate memory for aux tensor if not allocated
+    if (result == tpc_lib_api::GLUE_INSUFFICIENT_AUX_BUFFER_SIZE)
+    {
+        if (m_out_defs.auxiliaryTensors[0].pData)
+        {
+            delete [] (int8_t*)m_out_defs.auxiliaryTensors[0].pData;
+            m_out_defs.auxiliaryTensors[0].pData = NULL;
+        }
+
+        m_out_defs.auxiliaryTensors[0].pData =
+                                    new float[m_out_defs.auxiliaryTensors[0].bufferSize / sizeof(float)];
+        // second call of glue-code to load Auxiliary data.
+        m_out_defs.kernel.elfSize = c_default_isa_buffer_size;
+        result  = InstantiateTpcKernel(&m_in_defs,&m_out_defs);
+    }
+    if (result == tpc_lib_api::GLUE_SUCCESS)
+    {
+        const float* data = (const float*)m_out_defs.auxiliaryTensors[0].pData;
+        aux.assign(data, data + m_out_defs.auxiliaryTensors[0].geometry.maxSizes[0]);
+    }
+    return result;
+}
+
+int AuxTensorStoreGaudi2Test::runTest()
+{
+    // node n is an avg pool with a 2x2, 3x3 or 4x4 window, a user lut or a
+    // piecewise poly with one of two fits, 6 distinct tables in all
+    const int c_nodeCount = 48;
+    const int c_distinctTables = 6;
+
+    PiecewisePolyGaudi2::PiecewisePolyParams fits[2];
+    if (PiecewisePolyGaudi2::FitFunction(tanhRef, -4.0f, 4.0f, 16, 3, &fits[0], nullptr) != tpc_lib_api::GLUE_SUCCESS ||
+        PiecewisePolyGaudi2::FitFunction(sigmoid, -8.0f, 8.0f, 32, 2, &fits[1], nullptr) != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "piecewise poly fit failed!!" << std::endl;
+        return -1;
+    }
+
+    AuxTensorStore::Clear();
+    std::map<int, std::vector<float> > firstTables;
+    for (int node = 0; node < c_nodeCount; node++)
+    {
+        const int type = node % 3;
+        const int variant = (node / 3) % (type == 0 ? 3 : 2);
+        const int table = type == 0 ? variant : type == 1 ? 3 : 4 + variant;
+        std::vector<float> aux;
+        tpc_lib_api::GlueCodeReturn result;
+
+        m_in_defs.deviceId = tpc_lib_api::DEVICE_ID_GAUDI2;
+        if (type == 0)
+        {
+            const int window = 2 + variant;
+            AvgPool2dF32Gaudi2::AvgPool2DParam def;
+            memset(&def, 0, sizeof(def));
+            def.srdef.pad_w = 1;
+            def.srdef.pad_h = 1;
+            def.srdef.kernel_h = window;
+            def.srdef.kernel_w = window;
+            def.srdef.stride_h = 1;
+            def.srdef.stride_w = 1;
+            def.srdef.dilation_w = 1;
+            def.srdef.dilation_h = 1;
+            def.include_pads = 1;
+            def.numTpc = 8;
+            def.invNumTpc = 1.0 / 8.0;
+
+            const unsigned ofmSize = 5 + 1 - window;
+            uint64_t ifmInitializer[] = {100, 5, 5, 5};
+            uint64_t ofmInitializer[] = {100, ofmSize, ofmSize, 5};
+            float_4DTensor ifm(ifmInitializer);
+            float_4DTensor ofm(ofmInitializer);
+            int32_1DTensor validCountfm;
+            validCountfm.Init({1});
+
+            m_in_defs.nodeParams.nodeParams = &def;
+            m_in_defs.inputTensorNr = 2;
+            LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[0]), ifm);
+            LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[1]), validCountfm);
+            m_in_defs.outputTensorNr = 1;
+            LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[0]), ofm);
+            result = instantiate(GAUDI2_KERNEL_AVG_POOL_2D_FWD_F32, aux);
+
+            // the table itself, 1/i with 0 at 0
+            for (size_t i = 0; result == tpc_lib_api::GLUE_SUCCESS && i < aux.size(); i++)
+            {
+                if (aux[i] != (i == 0 ? 0.0f : (float)(1.0 / i)))
+                {
+                    std::cout << "reciprocal_tab entry " << i << " is " << aux[i] << ", test failed!!" << std::endl;
+                    return -1;
+                }
+            }
+        }
+        else if (type == 1)
+        {
+            uint64_t fmInitializer[] = {64, 1, 1, 1, 1};
+            float_1DTensor input0(fmInitializer);
+            float_1DTensor input1(fmInitializer);
+            float_1DTensor output(fmInitializer);
+
+            m_in_defs.nodeParams.nodeParams = nullptr;
+            m_in_defs.inputTensorNr = 2;
+            LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[0]), input0);
+            LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[1]), input1);
+            m_in_defs.outputTensorNr = 1;
+            LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[0]), output);
+            result = instantiate(GAUDI2_KERNEL_USER_LUT, aux);
+        }
+        else
+        {
+            uint64_t fmInitializer[] = {256, 4, 1, 1, 1};
+            float_5DTensor input(fmInitializer);
+            float_5DTensor output(fmInitializer);
+
+            m_in_defs.nodeParams.nodeParams = &fits[variant];
+            m_in_defs.inputTensorNr = 1;
+            LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[0]), input);
+            m_in_defs.outputTensorNr = 1;
+            LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[0]), output);
+            result = instantiate(GAUDI2_KERNEL_PIECEWISE_POLY_F32, aux);
+        }
+
+        if (result != tpc_lib_api::GLUE_SUCCESS)
+        {
+            std::cout << "glue test failed at node " << node << "!!" << result << std::endl;
+            return -1;
+        }
+
+        // every later node with the same table must get the bytes of the first
+        if (firstTables.count(table) == 0)
+        {
+            firstTables[table] = aux;
+        }
+        else if (firstTables[table] != aux)
+        {
+            std::cout << "aux tensor of node " << node << " differs from the first one, test failed!!" << std::endl;
+            return -1;
+        }
+    }
+
+    if (m_out_defs.auxiliaryTensors[0].pData)
+    {
+        delete [] (int8_t*)m_out_defs.auxiliaryTensors[0].pData;
+        m_out_defs.auxiliaryTensors[0].pData = NULL;
+    }
+
+    const AuxTensorStore::Stats stats = AuxTensorStore::GetStats();
+    std::cout << "aux tensor store: " << c_nodeCount << " nodes, " << stats.misses << " generated, "
+              << stats.hits << " reused, " << stats.bytesStored << " bytes stored, "
+              << stats.bytesNotRegenerated << " bytes not regenerated, " << stats.bytesDeduplicated
+              << " bytes deduplicated, " << stats.generationUs << " us generating, "
+              << stats.generationUsAvoided << " us avoided" << std::endl;
+    if (stats.misses != (uint64_t)c_distinctTables || stats.hits != (uint64_t)(c_nodeCount - c_distinctTables))
+    {
+        std::cout << "aux tensor store test failed!!" << std::endl;
+        return -1;
+    }
+    std::cout << "aux tensor store test pass!!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,45 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef AUX_TENSOR_STORE_GAUDI2_TEST_HPP
+#define AUX_TENSOR_STORE_GAUDI2_TEST_HPP
+
+#include <vector>
+#include "test_base.hpp"
+#include "tensor.h"
+#include "aux_tensor_store.hpp"
+#include "entry_points.hpp"
+
+// Instantiates a graph of avg pool, user lut and piecewise poly nodes that
+// repeat a few aux tables, checks that every node gets the right table and
+// reports what the store saved. Glue only, nothing is simulated.
+class AuxTensorStoreGaudi2Test : public TestBase
+{
+public:
+    AuxTensorStoreGaudi2Test() {}
+    ~AuxTensorStoreGaudi2Test() {}
+    int runTest();
+
+private:
+    // instantiate the node set up in m_in_defs, aux gets its aux tensor
+    tpc_lib_api::GlueCodeReturn instantiate(Gaudi2_Kernel_Name_e kernel, std::vector<float>& aux);
+
+    AuxTensorStoreGaudi2Test(const AuxTensorStoreGaudi2Test& other) = delete;
+    AuxTensorStoreGaudi2Test& operator=(const AuxTensorStoreGaudi2Test& other) = delete;
+};
+
+
+#endif /* AUX_TENSOR_STORE_GAUDI2_TEST_HPP */
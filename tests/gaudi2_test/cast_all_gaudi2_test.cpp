@@ -0,0 +1,235 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <algorithm>
+#include "cast_all_gaudi2_test.hpp"
+
+typedef CastAllGaudi2 CastAll;
+
+// Every source type converts to f32 exactly for the values used here, the
+// kernel's only rounding is the one into the destination type.
+static float castToF32(float x)    { return x; }
+static float castToF32(bfloat16 x) { return bf16ToFloat(x.val); }
+static float castToF32(float16 x)  { return float16ToFP32(x); }
+template <class T>
+static float castToF32(T x)        { return (float)x; }
+
+// Integer types: round half to even, saturated, NaN to 0.
+template <class T>
+static T castFromF32(float x)
+{
+    if (std::isnan(x))
+    {
+        return 0;
+    }
+    double v = std::min(std::max((double)x, (double)std::numeric_limits<T>::min()),
+                        (double)std::numeric_limits<T>::max());
+    return (T)std::nearbyint(v);
+}
+
+template <>
+float castFromF32<float>(float x)
+{
+    return x;
+}
+
+// round half to even, bfloat16(float) rounds half away from zero
+template <>
+bfloat16 castFromF32<bfloat16>(float x)
+{
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    bfloat16 out;
+    if (std::isnan(x) || std::isinf(x))
+    {
+        out.val = (uint16_t)(bits >> 16);
+    }
+    else
+    {
+        out.val = (uint16_t)((bits + 0x7fff + ((bits >> 16) & 1)) >> 16);
+    }
+    return out;
+}
+
+template <>
+float16 castFromF32<float16>(float x)
+{
+    float16 out;
+    out.val = fp32_to_fp16(x, RND_TO_NE);
+    return out;
+}
+
+template <class S, class D>
+void CastAllGaudi2Test::cast_all_reference_implementation(
+        test::Tensor<S,3>& ifm,
+        test::Tensor<D,3>& ofm)
+{
+    for (int element = 0; element < ifm.ElementCount(); element++)
+    {
+        ofm.Data()[element] = castFromF32<D>(castToF32(ifm.Data()[element]));
+    }
+}
+
+template <class S, class D>
+int CastAllGaudi2Test::runPair(tpc_lib_api::DeviceId deviceId, CastAll::CastType_t src,
+                               CastAll::CastType_t dst)
+{
+    // dim 0 ends in a partial vector
+    uint64_t fmInitializer[] = {300, 3, 2};
+
+    // Fractions within +-185, every 5th element a tie and every 7th scaled
+    // past the 8 and 16 bit integer ranges but within f16. The values are
+    // made representable in the source type first.
+    test::Tensor<S,3> ifm(fmInitializer);
+    for (int element = 0; element < ifm.ElementCount(); element++)
+    {
+        float x = ((element * 37) % 1001 - 500) * 0.37f;
+        if (element % 5 == 0)
+        {
+            x = (float)((element % 21) - 10) + 0.5f;
+        }
+        if (element % 7 == 0)
+        {
+            x *= 300.0f;
+        }
+        ifm.Data()[element] = castFromF32<S>(x);
+    }
+
+    // Integer destinations of a float source also get values past 2^31 and
+    // the non finite ones, f16 takes the large ones to inf.
+    if (std::numeric_limits<D>::is_integer && !std::numeric_limits<S>::is_integer)
+    {
+        const float specials[] = {2147483648.0f, 3.0e9f, -3.0e9f,
+                                  std::numeric_limits<float>::infinity(),
+                                  -std::numeric_limits<float>::infinity(),
+                                  std::numeric_limits<float>::quiet_NaN()};
+        for (unsigned i = 0; i < sizeof(specials) / sizeof(specials[0]); i++)
+        {
+            ifm.Data()[1 + i] = castFromF32<S>(specials[i]);
+        }
+    }
+
+    test::Tensor<D,3> ofm(fmInitializer);
+    test::Tensor<D,3> ofm_ref(fmInitializer);
+
+    // execute reference implementation of the kernel.
+    cast_all_reference_implementation<S, D>(ifm, ofm_ref);
+
+    // generate input for query call
+    m_in_defs.deviceId = deviceId;
+    m_in_defs.nodeParams.nodeParams = nullptr;
+    m_in_defs.inputTensorNr = 1;
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[0]), ifm);
+    m_in_defs.outputTensorNr = 1;
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[0]), ofm);
+
+    tpc_lib_api::GuidInfo *guids = nullptr;
+    unsigned kernelCount = 0;
+    tpc_lib_api::GlueCodeReturn result = GetKernelGuids(deviceId, &kernelCount, guids);
+    guids = new tpc_lib_api::GuidInfo[kernelCount];
+    result = GetKernelGuids(deviceId, &kernelCount, guids);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "Can't get kernel name!! " << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    unsigned kernelIndex = GAUDI2_KERNEL_CAST_ALL_FIRST + CastAll::GetPairIndex(src, dst);
+    if (deviceId == tpc_lib_api::DEVICE_ID_GAUDI)
+    {
+        kernelIndex = GAUDI_KERNEL_CAST_ALL_FIRST + CastAllGaudi::GetPairIndex(src, dst);
+    }
+    else if (deviceId == tpc_lib_api::DEVICE_ID_GAUDI3)
+    {
+        kernelIndex = GAUDI3_KERNEL_CAST_ALL_FIRST + CastAll::GetPairIndex(src, dst);
+    }
+    strcpy(m_in_defs.guid.name, guids[kernelIndex].name);
+    result  = InstantiateTpcKernel(&m_in_defs,&m_out_defs);
+    ReleaseKernelNames(guids, kernelCount);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "glue test failed!!" << result << std::endl;
+        return -1;
+    }
+
+    // generate and load tensor descriptors
+    std::vector<TensorDesc2> vec;
+    vec.push_back(ifm.GetTensorDescriptor());
+    vec.push_back(ofm.GetTensorDescriptor());
+
+    // execute a simulation of the kernel using TPC simulator,
+    TestBase::RunSimulation(vec, m_in_defs, m_out_defs);
+
+    // single rounding on both sides, the results match bit for bit
+    for (int element = 0; element < ofm_ref.ElementCount(); element++)
+    {
+        if (memcmp(&ofm.Data()[element], &ofm_ref.Data()[element], sizeof(D)) != 0)
+        {
+            std::cout << m_in_defs.guid.name << " test failed at element " << element << "!!" << std::endl;
+            return -1;
+        }
+    }
+
+    std::cout << m_in_defs.guid.name << " test pass!!" << std::endl;
+    return 0;
+}
+
+template <class S>
+int CastAllGaudi2Test::runSrc(tpc_lib_api::DeviceId deviceId, CastAll::CastType_t src,
+                              CastAll::CastType_t dst)
+{
+    switch (dst)
+    {
+        case CastAll::cast_f32:  return runPair<S, float>(deviceId, src, dst);
+        case CastAll::cast_bf16: return runPair<S, bfloat16>(deviceId, src, dst);
+        case CastAll::cast_f16:  return runPair<S, float16>(deviceId, src, dst);
+        case CastAll::cast_i32:  return runPair<S, int32_t>(deviceId, src, dst);
+        case CastAll::cast_i16:  return runPair<S, int16_t>(deviceId, src, dst);
+        case CastAll::cast_i8:   return runPair<S, int8_t>(deviceId, src, dst);
+        case CastAll::cast_u8:   return runPair<S, uint8_t>(deviceId, src, dst);
+        default:
+            std::cout << "Unsupported cast type " << dst << std::endl;
+            return -1;
+    }
+}
+
+int CastAllGaudi2Test::runTest(tpc_lib_api::DeviceId deviceId, CastAll::CastType_t src,
+                               CastAll::CastType_t dst)
+{
+    if (src == dst)
+    {
+        std::cout << "No cast from a type to itself" << std::endl;
+        return -1;
+    }
+
+    switch (src)
+    {
+        case CastAll::cast_f32:  return runSrc<float>(deviceId, src, dst);
+        case CastAll::cast_bf16: return runSrc<bfloat16>(deviceId, src, dst);
+        case CastAll::cast_f16:  return runSrc<float16>(deviceId, src, dst);
+        case CastAll::cast_i32:  return runSrc<int32_t>(deviceId, src, dst);
+        case CastAll::cast_i16:  return runSrc<int16_t>(deviceId, src, dst);
+        case CastAll::cast_i8:   return runSrc<int8_t>(deviceId, src, dst);
+        case CastAll::cast_u8:   return runSrc<uint8_t>(deviceId, src, dst);
+        default:
+            std::cout << "Unsupported cast type " << src << std::endl;
+            return -1;
+    }
+}
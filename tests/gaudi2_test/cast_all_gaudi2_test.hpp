@@ -0,0 +1,54 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef CAST_ALL_GAUDI2_TEST_HPP
+#define CAST_ALL_GAUDI2_TEST_HPP
+
+#include "test_base.hpp"
+#include "tensor.h"
+#include "cast_all_gaudi2.hpp"
+#include "cast_all_gaudi.hpp"
+#include "entry_points.hpp"
+
+// Runs one (src, dst) pair of the any-to-any casts on Gaudi, Gaudi2 or
+// Gaudi3, the glue code is shared.
+class CastAllGaudi2Test : public TestBase
+{
+public:
+    CastAllGaudi2Test() {}
+    ~CastAllGaudi2Test() {}
+    int runTest(tpc_lib_api::DeviceId deviceId, CastAllGaudi2::CastType_t src,
+                CastAllGaudi2::CastType_t dst);
+
+    template <class S, class D>
+    static void cast_all_reference_implementation(
+            test::Tensor<S,3>& ifm,
+            test::Tensor<D,3>& ofm);
+
+private:
+    template <class S>
+    int runSrc(tpc_lib_api::DeviceId deviceId, CastAllGaudi2::CastType_t src,
+               CastAllGaudi2::CastType_t dst);
+    template <class S, class D>
+    int runPair(tpc_lib_api::DeviceId deviceId, CastAllGaudi2::CastType_t src,
+                CastAllGaudi2::CastType_t dst);
+
+    CastAllGaudi2Test(const CastAllGaudi2Test& other) = delete;
+    CastAllGaudi2Test& operator=(const CastAllGaudi2Test& other) = delete;
+};
+
+
+#endif /* CAST_ALL_GAUDI2_TEST_HPP */
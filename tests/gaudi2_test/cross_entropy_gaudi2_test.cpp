@@ -0,0 +1,259 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "cross_entropy_gaudi2_test.hpp"
+
+template <class T>
+void CrossEntropyGaudi2Test::cross_entropy_fwd_reference_implementation(
+        test::Tensor<T,2>& logits,
+        int32_1DTensor& targets,
+        float_1DTensor& loss,
+        float_1DTensor& lse,
+        CrossEntropyGaudi2::CrossEntropy_reduction_t reduction)
+{
+    const int classes = (int)logits.Size(0);
+    const int rows    = (int)logits.Size(1);
+    float total = 0.0f;
+
+    for (int n = 0; n < rows; n++)
+    {
+        int coords[2] = {0, n};
+        float maxVal = -INFINITY;
+        for (int c = 0; c < classes; c++)
+        {
+            coords[0] = c;
+            maxVal = std::max(maxVal, (float)logits.ElementAt(coords));
+        }
+        float sum = 0.0f;
+        for (int c = 0; c < classes; c++)
+        {
+            coords[0] = c;
+            sum += std::exp((float)logits.ElementAt(coords) - maxVal);
+        }
+        float rowLse = maxVal + std::log(sum);
+
+        int rowCoords[1] = {n};
+        coords[0] = targets.ElementAt(rowCoords);
+        float rowLoss = rowLse - (float)logits.ElementAt(coords);
+
+        lse.SetElement(rowCoords, rowLse);
+        if (reduction == CrossEntropyGaudi2::reduction_none)
+        {
+            loss.SetElement(rowCoords, rowLoss);
+        }
+        total += rowLoss;
+    }
+
+    if (reduction != CrossEntropyGaudi2::reduction_none)
+    {
+        int coords[1] = {0};
+        loss.SetElement(coords, reduction == CrossEntropyGaudi2::reduction_mean ? total / rows : total);
+    }
+}
+
+template <class T>
+void CrossEntropyGaudi2Test::cross_entropy_bwd_reference_implementation(
+        test::Tensor<T,2>& logits,
+        int32_1DTensor& targets,
+        float_1DTensor& lse,
+        float_1DTensor& gradLoss,
+        test::Tensor<T,2>& gradLogits,
+        CrossEntropyGaudi2::CrossEntropy_reduction_t reduction)
+{
+    const int classes = (int)logits.Size(0);
+    const int rows    = (int)logits.Size(1);
+    const float scale = (reduction == CrossEntropyGaudi2::reduction_mean) ? 1.0f / rows : 1.0f;
+
+    for (int n = 0; n < rows; n++)
+    {
+        int rowCoords[1] = {n};
+        int gradCoords[1] = {reduction == CrossEntropyGaudi2::reduction_none ? n : 0};
+        const float g = gradLoss.ElementAt(gradCoords) * scale;
+        const int target = targets.ElementAt(rowCoords);
+        const float rowLse = lse.ElementAt(rowCoords);
+
+        for (int c = 0; c < classes; c++)
+        {
+            int coords[2] = {c, n};
+            float prob = std::exp((float)logits.ElementAt(coords) - rowLse);
+            if (c == target)
+            {
+                prob -= 1.0f;
+            }
+            gradLogits.SetElement(coords, (T)(prob * g));
+        }
+    }
+}
+
+template <class T>
+int CrossEntropyGaudi2Test::runCrossEntropyTest(
+        Gaudi2_Kernel_Name_e NameofKernel,
+        CrossEntropyGaudi2::CrossEntropy_reduction_t reduction,
+        bool backward)
+{
+    // a vocabulary that is not a multiple of the vector size covers the row tail
+    const uint64_t classes = 1000;
+    const uint64_t rows    = 16;
+    const bool reduce = reduction != CrossEntropyGaudi2::reduction_none;
+
+    CrossEntropyGaudi2::CrossEntropyParams def;
+    def.reduction = reduction;
+
+    uint64_t logitsInitializer[] = {classes, rows};
+    uint64_t rowInitializer[] = {rows};
+    uint64_t lossInitializer[] = {reduce ? 1 : rows};
+
+    test::Tensor<T,2> logits(logitsInitializer);
+    logits.InitRand(-10.0f, 10.0f);
+    int32_1DTensor targets(rowInitializer);
+    targets.InitRand(0, classes - 1);
+
+    // the forward pass accumulates a reduced loss into a zeroed tensor
+    float_1DTensor loss(lossInitializer);
+    float_1DTensor loss_ref(lossInitializer);
+    float_1DTensor lse(rowInitializer);
+    float_1DTensor lse_ref(rowInitializer);
+    cross_entropy_fwd_reference_implementation<T>(logits, targets, loss_ref, lse_ref, reduction);
+
+    float_1DTensor gradLoss(lossInitializer);
+    gradLoss.InitRand(0.5f, 1.5f);
+    test::Tensor<T,2> gradLogits(logitsInitializer);
+    test::Tensor<T,2> gradLogits_ref(logitsInitializer);
+    if (backward)
+    {
+        cross_entropy_bwd_reference_implementation<T>(logits, targets, lse_ref, gradLoss,
+                                                      gradLogits_ref, reduction);
+    }
+
+    // generate input for query call
+    m_in_defs.deviceId = tpc_lib_api::DEVICE_ID_GAUDI2;
+
+    std::vector<TensorDesc2> vec;
+    vec.push_back(logits.GetTensorDescriptor());
+    vec.push_back(targets.GetTensorDescriptor());
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[0]), logits);
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[1]), targets);
+    if (backward)
+    {
+        m_in_defs.inputTensorNr = 4;
+        LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[2]), lse_ref);
+        LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[3]), gradLoss);
+        m_in_defs.outputTensorNr = 1;
+        LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[0]), gradLogits);
+        vec.push_back(lse_ref.GetTensorDescriptor());
+        vec.push_back(gradLoss.GetTensorDescriptor());
+        vec.push_back(gradLogits.GetTensorDescriptor());
+    }
+    else
+    {
+        m_in_defs.inputTensorNr = 2;
+        m_in_defs.outputTensorNr = 2;
+        LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[0]), loss);
+        LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[1]), lse);
+        vec.push_back(loss.GetTensorDescriptor());
+        vec.push_back(lse.GetTensorDescriptor());
+    }
+    m_in_defs.nodeParams.nodeParams = &def;
+
+    tpc_lib_api::GuidInfo *guids = nullptr;
+    unsigned kernelCount = 0;
+    tpc_lib_api::GlueCodeReturn result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    guids = new tpc_lib_api::GuidInfo[kernelCount];
+    result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "Can't get kernel name!! " << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    strcpy(m_in_defs.guid.name, guids[NameofKernel].name);
+    result  = InstantiateTpcKernel(&m_in_defs,&m_out_defs);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "glue test failed!!" << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    // execute a simulation of the kernel using TPC simulator,
+    TestBase::RunSimulation(vec, m_in_defs, m_out_defs);
+
+    bool passed = true;
+    if (backward)
+    {
+        const float tolerance = sizeof(T) == sizeof(float) ? 1e-5f : 1e-2f;
+        for (int element = 0; element < gradLogits_ref.ElementCount(); element++)
+        {
+            if (std::abs((float)gradLogits.Data()[element] - (float)gradLogits_ref.Data()[element]) > tolerance)
+            {
+                passed = false;
+            }
+        }
+    }
+    else
+    {
+        // the losses are f32 for both data types, only the summation order differs
+        for (int element = 0; element < lse_ref.ElementCount(); element++)
+        {
+            if (std::abs(lse.Data()[element] - lse_ref.Data()[element]) > 1e-3f)
+            {
+                passed = false;
+            }
+        }
+        for (int element = 0; element < loss_ref.ElementCount(); element++)
+        {
+            float tolerance = 1e-3f * std::max(1.0f, std::abs(loss_ref.Data()[element]));
+            if (std::abs(loss.Data()[element] - loss_ref.Data()[element]) > tolerance)
+            {
+                passed = false;
+            }
+        }
+    }
+
+    if (!passed)
+    {
+        std::cout << m_in_defs.guid.name << " test failed!!" << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    std::cout << m_in_defs.guid.name << " test pass!!" << std::endl;
+    ReleaseKernelNames(guids, kernelCount);
+    return 0;
+}
+
+int CrossEntropyGaudi2Test::runTest(Gaudi2_Kernel_Name_e NameofKernel,
+                                    CrossEntropyGaudi2::CrossEntropy_reduction_t reduction)
+{
+    switch (NameofKernel)
+    {
+        case GAUDI2_KERNEL_CROSS_ENTROPY_FWD_F32:
+            return runCrossEntropyTest<float>(NameofKernel, reduction, false);
+        case GAUDI2_KERNEL_CROSS_ENTROPY_FWD_BF16:
+            return runCrossEntropyTest<bfloat16>(NameofKernel, reduction, false);
+        case GAUDI2_KERNEL_CROSS_ENTROPY_BWD_F32:
+            return runCrossEntropyTest<float>(NameofKernel, reduction, true);
+        case GAUDI2_KERNEL_CROSS_ENTROPY_BWD_BF16:
+            return runCrossEntropyTest<bfloat16>(NameofKernel, reduction, true);
+        default:
+            std::cout << "Unsupported cross-entropy kernel " << NameofKernel << std::endl;
+            return -1;
+    }
+}
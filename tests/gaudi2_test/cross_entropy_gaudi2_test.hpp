@@ -0,0 +1,62 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef CROSS_ENTROPY_GAUDI2_TEST_HPP
+#define CROSS_ENTROPY_GAUDI2_TEST_HPP
+
+#include "test_base.hpp"
+#include "tensor.h"
+#include "cross_entropy_gaudi2.hpp"
+#include "entry_points.hpp"
+
+class CrossEntropyGaudi2Test : public TestBase
+{
+public:
+    CrossEntropyGaudi2Test() {}
+    ~CrossEntropyGaudi2Test() {}
+    int runTest(Gaudi2_Kernel_Name_e NameofKernel,
+                CrossEntropyGaudi2::CrossEntropy_reduction_t reduction);
+
+    // lse and per row loss, loss[0] holds the mean/sum when reduced
+    template <class T>
+    static void cross_entropy_fwd_reference_implementation(
+            test::Tensor<T,2>& logits,
+            int32_1DTensor& targets,
+            float_1DTensor& loss,
+            float_1DTensor& lse,
+            CrossEntropyGaudi2::CrossEntropy_reduction_t reduction);
+
+    template <class T>
+    static void cross_entropy_bwd_reference_implementation(
+            test::Tensor<T,2>& logits,
+            int32_1DTensor& targets,
+            float_1DTensor& lse,
+            float_1DTensor& gradLoss,
+            test::Tensor<T,2>& gradLogits,
+            CrossEntropyGaudi2::CrossEntropy_reduction_t reduction);
+
+private:
+    template <class T>
+    int runCrossEntropyTest(Gaudi2_Kernel_Name_e NameofKernel,
+                            CrossEntropyGaudi2::CrossEntropy_reduction_t reduction,
+                            bool backward);
+
+    CrossEntropyGaudi2Test(const CrossEntropyGaudi2Test& other) = delete;
+    CrossEntropyGaudi2Test& operator=(const CrossEntropyGaudi2Test& other) = delete;
+};
+
+
+#endif /* CROSS_ENTROPY_GAUDI2_TEST_HPP */
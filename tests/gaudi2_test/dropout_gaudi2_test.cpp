@@ -0,0 +1,169 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include "dropout_gaudi2_test.hpp"
+
+typedef DropoutGaudi2 Dropout;
+
+// Same generator as kernels/include/counter_rng.h
+static uint32_t hash_u32(uint32_t a)
+{
+    a = (a + 0x7ed55d16) + (a << 12);
+    a = (a ^ 0xc761c23c) ^ (a >> 19);
+    a = (a + 0x165667b1) + (a << 5);
+    a = (a + 0xd3a2646c) ^ (a << 9);
+    a = (a + 0xfd7046c5) + (a << 3);
+    a = (a ^ 0xb55a4f09) ^ (a >> 16);
+    return a;
+}
+
+static uint32_t rng_u32(uint32_t counter, uint32_t key)
+{
+    uint32_t x = hash_u32(counter ^ key);
+    return hash_u32(x ^ (key + 0x9e3779b9));
+}
+
+static float scaleElement(float x, float scale)    { return x * scale; }
+static float scaleElement(bfloat16 x, float scale) { return floatTobf16ToFloat((float)x * floatTobf16ToFloat(scale)); }
+
+template <class T, class M>
+int DropoutGaudi2Test::runDropoutTest(Dropout::Dropout_mode_t mode)
+{
+    // two mask blocks along dim 0, the second one partial
+    const int lanes = 256 / sizeof(T);
+    const uint64_t depth = Dropout::c_maskBlockElements + 952;
+    const uint64_t blocks = (depth + Dropout::c_maskBlockElements - 1) / Dropout::c_maskBlockElements;
+    const uint64_t fmInitializer[] = {depth, 4, 3, 1, 1};
+    const uint64_t maskInitializer[] = {blocks * lanes, 4, 3, 1, 1};
+
+    const bool maskOut = mode == Dropout::dropout_fwd_mask_f32 || mode == Dropout::dropout_fwd_mask_bf16;
+    const bool maskIn = mode == Dropout::dropout_bwd_mask_f32 || mode == Dropout::dropout_bwd_mask_bf16;
+
+    Dropout::DropoutParams def;
+    def.prob = 0.25f;
+    def.seed = 0x1234;
+    def.offset = 77;
+
+    test::Tensor<T,5> input(fmInitializer);
+    input.InitRand(-10.0f, 10.0f);
+    test::Tensor<T,5> output(fmInitializer);
+    test::Tensor<M,5> mask(maskInitializer);
+    test::Tensor<M,5> mask_ref(maskInitializer);
+    memset(mask_ref.Data(), 0, mask_ref.ElementCount() * sizeof(M));
+
+    // execute reference implementation of the kernel, the stream is keyed on
+    // offset + linear element index
+    const uint32_t key = hash_u32(def.seed);
+    const uint32_t threshold = Dropout::GetThreshold(def.prob);
+    const float scale = 1.0f / (1.0f - def.prob);
+    const int count = input.ElementCount();
+    std::vector<float> output_ref(count);
+    int kept = 0;
+    for (int element = 0; element < count; element++)
+    {
+        const bool keep = rng_u32(def.offset + (uint32_t)element, key) >= threshold;
+        output_ref[element] = keep ? scaleElement(input.Data()[element], scale) : 0.0f;
+        kept += keep;
+
+        const int d = element % depth;
+        const int row = element / depth;
+        const int offset = d % Dropout::c_maskBlockElements;
+        const int word = row * maskInitializer[0] + (d / Dropout::c_maskBlockElements) * lanes + offset % lanes;
+        if (keep)
+        {
+            mask_ref.Data()[word] |= (M)(1u << (offset / lanes));
+        }
+    }
+
+    // generate input for query call
+    m_in_defs.deviceId = tpc_lib_api::DEVICE_ID_GAUDI2;
+    m_in_defs.nodeParams.nodeParams = (void*)&def;
+    m_in_defs.inputTensorNr = maskIn ? 2 : 1;
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[0]), input);
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[1]), mask_ref);
+    m_in_defs.outputTensorNr = maskOut ? 2 : 1;
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[0]), output);
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[1]), mask);
+
+    tpc_lib_api::GuidInfo *guids = nullptr;
+    unsigned kernelCount = 0;
+    tpc_lib_api::GlueCodeReturn result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    guids = new tpc_lib_api::GuidInfo[kernelCount];
+    result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "Can't get kernel name!! " << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    strcpy(m_in_defs.guid.name, guids[GAUDI2_KERNEL_DROPOUT_FWD_F32 + mode].name);
+    result  = InstantiateTpcKernel(&m_in_defs,&m_out_defs);
+    ReleaseKernelNames(guids, kernelCount);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "glue test failed!!" << result << std::endl;
+        return -1;
+    }
+
+    // generate and load tensor descriptors
+    std::vector<TensorDesc2> vec;
+    vec.push_back(input.GetTensorDescriptor());
+    if (maskIn)
+        vec.push_back(mask_ref.GetTensorDescriptor());
+    vec.push_back(output.GetTensorDescriptor());
+    if (maskOut)
+        vec.push_back(mask.GetTensorDescriptor());
+
+    // execute a simulation of the kernel using TPC simulator,
+    TestBase::RunSimulation(vec, m_in_defs, m_out_defs);
+
+    for (int element = 0; element < count; element++)
+    {
+        if ((float)output.Data()[element] != output_ref[element])
+        {
+            std::cout << m_in_defs.guid.name << " test failed at element " << element << ": "
+                      << (float)output.Data()[element] << " vs " << output_ref[element] << "!!" << std::endl;
+            return -1;
+        }
+    }
+    if (maskOut && memcmp(mask.Data(), mask_ref.Data(), mask.ElementCount() * sizeof(M)) != 0)
+    {
+        std::cout << m_in_defs.guid.name << " mask mismatch, test failed!!" << std::endl;
+        return -1;
+    }
+
+    // the stream itself, the kept fraction must be close to 1 - prob
+    const double keptFraction = (double)kept / count;
+    if (fabs(keptFraction - (1.0 - def.prob)) > 0.02)
+    {
+        std::cout << m_in_defs.guid.name << " kept " << keptFraction << " of the elements, test failed!!" << std::endl;
+        return -1;
+    }
+
+    std::cout << m_in_defs.guid.name << " kept " << keptFraction << ", test pass!!" << std::endl;
+    return 0;
+}
+
+int DropoutGaudi2Test::runTest(Dropout::Dropout_mode_t mode)
+{
+    if (mode >= Dropout::dropout_fwd_bf16)
+        return runDropoutTest<bfloat16, int16_t>(mode);
+    return runDropoutTest<float, int32_t>(mode);
+}
@@ -0,0 +1,229 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "fp8_cast_gaudi2_test.hpp"
+
+typedef Fp8CastGaudi2 Fp8;
+
+template <class T, class F8>
+void Fp8CastGaudi2Test::fp8_quant_reference_implementation(
+        test::Tensor<T,3>& ifm,
+        float scale,
+        test::Tensor<F8,3>& ofm,
+        float& amax)
+{
+    amax = 0.0f;
+    for (int element = 0; element < ifm.ElementCount(); element++)
+    {
+        float x = (float)ifm.Data()[element];
+        amax = std::max(amax, std::abs(x));
+        // float8 saturates on construction
+        ofm.Data()[element] = F8(x * scale);
+    }
+}
+
+template <class F8, class T>
+void Fp8CastGaudi2Test::fp8_dequant_reference_implementation(
+        test::Tensor<F8,3>& ifm,
+        float scaleInv,
+        test::Tensor<T,3>& ofm)
+{
+    for (int element = 0; element < ifm.ElementCount(); element++)
+    {
+        ofm.Data()[element] = (T)((float)ifm.Data()[element] * scaleInv);
+    }
+}
+
+int Fp8CastGaudi2Test::runKernel(tpc_lib_api::DeviceId deviceId, Fp8::Fp8Cast_mode_t mode,
+                                 std::vector<TensorDesc2>& vec)
+{
+    m_in_defs.deviceId = deviceId;
+    m_in_defs.nodeParams.nodeParams = nullptr;
+
+    tpc_lib_api::GuidInfo *guids = nullptr;
+    unsigned kernelCount = 0;
+    tpc_lib_api::GlueCodeReturn result = GetKernelGuids(deviceId, &kernelCount, guids);
+    guids = new tpc_lib_api::GuidInfo[kernelCount];
+    result = GetKernelGuids(deviceId, &kernelCount, guids);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "Can't get kernel name!! " << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    unsigned kernelIndex = (deviceId == tpc_lib_api::DEVICE_ID_GAUDI3) ?
+            GAUDI3_KERNEL_CAST_F32_TO_FP8_143 + mode : GAUDI2_KERNEL_CAST_F32_TO_FP8_143 + mode;
+    strcpy(m_in_defs.guid.name, guids[kernelIndex].name);
+    result  = InstantiateTpcKernel(&m_in_defs,&m_out_defs);
+    ReleaseKernelNames(guids, kernelCount);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "glue test failed!!" << result << std::endl;
+        return -1;
+    }
+
+    // execute a simulation of the kernel using TPC simulator,
+    TestBase::RunSimulation(vec, m_in_defs, m_out_defs);
+    return 0;
+}
+
+template <class T, class F8>
+int Fp8CastGaudi2Test::runQuantTest(tpc_lib_api::DeviceId deviceId, Fp8::Fp8Cast_mode_t mode)
+{
+    // dim 0 ends in a partial vector
+    uint64_t fmInitializer[] = {300, 3, 2};
+    uint64_t scalarInitializer[] = {1};
+
+    // the scale maps the input range onto the fp8 range, every 100th element
+    // lands past the fp8 maximum to check saturation
+    const float range = 4.0f;
+    const float scale = F8::MaxValue() / range;
+    test::Tensor<T,3> ifm(fmInitializer);
+    ifm.InitRand(-range, range);
+    for (int element = 0; element < ifm.ElementCount(); element += 100)
+    {
+        ifm.Data()[element] = (T)(2.0f * range * ((element % 200) ? 1.0f : -1.0f));
+    }
+
+    float_1DTensor scaleTensor(scalarInitializer);
+    scaleTensor.Data()[0] = scale;
+
+    test::Tensor<F8,3> ofm(fmInitializer);
+    test::Tensor<F8,3> ofm_ref(fmInitializer);
+    // the kernel merges into amax, test::Tensor starts zeroed
+    float_1DTensor amax(scalarInitializer);
+    float amax_ref = 0.0f;
+
+    // execute reference implementation of the kernel.
+    fp8_quant_reference_implementation<T, F8>(ifm, scale, ofm_ref, amax_ref);
+
+    // generate input for query call
+    m_in_defs.inputTensorNr = 2;
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[0]), ifm);
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[1]), scaleTensor);
+    m_in_defs.outputTensorNr = 2;
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[0]), ofm);
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[1]), amax);
+
+    // generate and load tensor descriptors
+    std::vector<TensorDesc2> vec;
+    vec.push_back(ifm.GetTensorDescriptor());
+    vec.push_back(scaleTensor.GetTensorDescriptor());
+    vec.push_back(ofm.GetTensorDescriptor());
+    vec.push_back(amax.GetTensorDescriptor());
+
+    if (runKernel(deviceId, mode, vec) != 0)
+    {
+        return -1;
+    }
+
+    // both sides round half to even, the codes match exactly
+    bool passed = (amax.Data()[0] == amax_ref);
+    for (int element = 0; element < ofm_ref.ElementCount() && passed; element++)
+    {
+        passed = (ofm.Data()[element].val == ofm_ref.Data()[element].val);
+    }
+
+    if (!passed)
+    {
+        std::cout << m_in_defs.guid.name << " test failed!!" << std::endl;
+        return -1;
+    }
+    std::cout << m_in_defs.guid.name << " test pass!!" << std::endl;
+    return 0;
+}
+
+template <class F8, class T>
+int Fp8CastGaudi2Test::runDequantTest(tpc_lib_api::DeviceId deviceId, Fp8::Fp8Cast_mode_t mode)
+{
+    uint64_t fmInitializer[] = {300, 3, 2};
+    uint64_t scalarInitializer[] = {1};
+    const float scaleInv = 0.375f;
+
+    // every finite code, in order, so a lane mix-up shows
+    test::Tensor<F8,3> ifm(fmInitializer);
+    int code = 0;
+    for (int element = 0; element < ifm.ElementCount(); element++)
+    {
+        do
+        {
+            code = (code + 1) & 0xFF;
+            ifm.Data()[element].val = (uint8_t)code;
+        } while (!std::isfinite((float)ifm.Data()[element]));
+    }
+
+    float_1DTensor scaleTensor(scalarInitializer);
+    scaleTensor.Data()[0] = scaleInv;
+
+    test::Tensor<T,3> ofm(fmInitializer);
+    test::Tensor<T,3> ofm_ref(fmInitializer);
+
+    // execute reference implementation of the kernel.
+    fp8_dequant_reference_implementation<F8, T>(ifm, scaleInv, ofm_ref);
+
+    // generate input for query call
+    m_in_defs.inputTensorNr = 2;
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[0]), ifm);
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[1]), scaleTensor);
+    m_in_defs.outputTensorNr = 1;
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[0]), ofm);
+
+    // generate and load tensor descriptors
+    std::vector<TensorDesc2> vec;
+    vec.push_back(ifm.GetTensorDescriptor());
+    vec.push_back(scaleTensor.GetTensorDescriptor());
+    vec.push_back(ofm.GetTensorDescriptor());
+
+    if (runKernel(deviceId, mode, vec) != 0)
+    {
+        return -1;
+    }
+
+    // at most 4 + 2 significant bits, the products are exact in f32 and bf16
+    for (int element = 0; element < ofm_ref.ElementCount(); element++)
+    {
+        if ((float)ofm.Data()[element] != (float)ofm_ref.Data()[element])
+        {
+            std::cout << m_in_defs.guid.name << " test failed!!" << std::endl;
+            return -1;
+        }
+    }
+
+    std::cout << m_in_defs.guid.name << " test pass!!" << std::endl;
+    return 0;
+}
+
+int Fp8CastGaudi2Test::runTest(tpc_lib_api::DeviceId deviceId, Fp8::Fp8Cast_mode_t mode)
+{
+    switch (mode)
+    {
+        case Fp8::f32_to_fp8_143:  return runQuantTest<float, float8_143>(deviceId, mode);
+        case Fp8::bf16_to_fp8_143: return runQuantTest<bfloat16, float8_143>(deviceId, mode);
+        case Fp8::f32_to_fp8_152:  return runQuantTest<float, float8_152>(deviceId, mode);
+        case Fp8::bf16_to_fp8_152: return runQuantTest<bfloat16, float8_152>(deviceId, mode);
+        case Fp8::fp8_143_to_f32:  return runDequantTest<float8_143, float>(deviceId, mode);
+        case Fp8::fp8_143_to_bf16: return runDequantTest<float8_143, bfloat16>(deviceId, mode);
+        case Fp8::fp8_152_to_f32:  return runDequantTest<float8_152, float>(deviceId, mode);
+        case Fp8::fp8_152_to_bf16: return runDequantTest<float8_152, bfloat16>(deviceId, mode);
+        default:
+            std::cout << "Unsupported fp8 cast mode " << mode << std::endl;
+            return -1;
+    }
+}
@@ -0,0 +1,61 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef FP8_CAST_GAUDI2_TEST_HPP
+#define FP8_CAST_GAUDI2_TEST_HPP
+
+#include "test_base.hpp"
+#include "tensor.h"
+#include "fp8_cast_gaudi2.hpp"
+#include "entry_points.hpp"
+
+// Runs the fp8 casts on Gaudi2 or Gaudi3, the glue code is shared.
+class Fp8CastGaudi2Test : public TestBase
+{
+public:
+    Fp8CastGaudi2Test() {}
+    ~Fp8CastGaudi2Test() {}
+    int runTest(tpc_lib_api::DeviceId deviceId, Fp8CastGaudi2::Fp8Cast_mode_t mode);
+
+    template <class T, class F8>
+    static void fp8_quant_reference_implementation(
+            test::Tensor<T,3>& ifm,
+            float scale,
+            test::Tensor<F8,3>& ofm,
+            float& amax);
+
+    template <class F8, class T>
+    static void fp8_dequant_reference_implementation(
+            test::Tensor<F8,3>& ifm,
+            float scaleInv,
+            test::Tensor<T,3>& ofm);
+
+private:
+    template <class T, class F8>
+    int runQuantTest(tpc_lib_api::DeviceId deviceId, Fp8CastGaudi2::Fp8Cast_mode_t mode);
+    template <class F8, class T>
+    int runDequantTest(tpc_lib_api::DeviceId deviceId, Fp8CastGaudi2::Fp8Cast_mode_t mode);
+
+    // instantiates mode on deviceId and runs it on vec
+    int runKernel(tpc_lib_api::DeviceId deviceId, Fp8CastGaudi2::Fp8Cast_mode_t mode,
+                  std::vector<TensorDesc2>& vec);
+
+    Fp8CastGaudi2Test(const Fp8CastGaudi2Test& other) = delete;
+    Fp8CastGaudi2Test& operator=(const Fp8CastGaudi2Test& other) = delete;
+};
+
+
+#endif /* FP8_CAST_GAUDI2_TEST_HPP */
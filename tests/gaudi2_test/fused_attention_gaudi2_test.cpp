@@ -0,0 +1,195 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "fused_attention_gaudi2_test.hpp"
+
+void FusedAttentionGaudi2Test::fused_attention_reference_implementation(
+        test::Tensor<float,4>& q,
+        test::Tensor<float,4>& k,
+        test::Tensor<float,4>& v,
+        test::Tensor<int32_t,1>* kvLengths,
+        test::Tensor<float,4>& ofm,
+        const FusedAttentionGaudi2::FusedAttentionParams& def)
+{
+    const int headDim = (int)q.Size(0);
+    const int qLen    = (int)q.Size(1);
+    const int kvLen   = (int)k.Size(1);
+    std::vector<double> p(kvLen);
+    std::vector<double> o(headDim);
+
+    for (int b = 0; b < (int)q.Size(3); b++)
+    {
+        int keyEnd = kvLen;
+        if (kvLengths != nullptr)
+        {
+            int lengthCoords[1] = {b};
+            keyEnd = std::min(kvLengths->ElementAt(lengthCoords), kvLen);
+        }
+        for (int h = 0; h < (int)q.Size(2); h++)
+        {
+            for (int i = 0; i < qLen; i++)
+            {
+                int visible = keyEnd;
+                if (def.causal)
+                {
+                    visible = std::max(0, std::min(keyEnd, i + def.causalOffset + 1));
+                }
+
+                double maxVal = -INFINITY;
+                for (int j = 0; j < visible; j++)
+                {
+                    double s = 0.0;
+                    for (int d = 0; d < headDim; d++)
+                    {
+                        int qCoords[4] = {d, i, h, b};
+                        int kCoords[4] = {d, j, h, b};
+                        s += (double)(def.scale * q.ElementAt(qCoords)) * k.ElementAt(kCoords);
+                    }
+                    p[j] = s;
+                    maxVal = std::max(maxVal, s);
+                }
+                double sum = 0.0;
+                std::fill(o.begin(), o.end(), 0.0);
+                for (int j = 0; j < visible; j++)
+                {
+                    p[j] = std::exp(p[j] - maxVal);
+                    sum += p[j];
+                    for (int d = 0; d < headDim; d++)
+                    {
+                        int vCoords[4] = {d, j, h, b};
+                        o[d] += p[j] * v.ElementAt(vCoords);
+                    }
+                }
+                // a query with no visible key gets zeros
+                for (int d = 0; d < headDim; d++)
+                {
+                    int coords[4] = {d, i, h, b};
+                    ofm.SetElement(coords, sum > 0.0 ? (float)(o[d] / sum) : 0.0f);
+                }
+            }
+        }
+    }
+}
+
+int FusedAttentionGaudi2Test::runTest(Gaudi2_Kernel_Name_e NameofKernel, bool causal)
+{
+    const bool hasKvLengths = (NameofKernel == GAUDI2_KERNEL_FUSED_ATTENTION_KV_LENGTHS_F32);
+
+    // partial query block and a head dim across two tiles, more keys than
+    // queries so the causal rows see a KV cache prefix
+    const uint64_t headDim = 80;
+    const uint64_t qLen    = 100;
+    const uint64_t kvLen   = 130;
+    const uint64_t heads   = 3;
+    const uint64_t batch   = 2;
+
+    FusedAttentionGaudi2::FusedAttentionParams def;
+    def.scale = 1.0f / std::sqrt((float)headDim);
+    def.causal = causal ? 1 : 0;
+    def.causalOffset = (int32_t)(kvLen - qLen);
+
+    uint64_t qInitializer[] = {headDim, qLen, heads, batch};
+    uint64_t kvInitializer[] = {headDim, kvLen, heads, batch};
+    uint64_t lengthsInitializer[] = {batch};
+
+    test::Tensor<float,4> q(qInitializer);
+    q.InitRand(-2.0f, 2.0f);
+    test::Tensor<float,4> k(kvInitializer);
+    k.InitRand(-2.0f, 2.0f);
+    test::Tensor<float,4> v(kvInitializer);
+    v.InitRand(-1.0f, 1.0f);
+    // ragged cache: one full entry, one short one
+    test::Tensor<int32_t,1> kvLengths(lengthsInitializer);
+    for (int b = 0; b < (int)batch; b++)
+    {
+        int coords[1] = {b};
+        kvLengths.SetElement(coords, b == 0 ? (int32_t)kvLen : 57);
+    }
+
+    test::Tensor<float,4> ofm(qInitializer);
+    test::Tensor<float,4> ofm_ref(qInitializer);
+
+    // execute reference implementation of the kernel.
+    fused_attention_reference_implementation(q, k, v, hasKvLengths ? &kvLengths : nullptr, ofm_ref, def);
+
+    // generate input for query call
+    m_in_defs.deviceId = tpc_lib_api::DEVICE_ID_GAUDI2;
+
+    std::vector<TensorDesc2> vec;
+    vec.push_back(q.GetTensorDescriptor());
+    vec.push_back(k.GetTensorDescriptor());
+    vec.push_back(v.GetTensorDescriptor());
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[0]), q);
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[1]), k);
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[2]), v);
+    m_in_defs.inputTensorNr = 3;
+    if (hasKvLengths)
+    {
+        vec.push_back(kvLengths.GetTensorDescriptor());
+        LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[3]), kvLengths);
+        m_in_defs.inputTensorNr = 4;
+    }
+    m_in_defs.outputTensorNr = 1;
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[0]), ofm);
+    vec.push_back(ofm.GetTensorDescriptor());
+    m_in_defs.nodeParams.nodeParams = &def;
+
+    tpc_lib_api::GuidInfo *guids = nullptr;
+    unsigned kernelCount = 0;
+    tpc_lib_api::GlueCodeReturn result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    guids = new tpc_lib_api::GuidInfo[kernelCount];
+    result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "Can't get kernel name!! " << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    strcpy(m_in_defs.guid.name, guids[NameofKernel].name);
+    result  = InstantiateTpcKernel(&m_in_defs,&m_out_defs);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "glue test failed!!" << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    // execute a simulation of the kernel using TPC simulator,
+    const unsigned cycles = TestBase::RunSimulation(vec, m_in_defs, m_out_defs);
+
+    float maxError = 0.0f;
+    for (int element = 0; element < ofm_ref.ElementCount(); element++)
+    {
+        maxError = std::max(maxError, std::abs(ofm.Data()[element] - ofm_ref.Data()[element]));
+    }
+    if (maxError > 1e-4f)
+    {
+        std::cout << m_in_defs.guid.name << " causal " << causal << " test failed!! max error "
+                  << maxError << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    std::cout << m_in_defs.guid.name << " causal " << causal << " test pass!! max error "
+              << maxError << ", " << (double)cycles / (qLen * heads * batch)
+              << " cycles per query" << std::endl;
+    ReleaseKernelNames(guids, kernelCount);
+    return 0;
+}
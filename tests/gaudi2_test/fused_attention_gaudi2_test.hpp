@@ -0,0 +1,48 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef FUSED_ATTENTION_GAUDI2_TEST_HPP
+#define FUSED_ATTENTION_GAUDI2_TEST_HPP
+
+#include "test_base.hpp"
+#include "tensor.h"
+#include "fused_attention_gaudi2.hpp"
+#include "entry_points.hpp"
+
+class FusedAttentionGaudi2Test : public TestBase
+{
+public:
+    FusedAttentionGaudi2Test() {}
+    ~FusedAttentionGaudi2Test() {}
+    int runTest(Gaudi2_Kernel_Name_e NameofKernel, bool causal);
+
+    // softmax(scale * q k^T + mask) v per head, kvLengths is null for the
+    // plain mode
+    static void fused_attention_reference_implementation(
+            test::Tensor<float,4>& q,
+            test::Tensor<float,4>& k,
+            test::Tensor<float,4>& v,
+            test::Tensor<int32_t,1>* kvLengths,
+            test::Tensor<float,4>& ofm,
+            const FusedAttentionGaudi2::FusedAttentionParams& def);
+
+private:
+    FusedAttentionGaudi2Test(const FusedAttentionGaudi2Test& other) = delete;
+    FusedAttentionGaudi2Test& operator=(const FusedAttentionGaudi2Test& other) = delete;
+};
+
+
+#endif /* FUSED_ATTENTION_GAUDI2_TEST_HPP */
@@ -0,0 +1,254 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include "fused_elementwise_gaudi2_test.hpp"
+
+typedef FusedElementwiseGaudi2 Fused;
+
+static float toFloat(float x)    { return x; }
+static float toFloat(bfloat16 x) { return bf16ToFloat(x.val); }
+
+// the kernel rounds half to even, bfloat16(float) rounds half away from zero
+template <class T>
+static T fromFloat(float x);
+
+template <>
+float fromFloat<float>(float x)
+{
+    return x;
+}
+
+template <>
+bfloat16 fromFloat<bfloat16>(float x)
+{
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    bfloat16 out;
+    out.val = (uint16_t)((bits + 0x7fff + ((bits >> 16) & 1)) >> 16);
+    return out;
+}
+
+float FusedElementwiseGaudi2Test::fused_reference(const Fused::FusedElementwiseParams& def,
+                                                  const float* inputs)
+{
+    float acc = inputs[0];
+    for (int i = 0; i < def.opCount; i++)
+    {
+        const int op = def.ops[i] & 0xff;
+        const int operand = (def.ops[i] >> 8) & 0xff;
+        const float in = inputs[std::min(operand, Fused::c_maxInputs - 1)];
+        const float imm = def.imms[operand % Fused::c_maxImms];
+        switch (op)
+        {
+            case Fused::fused_add_input:  acc = acc + in; break;
+            case Fused::fused_sub_input:  acc = acc - in; break;
+            case Fused::fused_mul_input:  acc = acc * in; break;
+            case Fused::fused_max_input:  acc = std::max(acc, in); break;
+            case Fused::fused_min_input:  acc = std::min(acc, in); break;
+            case Fused::fused_add_scalar: acc = acc + imm; break;
+            case Fused::fused_mul_scalar: acc = acc * imm; break;
+            case Fused::fused_max_scalar: acc = std::max(acc, imm); break;
+            case Fused::fused_min_scalar: acc = std::min(acc, imm); break;
+            case Fused::fused_relu:       acc = std::max(acc, 0.0f); break;
+            case Fused::fused_relu6:      acc = std::min(std::max(acc, 0.0f), 6.0f); break;
+            default: break;
+        }
+    }
+    return acc;
+}
+
+template <class TI, class TO>
+int FusedElementwiseGaudi2Test::runFusedTest(Fused::FusedElementwise_mode_t mode,
+                                             const Fused::FusedElementwiseParams& def,
+                                             int inputNr, const uint64_t sizes[][5])
+{
+    uint64_t ofmSizes[5] = {1, 1, 1, 1, 1};
+    for (int i = 0; i < inputNr; i++)
+    {
+        for (int dim = 0; dim < 5; dim++)
+        {
+            ofmSizes[dim] = std::max(ofmSizes[dim], sizes[i][dim]);
+        }
+    }
+
+    test::Tensor<TI,5>* ifms[Fused::c_maxInputs] = {nullptr};
+    for (int i = 0; i < inputNr; i++)
+    {
+        ifms[i] = new test::Tensor<TI,5>(sizes[i]);
+        for (int element = 0; element < ifms[i]->ElementCount(); element++)
+        {
+            ifms[i]->Data()[element] = (TI)(((element * (37 + 8 * i)) % 161 - 80) * 0.11f);
+        }
+    }
+
+    test::Tensor<TO,5> ofm(ofmSizes);
+    test::Tensor<TO,5> ofm_ref(ofmSizes);
+
+    // execute reference implementation of the kernel, broadcast dims read 0
+    int ofmCoords[5] = {0};
+    int ifmCoords[5] = {0};
+    float inputs[Fused::c_maxInputs] = {0};
+    for (ofmCoords[4] = 0; ofmCoords[4] < (int)ofmSizes[4]; ofmCoords[4]++)
+    for (ofmCoords[3] = 0; ofmCoords[3] < (int)ofmSizes[3]; ofmCoords[3]++)
+    for (ofmCoords[2] = 0; ofmCoords[2] < (int)ofmSizes[2]; ofmCoords[2]++)
+    for (ofmCoords[1] = 0; ofmCoords[1] < (int)ofmSizes[1]; ofmCoords[1]++)
+    for (ofmCoords[0] = 0; ofmCoords[0] < (int)ofmSizes[0]; ofmCoords[0]++)
+    {
+        for (int i = 0; i < inputNr; i++)
+        {
+            for (int dim = 0; dim < 5; dim++)
+            {
+                ifmCoords[dim] = sizes[i][dim] == 1 ? 0 : ofmCoords[dim];
+            }
+            inputs[i] = toFloat(ifms[i]->ElementAt(ifmCoords));
+        }
+        ofm_ref.SetElement(ofmCoords, fromFloat<TO>(fused_reference(def, inputs)));
+    }
+
+    // generate input for query call
+    m_in_defs.deviceId = tpc_lib_api::DEVICE_ID_GAUDI2;
+    m_in_defs.nodeParams.nodeParams = (void*)&def;
+    m_in_defs.inputTensorNr = inputNr;
+    for (int i = 0; i < inputNr; i++)
+    {
+        LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[i]), *ifms[i]);
+    }
+    m_in_defs.outputTensorNr = 1;
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[0]), ofm);
+
+    tpc_lib_api::GuidInfo *guids = nullptr;
+    unsigned kernelCount = 0;
+    tpc_lib_api::GlueCodeReturn result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    guids = new tpc_lib_api::GuidInfo[kernelCount];
+    result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "Can't get kernel name!! " << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    strcpy(m_in_defs.guid.name, guids[GAUDI2_KERNEL_FUSED_ELEMENTWISE_F32_TO_F32 + mode].name);
+    result  = InstantiateTpcKernel(&m_in_defs,&m_out_defs);
+    ReleaseKernelNames(guids, kernelCount);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "glue test failed!!" << result << std::endl;
+        for (int i = 0; i < inputNr; i++)
+        {
+            delete ifms[i];
+        }
+        return -1;
+    }
+
+    // generate and load tensor descriptors
+    std::vector<TensorDesc2> vec;
+    for (int i = 0; i < inputNr; i++)
+    {
+        vec.push_back(ifms[i]->GetTensorDescriptor());
+    }
+    vec.push_back(ofm.GetTensorDescriptor());
+
+    // execute a simulation of the kernel using TPC simulator,
+    TestBase::RunSimulation(vec, m_in_defs, m_out_defs);
+
+    for (int i = 0; i < inputNr; i++)
+    {
+        delete ifms[i];
+    }
+
+    // every op is a single f32 rounding on both sides and the cast rounds
+    // once, the values match exactly (+0 and -0 compare equal)
+    for (int element = 0; element < ofm_ref.ElementCount(); element++)
+    {
+        if (toFloat(ofm.Data()[element]) != toFloat(ofm_ref.Data()[element]))
+        {
+            std::cout << m_in_defs.guid.name << " test failed at element " << element << ": "
+                      << toFloat(ofm.Data()[element]) << " vs " << toFloat(ofm_ref.Data()[element])
+                      << "!!" << std::endl;
+            return -1;
+        }
+    }
+
+    std::cout << m_in_defs.guid.name << " test pass!!" << std::endl;
+    return 0;
+}
+
+int FusedElementwiseGaudi2Test::runTest(int testCase)
+{
+    Fused::FusedElementwiseParams def;
+    memset(&def, 0, sizeof(def));
+
+    switch (testCase)
+    {
+        case 0:
+        {
+            // add bias -> relu6 -> mul by scalar -> cast to bf16
+            const uint64_t sizes[][5] = {{200, 3, 4, 1, 1}, {200, 1, 1, 1, 1}};
+            def.opCount = 3;
+            def.ops[0] = Fused::MakeOp(Fused::fused_add_input, 1);
+            def.ops[1] = Fused::MakeOp(Fused::fused_relu6, 0);
+            def.ops[2] = Fused::MakeOp(Fused::fused_mul_scalar, 0);
+            def.imms[0] = 0.37f;
+            return runFusedTest<float, bfloat16>(Fused::fused_f32_to_bf16, def, 2, sizes);
+        }
+        case 1:
+        {
+            // x * per-channel scale + residual, scale broadcasts the FCD
+            const uint64_t sizes[][5] = {{150, 5, 2, 1, 1}, {1, 5, 1, 1, 1}, {150, 5, 2, 1, 1}};
+            def.opCount = 2;
+            def.ops[0] = Fused::MakeOp(Fused::fused_mul_input, 1);
+            def.ops[1] = Fused::MakeOp(Fused::fused_add_input, 2);
+            return runFusedTest<bfloat16, float>(Fused::fused_bf16_to_f32, def, 3, sizes);
+        }
+        case 2:
+        {
+            // every op over 4 inputs, ifm0 broadcast on dims 1 and 3
+            const uint64_t sizes[][5] = {{130, 1, 3, 1, 1}, {130, 2, 3, 2, 1},
+                                         {1, 2, 3, 2, 1}, {130, 2, 1, 1, 1}};
+            def.opCount = 11;
+            def.ops[0] = Fused::MakeOp(Fused::fused_add_input, 1);
+            def.ops[1] = Fused::MakeOp(Fused::fused_mul_scalar, 0);
+            def.ops[2] = Fused::MakeOp(Fused::fused_sub_input, 2);
+            def.ops[3] = Fused::MakeOp(Fused::fused_max_input, 3);
+            def.ops[4] = Fused::MakeOp(Fused::fused_mul_input, 0);
+            def.ops[5] = Fused::MakeOp(Fused::fused_add_scalar, 1);
+            def.ops[6] = Fused::MakeOp(Fused::fused_min_input, 2);
+            def.ops[7] = Fused::MakeOp(Fused::fused_max_scalar, 2);
+            def.ops[8] = Fused::MakeOp(Fused::fused_min_scalar, 3);
+            def.ops[9] = Fused::MakeOp(Fused::fused_relu, 0);
+            def.ops[10] = Fused::MakeOp(Fused::fused_relu6, 0);
+            def.imms[0] = 1.5f;
+            def.imms[1] = -0.25f;
+            def.imms[2] = -3.0f;
+            def.imms[3] = 5.0f;
+            return runFusedTest<float, float>(Fused::fused_f32_to_f32, def, 4, sizes);
+        }
+        case 3:
+        {
+            // single input, no ops: a plain bf16 copy
+            const uint64_t sizes[][5] = {{300, 3, 1, 1, 1}};
+            def.opCount = 0;
+            return runFusedTest<bfloat16, bfloat16>(Fused::fused_bf16_to_bf16, def, 1, sizes);
+        }
+        default:
+            std::cout << "Unsupported fused elementwise test case " << testCase << std::endl;
+            return -1;
+    }
+}
@@ -0,0 +1,49 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef FUSED_ELEMENTWISE_GAUDI2_TEST_HPP
+#define FUSED_ELEMENTWISE_GAUDI2_TEST_HPP
+
+#include "test_base.hpp"
+#include "tensor.h"
+#include "fused_elementwise_gaudi2.hpp"
+#include "entry_points.hpp"
+
+class FusedElementwiseGaudi2Test : public TestBase
+{
+public:
+    FusedElementwiseGaudi2Test() {}
+    ~FusedElementwiseGaudi2Test() {}
+    // testCase picks the program, the input shapes and the mode
+    int runTest(int testCase);
+    static const int c_testCaseCount = 4;
+
+    // runs the program of def on one element of every input
+    static float fused_reference(const FusedElementwiseGaudi2::FusedElementwiseParams& def,
+                                 const float* inputs);
+
+private:
+    template <class TI, class TO>
+    int runFusedTest(FusedElementwiseGaudi2::FusedElementwise_mode_t mode,
+                     const FusedElementwiseGaudi2::FusedElementwiseParams& def,
+                     int inputNr, const uint64_t sizes[][5]);
+
+    FusedElementwiseGaudi2Test(const FusedElementwiseGaudi2Test& other) = delete;
+    FusedElementwiseGaudi2Test& operator=(const FusedElementwiseGaudi2Test& other) = delete;
+};
+
+
+#endif /* FUSED_ELEMENTWISE_GAUDI2_TEST_HPP */
@@ -0,0 +1,267 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "grad_norm_gaudi2_test.hpp"
+
+template <class T, int DIMS>
+void GradNormGaudi2Test::grad_norm_reference_implementation(
+        test::Tensor<T,DIMS>& grad,
+        float_1DTensor& stats,
+        int32_1DTensor* chunkTensor,
+        int chunkSize,
+        float_2DTensor* tensorStats)
+{
+    const int numTensors = (tensorStats != nullptr) ? (int)tensorStats->Size(1) : 0;
+    std::vector<double> tensorSumSq(numTensors, 0.0);
+    std::vector<float> tensorNonFinite(numTensors, 0.0f);
+
+    double sumSq = 0.0;
+    float nonFinite = 0.0f;
+    for (int element = 0; element < grad.ElementCount(); element++)
+    {
+        float g = (float)grad.Data()[element];
+        float count = std::isfinite(g) ? 0.0f : 1.0f;
+        nonFinite += count;
+        sumSq += (double)g * g;
+        if (chunkTensor != nullptr)
+        {
+            const int t = chunkTensor->Data()[element / chunkSize];
+            tensorNonFinite[t] += count;
+            tensorSumSq[t] += (double)g * g;
+        }
+    }
+
+    int coords[1] = {GradNormGaudi2::c_sumSquares};
+    stats.SetElement(coords, (float)sumSq);
+    coords[0] = GradNormGaudi2::c_nonFiniteCount;
+    stats.SetElement(coords, nonFinite);
+
+    for (int t = 0; t < numTensors; t++)
+    {
+        int tensorCoords[2] = {GradNormGaudi2::c_sumSquares, t};
+        tensorStats->SetElement(tensorCoords, (float)tensorSumSq[t]);
+        tensorCoords[0] = GradNormGaudi2::c_nonFiniteCount;
+        tensorStats->SetElement(tensorCoords, tensorNonFinite[t]);
+    }
+}
+
+bool GradNormGaudi2Test::statsMatch(const float* stats, const float* stats_ref)
+{
+    const float count = stats[GradNormGaudi2::c_nonFiniteCount];
+    const float countRef = stats_ref[GradNormGaudi2::c_nonFiniteCount];
+    const float sumSq = stats[GradNormGaudi2::c_sumSquares];
+    const float sumSqRef = stats_ref[GradNormGaudi2::c_sumSquares];
+    if (count != countRef)
+    {
+        return false;
+    }
+    if (countRef != 0.0f)
+    {
+        return !std::isfinite(sumSq);
+    }
+    return std::abs(sumSq - sumSqRef) <= 1e-4f * sumSqRef;
+}
+
+int GradNormGaudi2Test::runKernel(Gaudi2_Kernel_Name_e NameofKernel, std::vector<TensorDesc2>& vec)
+{
+    m_in_defs.deviceId = tpc_lib_api::DEVICE_ID_GAUDI2;
+
+    tpc_lib_api::GuidInfo *guids = nullptr;
+    unsigned kernelCount = 0;
+    tpc_lib_api::GlueCodeReturn result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    guids = new tpc_lib_api::GuidInfo[kernelCount];
+    result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "Can't get kernel name!! " << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    strcpy(m_in_defs.guid.name, guids[NameofKernel].name);
+    result  = InstantiateTpcKernel(&m_in_defs,&m_out_defs);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "glue test failed!!" << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    // execute a simulation of the kernel using TPC simulator,
+    TestBase::RunSimulation(vec, m_in_defs, m_out_defs);
+    ReleaseKernelNames(guids, kernelCount);
+    return 0;
+}
+
+template <class T>
+int GradNormGaudi2Test::runGradNormTest(Gaudi2_Kernel_Name_e NameofKernel, bool nonFinite)
+{
+    // dim 0 is not a multiple of the member size
+    uint64_t fmInitializer[] = {1000, 7, 3};
+    uint64_t statsInitializer[] = {GradNormGaudi2::c_statsSize};
+
+    test::Tensor<T,3> grad(fmInitializer);
+    grad.InitRand(-1.0f, 1.0f);
+    if (nonFinite)
+    {
+        // one inf and one NaN in different members
+        grad.Data()[17] = (T)std::numeric_limits<float>::infinity();
+        grad.Data()[5000] = (T)std::numeric_limits<float>::quiet_NaN();
+    }
+
+    // the kernel accumulates, test::Tensor starts zeroed
+    float_1DTensor stats(statsInitializer);
+    float_1DTensor stats_ref(statsInitializer);
+
+    // execute reference implementation of the kernel.
+    grad_norm_reference_implementation<T,3>(grad, stats_ref, nullptr, 0, nullptr);
+
+    // generate input for query call
+    m_in_defs.inputTensorNr = 1;
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[0]), grad);
+    m_in_defs.outputTensorNr = 1;
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[0]), stats);
+
+    // generate and load tensor descriptors
+    std::vector<TensorDesc2> vec;
+    vec.push_back(grad.GetTensorDescriptor());
+    vec.push_back(stats.GetTensorDescriptor());
+
+    if (runKernel(NameofKernel, vec) != 0)
+        return -1;
+
+    if (!statsMatch(stats.Data(), stats_ref.Data()))
+    {
+        std::cout << m_in_defs.guid.name << " test failed!!" << std::endl;
+        return -1;
+    }
+
+    std::cout << m_in_defs.guid.name << " test pass!!" << std::endl;
+    return 0;
+}
+
+template <class T>
+int GradNormGaudi2Test::runGradNormMultiTest(Gaudi2_Kernel_Name_e NameofKernel, bool nonFinite)
+{
+    GradNormGaudi2::GradNormParams def;
+    def.chunkSize = 1024;
+
+    // a list of three tensors packed as for the multi tensor AdamW step,
+    // every tensor starts a new chunk and the list ends in a partial chunk
+    const int tensorSizes[] = {1500, 300, 2100};
+    const int numTensors = sizeof(tensorSizes) / sizeof(tensorSizes[0]);
+    std::vector<int32_t> chunkOwners;
+    uint64_t elements = 0;
+    for (int t = 0; t < numTensors; t++)
+    {
+        const int chunks = (tensorSizes[t] + def.chunkSize - 1) / def.chunkSize;
+        elements = chunkOwners.size() * def.chunkSize + tensorSizes[t];
+        chunkOwners.insert(chunkOwners.end(), chunks, t);
+    }
+    const uint64_t numChunks = chunkOwners.size();
+
+    uint64_t fmInitializer[] = {elements};
+    uint64_t chunkInitializer[] = {numChunks};
+    uint64_t statsInitializer[] = {GradNormGaudi2::c_statsSize};
+    uint64_t tensorStatsInitializer[] = {GradNormGaudi2::c_statsSize, (uint64_t)numTensors};
+
+    int32_1DTensor chunkTensor(chunkInitializer);
+    std::copy(chunkOwners.begin(), chunkOwners.end(), chunkTensor.Data());
+
+    // the padding at the end of every tensor is zero
+    test::Tensor<T,1> grad(fmInitializer);
+    grad.InitRand(-1.0f, 1.0f);
+    int tensorStart = 0;
+    for (int t = 0; t < numTensors; t++)
+    {
+        const int chunks = (tensorSizes[t] + def.chunkSize - 1) / def.chunkSize;
+        const int tensorEnd = std::min(tensorStart + chunks * def.chunkSize, (int)elements);
+        std::fill(grad.Data() + tensorStart + tensorSizes[t], grad.Data() + tensorEnd, (T)0.0f);
+        tensorStart = tensorEnd;
+    }
+    if (nonFinite)
+    {
+        // an inf in the first tensor and a NaN in the last one
+        grad.Data()[17] = (T)std::numeric_limits<float>::infinity();
+        grad.Data()[elements - 5] = (T)std::numeric_limits<float>::quiet_NaN();
+    }
+
+    // the kernel accumulates, test::Tensor starts zeroed
+    float_1DTensor stats(statsInitializer);
+    float_1DTensor stats_ref(statsInitializer);
+    float_2DTensor tensorStats(tensorStatsInitializer);
+    float_2DTensor tensorStats_ref(tensorStatsInitializer);
+
+    // execute reference implementation of the kernel.
+    grad_norm_reference_implementation<T,1>(grad, stats_ref, &chunkTensor, def.chunkSize, &tensorStats_ref);
+
+    // generate input for query call
+    m_in_defs.inputTensorNr = 2;
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[0]), grad);
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[1]), chunkTensor);
+    m_in_defs.outputTensorNr = 2;
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[0]), stats);
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[1]), tensorStats);
+    m_in_defs.nodeParams.nodeParams = &def;
+
+    // generate and load tensor descriptors
+    std::vector<TensorDesc2> vec;
+    vec.push_back(grad.GetTensorDescriptor());
+    vec.push_back(chunkTensor.GetTensorDescriptor());
+    vec.push_back(stats.GetTensorDescriptor());
+    vec.push_back(tensorStats.GetTensorDescriptor());
+
+    if (runKernel(NameofKernel, vec) != 0)
+        return -1;
+
+    bool passed = statsMatch(stats.Data(), stats_ref.Data());
+    for (int t = 0; t < numTensors; t++)
+    {
+        const int offset = t * GradNormGaudi2::c_statsSize;
+        passed = passed && statsMatch(tensorStats.Data() + offset, tensorStats_ref.Data() + offset);
+    }
+
+    if (!passed)
+    {
+        std::cout << m_in_defs.guid.name << " test failed!!" << std::endl;
+        return -1;
+    }
+
+    std::cout << m_in_defs.guid.name << " test pass!!" << std::endl;
+    return 0;
+}
+
+int GradNormGaudi2Test::runTest(Gaudi2_Kernel_Name_e NameofKernel, bool nonFinite)
+{
+    switch (NameofKernel)
+    {
+        case GAUDI2_KERNEL_GRAD_NORM_F32:
+            return runGradNormTest<float>(NameofKernel, nonFinite);
+        case GAUDI2_KERNEL_GRAD_NORM_BF16:
+            return runGradNormTest<bfloat16>(NameofKernel, nonFinite);
+        case GAUDI2_KERNEL_GRAD_NORM_MULTI_F32:
+            return runGradNormMultiTest<float>(NameofKernel, nonFinite);
+        case GAUDI2_KERNEL_GRAD_NORM_MULTI_BF16:
+            return runGradNormMultiTest<bfloat16>(NameofKernel, nonFinite);
+        default:
+            std::cout << "Unsupported grad norm kernel " << NameofKernel << std::endl;
+            return -1;
+    }
+}
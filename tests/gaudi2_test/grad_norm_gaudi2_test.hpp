@@ -0,0 +1,59 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef GRAD_NORM_GAUDI2_TEST_HPP
+#define GRAD_NORM_GAUDI2_TEST_HPP
+
+#include <vector>
+#include "test_base.hpp"
+#include "tensor.h"
+#include "grad_norm_gaudi2.hpp"
+#include "entry_points.hpp"
+
+class GradNormGaudi2Test : public TestBase
+{
+public:
+    GradNormGaudi2Test() {}
+    ~GradNormGaudi2Test() {}
+    int runTest(Gaudi2_Kernel_Name_e NameofKernel, bool nonFinite);
+
+    // sum of squares and the count of inf / NaN elements, also per tensor of
+    // a packed list when chunkTensor is given
+    template <class T, int DIMS>
+    static void grad_norm_reference_implementation(
+            test::Tensor<T,DIMS>& grad,
+            float_1DTensor& stats,
+            int32_1DTensor* chunkTensor,
+            int chunkSize,
+            float_2DTensor* tensorStats);
+
+private:
+    template <class T>
+    int runGradNormTest(Gaudi2_Kernel_Name_e NameofKernel, bool nonFinite);
+    template <class T>
+    int runGradNormMultiTest(Gaudi2_Kernel_Name_e NameofKernel, bool nonFinite);
+    int runKernel(Gaudi2_Kernel_Name_e NameofKernel, std::vector<TensorDesc2>& vec);
+
+    // the sum of squares only differs by the summation order, and is not
+    // finite exactly when the reference counted non-finite elements
+    static bool statsMatch(const float* stats, const float* stats_ref);
+
+    GradNormGaudi2Test(const GradNormGaudi2Test& other) = delete;
+    GradNormGaudi2Test& operator=(const GradNormGaudi2Test& other) = delete;
+};
+
+
+#endif /* GRAD_NORM_GAUDI2_TEST_HPP */
@@ -0,0 +1,465 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cmath>
+#include <string>
+#include <type_traits>
+#include "layer_norm_all_gaudi2_test.hpp"
+
+template <class T>
+void LayerNormAllGaudi2Test::layer_norm_fwd_reference_implementation(
+        test::Tensor<T,3>& ifm,
+        test::Tensor<T,3>& residual,
+        test::Tensor<T,1>& gamma,
+        test::Tensor<T,1>& beta,
+        test::Tensor<T,3>& ofm,
+        float_3DTensor& mean,
+        float_3DTensor& rstd,
+        test::Tensor<T,3>& residualOut,
+        float epsilon, bool rmsNorm, bool fuseResidual)
+{
+    const int rowLen = (int)ifm.Size(0);
+    const int rows   = ifm.ElementCount() / rowLen;
+    std::vector<float> x(rowLen);
+
+    for (int r = 0; r < rows; r++)
+    {
+        float sum = 0.f, sumSq = 0.f;
+        for (int c = 0; c < rowLen; c++)
+        {
+            int idx = r * rowLen + c;
+            float val = (float)ifm.Data()[idx];
+            if (fuseResidual)
+            {
+                val += (float)residual.Data()[idx];
+                residualOut.Data()[idx] = (T)val;
+                // the kernel normalizes the stored sum
+                val = (float)residualOut.Data()[idx];
+            }
+            x[c] = val;
+            sum   += val;
+            sumSq += val * val;
+        }
+
+        float mu = rmsNorm ? 0.f : sum / rowLen;
+        float var = sumSq / rowLen - mu * mu;
+        var = var < 0.f ? 0.f : var;
+        float rs = 1.f / std::sqrt(var + epsilon);
+
+        if (!rmsNorm)
+        {
+            mean.Data()[r] = mu;
+        }
+        rstd.Data()[r] = rs;
+
+        for (int c = 0; c < rowLen; c++)
+        {
+            float y = (x[c] - mu) * rs * (float)gamma.Data()[c];
+            if (!rmsNorm)
+            {
+                y += (float)beta.Data()[c];
+            }
+            ofm.Data()[r * rowLen + c] = (T)y;
+        }
+    }
+}
+
+template <class T>
+void LayerNormAllGaudi2Test::layer_norm_bwd_reference_implementation(
+        test::Tensor<T,3>& gradOut,
+        test::Tensor<T,3>& ifm,
+        test::Tensor<T,1>& gamma,
+        float_3DTensor& mean,
+        float_3DTensor& rstd,
+        test::Tensor<T,3>& gradIn,
+        test::Tensor<T,1>& gradGamma,
+        test::Tensor<T,1>& gradBeta,
+        bool rmsNorm)
+{
+    const int rowLen = (int)ifm.Size(0);
+    const int rows   = ifm.ElementCount() / rowLen;
+    std::vector<float> dGamma(rowLen, 0.f), dBeta(rowLen, 0.f);
+
+    for (int r = 0; r < rows; r++)
+    {
+        float mu = rmsNorm ? 0.f : mean.Data()[r];
+        float rs = rstd.Data()[r];
+        float sumG = 0.f, sumGX = 0.f;
+
+        for (int c = 0; c < rowLen; c++)
+        {
+            int idx = r * rowLen + c;
+            float xhat = ((float)ifm.Data()[idx] - mu) * rs;
+            float dy = (float)gradOut.Data()[idx];
+            float g = dy * (float)gamma.Data()[c];
+            sumG  += g;
+            sumGX += g * xhat;
+            dGamma[c] += dy * xhat;
+            dBeta[c]  += dy;
+        }
+
+        float meanG  = rmsNorm ? 0.f : sumG / rowLen;
+        float meanGX = sumGX / rowLen;
+        for (int c = 0; c < rowLen; c++)
+        {
+            int idx = r * rowLen + c;
+            float xhat = ((float)ifm.Data()[idx] - mu) * rs;
+            float g = (float)gradOut.Data()[idx] * (float)gamma.Data()[c];
+            gradIn.Data()[idx] = (T)(rs * (g - meanG - xhat * meanGX));
+        }
+    }
+
+    for (int c = 0; c < rowLen; c++)
+    {
+        gradGamma.Data()[c] = (T)dGamma[c];
+        if (!rmsNorm)
+        {
+            gradBeta.Data()[c] = (T)dBeta[c];
+        }
+    }
+}
+
+template <class T>
+static bool compareNorm(test::Tensor<T,3>& res, test::Tensor<T,3>& ref, float tolerance)
+{
+    for (int element = 0; element < ref.ElementCount(); element++)
+    {
+        float a = (float)res.Data()[element];
+        float b = (float)ref.Data()[element];
+        if (std::abs(a - b) > tolerance * (1.f + std::abs(b)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <class T>
+static bool compareNorm(test::Tensor<T,1>& res, test::Tensor<T,1>& ref, float tolerance)
+{
+    for (int element = 0; element < ref.ElementCount(); element++)
+    {
+        float a = (float)res.Data()[element];
+        float b = (float)ref.Data()[element];
+        if (std::abs(a - b) > tolerance * (1.f + std::abs(b)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <class T>
+int LayerNormAllGaudi2Test::runParamReduce(float_3DTensor& partials, test::Tensor<T,1>& paramGrad)
+{
+    TearDown();
+    SetUp();
+    std::vector<TensorDesc2> vec;
+    m_in_defs.deviceId = tpc_lib_api::DEVICE_ID_GAUDI2;
+    m_in_defs.inputTensorNr = 1;
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[0]), partials);
+    m_in_defs.outputTensorNr = 1;
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[0]), paramGrad);
+    vec.push_back(partials.GetTensorDescriptor());
+    vec.push_back(paramGrad.GetTensorDescriptor());
+    m_in_defs.nodeParams.nodeParams = nullptr;
+
+    tpc_lib_api::GuidInfo *guids = nullptr;
+    unsigned kernelCount = 0;
+    tpc_lib_api::GlueCodeReturn result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    guids = new tpc_lib_api::GuidInfo[kernelCount];
+    result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "Can't get kernel name!! " << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    strcpy(m_in_defs.guid.name, guids[GAUDI2_KERNEL_NORM_BWD_PARAM_REDUCE_BF16].name);
+    result  = InstantiateTpcKernel(&m_in_defs,&m_out_defs);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "glue test failed!!" << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    // execute a simulation of the kernel using TPC simulator,
+    TestBase::RunSimulation(vec, m_in_defs, m_out_defs);
+    ReleaseKernelNames(guids, kernelCount);
+    return 0;
+}
+
+template <class T>
+int LayerNormAllGaudi2Test::runNormTest(Gaudi2_Kernel_Name_e NameofKernel,
+                                        bool rmsNorm, bool fuseResidual, bool backward,
+                                        int height)
+{
+    const int rowLen = 300;
+    const int batch  = 2;
+    // parameter gradients are accumulated in f32 and rounded once, a bf16
+    // running sum drifts far outside this bound on the tall shapes
+    const float tolerance = std::is_same<T, float>::value ? 1e-3f : 2e-2f;
+    // the bf16 backward writes f32 gradient partials, reduced by a second kernel
+    const bool paramPartials = backward && std::is_same<T, bfloat16>::value;
+
+    uint64_t rowInitializer[]   = {(uint64_t)rowLen, (uint64_t)height, (uint64_t)batch};
+    uint64_t paramInitializer[] = {(uint64_t)rowLen};
+    uint64_t statInitializer[]  = {1, (uint64_t)height, (uint64_t)batch};
+    uint64_t partialInitializer[3];
+    LayerNormAllGaudi2::GetParamPartialSizes(rowInitializer, 3, partialInitializer);
+
+    test::Tensor<T,3> ifm(rowInitializer);
+    ifm.InitRand(-2.0f, 1.0f);
+    test::Tensor<T,3> residual(rowInitializer);
+    residual.InitRand(-1.0f, 1.0f);
+    test::Tensor<T,1> gamma(paramInitializer);
+    gamma.InitRand(0.5f, 0.5f);
+    test::Tensor<T,1> beta(paramInitializer);
+    beta.InitRand(-0.5f, 0.0f);
+
+    test::Tensor<T,3> ofm(rowInitializer);
+    test::Tensor<T,3> ofm_ref(rowInitializer);
+    test::Tensor<T,3> residualOut(rowInitializer);
+    test::Tensor<T,3> residualOut_ref(rowInitializer);
+    float_3DTensor mean(statInitializer);
+    float_3DTensor mean_ref(statInitializer);
+    float_3DTensor rstd(statInitializer);
+    float_3DTensor rstd_ref(statInitializer);
+
+    LayerNormAllGaudi2::LayerNormParams def;
+    def.epsilon = 1e-5f;
+
+    // execute reference implementation of the kernel.
+    layer_norm_fwd_reference_implementation<T>(ifm, residual, gamma, beta, ofm_ref,
+                                               mean_ref, rstd_ref, residualOut_ref,
+                                               def.epsilon, rmsNorm, fuseResidual);
+
+    test::Tensor<T,3> gradOut(rowInitializer);
+    gradOut.InitRand(-1.0f, 1.0f);
+    test::Tensor<T,3> gradIn(rowInitializer);
+    test::Tensor<T,3> gradIn_ref(rowInitializer);
+    test::Tensor<T,1> gradGamma(paramInitializer);
+    test::Tensor<T,1> gradGamma_ref(paramInitializer);
+    test::Tensor<T,1> gradBeta(paramInitializer);
+    test::Tensor<T,1> gradBeta_ref(paramInitializer);
+    float_3DTensor gammaPartials(partialInitializer);
+    float_3DTensor betaPartials(partialInitializer);
+    if (backward)
+    {
+        layer_norm_bwd_reference_implementation<T>(gradOut, ifm, gamma, mean_ref, rstd_ref,
+                                                   gradIn_ref, gradGamma_ref, gradBeta_ref,
+                                                   rmsNorm);
+    }
+
+    // generate input for query call
+    std::vector<TensorDesc2> vec;
+    std::vector<TensorDesc2> outVec;
+    m_in_defs.deviceId = tpc_lib_api::DEVICE_ID_GAUDI2;
+    unsigned inNr = 0, outNr = 0;
+    if (!backward)
+    {
+        LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[inNr++]), ifm);
+        vec.push_back(ifm.GetTensorDescriptor());
+        LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[inNr++]), gamma);
+        vec.push_back(gamma.GetTensorDescriptor());
+        if (!rmsNorm)
+        {
+            LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[inNr++]), beta);
+            vec.push_back(beta.GetTensorDescriptor());
+        }
+        if (fuseResidual)
+        {
+            LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[inNr++]), residual);
+            vec.push_back(residual.GetTensorDescriptor());
+        }
+
+        LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[outNr++]), ofm);
+        outVec.push_back(ofm.GetTensorDescriptor());
+        if (!rmsNorm)
+        {
+            LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[outNr++]), mean);
+            outVec.push_back(mean.GetTensorDescriptor());
+        }
+        LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[outNr++]), rstd);
+        outVec.push_back(rstd.GetTensorDescriptor());
+        if (fuseResidual)
+        {
+            LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[outNr++]), residualOut);
+            outVec.push_back(residualOut.GetTensorDescriptor());
+        }
+    }
+    else
+    {
+        LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[inNr++]), gradOut);
+        vec.push_back(gradOut.GetTensorDescriptor());
+        LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[inNr++]), ifm);
+        vec.push_back(ifm.GetTensorDescriptor());
+        LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[inNr++]), gamma);
+        vec.push_back(gamma.GetTensorDescriptor());
+        if (!rmsNorm)
+        {
+            LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[inNr++]), mean_ref);
+            vec.push_back(mean_ref.GetTensorDescriptor());
+        }
+        LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[inNr++]), rstd_ref);
+        vec.push_back(rstd_ref.GetTensorDescriptor());
+
+        LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[outNr++]), gradIn);
+        outVec.push_back(gradIn.GetTensorDescriptor());
+        if (paramPartials)
+        {
+            LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[outNr++]), gammaPartials);
+            outVec.push_back(gammaPartials.GetTensorDescriptor());
+            if (!rmsNorm)
+            {
+                LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[outNr++]), betaPartials);
+                outVec.push_back(betaPartials.GetTensorDescriptor());
+            }
+        }
+        else
+        {
+            LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[outNr++]), gradGamma);
+            outVec.push_back(gradGamma.GetTensorDescriptor());
+            if (!rmsNorm)
+            {
+                LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[outNr++]), gradBeta);
+                outVec.push_back(gradBeta.GetTensorDescriptor());
+            }
+        }
+    }
+    m_in_defs.inputTensorNr = inNr;
+    m_in_defs.outputTensorNr = outNr;
+    vec.insert(vec.end(), outVec.begin(), outVec.end());
+
+    m_in_defs.nodeParams.nodeParams = &def;
+
+    tpc_lib_api::GuidInfo *guids = nullptr;
+    unsigned kernelCount = 0;
+    tpc_lib_api::GlueCodeReturn result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    guids = new tpc_lib_api::GuidInfo[kernelCount];
+    result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "Can't get kernel name!! " << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    strcpy(m_in_defs.guid.name, guids[NameofKernel].name);
+    const std::string testName = m_in_defs.guid.name;
+    result  = InstantiateTpcKernel(&m_in_defs,&m_out_defs);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "glue test failed!!" << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    // execute a simulation of the kernel using TPC simulator,
+    TestBase::RunSimulation(vec, m_in_defs, m_out_defs);
+    ReleaseKernelNames(guids, kernelCount);
+
+    if (paramPartials)
+    {
+        if (runParamReduce<T>(gammaPartials, gradGamma) != 0 ||
+            (!rmsNorm && runParamReduce<T>(betaPartials, gradBeta) != 0))
+        {
+            return -1;
+        }
+    }
+
+    bool pass = true;
+    if (!backward)
+    {
+        pass = compareNorm<T>(ofm, ofm_ref, tolerance);
+        if (fuseResidual)
+        {
+            pass = pass && compareNorm<T>(residualOut, residualOut_ref, tolerance);
+        }
+        for (int element = 0; element < rstd_ref.ElementCount(); element++)
+        {
+            if (std::abs(rstd.Data()[element] - rstd_ref.Data()[element]) >
+                    tolerance * rstd_ref.Data()[element] ||
+                (!rmsNorm && std::abs(mean.Data()[element] - mean_ref.Data()[element]) > tolerance))
+            {
+                pass = false;
+            }
+        }
+    }
+    else
+    {
+        pass = compareNorm<T>(gradIn, gradIn_ref, tolerance) &&
+               compareNorm<T>(gradGamma, gradGamma_ref, tolerance);
+        if (!rmsNorm)
+        {
+            pass = pass && compareNorm<T>(gradBeta, gradBeta_ref, tolerance);
+        }
+    }
+
+    if (!pass)
+    {
+        std::cout << testName << " test failed!!" << std::endl;
+        return -1;
+    }
+
+    std::cout << testName << " test pass!!" << std::endl;
+    return 0;
+}
+
+int LayerNormAllGaudi2Test::runTest(Gaudi2_Kernel_Name_e NameofKernel)
+{
+    switch (NameofKernel)
+    {
+        case GAUDI2_KERNEL_LAYER_NORM_FWD_F32:
+            return runNormTest<float>(NameofKernel, false, false, false);
+        case GAUDI2_KERNEL_LAYER_NORM_FWD_BF16:
+            return runNormTest<bfloat16>(NameofKernel, false, false, false);
+        case GAUDI2_KERNEL_LAYER_NORM_RESIDUAL_FWD_F32:
+            return runNormTest<float>(NameofKernel, false, true, false);
+        case GAUDI2_KERNEL_LAYER_NORM_RESIDUAL_FWD_BF16:
+            return runNormTest<bfloat16>(NameofKernel, false, true, false);
+        case GAUDI2_KERNEL_LAYER_NORM_BWD_F32:
+            return runNormTest<float>(NameofKernel, false, false, true);
+        case GAUDI2_KERNEL_LAYER_NORM_BWD_BF16:
+            // 2048 rows per parameter gradient catch a bf16 accumulation
+            if (runNormTest<bfloat16>(NameofKernel, false, false, true) != 0)
+                return -1;
+            TearDown();
+            SetUp();
+            return runNormTest<bfloat16>(NameofKernel, false, false, true, 1024);
+        case GAUDI2_KERNEL_RMS_NORM_FWD_F32:
+            return runNormTest<float>(NameofKernel, true, false, false);
+        case GAUDI2_KERNEL_RMS_NORM_FWD_BF16:
+            return runNormTest<bfloat16>(NameofKernel, true, false, false);
+        case GAUDI2_KERNEL_RMS_NORM_RESIDUAL_FWD_F32:
+            return runNormTest<float>(NameofKernel, true, true, false);
+        case GAUDI2_KERNEL_RMS_NORM_RESIDUAL_FWD_BF16:
+            return runNormTest<bfloat16>(NameofKernel, true, true, false);
+        case GAUDI2_KERNEL_RMS_NORM_BWD_F32:
+            return runNormTest<float>(NameofKernel, true, false, true);
+        case GAUDI2_KERNEL_RMS_NORM_BWD_BF16:
+            if (runNormTest<bfloat16>(NameofKernel, true, false, true) != 0)
+                return -1;
+            TearDown();
+            SetUp();
+            return runNormTest<bfloat16>(NameofKernel, true, false, true, 1024);
+        default:
+            std::cout << "Unsupported layer norm kernel " << NameofKernel << std::endl;
+            return -1;
+    }
+}
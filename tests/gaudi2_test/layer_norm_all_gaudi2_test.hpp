@@ -0,0 +1,68 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef LAYER_NORM_ALL_GAUDI2_TEST_HPP
+#define LAYER_NORM_ALL_GAUDI2_TEST_HPP
+
+#include "test_base.hpp"
+#include "tensor.h"
+#include "layer_norm_all_gaudi2.hpp"
+#include "entry_points.hpp"
+
+class LayerNormAllGaudi2Test : public TestBase
+{
+public:
+    LayerNormAllGaudi2Test() {}
+    ~LayerNormAllGaudi2Test() {}
+    int runTest(Gaudi2_Kernel_Name_e NameofKernel);
+
+    template <class T>
+    static void layer_norm_fwd_reference_implementation(
+            test::Tensor<T,3>& ifm,
+            test::Tensor<T,3>& residual,
+            test::Tensor<T,1>& gamma,
+            test::Tensor<T,1>& beta,
+            test::Tensor<T,3>& ofm,
+            float_3DTensor& mean,
+            float_3DTensor& rstd,
+            test::Tensor<T,3>& residualOut,
+            float epsilon, bool rmsNorm, bool fuseResidual);
+
+    template <class T>
+    static void layer_norm_bwd_reference_implementation(
+            test::Tensor<T,3>& gradOut,
+            test::Tensor<T,3>& ifm,
+            test::Tensor<T,1>& gamma,
+            float_3DTensor& mean,
+            float_3DTensor& rstd,
+            test::Tensor<T,3>& gradIn,
+            test::Tensor<T,1>& gradGamma,
+            test::Tensor<T,1>& gradBeta,
+            bool rmsNorm);
+
+private:
+    template <class T>
+    int runNormTest(Gaudi2_Kernel_Name_e NameofKernel, bool rmsNorm, bool fuseResidual, bool backward,
+                    int height = 6);
+    template <class T>
+    int runParamReduce(float_3DTensor& partials, test::Tensor<T,1>& paramGrad);
+
+    LayerNormAllGaudi2Test(const LayerNormAllGaudi2Test& other) = delete;
+    LayerNormAllGaudi2Test& operator=(const LayerNormAllGaudi2Test& other) = delete;
+};
+
+
+#endif /* LAYER_NORM_ALL_GAUDI2_TEST_HPP */
@@ -0,0 +1,323 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <numeric>
+#include <vector>
+#include "paged_kv_cache_gaudi2_test.hpp"
+
+// cache geometry shared by the tests
+static const uint64_t c_headDim   = 128;
+static const uint64_t c_heads     = 4;
+static const uint64_t c_blockSize = 16;
+static const uint64_t c_numBlocks = 40;
+static const uint64_t c_numSeqs   = 5;
+static const uint64_t c_maxBlocks = 8;
+// ragged: a long one, a single token, a partial block, an empty one and an
+// exact block multiple
+static const int32_t c_contextLens[c_numSeqs] = {120, 1, 37, 0, 64};
+
+// values in [-4, 4], through float so that the fp8 types work too
+template <class T, int DIM>
+static void FillRand(test::Tensor<T,DIM>& tensor)
+{
+    for (int i = 0; i < tensor.ElementCount(); i++)
+    {
+        tensor.Data()[i] = T(-4.0f + 8.0f * (float)rand() / RAND_MAX);
+    }
+}
+
+template <class T>
+void PagedKvCacheGaudi2Test::paged_gather_reference_implementation(
+        test::Tensor<T,4>& cache,
+        test::Tensor<int32_t,2>& blockTable,
+        test::Tensor<int32_t,1>& contextLens,
+        test::Tensor<T,4>& ofm)
+{
+    const int blockSize = (int)cache.Size(2);
+    for (int s = 0; s < (int)ofm.Size(3); s++)
+    {
+        int lengthCoords[1] = {s};
+        const int contextLen = contextLens.ElementAt(lengthCoords);
+        for (int h = 0; h < (int)ofm.Size(2); h++)
+        {
+            for (int t = 0; t < (int)ofm.Size(1); t++)
+            {
+                int tableCoords[2] = {t / blockSize, s};
+                const int block = t < contextLen ? blockTable.ElementAt(tableCoords) : 0;
+                for (int d = 0; d < (int)ofm.Size(0); d++)
+                {
+                    int cacheCoords[4] = {d, h, t % blockSize, block};
+                    int coords[4] = {d, t, h, s};
+                    ofm.SetElement(coords, t < contextLen ? cache.ElementAt(cacheCoords) : T(0.0f));
+                }
+            }
+        }
+    }
+}
+
+template <class T>
+void PagedKvCacheGaudi2Test::paged_append_reference_implementation(
+        test::Tensor<T,3>& newTokens,
+        test::Tensor<int32_t,1>& slotMapping,
+        test::Tensor<T,4>& cache)
+{
+    const int blockSize = (int)cache.Size(2);
+    for (int i = 0; i < (int)newTokens.Size(2); i++)
+    {
+        int slotCoords[1] = {i};
+        const int slot = slotMapping.ElementAt(slotCoords);
+        if (slot < 0)
+        {
+            continue;
+        }
+        for (int h = 0; h < (int)newTokens.Size(1); h++)
+        {
+            for (int d = 0; d < (int)newTokens.Size(0); d++)
+            {
+                int coords[3] = {d, h, i};
+                int cacheCoords[4] = {d, h, slot % blockSize, slot / blockSize};
+                cache.SetElement(cacheCoords, newTokens.ElementAt(coords));
+            }
+        }
+    }
+}
+
+void PagedKvCacheGaudi2Test::BuildBlockTable(test::Tensor<int32_t,2>& blockTable,
+                                             test::Tensor<int32_t,1>& contextLens,
+                                             int blockSize, int numBlocks)
+{
+    std::vector<int32_t> blocks(numBlocks);
+    std::iota(blocks.begin(), blocks.end(), 0);
+    std::random_shuffle(blocks.begin(), blocks.end());
+
+    int next = 0;
+    for (int s = 0; s < (int)blockTable.Size(1); s++)
+    {
+        int lengthCoords[1] = {s};
+        const int contextLen = c_contextLens[s];
+        contextLens.SetElement(lengthCoords, contextLen);
+        for (int b = 0; b < (int)blockTable.Size(0); b++)
+        {
+            int tableCoords[2] = {b, s};
+            const bool used = b * blockSize < contextLen;
+            blockTable.SetElement(tableCoords, used ? blocks[next++] : -1);
+        }
+    }
+}
+
+int PagedKvCacheGaudi2Test::Instantiate(Gaudi2_Kernel_Name_e NameofKernel)
+{
+    tpc_lib_api::GuidInfo *guids = nullptr;
+    unsigned kernelCount = 0;
+    tpc_lib_api::GlueCodeReturn result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    guids = new tpc_lib_api::GuidInfo[kernelCount];
+    result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "Can't get kernel name!! " << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    strcpy(m_in_defs.guid.name, guids[NameofKernel].name);
+    ReleaseKernelNames(guids, kernelCount);
+    result  = InstantiateTpcKernel(&m_in_defs,&m_out_defs);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "glue test failed!!" << result << std::endl;
+        return -1;
+    }
+    return 0;
+}
+
+template <class T>
+int PagedKvCacheGaudi2Test::runGatherTest(Gaudi2_Kernel_Name_e NameofKernel)
+{
+    // the output stops inside the last logical block
+    const uint64_t maxLen = 120;
+
+    uint64_t cacheInitializer[] = {c_headDim, c_heads, c_blockSize, c_numBlocks};
+    uint64_t tableInitializer[] = {c_maxBlocks, c_numSeqs};
+    uint64_t lengthsInitializer[] = {c_numSeqs};
+    uint64_t outInitializer[] = {c_headDim, maxLen, c_heads, c_numSeqs};
+
+    test::Tensor<T,4> keyCache(cacheInitializer);
+    FillRand(keyCache);
+    test::Tensor<T,4> valueCache(cacheInitializer);
+    FillRand(valueCache);
+    test::Tensor<int32_t,2> blockTable(tableInitializer);
+    test::Tensor<int32_t,1> contextLens(lengthsInitializer);
+    BuildBlockTable(blockTable, contextLens, c_blockSize, c_numBlocks);
+
+    // garbage in the outputs, the tail past the context must come out zero
+    test::Tensor<T,4> key(outInitializer);
+    FillRand(key);
+    test::Tensor<T,4> value(outInitializer);
+    FillRand(value);
+    test::Tensor<T,4> key_ref(outInitializer);
+    test::Tensor<T,4> value_ref(outInitializer);
+
+    // execute reference implementation of the kernel.
+    paged_gather_reference_implementation<T>(keyCache, blockTable, contextLens, key_ref);
+    paged_gather_reference_implementation<T>(valueCache, blockTable, contextLens, value_ref);
+
+    // generate input for query call
+    m_in_defs.deviceId = tpc_lib_api::DEVICE_ID_GAUDI2;
+
+    std::vector<TensorDesc2> vec;
+    vec.push_back(keyCache.GetTensorDescriptor());
+    vec.push_back(valueCache.GetTensorDescriptor());
+    vec.push_back(blockTable.GetTensorDescriptor());
+    vec.push_back(contextLens.GetTensorDescriptor());
+    vec.push_back(key.GetTensorDescriptor());
+    vec.push_back(value.GetTensorDescriptor());
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[0]), keyCache);
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[1]), valueCache);
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[2]), blockTable);
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[3]), contextLens);
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[0]), key);
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[1]), value);
+    m_in_defs.inputTensorNr = 4;
+    m_in_defs.outputTensorNr = 2;
+
+    if (Instantiate(NameofKernel) != 0)
+    {
+        return -1;
+    }
+
+    // execute a simulation of the kernel using TPC simulator,
+    const unsigned cycles = TestBase::RunSimulation(vec, m_in_defs, m_out_defs);
+
+    // bits are moved, the match is exact
+    const size_t bytes = key_ref.ElementCount() * sizeof(T);
+    if (memcmp(key.Data(), key_ref.Data(), bytes) != 0 ||
+        memcmp(value.Data(), value_ref.Data(), bytes) != 0)
+    {
+        std::cout << m_in_defs.guid.name << " test failed!!" << std::endl;
+        return -1;
+    }
+
+    const int tokens = std::accumulate(c_contextLens, c_contextLens + c_numSeqs, 0);
+    std::cout << m_in_defs.guid.name << " test pass!! " << (double)cycles / tokens
+              << " cycles per cached token" << std::endl;
+    return 0;
+}
+
+template <class T>
+int PagedKvCacheGaudi2Test::runAppendTest(Gaudi2_Kernel_Name_e NameofKernel)
+{
+    uint64_t cacheInitializer[] = {c_headDim, c_heads, c_blockSize, c_numBlocks};
+    uint64_t tableInitializer[] = {c_maxBlocks, c_numSeqs};
+    uint64_t lengthsInitializer[] = {c_numSeqs};
+
+    test::Tensor<int32_t,2> blockTable(tableInitializer);
+    test::Tensor<int32_t,1> contextLens(lengthsInitializer);
+    BuildBlockTable(blockTable, contextLens, c_blockSize, c_numBlocks);
+
+    // one decode step: every sequence appends the token before its context
+    // end, the last one on a block boundary; a padding token skips
+    std::vector<int32_t> slots;
+    for (int s = 0; s < (int)c_numSeqs; s++)
+    {
+        if (c_contextLens[s] == 0)
+        {
+            slots.push_back(-1);
+            continue;
+        }
+        const int pos = c_contextLens[s] - 1;
+        int tableCoords[2] = {pos / (int)c_blockSize, s};
+        slots.push_back(blockTable.ElementAt(tableCoords) * (int)c_blockSize + pos % (int)c_blockSize);
+    }
+    const uint64_t numTokens = slots.size();
+    uint64_t slotsInitializer[] = {numTokens};
+    uint64_t tokensInitializer[] = {c_headDim, c_heads, numTokens};
+
+    test::Tensor<int32_t,1> slotMapping(slotsInitializer, slots.data());
+    test::Tensor<T,3> newKey(tokensInitializer);
+    FillRand(newKey);
+    test::Tensor<T,3> newValue(tokensInitializer);
+    FillRand(newValue);
+
+    // the caches are updated in place, everything but the slots must stay
+    test::Tensor<T,4> keyCache(cacheInitializer);
+    FillRand(keyCache);
+    test::Tensor<T,4> valueCache(cacheInitializer);
+    FillRand(valueCache);
+    test::Tensor<T,4> keyCache_ref(cacheInitializer, keyCache.Data());
+    test::Tensor<T,4> valueCache_ref(cacheInitializer, valueCache.Data());
+
+    // execute reference implementation of the kernel.
+    paged_append_reference_implementation<T>(newKey, slotMapping, keyCache_ref);
+    paged_append_reference_implementation<T>(newValue, slotMapping, valueCache_ref);
+
+    // generate input for query call
+    m_in_defs.deviceId = tpc_lib_api::DEVICE_ID_GAUDI2;
+
+    std::vector<TensorDesc2> vec;
+    vec.push_back(newKey.GetTensorDescriptor());
+    vec.push_back(newValue.GetTensorDescriptor());
+    vec.push_back(slotMapping.GetTensorDescriptor());
+    vec.push_back(keyCache.GetTensorDescriptor());
+    vec.push_back(valueCache.GetTensorDescriptor());
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[0]), newKey);
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[1]), newValue);
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[2]), slotMapping);
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[0]), keyCache);
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[1]), valueCache);
+    m_in_defs.inputTensorNr = 3;
+    m_in_defs.outputTensorNr = 2;
+
+    if (Instantiate(NameofKernel) != 0)
+    {
+        return -1;
+    }
+
+    // execute a simulation of the kernel using TPC simulator,
+    const unsigned cycles = TestBase::RunSimulation(vec, m_in_defs, m_out_defs);
+
+    const size_t bytes = keyCache_ref.ElementCount() * sizeof(T);
+    if (memcmp(keyCache.Data(), keyCache_ref.Data(), bytes) != 0 ||
+        memcmp(valueCache.Data(), valueCache_ref.Data(), bytes) != 0)
+    {
+        std::cout << m_in_defs.guid.name << " test failed!!" << std::endl;
+        return -1;
+    }
+
+    std::cout << m_in_defs.guid.name << " test pass!! " << (double)cycles / numTokens
+              << " cycles per appended token" << std::endl;
+    return 0;
+}
+
+int PagedKvCacheGaudi2Test::runTest(Gaudi2_Kernel_Name_e NameofKernel)
+{
+    switch (NameofKernel)
+    {
+        case GAUDI2_KERNEL_PAGED_KV_GATHER_BF16:
+            return runGatherTest<bfloat16>(NameofKernel);
+        case GAUDI2_KERNEL_PAGED_KV_GATHER_FP8:
+            return runGatherTest<float8_143>(NameofKernel);
+        case GAUDI2_KERNEL_PAGED_KV_APPEND_BF16:
+            return runAppendTest<bfloat16>(NameofKernel);
+        case GAUDI2_KERNEL_PAGED_KV_APPEND_FP8:
+            return runAppendTest<float8_152>(NameofKernel);
+        default:
+            std::cout << "Unsupported paged kv cache kernel " << NameofKernel << std::endl;
+            return -1;
+    }
+}
@@ -0,0 +1,67 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef PAGED_KV_CACHE_GAUDI2_TEST_HPP
+#define PAGED_KV_CACHE_GAUDI2_TEST_HPP
+
+#include "test_base.hpp"
+#include "tensor.h"
+#include "paged_kv_cache_gaudi2.hpp"
+#include "entry_points.hpp"
+
+class PagedKvCacheGaudi2Test : public TestBase
+{
+public:
+    PagedKvCacheGaudi2Test() {}
+    ~PagedKvCacheGaudi2Test() {}
+    int runTest(Gaudi2_Kernel_Name_e NameofKernel);
+
+    // key / value token t of sequence s from its cache block, zeros past the
+    // context length
+    template <class T>
+    static void paged_gather_reference_implementation(
+            test::Tensor<T,4>& cache,
+            test::Tensor<int32_t,2>& blockTable,
+            test::Tensor<int32_t,1>& contextLens,
+            test::Tensor<T,4>& ofm);
+
+    // new token i into slot slotMapping[i] of the cache, negative slots skip
+    template <class T>
+    static void paged_append_reference_implementation(
+            test::Tensor<T,3>& newTokens,
+            test::Tensor<int32_t,1>& slotMapping,
+            test::Tensor<T,4>& cache);
+
+private:
+    template <class T>
+    int runGatherTest(Gaudi2_Kernel_Name_e NameofKernel);
+    template <class T>
+    int runAppendTest(Gaudi2_Kernel_Name_e NameofKernel);
+
+    // ragged context lengths, each sequence gets its own shuffled blocks,
+    // unused table entries are -1
+    static void BuildBlockTable(test::Tensor<int32_t,2>& blockTable,
+                                test::Tensor<int32_t,1>& contextLens,
+                                int blockSize, int numBlocks);
+
+    int Instantiate(Gaudi2_Kernel_Name_e NameofKernel);
+
+    PagedKvCacheGaudi2Test(const PagedKvCacheGaudi2Test& other) = delete;
+    PagedKvCacheGaudi2Test& operator=(const PagedKvCacheGaudi2Test& other) = delete;
+};
+
+
+#endif /* PAGED_KV_CACHE_GAUDI2_TEST_HPP */
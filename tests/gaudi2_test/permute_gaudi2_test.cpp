@@ -0,0 +1,136 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cstring>
+#include "permute_gaudi2_test.hpp"
+
+template <class T>
+void PermuteGaudi2Test::permute_reference_implementation(
+        test::Tensor<T,5>& ifm,
+        test::Tensor<T,5>& ofm,
+        const int perm[5])
+{
+    int ofmCoords[5] = {0};
+    int ifmCoords[5] = {0};
+    for (ofmCoords[4] = 0; ofmCoords[4] < (int)ofm.Size(4); ofmCoords[4]++)
+    for (ofmCoords[3] = 0; ofmCoords[3] < (int)ofm.Size(3); ofmCoords[3]++)
+    for (ofmCoords[2] = 0; ofmCoords[2] < (int)ofm.Size(2); ofmCoords[2]++)
+    for (ofmCoords[1] = 0; ofmCoords[1] < (int)ofm.Size(1); ofmCoords[1]++)
+    for (ofmCoords[0] = 0; ofmCoords[0] < (int)ofm.Size(0); ofmCoords[0]++)
+    {
+        for (int dim = 0; dim < 5; dim++)
+        {
+            ifmCoords[perm[dim]] = ofmCoords[dim];
+        }
+        ofm.SetElement(ofmCoords, ifm.ElementAt(ifmCoords));
+    }
+}
+
+template <class T>
+int PermuteGaudi2Test::runPermuteTest(PermuteGaudi2::Permute_mode_t mode, const int perm[5],
+                                      const uint64_t sizes[5])
+{
+    uint64_t ofmSizes[5];
+    for (int dim = 0; dim < 5; dim++)
+    {
+        ofmSizes[dim] = sizes[perm[dim]];
+    }
+
+    // The kernel moves bits only. Every element gets a distinct pattern,
+    // NaN patterns included, so a misplaced element can't go unnoticed.
+    // 8 bit patterns repeat every 256 elements, one tile row.
+    test::Tensor<T,5> ifm(sizes);
+    for (int element = 0; element < ifm.ElementCount(); element++)
+    {
+        uint32_t bits = (uint32_t)element * 2654435761u;
+        memcpy((void*)&ifm.Data()[element], &bits, sizeof(T));
+    }
+
+    test::Tensor<T,5> ofm(ofmSizes);
+    test::Tensor<T,5> ofm_ref(ofmSizes);
+
+    // execute reference implementation of the kernel.
+    permute_reference_implementation<T>(ifm, ofm_ref, perm);
+
+    // generate input for query call
+    PermuteGaudi2::PermuteParams def;
+    memcpy(def.perm, perm, sizeof(def.perm));
+
+    m_in_defs.deviceId = tpc_lib_api::DEVICE_ID_GAUDI2;
+    m_in_defs.nodeParams.nodeParams = &def;
+    m_in_defs.inputTensorNr = 1;
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[0]), ifm);
+    m_in_defs.outputTensorNr = 1;
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[0]), ofm);
+
+    tpc_lib_api::GuidInfo *guids = nullptr;
+    unsigned kernelCount = 0;
+    tpc_lib_api::GlueCodeReturn result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    guids = new tpc_lib_api::GuidInfo[kernelCount];
+    result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "Can't get kernel name!! " << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    strcpy(m_in_defs.guid.name, guids[GAUDI2_KERNEL_PERMUTE_F32 + mode].name);
+    result  = InstantiateTpcKernel(&m_in_defs,&m_out_defs);
+    ReleaseKernelNames(guids, kernelCount);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "glue test failed!!" << result << std::endl;
+        return -1;
+    }
+
+    // generate and load tensor descriptors
+    std::vector<TensorDesc2> vec;
+    vec.push_back(ifm.GetTensorDescriptor());
+    vec.push_back(ofm.GetTensorDescriptor());
+
+    // execute a simulation of the kernel using TPC simulator,
+    TestBase::RunSimulation(vec, m_in_defs, m_out_defs);
+
+    if (memcmp(ofm.Data(), ofm_ref.Data(), ofm.ElementCount() * sizeof(T)) != 0)
+    {
+        std::cout << m_in_defs.guid.name << " test failed for perm {" << perm[0] << "," << perm[1] << ","
+                  << perm[2] << "," << perm[3] << "," << perm[4] << "}!!" << std::endl;
+        return -1;
+    }
+
+    std::cout << m_in_defs.guid.name << " test pass!!" << std::endl;
+    return 0;
+}
+
+int PermuteGaudi2Test::runTest(PermuteGaudi2::Permute_mode_t mode, const int perm[5],
+                               const uint64_t sizes[5])
+{
+    switch (mode)
+    {
+        case PermuteGaudi2::permute_f32:  return runPermuteTest<float>(mode, perm, sizes);
+        case PermuteGaudi2::permute_i32:  return runPermuteTest<int32_t>(mode, perm, sizes);
+        case PermuteGaudi2::permute_bf16: return runPermuteTest<bfloat16>(mode, perm, sizes);
+        case PermuteGaudi2::permute_f16:  return runPermuteTest<float16>(mode, perm, sizes);
+        case PermuteGaudi2::permute_i8:   return runPermuteTest<int8_t>(mode, perm, sizes);
+        case PermuteGaudi2::permute_u8:   return runPermuteTest<uint8_t>(mode, perm, sizes);
+        case PermuteGaudi2::permute_f8_143: return runPermuteTest<float8_143>(mode, perm, sizes);
+        case PermuteGaudi2::permute_f8_152: return runPermuteTest<float8_152>(mode, perm, sizes);
+        default:
+            std::cout << "Unsupported permute mode " << mode << std::endl;
+            return -1;
+    }
+}
@@ -0,0 +1,48 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef PERMUTE_GAUDI2_TEST_HPP
+#define PERMUTE_GAUDI2_TEST_HPP
+
+#include "test_base.hpp"
+#include "tensor.h"
+#include "permute_gaudi2.hpp"
+#include "entry_points.hpp"
+
+class PermuteGaudi2Test : public TestBase
+{
+public:
+    PermuteGaudi2Test() {}
+    ~PermuteGaudi2Test() {}
+    // ofm dim i = ifm dim perm[i], sizes are the ifm sizes
+    int runTest(PermuteGaudi2::Permute_mode_t mode, const int perm[5], const uint64_t sizes[5]);
+
+    template <class T>
+    static void permute_reference_implementation(
+        test::Tensor<T,5>& ifm,
+        test::Tensor<T,5>& ofm,
+        const int perm[5]);
+
+private:
+    template <class T>
+    int runPermuteTest(PermuteGaudi2::Permute_mode_t mode, const int perm[5], const uint64_t sizes[5]);
+
+    PermuteGaudi2Test(const PermuteGaudi2Test& other) = delete;
+    PermuteGaudi2Test& operator=(const PermuteGaudi2Test& other) = delete;
+};
+
+
+#endif /* PERMUTE_GAUDI2_TEST_HPP */
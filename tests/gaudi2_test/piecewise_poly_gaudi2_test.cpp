@@ -0,0 +1,157 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+#include "piecewise_poly_gaudi2_test.hpp"
+
+typedef PiecewisePolyGaudi2 Pwp;
+
+static double softplus(double x) { return log1p(exp(x)); }
+static double mish(double x)     { return x * tanh(log1p(exp(x))); }
+static double gelu(double x)     { return 0.5 * x * (1.0 + erf(x / sqrt(2.0))); }
+static double tanhRef(double x)  { return tanh(x); }
+
+int PiecewisePolyGaudi2Test::runTest(Activation_t activation, int intervals, int degree)
+{
+    static const char* const c_names[act_count] = {"softplus", "mish", "gelu", "tanh samples"};
+    static double (* const c_functions[act_count])(double) = {softplus, mish, gelu, tanhRef};
+    const float lo = -8.0f;
+    const float hi = 8.0f;
+
+    Pwp::PiecewisePolyParams def;
+    double fitError = 0.0;
+    tpc_lib_api::GlueCodeReturn result;
+    if (activation == act_tanh_samples)
+    {
+        const int sampleCount = 1024;
+        std::vector<float> x(sampleCount);
+        std::vector<float> y(sampleCount);
+        for (int k = 0; k < sampleCount; k++)
+        {
+            x[k] = lo + (hi - lo) * k / (sampleCount - 1);
+            y[k] = (float)tanh(x[k]);
+        }
+        result = Pwp::FitSamples(x.data(), y.data(), sampleCount, intervals, degree, &def, &fitError);
+    }
+    else
+    {
+        result = Pwp::FitFunction(c_functions[activation], lo, hi, intervals, degree, &def, &fitError);
+    }
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "piecewise poly fit failed!! " << result << std::endl;
+        return -1;
+    }
+
+    // deterministic grid a bit past [lo, hi] so the tails run too
+    const uint64_t fmInitializer[] = {256, 8, 2, 1, 1};
+    float_5DTensor input(fmInitializer);
+    float_5DTensor output(fmInitializer);
+    const int count = input.ElementCount();
+    for (int element = 0; element < count; element++)
+    {
+        input.Data()[element] = -10.0f + 20.0f * element / (count - 1);
+    }
+    input.Data()[0] = std::numeric_limits<float>::quiet_NaN();
+
+    // generate input for query call
+    m_in_defs.deviceId = tpc_lib_api::DEVICE_ID_GAUDI2;
+    m_in_defs.nodeParams.nodeParams = (void*)&def;
+    m_in_defs.inputTensorNr = 1;
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[0]), input);
+    m_in_defs.outputTensorNr = 1;
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[0]), output);
+
+    tpc_lib_api::GuidInfo *guids = nullptr;
+    unsigned kernelCount = 0;
+    result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    guids = new tpc_lib_api::GuidInfo[kernelCount];
+    result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "Can't get kernel name!! " << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    strcpy(m_in_defs.guid.name, guids[GAUDI2_KERNEL_PIECEWISE_POLY_F32].name);
+    result  = InstantiateTpcKernel(&m_in_defs,&m_out_defs);
+
+    // Declaration of auxiliary tensor
+    float_1DTensor aux_tensor({Pwp::c_lutSize});
+    // Allocate memory for aux tensor if not allocated
+    if (result == tpc_lib_api::GLUE_INSUFFICIENT_AUX_BUFFER_SIZE)
+    {
+        if (m_out_defs.auxiliaryTensors[0].pData)
+        {
+            delete [] (int8_t*)m_out_defs.auxiliaryTensors[0].pData;
+            m_out_defs.auxiliaryTensors[0].pData = NULL;
+        }
+
+        m_out_defs.auxiliaryTensors[0].pData =
+                                    new float[m_out_defs.auxiliaryTensors[0].bufferSize / sizeof(float)];
+        // second call of glue-code to load Auxiliary data.
+        result  = InstantiateTpcKernel(&m_in_defs,&m_out_defs);
+        // AUXILIARY TENSOR init based on parameters got from glue code
+        aux_tensor.Init(m_out_defs.auxiliaryTensors[0].geometry.maxSizes,
+                                    (float*)m_out_defs.auxiliaryTensors[0].pData);
+    }
+    ReleaseKernelNames(guids, kernelCount);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "glue test failed!!" << result << std::endl;
+        return -1;
+    }
+
+    // generate and load tensor descriptors
+    std::vector<TensorDesc2> vec;
+    vec.push_back(input.GetTensorDescriptor());
+    vec.push_back(output.GetTensorDescriptor());
+    vec.push_back(aux_tensor.GetTensorDescriptor());
+
+    // execute a simulation of the kernel using TPC simulator,
+    const unsigned cycles = TestBase::RunSimulation(vec, m_in_defs, m_out_defs);
+
+    // the kernel must follow the host model of the fit, up to the fused
+    // multiply add
+    double worstError = 0.0;
+    for (int element = 0; element < count; element++)
+    {
+        const float x = input.Data()[element];
+        const float out = output.Data()[element];
+        const float model = Pwp::Evaluate(def, x);
+        if (std::isnan(x) ? !std::isnan(out) : fabs(out - model) > 1e-5 * (1.0 + fabs(model)))
+        {
+            std::cout << m_in_defs.guid.name << " " << c_names[activation] << " test failed at x = "
+                      << x << ": " << out << " vs " << model << "!!" << std::endl;
+            return -1;
+        }
+        if (x >= lo && x <= hi)
+        {
+            const double error = fabs(out - c_functions[activation](x));
+            worstError = error > worstError ? error : worstError;
+        }
+    }
+
+    std::cout << m_in_defs.guid.name << " " << c_names[activation] << " " << intervals << "x"
+              << degree << ": fitted max error " << fitError << ", kernel max error " << worstError
+              << ", " << (double)cycles / count << " cycles per element" << std::endl;
+    std::cout << m_in_defs.guid.name << " " << c_names[activation] << " test pass!!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,241 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "quantize_i8_gaudi2_test.hpp"
+
+typedef QuantizeI8Gaudi2 Quant;
+
+int8_t QuantizeI8Gaudi2Test::quantize_reference(float x, float mul, float zeroPoint)
+{
+    // std::nearbyint rounds half to even in the default rounding mode, the
+    // zero point is added after rounding as in the kernel
+    float q = std::nearbyint(x * mul) + zeroPoint;
+    return (int8_t)std::min(std::max(q, -128.0f), 127.0f);
+}
+
+template <class T>
+int QuantizeI8Gaudi2Test::runQuantizeTest(Quant::QuantizeI8_mode_t mode, int param)
+{
+    Quant modeInfo(mode);
+    const bool dequant = modeInfo.IsDequant();
+    const bool perChannel = modeInfo.IsPerChannel();
+    const bool zeroPointTensor = modeInfo.HasZeroPointTensor();
+    const bool dynamic = modeInfo.IsDynamic();
+    const int axis = perChannel ? param : 0;
+
+    // dim 0 ends in a partial vector
+    uint64_t fmInitializer[] = {300, 4, 3};
+    uint64_t channelInitializer[] = {fmInitializer[axis]};
+    uint64_t rowInitializer[] = {1, 4, 3};
+
+    test::Tensor<T,3> wide(fmInitializer);
+    test::Tensor<T,3> wide_ref(fmInitializer);
+    int8_3DTensor q(fmInitializer);
+    int8_3DTensor q_ref(fmInitializer);
+    // per channel scales, or the per row outputs of the dynamic mode
+    float_1DTensor scale(channelInitializer);
+    int32_1DTensor zeroPoint(channelInitializer);
+    float_3DTensor rowScale(rowInitializer);
+    float_3DTensor rowScale_ref(rowInitializer);
+    int32_3DTensor rowZeroPoint(rowInitializer);
+    int32_3DTensor rowZeroPoint_ref(rowInitializer);
+
+    const float tensorScale = 0.05f;
+    const int tensorZeroPoint = -3;
+    for (unsigned c = 0; c < channelInitializer[0]; c++)
+    {
+        scale.Data()[c] = 0.01f * (1 + c % 7);
+        zeroPoint.Data()[c] = zeroPointTensor ? (int)(c % 11) - 5 : 0;
+    }
+
+    // the smaller channel scales push the input past the int8 range
+    wide.InitRand(-4.0f, 3.0f);
+    // every code, in a scrambled order
+    for (int element = 0; element < q.ElementCount(); element++)
+    {
+        q.Data()[element] = (int8_t)((element * 37) % 256 - 128);
+    }
+
+    // execute reference implementation of the kernel.
+    int coords[3];
+    for (coords[2] = 0; coords[2] < (int)fmInitializer[2]; coords[2]++)
+    {
+        for (coords[1] = 0; coords[1] < (int)fmInitializer[1]; coords[1]++)
+        {
+            float mul = 1.0f / tensorScale;
+            float zp = (float)tensorZeroPoint;
+            if (dynamic)
+            {
+                // the range always includes 0
+                float minV = 0.0f, maxV = 0.0f;
+                for (coords[0] = 0; coords[0] < (int)fmInitializer[0]; coords[0]++)
+                {
+                    minV = std::min(minV, (float)wide.ElementAt(coords));
+                    maxV = std::max(maxV, (float)wide.ElementAt(coords));
+                }
+                float s = param ? std::max(maxV, -minV) / 127.0f : (maxV - minV) / 255.0f;
+                s = (s == 0.0f) ? 1.0f : s;
+                mul = 1.0f / s;
+                zp = param ? 0.0f : std::nearbyint(-128.0f - minV * mul);
+                int rowCoords[3] = {0, coords[1], coords[2]};
+                rowScale_ref.SetElement(rowCoords, s);
+                rowZeroPoint_ref.SetElement(rowCoords, (int)zp);
+            }
+
+            for (coords[0] = 0; coords[0] < (int)fmInitializer[0]; coords[0]++)
+            {
+                if (perChannel)
+                {
+                    mul = 1.0f / scale.Data()[coords[axis]];
+                    zp = (float)zeroPoint.Data()[coords[axis]];
+                }
+                if (dequant)
+                {
+                    const float s = perChannel ? scale.Data()[coords[axis]] : tensorScale;
+                    wide_ref.SetElement(coords, (T)((q.ElementAt(coords) - zp) * s));
+                }
+                else
+                {
+                    q_ref.SetElement(coords, quantize_reference((float)wide.ElementAt(coords), mul, zp));
+                }
+            }
+        }
+    }
+
+    // generate input for query call
+    m_in_defs.deviceId = tpc_lib_api::DEVICE_ID_GAUDI2;
+    std::vector<TensorDesc2> vec;
+
+    m_in_defs.inputTensorNr = 0;
+    if (dequant)
+    {
+        LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[m_in_defs.inputTensorNr]), q);
+        m_in_defs.inputTensors[m_in_defs.inputTensorNr].quantizationParam.scale = tensorScale;
+        m_in_defs.inputTensors[m_in_defs.inputTensorNr++].quantizationParam.zeroPoint = tensorZeroPoint;
+        vec.push_back(q.GetTensorDescriptor());
+    }
+    else
+    {
+        LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[m_in_defs.inputTensorNr++]), wide);
+        vec.push_back(wide.GetTensorDescriptor());
+    }
+    if (perChannel)
+    {
+        LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[m_in_defs.inputTensorNr++]), scale);
+        vec.push_back(scale.GetTensorDescriptor());
+    }
+    if (zeroPointTensor)
+    {
+        LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[m_in_defs.inputTensorNr++]), zeroPoint);
+        vec.push_back(zeroPoint.GetTensorDescriptor());
+    }
+
+    m_in_defs.outputTensorNr = 0;
+    if (dequant)
+    {
+        LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[m_in_defs.outputTensorNr++]), wide);
+        vec.push_back(wide.GetTensorDescriptor());
+    }
+    else
+    {
+        LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[m_in_defs.outputTensorNr]), q);
+        m_in_defs.outputTensors[m_in_defs.outputTensorNr].quantizationParam.scale = tensorScale;
+        m_in_defs.outputTensors[m_in_defs.outputTensorNr++].quantizationParam.zeroPoint = tensorZeroPoint;
+        vec.push_back(q.GetTensorDescriptor());
+    }
+    if (dynamic)
+    {
+        LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[m_in_defs.outputTensorNr++]), rowScale);
+        vec.push_back(rowScale.GetTensorDescriptor());
+        LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[m_in_defs.outputTensorNr++]), rowZeroPoint);
+        vec.push_back(rowZeroPoint.GetTensorDescriptor());
+    }
+
+    Quant::QuantizeI8Params def;
+    def.axis = axis;
+    def.symmetric = param;
+    m_in_defs.nodeParams.nodeParams = &def;
+
+    tpc_lib_api::GuidInfo *guids = nullptr;
+    unsigned kernelCount = 0;
+    tpc_lib_api::GlueCodeReturn result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    guids = new tpc_lib_api::GuidInfo[kernelCount];
+    result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "Can't get kernel name!! " << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    strcpy(m_in_defs.guid.name, guids[GAUDI2_KERNEL_QUANTIZE_I8_TENSOR_F32 + mode].name);
+    result  = InstantiateTpcKernel(&m_in_defs,&m_out_defs);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "glue test failed!!" << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    // execute a simulation of the kernel using TPC simulator,
+    TestBase::RunSimulation(vec, m_in_defs, m_out_defs);
+
+    // the kernels use a reciprocal instruction, which may move a value
+    // sitting on a rounding boundary by one step
+    bool passed = true;
+    for (int element = 0; element < q_ref.ElementCount() && passed; element++)
+    {
+        if (dequant)
+        {
+            float a = (float)wide.Data()[element];
+            float b = (float)wide_ref.Data()[element];
+            passed = std::abs(a - b) <= 1e-2f * std::abs(b) + 1e-6f;
+        }
+        else
+        {
+            passed = std::abs(q.Data()[element] - q_ref.Data()[element]) <= 1;
+        }
+    }
+    for (int element = 0; dynamic && element < rowScale_ref.ElementCount() && passed; element++)
+    {
+        passed = std::abs(rowScale.Data()[element] - rowScale_ref.Data()[element]) <=
+                         1e-6f * rowScale_ref.Data()[element] &&
+                 std::abs(rowZeroPoint.Data()[element] - rowZeroPoint_ref.Data()[element]) <= 1;
+    }
+
+    if (!passed)
+    {
+        std::cout << m_in_defs.guid.name << " test failed!!" << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    std::cout << m_in_defs.guid.name << " test pass!!" << std::endl;
+    ReleaseKernelNames(guids, kernelCount);
+    return 0;
+}
+
+int QuantizeI8Gaudi2Test::runTest(Quant::QuantizeI8_mode_t mode, int param)
+{
+    if (mode % 2 == 1)
+    {
+        return runQuantizeTest<bfloat16>(mode, param);
+    }
+    return runQuantizeTest<float>(mode, param);
+}
@@ -0,0 +1,46 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef QUANTIZE_I8_GAUDI2_TEST_HPP
+#define QUANTIZE_I8_GAUDI2_TEST_HPP
+
+#include "test_base.hpp"
+#include "tensor.h"
+#include "quantize_i8_gaudi2.hpp"
+#include "entry_points.hpp"
+
+class QuantizeI8Gaudi2Test : public TestBase
+{
+public:
+    QuantizeI8Gaudi2Test() {}
+    ~QuantizeI8Gaudi2Test() {}
+    // param is the axis of the channel modes and the symmetric flag of the
+    // dynamic modes, unused otherwise
+    int runTest(QuantizeI8Gaudi2::QuantizeI8_mode_t mode, int param);
+
+    // q = clamp(round(x * mul) + zeroPoint), the kernels multiply by 1 / scale
+    static int8_t quantize_reference(float x, float mul, float zeroPoint);
+
+private:
+    template <class T>
+    int runQuantizeTest(QuantizeI8Gaudi2::QuantizeI8_mode_t mode, int param);
+
+    QuantizeI8Gaudi2Test(const QuantizeI8Gaudi2Test& other) = delete;
+    QuantizeI8Gaudi2Test& operator=(const QuantizeI8Gaudi2Test& other) = delete;
+};
+
+
+#endif /* QUANTIZE_I8_GAUDI2_TEST_HPP */
@@ -0,0 +1,261 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include "reduction_gaudi2_test.hpp"
+
+typedef ReductionGaudi2 Reduce;
+
+static float toFloat(float x)    { return x; }
+static float toFloat(bfloat16 x) { return bf16ToFloat(x.val); }
+
+template <class T>
+int ReductionGaudi2Test::runReduceTest(Reduce::Reduction_mode_t mode,
+                                       const Reduce::ReductionParams& def,
+                                       const uint64_t sizes[5], float offset, float step)
+{
+    uint64_t ofmSizes[5];
+    for (int dim = 0; dim < 5; dim++)
+    {
+        ofmSizes[dim] = ((def.axisMask >> dim) & 1) ? 1 : sizes[dim];
+    }
+
+    test::Tensor<T,5> ifm(sizes);
+    for (int element = 0; element < ifm.ElementCount(); element++)
+    {
+        ifm.Data()[element] = (T)(offset + ((element * 37) % 161 - 80) * step);
+    }
+
+    test::Tensor<T,5> ofm(ofmSizes);
+
+    // execute reference implementation of the kernel in double, two passes
+    // for the variance
+    const int outCount = ofm.ElementCount();
+    std::vector<double> sum(outCount, 0.0), absSum(outCount, 0.0), prod(outCount, 1.0);
+    std::vector<double> maxVal(outCount, -INFINITY), minVal(outCount, INFINITY), m2(outCount, 0.0);
+    int coords[5] = {0};
+    for (int pass = 0; pass < 2; pass++)
+    {
+        for (coords[4] = 0; coords[4] < (int)sizes[4]; coords[4]++)
+        for (coords[3] = 0; coords[3] < (int)sizes[3]; coords[3]++)
+        for (coords[2] = 0; coords[2] < (int)sizes[2]; coords[2]++)
+        for (coords[1] = 0; coords[1] < (int)sizes[1]; coords[1]++)
+        for (coords[0] = 0; coords[0] < (int)sizes[0]; coords[0]++)
+        {
+            int out = 0;
+            int stride = 1;
+            for (int dim = 0; dim < 5; dim++)
+            {
+                out += (((def.axisMask >> dim) & 1) ? 0 : coords[dim]) * stride;
+                stride *= (int)ofmSizes[dim];
+            }
+            const double x = toFloat(ifm.ElementAt(coords));
+            if (pass == 0)
+            {
+                sum[out] += x;
+                absSum[out] += fabs(x);
+                prod[out] *= x;
+                maxVal[out] = std::max(maxVal[out], x);
+                minVal[out] = std::min(minVal[out], x);
+            }
+            else
+            {
+                const double mean = sum[out] * outCount / ifm.ElementCount();
+                m2[out] += (x - mean) * (x - mean);
+            }
+        }
+    }
+
+    // generate input for query call
+    m_in_defs.deviceId = tpc_lib_api::DEVICE_ID_GAUDI2;
+    m_in_defs.nodeParams.nodeParams = (void*)&def;
+    m_in_defs.inputTensorNr = 1;
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[0]), ifm);
+    m_in_defs.outputTensorNr = 1;
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[0]), ofm);
+
+    tpc_lib_api::GuidInfo *guids = nullptr;
+    unsigned kernelCount = 0;
+    tpc_lib_api::GlueCodeReturn result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    guids = new tpc_lib_api::GuidInfo[kernelCount];
+    result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "Can't get kernel name!! " << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    strcpy(m_in_defs.guid.name, guids[GAUDI2_KERNEL_REDUCE_F32 + mode].name);
+    result  = InstantiateTpcKernel(&m_in_defs,&m_out_defs);
+    ReleaseKernelNames(guids, kernelCount);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "glue test failed!!" << result << std::endl;
+        return -1;
+    }
+
+    // generate and load tensor descriptors
+    std::vector<TensorDesc2> vec;
+    vec.push_back(ifm.GetTensorDescriptor());
+    vec.push_back(ofm.GetTensorDescriptor());
+
+    // execute a simulation of the kernel using TPC simulator,
+    TestBase::RunSimulation(vec, m_in_defs, m_out_defs);
+
+    // the kernel sums in a different order and in f32, bf16 outputs are
+    // rounded once more
+    const double rtol = (mode == Reduce::reduce_bf16) ? 1.0 / 128 : 1e-4;
+    const double count = (double)ifm.ElementCount() / outCount;
+    for (int element = 0; element < outCount; element++)
+    {
+        double ref = 0;
+        double tol = 0;
+        switch (def.op)
+        {
+            case Reduce::reduce_sum:
+                ref = sum[element];
+                tol = rtol * absSum[element];
+                break;
+            case Reduce::reduce_mean:
+                ref = sum[element] / count;
+                tol = rtol * absSum[element] / count;
+                break;
+            case Reduce::reduce_max:
+                ref = maxVal[element];
+                break;
+            case Reduce::reduce_min:
+                ref = minVal[element];
+                break;
+            case Reduce::reduce_prod:
+                ref = prod[element];
+                tol = rtol * fabs(ref);
+                break;
+            case Reduce::reduce_var:
+            case Reduce::reduce_std:
+                ref = m2[element] / (count - def.correction);
+                if (def.op == Reduce::reduce_std)
+                    ref = sqrt(ref);
+                tol = rtol * fabs(ref);
+                break;
+            default:
+                break;
+        }
+
+        const double out = toFloat(ofm.Data()[element]);
+        if (fabs(out - ref) > tol + 1e-6 * fabs(ref))
+        {
+            std::cout << m_in_defs.guid.name << " op " << def.op << " test failed at element "
+                      << element << ": " << out << " vs " << ref << "!!" << std::endl;
+            return -1;
+        }
+    }
+
+    std::cout << m_in_defs.guid.name << " op " << def.op << " test pass!!" << std::endl;
+    return 0;
+}
+
+int ReductionGaudi2Test::runTest(int testCase)
+{
+    Reduce::ReductionParams def;
+    memset(&def, 0, sizeof(def));
+    def.strategy = Reduce::reduce_strategy_auto;
+
+    switch (testCase)
+    {
+        case 0:
+        {
+            // sum over dim 1, dim 0 is kept
+            const uint64_t sizes[5] = {150, 7, 3, 1, 1};
+            def.op = Reduce::reduce_sum;
+            def.axisMask = 0x2;
+            return runReduceTest<float>(Reduce::reduce_f32, def, sizes, 0.0f, 0.11f);
+        }
+        case 1:
+        {
+            // mean over dims 0 and 2, lanes are folded
+            const uint64_t sizes[5] = {200, 3, 5, 2, 1};
+            def.op = Reduce::reduce_mean;
+            def.axisMask = 0x5;
+            return runReduceTest<float>(Reduce::reduce_f32, def, sizes, 0.0f, 0.11f);
+        }
+        case 2:
+        {
+            // sum over every dim, forced atomic RMW on the split dim
+            const uint64_t sizes[5] = {300, 40, 4, 1, 1};
+            def.op = Reduce::reduce_sum;
+            def.axisMask = 0x7;
+            def.strategy = Reduce::reduce_strategy_rmw;
+            return runReduceTest<float>(Reduce::reduce_f32, def, sizes, 0.0f, 0.11f);
+        }
+        case 3:
+        {
+            // large reduction with few outputs, the auto strategy goes RMW
+            const uint64_t sizes[5] = {256, 256, 2, 1, 1};
+            def.op = Reduce::reduce_mean;
+            def.axisMask = 0x3;
+            return runReduceTest<float>(Reduce::reduce_f32, def, sizes, 0.0f, 0.11f);
+        }
+        case 4:
+        {
+            // bf16 max over dim 0 with a partial last vector
+            const uint64_t sizes[5] = {130, 4, 3, 1, 1};
+            def.op = Reduce::reduce_max;
+            def.axisMask = 0x1;
+            return runReduceTest<bfloat16>(Reduce::reduce_bf16, def, sizes, 0.0f, 0.11f);
+        }
+        case 5:
+        {
+            // bf16 min over dims 1 and 3
+            const uint64_t sizes[5] = {70, 5, 2, 3, 1};
+            def.op = Reduce::reduce_min;
+            def.axisMask = 0xa;
+            return runReduceTest<bfloat16>(Reduce::reduce_bf16, def, sizes, 0.0f, 0.11f);
+        }
+        case 6:
+        {
+            // product over dim 2 of values close to 1
+            const uint64_t sizes[5] = {90, 3, 6, 1, 1};
+            def.op = Reduce::reduce_prod;
+            def.axisMask = 0x4;
+            return runReduceTest<float>(Reduce::reduce_f32, def, sizes, 1.0f, 0.002f);
+        }
+        case 7:
+        {
+            // sample variance of values with a large mean, the single pass
+            // must not cancel
+            const uint64_t sizes[5] = {500, 6, 1, 1, 1};
+            def.op = Reduce::reduce_var;
+            def.axisMask = 0x1;
+            def.correction = 1;
+            return runReduceTest<float>(Reduce::reduce_f32, def, sizes, 1000.0f, 0.01f);
+        }
+        case 8:
+        {
+            // bf16 population std over dim 1
+            const uint64_t sizes[5] = {140, 9, 2, 1, 1};
+            def.op = Reduce::reduce_std;
+            def.axisMask = 0x2;
+            return runReduceTest<bfloat16>(Reduce::reduce_bf16, def, sizes, 0.0f, 0.11f);
+        }
+        default:
+            std::cout << "Unsupported reduction test case " << testCase << std::endl;
+            return -1;
+    }
+}
@@ -0,0 +1,45 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef REDUCTION_GAUDI2_TEST_HPP
+#define REDUCTION_GAUDI2_TEST_HPP
+
+#include "test_base.hpp"
+#include "tensor.h"
+#include "reduction_gaudi2.hpp"
+#include "entry_points.hpp"
+
+class ReductionGaudi2Test : public TestBase
+{
+public:
+    ReductionGaudi2Test() {}
+    ~ReductionGaudi2Test() {}
+    // testCase picks the op, the reduced dims, the strategy and the mode
+    int runTest(int testCase);
+    static const int c_testCaseCount = 9;
+
+private:
+    template <class T>
+    int runReduceTest(ReductionGaudi2::Reduction_mode_t mode,
+                      const ReductionGaudi2::ReductionParams& def,
+                      const uint64_t sizes[5], float offset, float step);
+
+    ReductionGaudi2Test(const ReductionGaudi2Test& other) = delete;
+    ReductionGaudi2Test& operator=(const ReductionGaudi2Test& other) = delete;
+};
+
+
+#endif /* REDUCTION_GAUDI2_TEST_HPP */
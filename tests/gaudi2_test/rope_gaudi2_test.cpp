@@ -0,0 +1,223 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cmath>
+#include <type_traits>
+#include "rope_gaudi2_test.hpp"
+
+float RopeGaudi2Test::rope_angle(int e, int pos, int headDim, float thetaBase, bool interleaved)
+{
+    int pair = interleaved ? e / 2 : e % (headDim / 2);
+    float invFreq = std::pow(thetaBase, -2.0f * pair / headDim);
+    return (float)pos * invFreq;
+}
+
+template <class T>
+void RopeGaudi2Test::rope_reference_implementation(
+        test::Tensor<T,4>& x,
+        int32_2DTensor& positions,
+        test::Tensor<T,4>& out,
+        float thetaBase, bool interleaved)
+{
+    const int headDim = (int)x.Size(0);
+    const int half = headDim / 2;
+    int coords[4] = {0};
+    int posCoords[2] = {0};
+
+    for (int b = 0; b < (int)x.Size(3); b++)
+    {
+        for (int s = 0; s < (int)x.Size(1); s++)
+        {
+            posCoords[0] = s; posCoords[1] = b;
+            int pos = positions.ElementAt(posCoords);
+            for (int h = 0; h < (int)x.Size(2); h++)
+            {
+                coords[1] = s; coords[2] = h; coords[3] = b;
+                for (int e = 0; e < headDim; e++)
+                {
+                    int partnerIdx;
+                    float sign;
+                    if (interleaved)
+                    {
+                        partnerIdx = (e % 2 == 0) ? e + 1 : e - 1;
+                        sign = (e % 2 == 0) ? -1.0f : 1.0f;
+                    }
+                    else
+                    {
+                        partnerIdx = (e < half) ? e + half : e - half;
+                        sign = (e < half) ? -1.0f : 1.0f;
+                    }
+                    coords[0] = e;
+                    float val = (float)x.ElementAt(coords);
+                    coords[0] = partnerIdx;
+                    float partner = sign * (float)x.ElementAt(coords);
+
+                    float angle = rope_angle(e, pos, headDim, thetaBase, interleaved);
+                    coords[0] = e;
+                    out.SetElement(coords, (T)(val * std::cos(angle) + partner * std::sin(angle)));
+                }
+            }
+        }
+    }
+}
+
+template <class T>
+int RopeGaudi2Test::runRopeTest(Gaudi2_Kernel_Name_e NameofKernel, bool interleaved, bool useCache)
+{
+    const uint64_t headDim = 128;
+    const uint64_t seqLen  = 6;
+    const uint64_t qHeads  = 4;
+    const uint64_t kHeads  = 2;
+    const uint64_t batch   = 2;
+    const uint64_t maxPos  = 64;
+    const float tolerance = std::is_same<T, float>::value ? 1e-3f : 3e-2f;
+
+    RopeGaudi2::RopeParams def;
+    def.thetaBase = 10000.0f;
+
+    uint64_t qInitializer[] = {headDim, seqLen, qHeads, batch};
+    uint64_t kInitializer[] = {headDim, seqLen, kHeads, batch};
+    uint64_t posInitializer[] = {seqLen, batch};
+    uint64_t cacheInitializer[] = {headDim, maxPos};
+
+    test::Tensor<T,4> q(qInitializer);
+    q.InitRand(-1.0f, 0.0f);
+    test::Tensor<T,4> k(kInitializer);
+    k.InitRand(-1.0f, 0.0f);
+    int32_2DTensor positions(posInitializer);
+    for (int i = 0; i < positions.ElementCount(); i++)
+    {
+        positions.Data()[i] = rand() % maxPos;
+    }
+
+    // cos / sin cache, one entry per element like the heads
+    test::Tensor<T,2> cosCache(cacheInitializer);
+    test::Tensor<T,2> sinCache(cacheInitializer);
+    int cacheCoords[2] = {0};
+    for (int p = 0; p < (int)maxPos; p++)
+    {
+        for (int e = 0; e < (int)headDim; e++)
+        {
+            float angle = rope_angle(e, p, headDim, def.thetaBase, interleaved);
+            cacheCoords[0] = e; cacheCoords[1] = p;
+            cosCache.SetElement(cacheCoords, (T)std::cos(angle));
+            sinCache.SetElement(cacheCoords, (T)std::sin(angle));
+        }
+    }
+
+    test::Tensor<T,4> qOut(qInitializer);
+    test::Tensor<T,4> qOut_ref(qInitializer);
+    test::Tensor<T,4> kOut(kInitializer);
+    test::Tensor<T,4> kOut_ref(kInitializer);
+
+    // execute reference implementation of the kernel.
+    rope_reference_implementation<T>(q, positions, qOut_ref, def.thetaBase, interleaved);
+    rope_reference_implementation<T>(k, positions, kOut_ref, def.thetaBase, interleaved);
+
+    // generate input for query call
+    m_in_defs.deviceId = tpc_lib_api::DEVICE_ID_GAUDI2;
+    std::vector<TensorDesc2> vec;
+    m_in_defs.inputTensorNr = useCache ? 5 : 3;
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[0]), q);
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[1]), k);
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[2]), positions);
+    vec.push_back(q.GetTensorDescriptor());
+    vec.push_back(k.GetTensorDescriptor());
+    vec.push_back(positions.GetTensorDescriptor());
+    if (useCache)
+    {
+        LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[3]), cosCache);
+        LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[4]), sinCache);
+        vec.push_back(cosCache.GetTensorDescriptor());
+        vec.push_back(sinCache.GetTensorDescriptor());
+    }
+
+    m_in_defs.outputTensorNr = 2;
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[0]), qOut);
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[1]), kOut);
+    vec.push_back(qOut.GetTensorDescriptor());
+    vec.push_back(kOut.GetTensorDescriptor());
+
+    m_in_defs.nodeParams.nodeParams = &def;
+
+    tpc_lib_api::GuidInfo *guids = nullptr;
+    unsigned kernelCount = 0;
+    tpc_lib_api::GlueCodeReturn result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    guids = new tpc_lib_api::GuidInfo[kernelCount];
+    result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "Can't get kernel name!! " << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    strcpy(m_in_defs.guid.name, guids[NameofKernel].name);
+    result  = InstantiateTpcKernel(&m_in_defs,&m_out_defs);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "glue test failed!!" << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    // execute a simulation of the kernel using TPC simulator,
+    TestBase::RunSimulation(vec, m_in_defs, m_out_defs);
+
+    for (int element = 0; element < qOut_ref.ElementCount() + kOut_ref.ElementCount(); element++)
+    {
+        bool isQ = element < qOut_ref.ElementCount();
+        int idx = isQ ? element : element - qOut_ref.ElementCount();
+        float a = isQ ? (float)qOut.Data()[idx] : (float)kOut.Data()[idx];
+        float b = isQ ? (float)qOut_ref.Data()[idx] : (float)kOut_ref.Data()[idx];
+        if (std::abs(a - b) > tolerance * (1.f + std::abs(b)))
+        {
+            std::cout << m_in_defs.guid.name << " test failed!!" << std::endl;
+            ReleaseKernelNames(guids, kernelCount);
+            return -1;
+        }
+    }
+
+    std::cout << m_in_defs.guid.name << " test pass!!" << std::endl;
+    ReleaseKernelNames(guids, kernelCount);
+    return 0;
+}
+
+int RopeGaudi2Test::runTest(Gaudi2_Kernel_Name_e NameofKernel)
+{
+    switch (NameofKernel)
+    {
+        case GAUDI2_KERNEL_ROPE_HALF_CACHE_F32:
+            return runRopeTest<float>(NameofKernel, false, true);
+        case GAUDI2_KERNEL_ROPE_HALF_CACHE_BF16:
+            return runRopeTest<bfloat16>(NameofKernel, false, true);
+        case GAUDI2_KERNEL_ROPE_INTERLEAVED_CACHE_F32:
+            return runRopeTest<float>(NameofKernel, true, true);
+        case GAUDI2_KERNEL_ROPE_INTERLEAVED_CACHE_BF16:
+            return runRopeTest<bfloat16>(NameofKernel, true, true);
+        case GAUDI2_KERNEL_ROPE_HALF_DYNAMIC_F32:
+            return runRopeTest<float>(NameofKernel, false, false);
+        case GAUDI2_KERNEL_ROPE_HALF_DYNAMIC_BF16:
+            return runRopeTest<bfloat16>(NameofKernel, false, false);
+        case GAUDI2_KERNEL_ROPE_INTERLEAVED_DYNAMIC_F32:
+            return runRopeTest<float>(NameofKernel, true, false);
+        case GAUDI2_KERNEL_ROPE_INTERLEAVED_DYNAMIC_BF16:
+            return runRopeTest<bfloat16>(NameofKernel, true, false);
+        default:
+            std::cout << "Unsupported rope kernel " << NameofKernel << std::endl;
+            return -1;
+    }
+}
@@ -0,0 +1,243 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include "scan_gaudi2_test.hpp"
+
+// f32 accumulation for f32 / bf16, wrapping 32-bit accumulation for i32
+template <class T>
+struct ScanAccType { typedef float type; };
+template <>
+struct ScanAccType<int32_t> { typedef uint32_t type; };
+
+template <class T>
+void ScanGaudi2Test::scan_reference_implementation(
+        test::Tensor<T,3>& ifm,
+        test::Tensor<T,3>& ofm,
+        int axis, bool exclusive, bool prod)
+{
+    typedef typename ScanAccType<T>::type AccT;
+    int sizes[3] = {(int)ifm.Size(0), (int)ifm.Size(1), (int)ifm.Size(2)};
+    int outer[2];
+    int o = 0;
+    for (int dim = 0; dim < 3; dim++)
+    {
+        if (dim != axis)
+            outer[o++] = dim;
+    }
+
+    int coords[3] = {0};
+    for (int j = 0; j < sizes[outer[1]]; j++)
+    {
+        for (int i = 0; i < sizes[outer[0]]; i++)
+        {
+            coords[outer[0]] = i;
+            coords[outer[1]] = j;
+            AccT acc = prod ? (AccT)1 : (AccT)0;
+            for (int t = 0; t < sizes[axis]; t++)
+            {
+                coords[axis] = t;
+                AccT x = (AccT)ifm.ElementAt(coords);
+                AccT next = prod ? (AccT)(acc * x) : (AccT)(acc + x);
+                ofm.SetElement(coords, (T)(exclusive ? acc : next));
+                acc = next;
+            }
+        }
+    }
+}
+
+int ScanGaudi2Test::runKernel(ScanGaudi2::Scan_mode_t mode, std::vector<TensorDesc2>& vec,
+                              ScanGaudi2::ScanParams* def)
+{
+    m_in_defs.deviceId = tpc_lib_api::DEVICE_ID_GAUDI2;
+    m_in_defs.nodeParams.nodeParams = def;
+
+    tpc_lib_api::GuidInfo *guids = nullptr;
+    unsigned kernelCount = 0;
+    tpc_lib_api::GlueCodeReturn result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    guids = new tpc_lib_api::GuidInfo[kernelCount];
+    result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "Can't get kernel name!! " << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    strcpy(m_in_defs.guid.name, guids[GAUDI2_KERNEL_CUMSUM_F32 + mode].name);
+    result  = InstantiateTpcKernel(&m_in_defs,&m_out_defs);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "glue test failed!!" << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    // execute a simulation of the kernel using TPC simulator,
+    TestBase::RunSimulation(vec, m_in_defs, m_out_defs);
+    ReleaseKernelNames(guids, kernelCount);
+    return 0;
+}
+
+template <class T, class SumT>
+int ScanGaudi2Test::runScanTest(ScanGaudi2::Scan_mode_t mode, ScanGaudi2::Scan_mode_t sumsMode)
+{
+    const bool prod = mode >= ScanGaudi2::cumprod_f32;
+    const bool isInt = std::is_same<T, int32_t>::value;
+    const float tolerance = std::is_same<T, bfloat16>::value ? 1e-2f : 1e-4f;
+    const int vectorSize = std::is_same<T, bfloat16>::value ? 128 : 64;
+
+    // single pass along dim 1, three-phase along a long dim 0
+    uint64_t shortInitializer[] = {100, 37, 3};
+    uint64_t longInitializer[] = {1000, 4, 2};
+    ScanGaudi2::ScanParams singleDef;
+    singleDef.axis = 1;
+    singleDef.exclusive = 0;
+    singleDef.blockSize = 0;
+    ScanGaudi2::ScanParams blockDef;
+    blockDef.axis = 0;
+    blockDef.exclusive = 1;
+    blockDef.blockSize = 4 * vectorSize;
+
+    test::Tensor<T,3> shortIfm(shortInitializer);
+    test::Tensor<T,3> longIfm(longInitializer);
+    for (test::Tensor<T,3>* t : {&shortIfm, &longIfm})
+    {
+        for (int i = 0; i < t->ElementCount(); i++)
+        {
+            float r = (float)rand() / RAND_MAX;
+            if (isInt)
+                t->Data()[i] = (T)(prod ? (rand() % 2) * 2 - 1 : rand() % 11 - 5);
+            else
+                t->Data()[i] = (T)(prod ? 0.95f + 0.1f * r : 2.0f * r - 1.0f);
+        }
+    }
+
+    test::Tensor<T,3> shortOfm(shortInitializer);
+    test::Tensor<T,3> shortOfm_ref(shortInitializer);
+    test::Tensor<T,3> longOfm(longInitializer);
+    test::Tensor<T,3> longOfm_ref(longInitializer);
+
+    uint64_t ifmSizes[4] = {longInitializer[0], longInitializer[1], longInitializer[2], 1};
+    uint64_t sumsSizes[4];
+    ScanGaudi2::GetBlockSumsSizes(mode, ifmSizes, blockDef.axis, blockDef.blockSize, sumsSizes);
+    test::Tensor<SumT,3> blockSums(sumsSizes);
+    test::Tensor<SumT,3> blockCarry(sumsSizes);
+
+    // execute reference implementation of the kernel.
+    scan_reference_implementation<T>(shortIfm, shortOfm_ref, singleDef.axis, singleDef.exclusive, prod);
+    scan_reference_implementation<T>(longIfm, longOfm_ref, blockDef.axis, blockDef.exclusive, prod);
+
+    std::vector<TensorDesc2> vec;
+
+    // single pass
+    m_in_defs.inputTensorNr = 1;
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[0]), shortIfm);
+    m_in_defs.outputTensorNr = 1;
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[0]), shortOfm);
+    vec.push_back(shortIfm.GetTensorDescriptor());
+    vec.push_back(shortOfm.GetTensorDescriptor());
+    if (runKernel(mode, vec, &singleDef) != 0)
+        return -1;
+
+    // phase 1 - block reduce
+    TearDown();
+    SetUp();
+    vec.clear();
+    m_in_defs.inputTensorNr = 1;
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[0]), longIfm);
+    m_in_defs.outputTensorNr = 1;
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[0]), blockSums);
+    vec.push_back(longIfm.GetTensorDescriptor());
+    vec.push_back(blockSums.GetTensorDescriptor());
+    if (runKernel((ScanGaudi2::Scan_mode_t)(mode + 1), vec, &blockDef) != 0)
+        return -1;
+
+    // phase 2 - exclusive scan of the block sums
+    TearDown();
+    SetUp();
+    vec.clear();
+    m_in_defs.inputTensorNr = 1;
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[0]), blockSums);
+    m_in_defs.outputTensorNr = 1;
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[0]), blockCarry);
+    vec.push_back(blockSums.GetTensorDescriptor());
+    vec.push_back(blockCarry.GetTensorDescriptor());
+    ScanGaudi2::ScanParams sumsDef = blockDef;
+    sumsDef.exclusive = 1;
+    if (runKernel(sumsMode, vec, &sumsDef) != 0)
+        return -1;
+
+    // phase 3 - block fixup
+    TearDown();
+    SetUp();
+    vec.clear();
+    m_in_defs.inputTensorNr = 2;
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[0]), longIfm);
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[1]), blockCarry);
+    m_in_defs.outputTensorNr = 1;
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[0]), longOfm);
+    vec.push_back(longIfm.GetTensorDescriptor());
+    vec.push_back(blockCarry.GetTensorDescriptor());
+    vec.push_back(longOfm.GetTensorDescriptor());
+    if (runKernel((ScanGaudi2::Scan_mode_t)(mode + 2), vec, &blockDef) != 0)
+        return -1;
+
+    for (int pass = 0; pass < 2; pass++)
+    {
+        test::Tensor<T,3>& out = pass ? longOfm : shortOfm;
+        test::Tensor<T,3>& ref = pass ? longOfm_ref : shortOfm_ref;
+        for (int element = 0; element < ref.ElementCount(); element++)
+        {
+            float a = (float)out.Data()[element];
+            float b = (float)ref.Data()[element];
+            bool mismatch = isInt ? out.Data()[element] != ref.Data()[element] :
+                                    std::abs(a - b) > tolerance * (1.f + std::abs(b));
+            if (mismatch)
+            {
+                std::cout << m_in_defs.guid.name << " test failed!!" << std::endl;
+                return -1;
+            }
+        }
+    }
+
+    std::cout << m_in_defs.guid.name << " test pass!!" << std::endl;
+    return 0;
+}
+
+int ScanGaudi2Test::runTest(ScanGaudi2::Scan_mode_t mode)
+{
+    switch (mode)
+    {
+        case ScanGaudi2::cumsum_f32:
+            return runScanTest<float, float>(mode, ScanGaudi2::cumsum_f32);
+        case ScanGaudi2::cumsum_bf16:
+            return runScanTest<bfloat16, float>(mode, ScanGaudi2::cumsum_f32);
+        case ScanGaudi2::cumsum_i32:
+            return runScanTest<int32_t, int32_t>(mode, ScanGaudi2::cumsum_i32);
+        case ScanGaudi2::cumprod_f32:
+            return runScanTest<float, float>(mode, ScanGaudi2::cumprod_f32);
+        case ScanGaudi2::cumprod_bf16:
+            return runScanTest<bfloat16, float>(mode, ScanGaudi2::cumprod_f32);
+        case ScanGaudi2::cumprod_i32:
+            return runScanTest<int32_t, int32_t>(mode, ScanGaudi2::cumprod_i32);
+        default:
+            std::cout << "Unsupported scan mode " << mode << std::endl;
+            return -1;
+    }
+}
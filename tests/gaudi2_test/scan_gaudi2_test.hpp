@@ -0,0 +1,53 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef SCAN_GAUDI2_TEST_HPP
+#define SCAN_GAUDI2_TEST_HPP
+
+#include "test_base.hpp"
+#include "tensor.h"
+#include "scan_gaudi2.hpp"
+#include "entry_points.hpp"
+
+class ScanGaudi2Test : public TestBase
+{
+public:
+    ScanGaudi2Test() {}
+    ~ScanGaudi2Test() {}
+    // mode is one of the single pass modes, its block phases are covered too
+    int runTest(ScanGaudi2::Scan_mode_t mode);
+
+    template <class T>
+    static void scan_reference_implementation(
+            test::Tensor<T,3>& ifm,
+            test::Tensor<T,3>& ofm,
+            int axis, bool exclusive, bool prod);
+
+private:
+    // single pass along dim 1, three-phase along dim 0
+    template <class T, class SumT>
+    int runScanTest(ScanGaudi2::Scan_mode_t mode, ScanGaudi2::Scan_mode_t sumsMode);
+
+    // instantiates and simulates one kernel on the tensors loaded to m_in_defs
+    int runKernel(ScanGaudi2::Scan_mode_t mode, std::vector<TensorDesc2>& vec,
+                  ScanGaudi2::ScanParams* def);
+
+    ScanGaudi2Test(const ScanGaudi2Test& other) = delete;
+    ScanGaudi2Test& operator=(const ScanGaudi2Test& other) = delete;
+};
+
+
+#endif /* SCAN_GAUDI2_TEST_HPP */
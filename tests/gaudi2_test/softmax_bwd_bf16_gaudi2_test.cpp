@@ -0,0 +1,162 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cmath>
+#include "softmax_bwd_bf16_gaudi2_test.hpp"
+
+void SoftMaxBwdBF16Gaudi2Test::softmax_bwd_reference_implementation(
+        test::Tensor<bfloat16,4>& y,
+        test::Tensor<bfloat16,4>& dy,
+        test::Tensor<bfloat16,4>& dx,
+        int axis)
+{
+    // Inner most loop contains the axis
+    const int depth = axis;
+    const int width = 1 - axis;
+
+    int coords[4] = {0};
+    for (int b = 0; b < (int)y.Size(3); b++)
+    {
+        coords[3] = b;
+        for (int h = 0; h < (int)y.Size(2); h++)
+        {
+            coords[2] = h;
+            for (int w = 0; w < (int)y.Size(width); w++)
+            {
+                coords[width] = w;
+
+                float sum = 0.f;
+                for (int d = 0; d < (int)y.Size(depth); d++)
+                {
+                    coords[depth] = d;
+                    sum += (float)y.ElementAt(coords) * (float)dy.ElementAt(coords);
+                }
+
+                for (int d = 0; d < (int)y.Size(depth); d++)
+                {
+                    coords[depth] = d;
+                    float res = (float)y.ElementAt(coords) * ((float)dy.ElementAt(coords) - sum);
+                    dx.SetElement(coords, res);
+                }
+            }
+        }
+    }
+}
+
+int SoftMaxBwdBF16Gaudi2Test::runTest(int axis)
+{
+    // the FCD row is longer than the VLM cache so both of its loops are covered
+    const uint64_t fm_dim0 = axis == 0 ? 20000 : 300;
+    const uint64_t fm_dim1 = axis == 0 ? 3 : 7;
+
+    // dims 2 and 3 are outer batches of the softmax
+    uint64_t fmInitializer[] = {fm_dim0, fm_dim1, 2, 3};
+    bfloat16_4DTensor logits(fmInitializer);
+    logits.InitRand(-4.0f, 4.0f);
+    bfloat16_4DTensor dy(fmInitializer);
+    dy.InitRand(-1.0f, 1.0f);
+
+    // Y is the softmax of random logits along the axis
+    bfloat16_4DTensor y(fmInitializer);
+    int coords[4] = {0};
+    for (int o = 0; o < (int)(y.Size(2) * y.Size(3)); o++)
+    {
+        coords[2] = o % (int)y.Size(2);
+        coords[3] = o / (int)y.Size(2);
+        for (int w = 0; w < (int)y.Size(1 - axis); w++)
+        {
+            coords[1 - axis] = w;
+            float sum = 0.f;
+            for (int d = 0; d < (int)y.Size(axis); d++)
+            {
+                coords[axis] = d;
+                sum += std::exp((float)logits.ElementAt(coords));
+            }
+            for (int d = 0; d < (int)y.Size(axis); d++)
+            {
+                coords[axis] = d;
+                y.SetElement(coords, std::exp((float)logits.ElementAt(coords)) / sum);
+            }
+        }
+    }
+
+    bfloat16_4DTensor dx(fmInitializer);
+    bfloat16_4DTensor dx_ref(fmInitializer);
+
+    SoftMaxBwdBF16Gaudi2::SoftMaxParam def;
+    def.axis = axis;
+
+    // execute reference implementation of the kernel.
+    softmax_bwd_reference_implementation(y, dy, dx_ref, def.axis);
+
+    // generate input for query call
+    m_in_defs.deviceId = tpc_lib_api::DEVICE_ID_GAUDI2;
+    m_in_defs.inputTensorNr = 2;
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[0]), y);
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[1]), dy);
+
+    m_in_defs.outputTensorNr = 1;
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[0]), dx);
+
+    m_in_defs.nodeParams.nodeParams = &def;
+
+    tpc_lib_api::GuidInfo *guids = nullptr;
+    unsigned kernelCount = 0;
+    tpc_lib_api::GlueCodeReturn result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    guids = new tpc_lib_api::GuidInfo[kernelCount];
+    result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "Can't get kernel name!! " << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    strcpy(m_in_defs.guid.name, guids[axis == 0 ? GAUDI2_KERNEL_SOFTMAX_BWD_FCD_BF16 :
+                                                  GAUDI2_KERNEL_SOFTMAX_BWD_NONFCD_BF16].name);
+    result  = InstantiateTpcKernel(&m_in_defs,&m_out_defs);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "glue test failed!!" << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    // generate and load tensor descriptors
+    std::vector<TensorDesc2> vec;
+    vec.push_back(y.GetTensorDescriptor());
+    vec.push_back(dy.GetTensorDescriptor());
+    vec.push_back(dx.GetTensorDescriptor());
+
+    // execute a simulation of the kernel using TPC simulator,
+    TestBase::RunSimulation(vec, m_in_defs, m_out_defs);
+
+    // only the f32 summation order and the final bf16 rounding may differ
+    for (int element = 0 ; element < dx_ref.ElementCount() ; element++)
+    {
+        float ref = (float)dx_ref.Data()[element];
+        if (std::abs((float)dx.Data()[element] - ref) > 1e-2f * std::abs(ref) + 1e-6f)
+        {
+            std::cout << m_in_defs.guid.name << " test failed!!" << std::endl;
+            ReleaseKernelNames(guids, kernelCount);
+            return -1;
+        }
+    }
+
+    std::cout << m_in_defs.guid.name << " test pass!!" << std::endl;
+    ReleaseKernelNames(guids, kernelCount);
+    return 0;
+}
@@ -0,0 +1,46 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef SOFTMAX_BWD_BF16_GAUDI2_TEST_HPP
+#define SOFTMAX_BWD_BF16_GAUDI2_TEST_HPP
+
+#include "test_base.hpp"
+#include "tensor.h"
+#include "softmax_bwd_bf16_gaudi2.hpp"
+#include "entry_points.hpp"
+
+class SoftMaxBwdBF16Gaudi2Test : public TestBase
+{
+public:
+    SoftMaxBwdBF16Gaudi2Test() {}
+    ~SoftMaxBwdBF16Gaudi2Test() {}
+    int runTest(int axis);
+
+    // dX = Y * (dY - SUM(dY * Y)) along axis, accumulated in f32. Dims 2 and
+    // 3 are outer batches.
+    static void softmax_bwd_reference_implementation(
+         test::Tensor<bfloat16,4>& y,
+         test::Tensor<bfloat16,4>& dy,
+         test::Tensor<bfloat16,4>& dx,
+         int axis);
+private:
+    SoftMaxBwdBF16Gaudi2Test(const SoftMaxBwdBF16Gaudi2Test& other) = delete;
+    SoftMaxBwdBF16Gaudi2Test& operator=(const SoftMaxBwdBF16Gaudi2Test& other) = delete;
+
+};
+
+
+#endif /* SOFTMAX_BWD_BF16_GAUDI2_TEST_HPP */
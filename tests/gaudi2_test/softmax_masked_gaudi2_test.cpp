@@ -0,0 +1,186 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "softmax_masked_gaudi2_test.hpp"
+
+template <class T>
+void SoftMaxMaskedGaudi2Test::softmax_masked_reference_implementation(
+        test::Tensor<T,4>& ifm,
+        test::Tensor<T,2>* mask,
+        test::Tensor<T,4>& ofm,
+        const SoftMaxMaskedGaudi2::SoftMaxMaskedParam& def)
+{
+    const int kLen  = (int)ifm.Size(0);
+    const int qLen  = (int)ifm.Size(1);
+    const int heads = (int)ifm.Size(2);
+    const int causalOffset = kLen - qLen;
+    std::vector<float> z(kLen);
+
+    for (int b = 0; b < (int)ifm.Size(3); b++)
+    {
+        for (int h = 0; h < heads; h++)
+        {
+            const float slope = std::pow(2.0f, -8.0f * (h + 1) / heads);
+            for (int q = 0; q < qLen; q++)
+            {
+                float maxVal = -INFINITY;
+                for (int k = 0; k < kLen; k++)
+                {
+                    int coords[4] = {k, q, h, b};
+                    int maskCoords[2] = {k, q};
+                    z[k] = def.scale * (float)ifm.ElementAt(coords);
+                    if (mask != nullptr)
+                    {
+                        z[k] += (float)mask->ElementAt(maskCoords);
+                    }
+                    if (def.maskMode == SoftMaxMaskedGaudi2::mask_alibi)
+                    {
+                        z[k] += slope * (k - q - causalOffset);
+                    }
+                    if (def.maskMode != SoftMaxMaskedGaudi2::mask_none && k > q + causalOffset)
+                    {
+                        z[k] = -INFINITY;
+                    }
+                    maxVal = std::max(maxVal, z[k]);
+                }
+                float sum = 0.0f;
+                for (int k = 0; k < kLen; k++)
+                {
+                    z[k] = std::exp(z[k] - maxVal);
+                    sum += z[k];
+                }
+                for (int k = 0; k < kLen; k++)
+                {
+                    int coords[4] = {k, q, h, b};
+                    ofm.SetElement(coords, (T)(z[k] / sum));
+                }
+            }
+        }
+    }
+}
+
+template <class T>
+int SoftMaxMaskedGaudi2Test::runSoftMaxMaskedTest(
+        Gaudi2_Kernel_Name_e NameofKernel,
+        SoftMaxMaskedGaudi2::SoftMaxMasked_maskMode_t maskMode,
+        bool maskTensor)
+{
+    // more keys than queries, so the causal rows see a KV cache prefix
+    const uint64_t kLen  = 200;
+    const uint64_t qLen  = 50;
+    const uint64_t heads = 4;
+    const uint64_t batch = 2;
+
+    SoftMaxMaskedGaudi2::SoftMaxMaskedParam def;
+    def.axis = 0;
+    def.scale = 0.125f;
+    def.maskMode = maskMode;
+
+    uint64_t fmInitializer[] = {kLen, qLen, heads, batch};
+    uint64_t maskInitializer[] = {kLen, qLen};
+
+    test::Tensor<T,4> ifm(fmInitializer);
+    ifm.InitRand(-20.0f, 20.0f);
+    test::Tensor<T,2> mask(maskInitializer);
+    mask.InitRand(-4.0f, 0.0f);
+
+    test::Tensor<T,4> ofm(fmInitializer);
+    test::Tensor<T,4> ofm_ref(fmInitializer);
+
+    // execute reference implementation of the kernel.
+    softmax_masked_reference_implementation<T>(ifm, maskTensor ? &mask : nullptr, ofm_ref, def);
+
+    // generate input for query call
+    m_in_defs.deviceId = tpc_lib_api::DEVICE_ID_GAUDI2;
+
+    std::vector<TensorDesc2> vec;
+    vec.push_back(ifm.GetTensorDescriptor());
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[0]), ifm);
+    m_in_defs.inputTensorNr = 1;
+    if (maskTensor)
+    {
+        LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[1]), mask);
+        m_in_defs.inputTensorNr = 2;
+        vec.push_back(mask.GetTensorDescriptor());
+    }
+    m_in_defs.outputTensorNr = 1;
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[0]), ofm);
+    vec.push_back(ofm.GetTensorDescriptor());
+    m_in_defs.nodeParams.nodeParams = &def;
+
+    tpc_lib_api::GuidInfo *guids = nullptr;
+    unsigned kernelCount = 0;
+    tpc_lib_api::GlueCodeReturn result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    guids = new tpc_lib_api::GuidInfo[kernelCount];
+    result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "Can't get kernel name!! " << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    strcpy(m_in_defs.guid.name, guids[NameofKernel].name);
+    result  = InstantiateTpcKernel(&m_in_defs,&m_out_defs);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "glue test failed!!" << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    // execute a simulation of the kernel using TPC simulator,
+    TestBase::RunSimulation(vec, m_in_defs, m_out_defs);
+
+    // masked keys must be exactly zero
+    const float tolerance = sizeof(T) == sizeof(float) ? 1e-5f : 1e-2f;
+    for (int element = 0; element < ofm_ref.ElementCount(); element++)
+    {
+        float ref = (float)ofm_ref.Data()[element];
+        if (std::abs((float)ofm.Data()[element] - ref) > tolerance * std::max(ref, 1e-3f))
+        {
+            std::cout << m_in_defs.guid.name << " mask mode " << maskMode << " test failed!!" << std::endl;
+            ReleaseKernelNames(guids, kernelCount);
+            return -1;
+        }
+    }
+
+    std::cout << m_in_defs.guid.name << " mask mode " << maskMode << " test pass!!" << std::endl;
+    ReleaseKernelNames(guids, kernelCount);
+    return 0;
+}
+
+int SoftMaxMaskedGaudi2Test::runTest(Gaudi2_Kernel_Name_e NameofKernel,
+                                     SoftMaxMaskedGaudi2::SoftMaxMasked_maskMode_t maskMode)
+{
+    switch (NameofKernel)
+    {
+        case GAUDI2_KERNEL_SOFTMAX_SCALED_F32:
+            return runSoftMaxMaskedTest<float>(NameofKernel, maskMode, false);
+        case GAUDI2_KERNEL_SOFTMAX_SCALED_BF16:
+            return runSoftMaxMaskedTest<bfloat16>(NameofKernel, maskMode, false);
+        case GAUDI2_KERNEL_SOFTMAX_MASKED_F32:
+            return runSoftMaxMaskedTest<float>(NameofKernel, maskMode, true);
+        case GAUDI2_KERNEL_SOFTMAX_MASKED_BF16:
+            return runSoftMaxMaskedTest<bfloat16>(NameofKernel, maskMode, true);
+        default:
+            std::cout << "Unsupported masked softmax kernel " << NameofKernel << std::endl;
+            return -1;
+    }
+}
@@ -0,0 +1,157 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <algorithm>
+#include <vector>
+#include "topk_gaudi2_test.hpp"
+
+template <class T>
+void TopKGaudi2Test::topk_reference_implementation(
+        test::Tensor<T,3>& ifm,
+        test::Tensor<T,3>& values,
+        int32_3DTensor& indices,
+        int k)
+{
+    const int rowSize = (int)ifm.Size(0);
+    int coords[3] = {0};
+
+    for (int h = 0; h < (int)ifm.Size(2); h++)
+    {
+        for (int w = 0; w < (int)ifm.Size(1); w++)
+        {
+            coords[1] = w; coords[2] = h;
+            std::vector<int> order(rowSize);
+            for (int d = 0; d < rowSize; d++)
+            {
+                order[d] = d;
+            }
+            std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+                int ca[3] = {a, w, h};
+                int cb[3] = {b, w, h};
+                return (float)ifm.ElementAt(ca) > (float)ifm.ElementAt(cb);
+            });
+
+            for (int r = 0; r < k; r++)
+            {
+                coords[0] = order[r];
+                T val = ifm.ElementAt(coords);
+                coords[0] = r;
+                values.SetElement(coords, val);
+                indices.SetElement(coords, order[r]);
+            }
+        }
+    }
+}
+
+template <class T>
+int TopKGaudi2Test::runTopKTest(Gaudi2_Kernel_Name_e NameofKernel, bool argMax)
+{
+    // the row is not a multiple of the vector size to cover the tail
+    const uint64_t rowSize = 1000;
+    const uint64_t width   = 5;
+    const uint64_t height  = 3;
+
+    TopKGaudi2::TopKParams def;
+    def.k = argMax ? 1 : 20;
+
+    uint64_t fmInitializer[] = {rowSize, width, height};
+    uint64_t outInitializer[] = {(uint64_t)def.k, width, height};
+
+    test::Tensor<T,3> ifm(fmInitializer);
+    ifm.InitRand(-10.0f, 10.0f);
+
+    test::Tensor<T,3> values(outInitializer);
+    test::Tensor<T,3> values_ref(outInitializer);
+    int32_3DTensor indices(outInitializer);
+    int32_3DTensor indices_ref(outInitializer);
+
+    // execute reference implementation of the kernel.
+    topk_reference_implementation<T>(ifm, values_ref, indices_ref, def.k);
+
+    // generate input for query call
+    m_in_defs.deviceId = tpc_lib_api::DEVICE_ID_GAUDI2;
+
+    m_in_defs.inputTensorNr = 1;
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[0]), ifm);
+    m_in_defs.outputTensorNr = 2;
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[0]), values);
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[1]), indices);
+    m_in_defs.nodeParams.nodeParams = argMax ? nullptr : &def;
+
+    tpc_lib_api::GuidInfo *guids = nullptr;
+    unsigned kernelCount = 0;
+    tpc_lib_api::GlueCodeReturn result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    guids = new tpc_lib_api::GuidInfo[kernelCount];
+    result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "Can't get kernel name!! " << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    strcpy(m_in_defs.guid.name, guids[NameofKernel].name);
+    result  = InstantiateTpcKernel(&m_in_defs,&m_out_defs);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "glue test failed!!" << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    // generate and load tensor descriptors
+    std::vector<TensorDesc2> vec;
+    vec.push_back(ifm.GetTensorDescriptor());
+    vec.push_back(values.GetTensorDescriptor());
+    vec.push_back(indices.GetTensorDescriptor());
+
+    // execute a simulation of the kernel using TPC simulator,
+    TestBase::RunSimulation(vec, m_in_defs, m_out_defs);
+
+    // values are copied, indices must match exactly
+    for (int element = 0; element < values_ref.ElementCount(); element++)
+    {
+        if ((float)values.Data()[element] != (float)values_ref.Data()[element] ||
+            indices.Data()[element] != indices_ref.Data()[element])
+        {
+            std::cout << m_in_defs.guid.name << " test failed!!" << std::endl;
+            ReleaseKernelNames(guids, kernelCount);
+            return -1;
+        }
+    }
+
+    std::cout << m_in_defs.guid.name << " test pass!!" << std::endl;
+    ReleaseKernelNames(guids, kernelCount);
+    return 0;
+}
+
+int TopKGaudi2Test::runTest(Gaudi2_Kernel_Name_e NameofKernel)
+{
+    switch (NameofKernel)
+    {
+        case GAUDI2_KERNEL_TOPK_F32:
+            return runTopKTest<float>(NameofKernel, false);
+        case GAUDI2_KERNEL_TOPK_BF16:
+            return runTopKTest<bfloat16>(NameofKernel, false);
+        case GAUDI2_KERNEL_ARGMAX_F32:
+            return runTopKTest<float>(NameofKernel, true);
+        case GAUDI2_KERNEL_ARGMAX_BF16:
+            return runTopKTest<bfloat16>(NameofKernel, true);
+        default:
+            std::cout << "Unsupported top-k kernel " << NameofKernel << std::endl;
+            return -1;
+    }
+}
@@ -0,0 +1,49 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef TOPK_GAUDI2_TEST_HPP
+#define TOPK_GAUDI2_TEST_HPP
+
+#include "test_base.hpp"
+#include "tensor.h"
+#include "topk_gaudi2.hpp"
+#include "entry_points.hpp"
+
+class TopKGaudi2Test : public TestBase
+{
+public:
+    TopKGaudi2Test() {}
+    ~TopKGaudi2Test() {}
+    int runTest(Gaudi2_Kernel_Name_e NameofKernel);
+
+    // k largest values of every row, ties ordered by the lower index
+    template <class T>
+    static void topk_reference_implementation(
+            test::Tensor<T,3>& ifm,
+            test::Tensor<T,3>& values,
+            int32_3DTensor& indices,
+            int k);
+
+private:
+    template <class T>
+    int runTopKTest(Gaudi2_Kernel_Name_e NameofKernel, bool argMax);
+
+    TopKGaudi2Test(const TopKGaudi2Test& other) = delete;
+    TopKGaudi2Test& operator=(const TopKGaudi2Test& other) = delete;
+};
+
+
+#endif /* TOPK_GAUDI2_TEST_HPP */
@@ -0,0 +1,179 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+#include "transcendental_gaudi2_test.hpp"
+
+typedef TranscendentalGaudi2 Tr;
+
+static double reference(Tr::Transcendental_mode_t mode, double x)
+{
+    switch (mode)
+    {
+        case Tr::tr_cos:     return cos(x);
+        case Tr::tr_sincos:  return sin(x);
+        case Tr::tr_exp:     return exp(x);
+        case Tr::tr_log:     return log(x);
+        case Tr::tr_tanh:    return tanh(x);
+        case Tr::tr_sigmoid: return 1.0 / (1.0 + exp(-x));
+        case Tr::tr_rsqrt:   return 1.0 / sqrt(x);
+        case Tr::tr_erf:     return erf(x);
+        default:             return 0.0;
+    }
+}
+
+// distance of out from ref in units of the f32 spacing at ref
+static double ulpError(float out, double ref)
+{
+    if (std::isnan(ref) || std::isinf(ref))
+        return (std::isnan(ref) ? std::isnan(out) : out == (float)ref) ? 0.0 : INFINITY;
+    if (!std::isfinite(out))
+        return INFINITY;
+    int exponent;
+    frexp(ref, &exponent);
+    // below the normal range the spacing stays at the smallest normal one
+    exponent = exponent > -125 ? exponent : -125;
+    return fabs(out - ref) / ldexp(1.0, exponent - 24);
+}
+
+// the error table of transcendental.h plus 1 ULP, by tier and mode
+static const double c_maxUlp[Tr::tier_count][Tr::tr_mode_count] = {
+    // cos sincos exp   log   tanh  sigmoid rsqrt erf
+    {  0.0, 0.0,  10.0, 12.0, 6.0,  8.0,    3.0,  11.0},  // fast, cos / sincos on abs error
+    {  3.0, 3.0,  3.0,  2.0,  3.0,  4.0,    2.0,  4.0}    // precise
+};
+
+int TranscendentalGaudi2Test::runTest(Tr::Transcendental_mode_t mode, Tr::Tier_t tier)
+{
+    const uint64_t fmInitializer[] = {256, 8, 2, 1, 1};
+
+    // deterministic grid over the interesting range of every function,
+    // linear or log spaced
+    static const double c_ranges[Tr::tr_mode_count][2] = {
+        {-20.0, 20.0},  // cos
+        {-20.0, 20.0},  // sincos
+        {-80.0, 80.0},  // exp
+        {1e-20, 1e20},  // log
+        {-10.0, 10.0},  // tanh
+        {-30.0, 30.0},  // sigmoid
+        {1e-20, 1e20},  // rsqrt
+        {-5.0, 5.0}     // erf
+    };
+    const bool logSpaced = mode == Tr::tr_log || mode == Tr::tr_rsqrt;
+
+    float_5DTensor input(fmInitializer);
+    const int count = input.ElementCount();
+    const double lo = c_ranges[mode][0];
+    const double hi = c_ranges[mode][1];
+    for (int element = 0; element < count; element++)
+    {
+        const double t = (double)element / (count - 1);
+        input.Data()[element] = logSpaced ? (float)(lo * pow(hi / lo, t)) :
+                                            (float)(lo + (hi - lo) * t);
+    }
+    if (tier == Tr::tier_precise)
+    {
+        // the precise tier also handles special values
+        const float inf = std::numeric_limits<float>::infinity();
+        const float specials[] = {std::numeric_limits<float>::quiet_NaN(), inf, -inf, 0.0f, -1.0f};
+        const int specialCount = sizeof(specials) / sizeof(specials[0]);
+        for (int i = 0; i < specialCount; i++)
+        {
+            input.Data()[i] = specials[i];
+        }
+    }
+
+    float_5DTensor output(fmInitializer);
+    float_5DTensor output2(fmInitializer);
+
+    Tr::TranscendentalParams def;
+    def.tier = tier;
+
+    // generate input for query call
+    m_in_defs.deviceId = tpc_lib_api::DEVICE_ID_GAUDI2;
+    m_in_defs.nodeParams.nodeParams = (void*)&def;
+    m_in_defs.inputTensorNr = 1;
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[0]), input);
+    m_in_defs.outputTensorNr = mode == Tr::tr_sincos ? 2 : 1;
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[0]), output);
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[1]), output2);
+
+    tpc_lib_api::GuidInfo *guids = nullptr;
+    unsigned kernelCount = 0;
+    tpc_lib_api::GlueCodeReturn result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    guids = new tpc_lib_api::GuidInfo[kernelCount];
+    result = GetKernelGuids(tpc_lib_api::DEVICE_ID_GAUDI2, &kernelCount, guids);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "Can't get kernel name!! " << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    strcpy(m_in_defs.guid.name, guids[GAUDI2_KERNEL_TRANSCENDENTAL_COS + mode].name);
+    result  = InstantiateTpcKernel(&m_in_defs,&m_out_defs);
+    ReleaseKernelNames(guids, kernelCount);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "glue test failed!!" << result << std::endl;
+        return -1;
+    }
+
+    // generate and load tensor descriptors
+    std::vector<TensorDesc2> vec;
+    vec.push_back(input.GetTensorDescriptor());
+    vec.push_back(output.GetTensorDescriptor());
+    if (mode == Tr::tr_sincos)
+        vec.push_back(output2.GetTensorDescriptor());
+
+    // execute a simulation of the kernel using TPC simulator,
+    const unsigned cycles = TestBase::RunSimulation(vec, m_in_defs, m_out_defs);
+
+    // the fast sin / cos go through the LUT and are checked on absolute error
+    // like sin_f32, everything else on ULP
+    const bool lutSinCos = tier == Tr::tier_fast && (mode == Tr::tr_cos || mode == Tr::tr_sincos);
+    const double maxUlp = c_maxUlp[tier][mode];
+    double worstUlp = 0.0;
+    double worstAbs = 0.0;
+    for (int element = 0; element < count; element++)
+    {
+        const double x = input.Data()[element];
+        const int outputs = mode == Tr::tr_sincos ? 2 : 1;
+        for (int o = 0; o < outputs; o++)
+        {
+            const double ref = o == 0 ? reference(mode, x) : cos(x);
+            const float out = o == 0 ? output.Data()[element] : output2.Data()[element];
+            const double ulp = ulpError(out, ref);
+            worstUlp = ulp > worstUlp ? ulp : worstUlp;
+            worstAbs = fabs(out - ref) > worstAbs ? fabs(out - ref) : worstAbs;
+            if (lutSinCos ? fabs(out - ref) > 1e-6 : ulp > maxUlp)
+            {
+                std::cout << m_in_defs.guid.name << " tier " << tier << " test failed at x = "
+                          << x << ": " << out << " vs " << ref << "!!" << std::endl;
+                return -1;
+            }
+        }
+    }
+
+    std::cout << m_in_defs.guid.name << " tier " << tier << " max error " << worstUlp
+              << " ULP (" << worstAbs << " abs), " << (double)cycles / count
+              << " cycles per element" << std::endl;
+    std::cout << m_in_defs.guid.name << " tier " << tier << " test pass!!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,40 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef TRANSCENDENTAL_GAUDI2_TEST_HPP
+#define TRANSCENDENTAL_GAUDI2_TEST_HPP
+
+#include "test_base.hpp"
+#include "tensor.h"
+#include "transcendental_gaudi2.hpp"
+#include "entry_points.hpp"
+
+class TranscendentalGaudi2Test : public TestBase
+{
+public:
+    TranscendentalGaudi2Test() {}
+    ~TranscendentalGaudi2Test() {}
+    // reports the max error in ULP and the cycles per element
+    int runTest(TranscendentalGaudi2::Transcendental_mode_t mode,
+                TranscendentalGaudi2::Tier_t tier);
+
+private:
+    TranscendentalGaudi2Test(const TranscendentalGaudi2Test& other) = delete;
+    TranscendentalGaudi2Test& operator=(const TranscendentalGaudi2Test& other) = delete;
+};
+
+
+#endif /* TRANSCENDENTAL_GAUDI2_TEST_HPP */
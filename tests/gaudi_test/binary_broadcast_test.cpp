@@ -0,0 +1,200 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include "binary_broadcast_test.hpp"
+
+static float toFloat(float x)    { return x; }
+static float toFloat(bfloat16 x) { return bf16ToFloat(x.val); }
+
+float BinaryBroadcastTest::binary_op_reference(BinaryBroadcast::BinaryOp_t op, float x, float y)
+{
+    switch (op)
+    {
+        case BinaryBroadcast::binary_add: return x + y;
+        case BinaryBroadcast::binary_sub: return x - y;
+        case BinaryBroadcast::binary_mul: return x * y;
+        case BinaryBroadcast::binary_div: return x / y;
+        case BinaryBroadcast::binary_max: return std::max(x, y);
+        case BinaryBroadcast::binary_min: return std::min(x, y);
+        default:                          return 0.0f;
+    }
+}
+
+template <class T>
+int BinaryBroadcastTest::runBinaryTest(tpc_lib_api::DeviceId deviceId,
+                                       BinaryBroadcast::BinaryBroadcast_mode_t mode,
+                                       BinaryBroadcast::BinaryOp_t op,
+                                       const uint64_t sizes0[5], const uint64_t sizes1[5],
+                                       bool inPlace)
+{
+    uint64_t ofmSizes[5];
+    for (int dim = 0; dim < 5; dim++)
+    {
+        ofmSizes[dim] = std::max(sizes0[dim], sizes1[dim]);
+    }
+
+    // ifm1 stays within +-[0.5, 4.5) to keep the divisions well defined
+    test::Tensor<T,5> ifm0(sizes0);
+    test::Tensor<T,5> ifm1(sizes1);
+    for (int element = 0; element < ifm0.ElementCount(); element++)
+    {
+        ifm0.Data()[element] = (T)(((element * 37) % 201 - 100) * 0.13f);
+    }
+    for (int element = 0; element < ifm1.ElementCount(); element++)
+    {
+        float y = 0.5f + ((element * 53) % 64) / 16.0f;
+        ifm1.Data()[element] = (T)((element % 3 == 0) ? -y : y);
+    }
+
+    test::Tensor<T,5> ofm(ofmSizes);
+    test::Tensor<float,5> ofm_ref(ofmSizes);
+
+    // execute reference implementation of the kernel, broadcast dims read 0
+    int ofmCoords[5] = {0};
+    int ifm0Coords[5] = {0};
+    int ifm1Coords[5] = {0};
+    for (ofmCoords[4] = 0; ofmCoords[4] < (int)ofmSizes[4]; ofmCoords[4]++)
+    for (ofmCoords[3] = 0; ofmCoords[3] < (int)ofmSizes[3]; ofmCoords[3]++)
+    for (ofmCoords[2] = 0; ofmCoords[2] < (int)ofmSizes[2]; ofmCoords[2]++)
+    for (ofmCoords[1] = 0; ofmCoords[1] < (int)ofmSizes[1]; ofmCoords[1]++)
+    for (ofmCoords[0] = 0; ofmCoords[0] < (int)ofmSizes[0]; ofmCoords[0]++)
+    {
+        for (int dim = 0; dim < 5; dim++)
+        {
+            ifm0Coords[dim] = sizes0[dim] == 1 ? 0 : ofmCoords[dim];
+            ifm1Coords[dim] = sizes1[dim] == 1 ? 0 : ofmCoords[dim];
+        }
+        ofm_ref.SetElement(ofmCoords, binary_op_reference(op, toFloat(ifm0.ElementAt(ifm0Coords)),
+                                                          toFloat(ifm1.ElementAt(ifm1Coords))));
+    }
+
+    // generate input for query call
+    BinaryBroadcast::BinaryBroadcastParams def;
+    def.op = op;
+    def.inPlace = inPlace ? 1 : 0;
+
+    // in place the ofm is the ifm0 tensor itself
+    test::Tensor<T,5>& result_ofm = inPlace ? ifm0 : ofm;
+
+    m_in_defs.deviceId = deviceId;
+    m_in_defs.nodeParams.nodeParams = &def;
+    m_in_defs.inputTensorNr = 2;
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[0]), ifm0);
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[1]), ifm1);
+    m_in_defs.outputTensorNr = 1;
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[0]), result_ofm);
+
+    tpc_lib_api::GuidInfo *guids = nullptr;
+    unsigned kernelCount = 0;
+    tpc_lib_api::GlueCodeReturn result = GetKernelGuids(deviceId, &kernelCount, guids);
+    guids = new tpc_lib_api::GuidInfo[kernelCount];
+    result = GetKernelGuids(deviceId, &kernelCount, guids);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "Can't get kernel name!! " << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    unsigned kernelIndex = GAUDI_KERNEL_BINARY_BROADCAST_F32 + mode;
+    if (deviceId == tpc_lib_api::DEVICE_ID_GAUDI2)
+    {
+        kernelIndex = GAUDI2_KERNEL_BINARY_BROADCAST_F32 + mode;
+    }
+    else if (deviceId == tpc_lib_api::DEVICE_ID_GAUDI3)
+    {
+        kernelIndex = GAUDI3_KERNEL_BINARY_BROADCAST_F32 + mode;
+    }
+    strcpy(m_in_defs.guid.name, guids[kernelIndex].name);
+    result  = InstantiateTpcKernel(&m_in_defs,&m_out_defs);
+    ReleaseKernelNames(guids, kernelCount);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "glue test failed!!" << result << std::endl;
+        return -1;
+    }
+
+    // generate and load tensor descriptors
+    std::vector<TensorDesc2> vec;
+    vec.push_back(ifm0.GetTensorDescriptor());
+    vec.push_back(ifm1.GetTensorDescriptor());
+    vec.push_back(result_ofm.GetTensorDescriptor());
+
+    // execute a simulation of the kernel using TPC simulator,
+    TestBase::RunSimulation(vec, m_in_defs, m_out_defs);
+
+    // f32 add / sub / mul / max / min match exactly, div multiplies by the
+    // reciprocal, bf16 rounds the result once
+    float tolerance = 0.0f;
+    if (mode == BinaryBroadcast::binary_broadcast_bf16)
+    {
+        tolerance = 1.0f / 128;
+    }
+    else if (op == BinaryBroadcast::binary_div)
+    {
+        tolerance = 1e-6f;
+    }
+    for (int element = 0; element < ofm_ref.ElementCount(); element++)
+    {
+        float out = toFloat(result_ofm.Data()[element]);
+        float ref = ofm_ref.Data()[element];
+        if (std::abs(out - ref) > tolerance * std::max(std::abs(ref), 1.0f))
+        {
+            std::cout << m_in_defs.guid.name << " op " << op << " test failed at element " << element
+                      << ": " << out << " vs " << ref << "!!" << std::endl;
+            return -1;
+        }
+    }
+
+    std::cout << m_in_defs.guid.name << " op " << op << " test pass!!" << std::endl;
+    return 0;
+}
+
+int BinaryBroadcastTest::runTest(tpc_lib_api::DeviceId deviceId,
+                                 BinaryBroadcast::BinaryBroadcast_mode_t mode,
+                                 BinaryBroadcast::BinaryOp_t op, int testCase)
+{
+    // dim 0 ends in a partial vector for both data types
+    static const uint64_t c_sizes[c_testCaseCount][2][5] = {
+        {{130, 3, 2, 1, 1}, {130, 3, 2, 1, 1}},    // same shape
+        {{130, 3, 2, 1, 1}, {130, 1, 1, 1, 1}},    // bias add
+        {{130, 3, 2, 1, 1}, {  1, 3, 1, 1, 1}},    // per-channel scale, ifm1 FCD splat
+        {{  1, 3, 1, 2, 1}, {130, 1, 2, 1, 1}},    // ifm0 broadcast, FCD splat included
+        {{130, 3, 2, 1, 1}, {  1, 3, 1, 1, 1}}     // in place into ifm0
+    };
+    if (testCase < 0 || testCase >= c_testCaseCount)
+    {
+        std::cout << "Unsupported binary broadcast test case " << testCase << std::endl;
+        return -1;
+    }
+    const uint64_t* sizes0 = c_sizes[testCase][0];
+    const uint64_t* sizes1 = c_sizes[testCase][1];
+    const bool inPlace = testCase == c_testCaseCount - 1;
+
+    switch (mode)
+    {
+        case BinaryBroadcast::binary_broadcast_f32:
+            return runBinaryTest<float>(deviceId, mode, op, sizes0, sizes1, inPlace);
+        case BinaryBroadcast::binary_broadcast_bf16:
+            return runBinaryTest<bfloat16>(deviceId, mode, op, sizes0, sizes1, inPlace);
+        default:
+            std::cout << "Unsupported binary broadcast mode " << mode << std::endl;
+            return -1;
+    }
+}
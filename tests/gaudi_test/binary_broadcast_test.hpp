@@ -0,0 +1,49 @@
+/**********************************************************************
+Copyright (c) 2024 Habana Labs. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+*   Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+*   Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************/
+
+#ifndef BINARY_BROADCAST_TEST_HPP
+#define BINARY_BROADCAST_TEST_HPP
+
+#include "test_base.hpp"
+#include "tensor.h"
+#include "binary_broadcast.hpp"
+#include "entry_points.hpp"
+
+class BinaryBroadcastTest : public TestBase
+{
+public:
+    BinaryBroadcastTest() {}
+    ~BinaryBroadcastTest() {}
+    // testCase picks the shapes: same shape, bias add, per-channel scale
+    // (broadcast FCD), broadcast ifm0 and in place
+    int runTest(tpc_lib_api::DeviceId deviceId, BinaryBroadcast::BinaryBroadcast_mode_t mode,
+                BinaryBroadcast::BinaryOp_t op, int testCase);
+    static const int c_testCaseCount = 5;
+
+    static float binary_op_reference(BinaryBroadcast::BinaryOp_t op, float x, float y);
+
+private:
+    template <class T>
+    int runBinaryTest(tpc_lib_api::DeviceId deviceId, BinaryBroadcast::BinaryBroadcast_mode_t mode,
+                      BinaryBroadcast::BinaryOp_t op, const uint64_t sizes0[5], const uint64_t sizes1[5],
+                      bool inPlace);
+
+    BinaryBroadcastTest(const BinaryBroadcastTest& other) = delete;
+    BinaryBroadcastTest& operator=(const BinaryBroadcastTest& other) = delete;
+};
+
+
+#endif /* BINARY_BROADCAST_TEST_HPP */
@@ -17,6 +17,24 @@ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVE
 #include "cast_gaudi_test.hpp"
 #include "entry_points.hpp"
 
+// Same generator as kernels/include/counter_rng.h
+static uint32_t hash_u32(uint32_t a)
+{
+    a = (a + 0x7ed55d16) + (a << 12);
+    a = (a ^ 0xc761c23c) ^ (a >> 19);
+    a = (a + 0x165667b1) + (a << 5);
+    a = (a + 0xd3a2646c) ^ (a << 9);
+    a = (a + 0xfd7046c5) + (a << 3);
+    a = (a ^ 0xb55a4f09) ^ (a >> 16);
+    return a;
+}
+
+static uint32_t rng_u32(uint32_t counter, uint32_t key)
+{
+    uint32_t x = hash_u32(counter ^ key);
+    return hash_u32(x ^ (key + 0x9e3779b9));
+}
+
 void CastGaudiTest::cast_bf16_to_f32_ref(
          const test::Tensor<bfloat16,4>& input,
          test::Tensor<float,4>& output,
@@ -77,6 +95,64 @@ void CastGaudiTest::cast_f32_to_bf16_ref(
     }
 }
 
+void CastGaudiTest::cast_f32_to_bf16_sr_ref(
+    test::Tensor<float,4>& ifm,
+    test::Tensor<bfloat16,4>& ofm,
+    uint32_t seed)
+{
+    const uint32_t seedKey = hash_u32(seed);
+
+    // the kernel keys the random stream on the linear element index
+    for (int element = 0 ; element < ifm.ElementCount() ; element++)
+    {
+        uint32_t bits;
+        memcpy(&bits, &ifm.Data()[element], sizeof(bits));
+
+        if ((bits & 0x7f800000) != 0x7f800000)
+        {
+            uint32_t rnd = rng_u32((uint32_t)element, seedKey);
+            bits = (bits + (rnd & 0xffff)) & 0xffff0000;
+        }
+        ofm.Data()[element].val = (uint16_t)(bits >> 16);
+    }
+}
+
+int CastGaudiTest::runCastSR(float_4DTensor& input,
+                             bfloat16_4DTensor& out,
+                             uint32_t seed,
+                             const char* guid)
+{
+    CastGaudi::CastSRParams def;
+    def.scale = 1.0;
+    def.seed = seed;
+
+    // generate input for query call
+    m_in_defs.deviceId = tpc_lib_api::DEVICE_ID_GAUDI;
+    m_in_defs.nodeParams.nodeParams = &def;
+    m_in_defs.inputTensorNr = 1;
+    LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[0]),input );
+
+    m_in_defs.outputTensorNr = 1;
+    LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[0]),out );
+
+    strcpy(m_in_defs.guid.name, guid);
+    tpc_lib_api::GlueCodeReturn result  = InstantiateTpcKernel(&m_in_defs,&m_out_defs);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "Glue test failed, can't load kernel " << result << std::endl;
+        return -1;
+    }
+
+    // generate and load tensor descriptors
+    std::vector<TensorDesc2> vec;
+    vec.push_back(input.GetTensorDescriptor());
+    vec.push_back(out.GetTensorDescriptor());
+
+    // execute a simulation of the kernel using TPC simulator,
+    TestBase::RunSimulation(vec, m_in_defs, m_out_defs);
+    return 0;
+}
+
  int CastGaudiTest::runTest()
  {
 
@@ -202,7 +278,6 @@ void CastGaudiTest::cast_f32_to_bf16_ref(
 
     // execute a simulation of the kernel using TPC simulator,
     TestBase::RunSimulation(vec1, m_in_defs, m_out_defs);
-    ReleaseKernelNames(guids, kernelCount);
     out.Print(0);
     out_ref.Print(0);
     for (int element = 0 ; element <  out_ref.ElementCount() ; element++)
@@ -210,10 +285,96 @@ void CastGaudiTest::cast_f32_to_bf16_ref(
         if (out.Data()[element] != out_ref.Data()[element])
         {
             std::cout << "Cast F32_2_BF16 test failed!!" << std::endl;
+            ReleaseKernelNames(guids, kernelCount);
             return -1;
         }
     }
     std::cout << "Cast F32_2_BF16 test pass!!" << std::endl;
+
+
+    /*****************Test for stochastic cast f32 to bf16******************/
+    const uint32_t seed = 0x1234;
+    const char* srGuid = guids[GAUDI_KERNEL_CAST_F32_BF16_SR].name;
+
+    // random input, bit exact against the reference
+    bfloat16_4DTensor outSR(ifmofmInitializer);
+    bfloat16_4DTensor outSR_ref(ifmofmInitializer);
+    this->cast_f32_to_bf16_sr_ref(input, outSR_ref, seed);
+    if (runCastSR(input, outSR, seed, srGuid) != 0)
+    {
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+    for (int element = 0 ; element <  outSR_ref.ElementCount() ; element++)
+    {
+        if (outSR.Data()[element].val != outSR_ref.Data()[element].val)
+        {
+            std::cout << "Cast F32_2_BF16_SR test failed!!" << std::endl;
+            ReleaseKernelNames(guids, kernelCount);
+            return -1;
+        }
+    }
+
+    // same seed must reproduce the same output
+    bfloat16_4DTensor outSR2(ifmofmInitializer);
+    if (runCastSR(input, outSR2, seed, srGuid) != 0)
+    {
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+    for (int element = 0 ; element <  outSR.ElementCount() ; element++)
+    {
+        if (outSR2.Data()[element].val != outSR.Data()[element].val)
+        {
+            std::cout << "Cast F32_2_BF16_SR reproducibility test failed!!" << std::endl;
+            ReleaseKernelNames(guids, kernelCount);
+            return -1;
+        }
+    }
+
+    // Unbiasedness: a constant input between two bf16 neighbours must round
+    // up with probability equal to its distance from the lower one.
+    float_4DTensor constIn(ifmofmInitializer);
+    const float constVal = 1.0f + 0.3f / 128.0f;
+    for (int element = 0 ; element <  constIn.ElementCount() ; element++)
+    {
+        constIn.Data()[element] = constVal;
+    }
+    bfloat16_4DTensor constOut(ifmofmInitializer);
+    if (runCastSR(constIn, constOut, seed + 1, srGuid) != 0)
+    {
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+    ReleaseKernelNames(guids, kernelCount);
+
+    uint32_t constBits;
+    memcpy(&constBits, &constVal, sizeof(constBits));
+    const uint16_t lower = (uint16_t)(constBits >> 16);
+    const double pUp = (double)(constBits & 0xffff) / 65536.0;
+    const int count = constOut.ElementCount();
+
+    int roundedUp = 0;
+    for (int element = 0 ; element < count ; element++)
+    {
+        uint16_t val = constOut.Data()[element].val;
+        if (val != lower && val != lower + 1)
+        {
+            std::cout << "Cast F32_2_BF16_SR test failed, value is not a bf16 neighbour!!" << std::endl;
+            return -1;
+        }
+        roundedUp += (val == lower + 1);
+    }
+    // binomial count, allow 4 standard deviations
+    const double expected = pUp * count;
+    const double sigma = std::sqrt(count * pUp * (1.0 - pUp));
+    if (std::fabs(roundedUp - expected) > 4.0 * sigma)
+    {
+        std::cout << "Cast F32_2_BF16_SR test failed, biased rounding: " << roundedUp
+                  << " rounded up, expected " << expected << std::endl;
+        return -1;
+    }
+    std::cout << "Cast F32_2_BF16_SR test pass!!" << std::endl;
     return 0;
  }
 
@@ -37,7 +37,18 @@ public:
         const test::Tensor<float,4>& ifm,
         test::Tensor<bfloat16,4>& ofm,
         const IndexSpace& indexSpace);
+
+    static void cast_f32_to_bf16_sr_ref(
+        test::Tensor<float,4>& ifm,
+        test::Tensor<bfloat16,4>& ofm,
+        uint32_t seed);
 private:
+    int runCastSR(float_4DTensor& input,
+                  bfloat16_4DTensor& out,
+                  uint32_t seed,
+                  const char* guid);
+
+
     CastGaudiTest(const CastGaudiTest& other) = delete;
     CastGaudiTest& operator=(const CastGaudiTest& other) = delete;
 
@@ -339,3 +339,139 @@ int Relu6AllTest::runTest(Gaudi_Kernel_Name_e NameofKernel)
     return 0;
 }
 
+template <class T, class M>
+int Relu6AllTest::runMaskTestTyped(tpc_lib_api::DeviceId deviceId, int kernel, bool relu6, bool bwd)
+{
+    // two mask blocks, the second one partial
+    const int lanes = 256 / sizeof(T);
+    const int depth = Relu6All::c_maskBlockElements + 452;
+    const int blocks = (depth + Relu6All::c_maskBlockElements - 1) / Relu6All::c_maskBlockElements;
+    uint64_t fmInitializer[] = {(uint64_t)depth, 3, 2, 2, 1};
+    uint64_t maskInitializer[] = {(uint64_t)(blocks * lanes), 3, 2, 2, 1};
+
+    test::Tensor<T,5> input(fmInitializer);
+    input.InitRand(-10.0f, 10.0f);
+    // the region borders
+    const float borders[] = {0.0f, -0.0f, 6.0f, 5.9375f, 0.0625f};
+    for (unsigned i = 0; i < sizeof(borders) / sizeof(borders[0]); i++)
+    {
+        input.Data()[i] = (T)borders[i];
+    }
+    test::Tensor<T,5> gradin(fmInitializer);
+    gradin.InitRand(-10.0f, 10.0f);
+    test::Tensor<T,5> output(fmInitializer);
+    test::Tensor<M,5> mask(maskInitializer);
+    test::Tensor<M,5> mask_ref(maskInitializer);
+    memset(mask_ref.Data(), 0, mask_ref.ElementCount() * sizeof(M));
+
+    // execute reference implementation of the kernel, the gradient passes
+    // for 0 < x (< 6)
+    std::vector<float> output_ref(input.ElementCount());
+    int coords[5] = {0};
+    for (coords[4] = 0; coords[4] < (int)fmInitializer[4]; coords[4]++)
+    for (coords[3] = 0; coords[3] < (int)fmInitializer[3]; coords[3]++)
+    for (coords[2] = 0; coords[2] < (int)fmInitializer[2]; coords[2]++)
+    for (coords[1] = 0; coords[1] < (int)fmInitializer[1]; coords[1]++)
+    for (coords[0] = 0; coords[0] < depth; coords[0]++)
+    {
+        const int element = (((coords[4] * fmInitializer[3] + coords[3]) * fmInitializer[2] +
+                              coords[2]) * fmInitializer[1] + coords[1]) * depth + coords[0];
+        const float x = (float)input.ElementAt(coords);
+        const bool pass = x > 0.0f && (!relu6 || x < 6.0f);
+        float y = x > 0.0f ? x : 0.0f;
+        y = (relu6 && y > 6.0f) ? 6.0f : y;
+        output_ref[element] = bwd ? (pass ? (float)gradin.ElementAt(coords) : 0.0f) : y;
+
+        const int block = coords[0] / Relu6All::c_maskBlockElements;
+        const int offset = coords[0] % Relu6All::c_maskBlockElements;
+        int maskCoords[5] = {block * lanes + offset % lanes, coords[1], coords[2], coords[3], coords[4]};
+        if (pass)
+        {
+            M word = mask_ref.ElementAt(maskCoords) | (M)(1u << (offset / lanes));
+            mask_ref.SetElement(maskCoords, word);
+        }
+    }
+
+    // generate input for query call
+    m_in_defs.deviceId = deviceId;
+    if (bwd)
+    {
+        m_in_defs.inputTensorNr = 2;
+        LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[0]), gradin);
+        LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[1]), mask_ref);
+        m_in_defs.outputTensorNr = 1;
+        LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[0]), output);
+    }
+    else
+    {
+        m_in_defs.inputTensorNr = 1;
+        LoadTensorToGcDescriptor(&(m_in_defs.inputTensors[0]), input);
+        m_in_defs.outputTensorNr = 2;
+        LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[0]), output);
+        LoadTensorToGcDescriptor(&(m_in_defs.outputTensors[1]), mask);
+    }
+
+    tpc_lib_api::GuidInfo *guids = nullptr;
+    unsigned kernelCount = 0;
+    tpc_lib_api::GlueCodeReturn result = GetKernelGuids(deviceId, &kernelCount, guids);
+    guids = new tpc_lib_api::GuidInfo[kernelCount];
+    result = GetKernelGuids(deviceId, &kernelCount, guids);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "Can't get kernel name!! " << result << std::endl;
+        ReleaseKernelNames(guids, kernelCount);
+        return -1;
+    }
+
+    strcpy(m_in_defs.guid.name, guids[kernel].name);
+    result  = InstantiateTpcKernel(&m_in_defs,&m_out_defs);
+    ReleaseKernelNames(guids, kernelCount);
+    if (result != tpc_lib_api::GLUE_SUCCESS)
+    {
+        std::cout << "Glue test failed, can't load kernel " << result << std::endl;
+        return -1;
+    }
+
+    // generate and load tensor descriptors
+    std::vector<TensorDesc2> vec;
+    if (bwd)
+    {
+        vec.push_back(gradin.GetTensorDescriptor());
+        vec.push_back(mask_ref.GetTensorDescriptor());
+        vec.push_back(output.GetTensorDescriptor());
+    }
+    else
+    {
+        vec.push_back(input.GetTensorDescriptor());
+        vec.push_back(output.GetTensorDescriptor());
+        vec.push_back(mask.GetTensorDescriptor());
+    }
+    // execute a simulation of the kernel using TPC simulator,
+    TestBase::RunSimulation(vec, m_in_defs, m_out_defs);
+
+    for (int element = 0; element < output.ElementCount(); element++)
+    {
+        if ((float)output.Data()[element] != output_ref[element])
+        {
+            std::cout << m_in_defs.guid.name << " test failed at element " << element << "!!" << std::endl;
+            return -1;
+        }
+    }
+    if (!bwd && memcmp(mask.Data(), mask_ref.Data(), mask.ElementCount() * sizeof(M)) != 0)
+    {
+        std::cout << m_in_defs.guid.name << " mask mismatch, test failed!!" << std::endl;
+        return -1;
+    }
+
+    // saved for backward: the mask instead of the input
+    std::cout << m_in_defs.guid.name << " saves " << mask.ElementCount() * sizeof(M) << " bytes instead of "
+              << input.ElementCount() * sizeof(T) << ", test pass!!" << std::endl;
+    return 0;
+}
+
+int Relu6AllTest::runMaskTest(tpc_lib_api::DeviceId deviceId, int kernel, bool relu6, bool bwd, bool bf16)
+{
+    if (bf16)
+        return runMaskTestTyped<bfloat16, int16_t>(deviceId, kernel, relu6, bwd);
+    return runMaskTestTyped<float, int32_t>(deviceId, kernel, relu6, bwd);
+}
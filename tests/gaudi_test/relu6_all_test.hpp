@@ -28,6 +28,9 @@ public:
     Relu6AllTest() {}
     ~Relu6AllTest() {}
     int runTest(Gaudi_Kernel_Name_e NameofKernel);
+    // bit-packed mask modes of Relu6All (Gaudi) and ReluAllGaudi2, kernel is
+    // the guid index of the mode
+    int runMaskTest(tpc_lib_api::DeviceId deviceId, int kernel, bool relu6, bool bwd, bool bf16);
 
     static void relu6_f32_reference_implementation(
             const float_5DTensor& gradin,  
@@ -40,6 +43,10 @@ public:
             bfloat16_5DTensor& output, Gaudi_Kernel_Name_e mode);
             
 private:
+    // T is the data type, M the mask word
+    template <class T, class M>
+    int runMaskTestTyped(tpc_lib_api::DeviceId deviceId, int kernel, bool relu6, bool bwd);
+
     Relu6AllTest(const Relu6AllTest& other) = delete;
     Relu6AllTest& operator=(const Relu6AllTest& other) = delete;
 
@@ -28,6 +28,7 @@ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVE
 
 #include "bfloat16.h"
 #include "float16.h"
+#include "float8.h"
 #include "tpc_test_core_types.h"
 #include "gc_interface.h"
 #include "tpc_kernel_lib_interface.h"
@@ -420,6 +421,12 @@ tpc_lib_api::TensorDataType getGcDataType(const Tensor<signed char,NUM>& a)
    return tpc_lib_api::DATA_I8;
 }
 
+template<int NUM>
+tpc_lib_api::TensorDataType getGcDataType(const Tensor<unsigned char,NUM>& a)
+{
+   return tpc_lib_api::DATA_U8;
+}
+
 template<int NUM>
 tpc_lib_api::TensorDataType getGcDataType(const Tensor<signed int,NUM>& a)
 {
@@ -450,6 +457,18 @@ tpc_lib_api::TensorDataType getGcDataType(const Tensor<float16,NUM>& a)
    return tpc_lib_api::DATA_F16;
 }
 
+template<int NUM>
+tpc_lib_api::TensorDataType getGcDataType(const Tensor<float8_143,NUM>& a)
+{
+   return tpc_lib_api::DATA_F8_143;
+}
+
+template<int NUM>
+tpc_lib_api::TensorDataType getGcDataType(const Tensor<float8_152,NUM>& a)
+{
+   return tpc_lib_api::DATA_F8_152;
+}
+
 static const unsigned MAX_TENSOR_DIM = 5;
 
 
@@ -476,6 +495,7 @@ typedef test::Tensor<float,2>   float_2DTensor;
 typedef test::Tensor<float,3>   float_3DTensor;
 typedef test::Tensor<float,4>   float_4DTensor;
 typedef test::Tensor<float,5>   float_5DTensor;
+typedef test::Tensor<bfloat16,1>   bfloat16_1DTensor;
 typedef test::Tensor<bfloat16,2>   bfloat16_2DTensor;
 typedef test::Tensor<bfloat16,3>   bfloat16_3DTensor;
 typedef test::Tensor<bfloat16,4>   bfloat16_4DTensor;
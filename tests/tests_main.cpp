@@ -34,7 +34,30 @@ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVE
 #include "searchsorted_f32_test.hpp"
 #include "gather_fwd_i32_test.hpp"
 #include "kl_div_all_test.hpp"
+#include "binary_broadcast_test.hpp"
 #include "user_lut_gaudi2_test.hpp"
+#include "layer_norm_all_gaudi2_test.hpp"
+#include "activation_all_gaudi2_test.hpp"
+#include "rope_gaudi2_test.hpp"
+#include "topk_gaudi2_test.hpp"
+#include "scan_gaudi2_test.hpp"
+#include "cross_entropy_gaudi2_test.hpp"
+#include "softmax_bwd_bf16_gaudi2_test.hpp"
+#include "softmax_masked_gaudi2_test.hpp"
+#include "adamw_gaudi2_test.hpp"
+#include "grad_norm_gaudi2_test.hpp"
+#include "fp8_cast_gaudi2_test.hpp"
+#include "quantize_i8_gaudi2_test.hpp"
+#include "cast_all_gaudi2_test.hpp"
+#include "permute_gaudi2_test.hpp"
+#include "fused_elementwise_gaudi2_test.hpp"
+#include "reduction_gaudi2_test.hpp"
+#include "transcendental_gaudi2_test.hpp"
+#include "dropout_gaudi2_test.hpp"
+#include "piecewise_poly_gaudi2_test.hpp"
+#include "aux_tensor_store_gaudi2_test.hpp"
+#include "fused_attention_gaudi2_test.hpp"
+#include "paged_kv_cache_gaudi2_test.hpp"
 #include "mamba_pscan_gaudi3_test.hpp"
 #include "mamba_pscan_update_gaudi3_test.hpp"
 
@@ -89,6 +112,7 @@ int main(int argc, char** argv)
             "ReluBwdF32                 Run ReluBwdF32 only   " << std::endl <<
             "ReluFwdBF16                Run ReluFwdBF16 only   " << std::endl <<
             "ReluBwdBF16                Run ReluBwdBF16 only   " << std::endl <<
+            "ReluMaskTest               Run ReluMaskTest only   " << std::endl <<
             "MatrixMulFwdF32Test        Run MatrixMulFwdF32Test only   " << std::endl <<
             "SpatialConvF32Test         Run SpatialConvF32Test only   " << std::endl <<
             "SinF32Test                 Run SinF32Test only   " << std::endl <<
@@ -98,12 +122,64 @@ int main(int argc, char** argv)
             "SearchSortedFwdF32Test     Run SearchSortedFwdF32Test only   " << std::endl <<
             "GatherFwdDim0I32Test       Run GatherFwdDim0I32Test only   " << std::endl <<
             "KLDivFwdF32                Run KLDivFwdF32 only   "          << std::endl <<
+            "BinaryBroadcastTest        Run BinaryBroadcastTest only   " << std::endl <<
+            "CastAllGaudiTest           Run CastAllGaudiTest only   " << std::endl <<
 
             "AvgPool2DFwdF32Gaudi2Test  Run AvgPool2DFwdF32Gaudi2Test only   " << std::endl <<
             "AvgPool2DBwdF32Gaudi2Test  Run AvgPool2DBwdF32Gaudi2Test only   " << std::endl <<
             "CastF16toI16Gaudi2Test     Run CastF16toI16Gaudi2Test only   " << std::endl <<
             "SoftMaxBF16Gaudi2Test      Run SoftMaxBF16Gaudi2Test only   " << std::endl <<
             "UserLutGaudi2Test          Run UserLutGaudi2Test only   " << std::endl <<
+            "LayerNormFwdF32Gaudi2Test           Run LayerNormFwdF32Gaudi2Test only   " << std::endl <<
+            "LayerNormFwdBF16Gaudi2Test          Run LayerNormFwdBF16Gaudi2Test only   " << std::endl <<
+            "LayerNormResidualFwdF32Gaudi2Test   Run LayerNormResidualFwdF32Gaudi2Test only   " << std::endl <<
+            "LayerNormResidualFwdBF16Gaudi2Test  Run LayerNormResidualFwdBF16Gaudi2Test only   " << std::endl <<
+            "LayerNormBwdF32Gaudi2Test           Run LayerNormBwdF32Gaudi2Test only   " << std::endl <<
+            "LayerNormBwdBF16Gaudi2Test          Run LayerNormBwdBF16Gaudi2Test only   " << std::endl <<
+            "RmsNormFwdF32Gaudi2Test             Run RmsNormFwdF32Gaudi2Test only   " << std::endl <<
+            "RmsNormFwdBF16Gaudi2Test            Run RmsNormFwdBF16Gaudi2Test only   " << std::endl <<
+            "RmsNormResidualFwdF32Gaudi2Test     Run RmsNormResidualFwdF32Gaudi2Test only   " << std::endl <<
+            "RmsNormResidualFwdBF16Gaudi2Test    Run RmsNormResidualFwdBF16Gaudi2Test only   " << std::endl <<
+            "RmsNormBwdF32Gaudi2Test             Run RmsNormBwdF32Gaudi2Test only   " << std::endl <<
+            "RmsNormBwdBF16Gaudi2Test            Run RmsNormBwdBF16Gaudi2Test only   " << std::endl <<
+            "GeluTanhGaudi2Test                  Run GeluTanhGaudi2Test only   " << std::endl <<
+            "GeluErfGaudi2Test                   Run GeluErfGaudi2Test only   " << std::endl <<
+            "SiluGaudi2Test                      Run SiluGaudi2Test only   " << std::endl <<
+            "SwiGluGaudi2Test                    Run SwiGluGaudi2Test only   " << std::endl <<
+            "GeGluGaudi2Test                     Run GeGluGaudi2Test only   " << std::endl <<
+            "RopeCacheGaudi2Test                 Run RopeCacheGaudi2Test only   " << std::endl <<
+            "RopeDynamicGaudi2Test               Run RopeDynamicGaudi2Test only   " << std::endl <<
+            "TopKGaudi2Test                      Run TopKGaudi2Test only   " << std::endl <<
+            "ArgMaxGaudi2Test                    Run ArgMaxGaudi2Test only   " << std::endl <<
+            "CumSumGaudi2Test                    Run CumSumGaudi2Test only   " << std::endl <<
+            "CumProdGaudi2Test                   Run CumProdGaudi2Test only   " << std::endl <<
+            "CrossEntropyGaudi2Test              Run CrossEntropyGaudi2Test only   " << std::endl <<
+            "SoftMaxBwdBF16Gaudi2Test            Run SoftMaxBwdBF16Gaudi2Test only   " << std::endl <<
+            "SoftMaxMaskedGaudi2Test             Run SoftMaxMaskedGaudi2Test only   " << std::endl <<
+            "AdamWGaudi2Test                     Run AdamWGaudi2Test only   " << std::endl <<
+            "GradNormGaudi2Test                  Run GradNormGaudi2Test only   " << std::endl <<
+            "Fp8CastGaudi2Test                   Run Fp8CastGaudi2Test only   " << std::endl <<
+            "QuantizeI8Gaudi2Test                Run QuantizeI8Gaudi2Test only   " << std::endl <<
+            "CastAllGaudi2Test                   Run CastAllGaudi2Test only   " << std::endl <<
+            "PermuteGaudi2Test                   Run PermuteGaudi2Test only   " << std::endl <<
+            "BinaryBroadcastGaudi2Test           Run BinaryBroadcastGaudi2Test only   " << std::endl <<
+            "FusedElementwiseGaudi2Test          Run FusedElementwiseGaudi2Test only   " << std::endl <<
+            "ReductionGaudi2Test                 Run ReductionGaudi2Test only   " << std::endl <<
+            "TranscendentalGaudi2Test            Run TranscendentalGaudi2Test only   " << std::endl <<
+            "ReluMaskGaudi2Test                  Run ReluMaskGaudi2Test only   " << std::endl <<
+            "DropoutGaudi2Test                   Run DropoutGaudi2Test only   " << std::endl <<
+            "PiecewisePolyGaudi2Test             Run PiecewisePolyGaudi2Test only   " << std::endl <<
+            "AuxTensorStoreGaudi2Test            Run AuxTensorStoreGaudi2Test only   " << std::endl <<
+            "FusedAttentionGaudi2Test            Run FusedAttentionGaudi2Test only   " << std::endl <<
+            "PagedKvCacheGaudi2Test              Run PagedKvCacheGaudi2Test only   " << std::endl <<
+            "GeluTanhGaudi3Test                  Run GeluTanhGaudi3Test only   " << std::endl <<
+            "GeluErfGaudi3Test                   Run GeluErfGaudi3Test only   " << std::endl <<
+            "SiluGaudi3Test                      Run SiluGaudi3Test only   " << std::endl <<
+            "SwiGluGaudi3Test                    Run SwiGluGaudi3Test only   " << std::endl <<
+            "GeGluGaudi3Test                     Run GeGluGaudi3Test only   " << std::endl <<
+            "Fp8CastGaudi3Test                   Run Fp8CastGaudi3Test only   " << std::endl <<
+            "CastAllGaudi3Test                   Run CastAllGaudi3Test only   " << std::endl <<
+            "BinaryBroadcastGaudi3Test           Run BinaryBroadcastGaudi3Test only   " << std::endl <<
             "MambaPscanGaudi3F32Test         Run MambaPscanGaudi3F32Test only   "        << std::endl <<
             "MambaPscanGaudi3BF16Test        Run MambaPscanGaudi3BF16Test only   "       << std::endl <<
             "MambaPscanUpdateGaudi3F32Test   Run MambaPscanUpdateGaudi3F32Test only   "  << std::endl <<
@@ -150,7 +226,7 @@ int main(int argc, char** argv)
         testCaseGaudi.SetUp();
         result = testCaseGaudi.runTest();
         testCaseGaudi.TearDown();
-        testCount += 2;
+        testCount += 3;
         if (result != 0)
         {
             return result;
@@ -307,6 +383,24 @@ int main(int argc, char** argv)
         }
     }
 
+    if(check_arg(argc, argv, "Gaudi", "ReluMaskTest"))
+    {
+        // relu6 / relu x f32 / bf16 x fwd / bwd, in the kernel enum order
+        for (int kernel = GAUDI_KERNEL_RELU6_FWD_MASK_F32; kernel <= GAUDI_KERNEL_RELU_BWD_MASK_BF16; kernel++)
+        {
+            const int index = kernel - GAUDI_KERNEL_RELU6_FWD_MASK_F32;
+            testRelu.SetUp();
+            result = testRelu.runMaskTest(tpc_lib_api::DEVICE_ID_GAUDI, kernel,
+                                          index < 4, index & 1, index & 2);
+            testRelu.TearDown();
+            testCount ++;
+            if (result != 0)
+            {
+                return result;
+            }
+        }
+    }
+
     if(check_arg(argc, argv, "Gaudi", "MatrixMulFwdF32Test"))
     {
         MatrixMulFwdF32Test testMatrixMulFwdF32;
@@ -423,6 +517,49 @@ int main(int argc, char** argv)
         }
     }
 
+    if(check_arg(argc, argv, "Gaudi", "BinaryBroadcastTest"))
+    {
+        BinaryBroadcastTest testBinaryBroadcast;
+        // every op and data type over the BinaryBroadcastTest shape cases
+        for (int mode = 0; mode < BinaryBroadcast::binary_broadcast_mode_count; mode++)
+        {
+            for (int op = 0; op < BinaryBroadcast::binary_op_count; op++)
+            {
+                for (int testCase = 0; testCase < BinaryBroadcastTest::c_testCaseCount; testCase++)
+                {
+                    testBinaryBroadcast.SetUp();
+                    result = testBinaryBroadcast.runTest(tpc_lib_api::DEVICE_ID_GAUDI,
+                                          (BinaryBroadcast::BinaryBroadcast_mode_t)mode,
+                                          (BinaryBroadcast::BinaryOp_t)op, testCase);
+                    testBinaryBroadcast.TearDown();
+                    testCount++;
+                    if (result != 0)
+                    {
+                        return result;
+                    }
+                }
+            }
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi", "CastAllGaudiTest"))
+    {
+        CastAllGaudi2Test testCastAll;
+        // every (src, dst) pair of f32 / bf16 / i32 / i16 / i8 / u8
+        for (int pair = 0; pair < CastAllGaudi::c_pairCount; pair++)
+        {
+            testCastAll.SetUp();
+            result = testCastAll.runTest(tpc_lib_api::DEVICE_ID_GAUDI,
+                                         CastAllGaudi::GetPairSrc(pair), CastAllGaudi::GetPairDst(pair));
+            testCastAll.TearDown();
+            testCount++;
+            if (result != 0)
+            {
+                return result;
+            }
+        }
+    }
+
     // The following ones are for Gaudi2
     AvgPool2DF32Gaudi2Test avgpool2df32Gaudi2ins;
     if(check_arg(argc, argv, "Gaudi2", "AvgPool2DFwdF32Gaudi2Test"))
@@ -490,6 +627,693 @@ int main(int argc, char** argv)
         }
     }
 
+    LayerNormAllGaudi2Test testLayerNorm;
+    if(check_arg(argc, argv, "Gaudi2", "LayerNormFwdF32Gaudi2Test"))
+    {
+        testLayerNorm.SetUp();
+        result = testLayerNorm.runTest(GAUDI2_KERNEL_LAYER_NORM_FWD_F32);
+        testLayerNorm.TearDown();
+        testCount++;
+        if (result != 0)
+        {
+            return result;
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi2", "LayerNormFwdBF16Gaudi2Test"))
+    {
+        testLayerNorm.SetUp();
+        result = testLayerNorm.runTest(GAUDI2_KERNEL_LAYER_NORM_FWD_BF16);
+        testLayerNorm.TearDown();
+        testCount++;
+        if (result != 0)
+        {
+            return result;
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi2", "LayerNormResidualFwdF32Gaudi2Test"))
+    {
+        testLayerNorm.SetUp();
+        result = testLayerNorm.runTest(GAUDI2_KERNEL_LAYER_NORM_RESIDUAL_FWD_F32);
+        testLayerNorm.TearDown();
+        testCount++;
+        if (result != 0)
+        {
+            return result;
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi2", "LayerNormResidualFwdBF16Gaudi2Test"))
+    {
+        testLayerNorm.SetUp();
+        result = testLayerNorm.runTest(GAUDI2_KERNEL_LAYER_NORM_RESIDUAL_FWD_BF16);
+        testLayerNorm.TearDown();
+        testCount++;
+        if (result != 0)
+        {
+            return result;
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi2", "LayerNormBwdF32Gaudi2Test"))
+    {
+        testLayerNorm.SetUp();
+        result = testLayerNorm.runTest(GAUDI2_KERNEL_LAYER_NORM_BWD_F32);
+        testLayerNorm.TearDown();
+        testCount++;
+        if (result != 0)
+        {
+            return result;
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi2", "LayerNormBwdBF16Gaudi2Test"))
+    {
+        testLayerNorm.SetUp();
+        result = testLayerNorm.runTest(GAUDI2_KERNEL_LAYER_NORM_BWD_BF16);
+        testLayerNorm.TearDown();
+        testCount++;
+        if (result != 0)
+        {
+            return result;
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi2", "RmsNormFwdF32Gaudi2Test"))
+    {
+        testLayerNorm.SetUp();
+        result = testLayerNorm.runTest(GAUDI2_KERNEL_RMS_NORM_FWD_F32);
+        testLayerNorm.TearDown();
+        testCount++;
+        if (result != 0)
+        {
+            return result;
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi2", "RmsNormFwdBF16Gaudi2Test"))
+    {
+        testLayerNorm.SetUp();
+        result = testLayerNorm.runTest(GAUDI2_KERNEL_RMS_NORM_FWD_BF16);
+        testLayerNorm.TearDown();
+        testCount++;
+        if (result != 0)
+        {
+            return result;
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi2", "RmsNormResidualFwdF32Gaudi2Test"))
+    {
+        testLayerNorm.SetUp();
+        result = testLayerNorm.runTest(GAUDI2_KERNEL_RMS_NORM_RESIDUAL_FWD_F32);
+        testLayerNorm.TearDown();
+        testCount++;
+        if (result != 0)
+        {
+            return result;
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi2", "RmsNormResidualFwdBF16Gaudi2Test"))
+    {
+        testLayerNorm.SetUp();
+        result = testLayerNorm.runTest(GAUDI2_KERNEL_RMS_NORM_RESIDUAL_FWD_BF16);
+        testLayerNorm.TearDown();
+        testCount++;
+        if (result != 0)
+        {
+            return result;
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi2", "RmsNormBwdF32Gaudi2Test"))
+    {
+        testLayerNorm.SetUp();
+        result = testLayerNorm.runTest(GAUDI2_KERNEL_RMS_NORM_BWD_F32);
+        testLayerNorm.TearDown();
+        testCount++;
+        if (result != 0)
+        {
+            return result;
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi2", "RmsNormBwdBF16Gaudi2Test"))
+    {
+        testLayerNorm.SetUp();
+        result = testLayerNorm.runTest(GAUDI2_KERNEL_RMS_NORM_BWD_BF16);
+        testLayerNorm.TearDown();
+        testCount++;
+        if (result != 0)
+        {
+            return result;
+        }
+    }
+
+    ActivationAllGaudi2Test testActivationG2;
+    if(check_arg(argc, argv, "Gaudi2", "GeluTanhGaudi2Test"))
+    {
+        // fwd/bwd x f32/bf16
+        for (int mode = ActivationAllGaudi2::gelu_tanh_fwd_f32; mode < ActivationAllGaudi2::gelu_tanh_fwd_f32 + 4; mode++)
+        {
+            testActivationG2.SetUp();
+            result = testActivationG2.runTest(tpc_lib_api::DEVICE_ID_GAUDI2, (ActivationAllGaudi2::Activation_mode_t)mode);
+            testActivationG2.TearDown();
+            testCount++;
+            if (result != 0)
+            {
+                return result;
+            }
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi2", "GeluErfGaudi2Test"))
+    {
+        // fwd/bwd x f32/bf16
+        for (int mode = ActivationAllGaudi2::gelu_erf_fwd_f32; mode < ActivationAllGaudi2::gelu_erf_fwd_f32 + 4; mode++)
+        {
+            testActivationG2.SetUp();
+            result = testActivationG2.runTest(tpc_lib_api::DEVICE_ID_GAUDI2, (ActivationAllGaudi2::Activation_mode_t)mode);
+            testActivationG2.TearDown();
+            testCount++;
+            if (result != 0)
+            {
+                return result;
+            }
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi2", "SiluGaudi2Test"))
+    {
+        // fwd/bwd x f32/bf16
+        for (int mode = ActivationAllGaudi2::silu_fwd_f32; mode < ActivationAllGaudi2::silu_fwd_f32 + 4; mode++)
+        {
+            testActivationG2.SetUp();
+            result = testActivationG2.runTest(tpc_lib_api::DEVICE_ID_GAUDI2, (ActivationAllGaudi2::Activation_mode_t)mode);
+            testActivationG2.TearDown();
+            testCount++;
+            if (result != 0)
+            {
+                return result;
+            }
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi2", "SwiGluGaudi2Test"))
+    {
+        // fwd/bwd x f32/bf16
+        for (int mode = ActivationAllGaudi2::swiglu_fwd_f32; mode < ActivationAllGaudi2::swiglu_fwd_f32 + 4; mode++)
+        {
+            testActivationG2.SetUp();
+            result = testActivationG2.runTest(tpc_lib_api::DEVICE_ID_GAUDI2, (ActivationAllGaudi2::Activation_mode_t)mode);
+            testActivationG2.TearDown();
+            testCount++;
+            if (result != 0)
+            {
+                return result;
+            }
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi2", "GeGluGaudi2Test"))
+    {
+        // fwd/bwd x f32/bf16
+        for (int mode = ActivationAllGaudi2::geglu_fwd_f32; mode < ActivationAllGaudi2::geglu_fwd_f32 + 4; mode++)
+        {
+            testActivationG2.SetUp();
+            result = testActivationG2.runTest(tpc_lib_api::DEVICE_ID_GAUDI2, (ActivationAllGaudi2::Activation_mode_t)mode);
+            testActivationG2.TearDown();
+            testCount++;
+            if (result != 0)
+            {
+                return result;
+            }
+        }
+    }
+
+    RopeGaudi2Test testRope;
+    if(check_arg(argc, argv, "Gaudi2", "RopeCacheGaudi2Test"))
+    {
+        // half/interleaved x f32/bf16
+        for (int kernel = GAUDI2_KERNEL_ROPE_HALF_CACHE_F32; kernel <= GAUDI2_KERNEL_ROPE_INTERLEAVED_CACHE_BF16; kernel++)
+        {
+            testRope.SetUp();
+            result = testRope.runTest((Gaudi2_Kernel_Name_e)kernel);
+            testRope.TearDown();
+            testCount++;
+            if (result != 0)
+            {
+                return result;
+            }
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi2", "RopeDynamicGaudi2Test"))
+    {
+        // half/interleaved x f32/bf16
+        for (int kernel = GAUDI2_KERNEL_ROPE_HALF_DYNAMIC_F32; kernel <= GAUDI2_KERNEL_ROPE_INTERLEAVED_DYNAMIC_BF16; kernel++)
+        {
+            testRope.SetUp();
+            result = testRope.runTest((Gaudi2_Kernel_Name_e)kernel);
+            testRope.TearDown();
+            testCount++;
+            if (result != 0)
+            {
+                return result;
+            }
+        }
+    }
+
+    TopKGaudi2Test testTopK;
+    if(check_arg(argc, argv, "Gaudi2", "TopKGaudi2Test"))
+    {
+        for (int kernel = GAUDI2_KERNEL_TOPK_F32; kernel <= GAUDI2_KERNEL_TOPK_BF16; kernel++)
+        {
+            testTopK.SetUp();
+            result = testTopK.runTest((Gaudi2_Kernel_Name_e)kernel);
+            testTopK.TearDown();
+            testCount++;
+            if (result != 0)
+            {
+                return result;
+            }
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi2", "ArgMaxGaudi2Test"))
+    {
+        for (int kernel = GAUDI2_KERNEL_ARGMAX_F32; kernel <= GAUDI2_KERNEL_ARGMAX_BF16; kernel++)
+        {
+            testTopK.SetUp();
+            result = testTopK.runTest((Gaudi2_Kernel_Name_e)kernel);
+            testTopK.TearDown();
+            testCount++;
+            if (result != 0)
+            {
+                return result;
+            }
+        }
+    }
+
+    ScanGaudi2Test testScan;
+    if(check_arg(argc, argv, "Gaudi2", "CumSumGaudi2Test"))
+    {
+        // f32/bf16/i32, each covering the single pass and the three-phase scan
+        for (int mode = ScanGaudi2::cumsum_f32; mode < ScanGaudi2::cumprod_f32; mode += 3)
+        {
+            testScan.SetUp();
+            result = testScan.runTest((ScanGaudi2::Scan_mode_t)mode);
+            testScan.TearDown();
+            testCount++;
+            if (result != 0)
+            {
+                return result;
+            }
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi2", "CumProdGaudi2Test"))
+    {
+        // f32/bf16/i32, each covering the single pass and the three-phase scan
+        for (int mode = ScanGaudi2::cumprod_f32; mode < ScanGaudi2::scan_mode_count; mode += 3)
+        {
+            testScan.SetUp();
+            result = testScan.runTest((ScanGaudi2::Scan_mode_t)mode);
+            testScan.TearDown();
+            testCount++;
+            if (result != 0)
+            {
+                return result;
+            }
+        }
+    }
+
+    CrossEntropyGaudi2Test testCrossEntropy;
+    if(check_arg(argc, argv, "Gaudi2", "CrossEntropyGaudi2Test"))
+    {
+        for (int kernel = GAUDI2_KERNEL_CROSS_ENTROPY_FWD_F32; kernel <= GAUDI2_KERNEL_CROSS_ENTROPY_BWD_BF16; kernel++)
+        {
+            for (int reduction = CrossEntropyGaudi2::reduction_none; reduction <= CrossEntropyGaudi2::reduction_sum; reduction++)
+            {
+                testCrossEntropy.SetUp();
+                result = testCrossEntropy.runTest((Gaudi2_Kernel_Name_e)kernel,
+                                                  (CrossEntropyGaudi2::CrossEntropy_reduction_t)reduction);
+                testCrossEntropy.TearDown();
+                testCount++;
+                if (result != 0)
+                {
+                    return result;
+                }
+            }
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi2", "SoftMaxBwdBF16Gaudi2Test"))
+    {
+        SoftMaxBwdBF16Gaudi2Test testSoftMaxBwd;
+        for (int axis = 0; axis < 2; axis++)
+        {
+            testSoftMaxBwd.SetUp();
+            result = testSoftMaxBwd.runTest(axis);
+            testSoftMaxBwd.TearDown();
+            testCount++;
+            if (result != 0)
+            {
+                return result;
+            }
+        }
+    }
+
+    SoftMaxMaskedGaudi2Test testSoftMaxMasked;
+    if(check_arg(argc, argv, "Gaudi2", "SoftMaxMaskedGaudi2Test"))
+    {
+        for (int kernel = GAUDI2_KERNEL_SOFTMAX_SCALED_F32; kernel <= GAUDI2_KERNEL_SOFTMAX_MASKED_BF16; kernel++)
+        {
+            for (int maskMode = SoftMaxMaskedGaudi2::mask_none; maskMode <= SoftMaxMaskedGaudi2::mask_alibi; maskMode++)
+            {
+                testSoftMaxMasked.SetUp();
+                result = testSoftMaxMasked.runTest((Gaudi2_Kernel_Name_e)kernel,
+                                                   (SoftMaxMaskedGaudi2::SoftMaxMasked_maskMode_t)maskMode);
+                testSoftMaxMasked.TearDown();
+                testCount++;
+                if (result != 0)
+                {
+                    return result;
+                }
+            }
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi2", "AdamWGaudi2Test"))
+    {
+        AdamWGaudi2Test testAdamW;
+        for (int kernel = GAUDI2_KERNEL_ADAMW_F32; kernel <= GAUDI2_KERNEL_ADAMW_MULTI_BF16; kernel++)
+        {
+            testAdamW.SetUp();
+            result = testAdamW.runTest((Gaudi2_Kernel_Name_e)kernel);
+            testAdamW.TearDown();
+            testCount++;
+            if (result != 0)
+            {
+                return result;
+            }
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi2", "GradNormGaudi2Test"))
+    {
+        GradNormGaudi2Test testGradNorm;
+        for (int kernel = GAUDI2_KERNEL_GRAD_NORM_F32; kernel <= GAUDI2_KERNEL_GRAD_NORM_MULTI_BF16; kernel++)
+        {
+            // finite gradients, then an inf and a NaN
+            for (int nonFinite = 0; nonFinite < 2; nonFinite++)
+            {
+                testGradNorm.SetUp();
+                result = testGradNorm.runTest((Gaudi2_Kernel_Name_e)kernel, nonFinite != 0);
+                testGradNorm.TearDown();
+                testCount++;
+                if (result != 0)
+                {
+                    return result;
+                }
+            }
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi2", "Fp8CastGaudi2Test"))
+    {
+        Fp8CastGaudi2Test testFp8CastG2;
+        // quant then dequant, E4M3 / E5M2 x f32 / bf16
+        for (int mode = 0; mode < Fp8CastGaudi2::fp8_cast_mode_count; mode++)
+        {
+            testFp8CastG2.SetUp();
+            result = testFp8CastG2.runTest(tpc_lib_api::DEVICE_ID_GAUDI2, (Fp8CastGaudi2::Fp8Cast_mode_t)mode);
+            testFp8CastG2.TearDown();
+            testCount++;
+            if (result != 0)
+            {
+                return result;
+            }
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi2", "QuantizeI8Gaudi2Test"))
+    {
+        QuantizeI8Gaudi2Test testQuantizeI8;
+        for (int mode = 0; mode < QuantizeI8Gaudi2::quantize_i8_mode_count; mode++)
+        {
+            // channel modes run along the FCD and along dim 2, dynamic
+            // modes asymmetric then symmetric
+            QuantizeI8Gaudi2 modeInfo((QuantizeI8Gaudi2::QuantizeI8_mode_t)mode);
+            const int params[2] = {0, modeInfo.IsPerChannel() ? 2 : 1};
+            const int paramCount = (modeInfo.IsPerChannel() || modeInfo.IsDynamic()) ? 2 : 1;
+            for (int p = 0; p < paramCount; p++)
+            {
+                testQuantizeI8.SetUp();
+                result = testQuantizeI8.runTest((QuantizeI8Gaudi2::QuantizeI8_mode_t)mode, params[p]);
+                testQuantizeI8.TearDown();
+                testCount++;
+                if (result != 0)
+                {
+                    return result;
+                }
+            }
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi2", "CastAllGaudi2Test"))
+    {
+        CastAllGaudi2Test testCastAllG2;
+        // every (src, dst) pair of f32 / bf16 / f16 / i32 / i16 / i8 / u8
+        for (int pair = 0; pair < CastAllGaudi2::c_pairCount; pair++)
+        {
+            testCastAllG2.SetUp();
+            result = testCastAllG2.runTest(tpc_lib_api::DEVICE_ID_GAUDI2,
+                                          CastAllGaudi2::GetPairSrc(pair), CastAllGaudi2::GetPairDst(pair));
+            testCastAllG2.TearDown();
+            testCount++;
+            if (result != 0)
+            {
+                return result;
+            }
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi2", "PermuteGaudi2Test"))
+    {
+        PermuteGaudi2Test testPermute;
+        // FCD kept, head transpose, NCHW -> NHWC, 2D transpose and a 5D
+        // permutation, sizes past one tile and not multiples of it, the last
+        // 2D transpose also past the 256 wide tiles of the 8 bit types
+        const int perms[][5] = {{0, 2, 1, 3, 4},
+                                {2, 0, 1, 3, 4},
+                                {1, 0, 2, 3, 4},
+                                {3, 0, 4, 2, 1},
+                                {1, 0, 2, 3, 4}};
+        const uint64_t sizes[][5] = {{70, 5, 3, 2, 1},
+                                     {150, 9, 20, 3, 1},
+                                     {200, 135, 1, 1, 1},
+                                     {67, 3, 2, 130, 2},
+                                     {300, 270, 1, 1, 1}};
+        for (int mode = 0; mode < PermuteGaudi2::permute_mode_count; mode++)
+        {
+            for (unsigned i = 0; i < sizeof(perms) / sizeof(perms[0]); i++)
+            {
+                testPermute.SetUp();
+                result = testPermute.runTest((PermuteGaudi2::Permute_mode_t)mode, perms[i], sizes[i]);
+                testPermute.TearDown();
+                testCount++;
+                if (result != 0)
+                {
+                    return result;
+                }
+            }
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi2", "BinaryBroadcastGaudi2Test"))
+    {
+        BinaryBroadcastTest testBinaryBroadcastG2;
+        // every op and data type over the BinaryBroadcastTest shape cases
+        for (int mode = 0; mode < BinaryBroadcast::binary_broadcast_mode_count; mode++)
+        {
+            for (int op = 0; op < BinaryBroadcast::binary_op_count; op++)
+            {
+                for (int testCase = 0; testCase < BinaryBroadcastTest::c_testCaseCount; testCase++)
+                {
+                    testBinaryBroadcastG2.SetUp();
+                    result = testBinaryBroadcastG2.runTest(tpc_lib_api::DEVICE_ID_GAUDI2,
+                                          (BinaryBroadcast::BinaryBroadcast_mode_t)mode,
+                                          (BinaryBroadcast::BinaryOp_t)op, testCase);
+                    testBinaryBroadcastG2.TearDown();
+                    testCount++;
+                    if (result != 0)
+                    {
+                        return result;
+                    }
+                }
+            }
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi2", "FusedElementwiseGaudi2Test"))
+    {
+        FusedElementwiseGaudi2Test testFused;
+        for (int testCase = 0; testCase < FusedElementwiseGaudi2Test::c_testCaseCount; testCase++)
+        {
+            testFused.SetUp();
+            result = testFused.runTest(testCase);
+            testFused.TearDown();
+            testCount++;
+            if (result != 0)
+            {
+                return result;
+            }
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi2", "ReductionGaudi2Test"))
+    {
+        ReductionGaudi2Test testReduction;
+        for (int testCase = 0; testCase < ReductionGaudi2Test::c_testCaseCount; testCase++)
+        {
+            testReduction.SetUp();
+            result = testReduction.runTest(testCase);
+            testReduction.TearDown();
+            testCount++;
+            if (result != 0)
+            {
+                return result;
+            }
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi2", "TranscendentalGaudi2Test"))
+    {
+        TranscendentalGaudi2Test testTranscendental;
+        for (int mode = 0; mode < TranscendentalGaudi2::tr_mode_count; mode++)
+        {
+            for (int tier = 0; tier < TranscendentalGaudi2::tier_count; tier++)
+            {
+                testTranscendental.SetUp();
+                result = testTranscendental.runTest((TranscendentalGaudi2::Transcendental_mode_t)mode,
+                                                    (TranscendentalGaudi2::Tier_t)tier);
+                testTranscendental.TearDown();
+                testCount++;
+                if (result != 0)
+                {
+                    return result;
+                }
+            }
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi2", "ReluMaskGaudi2Test"))
+    {
+        Relu6AllTest testReluMask;
+        for (int kernel = GAUDI2_KERNEL_RELU_FWD_MASK_F32; kernel <= GAUDI2_KERNEL_RELU_BWD_MASK_BF16; kernel++)
+        {
+            const int index = kernel - GAUDI2_KERNEL_RELU_FWD_MASK_F32;
+            testReluMask.SetUp();
+            result = testReluMask.runMaskTest(tpc_lib_api::DEVICE_ID_GAUDI2, kernel,
+                                              false, index & 1, index & 2);
+            testReluMask.TearDown();
+            testCount++;
+            if (result != 0)
+            {
+                return result;
+            }
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi2", "DropoutGaudi2Test"))
+    {
+        DropoutGaudi2Test testDropout;
+        for (int mode = 0; mode < DropoutGaudi2::dropout_mode_count; mode++)
+        {
+            testDropout.SetUp();
+            result = testDropout.runTest((DropoutGaudi2::Dropout_mode_t)mode);
+            testDropout.TearDown();
+            testCount++;
+            if (result != 0)
+            {
+                return result;
+            }
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi2", "PiecewisePolyGaudi2Test"))
+    {
+        // intervals x degree
+        const int configs[][2] = {{32, 3}, {16, 2}, {8, 1}};
+        PiecewisePolyGaudi2Test testPiecewisePoly;
+        for (int act = 0; act < PiecewisePolyGaudi2Test::act_count; act++)
+        {
+            for (const auto& config : configs)
+            {
+                testPiecewisePoly.SetUp();
+                result = testPiecewisePoly.runTest((PiecewisePolyGaudi2Test::Activation_t)act,
+                                                   config[0], config[1]);
+                testPiecewisePoly.TearDown();
+                testCount++;
+                if (result != 0)
+                {
+                    return result;
+                }
+            }
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi2", "AuxTensorStoreGaudi2Test"))
+    {
+        AuxTensorStoreGaudi2Test testAuxStore;
+        testAuxStore.SetUp();
+        result = testAuxStore.runTest();
+        testAuxStore.TearDown();
+        testCount++;
+        if (result != 0)
+        {
+            return result;
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi2", "FusedAttentionGaudi2Test"))
+    {
+        FusedAttentionGaudi2Test testAttention;
+        for (int kernel = GAUDI2_KERNEL_FUSED_ATTENTION_F32; kernel <= GAUDI2_KERNEL_FUSED_ATTENTION_KV_LENGTHS_F32; kernel++)
+        {
+            for (int causal = 0; causal < 2; causal++)
+            {
+                testAttention.SetUp();
+                result = testAttention.runTest((Gaudi2_Kernel_Name_e)kernel, causal != 0);
+                testAttention.TearDown();
+                testCount++;
+                if (result != 0)
+                {
+                    return result;
+                }
+            }
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi2", "PagedKvCacheGaudi2Test"))
+    {
+        PagedKvCacheGaudi2Test testPagedKv;
+        for (int kernel = GAUDI2_KERNEL_PAGED_KV_GATHER_BF16; kernel <= GAUDI2_KERNEL_PAGED_KV_APPEND_FP8; kernel++)
+        {
+            testPagedKv.SetUp();
+            result = testPagedKv.runTest((Gaudi2_Kernel_Name_e)kernel);
+            testPagedKv.TearDown();
+            testCount++;
+            if (result != 0)
+            {
+                return result;
+            }
+        }
+    }
+
     MambaPscanGaudi3Test testPscan;
     if(check_arg(argc, argv, "Gaudi3", "MambaPscanGaudi3F32Test"))
     {
@@ -540,6 +1364,147 @@ int main(int argc, char** argv)
         }
     }
 
+    ActivationAllGaudi2Test testActivationG3;
+    if(check_arg(argc, argv, "Gaudi3", "GeluTanhGaudi3Test"))
+    {
+        // fwd/bwd x f32/bf16
+        for (int mode = ActivationAllGaudi2::gelu_tanh_fwd_f32; mode < ActivationAllGaudi2::gelu_tanh_fwd_f32 + 4; mode++)
+        {
+            testActivationG3.SetUp();
+            result = testActivationG3.runTest(tpc_lib_api::DEVICE_ID_GAUDI3, (ActivationAllGaudi2::Activation_mode_t)mode);
+            testActivationG3.TearDown();
+            testCount++;
+            if (result != 0)
+            {
+                return result;
+            }
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi3", "GeluErfGaudi3Test"))
+    {
+        // fwd/bwd x f32/bf16
+        for (int mode = ActivationAllGaudi2::gelu_erf_fwd_f32; mode < ActivationAllGaudi2::gelu_erf_fwd_f32 + 4; mode++)
+        {
+            testActivationG3.SetUp();
+            result = testActivationG3.runTest(tpc_lib_api::DEVICE_ID_GAUDI3, (ActivationAllGaudi2::Activation_mode_t)mode);
+            testActivationG3.TearDown();
+            testCount++;
+            if (result != 0)
+            {
+                return result;
+            }
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi3", "SiluGaudi3Test"))
+    {
+        // fwd/bwd x f32/bf16
+        for (int mode = ActivationAllGaudi2::silu_fwd_f32; mode < ActivationAllGaudi2::silu_fwd_f32 + 4; mode++)
+        {
+            testActivationG3.SetUp();
+            result = testActivationG3.runTest(tpc_lib_api::DEVICE_ID_GAUDI3, (ActivationAllGaudi2::Activation_mode_t)mode);
+            testActivationG3.TearDown();
+            testCount++;
+            if (result != 0)
+            {
+                return result;
+            }
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi3", "SwiGluGaudi3Test"))
+    {
+        // fwd/bwd x f32/bf16
+        for (int mode = ActivationAllGaudi2::swiglu_fwd_f32; mode < ActivationAllGaudi2::swiglu_fwd_f32 + 4; mode++)
+        {
+            testActivationG3.SetUp();
+            result = testActivationG3.runTest(tpc_lib_api::DEVICE_ID_GAUDI3, (ActivationAllGaudi2::Activation_mode_t)mode);
+            testActivationG3.TearDown();
+            testCount++;
+            if (result != 0)
+            {
+                return result;
+            }
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi3", "GeGluGaudi3Test"))
+    {
+        // fwd/bwd x f32/bf16
+        for (int mode = ActivationAllGaudi2::geglu_fwd_f32; mode < ActivationAllGaudi2::geglu_fwd_f32 + 4; mode++)
+        {
+            testActivationG3.SetUp();
+            result = testActivationG3.runTest(tpc_lib_api::DEVICE_ID_GAUDI3, (ActivationAllGaudi2::Activation_mode_t)mode);
+            testActivationG3.TearDown();
+            testCount++;
+            if (result != 0)
+            {
+                return result;
+            }
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi3", "Fp8CastGaudi3Test"))
+    {
+        Fp8CastGaudi2Test testFp8CastG3;
+        // quant then dequant, E4M3 / E5M2 x f32 / bf16
+        for (int mode = 0; mode < Fp8CastGaudi2::fp8_cast_mode_count; mode++)
+        {
+            testFp8CastG3.SetUp();
+            result = testFp8CastG3.runTest(tpc_lib_api::DEVICE_ID_GAUDI3, (Fp8CastGaudi2::Fp8Cast_mode_t)mode);
+            testFp8CastG3.TearDown();
+            testCount++;
+            if (result != 0)
+            {
+                return result;
+            }
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi3", "CastAllGaudi3Test"))
+    {
+        CastAllGaudi2Test testCastAllG3;
+        // every (src, dst) pair of f32 / bf16 / f16 / i32 / i16 / i8 / u8
+        for (int pair = 0; pair < CastAllGaudi2::c_pairCount; pair++)
+        {
+            testCastAllG3.SetUp();
+            result = testCastAllG3.runTest(tpc_lib_api::DEVICE_ID_GAUDI3,
+                                          CastAllGaudi2::GetPairSrc(pair), CastAllGaudi2::GetPairDst(pair));
+            testCastAllG3.TearDown();
+            testCount++;
+            if (result != 0)
+            {
+                return result;
+            }
+        }
+    }
+
+    if(check_arg(argc, argv, "Gaudi3", "BinaryBroadcastGaudi3Test"))
+    {
+        BinaryBroadcastTest testBinaryBroadcastG3;
+        // every op and data type over the BinaryBroadcastTest shape cases
+        for (int mode = 0; mode < BinaryBroadcast::binary_broadcast_mode_count; mode++)
+        {
+            for (int op = 0; op < BinaryBroadcast::binary_op_count; op++)
+            {
+                for (int testCase = 0; testCase < BinaryBroadcastTest::c_testCaseCount; testCase++)
+                {
+                    testBinaryBroadcastG3.SetUp();
+                    result = testBinaryBroadcastG3.runTest(tpc_lib_api::DEVICE_ID_GAUDI3,
+                                          (BinaryBroadcast::BinaryBroadcast_mode_t)mode,
+                                          (BinaryBroadcast::BinaryOp_t)op, testCase);
+                    testBinaryBroadcastG3.TearDown();
+                    testCount++;
+                    if (result != 0)
+                    {
+                        return result;
+                    }
+                }
+            }
+        }
+    }
+
     if(testCount > 0)
         std::cout << "All " << testCount  <<" tests pass!" <<std::endl;
     else